@@ -25,6 +25,7 @@
 #include <lal/LALAtomicDatatypes.h>
 #include <lal/LALConstants.h>
 #include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
 #include <lal/Sequence.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/Units.h>
@@ -418,19 +419,70 @@ static void median_cleanup_REAL8( REAL8FrequencySeries *work, UINT4 n )
   return;
 }
 
-/* comparison for floating point numbers */
-static int compare_REAL4( const void *p1, const void *p2 )
-{
-  REAL4 x1 = *(const REAL4 *)p1;
-  REAL4 x2 = *(const REAL4 *)p2;
-  return (x1 > x2) - (x1 < x2);
-}
-static int compare_REAL8( const void *p1, const void *p2 )
-{
-  REAL8 x1 = *(const REAL8 *)p1;
-  REAL8 x2 = *(const REAL8 *)p2;
-  return (x1 > x2) - (x1 < x2);
+/*
+ * selection of the k-th smallest element of an array (Hoare's quickselect
+ * with median-of-three pivoting); the array is partially reordered so that
+ * x[i] <= x[k] for i < k and x[i] >= x[k] for i > k, which is all that is
+ * needed to find a median in linear (rather than n log n) time
+ */
+#define DEFINE_SELECT(TYPE) \
+static TYPE select_ ## TYPE( TYPE *x, INT8 n, INT8 k ) \
+{ \
+  INT8 lo = 0; \
+  INT8 hi = n - 1; \
+  while ( hi > lo ) \
+  { \
+    INT8 mid = lo + ( hi - lo ) / 2; \
+    INT8 i = lo; \
+    INT8 j = hi; \
+    TYPE pivot; \
+    TYPE tmp; \
+    /* median-of-three pivot; also places sentinels at lo and hi */ \
+    if ( x[mid] < x[lo] ) { tmp = x[mid]; x[mid] = x[lo]; x[lo] = tmp; } \
+    if ( x[hi] < x[lo] ) { tmp = x[hi]; x[hi] = x[lo]; x[lo] = tmp; } \
+    if ( x[hi] < x[mid] ) { tmp = x[hi]; x[hi] = x[mid]; x[mid] = tmp; } \
+    pivot = x[mid]; \
+    while ( i <= j ) \
+    { \
+      while ( x[i] < pivot ) \
+        ++i; \
+      while ( x[j] > pivot ) \
+        --j; \
+      if ( i <= j ) \
+      { \
+        tmp = x[i]; x[i] = x[j]; x[j] = tmp; \
+        ++i; \
+        --j; \
+      } \
+    } \
+    if ( k <= j ) \
+      hi = j; \
+    else if ( k >= i ) \
+      lo = i; \
+    else \
+      break; \
+  } \
+  return x[k]; \
+} \
+\
+/* median of an array; the array is reordered */ \
+static TYPE median_ ## TYPE( TYPE *x, UINT4 n ) \
+{ \
+  TYPE upper = select_ ## TYPE( x, n, n/2 ); \
+  TYPE lower; \
+  UINT4 i; \
+  if ( n % 2 ) /* odd number: middle element */ \
+    return upper; \
+  /* even number: average with largest element below the middle */ \
+  lower = x[0]; \
+  for ( i = 1; i < n/2; ++i ) \
+    if ( x[i] > lower ) \
+      lower = x[i]; \
+  return 0.5*(lower + upper); \
 }
+DEFINE_SELECT(REAL4)
+DEFINE_SELECT(REAL8)
+#undef DEFINE_SELECT
 
 
 /**
@@ -537,12 +589,8 @@ int XLALREAL4AverageSpectrumMedian(
     for ( seg = 0; seg < numseg; ++seg )
       bin[seg] = work[seg].data->data[k];
 
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL4 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
+    /* find median */
+    spectrum->data->data[k] = median_REAL4( bin, numseg );
 
     /* remove median bias */
     spectrum->data->data[k] *= normfac;
@@ -665,12 +713,8 @@ int XLALREAL8AverageSpectrumMedian(
     for ( seg = 0; seg < numseg; ++seg )
       bin[seg] = work[seg].data->data[k];
 
-    /* sort them and find median */
-    qsort( bin, numseg, sizeof( *bin ), compare_REAL8 );
-    if ( numseg % 2 ) /* odd number of evens */
-      spectrum->data->data[k] = bin[numseg/2];
-    else /* even number... take average */
-      spectrum->data->data[k] = 0.5*(bin[numseg/2-1] + bin[numseg/2]);
+    /* find median */
+    spectrum->data->data[k] = median_REAL8( bin, numseg );
 
     /* remove median bias */
     spectrum->data->data[k] *= normfac;
@@ -690,6 +734,150 @@ int XLALREAL8AverageSpectrumMedian(
 }
 
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+
+/*
+ * Median Method using a batch of FFTs: computes the same spectrum as
+ * XLALREAL4AverageSpectrumMedian() or XLALREAL8AverageSpectrumMedian(),
+ * but all segments are transformed with a single call to FFTW.  The
+ * segments are stored interleaved, so that the values of all segments in a
+ * given frequency bin are contiguous in memory, and the median of each bin
+ * is found by selection rather than by sorting.  Windowing and the per-bin
+ * power and median computations are parallelised with OpenMP, if enabled.
+ */
+#define DEFINE_MEDIAN_BATCH(RTYPE, CTYPE, CREAL, CIMAG) \
+int XLAL ## RTYPE ## AverageSpectrumMedianBatch( \
+    RTYPE ## FrequencySeries        *spectrum, \
+    const RTYPE ## TimeSeries       *tseries, \
+    UINT4                           seglen, \
+    UINT4                           stride, \
+    const RTYPE ## Window           *window, \
+    const RTYPE ## FFTBatchPlan     *plan \
+    ) \
+{ \
+  RTYPE ## VectorSequence *segments; /* interleaved windowed segments */ \
+  CTYPE ## VectorSequence *transforms; /* interleaved segment transforms */ \
+  RTYPE *power; /* bin-major array of segment powers */ \
+  RTYPE winnorm; /* unitary window normalization */ \
+  RTYPE normfac; /* normalization factor */ \
+  UINT4 reclen; /* length of entire data record */ \
+  UINT4 numseg; \
+  UINT4 numbin; \
+  UINT4 k; \
+\
+  if ( ! spectrum || ! tseries || ! plan ) \
+      XLAL_ERROR( XLAL_EFAULT ); \
+  if ( ! spectrum->data || ! tseries->data ) \
+      XLAL_ERROR( XLAL_EINVAL ); \
+  if ( tseries->deltaT <= 0.0 ) \
+      XLAL_ERROR( XLAL_EINVAL ); \
+  if ( ! seglen || ! stride || seglen > tseries->data->length ) \
+      XLAL_ERROR( XLAL_EBADLEN ); \
+\
+  reclen = tseries->data->length; \
+  numseg = 1 + (reclen - seglen)/stride; \
+  numbin = seglen/2 + 1; \
+\
+  /* consistency check for lengths: make sure that the segments cover the \
+   * data record completely */ \
+  if ( (numseg - 1)*stride + seglen != reclen ) \
+    XLAL_ERROR( XLAL_EBADLEN ); \
+  if ( spectrum->data->length != numbin ) \
+    XLAL_ERROR( XLAL_EBADLEN ); \
+  if ( window && window->data->length != seglen ) \
+    XLAL_ERROR( XLAL_EBADLEN ); \
+  if ( window && window->sumofsquares <= 0 ) \
+    XLAL_ERROR( XLAL_EDOM ); \
+\
+  /* create interleaved workspaces: element k of segment j is element j \
+   * of vector k, so the values of each frequency bin are contiguous */ \
+  segments = XLALCreate ## RTYPE ## VectorSequence( seglen, numseg ); \
+  if ( ! segments ) \
+    XLAL_ERROR( XLAL_EFUNC ); \
+  transforms = XLALCreate ## CTYPE ## VectorSequence( numbin, numseg ); \
+  if ( ! transforms ) \
+  { \
+    XLALDestroy ## RTYPE ## VectorSequence( segments ); \
+    XLAL_ERROR( XLAL_EFUNC ); \
+  } \
+\
+  /* copy the (windowed) segments into the interleaved workspace */ \
+  winnorm = window ? sqrt( seglen / window->sumofsquares ) : 1.0; \
+  _Pragma("omp parallel for schedule(static)") \
+  for ( k = 0; k < seglen; ++k ) \
+  { \
+    RTYPE w = window ? window->data->data[k] * winnorm : 1.0; \
+    const RTYPE *in = tseries->data->data + k; \
+    RTYPE *out = segments->data + (size_t)k * numseg; \
+    UINT4 seg; \
+    for ( seg = 0; seg < numseg; ++seg ) \
+      out[seg] = w * in[(size_t)seg * stride]; \
+  } \
+\
+  /* transform all segments at once */ \
+  if ( XLAL ## RTYPE ## ForwardFFTBatch( transforms, segments, plan ) == XLAL_FAILURE ) \
+  { \
+    XLALDestroy ## CTYPE ## VectorSequence( transforms ); \
+    XLALDestroy ## RTYPE ## VectorSequence( segments ); \
+    XLAL_ERROR( XLAL_EFUNC ); \
+  } \
+\
+  /* the segment data is no longer needed: reuse it to hold the powers */ \
+  power = segments->data; \
+\
+  /* normalization takes into account the periodogram normalization and the \
+   * median bias */ \
+  normfac = tseries->deltaT / ( seglen * XLALMedianBias( numseg ) ); \
+\
+  /* now loop over frequency bins and compute the median */ \
+  _Pragma("omp parallel for schedule(static)") \
+  for ( k = 0; k < numbin; ++k ) \
+  { \
+    const CTYPE *z = transforms->data + (size_t)k * numseg; \
+    RTYPE *bin = power + (size_t)k * numseg; \
+    RTYPE fac = 2.0; /* accounts for negative frequency part */ \
+    UINT4 seg; \
+\
+    /* DC and Nyquist components have no negative frequency part */ \
+    if ( k == 0 || ( seglen % 2 == 0 && k == seglen/2 ) ) \
+      fac = 1.0; \
+\
+    for ( seg = 0; seg < numseg; ++seg ) \
+    { \
+      RTYPE re = CREAL( z[seg] ); \
+      RTYPE im = CIMAG( z[seg] ); \
+      bin[seg] = fac * ( re * re + im * im ); \
+    } \
+\
+    /* find median and normalize */ \
+    spectrum->data->data[k] = normfac * median_ ## RTYPE( bin, numseg ); \
+  } \
+\
+  /* set metadata */ \
+  spectrum->epoch       = tseries->epoch; \
+  spectrum->f0          = tseries->f0; \
+  spectrum->deltaF      = 1.0 / ( seglen * tseries->deltaT ); \
+\
+  /* free the workspace data */ \
+  XLALDestroy ## CTYPE ## VectorSequence( transforms ); \
+  XLALDestroy ## RTYPE ## VectorSequence( segments ); \
+\
+  /* compute units */ \
+  if ( ! XLALUnitSquare( &spectrum->sampleUnits, &tseries->sampleUnits ) ) \
+    XLAL_ERROR( XLAL_EFUNC ); \
+  if ( ! XLALUnitMultiply( &spectrum->sampleUnits, \
+                           &spectrum->sampleUnits, &lalSecondUnit ) ) \
+    XLAL_ERROR( XLAL_EFUNC ); \
+\
+  return 0; \
+}
+DEFINE_MEDIAN_BATCH(REAL4, COMPLEX8, crealf, cimagf)
+DEFINE_MEDIAN_BATCH(REAL8, COMPLEX16, creal, cimag)
+#undef DEFINE_MEDIAN_BATCH
+
+#endif /* defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED) */
+
+
 /*
  *
  * Median-Mean Method
@@ -865,23 +1053,15 @@ int XLALREAL4AverageSpectrumMedianMean(
     for ( seg = 0; seg < halfnumseg; ++seg )
       bin[seg] = even[seg].data->data[k];
 
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
+    /* find median */
+    evenmedian = median_REAL4( bin, halfnumseg );
 
     /* assign array of odd segment values to bin array for this freq bin */
     for ( seg = 0; seg < halfnumseg; ++seg )
       bin[seg] = odd[seg].data->data[k];
 
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL4 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
+    /* find median */
+    oddmedian = median_REAL4( bin, halfnumseg );
 
     /* spectrum for this bin is the mean of the medians */
     spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
@@ -1034,23 +1214,15 @@ int XLALREAL8AverageSpectrumMedianMean(
     for ( seg = 0; seg < halfnumseg; ++seg )
       bin[seg] = even[seg].data->data[k];
 
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of evens */
-      evenmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      evenmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
+    /* find median */
+    evenmedian = median_REAL8( bin, halfnumseg );
 
     /* assign array of odd segment values to bin array for this freq bin */
     for ( seg = 0; seg < halfnumseg; ++seg )
       bin[seg] = odd[seg].data->data[k];
 
-    /* sort them and find median */
-    qsort( bin, halfnumseg, sizeof( *bin ), compare_REAL8 );
-    if ( halfnumseg % 2 ) /* odd number of odds */
-      oddmedian = bin[halfnumseg/2];
-    else /* even number... take average */
-      oddmedian = 0.5*(bin[halfnumseg/2-1] + bin[halfnumseg/2]);
+    /* find median */
+    oddmedian = median_REAL8( bin, halfnumseg );
 
     /* spectrum for this bin is the mean of the medians */
     spectrum->data->data[k] = normfac * (evenmedian + oddmedian);
@@ -1738,10 +1910,9 @@ int XLALPSDRegressorAdd(LALPSDRegressor *r, const COMPLEX16FrequencySeries *samp
     for(j = 0; j < history_length; j++)
       bin_history[j] = r->history[j]->data[i];
 
-    /* sort (to find the median) */
+    /* select the median */
 
-    qsort(bin_history, history_length, sizeof(*bin_history), compare_REAL8);
-    log_bin_median = log(bin_history[history_length / 2]);
+    log_bin_median = log(select_REAL8(bin_history, history_length, history_length / 2));
 
     /* use logarithm of median to update geometric mean.
      *
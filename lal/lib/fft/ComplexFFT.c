@@ -21,6 +21,7 @@
 
 #include <complex.h>
 #include <fftw3.h>
+#include <limits.h>
 #include <string.h>
 
 #include <lal/AVFactories.h>
@@ -127,6 +128,7 @@ tagCOMPLEX8FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the complex data vector for this plan */
   fftwf_plan plan; /**< the FFTW plan */
+  LALFFTWPlanCacheEntry *cache; /**< entry in the FFTW plan cache which owns the plan */
 };
 
 /**
@@ -138,6 +140,35 @@ tagCOMPLEX16FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the complex data vector for this plan */
   fftw_plan  plan; /**< the FFTW plan */
+  LALFFTWPlanCacheEntry *cache; /**< entry in the FFTW plan cache which owns the plan */
+};
+
+/**
+ * Plan to perform a batch of FFTs of COMPLEX8 data
+ */
+struct
+tagCOMPLEX8FFTBatchPlan
+{
+  INT4       sign;    /**< sign in transform exponential, -1 for forward, +1 for reverse */
+  UINT4      size;    /**< length of the complex data of each transform */
+  UINT4      howmany; /**< number of transforms */
+  UINT4      stride;  /**< stride of interleaved transforms, or 0 for consecutive transforms */
+  int        inplace; /**< whether the plan performs in-place transforms */
+  fftwf_plan plan;    /**< the FFTW plan */
+};
+
+/**
+ * Plan to perform a batch of FFTs of COMPLEX16 data
+ */
+struct
+tagCOMPLEX16FFTBatchPlan
+{
+  INT4       sign;    /**< sign in transform exponential, -1 for forward, +1 for reverse */
+  UINT4      size;    /**< length of the complex data of each transform */
+  UINT4      howmany; /**< number of transforms */
+  UINT4      stride;  /**< stride of interleaved transforms, or 0 for consecutive transforms */
+  int        inplace; /**< whether the plan performs in-place transforms */
+  fftw_plan  plan;    /**< the FFTW plan */
 };
 
 /* single- and double-precision routines */
@@ -43,6 +43,14 @@ extern "C" {
  * Perform complex-to-complex fast Fourier transforms of vectors using the
  * package FFTW \cite fj_1998 .
  *
+ * Plans of the same size, direction and \c measurelvl share one FFTW
+ * plan through LAL's global FFTW plan cache.  By default the FFTW plan
+ * is destroyed along with the last plan sharing it, so programs which
+ * repeatedly create and destroy plans of the same size only benefit from
+ * the cache if it is enabled, by calling XLALSetFFTWPlanCacheMaxUnused()
+ * or setting the environment variable \c LAL_FFTW_PLAN_CACHE to the
+ * number of unused FFTW plans to keep.
+ *
  */
 /** @{ */
 
@@ -79,12 +87,18 @@ extern "C" {
 typedef struct tagCOMPLEX8FFTPlan COMPLEX8FFTPlan;
 /** Plan to perform FFT of COMPLEX16 data */
 typedef struct tagCOMPLEX16FFTPlan COMPLEX16FFTPlan;
+/** Plan to perform a batch of FFTs of COMPLEX8 data */
+typedef struct tagCOMPLEX8FFTBatchPlan COMPLEX8FFTBatchPlan;
+/** Plan to perform a batch of FFTs of COMPLEX16 data */
+typedef struct tagCOMPLEX16FFTBatchPlan COMPLEX16FFTBatchPlan;
 #define tagComplexFFTPlan tagCOMPLEX8FFTPlan
 #define ComplexFFTPlan COMPLEX8FFTPlan
 
 #ifdef SWIG /* SWIG interface directives */
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX8Vector, output));
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX16Vector, output));
+SWIGLAL(VIEWIN_ARRAYS(COMPLEX8VectorSequence, output));
+SWIGLAL(VIEWIN_ARRAYS(COMPLEX16VectorSequence, output));
 #endif /* SWIG */
 
 /*
@@ -358,6 +372,104 @@ void XLALDestroyCOMPLEX16FFTPlan( COMPLEX16FFTPlan *plan );
  */
 int XLALCOMPLEX16VectorFFT( COMPLEX16Vector * _LAL_RESTRICT_ output, const COMPLEX16Vector * _LAL_RESTRICT_ input, const COMPLEX16FFTPlan *plan );
 
+/*
+ *
+ * XLAL batched functions; only available with the FFTW backend
+ *
+ */
+
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+
+/**
+ * Returns a new COMPLEX8FFTBatchPlan
+ *
+ * A COMPLEX8FFTBatchPlan performs \c howmany complex FFTs of the same
+ * size with a single call to FFTW, which avoids per-transform overheads
+ * and allows FFTW to use its multi-transform algorithms.  The data of the
+ * transforms may be laid out in one of two ways:
+ * - if \c stride is zero, each transform is one vector of a sequence of
+ * \c howmany vectors of length N;
+ * - otherwise, the transforms are interleaved, i.e. element k of
+ * transform j is element j of vector k of a sequence of N vectors, where
+ * the vector length of the sequence is \c stride (which must be at least
+ * \c howmany).
+ *
+ * @param[in] size The number of points N in each transform.
+ * @param[in] howmany The number of transforms.
+ * @param[in] stride Zero for consecutive transforms, or the stride of
+ * interleaved transforms.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] inplace Set non-zero for a plan which transforms its input
+ * in-place; otherwise the input and output must be distinct
+ * @param[in] measurelvl Measurement level for plan creation, as for
+ * XLALCreateCOMPLEX8FFTPlan().
+ * @return A pointer to an allocated \c COMPLEX8FFTBatchPlan structure is
+ * returned upon successful completion.  Otherwise, a \c NULL pointer is
+ * returned and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateCOMPLEX8FFTBatchPlan() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size or number of transforms is 0, or too large.
+ * - [\c XLAL_EINVAL] The stride of interleaved transforms is less than
+ * the number of transforms.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+COMPLEX8FFTBatchPlan * XLALCreateCOMPLEX8FFTBatchPlan( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int inplace, int measurelvl );
+
+/**
+ * Destroys a COMPLEX8FFTBatchPlan
+ * @param[in] plan A pointer to the COMPLEX8FFTBatchPlan to be destroyed.
+ * @return None.
+ */
+void XLALDestroyCOMPLEX8FFTBatchPlan( COMPLEX8FFTBatchPlan *plan );
+
+/**
+ * Performs a batch of COMPLEX8 FFTs
+ *
+ * Each transform is as performed by XLALCOMPLEX8VectorFFT(), with the
+ * layout of the input and output sequences determined by the plan; see
+ * XLALCreateCOMPLEX8FFTBatchPlan().
+ *
+ * @param[out] output The complex data sequence that results from the transforms
+ * @param[in] input The complex data sequence to be transformed
+ * @param[in] plan The FFT batch plan to use for the transforms
+ * @note
+ * The input and output sequences must be the same for an in-place plan,
+ * and distinct otherwise.
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALCOMPLEX8VectorSequenceFFT() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid, or the placement of the input
+ * and output sequences does not match the plan.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALCOMPLEX8VectorSequenceFFT( COMPLEX8VectorSequence *output, const COMPLEX8VectorSequence *input, const COMPLEX8FFTBatchPlan *plan );
+
+/**
+ * Returns a new COMPLEX16FFTBatchPlan; see XLALCreateCOMPLEX8FFTBatchPlan().
+ */
+COMPLEX16FFTBatchPlan * XLALCreateCOMPLEX16FFTBatchPlan( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int inplace, int measurelvl );
+
+/**
+ * Destroys a COMPLEX16FFTBatchPlan
+ * @param[in] plan A pointer to the COMPLEX16FFTBatchPlan to be destroyed.
+ * @return None.
+ */
+void XLALDestroyCOMPLEX16FFTBatchPlan( COMPLEX16FFTBatchPlan *plan );
+
+/**
+ * Performs a batch of COMPLEX16 FFTs; see XLALCOMPLEX8VectorSequenceFFT().
+ */
+int XLALCOMPLEX16VectorSequenceFFT( COMPLEX16VectorSequence *output, const COMPLEX16VectorSequence *input, const COMPLEX16FFTBatchPlan *plan );
+
+#endif /* defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED) */
+
 /** @} */
 
 #if 0
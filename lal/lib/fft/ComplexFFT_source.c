@@ -7,25 +7,41 @@
 #ifdef SINGLE_PRECISION
 #define COMPLEX_TYPE COMPLEX8
 #define TYPESUFFIX f
+#define PLAN_CACHE_TYPE LAL_FFTW_PLAN_COMPLEX8
 #else
 #define COMPLEX_TYPE COMPLEX16
 #define TYPESUFFIX
+#define PLAN_CACHE_TYPE LAL_FFTW_PLAN_COMPLEX16
 #endif
 
 #define PLAN_TYPE			CONCAT2(COMPLEX_TYPE,FFTPlan)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define BATCH_PLAN_TYPE			CONCAT2(COMPLEX_TYPE,FFTBatchPlan)
+#define COMPLEX_SEQUENCE_TYPE		CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
+#define DESTROY_CACHED_PLAN_FUNCTION	CONCAT2(DestroyCached,PLAN_TYPE)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,COMPLEX_VECTOR_TYPE,FFT)
+#define CREATE_BATCH_PLAN_FUNCTION	CONCAT2(XLALCreate,BATCH_PLAN_TYPE)
+#define DESTROY_BATCH_PLAN_FUNCTION	CONCAT2(XLALDestroy,BATCH_PLAN_TYPE)
+#define SEQUENCE_FFT_FUNCTION		CONCAT3(XLAL,COMPLEX_SEQUENCE_TYPE,FFT)
 
 #define FFTWX				CONCAT2(fftw,TYPESUFFIX)
 #define FFTWX_COMPLEX			CONCAT2(FFTWX,_complex)
 #define FFTWX_PLAN_DFT_1D		CONCAT2(FFTWX,_plan_dft_1d)
+#define FFTWX_PLAN			CONCAT2(FFTWX,_plan)
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_DFT		CONCAT2(FFTWX,_execute_dft)
+#define FFTWX_PLAN_MANY_DFT		CONCAT2(FFTWX,_plan_many_dft)
+
+/* destroy an FFTW plan owned by the FFTW plan cache */
+static void DESTROY_CACHED_PLAN_FUNCTION(void *plan)
+{
+    FFTWX_DESTROY_PLAN((FFTWX_PLAN) plan);
+}
 
 PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
 {
@@ -34,10 +50,16 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     COMPLEX_TYPE *tmp2;
     size_t nbytes;
     int flags;
+    int nthreads;
 
     if (!size)
         XLAL_ERROR_NULL(XLAL_EBADLEN);
 
+    /* measurement levels other than 0, 1 and 2 are all exhaustive */
+
+    if (measurelvl < 0 || measurelvl > 3)
+        measurelvl = 3;
+
     nbytes = size * sizeof(COMPLEX_TYPE);
 
     /* set fftw3 flags to perform requested degree of measurement */
@@ -68,6 +90,18 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     plan = XLALMalloc(sizeof(*plan));
     if (!plan)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
+    plan->size = size;
+    plan->sign = (fwdflg ? -1 : 1);
+
+    /* reuse a cached plan of the same size, direction and measurement
+     * level, if available; this avoids both planning and the fftw mutex */
+
+    nthreads = XLALGetFFTWThreads(size);
+    plan->cache = XLALFFTWPlanCacheLookup(PLAN_CACHE_TYPE, size, fwdflg, measurelvl, nthreads);
+    if (plan->cache) {
+        plan->plan = XLALFFTWPlanCacheEntryPlan(plan->cache);
+        return plan;
+    }
 
 #   ifdef LAL_FFTW3_MEMALIGN_ENABLED
     tmp1 = XLALMallocAligned(nbytes);
@@ -90,8 +124,10 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     /* establish fftw mutex lock and create plan */
 
     LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWPlanWithNumThreads(nthreads);
     plan->plan =
         FFTWX_PLAN_DFT_1D(size, (FFTWX_COMPLEX *) tmp1, (FFTWX_COMPLEX *) tmp2, fwdflg ? FFTW_FORWARD : FFTW_BACKWARD, flags);
+    XLALFFTWPlanWithNumThreads(1);
     LAL_FFTW_WISDOM_UNLOCK;
 
     /* free the temporary arrays */
@@ -111,10 +147,15 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
         XLAL_ERROR_NULL(XLAL_EFAILED);
     }
 
-    /* set remaining plan fields */
+    /* hand the plan over to the plan cache; if another thread has
+     * created the same plan in the meantime, the cached one is used */
 
-    plan->size = size;
-    plan->sign = (fwdflg ? -1 : 1);
+    plan->cache = XLALFFTWPlanCacheInsert(PLAN_CACHE_TYPE, size, fwdflg, measurelvl, nthreads, plan->plan, DESTROY_CACHED_PLAN_FUNCTION);
+    if (!plan->cache) {
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    plan->plan = XLALFFTWPlanCacheEntryPlan(plan->cache);
 
     return plan;
 }
@@ -140,7 +181,9 @@ PLAN_TYPE *CREATE_REVERSE_PLAN_FUNCTION(UINT4 size, int measurelvl)
 void DESTROY_PLAN_FUNCTION(PLAN_TYPE * plan)
 {
     if (plan) {
-        if (plan->plan) {
+        if (plan->cache) {
+            XLALFFTWPlanCacheRelease(plan->cache);
+        } else if (plan->plan) {
             LAL_FFTW_WISDOM_LOCK;
             FFTWX_DESTROY_PLAN(plan->plan);
             LAL_FFTW_WISDOM_UNLOCK;
@@ -209,6 +252,223 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
     return 0;
 }
 
+/*
+ *
+ * batched transforms
+ *
+ */
+
+BATCH_PLAN_TYPE *CREATE_BATCH_PLAN_FUNCTION(UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int inplace, int measurelvl)
+{
+    BATCH_PLAN_TYPE *plan;
+    COMPLEX_TYPE *tmp1;
+    COMPLEX_TYPE *tmp2;
+    size_t nbytes;
+    int n, istride, idist;
+    int flags;
+    int nthreads;
+
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    if (size > INT_MAX || howmany > INT_MAX || stride > INT_MAX)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    if (stride && stride < howmany)
+        XLAL_ERROR_NULL(XLAL_EINVAL);   /* interleaved transforms must not overlap */
+
+    /* layout of the data: either consecutive vectors of a sequence, or
+     * interleaved in a sequence with vector length stride */
+
+    n = size;
+    if (stride) {
+        istride = stride;
+        idist = 1;
+        nbytes = (size_t) size * stride * sizeof(COMPLEX_TYPE);
+    } else {
+        istride = 1;
+        idist = size;
+        nbytes = (size_t) size * howmany * sizeof(COMPLEX_TYPE);
+    }
+
+    /* set fftw3 flags to perform requested degree of measurement */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    flags = 0;
+#   else
+    flags = FFTW_UNALIGNED;
+#   endif
+
+    switch (measurelvl) {
+    case 0:    /* estimate */
+        flags |= FFTW_ESTIMATE;
+        break;
+    default:   /* exhaustive measurement */
+        flags |= FFTW_EXHAUSTIVE;
+        /* fall-through */
+    case 2:    /* lengthy measurement */
+        flags |= FFTW_PATIENT;
+        /* fall-through */
+    case 1:    /* measure the best plan */
+        flags |= FFTW_MEASURE;
+        break;
+    }
+
+    /* allocate memory for the plan and the temporary arrays; an in-place
+     * plan is created with a single array */
+
+    plan = XLALMalloc(sizeof(*plan));
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    tmp1 = XLALMallocAligned(nbytes);
+    tmp2 = inplace ? tmp1 : XLALMallocAligned(nbytes);
+    if (!tmp1 || !tmp2) {
+        XLALFreeAligned(tmp1);
+        if (!inplace)
+            XLALFreeAligned(tmp2);
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+#   else
+    tmp1 = XLALMalloc(nbytes);
+    tmp2 = inplace ? tmp1 : XLALMalloc(nbytes);
+    if (!tmp1 || !tmp2) {
+        XLALFree(tmp1);
+        if (!inplace)
+            XLALFree(tmp2);
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+#   endif
+
+    /* establish fftw mutex lock and create plan, using threads if the
+     * total size of the transforms is large enough */
+
+    nthreads = XLALGetFFTWThreads((UINT8) size * howmany);
+    LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWPlanWithNumThreads(nthreads);
+    plan->plan =
+        FFTWX_PLAN_MANY_DFT(1, &n, howmany, (FFTWX_COMPLEX *) tmp1, NULL, istride, idist, (FFTWX_COMPLEX *) tmp2, NULL, istride, idist, fwdflg ? FFTW_FORWARD : FFTW_BACKWARD, flags);
+    XLALFFTWPlanWithNumThreads(1);
+    LAL_FFTW_WISDOM_UNLOCK;
+
+    /* free the temporary arrays */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    XLALFreeAligned(tmp1);
+    if (!inplace)
+        XLALFreeAligned(tmp2);
+#   else
+    XLALFree(tmp1);
+    if (!inplace)
+        XLALFree(tmp2);
+#   endif
+
+    /* check to see success of plan creation */
+
+    if (!plan->plan) {
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_EFAILED);
+    }
+
+    /* set remaining plan fields */
+
+    plan->size = size;
+    plan->howmany = howmany;
+    plan->stride = stride;
+    plan->inplace = inplace ? 1 : 0;
+    plan->sign = (fwdflg ? -1 : 1);
+
+    return plan;
+}
+
+void DESTROY_BATCH_PLAN_FUNCTION(BATCH_PLAN_TYPE * plan)
+{
+    if (plan) {
+        if (plan->plan) {
+            LAL_FFTW_WISDOM_LOCK;
+            FFTWX_DESTROY_PLAN(plan->plan);
+            LAL_FFTW_WISDOM_UNLOCK;
+        }
+        memset(plan, 0, sizeof(*plan));
+        XLALFree(plan);
+    }
+}
+
+int SEQUENCE_FFT_FUNCTION(COMPLEX_SEQUENCE_TYPE * output, const COMPLEX_SEQUENCE_TYPE * input, const BATCH_PLAN_TYPE * plan)
+{
+    COMPLEX_TYPE *input_data;
+    COMPLEX_TYPE *output_data;
+    size_t nbytes;
+
+    /* sanity check on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (plan->inplace ? (output->data != input->data) : (output->data == input->data))
+        XLAL_ERROR(XLAL_EINVAL);        /* note: must match placement of plan */
+    if (output->length != input->length || output->vectorLength != input->vectorLength)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (plan->stride) {
+        if (input->length != plan->size || input->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+    } else {
+        if (input->length != plan->howmany || input->vectorLength != plan->size)
+            XLAL_ERROR(XLAL_EBADLEN);
+    }
+
+    nbytes = (size_t) input->length * input->vectorLength * sizeof(COMPLEX_TYPE);
+    input_data = input->data;
+    output_data = output->data;
+
+    /* if memory alignment is required, check memory alignment and create
+     * temporary space if necessary; an in-place transform of unaligned
+     * data is performed in-place in the temporary space */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (!LAL_IS_MEMORY_ALIGNED(input_data)) {
+        input_data = XLALMallocAligned(nbytes);
+        if (!input_data)
+            XLAL_ERROR(XLAL_ENOMEM);
+        memcpy(input_data, input->data, nbytes);
+        if (plan->inplace)
+            output_data = input_data;
+    }
+    if (!LAL_IS_MEMORY_ALIGNED(output_data)) {
+        output_data = XLALMallocAligned(nbytes);
+        if (!output_data) {
+            if (input_data != input->data)
+                XLALFreeAligned(input_data);
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+    }
+#   else
+    (void) nbytes;
+#   endif
+
+    /* perform the ffts */
+
+    FFTWX_EXECUTE_DFT(plan->plan, (FFTWX_COMPLEX *)input_data, (FFTWX_COMPLEX *)output_data);
+
+    /* cleanup aligned memory space if memory alignment is required;
+     * copy data from temporary space to output sequence */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (output_data != output->data)
+        memcpy(output->data, output_data, nbytes);
+    if (input_data != input->data)
+        XLALFreeAligned(input_data);
+    if (output_data != output->data && output_data != input_data)
+        XLALFreeAligned(output_data);
+#   endif
+
+    return 0;
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
@@ -217,18 +477,27 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
 
 #undef COMPLEX_TYPE
 #undef TYPESUFFIX
+#undef PLAN_CACHE_TYPE
 
 #undef PLAN_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef BATCH_PLAN_TYPE
+#undef COMPLEX_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
+#undef DESTROY_CACHED_PLAN_FUNCTION
 #undef VECTOR_FFT_FUNCTION
+#undef CREATE_BATCH_PLAN_FUNCTION
+#undef DESTROY_BATCH_PLAN_FUNCTION
+#undef SEQUENCE_FFT_FUNCTION
 
 #undef FFTWX
 #undef FFTWX_COMPLEX
 #undef FFTWX_PLAN_DFT_1D
+#undef FFTWX_PLAN
 #undef FFTWX_DESTROY_PLAN
 #undef FFTWX_EXECUTE_DFT
+#undef FFTWX_PLAN_MANY_DFT
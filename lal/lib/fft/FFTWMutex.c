@@ -17,11 +17,81 @@
 *  MA  02111-1307  USA
 */
 
+#include <config.h>
+
+#include <stdlib.h>
 #include <lal/FFTWMutex.h>
+#include <lal/XLALError.h>
+
+#if defined(HAVE_FFTW3_THREADS) && defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
+#define LAL_FFTW3_THREADS_ENABLED
+#include <fftw3.h>
+#endif
 
 #if defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
 #include <pthread.h>
 static pthread_mutex_t lalFFTWMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t lalFFTWPlanCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+# define LAL_FFTW_PLAN_CACHE_LOCK pthread_mutex_lock( &lalFFTWPlanCacheMutex )
+# define LAL_FFTW_PLAN_CACHE_UNLOCK pthread_mutex_unlock( &lalFFTWPlanCacheMutex )
+#else
+# define LAL_FFTW_PLAN_CACHE_LOCK
+# define LAL_FFTW_PLAN_CACHE_UNLOCK
+#endif
+
+/* number of hash buckets in the plan cache; must be a power of two */
+#define LAL_FFTW_PLAN_CACHE_BUCKETS 64
+
+/* maximum number of unreferenced plans kept in the plan cache when it is
+ * enabled by the LAL_FFTW_PLAN_CACHE environment variable */
+#define LAL_FFTW_PLAN_CACHE_MAX_MAX_UNUSED 65536
+
+/* default minimum size of a transform for which threaded FFTW plans are created */
+#define LAL_FFTW_THREADS_MIN_SIZE 65536
+
+/*
+ * Entry in the FFTW plan cache.  Entries are allocated with the C library
+ * allocator rather than LALMalloc(), since cached plans deliberately outlive
+ * the LAL plan structures which reference them and would otherwise be
+ * reported as memory leaks.
+ */
+struct tagLALFFTWPlanCacheEntry {
+    struct tagLALFFTWPlanCacheEntry *next;  /* next entry in hash bucket */
+    struct tagLALFFTWPlanCacheEntry **pprev;/* link to this entry in hash bucket */
+    struct tagLALFFTWPlanCacheEntry *lru_next; /* next (more recently released) unreferenced entry */
+    struct tagLALFFTWPlanCacheEntry *lru_prev; /* previous (less recently released) unreferenced entry */
+    LALFFTWPlanType type;                   /* type of transform */
+    UINT4 size;                             /* length of transform */
+    int fwdflg;                             /* direction of transform */
+    int measurelvl;                         /* level of plan measurement */
+    int nthreads;                           /* number of threads used by plan */
+    void *plan;                             /* the FFTW plan */
+    LALFFTWPlanDestroyFunction destroy;     /* function to destroy the FFTW plan */
+    UINT8 refcount;                         /* number of references to the plan */
+};
+
+/*
+ * the plan cache; all access must hold the plan cache lock.  Unreferenced
+ * entries are also kept in a list, least recently released first, from
+ * which they are evicted.  By default no unreferenced entries are kept, so
+ * that destroying the last LAL plan using an FFTW plan destroys it.
+ */
+static LALFFTWPlanCacheEntry *lalFFTWPlanCache[LAL_FFTW_PLAN_CACHE_BUCKETS];
+static LALFFTWPlanCacheEntry *lalFFTWPlanCacheLRUHead = NULL;
+static LALFFTWPlanCacheEntry *lalFFTWPlanCacheLRUTail = NULL;
+static size_t lalFFTWPlanCacheUnused = 0;
+static int lalFFTWPlanCacheInit = 0;
+static size_t lalFFTWPlanCacheMaxUnused = 0;
+
+/* settings for threaded FFTW plans; all access must hold the plan cache lock */
+static int lalFFTWThreadsInit = 0;
+static int lalFFTWNumThreads = 1;
+static UINT8 lalFFTWThreadsMinSize = LAL_FFTW_THREADS_MIN_SIZE;
+
+#if defined(LAL_FFTW3_THREADS_ENABLED)
+/* whether the FFTW threads library has been initialised; all access must
+ * hold LAL's FFTW wisdom lock */
+static int lalFFTWThreadsLibInit = 0;
 #endif
 
 
@@ -55,3 +125,409 @@ void XLALFFTWWisdomUnlock(void)
     pthread_mutex_unlock( &lalFFTWMutex );
 #endif
 }
+
+
+/* return the hash bucket for a plan cache key */
+static size_t FFTWPlanCacheBucket(LALFFTWPlanType type, UINT4 size, int fwdflg, int measurelvl, int nthreads)
+{
+    UINT8 h = size;
+    h = h * 31 + (UINT8) type;
+    h = h * 31 + (fwdflg ? 1 : 0);
+    h = h * 31 + (UINT8) measurelvl;
+    h = h * 31 + (UINT8) nthreads;
+    h ^= h >> 17;
+    h *= 0xed5ad4bbULL;
+    h ^= h >> 11;
+    return (size_t) (h & (LAL_FFTW_PLAN_CACHE_BUCKETS - 1));
+}
+
+/* find a plan cache entry; the plan cache lock must be held */
+static LALFFTWPlanCacheEntry *FFTWPlanCacheFind(LALFFTWPlanType type, UINT4 size, int fwdflg, int measurelvl, int nthreads)
+{
+    LALFFTWPlanCacheEntry *entry;
+    for (entry = lalFFTWPlanCache[FFTWPlanCacheBucket(type, size, fwdflg, measurelvl, nthreads)]; entry; entry = entry->next)
+        if (entry->type == type && entry->size == size && entry->fwdflg == fwdflg && entry->measurelvl == measurelvl && entry->nthreads == nthreads)
+            return entry;
+    return NULL;
+}
+
+/* read the plan cache settings from the environment, once; the plan cache
+ * lock must be held */
+static void FFTWPlanCacheInitSettings(void)
+{
+    if (lalFFTWPlanCacheInit)
+        return;
+    lalFFTWPlanCacheInit = 1;
+    const char *env = getenv("LAL_FFTW_PLAN_CACHE");
+    if (env && *env) {
+        char *endp = NULL;
+        const long n = strtol(env, &endp, 10);
+        if (*endp != '\0' || n < 0 || n > LAL_FFTW_PLAN_CACHE_MAX_MAX_UNUSED) {
+            XLALPrintWarning("%s: ignoring invalid LAL_FFTW_PLAN_CACHE='%s'\n", __func__, env);
+        } else {
+            lalFFTWPlanCacheMaxUnused = (size_t) n;
+        }
+    }
+}
+
+/* add an entry which is no longer referenced to the end of the list of
+ * unreferenced entries; the plan cache lock must be held */
+static void FFTWPlanCacheLRUPush(LALFFTWPlanCacheEntry *entry)
+{
+    entry->lru_next = NULL;
+    entry->lru_prev = lalFFTWPlanCacheLRUTail;
+    if (lalFFTWPlanCacheLRUTail)
+        lalFFTWPlanCacheLRUTail->lru_next = entry;
+    else
+        lalFFTWPlanCacheLRUHead = entry;
+    lalFFTWPlanCacheLRUTail = entry;
+    ++lalFFTWPlanCacheUnused;
+}
+
+/* remove an entry from the list of unreferenced entries; the plan cache
+ * lock must be held */
+static void FFTWPlanCacheLRURemove(LALFFTWPlanCacheEntry *entry)
+{
+    if (entry->lru_prev)
+        entry->lru_prev->lru_next = entry->lru_next;
+    else
+        lalFFTWPlanCacheLRUHead = entry->lru_next;
+    if (entry->lru_next)
+        entry->lru_next->lru_prev = entry->lru_prev;
+    else
+        lalFFTWPlanCacheLRUTail = entry->lru_prev;
+    entry->lru_next = entry->lru_prev = NULL;
+    --lalFFTWPlanCacheUnused;
+}
+
+/* take a reference to an entry; the plan cache lock must be held */
+static void FFTWPlanCacheRef(LALFFTWPlanCacheEntry *entry)
+{
+    if (entry->refcount++ == 0)
+        FFTWPlanCacheLRURemove(entry);
+}
+
+/*
+ * remove unreferenced entries, least recently used first, until at most
+ * max_unused remain; the plan cache lock must be held, and the removed
+ * entries are returned as a list so that their plans can be destroyed
+ * outside of the lock
+ */
+static LALFFTWPlanCacheEntry *FFTWPlanCacheEvict(size_t max_unused)
+{
+    LALFFTWPlanCacheEntry *evicted = NULL;
+    while (lalFFTWPlanCacheUnused > max_unused) {
+        LALFFTWPlanCacheEntry *victim = lalFFTWPlanCacheLRUHead;
+        FFTWPlanCacheLRURemove(victim);
+        *victim->pprev = victim->next;
+        if (victim->next)
+            victim->next->pprev = victim->pprev;
+        victim->next = evicted;
+        evicted = victim;
+    }
+    return evicted;
+}
+
+/* destroy a list of evicted plan cache entries */
+static void FFTWPlanCacheDestroyList(LALFFTWPlanCacheEntry *list)
+{
+    if (!list)
+        return;
+    LAL_FFTW_WISDOM_LOCK;
+    while (list) {
+        LALFFTWPlanCacheEntry *next = list->next;
+        list->destroy(list->plan);
+        free(list);
+        list = next;
+    }
+    LAL_FFTW_WISDOM_UNLOCK;
+}
+
+
+/**
+ * Look up an FFTW plan in LAL's global FFTW plan cache.  If a plan for a
+ * transform of the given type, size, direction and measurement level, and
+ * using the given number of threads, has previously been added with XLALFFTWPlanCacheInsert(), its reference count
+ * is incremented and the plan cache entry is returned; otherwise NULL is
+ * returned.  The FFTW plan is given by XLALFFTWPlanCacheEntryPlan(), and
+ * the reference must be returned with XLALFFTWPlanCacheRelease().
+ *
+ * Lookups only hold the plan cache lock, and not LAL's FFTW wisdom lock,
+ * and may be performed concurrently from multiple threads.
+ */
+
+LALFFTWPlanCacheEntry *XLALFFTWPlanCacheLookup(LALFFTWPlanType type, UINT4 size, int fwdflg, int measurelvl, int nthreads)
+{
+    fwdflg = fwdflg ? 1 : 0;
+    LAL_FFTW_PLAN_CACHE_LOCK;
+    LALFFTWPlanCacheEntry *entry = FFTWPlanCacheFind(type, size, fwdflg, measurelvl, nthreads);
+    if (entry)
+        FFTWPlanCacheRef(entry);
+    LAL_FFTW_PLAN_CACHE_UNLOCK;
+    return entry;
+}
+
+
+/**
+ * Add an FFTW plan to LAL's global FFTW plan cache, and return a
+ * reference to its plan cache entry.  The cache takes ownership of the
+ * plan, which is destroyed with the supplied function (while holding LAL's
+ * FFTW wisdom lock) when it is eventually evicted from the cache.  If
+ * another thread has added a plan with the same key in the meantime, the
+ * supplied plan is destroyed and a reference to the existing entry is
+ * returned instead.
+ */
+
+LALFFTWPlanCacheEntry *XLALFFTWPlanCacheInsert(LALFFTWPlanType type, UINT4 size, int fwdflg, int measurelvl, int nthreads, void *plan, LALFFTWPlanDestroyFunction destroy)
+{
+    if (!plan || !destroy)
+        XLAL_ERROR_NULL(XLAL_EFAULT);
+    fwdflg = fwdflg ? 1 : 0;
+
+    LALFFTWPlanCacheEntry *newentry = calloc(1, sizeof(*newentry));
+    if (!newentry) {
+        LAL_FFTW_WISDOM_LOCK;
+        destroy(plan);
+        LAL_FFTW_WISDOM_UNLOCK;
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    newentry->type = type;
+    newentry->size = size;
+    newentry->fwdflg = fwdflg;
+    newentry->measurelvl = measurelvl;
+    newentry->nthreads = nthreads;
+    newentry->plan = plan;
+    newentry->destroy = destroy;
+    newentry->refcount = 1;
+
+    LAL_FFTW_PLAN_CACHE_LOCK;
+    LALFFTWPlanCacheEntry *entry = FFTWPlanCacheFind(type, size, fwdflg, measurelvl, nthreads);
+    if (entry) {
+        FFTWPlanCacheRef(entry);
+    } else {
+        const size_t bucket = FFTWPlanCacheBucket(type, size, fwdflg, measurelvl, nthreads);
+        newentry->next = lalFFTWPlanCache[bucket];
+        newentry->pprev = &lalFFTWPlanCache[bucket];
+        if (newentry->next)
+            newentry->next->pprev = &newentry->next;
+        lalFFTWPlanCache[bucket] = newentry;
+        entry = newentry;
+        newentry = NULL;
+    }
+    LAL_FFTW_PLAN_CACHE_UNLOCK;
+
+    /* lost the race to another thread: discard the duplicate plan */
+    FFTWPlanCacheDestroyList(newentry);
+
+    return entry;
+}
+
+
+/**
+ * Return the FFTW plan held by a plan cache entry.
+ */
+
+void *XLALFFTWPlanCacheEntryPlan(const LALFFTWPlanCacheEntry *entry)
+{
+    return entry ? entry->plan : NULL;
+}
+
+
+/**
+ * Release a reference to a plan cache entry returned by
+ * XLALFFTWPlanCacheLookup() or XLALFFTWPlanCacheInsert().  If caching of
+ * unreferenced plans has been enabled, they are kept in the cache for
+ * reuse, up to the limit set by XLALSetFFTWPlanCacheMaxUnused(); beyond
+ * that the least recently used unreferenced plans are destroyed.
+ * Otherwise, the plan is destroyed once it is no longer referenced.
+ */
+
+void XLALFFTWPlanCacheRelease(LALFFTWPlanCacheEntry *entry)
+{
+    if (!entry)
+        return;
+    LAL_FFTW_PLAN_CACHE_LOCK;
+    LALFFTWPlanCacheEntry *evicted = NULL;
+    if (entry->refcount > 0 && --entry->refcount == 0) {
+        FFTWPlanCacheInitSettings();
+        FFTWPlanCacheLRUPush(entry);
+        evicted = FFTWPlanCacheEvict(lalFFTWPlanCacheMaxUnused);
+    }
+    LAL_FFTW_PLAN_CACHE_UNLOCK;
+    FFTWPlanCacheDestroyList(evicted);
+}
+
+
+/**
+ * Set the maximum number of unreferenced plans kept in LAL's global FFTW
+ * plan cache, and return the previous maximum.  A maximum of zero destroys
+ * plans as soon as they are no longer referenced, i.e. disables caching;
+ * this is the default.
+ *
+ * The default may also be set with the environment variable
+ * \c LAL_FFTW_PLAN_CACHE, which is read when the first plan is destroyed;
+ * explicit calls to this function take precedence.
+ *
+ * Programs which enable caching and call e.g. fftw_cleanup(), which
+ * invalidates all existing FFTW plans, must first call
+ * XLALClearFFTWPlanCache().
+ */
+
+size_t XLALSetFFTWPlanCacheMaxUnused(size_t max_unused)
+{
+    LAL_FFTW_PLAN_CACHE_LOCK;
+    lalFFTWPlanCacheInit = 1;
+    const size_t old_max_unused = lalFFTWPlanCacheMaxUnused;
+    lalFFTWPlanCacheMaxUnused = max_unused;
+    LALFFTWPlanCacheEntry *evicted = FFTWPlanCacheEvict(max_unused);
+    LAL_FFTW_PLAN_CACHE_UNLOCK;
+    FFTWPlanCacheDestroyList(evicted);
+    return old_max_unused;
+}
+
+
+/**
+ * Destroy all unreferenced plans in LAL's global FFTW plan cache.  If
+ * caching has been enabled with XLALSetFFTWPlanCacheMaxUnused() or
+ * \c LAL_FFTW_PLAN_CACHE, this must be called before e.g. fftw_cleanup(),
+ * which invalidates all existing FFTW plans.
+ */
+
+void XLALClearFFTWPlanCache(void)
+{
+    LAL_FFTW_PLAN_CACHE_LOCK;
+    LALFFTWPlanCacheEntry *evicted = FFTWPlanCacheEvict(0);
+    LAL_FFTW_PLAN_CACHE_UNLOCK;
+    FFTWPlanCacheDestroyList(evicted);
+}
+
+
+/* initialise the FFTW threads library of both precisions, once; returns
+ * nonzero on success.  Takes LAL's FFTW wisdom lock, which must therefore
+ * not already be held. */
+static int FFTWThreadsInitLibrary(void)
+{
+#if defined(LAL_FFTW3_THREADS_ENABLED)
+    LAL_FFTW_WISDOM_LOCK;
+    if (!lalFFTWThreadsLibInit && fftwf_init_threads() && fftw_init_threads())
+        lalFFTWThreadsLibInit = 1;
+    const int ok = lalFFTWThreadsLibInit;
+    LAL_FFTW_WISDOM_UNLOCK;
+    return ok;
+#else
+    return 0;
+#endif
+}
+
+/* read the threaded FFTW settings from the environment, once; the plan
+ * cache lock must be held, but not LAL's FFTW wisdom lock */
+static void FFTWThreadsInitSettings(void)
+{
+    if (lalFFTWThreadsInit)
+        return;
+    lalFFTWThreadsInit = 1;
+    const char *env = getenv("LAL_FFTW_THREADS");
+    if (env && *env) {
+        char *endp = NULL;
+        const long n = strtol(env, &endp, 10);
+        if (*endp != '\0' || n < 1 || n > 4096) {
+            XLALPrintWarning("%s: ignoring invalid LAL_FFTW_THREADS='%s'\n", __func__, env);
+        } else {
+#if defined(LAL_FFTW3_THREADS_ENABLED)
+            if (n == 1 || FFTWThreadsInitLibrary())
+                lalFFTWNumThreads = (int) n;
+            else
+                XLALPrintWarning("%s: failed to initialise FFTW threads; ignoring LAL_FFTW_THREADS='%s'\n", __func__, env);
+#else
+            if (n > 1)
+                XLALPrintWarning("%s: LAL was built without threaded FFTW; ignoring LAL_FFTW_THREADS='%s'\n", __func__, env);
+#endif
+        }
+    }
+    env = getenv("LAL_FFTW_THREADS_MIN_SIZE");
+    if (env && *env) {
+        char *endp = NULL;
+        const unsigned long long m = strtoull(env, &endp, 10);
+        if (*env < '0' || *env > '9' || *endp != '\0') {
+            XLALPrintWarning("%s: ignoring invalid LAL_FFTW_THREADS_MIN_SIZE='%s'\n", __func__, env);
+        } else {
+            lalFFTWThreadsMinSize = m;
+        }
+    }
+}
+
+
+/**
+ * Set the number of threads used by FFTW plans created by LAL, for
+ * transforms of at least \c min_size points (summed over all transforms
+ * of a batch plan).  Smaller transforms always use a single thread, since
+ * the overhead of threading outweighs the gain.  A value of 1 for
+ * \c nthreads disables threaded plans; this is the default.
+ *
+ * The defaults may also be set with the environment variables
+ * \c LAL_FFTW_THREADS and \c LAL_FFTW_THREADS_MIN_SIZE, which are read
+ * when the first plan is created; explicit calls to this function take
+ * precedence.  Threaded plans require that LAL be built with pthread
+ * support and the threaded FFTW libraries; otherwise this function fails
+ * with #XLAL_EINVAL if more than one thread is requested.  The FFTW
+ * threads library is initialised the first time more than one thread is
+ * requested.
+ *
+ * Plans which already exist are not affected.
+ */
+
+int XLALSetFFTWThreads(int nthreads, UINT8 min_size)
+{
+    if (nthreads < 1)
+        XLAL_ERROR(XLAL_EINVAL, "Number of threads must be at least 1");
+#if !defined(LAL_FFTW3_THREADS_ENABLED)
+    if (nthreads > 1)
+        XLAL_ERROR(XLAL_EINVAL, "LAL was built without threaded FFTW");
+#endif
+    if (nthreads > 1 && !FFTWThreadsInitLibrary())
+        XLAL_ERROR(XLAL_EFAILED, "Failed to initialise FFTW threads");
+    LAL_FFTW_PLAN_CACHE_LOCK;
+    lalFFTWThreadsInit = 1;
+    lalFFTWNumThreads = nthreads;
+    lalFFTWThreadsMinSize = min_size;
+    LAL_FFTW_PLAN_CACHE_UNLOCK;
+    return XLAL_SUCCESS;
+}
+
+
+/**
+ * Return the number of threads which LAL uses for an FFTW plan of
+ * \c size points (summed over all transforms of a batch plan), as
+ * determined by XLALSetFFTWThreads() or the environment.
+ */
+
+int XLALGetFFTWThreads(UINT8 size)
+{
+    LAL_FFTW_PLAN_CACHE_LOCK;
+    FFTWThreadsInitSettings();
+    const int nthreads = (size >= lalFFTWThreadsMinSize) ? lalFFTWNumThreads : 1;
+    LAL_FFTW_PLAN_CACHE_UNLOCK;
+    return nthreads;
+}
+
+
+/**
+ * Make subsequently created FFTW plans, of either precision, use the
+ * given number of threads.  LAL's FFTW wisdom lock must be held, since
+ * FFTW's planner settings are global.  The FFTW threads library is
+ * initialised by XLALSetFFTWThreads(), or when \c LAL_FFTW_THREADS is
+ * read; until then, this function is a no-op, as it is if LAL has been
+ * compiled without threaded FFTW.
+ */
+
+void XLALFFTWPlanWithNumThreads(int nthreads)
+{
+#if defined(LAL_FFTW3_THREADS_ENABLED)
+    if (lalFFTWThreadsLibInit) {
+        fftwf_plan_with_nthreads(nthreads);
+        fftw_plan_with_nthreads(nthreads);
+    }
+#else
+    (void) nthreads;
+#endif
+}
@@ -20,7 +20,9 @@
 #ifndef _FFTWMUTEX_H
 #define _FFTWMUTEX_H
 
+#include <stddef.h>
 #include <lal/LALConfig.h>
+#include <lal/LALAtomicDatatypes.h>
 
 #ifdef  __cplusplus
 extern "C" {
@@ -29,6 +31,37 @@ extern "C" {
 void XLALFFTWWisdomLock(void);
 void XLALFFTWWisdomUnlock(void);
 
+size_t XLALSetFFTWPlanCacheMaxUnused(size_t max_unused);
+void XLALClearFFTWPlanCache(void);
+
+int XLALSetFFTWThreads(int nthreads, UINT8 min_size);
+int XLALGetFFTWThreads(UINT8 size);
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+/** Types of transform held in LAL's global FFTW plan cache */
+typedef enum tagLALFFTWPlanType {
+  LAL_FFTW_PLAN_REAL4,
+  LAL_FFTW_PLAN_REAL8,
+  LAL_FFTW_PLAN_COMPLEX8,
+  LAL_FFTW_PLAN_COMPLEX16,
+} LALFFTWPlanType;
+
+/** Entry in LAL's global FFTW plan cache */
+typedef struct tagLALFFTWPlanCacheEntry LALFFTWPlanCacheEntry;
+
+/** Function which destroys an FFTW plan */
+typedef void (*LALFFTWPlanDestroyFunction)(void *plan);
+
+LALFFTWPlanCacheEntry *XLALFFTWPlanCacheLookup(LALFFTWPlanType type, UINT4 size, int fwdflg, int measurelvl, int nthreads);
+LALFFTWPlanCacheEntry *XLALFFTWPlanCacheInsert(LALFFTWPlanType type, UINT4 size, int fwdflg, int measurelvl, int nthreads, void *plan, LALFFTWPlanDestroyFunction destroy);
+void *XLALFFTWPlanCacheEntryPlan(const LALFFTWPlanCacheEntry *entry);
+void XLALFFTWPlanCacheRelease(LALFFTWPlanCacheEntry *entry);
+
+void XLALFFTWPlanWithNumThreads(int nthreads);
+
+#endif /* SWIG */
+
 #if defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
 # define LAL_FFTW_WISDOM_LOCK XLALFFTWWisdomLock()
 # define LAL_FFTW_WISDOM_UNLOCK XLALFFTWWisdomUnlock()
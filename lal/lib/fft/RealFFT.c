@@ -21,6 +21,7 @@
 
 #include <complex.h>
 #include <fftw3.h>
+#include <limits.h>
 #include <string.h>
 
 #include <lal/LALDatatypes.h>
@@ -155,6 +156,7 @@ tagREAL4FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
   fftwf_plan plan; /**< the FFTW plan */
+  LALFFTWPlanCacheEntry *cache; /**< entry in the FFTW plan cache which owns the plan */
 };
 
 /**
@@ -166,9 +168,35 @@ tagREAL8FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
   fftw_plan  plan; /**< the FFTW plan */
+  LALFFTWPlanCacheEntry *cache; /**< entry in the FFTW plan cache which owns the plan */
 };
 
 
+/**
+ * \brief Plan to perform a batch of FFTs of REAL4 data.
+ */
+struct
+tagREAL4FFTBatchPlan
+{
+  INT4       sign;    /**< sign in transform exponential, -1 for forward, +1 for reverse */
+  UINT4      size;    /**< length of the real data of each transform */
+  UINT4      howmany; /**< number of transforms */
+  UINT4      stride;  /**< stride of interleaved transforms, or 0 for consecutive transforms */
+  fftwf_plan plan;    /**< the FFTW plan */
+};
+
+/**
+ * \brief Plan to perform a batch of FFTs of REAL8 data.
+ */
+struct
+tagREAL8FFTBatchPlan
+{
+  INT4       sign;    /**< sign in transform exponential, -1 for forward, +1 for reverse */
+  UINT4      size;    /**< length of the real data of each transform */
+  UINT4      howmany; /**< number of transforms */
+  UINT4      stride;  /**< stride of interleaved transforms, or 0 for consecutive transforms */
+  fftw_plan  plan;    /**< the FFTW plan */
+};
 
 /* single- and double-precision routines */
 
@@ -100,6 +100,14 @@ extern "C" {
  * memory that was allocated in the structure as well as the structure
  * itself.  It can be used on either forward or reverse plans.
  *
+ * Plans of the same size, direction and \c measurelvl share one FFTW
+ * plan through LAL's global FFTW plan cache.  By default the FFTW plan
+ * is destroyed along with the last plan sharing it, so programs which
+ * repeatedly create and destroy plans of the same size only benefit from
+ * the cache if it is enabled, by calling XLALSetFFTWPlanCacheMaxUnused()
+ * or setting the environment variable \c LAL_FFTW_PLAN_CACHE to the
+ * number of unused FFTW plans to keep.
+ *
  * XLALREAL4ForwardFFT() and
  * XLALREAL4ReverseFFT() perform forward (real to complex) and
  * reverse (complex to real) transforms respectively.  The plan supplied
@@ -193,12 +201,20 @@ typedef struct tagREAL4FFTPlan REAL4FFTPlan;
 typedef struct tagREAL8FFTPlan REAL8FFTPlan;
 #define tagRealFFTPlan tagREAL4FFTPlan
 #define RealFFTPlan REAL4FFTPlan
+/** Plan to perform a batch of FFTs of REAL4 data */
+typedef struct tagREAL4FFTBatchPlan REAL4FFTBatchPlan;
+/** Plan to perform a batch of FFTs of REAL8 data */
+typedef struct tagREAL8FFTBatchPlan REAL8FFTBatchPlan;
 
 #ifdef SWIG /* SWIG interface directives */
 SWIGLAL(VIEWIN_ARRAYS(REAL4Vector, output, spec));
 SWIGLAL(VIEWIN_ARRAYS(REAL8Vector, output, spec));
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX8Vector, output));
 SWIGLAL(VIEWIN_ARRAYS(COMPLEX16Vector, output));
+SWIGLAL(VIEWIN_ARRAYS(REAL4VectorSequence, output));
+SWIGLAL(VIEWIN_ARRAYS(REAL8VectorSequence, output));
+SWIGLAL(VIEWIN_ARRAYS(COMPLEX8VectorSequence, output));
+SWIGLAL(VIEWIN_ARRAYS(COMPLEX16VectorSequence, output));
 #endif /* SWIG */
 
 /*
@@ -660,6 +676,132 @@ int XLALREAL8VectorFFT( REAL8Vector *output, const REAL8Vector *input,
 int XLALREAL8PowerSpectrum( REAL8Vector *spec, const REAL8Vector *data,
     const REAL8FFTPlan *plan );
 
+/*
+ *
+ * XLAL batched functions; only available with the FFTW backend
+ *
+ */
+
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+
+/**
+ * Returns a new REAL4FFTBatchPlan
+ *
+ * A REAL4FFTBatchPlan performs \c howmany real FFTs of the same size
+ * with a single call to FFTW, which avoids per-transform overheads and
+ * allows FFTW to use its multi-transform algorithms.  The data of the
+ * transforms may be laid out in one of two ways:
+ * - if \c stride is zero, each transform is one vector of a sequence,
+ * i.e. the real data is a sequence of \c howmany vectors of length N,
+ * and the complex data a sequence of \c howmany vectors of length
+ * [N/2] + 1;
+ * - otherwise, the transforms are interleaved, i.e. element k of
+ * transform j is element j of vector k of a sequence, where the vector
+ * length of the sequence is \c stride (which must be at least
+ * \c howmany); the real data is a sequence of N such vectors, and the
+ * complex data a sequence of [N/2] + 1 such vectors.
+ *
+ * @param[in] size The number of points N in the real data of each transform.
+ * @param[in] howmany The number of transforms.
+ * @param[in] stride Zero for consecutive transforms, or the stride of
+ * interleaved transforms.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation, as for
+ * XLALCreateREAL4FFTPlan().
+ * @return A pointer to an allocated \c REAL4FFTBatchPlan structure is
+ * returned upon successful completion.  Otherwise, a \c NULL pointer is
+ * returned and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateREAL4FFTBatchPlan() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size or number of transforms is 0, or too large.
+ * - [\c XLAL_EINVAL] The stride of interleaved transforms is less than
+ * the number of transforms.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+REAL4FFTBatchPlan * XLALCreateREAL4FFTBatchPlan( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+
+/**
+ * Destroys a REAL4FFTBatchPlan
+ * @param[in] plan A pointer to the REAL4FFTBatchPlan to be destroyed.
+ * @return None.
+ */
+void XLALDestroyREAL4FFTBatchPlan( REAL4FFTBatchPlan *plan );
+
+/**
+ * Performs a batch of forward FFTs of REAL4 data
+ *
+ * Each transform is as performed by XLALREAL4ForwardFFT(), with the
+ * layout of the input and output sequences determined by the plan; see
+ * XLALCreateREAL4FFTBatchPlan().
+ *
+ * @param[out] output The complex data sequence that results from the transforms
+ * @param[in] input The real data sequence to be transformed
+ * @param[in] plan The FFT batch plan to use for the transforms
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALREAL4ForwardFFTBatch() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a
+ * reverse transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALREAL4ForwardFFTBatch( COMPLEX8VectorSequence *output, const REAL4VectorSequence *input, const REAL4FFTBatchPlan *plan );
+
+/**
+ * Performs a batch of reverse FFTs of REAL4 data
+ *
+ * Each transform is as performed by XLALREAL4ReverseFFT(), with the
+ * layout of the input and output sequences determined by the plan; see
+ * XLALCreateREAL4FFTBatchPlan().  The input sequence is left undamaged.
+ *
+ * @param[out] output The real data sequence that results from the transforms
+ * @param[in] input The complex data sequence to be transformed
+ * @param[in] plan The FFT batch plan to use for the transforms
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALREAL4ReverseFFTBatch() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a
+ * forward transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan are
+ * incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EDOM] Domain error if the DC or Nyquist component of any of
+ * the transforms is not purely real.
+ * .
+ */
+int XLALREAL4ReverseFFTBatch( REAL4VectorSequence *output, const COMPLEX8VectorSequence *input, const REAL4FFTBatchPlan *plan );
+
+/**
+ * Returns a new REAL8FFTBatchPlan; see XLALCreateREAL4FFTBatchPlan().
+ */
+REAL8FFTBatchPlan * XLALCreateREAL8FFTBatchPlan( UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl );
+
+/**
+ * Destroys a REAL8FFTBatchPlan
+ * @param[in] plan A pointer to the REAL8FFTBatchPlan to be destroyed.
+ * @return None.
+ */
+void XLALDestroyREAL8FFTBatchPlan( REAL8FFTBatchPlan *plan );
+
+/**
+ * Performs a batch of forward FFTs of REAL8 data; see XLALREAL4ForwardFFTBatch().
+ */
+int XLALREAL8ForwardFFTBatch( COMPLEX16VectorSequence *output, const REAL8VectorSequence *input, const REAL8FFTBatchPlan *plan );
+
+/**
+ * Performs a batch of reverse FFTs of REAL8 data; see XLALREAL4ReverseFFTBatch().
+ */
+int XLALREAL8ReverseFFTBatch( REAL8VectorSequence *output, const COMPLEX16VectorSequence *input, const REAL8FFTBatchPlan *plan );
+
+#endif /* defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED) */
+
 /** @} */
 
 #if 0
@@ -8,31 +8,53 @@
 #define REAL_TYPE REAL4
 #define COMPLEX_TYPE COMPLEX8
 #define TYPESUFFIX f
+#define PLAN_CACHE_TYPE LAL_FFTW_PLAN_REAL4
 #else
 #define REAL_TYPE REAL8
 #define COMPLEX_TYPE COMPLEX16
 #define TYPESUFFIX
+#define PLAN_CACHE_TYPE LAL_FFTW_PLAN_REAL8
 #endif
 
 #define PLAN_TYPE			CONCAT2(REAL_TYPE,FFTPlan)
+#define BATCH_PLAN_TYPE			CONCAT2(REAL_TYPE,FFTBatchPlan)
 #define REAL_VECTOR_TYPE		CONCAT2(REAL_TYPE,Vector)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define REAL_SEQUENCE_TYPE		CONCAT2(REAL_TYPE,VectorSequence)
+#define COMPLEX_SEQUENCE_TYPE		CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
+#define DESTROY_CACHED_PLAN_FUNCTION	CONCAT2(DestroyCached,PLAN_TYPE)
 #define FORWARD_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ForwardFFT)
 #define REVERSE_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ReverseFFT)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,REAL_VECTOR_TYPE,FFT)
 #define POWER_SPECTRUM_FUNCTION		CONCAT3(XLAL,REAL_TYPE,PowerSpectrum)
+#define CREATE_BATCH_PLAN_FUNCTION	CONCAT2(XLALCreate,BATCH_PLAN_TYPE)
+#define DESTROY_BATCH_PLAN_FUNCTION	CONCAT2(XLALDestroy,BATCH_PLAN_TYPE)
+#define FORWARD_FFT_BATCH_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ForwardFFTBatch)
+#define REVERSE_FFT_BATCH_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ReverseFFTBatch)
 
 #define CREALX				CONCAT2(creal,TYPESUFFIX)
 #define CIMAGX				CONCAT2(cimag,TYPESUFFIX)
 #define FFTWX				CONCAT2(fftw,TYPESUFFIX)
 #define FFTWX_PLAN_R2R_1D		CONCAT2(FFTWX,_plan_r2r_1d)
+#define FFTWX_PLAN			CONCAT2(FFTWX,_plan)
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_R2R		CONCAT2(FFTWX,_execute_r2r)
+#define FFTWX_COMPLEX			CONCAT2(FFTWX,_complex)
+#define FFTWX_PLAN_MANY_DFT_R2C		CONCAT2(FFTWX,_plan_many_dft_r2c)
+#define FFTWX_PLAN_MANY_DFT_C2R		CONCAT2(FFTWX,_plan_many_dft_c2r)
+#define FFTWX_EXECUTE_DFT_R2C		CONCAT2(FFTWX,_execute_dft_r2c)
+#define FFTWX_EXECUTE_DFT_C2R		CONCAT2(FFTWX,_execute_dft_c2r)
+
+/* destroy an FFTW plan owned by the FFTW plan cache */
+static void DESTROY_CACHED_PLAN_FUNCTION(void *plan)
+{
+    FFTWX_DESTROY_PLAN((FFTWX_PLAN) plan);
+}
 
 PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
 {
@@ -41,10 +63,16 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     REAL_TYPE *tmp2;
     size_t nbytes;
     int flags;
+    int nthreads;
 
     if (!size)
         XLAL_ERROR_NULL(XLAL_EBADLEN);
 
+    /* measurement levels other than 0, 1 and 2 are all exhaustive */
+
+    if (measurelvl < 0 || measurelvl > 3)
+        measurelvl = 3;
+
     nbytes = size * sizeof(REAL_TYPE);
 
     /* set fftw3 flags to perform requested degree of measurement */
@@ -75,6 +103,18 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     plan = XLALMalloc(sizeof(*plan));
     if (!plan)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
+    plan->size = size;
+    plan->sign = (fwdflg ? -1 : 1);
+
+    /* reuse a cached plan of the same size, direction and measurement
+     * level, if available; this avoids both planning and the fftw mutex */
+
+    nthreads = XLALGetFFTWThreads(size);
+    plan->cache = XLALFFTWPlanCacheLookup(PLAN_CACHE_TYPE, size, fwdflg, measurelvl, nthreads);
+    if (plan->cache) {
+        plan->plan = XLALFFTWPlanCacheEntryPlan(plan->cache);
+        return plan;
+    }
 
 #   ifdef LAL_FFTW3_MEMALIGN_ENABLED
     tmp1 = XLALMallocAligned(nbytes);
@@ -97,10 +137,12 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     /* establish fftw mutex lock and create plan */
 
     LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWPlanWithNumThreads(nthreads);
     if (fwdflg) /* forward */
         plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_R2HC, flags);
     else        /* reverse */
         plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_HC2R, flags);
+    XLALFFTWPlanWithNumThreads(1);
     LAL_FFTW_WISDOM_UNLOCK;
 
     /* free the temporary arrays */
@@ -120,10 +162,15 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
         XLAL_ERROR_NULL(XLAL_EFAILED);
     }
 
-    /* set remaining plan fields */
+    /* hand the plan over to the plan cache; if another thread has
+     * created the same plan in the meantime, the cached one is used */
 
-    plan->size = size;
-    plan->sign = (fwdflg ? -1 : 1);
+    plan->cache = XLALFFTWPlanCacheInsert(PLAN_CACHE_TYPE, size, fwdflg, measurelvl, nthreads, plan->plan, DESTROY_CACHED_PLAN_FUNCTION);
+    if (!plan->cache) {
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    plan->plan = XLALFFTWPlanCacheEntryPlan(plan->cache);
 
     return plan;
 }
@@ -149,7 +196,9 @@ PLAN_TYPE *CREATE_REVERSE_PLAN_FUNCTION(UINT4 size, int measurelvl)
 void DESTROY_PLAN_FUNCTION(PLAN_TYPE * plan)
 {
     if (plan) {
-        if (plan->plan) {
+        if (plan->cache) {
+            XLALFFTWPlanCacheRelease(plan->cache);
+        } else if (plan->plan) {
             LAL_FFTW_WISDOM_LOCK;
             FFTWX_DESTROY_PLAN(plan->plan);
             LAL_FFTW_WISDOM_UNLOCK;
@@ -453,6 +502,312 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     return 0;
 }
 
+/*
+ *
+ * batched transforms
+ *
+ */
+
+BATCH_PLAN_TYPE *CREATE_BATCH_PLAN_FUNCTION(UINT4 size, UINT4 howmany, UINT4 stride, int fwdflg, int measurelvl)
+{
+    BATCH_PLAN_TYPE *plan;
+    REAL_TYPE *tmp1;
+    COMPLEX_TYPE *tmp2;
+    size_t nreal, ncomplex;
+    int n, istride, idist, ostride, odist;
+    int flags;
+    int nthreads;
+
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    if (size > INT_MAX || howmany > INT_MAX || stride > INT_MAX)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    if (stride && stride < howmany)
+        XLAL_ERROR_NULL(XLAL_EINVAL);   /* interleaved transforms must not overlap */
+
+    /* layout of the real and complex data: either consecutive vectors of
+     * a sequence, or interleaved in a sequence with vector length stride */
+
+    n = size;
+    if (stride) {
+        istride = ostride = stride;
+        idist = odist = 1;
+        nreal = (size_t) size * stride;
+        ncomplex = (size_t) (size / 2 + 1) * stride;
+    } else {
+        istride = ostride = 1;
+        idist = size;
+        odist = size / 2 + 1;
+        nreal = (size_t) size * howmany;
+        ncomplex = (size_t) (size / 2 + 1) * howmany;
+    }
+
+    /* set fftw3 flags to perform requested degree of measurement; the
+     * reverse (complex to real) transform must not destroy its input */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    flags = 0;
+#   else
+    flags = FFTW_UNALIGNED;
+#   endif
+    if (!fwdflg)
+        flags |= FFTW_PRESERVE_INPUT;
+
+    switch (measurelvl) {
+    case 0:    /* estimate */
+        flags |= FFTW_ESTIMATE;
+        break;
+    default:   /* exhaustive measurement */
+        flags |= FFTW_EXHAUSTIVE;
+        /* fall-through */
+    case 2:    /* lengthy measurement */
+        flags |= FFTW_PATIENT;
+        /* fall-through */
+    case 1:    /* measure the best plan */
+        flags |= FFTW_MEASURE;
+        break;
+    }
+
+    /* allocate memory for the plan and the temporary arrays */
+
+    plan = XLALMalloc(sizeof(*plan));
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    tmp1 = XLALMallocAligned(nreal * sizeof(*tmp1));
+    tmp2 = XLALMallocAligned(ncomplex * sizeof(*tmp2));
+    if (!tmp1 || !tmp2) {
+        XLALFreeAligned(tmp1);
+        XLALFreeAligned(tmp2);
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+#   else
+    tmp1 = XLALMalloc(nreal * sizeof(*tmp1));
+    tmp2 = XLALMalloc(ncomplex * sizeof(*tmp2));
+    if (!tmp1 || !tmp2) {
+        XLALFree(tmp1);
+        XLALFree(tmp2);
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+#   endif
+
+    /* establish fftw mutex lock and create plan, using threads if the
+     * total size of the transforms is large enough */
+
+    nthreads = XLALGetFFTWThreads((UINT8) size * howmany);
+    LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWPlanWithNumThreads(nthreads);
+    if (fwdflg) /* forward */
+        plan->plan = FFTWX_PLAN_MANY_DFT_R2C(1, &n, howmany, tmp1, NULL, istride, idist, (FFTWX_COMPLEX *) tmp2, NULL, ostride, odist, flags);
+    else        /* reverse */
+        plan->plan = FFTWX_PLAN_MANY_DFT_C2R(1, &n, howmany, (FFTWX_COMPLEX *) tmp2, NULL, ostride, odist, tmp1, NULL, istride, idist, flags);
+    XLALFFTWPlanWithNumThreads(1);
+    LAL_FFTW_WISDOM_UNLOCK;
+
+    /* free the temporary arrays */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    XLALFreeAligned(tmp1);
+    XLALFreeAligned(tmp2);
+#   else
+    XLALFree(tmp1);
+    XLALFree(tmp2);
+#   endif
+
+    /* check to see success of plan creation */
+
+    if (!plan->plan) {
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_EFAILED);
+    }
+
+    /* set remaining plan fields */
+
+    plan->size = size;
+    plan->howmany = howmany;
+    plan->stride = stride;
+    plan->sign = (fwdflg ? -1 : 1);
+
+    return plan;
+}
+
+void DESTROY_BATCH_PLAN_FUNCTION(BATCH_PLAN_TYPE * plan)
+{
+    if (plan) {
+        if (plan->plan) {
+            LAL_FFTW_WISDOM_LOCK;
+            FFTWX_DESTROY_PLAN(plan->plan);
+            LAL_FFTW_WISDOM_UNLOCK;
+        }
+        memset(plan, 0, sizeof(*plan));
+        XLALFree(plan);
+    }
+}
+
+int FORWARD_FFT_BATCH_FUNCTION(COMPLEX_SEQUENCE_TYPE * output, const REAL_SEQUENCE_TYPE * input, const BATCH_PLAN_TYPE * plan)
+{
+    REAL_TYPE *input_data;
+    COMPLEX_TYPE *output_data;
+    size_t nreal, ncomplex;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != -1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (plan->stride) {
+        if (input->length != plan->size || input->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (output->length != plan->size / 2 + 1 || output->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+    } else {
+        if (input->length != plan->howmany || input->vectorLength != plan->size)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (output->length != plan->howmany || output->vectorLength != plan->size / 2 + 1)
+            XLAL_ERROR(XLAL_EBADLEN);
+    }
+
+    nreal = (size_t) input->length * input->vectorLength;
+    ncomplex = (size_t) output->length * output->vectorLength;
+    input_data = input->data;
+    output_data = output->data;
+
+    /* if memory alignment is required, check memory alignment and create
+     * temporary space if necessary */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (!LAL_IS_MEMORY_ALIGNED(input_data)) {
+        input_data = XLALMallocAligned(nreal * sizeof(*input_data));
+        if (!input_data)
+            XLAL_ERROR(XLAL_ENOMEM);
+        memcpy(input_data, input->data, nreal * sizeof(*input_data));
+    }
+    if (!LAL_IS_MEMORY_ALIGNED(output_data)) {
+        output_data = XLALMallocAligned(ncomplex * sizeof(*output_data));
+        if (!output_data) {
+            if (input_data != input->data)
+                XLALFreeAligned(input_data);
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+    }
+#   else
+    (void) nreal;
+    (void) ncomplex;
+#   endif
+
+    /* perform the ffts; an out-of-place real to complex transform
+     * leaves its input undamaged */
+
+    FFTWX_EXECUTE_DFT_R2C(plan->plan, input_data, (FFTWX_COMPLEX *) output_data);
+
+    /* cleanup aligned memory space if memory alignment is required;
+     * copy data from temporary space to output sequence */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (input_data != input->data)
+        XLALFreeAligned(input_data);
+    if (output_data != output->data) {
+        memcpy(output->data, output_data, ncomplex * sizeof(*output_data));
+        XLALFreeAligned(output_data);
+    }
+#   endif
+
+    return 0;
+}
+
+int REVERSE_FFT_BATCH_FUNCTION(REAL_SEQUENCE_TYPE * output, const COMPLEX_SEQUENCE_TYPE * input, const BATCH_PLAN_TYPE * plan)
+{
+    COMPLEX_TYPE *input_data;
+    REAL_TYPE *output_data;
+    size_t nreal, ncomplex;
+    UINT4 j, kdc, knyq, jstep;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != 1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (plan->stride) {
+        if (output->length != plan->size || output->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (input->length != plan->size / 2 + 1 || input->vectorLength != plan->stride)
+            XLAL_ERROR(XLAL_EBADLEN);
+        kdc = 0;
+        knyq = (plan->size / 2) * plan->stride;
+        jstep = 1;
+    } else {
+        if (output->length != plan->howmany || output->vectorLength != plan->size)
+            XLAL_ERROR(XLAL_EBADLEN);
+        if (input->length != plan->howmany || input->vectorLength != plan->size / 2 + 1)
+            XLAL_ERROR(XLAL_EBADLEN);
+        kdc = 0;
+        knyq = plan->size / 2;
+        jstep = plan->size / 2 + 1;
+    }
+    for (j = 0; j < plan->howmany; ++j) {
+        if (CIMAGX(input->data[kdc + j * jstep]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);      /* imaginary part of DC must be zero */
+        if (plan->size % 2 == 0 && CIMAGX(input->data[knyq + j * jstep]) != 0.0)
+            XLAL_ERROR(XLAL_EDOM);      /* imaginary part of Nyquist must be zero */
+    }
+
+    nreal = (size_t) output->length * output->vectorLength;
+    ncomplex = (size_t) input->length * input->vectorLength;
+    input_data = input->data;
+    output_data = output->data;
+
+    /* if memory alignment is required, check memory alignment and create
+     * temporary space if necessary */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (!LAL_IS_MEMORY_ALIGNED(input_data)) {
+        input_data = XLALMallocAligned(ncomplex * sizeof(*input_data));
+        if (!input_data)
+            XLAL_ERROR(XLAL_ENOMEM);
+        memcpy(input_data, input->data, ncomplex * sizeof(*input_data));
+    }
+    if (!LAL_IS_MEMORY_ALIGNED(output_data)) {
+        output_data = XLALMallocAligned(nreal * sizeof(*output_data));
+        if (!output_data) {
+            if (input_data != input->data)
+                XLALFreeAligned(input_data);
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+    }
+#   else
+    (void) nreal;
+    (void) ncomplex;
+#   endif
+
+    /* perform the ffts; the plan was created with FFTW_PRESERVE_INPUT,
+     * so the input is left undamaged */
+
+    FFTWX_EXECUTE_DFT_C2R(plan->plan, (FFTWX_COMPLEX *) input_data, output_data);
+
+    /* cleanup aligned memory space if memory alignment is required;
+     * copy data from temporary space to output sequence */
+
+#   ifdef LAL_FFTW3_MEMALIGN_ENABLED
+    if (input_data != input->data)
+        XLALFreeAligned(input_data);
+    if (output_data != output->data) {
+        memcpy(output->data, output_data, nreal * sizeof(*output_data));
+        XLALFreeAligned(output_data);
+    }
+#   endif
+
+    return 0;
+}
+
 #undef CONCAT2x
 #undef CONCAT2
 #undef CONCAT3x
@@ -462,23 +817,38 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
 #undef REAL_TYPE
 #undef COMPLEX_TYPE
 #undef TYPESUFFIX
+#undef PLAN_CACHE_TYPE
 
 #undef PLAN_TYPE
+#undef BATCH_PLAN_TYPE
 #undef REAL_VECTOR_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef REAL_SEQUENCE_TYPE
+#undef COMPLEX_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
+#undef DESTROY_CACHED_PLAN_FUNCTION
 #undef FORWARD_FFT_FUNCTION
 #undef REVERSE_FFT_FUNCTION
 #undef VECTOR_FFT_FUNCTION
 #undef POWER_SPECTRUM_FUNCTION
+#undef CREATE_BATCH_PLAN_FUNCTION
+#undef DESTROY_BATCH_PLAN_FUNCTION
+#undef FORWARD_FFT_BATCH_FUNCTION
+#undef REVERSE_FFT_BATCH_FUNCTION
 
 #undef CREALX
 #undef CIMAGX
 #undef FFTWX
 #undef FFTWX_PLAN_R2R_1D
+#undef FFTWX_PLAN
 #undef FFTWX_DESTROY_PLAN
 #undef FFTWX_EXECUTE_R2R
+#undef FFTWX_COMPLEX
+#undef FFTWX_PLAN_MANY_DFT_R2C
+#undef FFTWX_PLAN_MANY_DFT_C2R
+#undef FFTWX_EXECUTE_DFT_R2C
+#undef FFTWX_EXECUTE_DFT_C2R
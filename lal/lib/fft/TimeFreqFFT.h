@@ -293,6 +293,50 @@ int XLALREAL8AverageSpectrumMedian(
     const REAL8FFTPlan          *plan
     );
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+
+/**
+ * Median Method using a batch of FFTs: computes the same spectrum as
+ * XLALREAL4AverageSpectrumMedian(), but all segments are transformed with
+ * a single call to FFTW, and the median of each frequency bin is found by
+ * selection rather than by sorting.
+ *
+ * The plan must be a forward batch plan of interleaved transforms, created
+ * with XLALCreateREAL4FFTBatchPlan( seglen, numseg, numseg, 1, measurelvl ),
+ * where numseg = 1 + (tseries->data->length - seglen)/stride is the number
+ * of segments.
+ */
+int XLALREAL4AverageSpectrumMedianBatch(
+    REAL4FrequencySeries        *spectrum,
+    const REAL4TimeSeries       *tseries,
+    UINT4                        seglen,
+    UINT4                        stride,
+    const REAL4Window           *window,
+    const REAL4FFTBatchPlan     *plan
+    );
+
+/**
+ * Median Method using a batch of FFTs: computes the same spectrum as
+ * XLALREAL8AverageSpectrumMedian(), but all segments are transformed with
+ * a single call to FFTW, and the median of each frequency bin is found by
+ * selection rather than by sorting.
+ *
+ * The plan must be a forward batch plan of interleaved transforms, created
+ * with XLALCreateREAL8FFTBatchPlan( seglen, numseg, numseg, 1, measurelvl ),
+ * where numseg = 1 + (tseries->data->length - seglen)/stride is the number
+ * of segments.
+ */
+int XLALREAL8AverageSpectrumMedianBatch(
+    REAL8FrequencySeries        *spectrum,
+    const REAL8TimeSeries       *tseries,
+    UINT4                        seglen,
+    UINT4                        stride,
+    const REAL8Window           *window,
+    const REAL8FFTBatchPlan     *plan
+    );
+
+#endif /* defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED) */
+
 int XLALREAL4AverageSpectrumMedianMean(
     REAL4FrequencySeries        *spectrum,
     const REAL4TimeSeries       *tseries,
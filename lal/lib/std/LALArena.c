@@ -0,0 +1,451 @@
+/*
+*  Copyright (C) 2026 Karl Wette
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <config.h>
+#include <lal/LALArena.h>
+#include <lal/LALMalloc.h>
+#include <lal/XLALError.h>
+
+/*
+ *
+ * Arena allocator.
+ *
+ */
+
+/* alignment of allocations from an arena; matches LAL_MEM_ALIGNMENT */
+#define ARENA_ALIGNMENT ((size_t)0x40)
+
+/* default block size */
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t)65536)
+
+/* blocks are kept in allocation order; 'start' is the offset of the block
+ * in the arena's notional contiguous address space, in which marks are
+ * expressed, and 'used' is the offset of the end of the last allocation
+ * from 'base', the first aligned address in the block */
+struct arenaBlock {
+    struct arenaBlock *next;
+    size_t start;
+    size_t size;
+    size_t used;
+    char *base;
+    void *data;
+};
+
+struct tagLALArena {
+    size_t blockSize;
+    struct arenaBlock *head;
+    struct arenaBlock *current;
+    size_t numBlocks;
+    size_t capacity;
+    size_t peak;
+    size_t numAllocs;
+    size_t numResets;
+};
+
+#define ALIGN_UP(x) (((x) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1))
+
+static struct arenaBlock *ArenaBlockCreate(size_t size)
+{
+    struct arenaBlock *block = XLALMalloc(sizeof(*block));
+    if (!block)
+        return NULL;
+    /* over-allocate so that the whole block can be used once aligned */
+    block->data = XLALMalloc(size + ARENA_ALIGNMENT - 1);
+    if (!block->data) {
+        XLALFree(block);
+        return NULL;
+    }
+    block->base = (char *) ALIGN_UP((uintptr_t) block->data);
+    block->next = NULL;
+    block->start = 0;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+static void ArenaBlockDestroy(struct arenaBlock *block)
+{
+    if (block) {
+        XLALFree(block->data);
+        XLALFree(block);
+    }
+}
+
+/* recompute the block offsets after the block list has changed */
+static void ArenaRenumber(LALArena *arena)
+{
+    size_t start = 0;
+    for (struct arenaBlock *block = arena->head; block; block = block->next) {
+        block->start = start;
+        start += block->size;
+    }
+}
+
+/**
+ * Creates an arena whose memory is obtained in blocks of \c blockSize bytes;
+ * larger allocations get a block of their own.  If \c blockSize is 0 a
+ * default of 64 KiB is used.
+ */
+LALArena *XLALCreateArena(size_t blockSize)
+{
+    LALArena *arena = XLALCalloc(1, sizeof(*arena));
+    if (!arena)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    arena->blockSize = blockSize > 0 ? blockSize : ARENA_DEFAULT_BLOCK_SIZE;
+    return arena;
+}
+
+/** Destroys an arena, releasing all memory allocated from it. */
+void XLALDestroyArena(LALArena *arena)
+{
+    if (arena) {
+        struct arenaBlock *block = arena->head;
+        while (block) {
+            struct arenaBlock *next = block->next;
+            ArenaBlockDestroy(block);
+            block = next;
+        }
+        XLALFree(arena);
+    }
+}
+
+/**
+ * Allocates \c n bytes from an arena.  The memory is aligned to 64 bytes
+ * and remains valid until it is released by XLALArenaRelease(),
+ * XLALArenaReset() or XLALDestroyArena().
+ */
+void *XLALArenaAlloc(LALArena *arena, size_t n)
+{
+    struct arenaBlock *block;
+    size_t offset, mark;
+
+    XLAL_CHECK_NULL(arena, XLAL_EFAULT);
+    if (n == 0)
+        n = 1;
+    XLAL_CHECK_NULL(n <= SIZE_MAX - 2 * ARENA_ALIGNMENT, XLAL_ENOMEM);
+
+    /* try the current block, then the (reused) blocks after it */
+    for (block = arena->current; block; block = block->next) {
+        if (block != arena->current)
+            block->used = 0;
+        arena->current = block;
+        offset = ALIGN_UP(block->used);
+        if (offset <= block->size && n <= block->size - offset)
+            break;
+    }
+
+    /* no room: insert a new block after the current one */
+    if (!block) {
+        size_t size = n > arena->blockSize ? n : arena->blockSize;
+        block = ArenaBlockCreate(size);
+        XLAL_CHECK_NULL(block, XLAL_ENOMEM);
+        if (arena->current) {
+            block->next = arena->current->next;
+            arena->current->next = block;
+        } else {
+            block->next = arena->head;
+            arena->head = block;
+        }
+        arena->current = block;
+        ++arena->numBlocks;
+        arena->capacity += size;
+        ArenaRenumber(arena);
+        offset = 0;
+    }
+
+    block->used = offset + n;
+    ++arena->numAllocs;
+    mark = block->start + block->used;
+    if (mark > arena->peak)
+        arena->peak = mark;
+
+    return block->base + offset;
+}
+
+/** Allocates zeroed memory for \c m objects of \c n bytes from an arena. */
+void *XLALArenaCalloc(LALArena *arena, size_t m, size_t n)
+{
+    void *p;
+    XLAL_CHECK_NULL(n == 0 || m <= SIZE_MAX / n, XLAL_ENOMEM);
+    p = XLALArenaAlloc(arena, m * n);
+    XLAL_CHECK_NULL(p, XLAL_EFUNC);
+    memset(p, 0, m * n);
+    return p;
+}
+
+/**
+ * Returns a mark recording the current state of an arena.  Passing the mark
+ * to XLALArenaRelease() releases everything allocated after this call.
+ * Marks can be nested, and are invalidated by releasing to an earlier mark.
+ */
+size_t XLALArenaMark(const LALArena *arena)
+{
+    XLAL_CHECK_VAL(0, arena, XLAL_EFAULT);
+    return arena->current ? arena->current->start + arena->current->used : 0;
+}
+
+/**
+ * Releases all memory allocated from an arena since \c mark was obtained
+ * from XLALArenaMark().  The memory is kept by the arena for reuse.
+ */
+int XLALArenaRelease(LALArena *arena, size_t mark)
+{
+    struct arenaBlock *block;
+    XLAL_CHECK(arena, XLAL_EFAULT);
+    XLAL_CHECK(mark <= XLALArenaMark(arena), XLAL_EINVAL, "mark %zu is beyond the end of the arena", mark);
+    if (!arena->head)
+        return 0;
+    for (block = arena->head; block->next && mark > block->start + block->size; block = block->next)
+        ;
+    arena->current = block;
+    block->used = mark - block->start;
+    return 0;
+}
+
+/**
+ * Releases all memory allocated from an arena.  The memory is kept by the
+ * arena for reuse; if it is spread over several blocks, they are merged
+ * into one so that the next cycle of allocations is contiguous.
+ */
+int XLALArenaReset(LALArena *arena)
+{
+    XLAL_CHECK(arena, XLAL_EFAULT);
+    ++arena->numResets;
+    if (arena->numBlocks > 1) {
+        struct arenaBlock *merged = ArenaBlockCreate(arena->capacity);
+        if (merged) {
+            struct arenaBlock *block = arena->head;
+            while (block) {
+                struct arenaBlock *next = block->next;
+                ArenaBlockDestroy(block);
+                block = next;
+            }
+            arena->head = merged;
+            arena->numBlocks = 1;
+        }
+        /* if the merged block cannot be allocated, just reuse the blocks */
+    }
+    arena->current = arena->head;
+    if (arena->current)
+        arena->current->used = 0;
+    return 0;
+}
+
+/** Returns usage statistics of an arena in \c stats. */
+int XLALArenaGetStats(const LALArena *arena, LALArenaStats *stats)
+{
+    XLAL_CHECK(arena && stats, XLAL_EFAULT);
+    stats->numBlocks = arena->numBlocks;
+    stats->capacity = arena->capacity;
+    stats->used = XLALArenaMark(arena);
+    stats->peak = arena->peak;
+    stats->numAllocs = arena->numAllocs;
+    stats->numResets = arena->numResets;
+    return 0;
+}
+
+/*
+ *
+ * Small-object pool allocator.
+ *
+ */
+
+/* size classes are multiples of POOL_GRANULE up to LAL_POOL_MAX_SIZE;
+ * each object is preceded by a header holding its class, which keeps the
+ * object aligned to POOL_GRANULE; the class POOL_NUM_CLASSES marks objects
+ * that bypass the free lists */
+#define POOL_GRANULE ((size_t)16)
+#define POOL_NUM_CLASSES (LAL_POOL_MAX_SIZE / POOL_GRANULE)
+#define POOL_MAX_CACHED 1024
+
+union poolHeader {
+    size_t sizeClass;
+    char pad[POOL_GRANULE];
+};
+
+struct poolCache {
+    void *head[POOL_NUM_CLASSES];
+    size_t count[POOL_NUM_CLASSES];
+    LALPoolStats stats;
+};
+
+static void PoolCacheTrim(struct poolCache *cache)
+{
+    for (size_t c = 0; c < POOL_NUM_CLASSES; ++c) {
+        while (cache->head[c]) {
+            void *obj = cache->head[c];
+            cache->head[c] = *(void **) obj;
+            free((union poolHeader *) obj - 1);
+        }
+        cache->count[c] = 0;
+    }
+    cache->stats.numCached = 0;
+    cache->stats.cachedBytes = 0;
+}
+
+#ifndef LAL_PTHREAD_LOCK
+
+static struct poolCache poolCacheGlobal;
+
+static struct poolCache *PoolGetCache(void)
+{
+    return &poolCacheGlobal;
+}
+
+#else /* pthread safe code */
+
+/* Note: malloc and free are used here rather than LALMalloc and LALFree,
+ * as for the thread-specific XLAL error number, so that cached objects
+ * are not reported as leaks. */
+
+#include <pthread.h>
+
+static pthread_key_t poolCacheKey;
+static pthread_once_t poolCacheKeyOnce = PTHREAD_ONCE_INIT;
+
+/* routine to free a thread's pool cache when the thread exits */
+static void PoolDestroyCache(void *ptr)
+{
+    PoolCacheTrim(ptr);
+    free(ptr);
+}
+
+/* routine to create the pool cache key */
+static void PoolCreateCacheKey(void)
+{
+    pthread_key_create(&poolCacheKey, PoolDestroyCache);
+}
+
+/* return the pool cache of this thread, or NULL if it cannot be created */
+static struct poolCache *PoolGetCache(void)
+{
+    struct poolCache *cache;
+    pthread_once(&poolCacheKeyOnce, PoolCreateCacheKey);
+    cache = pthread_getspecific(poolCacheKey);
+    if (!cache) {
+        cache = calloc(1, sizeof(*cache));
+        if (cache && pthread_setspecific(poolCacheKey, cache)) {
+            free(cache);
+            cache = NULL;
+        }
+    }
+    return cache;
+}
+
+#endif /* end of pthread-safe code */
+
+/**
+ * Allocates \c n bytes from the calling thread's pool.  The memory is
+ * aligned to 16 bytes and must be freed with XLALPoolFree().
+ */
+void *XLALPoolMalloc(size_t n)
+{
+    struct poolCache *cache = PoolGetCache();
+    size_t c = n > 0 ? (n - 1) / POOL_GRANULE : 0;
+    union poolHeader *h;
+
+    if (cache)
+        ++cache->stats.numAllocs;
+
+    if (c < POOL_NUM_CLASSES) {
+        if (cache && cache->head[c]) {
+            void *obj = cache->head[c];
+            cache->head[c] = *(void **) obj;
+            --cache->count[c];
+            ++cache->stats.numReused;
+            --cache->stats.numCached;
+            cache->stats.cachedBytes -= (c + 1) * POOL_GRANULE;
+            return obj;
+        }
+        n = (c + 1) * POOL_GRANULE;
+    } else {
+        c = POOL_NUM_CLASSES;
+        XLAL_CHECK_NULL(n <= SIZE_MAX - sizeof(*h), XLAL_ENOMEM);
+    }
+
+    h = malloc(sizeof(*h) + n);
+    XLAL_CHECK_NULL(h, XLAL_ENOMEM);
+    h->sizeClass = c;
+    return h + 1;
+}
+
+/** Allocates zeroed memory for \c m objects of \c n bytes from the calling thread's pool. */
+void *XLALPoolCalloc(size_t m, size_t n)
+{
+    void *p;
+    XLAL_CHECK_NULL(n == 0 || m <= SIZE_MAX / n, XLAL_ENOMEM);
+    p = XLALPoolMalloc(m * n);
+    XLAL_CHECK_NULL(p, XLAL_EFUNC);
+    memset(p, 0, m * n);
+    return p;
+}
+
+/**
+ * Frees memory allocated by XLALPoolMalloc() or XLALPoolCalloc().  Small
+ * objects are kept on the calling thread's free list for reuse.  NULL is a
+ * no-op.
+ */
+void XLALPoolFree(void *p)
+{
+    union poolHeader *h;
+    struct poolCache *cache;
+    size_t c;
+
+    if (!p)
+        return;
+    h = (union poolHeader *) p - 1;
+    c = h->sizeClass;
+    cache = PoolGetCache();
+    if (cache)
+        ++cache->stats.numFrees;
+
+    if (c < POOL_NUM_CLASSES && cache && cache->count[c] < POOL_MAX_CACHED) {
+        *(void **) p = cache->head[c];
+        cache->head[c] = p;
+        ++cache->count[c];
+        ++cache->stats.numCached;
+        cache->stats.cachedBytes += (c + 1) * POOL_GRANULE;
+        return;
+    }
+
+    free(h);
+}
+
+/** Returns the objects cached by the calling thread's pool to the system. */
+void XLALPoolTrim(void)
+{
+    struct poolCache *cache = PoolGetCache();
+    if (cache)
+        PoolCacheTrim(cache);
+}
+
+/** Returns usage statistics of the calling thread's pool in \c stats. */
+int XLALPoolGetStats(LALPoolStats *stats)
+{
+    struct poolCache *cache;
+    XLAL_CHECK(stats, XLAL_EFAULT);
+    cache = PoolGetCache();
+    XLAL_CHECK(cache, XLAL_ENOMEM);
+    *stats = cache->stats;
+    return 0;
+}
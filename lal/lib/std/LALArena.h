@@ -0,0 +1,128 @@
+/*
+*  Copyright (C) 2026 Karl Wette
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#ifndef _LALARENA_H
+#define _LALARENA_H
+
+#include <stddef.h>
+#include <lal/LALConfig.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#elif 0
+}       /* so that editors will match preceding brace */
+#endif
+
+/**
+ * \defgroup LALArena_h Header LALArena.h
+ * \ingroup lal_std
+ * \brief Arena and small-object pool allocators.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/LALArena.h>
+ * \endcode
+ *
+ * These allocators are an optional alternative to XLALMalloc() for code
+ * that makes many small, short-lived allocations in a loop, such as
+ * generating a waveform at each step of a sampler.
+ *
+ * A ::LALArena hands out memory from a list of large blocks by advancing a
+ * pointer.  Individual allocations are never freed.  Instead, all memory
+ * allocated since a mark obtained from XLALArenaMark() is released at once
+ * by XLALArenaRelease(), and all memory in the arena by XLALArenaReset().
+ * The blocks are kept for reuse, so once an arena has grown to the size
+ * needed by one iteration of a loop, resetting it at the start of each
+ * iteration makes later iterations free of calls to the system allocator.
+ * An arena is not thread-safe; use one arena per thread.
+ *
+ * \code
+ * LALArena *arena = XLALCreateArena(0);
+ * for (i = 0; i < niter; ++i) {
+ *     XLALArenaReset(arena);
+ *     REAL8 *work = XLALArenaAlloc(arena, n * sizeof(*work));
+ *     ...
+ * }
+ * XLALDestroyArena(arena);
+ * \endcode
+ *
+ * XLALPoolMalloc() and XLALPoolFree() allocate and free small objects
+ * individually.  Freed objects of up to ::LAL_POOL_MAX_SIZE bytes are kept
+ * on a free list private to the calling thread, one per size class, and
+ * reused by later allocations of the same size class in that thread
+ * without locking.  Larger objects go straight to the system allocator.
+ * XLALPoolTrim() returns the calling thread's cached objects to the system;
+ * this is done automatically when a thread exits.
+ *
+ * Both allocators obtain memory from the system directly, so allocations
+ * made from them are not seen by the memory debugging of XLALMalloc(); the
+ * arenas themselves are.  Usage statistics are available from
+ * XLALArenaGetStats() and XLALPoolGetStats().
+ */
+/** @{ */
+
+/** Largest object size, in bytes, cached by the pool allocator */
+#define LAL_POOL_MAX_SIZE 512
+
+/** Opaque arena allocator */
+typedef struct tagLALArena LALArena;
+
+/** Usage statistics of an arena */
+typedef struct tagLALArenaStats {
+    size_t numBlocks;   /**< Number of blocks held by the arena */
+    size_t capacity;    /**< Total size of the blocks, in bytes */
+    size_t used;        /**< Bytes currently allocated, including alignment padding */
+    size_t peak;        /**< Largest value of \c used since the arena was created */
+    size_t numAllocs;   /**< Number of allocations since the arena was created */
+    size_t numResets;   /**< Number of calls to XLALArenaReset() */
+} LALArenaStats;
+
+/** Usage statistics of the calling thread's pool */
+typedef struct tagLALPoolStats {
+    size_t numAllocs;   /**< Number of calls to XLALPoolMalloc() */
+    size_t numReused;   /**< Number of allocations served from a free list */
+    size_t numFrees;    /**< Number of calls to XLALPoolFree() */
+    size_t numCached;   /**< Number of freed objects currently on the free lists */
+    size_t cachedBytes; /**< Total size of the objects on the free lists, in bytes */
+} LALPoolStats;
+
+LALArena *XLALCreateArena(size_t blockSize);
+void XLALDestroyArena(LALArena *arena);
+void *XLALArenaAlloc(LALArena *arena, size_t n);
+void *XLALArenaCalloc(LALArena *arena, size_t m, size_t n);
+size_t XLALArenaMark(const LALArena *arena);
+int XLALArenaRelease(LALArena *arena, size_t mark);
+int XLALArenaReset(LALArena *arena);
+int XLALArenaGetStats(const LALArena *arena, LALArenaStats *stats);
+
+void *XLALPoolMalloc(size_t n);
+void *XLALPoolCalloc(size_t m, size_t n);
+void XLALPoolFree(void *p);
+void XLALPoolTrim(void);
+int XLALPoolGetStats(LALPoolStats *stats);
+
+/** @} */
+
+#if 0
+{       /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+#endif /* _LALARENA_H */
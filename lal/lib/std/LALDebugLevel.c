@@ -91,6 +91,8 @@ static void XLALSetDebugLevel(void)
                 level |= LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT; /* enable memory debugging tools */
             } else if (XLALStringNCaseCompare("MEMTRACE", token, toklen) == 0) {
                 level |= LALTRACEBIT | LALMEMDBG | LALMEMINFOBIT; /* enable memory tracing tools */
+            } else if (XLALStringNCaseCompare("MEMSTAT", token, toklen) == 0) {
+                level |= LALMEMDBGBIT | LALMEMSTATBIT; /* enable memory statistics only */
             } else if (XLALStringNCaseCompare("ALLDBG", token, toklen) == 0) {
                 level |= ~LALNDEBUG; /* enable all debugging */
             } else {
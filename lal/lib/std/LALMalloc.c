@@ -27,6 +27,7 @@
 #include <lal/LALMalloc.h>
 #include <lal/LALStdio.h>
 #include <lal/LALError.h>
+#include <lal/Window.h>
 
 /* global variables */
 size_t lalMallocTotal = 0;	/**< current amount of memory allocated by process */
@@ -217,15 +218,101 @@ void XLALFreeAligned(void *ptr)
 
 #if ! defined NDEBUG
 
+#include <stdint.h>
+#include <lal/LALStdlib.h>
+
+/*
+ * Locking.  The allocation table is split into shards, each protected by
+ * its own mutex, so that threads allocating and freeing different memory
+ * rarely contend.  The running totals and the call-site statistics are
+ * counters which are updated with C11 atomic operations, if available,
+ * and otherwise under a single mutex.
+ */
+
 #ifdef LAL_PTHREAD_LOCK
 #include <pthread.h>
-static pthread_mutex_t mut = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK(l)     pthread_mutex_lock(&(l))
+#define UNLOCK(l)   pthread_mutex_unlock(&(l))
 #else
-#define pthread_mutex_lock( pmut )
-#define pthread_mutex_unlock( pmut )
+#define LOCK(l)
+#define UNLOCK(l)
 #endif
 
-#include <lal/LALStdlib.h>
+#if defined(HAVE_STDATOMIC_H) && !defined(__STDC_NO_ATOMICS__)
+#define LAL_MALLOC_ATOMICS 1
+#include <stdatomic.h>
+#define ATOMIC_SIZE(x)     ((_Atomic size_t *) &(x))
+#else
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t counter_mut = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#endif
+
+/* add n to *x, and return the new value */
+static size_t AtomicAdd(size_t *x, size_t n)
+{
+#ifdef LAL_MALLOC_ATOMICS
+    return atomic_fetch_add_explicit(ATOMIC_SIZE(*x), n, memory_order_relaxed) + n;
+#else
+    size_t value;
+    LOCK(counter_mut);
+    value = (*x += n);
+    UNLOCK(counter_mut);
+    return value;
+#endif
+}
+
+/* subtract n from *x */
+static void AtomicSub(size_t *x, size_t n)
+{
+#ifdef LAL_MALLOC_ATOMICS
+    atomic_fetch_sub_explicit(ATOMIC_SIZE(*x), n, memory_order_relaxed);
+#else
+    LOCK(counter_mut);
+    *x -= n;
+    UNLOCK(counter_mut);
+#endif
+}
+
+/* return the value of *x */
+static size_t AtomicLoad(const size_t *x)
+{
+#ifdef LAL_MALLOC_ATOMICS
+    return atomic_load_explicit((const _Atomic size_t *) x, memory_order_relaxed);
+#else
+    size_t value;
+    LOCK(counter_mut);
+    value = *x;
+    UNLOCK(counter_mut);
+    return value;
+#endif
+}
+
+/* raise *peak to at least value */
+static void AtomicMax(size_t *peak, size_t value)
+{
+#ifdef LAL_MALLOC_ATOMICS
+    size_t old = atomic_load_explicit(ATOMIC_SIZE(*peak), memory_order_relaxed);
+    while (old < value && !atomic_compare_exchange_weak_explicit(ATOMIC_SIZE(*peak), &old, value, memory_order_relaxed, memory_order_relaxed)) {
+    }
+#else
+    LOCK(counter_mut);
+    if (*peak < value) {
+        *peak = value;
+    }
+    UNLOCK(counter_mut);
+#endif
+}
+
+static void AddTotal(size_t n)
+{
+    AtomicMax(&lalMallocTotalPeak, AtomicAdd(&lalMallocTotal, n));
+}
+
+static void SubTotal(size_t n)
+{
+    AtomicSub(&lalMallocTotal, n);
+}
 
 /* global variables to assist in memory debugging */
 /* watch the value of these variables to find a particular alloc/free */
@@ -250,25 +337,55 @@ static const size_t magic = 0xABadCafe;
 
 /* Hash table implementation taken from src/utilities/LALHashTbl.c */
 
-static struct allocNode {
+struct allocNode {
     void *addr;
     size_t size;
     const char *file;
     int line;
-} **alloc_data = NULL;		/* Allocation hash table with open addressing and linear probing */
-static int alloc_data_len = 0;	/* Size of the memory block 'alloc_data', in number of elements */
-static int alloc_n = 0;		/* Number of valid elements in the hash */
-static int alloc_q = 0;		/* Number of non-NULL elements in the hash */
+};
+
+/* One shard of the allocation hash table, with open addressing and linear probing */
+struct allocShard {
+    struct allocNode **data;	/* Hash table */
+    int data_len;		/* Size of the memory block 'data', in number of elements */
+    int n;			/* Number of valid elements in the hash */
+    int q;			/* Number of non-NULL elements in the hash */
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_t lock;	/* Mutex protecting this shard */
+#endif
+};
+
+#define NSHARDS 64
+static struct allocShard alloc_shards[NSHARDS];
+
+#ifdef LAL_PTHREAD_LOCK
+/* Initialise the mutexes of the allocation hash table shards */
+static pthread_once_t alloc_shards_once = PTHREAD_ONCE_INIT;
+static void AllocShardsInit(void)
+{
+    for (int k = 0; k < NSHARDS; ++k) {
+        pthread_mutex_init(&alloc_shards[k].lock, NULL);
+    }
+}
+#define SHARDS_INIT() pthread_once(&alloc_shards_once, AllocShardsInit)
+#else
+#define SHARDS_INIT()
+#endif
 
 /* Special allocation hash table element value to indicate elements that have been deleted */
 static const void *hash_del = 0;
 #define DEL   ((struct allocNode*) &hash_del)
 
-/* Evaluates to the hash value of x, restricted to the length of the allocation hash table */
-#define HASHIDX(x)   ((int)( ((intptr_t)( (x)->addr )) % alloc_data_len ))
+/* Mix the bits of an address; the top bits select the shard, the next
+ * ones the position in the shard's hash table */
+#define ADDRHASH(a)   ((uint64_t)(((uintptr_t)(a)) >> 4) * UINT64_C(0x9E3779B97F4A7C15))
+#define SHARD(a)      (&alloc_shards[ADDRHASH(a) >> 58])
 
-/* Increment the next hash index, restricted to the length of the allocation hash table */
-#define INCRIDX(i)   do { if (++(i) == alloc_data_len) { (i) = 0; } } while(0)
+/* Evaluates to the hash value of x, restricted to the length of the shard's hash table */
+#define HASHIDX(s, x)   ((int)((ADDRHASH((x)->addr) >> 32) % (uint64_t)(s)->data_len))
+
+/* Increment the next hash index, restricted to the length of the shard's hash table */
+#define INCRIDX(s, i)   do { if (++(i) == (s)->data_len) { (i) = 0; } } while(0)
 
 /* Evaluates true if the elements x and y are equal */
 #define EQUAL(x, y)   ((x)->addr == (y)->addr)
@@ -280,101 +397,116 @@ static const void *hash_del = 0;
 #define UNUSED
 #endif
 
-/* Resize and rebuild the allocation allocation hash table */
-UNUSED static int AllocHashTblResize(void)
+/* Resize and rebuild a shard of the allocation hash table */
+UNUSED static int AllocHashTblResize(struct allocShard *s)
 {
-    struct allocNode **old_data = alloc_data;
-    int old_data_len = alloc_data_len;
-    alloc_data_len = 2;
-    while (alloc_data_len < 3*alloc_n) {
-        alloc_data_len *= 2;
+    struct allocNode **old_data = s->data;
+    int old_data_len = s->data_len;
+    int new_data_len = 2;
+    while (new_data_len < 3*s->n) {
+        new_data_len *= 2;
     }
-    alloc_data = calloc(alloc_data_len, sizeof(alloc_data[0]));
-    if (alloc_data == NULL) {
+    struct allocNode **new_data = calloc(new_data_len, sizeof(new_data[0]));
+    if (new_data == NULL) {
         return 0;
     }
-    alloc_q = alloc_n;
+    s->data = new_data;
+    s->data_len = new_data_len;
+    s->q = s->n;
     for (int k = 0; k < old_data_len; ++k) {
         if (old_data[k] != NULL && old_data[k] != DEL) {
-            int i = HASHIDX(old_data[k]);
-            while (alloc_data[i] != NULL) {
-                INCRIDX(i);
+            int i = HASHIDX(s, old_data[k]);
+            while (s->data[i] != NULL) {
+                INCRIDX(s, i);
             }
-            alloc_data[i] = old_data[k];
+            s->data[i] = old_data[k];
         }
     }
     free(old_data);
     return 1;
 }
 
-/* Find node in allocation hash table */
-UNUSED static struct allocNode *AllocHashTblFind(struct allocNode *x)
+/* Find node in a shard of the allocation hash table */
+UNUSED static struct allocNode *AllocHashTblFind(struct allocShard *s, struct allocNode *x)
 {
     struct allocNode *y = NULL;
-    if (alloc_data_len > 0) {
-        int i = HASHIDX(x);
-        while (alloc_data[i] != NULL) {
-            y = alloc_data[i];
+    if (s->data_len > 0) {
+        int i = HASHIDX(s, x);
+        while (s->data[i] != NULL) {
+            y = s->data[i];
             if (y != DEL && EQUAL(x, y)) {
                 return y;
             }
-            INCRIDX(i);
+            INCRIDX(s, i);
         }
     }
     return NULL;
 }
 
-/* Add node to allocation hash table */
-UNUSED static int AllocHashTblAdd(struct allocNode *x)
+/* Add node to a shard of the allocation hash table */
+UNUSED static int AllocHashTblAdd(struct allocShard *s, struct allocNode *x)
 {
-    if (2*(alloc_q + 1) > alloc_data_len) {
+    if (2*(s->q + 1) > s->data_len) {
         /* Resize allocation hash table to preserve maximum 50% occupancy */
-        if (!AllocHashTblResize()) {
+        if (!AllocHashTblResize(s)) {
             return 0;
         }
     }
-    int i = HASHIDX(x);
-    while (alloc_data[i] != NULL && alloc_data[i] != DEL) {
-        INCRIDX(i);
+    int i = HASHIDX(s, x);
+    while (s->data[i] != NULL && s->data[i] != DEL) {
+        INCRIDX(s, i);
     }
-    if (alloc_data[i] == NULL) {
-        ++alloc_q;
+    if (s->data[i] == NULL) {
+        ++s->q;
     }
-    ++alloc_n;
-    alloc_data[i] = x;
+    ++s->n;
+    s->data[i] = x;
     return 1;
 }
 
-/* Extract node from allocation hash table */
-UNUSED static struct allocNode *AllocHashTblExtract(struct allocNode *x)
+/* Extract node from a shard of the allocation hash table */
+UNUSED static struct allocNode *AllocHashTblExtract(struct allocShard *s, struct allocNode *x)
 {
-    if (alloc_data_len > 0) {
-        int i = HASHIDX(x);
-        while (alloc_data[i] != NULL) {
-            struct allocNode *y = alloc_data[i];
+    if (s->data_len > 0) {
+        int i = HASHIDX(s, x);
+        while (s->data[i] != NULL) {
+            struct allocNode *y = s->data[i];
             if (y != DEL && EQUAL(x, y)) {
-                alloc_data[i] = DEL;
-                --alloc_n;
-                if (alloc_n == 0) {
+                s->data[i] = DEL;
+                --s->n;
+                if (s->n == 0) {
                     /* Free all hash table memory */
-                    free(alloc_data);
-                    alloc_data = NULL;
-                    alloc_data_len = 0;
-                    alloc_q = 0;
-                } else if (8*alloc_n < alloc_data_len) {
+                    free(s->data);
+                    s->data = NULL;
+                    s->data_len = 0;
+                    s->q = 0;
+                } else if (8*s->n < s->data_len) {
                     /* Resize hash table to preserve minimum 50% occupancy */
-                    if (!AllocHashTblResize()) {
+                    if (!AllocHashTblResize(s)) {
                         return NULL;
                     }
                 }
                 return y;
             }
-            INCRIDX(i);
+            INCRIDX(s, i);
         }
     }
     return NULL;
 }
 
+/* Total number of tracked allocations */
+static int AllocCount(void)
+{
+    int count = 0;
+    SHARDS_INIT();
+    for (int k = 0; k < NSHARDS; ++k) {
+        LOCK(alloc_shards[k].lock);
+        count += alloc_shards[k].n;
+        UNLOCK(alloc_shards[k].lock);
+    }
+    return count;
+}
+
 
 /* Useful function for debugging */
 /* Checks to make sure alloc list is OK */
@@ -383,13 +515,16 @@ UNUSED static int CheckAllocList(void)
 {
     int count = 0;
     size_t total = 0;
-    for (int k = 0; k < alloc_data_len; ++k) {
-        if (alloc_data[k] != NULL && alloc_data[k] != DEL) {
-            ++count;
-            total += alloc_data[k]->size;
+    for (int j = 0; j < NSHARDS; ++j) {
+        struct allocShard *s = &alloc_shards[j];
+        for (int k = 0; k < s->data_len; ++k) {
+            if (s->data[k] != NULL && s->data[k] != DEL) {
+                ++count;
+                total += s->data[k]->size;
+            }
         }
     }
-    return count == alloc_n && total == lalMallocTotal;
+    return count == AllocCount() && total == lalMallocTotal;
 }
 
 /* Useful function for debugging */
@@ -398,7 +533,131 @@ UNUSED static int CheckAllocList(void)
 UNUSED static struct allocNode *FindAlloc(void *p)
 {
     struct allocNode key = { .addr = p };
-    return AllocHashTblFind(&key);
+    return AllocHashTblFind(SHARD(p), &key);
+}
+
+
+/*
+ * Call-site statistics.  Each call site (file and line) gets an entry in a
+ * fixed-size table, which is searched without locking if atomic operations
+ * are available; the insertion of a new call site takes a lock.  Call sites
+ * which do not fit in the table share one entry.  When statistics are enabled, each
+ * allocation is preceded by a header recording its call site and size, so
+ * that freeing it needs no table lookup.
+ */
+
+#define NSITES 4096
+
+struct allocSite {
+    const char *file;
+    int line;
+    size_t live;	/* bytes currently allocated */
+    size_t peak;	/* largest value of live */
+    size_t count;	/* number of allocations */
+};
+
+static struct allocSite alloc_sites[NSITES];
+static struct allocSite alloc_site_other = { "(other call sites)", 0, 0, 0, 0 };
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t alloc_sites_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+struct statHeader {
+    struct allocSite *site;
+    size_t size;
+};
+
+#define statsz ((lalDebugLevel & LALMEMSTATBIT) ? sizeof(struct statHeader) : 0)
+
+static struct allocSite *FindSite(const char *file, int line)
+{
+    uint64_t h = ((uint64_t)(uintptr_t) file + UINT64_C(0x9E3779B97F4A7C15) * (uint64_t) line) * UINT64_C(0x9E3779B97F4A7C15);
+    int i0 = (int)(h >> 52), i;
+    if (file == NULL) {
+        file = "unknown";
+    }
+#ifdef LAL_MALLOC_ATOMICS
+    /* lock-free search */
+    for (i = i0; ; ) {
+        const char *f = atomic_load_explicit((_Atomic(const char *) *) &alloc_sites[i].file, memory_order_acquire);
+        if (f == NULL) {
+            break;
+        }
+        if (f == file && alloc_sites[i].line == line) {
+            return &alloc_sites[i];
+        }
+        if (++i == NSITES) {
+            i = 0;
+        }
+        if (i == i0) {
+            return &alloc_site_other;
+        }
+    }
+#endif
+    /* not found: search again under the lock, and insert */
+    struct allocSite *site = &alloc_site_other;
+    LOCK(alloc_sites_lock);
+    for (i = i0; ; ) {
+        const char *f = alloc_sites[i].file;
+        if (f == NULL) {
+            alloc_sites[i].line = line;
+#ifdef LAL_MALLOC_ATOMICS
+            atomic_store_explicit((_Atomic(const char *) *) &alloc_sites[i].file, file, memory_order_release);
+#else
+            alloc_sites[i].file = file;
+#endif
+            site = &alloc_sites[i];
+            break;
+        }
+        if (f == file && alloc_sites[i].line == line) {
+            site = &alloc_sites[i];
+            break;
+        }
+        if (++i == NSITES) {
+            i = 0;
+        }
+        if (i == i0) {
+            break;
+        }
+    }
+    UNLOCK(alloc_sites_lock);
+    return site;
+}
+
+static void *StatAlloc(void *p, size_t n, const char *file, int line)
+{
+    struct statHeader *h = p;
+    if (!(lalDebugLevel & LALMEMSTATBIT)) {
+        return p;
+    }
+    if (!p) {
+        return NULL;
+    }
+    h->site = FindSite(file, line);
+    h->size = n;
+    AtomicMax(&h->site->peak, AtomicAdd(&h->site->live, n));
+    AtomicAdd(&h->site->count, 1);
+    if (!(lalDebugLevel & LALMEMPADBIT)) {
+        AddTotal(n);
+    }
+    return h + 1;
+}
+
+static void *UnStatAlloc(void *p)
+{
+    struct statHeader *h;
+    if (!(lalDebugLevel & LALMEMSTATBIT)) {
+        return p;
+    }
+    if (!p) {
+        return NULL;
+    }
+    h = ((struct statHeader *) p) - 1;
+    AtomicSub(&h->site->live, h->size);
+    if (!(lalDebugLevel & LALMEMPADBIT)) {
+        SubTotal(h->size);
+    }
+    return h;
 }
 
 
@@ -428,10 +687,7 @@ static void *PadAlloc(size_t * p, size_t n, int keep, const char *func)
         ((char *) p)[i + prefix] = (char) (i ^ padding);
     }
 
-    pthread_mutex_lock(&mut);
-    lalMallocTotal += n;
-    lalMallocTotalPeak = (lalMallocTotalPeak > lalMallocTotal) ? lalMallocTotalPeak : lalMallocTotal;
-    pthread_mutex_unlock(&mut);
+    AddTotal(n);
 
     return (void *) (((char *) p) + prefix);
 }
@@ -495,7 +751,7 @@ static void *UnPadAlloc(void *p, int keep, const char *func)
     }
 
     /* see if there is enough allocated memory to be freed */
-    if (lalMallocTotal < n) {
+    if (AtomicLoad(&lalMallocTotal) < n) {
         lalRaiseHook(SIGSEGV, "%s error: lalMallocTotal too small\n",
                      func);
         return NULL;
@@ -509,9 +765,7 @@ static void *UnPadAlloc(void *p, int keep, const char *func)
     q[0] = -1;  /* set negative to detect duplicate frees */
     q[1] = ~magic;
 
-    pthread_mutex_lock(&mut);
-    lalMallocTotal -= n;
-    pthread_mutex_unlock(&mut);
+    SubTotal(n);
 
     return q;
 }
@@ -520,6 +774,8 @@ static void *UnPadAlloc(void *p, int keep, const char *func)
 static void *PushAlloc(void *p, size_t n, const char *file, int line)
 {
     struct allocNode *newnode;
+    struct allocShard *s;
+    int ok;
     if (!(lalDebugLevel & LALMEMTRKBIT)) {
         return p;
     }
@@ -529,16 +785,19 @@ static void *PushAlloc(void *p, size_t n, const char *file, int line)
     if (!(newnode = malloc(sizeof(*newnode)))) {
         return NULL;
     }
-    pthread_mutex_lock(&mut);
     newnode->addr = p;
     newnode->size = n;
     newnode->file = file;
     newnode->line = line;
-    if (!AllocHashTblAdd(newnode)) {
+    SHARDS_INIT();
+    s = SHARD(p);
+    LOCK(s->lock);
+    ok = AllocHashTblAdd(s, newnode);
+    UNLOCK(s->lock);
+    if (!ok) {
         free(newnode);
         return NULL;
     }
-    pthread_mutex_unlock(&mut);
     return p;
 }
 
@@ -551,16 +810,17 @@ static void *PopAlloc(void *p, const char *func)
     if (!p) {
         return NULL;
     }
-    pthread_mutex_lock(&mut);
+    SHARDS_INIT();
+    struct allocShard *s = SHARD(p);
     struct allocNode key = { .addr = p };
-    struct allocNode *node = AllocHashTblExtract(&key);
+    LOCK(s->lock);
+    struct allocNode *node = AllocHashTblExtract(s, &key);
+    UNLOCK(s->lock);
     if (node == NULL) {
-        pthread_mutex_unlock(&mut);
         lalRaiseHook(SIGSEGV, "%s error: alloc %p not found\n", func, p);
         return NULL;
     }
     free(node);
-    pthread_mutex_unlock(&mut);
     return p;
 }
 
@@ -574,11 +834,14 @@ static void *ModAlloc(void *p, void *q, size_t n, const char *func,
     if (!p || !q) {
         return NULL;
     }
-    pthread_mutex_lock(&mut);
+    SHARDS_INIT();
+    struct allocShard *s = SHARD(p);
     struct allocNode key = { .addr = p };
-    struct allocNode *node = AllocHashTblExtract(&key);
+    int ok;
+    LOCK(s->lock);
+    struct allocNode *node = AllocHashTblExtract(s, &key);
+    UNLOCK(s->lock);
     if (node == NULL) {
-        pthread_mutex_unlock(&mut);
         lalRaiseHook(SIGSEGV, "%s error: alloc %p not found\n", func, p);
         return NULL;
     }
@@ -586,11 +849,14 @@ static void *ModAlloc(void *p, void *q, size_t n, const char *func,
     node->size = n;
     node->file = file;
     node->line = line;
-    if (!AllocHashTblAdd(node)) {
+    s = SHARD(q);
+    LOCK(s->lock);
+    ok = AllocHashTblAdd(s, node);
+    UNLOCK(s->lock);
+    if (!ok) {
         free(node);
         return NULL;
     }
-    pthread_mutex_unlock(&mut);
     return q;
 }
 
@@ -612,8 +878,8 @@ void *LALMallocLong(size_t n, const char *file, int line)
         return malloc(n);
     }
 
-    p = malloc(allocsz(n));
-    q = PushAlloc(PadAlloc(p, n, 0, "LALMalloc"), n, file, line);
+    p = malloc(statsz + allocsz(n));
+    q = PushAlloc(PadAlloc(StatAlloc(p, n, file, line), n, 0, "LALMalloc"), n, file, line);
     lalMemDbgPtr = lalMemDbgRetPtr = q;
     lalIsMemDbgPtr = lalIsMemDbgRetPtr = (lalMemDbgRetPtr == lalMemDbgUsrPtr);
     if (!q) {
@@ -650,8 +916,8 @@ void *LALCallocLong(size_t m, size_t n, const char *file, int line)
     }
 
     sz = m * n;
-    p = malloc(allocsz(sz));
-    q = PushAlloc(PadAlloc(p, sz, 1, "LALCalloc"), sz, file, line);
+    p = malloc(statsz + allocsz(sz));
+    q = PushAlloc(PadAlloc(StatAlloc(p, sz, file, line), sz, 1, "LALCalloc"), sz, file, line);
     lalMemDbgPtr = lalMemDbgRetPtr = q;
     lalIsMemDbgPtr = lalIsMemDbgRetPtr = (lalMemDbgRetPtr == lalMemDbgUsrPtr);
     if (!q) {
@@ -686,8 +952,8 @@ void *LALReallocLong(void *q, size_t n, const char *file, const int line)
     lalMemDbgPtr = lalMemDbgArgPtr = q;
     lalIsMemDbgPtr = lalIsMemDbgArgPtr = (lalMemDbgArgPtr == lalMemDbgUsrPtr);
     if (!q) {
-        p = malloc(allocsz(n));
-        q = PushAlloc(PadAlloc(p, n, 0, "LALRealloc"), n, file, line);
+        p = malloc(statsz + allocsz(n));
+        q = PushAlloc(PadAlloc(StatAlloc(p, n, file, line), n, 0, "LALRealloc"), n, file, line);
         if (!q) {
             XLALPrintError("LALMalloc: failed to allocate %zd bytes of memory\n", n);
             XLALPrintError("LALMalloc: %zd bytes of memory already allocated\n", lalMallocTotal);
@@ -702,19 +968,19 @@ void *LALReallocLong(void *q, size_t n, const char *file, const int line)
     }
 
     if (!n) {
-        p = UnPadAlloc(PopAlloc(q, "LALRealloc"), 0, "LALRealloc");
+        p = UnStatAlloc(UnPadAlloc(PopAlloc(q, "LALRealloc"), 0, "LALRealloc"));
         if (p) {
             free(p);
         }
         return NULL;
     }
 
-    p = UnPadAlloc(q, 1, "LALRealloc");
+    p = UnStatAlloc(UnPadAlloc(q, 1, "LALRealloc"));
     if (!p) {
         return NULL;
     }
 
-    q = ModAlloc(q, PadAlloc(realloc(p, allocsz(n)), n, 1, "LALRealloc"), n, "LALRealloc", file, line);
+    q = ModAlloc(q, PadAlloc(StatAlloc(realloc(p, statsz + allocsz(n)), n, file, line), n, 1, "LALRealloc"), n, "LALRealloc", file, line);
     lalMemDbgPtr = lalMemDbgRetPtr = q;
     lalIsMemDbgPtr = lalIsMemDbgRetPtr = (lalMemDbgRetPtr == lalMemDbgUsrPtr);
 
@@ -734,7 +1000,7 @@ void LALFree(void *q)
     }
     lalMemDbgPtr = lalMemDbgArgPtr = q;
     lalIsMemDbgPtr = lalIsMemDbgArgPtr = (lalMemDbgArgPtr == lalMemDbgUsrPtr);
-    p = UnPadAlloc(PopAlloc(q, "LALFree"), 0, "LALFree");
+    p = UnStatAlloc(UnPadAlloc(PopAlloc(q, "LALFree"), 0, "LALFree"));
     if (p) {
         free(p);
     }
@@ -750,22 +1016,48 @@ void LALCheckMemoryLeaks(void)
         return;
     }
 
-    /* alloc_data_len should be zero */
-    if ((lalDebugLevel & LALMEMTRKBIT) && alloc_data_len > 0) {
+    /* free windows cached by LAL, which are not owned by the caller */
+    XLALClearWindowCache();
+
+    /* allocation hash table should be empty */
+    if ((lalDebugLevel & LALMEMTRKBIT) && AllocCount() > 0) {
         XLALPrintError("LALCheckMemoryLeaks: allocation list\n");
-        for (int k = 0; k < alloc_data_len; ++k) {
-            if (alloc_data[k] != NULL && alloc_data[k] != DEL) {
-                XLALPrintError("%p: %zu bytes (%s:%d)\n", alloc_data[k]->addr,
-                               alloc_data[k]->size, alloc_data[k]->file,
-                               alloc_data[k]->line);
+        SHARDS_INIT();
+        for (int j = 0; j < NSHARDS; ++j) {
+            struct allocShard *s = &alloc_shards[j];
+            LOCK(s->lock);
+            for (int k = 0; k < s->data_len; ++k) {
+                if (s->data[k] != NULL && s->data[k] != DEL) {
+                    XLALPrintError("%p: %zu bytes (%s:%d)\n", s->data[k]->addr,
+                                   s->data[k]->size, s->data[k]->file,
+                                   s->data[k]->line);
+                }
             }
+            UNLOCK(s->lock);
         }
         leak = 1;
     }
 
-    /* lalMallocTotal and alloc_n should be zero */
-    if ((lalDebugLevel & LALMEMPADBIT) && (lalMallocTotal || alloc_n)) {
-        XLALPrintError("LALCheckMemoryLeaks: %d allocs, %zd bytes\n", alloc_n, lalMallocTotal);
+    /* no call site should have live allocations */
+    if (lalDebugLevel & LALMEMSTATBIT) {
+        int header = 0;
+        for (int k = 0; k <= NSITES; ++k) {
+            const struct allocSite *site = (k < NSITES) ? &alloc_sites[k] : &alloc_site_other;
+            size_t live = AtomicLoad(&site->live);
+            if (live > 0) {
+                if (!header) {
+                    XLALPrintError("LALCheckMemoryLeaks: call sites with live allocations\n");
+                    header = 1;
+                }
+                XLALPrintError("%s:%d: %zu bytes\n", site->file, site->line, live);
+                leak = 1;
+            }
+        }
+    }
+
+    /* lalMallocTotal and number of allocations should be zero */
+    if ((lalDebugLevel & (LALMEMPADBIT | LALMEMSTATBIT)) && (lalMallocTotal || AllocCount())) {
+        XLALPrintError("LALCheckMemoryLeaks: %d allocs, %zd bytes\n", AllocCount(), lalMallocTotal);
         leak = 1;
     }
 
@@ -779,8 +1071,32 @@ void LALCheckMemoryLeaks(void)
     return;
 }
 
+
+
+void XLALPrintMemoryStatistics(void)
+{
+    if (!(lalDebugLevel & LALMEMSTATBIT)) {
+        XLALPrintError("XLALPrintMemoryStatistics: memory statistics are not enabled\n");
+        return;
+    }
+    XLALPrintError("XLALPrintMemoryStatistics: %zu bytes live, %zu bytes peak\n",
+                   lalMallocTotal, lalMallocTotalPeak);
+    XLALPrintError("%12s %12s %12s  %s\n", "live", "peak", "count", "call site");
+    for (int k = 0; k <= NSITES; ++k) {
+        const struct allocSite *site = (k < NSITES) ? &alloc_sites[k] : &alloc_site_other;
+        size_t count = AtomicLoad(&site->count);
+        if (count > 0) {
+            XLALPrintError("%12zu %12zu %12zu  %s:%d\n",
+                           AtomicLoad(&site->live),
+                           AtomicLoad(&site->peak),
+                           count, site->file, site->line);
+        }
+    }
+}
+
 #else
 
 void (LALCheckMemoryLeaks)(void) { return; }
+void (XLALPrintMemoryStatistics)(void) { return; }
 
 #endif /* ! defined NDEBUG */
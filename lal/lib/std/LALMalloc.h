@@ -81,6 +81,7 @@ void XLALFreeAligned(void *ptr);
 #define LALReallocLong( p, n, file, line ) realloc( p, n )
 #define LALFree                            free
 #define LALCheckMemoryLeaks()
+#define XLALPrintMemoryStatistics()
 #endif /* SWIG */
 
 #else
@@ -118,6 +119,7 @@ void *LALReallocLong(void *p, size_t n, const char *file, int line);
 #endif /* NDEBUG  */
 
 void (LALCheckMemoryLeaks) (void);
+void (XLALPrintMemoryStatistics) (void);
 
 #if 0
 {       /* so that editors will match succeeding brace */
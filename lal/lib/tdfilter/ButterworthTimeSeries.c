@@ -199,8 +199,8 @@
  *
  * Each ZPG filter in the \f$w\f$-plane is first transformed to the \f$z\f$-plane
  * by a bilinear transformation, and is then used to construct a
- * time-domain IIR filter.  Each filter is then applied to the time
- * series.  As mentioned in the description above, the filters are
+ * time-domain second-order section (see \ref SOSFilter_c).  Each filter
+ * is then applied to the time series.  As mentioned in the description above, the filters are
  * designed to give an overall amplitude response that is the square root
  * of the desired attenuation; however, each time-domain filter is
  * applied to the data stream twice: once in the normal sense, and once
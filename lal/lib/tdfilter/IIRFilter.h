@@ -123,6 +123,7 @@ extern "C" {
  * \defgroup IIRFilter_c 		Module IIRFilter.c
  * \defgroup IIRFilterVector_c 	Module IIRFilterVector.c
  * \defgroup IIRFilterVectorR_c 	Module IIRFilterVectorR.c
+ * \defgroup SOSFilter_c 		Module SOSFilter.c
  * @}
  */
 
@@ -189,6 +190,23 @@ typedef struct tagCOMPLEX16IIRFilter{
   COMPLEX16Vector *history;    /**< The previous values of w. */
 } COMPLEX16IIRFilter;
 
+/**
+ * This structure stores a REAL8 filter as a cascade of second-order
+ * sections, as well as the history of each section for each data channel;
+ * see \ref SOSFilter_c.
+ */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IMMUTABLE_MEMBERS(tagREAL8SOSFilter, name));
+#endif /* SWIG */
+typedef struct tagREAL8SOSFilter{
+  const CHAR *name;        /**< User assigned name. */
+  REAL8 deltaT;            /**< Sampling time interval of the filter; If \f$\leq0\f$, it will be ignored (ie it will be taken from the data stream). */
+  UINT4 numSections;       /**< The number of second-order sections. */
+  UINT4 numChannels;       /**< The number of data channels the history is kept for. */
+  REAL8Vector *coef;       /**< The coefficients \f$b_0, b_1, b_2, a_1, a_2\f$ of each section. */
+  REAL8Vector *history;    /**< The two state variables of each section for each channel. */
+} REAL8SOSFilter;
+
 /** @} */
 
 /* Function prototypes. */
@@ -208,6 +226,20 @@ int XLALIIRFilterReverseREAL8Vector( REAL8Vector *vector, REAL8IIRFilter *filter
 int XLALIIRFilterReverseCOMPLEX8Vector( COMPLEX8Vector *vector, COMPLEX16IIRFilter *filter );
 int XLALIIRFilterReverseCOMPLEX16Vector( COMPLEX16Vector *vector, COMPLEX16IIRFilter *filter );
 
+REAL8SOSFilter *XLALCreateREAL8SOSFilter( COMPLEX16ZPGFilter *input, UINT4 numChannels );
+void XLALDestroyREAL8SOSFilter( REAL8SOSFilter *filter );
+int XLALResetREAL8SOSFilter( REAL8SOSFilter *filter );
+int XLALSOSFilterREAL4Vector( REAL4Vector *vector, REAL8SOSFilter *filter );
+int XLALSOSFilterREAL8Vector( REAL8Vector *vector, REAL8SOSFilter *filter );
+int XLALSOSFilterREAL4VectorSequence( REAL4VectorSequence *sequence, REAL8SOSFilter *filter );
+int XLALSOSFilterREAL8VectorSequence( REAL8VectorSequence *sequence, REAL8SOSFilter *filter );
+int XLALSOSFilterZeroPhaseREAL4Vector( REAL4Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFilterZeroPhaseREAL8Vector( REAL8Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFilterZeroPhaseCOMPLEX8Vector( COMPLEX8Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFilterZeroPhaseCOMPLEX16Vector( COMPLEX16Vector *vector, const REAL8SOSFilter *filter );
+int XLALSOSFilterZeroPhaseREAL4VectorSequence( REAL4VectorSequence *sequence, const REAL8SOSFilter *filter );
+int XLALSOSFilterZeroPhaseREAL8VectorSequence( REAL8VectorSequence *sequence, const REAL8SOSFilter *filter );
+
 REAL4 XLALIIRFilterREAL4( REAL4 x, REAL8IIRFilter *filter );
 REAL8 XLALIIRFilterREAL8( REAL8 x, REAL8IIRFilter *filter );
 /* WARNING: THIS FUNCTION IS OBSOLETE */
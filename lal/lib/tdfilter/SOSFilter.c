@@ -0,0 +1,489 @@
+/*
+*  Copyright (C) 2026 Jolien Creighton
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <complex.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/IIRFilter.h>
+
+/**
+ * \addtogroup SOSFilter_c
+ *
+ * \brief Creates and applies IIR filters as cascades of second-order sections.
+ *
+ * ### Description ###
+ *
+ * A \c REAL8SOSFilter represents the transfer function of a ZPG
+ * filter as a product of second-order sections ("biquads"):
+ * \f[
+ * T(z) = \prod_s \frac{b_{0,s} + b_{1,s}z^{-1} + b_{2,s}z^{-2}}
+ * {1 + a_{1,s}z^{-1} + a_{2,s}z^{-2}} \; .
+ * \f]
+ * Unlike the expanded polynomials of a \c REAL8IIRFilter, whose
+ * coefficients become extremely sensitive to roundoff as the filter
+ * order increases, each section only involves one pair of poles and
+ * zeros, so the cascade remains accurate at high orders.
+ *
+ * <tt>XLALCreateREAL8SOSFilter()</tt> builds the sections from a ZPG
+ * filter in the \f$z\f$ plane, subject to the same constraints as
+ * <tt>XLALCreateREAL8IIRFilter()</tt>: nonreal zeros and poles must
+ * come in complex conjugate pairs, only the real part of the gain is
+ * used, and any excess zeros are balanced by poles at \f$z=0\f$.  Each
+ * conjugate pair, or each two real roots, form one section; sections are
+ * ordered by increasing pole radius, so the most resonant sections are
+ * applied last.  The filter keeps a separate history for each of
+ * \c numChannels data channels.
+ *
+ * <tt>XLALSOSFilter\<datatype\>Vector()</tt> filters a single channel, and
+ * <tt>XLALSOSFilter\<datatype\>VectorSequence()</tt> filters each vector of
+ * a sequence as a separate channel, continuing from and updating the
+ * filter history.  <tt>XLALSOSFilterZeroPhase\<datatype\>()</tt> filters
+ * the data forward and then backward through the cascade, starting each
+ * pass from zero history, which gives a zero-phase response with the
+ * square of the filter's amplitude response; the filter history is not
+ * used or modified.
+ *
+ * ### Algorithm ###
+ *
+ * Each section is applied in transposed direct form II, in double
+ * precision.  The data are processed in blocks of samples: each block of
+ * a group of channels is copied into a buffer with the channels
+ * interleaved, which is then passed through each section in turn.  The
+ * innermost loop runs over the channels of a group, which are
+ * independent, so that the compiler can vectorise it; the buffer stays in
+ * cache while it passes through all sections.
+ *
+ */
+/** @{ */
+
+/* number of channels filtered together, and samples per block */
+#define SOS_GROUP 8
+#define SOS_BLOCK 256
+
+/* pass an interleaved block of samples through the cascade of sections */
+static void sos_cascade( REAL8 *buf, UINT4 nsamp, UINT4 nchan, const REAL8 *coef, UINT4 nsec, REAL8 *state, UINT4 statestride )
+{
+  UINT4 s, n, c;
+  for ( s = 0; s < nsec; ++s )
+  {
+    const REAL8 b0 = coef[5*s], b1 = coef[5*s+1], b2 = coef[5*s+2];
+    const REAL8 a1 = coef[5*s+3], a2 = coef[5*s+4];
+    REAL8 *st = state + 2*s*statestride;
+    REAL8 z1[SOS_GROUP], z2[SOS_GROUP];
+    for ( c = 0; c < nchan; ++c )
+    {
+      z1[c] = st[2*c];
+      z2[c] = st[2*c+1];
+    }
+    for ( n = 0; n < nsamp; ++n )
+    {
+      REAL8 *x = buf + n*nchan;
+      for ( c = 0; c < nchan; ++c )
+      {
+        const REAL8 y = b0*x[c] + z1[c];
+        z1[c] = b1*x[c] - a1*y + z2[c];
+        z2[c] = b2*x[c] - a2*y;
+        x[c] = y;
+      }
+    }
+    for ( c = 0; c < nchan; ++c )
+    {
+      st[2*c] = z1[c];
+      st[2*c+1] = z2[c];
+    }
+  }
+}
+
+/*
+ * filter nchan channels of length samples, where sample n of channel c is
+ * data[c*chanstride + n*sampstride]; the history of channel c of section s
+ * is state[2*(s*nchan + c)] and state[2*(s*nchan + c) + 1]
+ */
+#define DEFINE_SOS_FILTER( TYPE ) \
+static void sos_filter_ ## TYPE( TYPE *data, ptrdiff_t sampstride, ptrdiff_t chanstride, UINT4 length, UINT4 nchan, const REAL8 *coef, UINT4 nsec, REAL8 *state ) \
+{ \
+  REAL8 buf[SOS_GROUP*SOS_BLOCK]; \
+  UINT4 c0, n0, n, c; \
+  for ( c0 = 0; c0 < nchan; c0 += SOS_GROUP ) \
+  { \
+    const UINT4 ngroup = nchan - c0 < SOS_GROUP ? nchan - c0 : SOS_GROUP; \
+    TYPE *group = data + c0*chanstride; \
+    for ( n0 = 0; n0 < length; n0 += SOS_BLOCK ) \
+    { \
+      const UINT4 nsamp = length - n0 < SOS_BLOCK ? length - n0 : SOS_BLOCK; \
+      for ( n = 0; n < nsamp; ++n ) \
+        for ( c = 0; c < ngroup; ++c ) \
+          buf[n*ngroup + c] = group[c*chanstride + (n0 + n)*sampstride]; \
+      sos_cascade( buf, nsamp, ngroup, coef, nsec, state + 2*c0, nchan ); \
+      for ( n = 0; n < nsamp; ++n ) \
+        for ( c = 0; c < ngroup; ++c ) \
+          group[c*chanstride + (n0 + n)*sampstride] = buf[n*ngroup + c]; \
+    } \
+  } \
+} \
+\
+/* forward-backward filtering from zero history */ \
+static int sos_zero_phase_ ## TYPE( TYPE *data, ptrdiff_t sampstride, ptrdiff_t chanstride, UINT4 length, UINT4 nchan, const REAL8 *coef, UINT4 nsec ) \
+{ \
+  REAL8 *state; \
+  if ( length == 0 || nchan == 0 ) \
+    return 0; \
+  state = LALCalloc( 2*nsec*nchan, sizeof( *state ) ); \
+  if ( ! state ) \
+    XLAL_ERROR( XLAL_ENOMEM ); \
+  sos_filter_ ## TYPE( data, sampstride, chanstride, length, nchan, coef, nsec, state ); \
+  memset( state, 0, 2*nsec*nchan*sizeof( *state ) ); \
+  sos_filter_ ## TYPE( data + (length - 1)*sampstride, -sampstride, chanstride, length, nchan, coef, nsec, state ); \
+  LALFree( state ); \
+  return 0; \
+}
+DEFINE_SOS_FILTER( REAL4 )
+DEFINE_SOS_FILTER( REAL8 )
+#undef DEFINE_SOS_FILTER
+
+/*
+ * pair the roots of a real polynomial into quadratic factors
+ * z^2 + q[0] z + q[1], using only the real and positive-imaginary roots;
+ * returns the number of factors, or -1 if the roots are not paired
+ */
+static INT4 sos_quadratics( REAL8 *q, REAL8 *radius, const COMPLEX16 *roots, INT4 numRoots )
+{
+  INT4 i, num = 0, nquad = 0;
+  INT4 havereal = 0;
+  REAL8 lastreal = 0.0;
+  for ( i = 0; i < numRoots; ++i )
+  {
+    const REAL8 x = creal( roots[i] );
+    const REAL8 y = cimag( roots[i] );
+    if ( y > 0.0 )
+    {
+      q[2*nquad] = -2.0*x;
+      q[2*nquad+1] = x*x + y*y;
+      radius[nquad++] = sqrt( x*x + y*y );
+      num += 2;
+    }
+    else if ( y == 0.0 )
+    {
+      /* pair consecutive real roots */
+      if ( havereal )
+      {
+        q[2*nquad] = -( lastreal + x );
+        q[2*nquad+1] = lastreal*x;
+        radius[nquad++] = fabs( x ) > fabs( lastreal ) ? fabs( x ) : fabs( lastreal );
+        havereal = 0;
+      }
+      else
+      {
+        lastreal = x;
+        havereal = 1;
+      }
+      num += 1;
+    }
+  }
+  if ( num != numRoots )
+    return -1;
+  /* an unpaired real root is paired with a root at the origin */
+  if ( havereal )
+  {
+    q[2*nquad] = -lastreal;
+    q[2*nquad+1] = 0.0;
+    radius[nquad++] = fabs( lastreal );
+  }
+  /* order by increasing radius */
+  for ( i = 1; i < nquad; ++i )
+  {
+    INT4 j = i;
+    const REAL8 r = radius[i], q0 = q[2*i], q1 = q[2*i+1];
+    while ( j > 0 && radius[j-1] > r )
+    {
+      radius[j] = radius[j-1];
+      q[2*j] = q[2*j-2];
+      q[2*j+1] = q[2*j-1];
+      --j;
+    }
+    radius[j] = r;
+    q[2*j] = q0;
+    q[2*j+1] = q1;
+  }
+  return nquad;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+REAL8SOSFilter *XLALCreateREAL8SOSFilter( COMPLEX16ZPGFilter *input, UINT4 numChannels )
+{
+  REAL8SOSFilter *output;
+  REAL8 *zq, *pq, *zr, *pr;
+  INT4 numZeros, numPoles, nzq, npq, nsec, s;
+
+  /* Make sure all the input structures have been initialized. */
+  if ( ! input )
+    XLAL_ERROR_NULL( XLAL_EFAULT );
+  if ( ! input->zeros || ! input->poles
+      || ! input->zeros->data || ! input->poles->data )
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+  if ( numChannels == 0 )
+    XLAL_ERROR_NULL( XLAL_EINVAL );
+
+  numZeros = input->zeros->length;
+  numPoles = input->poles->length;
+
+  /* Pair up the zeros and the poles into quadratic factors. */
+  zq = LALMalloc( ( 2*numZeros + 2 )*sizeof( *zq ) );
+  pq = LALMalloc( ( 2*numPoles + 2 )*sizeof( *pq ) );
+  zr = LALMalloc( ( numZeros + 1 )*sizeof( *zr ) );
+  pr = LALMalloc( ( numPoles + 1 )*sizeof( *pr ) );
+  if ( ! zq || ! pq || ! zr || ! pr )
+  {
+    LALFree( zq );
+    LALFree( pq );
+    LALFree( zr );
+    LALFree( pr );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  nzq = sos_quadratics( zq, zr, input->zeros->data, numZeros );
+  npq = sos_quadratics( pq, pr, input->poles->data, numPoles );
+  if ( nzq < 0 || npq < 0 )
+  {
+    LALFree( zq );
+    LALFree( pq );
+    LALFree( zr );
+    LALFree( pr );
+    XLAL_ERROR_NULL( XLAL_EINVAL, "Input has unpaired nonreal poles or zeros" );
+  }
+  for ( s = 0; s < npq; ++s )
+    if ( pr[s] > 1.0 )
+      XLALPrintWarning( "XLAL Warning - %s: Filter has pole outside of unit circle\n", __func__ );
+
+  /* Create the filter; missing factors are roots at the origin. */
+  nsec = npq > nzq ? npq : nzq;
+  if ( nsec == 0 )
+    nsec = 1;
+  output = LALCalloc( 1, sizeof( *output ) );
+  if ( ! output )
+  {
+    LALFree( zq );
+    LALFree( pq );
+    LALFree( zr );
+    LALFree( pr );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  output->deltaT = input->deltaT;
+  output->numSections = nsec;
+  output->numChannels = numChannels;
+  output->coef = XLALCreateREAL8Vector( 5*nsec );
+  output->history = XLALCreateREAL8Vector( 2*nsec*numChannels );
+  if ( ! output->coef || ! output->history )
+  {
+    LALFree( zq );
+    LALFree( pq );
+    LALFree( zr );
+    LALFree( pr );
+    XLALDestroyREAL8SOSFilter( output );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  for ( s = 0; s < nsec; ++s )
+  {
+    REAL8 *coef = output->coef->data + 5*s;
+    coef[0] = 1.0;
+    coef[1] = s < nzq ? zq[2*s] : 0.0;
+    coef[2] = s < nzq ? zq[2*s+1] : 0.0;
+    coef[3] = s < npq ? pq[2*s] : 0.0;
+    coef[4] = s < npq ? pq[2*s+1] : 0.0;
+  }
+
+  /* Apply the gain to the first section. */
+  for ( s = 0; s < 3; ++s )
+    output->coef->data[s] *= creal( input->gain );
+
+  memset( output->history->data, 0, output->history->length*sizeof( *output->history->data ) );
+
+  LALFree( zq );
+  LALFree( pq );
+  LALFree( zr );
+  LALFree( pr );
+
+  return output;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+void XLALDestroyREAL8SOSFilter( REAL8SOSFilter *filter )
+{
+  if ( filter )
+  {
+    XLALDestroyREAL8Vector( filter->coef );
+    XLALDestroyREAL8Vector( filter->history );
+    LALFree( filter );
+  }
+  return;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALResetREAL8SOSFilter( REAL8SOSFilter *filter )
+{
+  if ( ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! filter->history || ! filter->history->data )
+    XLAL_ERROR( XLAL_EINVAL );
+  memset( filter->history->data, 0, filter->history->length*sizeof( *filter->history->data ) );
+  return 0;
+}
+
+/* check that a filter has been initialized */
+static int sos_check( const REAL8SOSFilter *filter )
+{
+  if ( ! filter )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! filter->coef || ! filter->history
+      || ! filter->coef->data || ! filter->history->data
+      || filter->coef->length != 5*filter->numSections
+      || filter->history->length != 2*filter->numSections*filter->numChannels )
+    XLAL_ERROR( XLAL_EINVAL );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterREAL4Vector( REAL4Vector *vector, REAL8SOSFilter *filter )
+{
+  if ( ! vector )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( filter->numChannels != 1 )
+    XLAL_ERROR( XLAL_EBADLEN, "Filter has %u channels, not 1", filter->numChannels );
+  sos_filter_REAL4( vector->data, 1, 0, vector->length, 1, filter->coef->data, filter->numSections, filter->history->data );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterREAL8Vector( REAL8Vector *vector, REAL8SOSFilter *filter )
+{
+  if ( ! vector )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( filter->numChannels != 1 )
+    XLAL_ERROR( XLAL_EBADLEN, "Filter has %u channels, not 1", filter->numChannels );
+  sos_filter_REAL8( vector->data, 1, 0, vector->length, 1, filter->coef->data, filter->numSections, filter->history->data );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterREAL4VectorSequence( REAL4VectorSequence *sequence, REAL8SOSFilter *filter )
+{
+  if ( ! sequence )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! sequence->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( filter->numChannels != sequence->length )
+    XLAL_ERROR( XLAL_EBADLEN, "Filter has %u channels, not %u", filter->numChannels, sequence->length );
+  sos_filter_REAL4( sequence->data, 1, sequence->vectorLength, sequence->vectorLength, sequence->length, filter->coef->data, filter->numSections, filter->history->data );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterREAL8VectorSequence( REAL8VectorSequence *sequence, REAL8SOSFilter *filter )
+{
+  if ( ! sequence )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! sequence->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( filter->numChannels != sequence->length )
+    XLAL_ERROR( XLAL_EBADLEN, "Filter has %u channels, not %u", filter->numChannels, sequence->length );
+  sos_filter_REAL8( sequence->data, 1, sequence->vectorLength, sequence->vectorLength, sequence->length, filter->coef->data, filter->numSections, filter->history->data );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterZeroPhaseREAL4Vector( REAL4Vector *vector, const REAL8SOSFilter *filter )
+{
+  if ( ! vector )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( sos_zero_phase_REAL4( vector->data, 1, 0, vector->length, 1, filter->coef->data, filter->numSections ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterZeroPhaseREAL8Vector( REAL8Vector *vector, const REAL8SOSFilter *filter )
+{
+  if ( ! vector )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( sos_zero_phase_REAL8( vector->data, 1, 0, vector->length, 1, filter->coef->data, filter->numSections ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterZeroPhaseCOMPLEX8Vector( COMPLEX8Vector *vector, const REAL8SOSFilter *filter )
+{
+  if ( ! vector )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  /* the real and imaginary parts are filtered as two channels */
+  if ( sos_zero_phase_REAL4( (REAL4 *) vector->data, 2, 1, vector->length, 2, filter->coef->data, filter->numSections ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterZeroPhaseCOMPLEX16Vector( COMPLEX16Vector *vector, const REAL8SOSFilter *filter )
+{
+  if ( ! vector )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! vector->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  /* the real and imaginary parts are filtered as two channels */
+  if ( sos_zero_phase_REAL8( (REAL8 *) vector->data, 2, 1, vector->length, 2, filter->coef->data, filter->numSections ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterZeroPhaseREAL4VectorSequence( REAL4VectorSequence *sequence, const REAL8SOSFilter *filter )
+{
+  if ( ! sequence )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! sequence->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( sos_zero_phase_REAL4( sequence->data, 1, sequence->vectorLength, sequence->vectorLength, sequence->length, filter->coef->data, filter->numSections ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int XLALSOSFilterZeroPhaseREAL8VectorSequence( REAL8VectorSequence *sequence, const REAL8SOSFilter *filter )
+{
+  if ( ! sequence )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! sequence->data || sos_check( filter ) < 0 )
+    XLAL_ERROR( XLAL_EINVAL );
+  if ( sos_zero_phase_REAL8( sequence->data, 1, sequence->vectorLength, sequence->vectorLength, sequence->length, filter->coef->data, filter->numSections ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+/** @} */
@@ -18,50 +18,262 @@
 */
 
 /*
- * Dictionary is implemented as a hash search with algorithm adopted
- * from "The C Programming Language" by Kernighan and Ritchie, 2nd ed.
- * section 6.6.
+ * Dictionary is implemented as an open-addressing hash table with linear
+ * probing.  Keys are interned: each distinct key name is stored once in a
+ * global table, so that dictionary entries hold a pointer to the interned
+ * name and its hash, and keys resolved ahead of time with a LALDictKey are
+ * compared by pointer.  Values of up to LAL_DICT_INLINE_SIZE bytes, which
+ * includes all scalar types, are stored inline in the hash table entry;
+ * larger values are allocated separately.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <unistd.h>
 
+#include <config.h>
 #include <lal/LALStdio.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALDict.h>
 #include "LALValue_private.h"
 
-#define LAL_DICT_HASHSIZE 101
+/* largest value, in bytes, stored inline in an entry */
+#define LAL_DICT_INLINE_SIZE 16
+
+/* initial number of hash table slots; must be a power of 2 */
+#define LAL_DICT_MIN_SLOTS 16
 
 struct tagLALDictEntry {
-        struct tagLALDictEntry *next;
-        char key[LAL_KEYNAME_MAX + 1];
-	LALValue value;
+	const char *key;	/* interned key; NULL if slot is empty */
+	size_t hash;		/* hash of key */
+	LALValue *heap;		/* value if too large to store inline, else NULL */
+	union {
+		LALValue value;
+		char storage[sizeof(LALValue) + LAL_DICT_INLINE_SIZE];
+	} small;		/* value if stored inline */
 };
 
 struct tagLALDict {
-	size_t size;
-	struct tagLALDictEntry *hashes[];
+	size_t size;	/* number of entries */
+	size_t used;	/* number of non-empty slots, including deleted entries */
+	size_t mask;	/* number of slots minus one */
+	struct tagLALDictEntry *slots;
 };
 
+/* key of a deleted entry */
+static const char deleted_key[] = "";
+#define DELETED deleted_key
+
+/* string hash, with the high bits mixed into the low bits used to index the table */
 static size_t hash(const char *s)
 {
-	size_t hashval;
+	UINT8 hashval;
 	for (hashval = 0; *s != '\0'; ++s)
 		hashval = *s + 31 * hashval;
-	return hashval;
+	hashval *= UINT64_C(0x9E3779B97F4A7C15);
+	return hashval ^ (hashval >> 32);
+}
+
+/* KEY INTERNING ROUTINES */
+
+/*
+ * Interned key names are never freed.  If C11 atomic operations are
+ * available, the table of interned names is read without locking: slots
+ * are only ever filled, never cleared, and when the table grows the old
+ * table is kept so that concurrent readers can finish with it.  Adding a
+ * new name takes a lock.  Otherwise the table is only accessed under the
+ * lock.  The table is allocated with malloc(), so that interned names are
+ * not reported by LALCheckMemoryLeaks().
+ */
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_mutex_t intern_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK(l)     pthread_mutex_lock(&(l))
+#define UNLOCK(l)   pthread_mutex_unlock(&(l))
+#else
+#define LOCK(l)
+#define UNLOCK(l)
+#endif
+
+#if defined(HAVE_STDATOMIC_H) && !defined(__STDC_NO_ATOMICS__)
+#define LAL_DICT_ATOMICS 1
+#include <stdatomic.h>
+#define ATOMIC(T)       _Atomic(T)
+#define LOAD(x)         atomic_load_explicit(&(x), memory_order_acquire)
+#define STORE(x, v)     atomic_store_explicit(&(x), (v), memory_order_release)
+#else
+#define ATOMIC(T)       T
+#define LOAD(x)         (x)
+#define STORE(x, v)     ((x) = (v))
+#endif
+
+struct internedName {
+	size_t hash;
+	char name[LAL_KEYNAME_MAX + 1];
+};
+
+struct internTable {
+	struct internTable *prev;	/* previous table, kept for concurrent readers */
+	size_t n;			/* number of interned names */
+	size_t mask;			/* number of slots minus one */
+	ATOMIC(struct internedName *) slots[];
+};
+
+static ATOMIC(struct internTable *) intern_table = NULL;
+
+static const char *intern_find(struct internTable *table, const char *key, size_t hashval)
+{
+	size_t i;
+	if (table == NULL)
+		return NULL;
+	for (i = hashval & table->mask; ; i = (i + 1) & table->mask) {
+		const struct internedName *name = LOAD(table->slots[i]);
+		if (name == NULL)
+			return NULL;
+		if (name->hash == hashval && strcmp(name->name, key) == 0)
+			return name->name;
+	}
+}
+
+/* must be called with the lock held */
+static int intern_grow(void)
+{
+	struct internTable *old = LOAD(intern_table);
+	size_t len = old ? 2 * (old->mask + 1) : 64;
+	struct internTable *table;
+	size_t i, j;
+	table = calloc(1, sizeof(*table) + len * sizeof(*table->slots));
+	if (!table)
+		return -1;
+	table->prev = old;
+	table->mask = len - 1;
+	if (old) {
+		table->n = old->n;
+		for (i = 0; i <= old->mask; ++i) {
+			struct internedName *name = LOAD(old->slots[i]);
+			if (name == NULL)
+				continue;
+			for (j = name->hash & table->mask; LOAD(table->slots[j]) != NULL; j = (j + 1) & table->mask)
+				;
+			STORE(table->slots[j], name);
+		}
+	}
+	STORE(intern_table, table);
+	return 0;
+}
+
+/* return the interned copy of a key name, and its hash */
+static const char *intern(const char *key, size_t *hashval)
+{
+	struct internTable *table;
+	const char *interned;
+	struct internedName *name;
+	size_t i;
+
+	XLAL_CHECK_NULL(key != NULL, XLAL_EFAULT);
+	XLAL_CHECK_NULL(strlen(key) <= LAL_KEYNAME_MAX, XLAL_ENAME, "Key name `%s' too long (max %d characters)", key, LAL_KEYNAME_MAX);
+
+	*hashval = hash(key);
+#ifdef LAL_DICT_ATOMICS
+	interned = intern_find(LOAD(intern_table), key, *hashval);
+	if (interned)
+		return interned;
+#endif
+
+	/* not found: search again under the lock, and add */
+	LOCK(intern_mutex);
+	interned = intern_find(LOAD(intern_table), key, *hashval);
+	if (interned == NULL) {
+		table = LOAD(intern_table);
+		if (table == NULL || 2 * (table->n + 1) > table->mask + 1) {
+			if (intern_grow() < 0) {
+				UNLOCK(intern_mutex);
+				XLAL_ERROR_NULL(XLAL_ENOMEM);
+			}
+			table = LOAD(intern_table);
+		}
+		name = malloc(sizeof(*name));
+		if (!name) {
+			UNLOCK(intern_mutex);
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		}
+		name->hash = *hashval;
+		strcpy(name->name, key);
+		for (i = name->hash & table->mask; LOAD(table->slots[i]) != NULL; i = (i + 1) & table->mask)
+			;
+		STORE(table->slots[i], name);
+		++table->n;
+		interned = name->name;
+	}
+	UNLOCK(intern_mutex);
+	return interned;
+}
+
+/* resolve a precomputed key to its interned name */
+static const char *resolve(LALDictKey *key, size_t *hashval)
+{
+#ifdef LAL_DICT_ATOMICS
+	_Atomic(const char *) *pinterned = (_Atomic(const char *) *) &key->interned;
+	const char *interned = LOAD(*pinterned);
+	if (interned == NULL) {
+		interned = intern(key->name, hashval);
+		if (interned == NULL)
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		STORE(*pinterned, interned);
+		return interned;
+	}
+	*hashval = ((const struct internedName *)(interned - offsetof(struct internedName, name)))->hash;
+	return interned;
+#else
+	/* key may be shared between threads, so it is not updated without atomic operations */
+	const char *interned = intern(key->name, hashval);
+	if (interned == NULL)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return interned;
+#endif
 }
 
 /* DICT ENTRY ROUTINES */
 
+static LALValue * entry_value(LALDictEntry *entry)
+{
+	return entry->heap ? entry->heap : &entry->small.value;
+}
+
+/* set up storage for a value of the given size; any existing value is lost */
+static int entry_alloc_value(LALDictEntry *entry, size_t size)
+{
+	entry->heap = NULL;
+	if (size > LAL_DICT_INLINE_SIZE) {
+		entry->heap = XLALValueAlloc(size);
+		if (!entry->heap)
+			XLAL_ERROR(XLAL_EFUNC);
+	}
+	entry_value(entry)->size = size;
+	return 0;
+}
+
+/* set up storage for a value and set it; nothing is allocated on failure */
+static int entry_init_value(LALDictEntry *entry, const void *data, size_t size, LALTYPECODE type)
+{
+	if (entry_alloc_value(entry, size) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	if (XLALValueSet(entry_value(entry), data, size, type) == NULL) {
+		XLALFree(entry->heap);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	return 0;
+}
+
+/* entries are no longer chained, so this frees a single entry */
 void XLALDictEntryFree(LALDictEntry *list)
 {
-	while (list) {
-		LALDictEntry *next = list->next;
+	if (list) {
+		XLALFree(list->heap);
 		LALFree(list);
-		list = next;
 	}
 	return;
 }
@@ -69,10 +281,13 @@ void XLALDictEntryFree(LALDictEntry *list)
 LALDictEntry * XLALDictEntryAlloc(size_t size)
 {
 	LALDictEntry *entry;
-	entry = XLALMalloc(sizeof(*entry) + size);
+	entry = XLALCalloc(1, sizeof(*entry));
 	if (!entry)
 		XLAL_ERROR_NULL(XLAL_ENOMEM);
-	entry->value.size = size;
+	if (entry_alloc_value(entry, size) < 0) {
+		LALFree(entry);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
 	return entry;
 }
 
@@ -80,25 +295,37 @@ LALDictEntry * XLALDictEntryRealloc(LALDictEntry *entry, size_t size)
 {
 	if (entry == NULL)
 		return XLALDictEntryAlloc(size);
-	if (entry->value.size == size)
+	if (entry_value(entry)->size == size)
 		return entry;
-	entry = XLALRealloc(entry, sizeof(*entry) + size);
-	if (!entry)
-		XLAL_ERROR_NULL(XLAL_ENOMEM);
-	entry->value.size = size;
+	if (size > LAL_DICT_INLINE_SIZE) {
+		LALValue *value = XLALRealloc(entry->heap, sizeof(*value) + size);
+		if (!value)
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		if (entry->heap == NULL) /* move inline value */
+			memcpy(value, &entry->small.value, sizeof(*value) + entry->small.value.size);
+		entry->heap = value;
+	} else {
+		if (entry->heap)
+			memcpy(&entry->small.value, entry->heap, sizeof(LALValue) + size);
+		XLALFree(entry->heap);
+		entry->heap = NULL;
+	}
+	entry_value(entry)->size = size;
 	return entry;
 }
 
 LALDictEntry * XLALDictEntrySetKey(LALDictEntry *entry, const char *key)
 {
-	if ((size_t)snprintf(entry->key, sizeof(entry->key), "%s", key) >= sizeof(entry->key))
-		XLAL_ERROR_NULL(XLAL_ENAME, "Key name `%s' too long (max %d characters)", key, LAL_KEYNAME_MAX);
+	const char *interned = intern(key, &entry->hash);
+	if (interned == NULL)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	entry->key = interned;
 	return entry;
 }
 
 LALDictEntry * XLALDictEntrySetValue(LALDictEntry *entry, const void *data, size_t size, LALTYPECODE type)
 {
-	if (XLALValueSet(&entry->value, data, size, type) == NULL)
+	if (XLALValueSet(entry_value(entry), data, size, type) == NULL)
 		XLAL_ERROR_NULL(XLAL_EFUNC);
 	return entry;
 }
@@ -112,15 +339,19 @@ const char * XLALDictEntryGetKey(const LALDictEntry *entry)
 /* warning: shallow pointer */
 const LALValue * XLALDictEntryGetValue(const LALDictEntry *entry)
 {
-	return &entry->value;
+	return entry->heap ? entry->heap : &entry->small.value;
 }
 
+#define IS_ENTRY(entry) ((entry)->key != NULL && (entry)->key != DELETED)
+
 void XLALDestroyDict(LALDict *dict)
 {
 	if (dict) {
 		size_t i;
-		for (i = 0; i < dict->size; ++i)
-			XLALDictEntryFree(dict->hashes[i]);
+		for (i = 0; i <= dict->mask; ++i)
+			if (IS_ENTRY(&dict->slots[i]))
+				XLALFree(dict->slots[i].heap);
+		LALFree(dict->slots);
 		LALFree(dict);
 	}
 	return;
@@ -128,23 +359,115 @@ void XLALDestroyDict(LALDict *dict)
 
 /* DICT ROUTINES */
 
+/* rebuild the hash table with enough slots for at least the given number of entries */
+static int resize(LALDict *dict, size_t size)
+{
+	struct tagLALDictEntry *old = dict->slots;
+	size_t oldlen = dict->mask + 1;
+	size_t len = LAL_DICT_MIN_SLOTS;
+	size_t i, j;
+	while (len < 4 * size)
+		len *= 2;
+	dict->slots = XLALCalloc(len, sizeof(*dict->slots));
+	if (!dict->slots) {
+		dict->slots = old;
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	dict->mask = len - 1;
+	dict->used = dict->size;
+	for (i = 0; i < oldlen; ++i) {
+		if (IS_ENTRY(&old[i])) {
+			for (j = old[i].hash & dict->mask; dict->slots[j].key != NULL; j = (j + 1) & dict->mask)
+				;
+			dict->slots[j] = old[i];
+		}
+	}
+	LALFree(old);
+	return 0;
+}
+
+/* find the entry with an interned key, or NULL */
+static LALDictEntry * find_interned(const LALDict *dict, const char *key, size_t hashval)
+{
+	size_t i;
+	for (i = hashval & dict->mask; dict->slots[i].key != NULL; i = (i + 1) & dict->mask)
+		if (dict->slots[i].key == key)
+			return &dict->slots[i];
+	return NULL;
+}
+
+/* find the entry with a key, or NULL */
+static LALDictEntry * find(const LALDict *dict, const char *key)
+{
+	size_t hashval = hash(key);
+	size_t i;
+	for (i = hashval & dict->mask; dict->slots[i].key != NULL; i = (i + 1) & dict->mask) {
+		const LALDictEntry *entry = &dict->slots[i];
+		if (entry->hash == hashval && entry->key != DELETED && strcmp(entry->key, key) == 0)
+			return &dict->slots[i];
+	}
+	return NULL;
+}
+
+/* insert or replace the value of an interned key */
+static int insert_interned(LALDict *dict, const char *key, size_t hashval, const void *data, size_t size, LALTYPECODE type)
+{
+	LALDictEntry new;
+	LALDictEntry *entry;
+	size_t i;
+
+	/* set the new value aside first, so that failure leaves the dictionary unchanged */
+	if (entry_init_value(&new, data, size, type) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	new.key = key;
+	new.hash = hashval;
+
+	/* see if entry already exists */
+	entry = find_interned(dict, key, hashval);
+	if (entry) {
+		XLALFree(entry->heap);
+		*entry = new;
+		return 0;
+	}
+
+	/* not found: resize to keep the table at most half full, and add new entry */
+	if (2 * (dict->used + 1) > dict->mask + 1) {
+		if (resize(dict, dict->size + 1) < 0) {
+			XLALFree(new.heap);
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+	}
+	for (i = hashval & dict->mask; IS_ENTRY(&dict->slots[i]); i = (i + 1) & dict->mask)
+		;
+	if (dict->slots[i].key == NULL)
+		++dict->used;
+	++dict->size;
+	dict->slots[i] = new;
+	return 0;
+}
+
 LALDict * XLALCreateDict(void)
 {
 	LALDict *dict;
-	dict = XLALCalloc(1, sizeof(dict) + LAL_DICT_HASHSIZE * sizeof(*dict->hashes));
+	dict = XLALCalloc(1, sizeof(*dict));
 	if (!dict)
 		XLAL_ERROR_NULL(XLAL_ENOMEM);
-	dict->size = LAL_DICT_HASHSIZE;
+	dict->slots = XLALCalloc(LAL_DICT_MIN_SLOTS, sizeof(*dict->slots));
+	if (!dict->slots) {
+		LALFree(dict);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	dict->mask = LAL_DICT_MIN_SLOTS - 1;
 	return dict;
 }
 
 void XLALDictForeach(LALDict *dict, void (*func)(char *, LALValue *, void *), void *thunk)
 {
 	size_t i;
-	for (i = 0; i < dict->size; ++i) {
-		LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next)
-			func(entry->key, &entry->value, thunk);
+	for (i = 0; i <= dict->mask; ++i) {
+		LALDictEntry *entry = &dict->slots[i];
+		if (IS_ENTRY(entry))
+			func((char *)entry->key, entry_value(entry), thunk);
 	}
 	return;
 }
@@ -152,11 +475,10 @@ void XLALDictForeach(LALDict *dict, void (*func)(char *, LALValue *, void *), vo
 LALDictEntry * XLALDictFind(LALDict *dict, int (*func)(const char *, const LALValue *, void *), void *thunk)
 {
 	size_t i;
-	for (i = 0; i < dict->size; ++i) {
-		LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next)
-			if (func(entry->key, &entry->value, thunk))
-				return entry;
+	for (i = 0; i <= dict->mask; ++i) {
+		LALDictEntry *entry = &dict->slots[i];
+		if (IS_ENTRY(entry) && func(entry->key, entry_value(entry), thunk))
+			return entry;
 	}
 	return NULL;
 }
@@ -171,41 +493,33 @@ void XLALDictIterInit(LALDictIter *iter, LALDict *dict)
 
 LALDictEntry * XLALDictIterNext(LALDictIter *iter)
 {
-	while (1) {
-
-		if (iter->next) {
-			LALDictEntry *entry = iter->next;
-			iter->next = entry->next;
+	while (iter->pos <= iter->dict->mask) {
+		LALDictEntry *entry = &iter->dict->slots[iter->pos++];
+		if (IS_ENTRY(entry))
 			return entry;
-		}
-
-		/* check end of iteration */
-		if (iter->pos >= iter->dict->size)
-			return NULL;
-
-		iter->next = iter->dict->hashes[iter->pos++];
 	}
 	return NULL;
 }
 
 LALDict * XLALDictDuplicate(LALDict *old)
 {
-    UINT4 i;
-    int retcode;
+    size_t i;
     if(old==NULL) return NULL;
     LALDict *new = XLALCreateDict();
     if (!new)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
-    for (i = 0; i < old->size; ++i) {
-        const LALDictEntry *entry;
-        for (entry = old->hashes[i]; entry != NULL; entry = entry->next) {
-            const char *key = XLALDictEntryGetKey(entry);
-            XLAL_TRY(XLALDictInsertValue(new, key, XLALDictEntryGetValue(entry)), retcode);
-            if(retcode!=XLAL_SUCCESS)
-            {
-                XLALDestroyDict(new);
-                XLAL_ERROR_NULL(retcode & XLAL_EFUNC);
-            }
+    if (resize(new, old->size) < 0) {
+        XLALDestroyDict(new);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    for (i = 0; i <= old->mask; ++i) {
+        const LALDictEntry *entry = &old->slots[i];
+        if (!IS_ENTRY(entry))
+            continue;
+        const LALValue *value = XLALDictEntryGetValue(entry);
+        if (insert_interned(new, entry->key, entry->hash, XLALValueGetDataPtr(value), XLALValueGetSize(value), XLALValueGetType(value)) < 0) {
+            XLALDestroyDict(new);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
         }
     }
     return(new);
@@ -218,14 +532,14 @@ LALList * XLALDictKeys(const LALDict *dict)
 	list = XLALCreateList();
 	if (!list)
 		XLAL_ERROR_NULL(XLAL_EFUNC);
-	for (i = 0; i < dict->size; ++i) {
-		const LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next) {
-			const char *key = XLALDictEntryGetKey(entry);
-			if (XLALListAddStringValue(list, key) < 0) {
-				XLALDestroyList(list);
-				XLAL_ERROR_NULL(XLAL_EFUNC);
-			}
+	for (i = 0; i <= dict->mask; ++i) {
+		const LALDictEntry *entry = &dict->slots[i];
+		if (!IS_ENTRY(entry))
+			continue;
+		const char *key = XLALDictEntryGetKey(entry);
+		if (XLALListAddStringValue(list, key) < 0) {
+			XLALDestroyList(list);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
 		}
 	}
 	return list;
@@ -238,14 +552,14 @@ LALList * XLALDictValues(const LALDict *dict)
 	list = XLALCreateList();
 	if (!list)
 		XLAL_ERROR_NULL(XLAL_EFUNC);
-	for (i = 0; i < dict->size; ++i) {
-		const LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next) {
-			const LALValue *value = XLALDictEntryGetValue(entry);
-			if (XLALListAddValue(list, value) < 0) {
-				XLALDestroyList(list);
-				XLAL_ERROR_NULL(XLAL_EFUNC);
-			}
+	for (i = 0; i <= dict->mask; ++i) {
+		const LALDictEntry *entry = &dict->slots[i];
+		if (!IS_ENTRY(entry))
+			continue;
+		const LALValue *value = XLALDictEntryGetValue(entry);
+		if (XLALListAddValue(list, value) < 0) {
+			XLALDestroyList(list);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
 		}
 	}
 	return list;
@@ -253,103 +567,39 @@ LALList * XLALDictValues(const LALDict *dict)
 
 int XLALDictContains(const LALDict *dict, const char *key)
 {
-	const LALDictEntry *entry;
-	for (entry = dict->hashes[hash(key) % dict->size]; entry != NULL; entry = entry->next)
-		if (strcmp(key, entry->key) == 0)
-			return 1;
-	return 0;
+	return find(dict, key) != NULL;
 }
 
 size_t XLALDictSize(const LALDict *dict)
 {
-	size_t size = 0;
-	size_t i;
-	for (i = 0; i < dict->size; ++i) {
-		const LALDictEntry *entry;
-		for (entry = dict->hashes[i]; entry != NULL; entry = entry->next)
-			++size;
-	}
-	return size;
+	return dict->size;
 }
 
 LALDictEntry *XLALDictLookup(LALDict *dict, const char *key)
 {
-	LALDictEntry *entry;
-	for (entry = dict->hashes[hash(key) % dict->size]; entry != NULL; entry = entry->next)
-		if (strcmp(key, entry->key) == 0)
-			return entry;
-	return NULL;
+	return find(dict, key);
 }
 
 int XLALDictRemove(LALDict *dict, const char *key)
 {
-	size_t hashidx = hash(key) % dict->size;
-	LALDictEntry *this = dict->hashes[hashidx];
-	LALDictEntry *prev = this;
-	while (this) {
-		if (strcmp(this->key, key) == 0) { /* found it! */
-			if (prev == this) /* head is removed */
-				dict->hashes[hashidx] = this->next;
-			else
-				prev->next = this->next;
-			LALFree(this);
-			return 0;
-		}
-		prev = this;
-		this = this->next;
-	}
-	return -1; /* not found */
+	LALDictEntry *entry = find(dict, key);
+	if (entry == NULL)
+		return -1; /* not found */
+	XLALFree(entry->heap);
+	entry->heap = NULL;
+	entry->key = DELETED;
+	--dict->size;
+	return 0;
 }
 
 int XLALDictInsert(LALDict *dict, const char *key, const void *data, size_t size, LALTYPECODE type)
 {
-	size_t hashidx = hash(key) % dict->size;
-	LALDictEntry *this = dict->hashes[hashidx];
-	LALDictEntry *prev = NULL;
-	LALDictEntry *entry;
-
-	/* see if entry already exists */
-	while (this) {
-		if (strcmp(this->key, key) == 0) { /* found it! */
-			entry = XLALDictEntryRealloc(this, size);
-			if (entry == NULL)
-				XLAL_ERROR(XLAL_EFUNC);
-			if (entry != this) { /* relink */
-				if (prev == NULL) /* head is moved */
-					dict->hashes[hashidx] = entry;
-				else
-					prev->next = entry;
-			}
-			entry = XLALDictEntrySetValue(entry, data, size, type);
-
-			if (entry == NULL)
-				XLAL_ERROR(XLAL_EFUNC);
-
-			return 0;
-		}
-		prev = this;
-		this = this->next;
-	}
-
-	/* not found: create new entry */
-	entry = XLALDictEntryAlloc(size);
-	if (entry == NULL)
+	size_t hashval;
+	const char *interned = intern(key, &hashval);
+	if (interned == NULL)
 		XLAL_ERROR(XLAL_EFUNC);
-
-	entry = XLALDictEntrySetKey(entry, key);
-	if (entry == NULL) {
-		LALFree(entry);
+	if (insert_interned(dict, interned, hashval, data, size, type) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
-	}
-
-	entry = XLALDictEntrySetValue(entry, data, size, type);
-	if (entry == NULL) {
-		LALFree(entry);
-		XLAL_ERROR(XLAL_EFUNC);
-	}
-
-	entry->next = dict->hashes[hashidx];
-	dict->hashes[hashidx] = entry;
 	return 0;
 }
 
@@ -432,6 +682,101 @@ DEFINE_LOOKUP_FUNC(REAL8, XLAL_REAL8_FAIL_NAN)
 DEFINE_LOOKUP_FUNC(COMPLEX8, XLAL_REAL4_FAIL_NAN)
 DEFINE_LOOKUP_FUNC(COMPLEX16, XLAL_REAL8_FAIL_NAN)
 
+/* PRECOMPUTED KEY ROUTINES */
+
+LALDictEntry * XLALDictLookupByKey(LALDict *dict, LALDictKey *key)
+{
+	size_t hashval;
+	const char *interned = resolve(key, &hashval);
+	if (interned == NULL)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return find_interned(dict, interned, hashval);
+}
+
+int XLALDictContainsByKey(const LALDict *dict, LALDictKey *key)
+{
+	size_t hashval;
+	const char *interned = resolve(key, &hashval);
+	if (interned == NULL)
+		XLAL_ERROR(XLAL_EFUNC);
+	return find_interned(dict, interned, hashval) != NULL;
+}
+
+int XLALDictInsertByKey(LALDict *dict, LALDictKey *key, const void *data, size_t size, LALTYPECODE type)
+{
+	size_t hashval;
+	const char *interned = resolve(key, &hashval);
+	if (interned == NULL)
+		XLAL_ERROR(XLAL_EFUNC);
+	if (insert_interned(dict, interned, hashval, data, size, type) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+int XLALDictInsertStringValueByKey(LALDict *dict, LALDictKey *key, const char *value)
+{
+	size_t size = strlen(value) + 1;
+	if (XLALDictInsertByKey(dict, key, value, size, LAL_CHAR_TYPE_CODE) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+#define DEFINE_INSERT_BY_KEY_FUNC(TYPE, TCODE) \
+	int XLALDictInsert ## TYPE ## ValueByKey(LALDict *dict, LALDictKey *key, TYPE value) \
+	{ \
+		if (XLALDictInsertByKey(dict, key, &value, sizeof(value), TCODE) < 0) \
+			XLAL_ERROR(XLAL_EFUNC); \
+		return 0; \
+	}
+
+DEFINE_INSERT_BY_KEY_FUNC(CHAR, LAL_CHAR_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(INT2, LAL_I2_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(INT4, LAL_I4_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(INT8, LAL_I8_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(UCHAR, LAL_UCHAR_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(UINT2, LAL_U2_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(UINT4, LAL_U4_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(UINT8, LAL_U8_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(REAL4, LAL_S_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(REAL8, LAL_D_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(COMPLEX8, LAL_C_TYPE_CODE)
+DEFINE_INSERT_BY_KEY_FUNC(COMPLEX16, LAL_Z_TYPE_CODE)
+
+#undef DEFINE_INSERT_BY_KEY_FUNC
+
+/* warning: shallow pointer */
+const char * XLALDictLookupStringValueByKey(LALDict *dict, LALDictKey *key)
+{
+	LALDictEntry *entry = XLALDictLookupByKey(dict, key);
+	if (entry == NULL)
+		XLAL_ERROR_NULL(XLAL_ENAME, "Key `%s' not found", key->name);
+	return XLALValueGetString(XLALDictEntryGetValue(entry));
+}
+
+#define DEFINE_LOOKUP_BY_KEY_FUNC(TYPE, FAILVAL) \
+	TYPE XLALDictLookup ## TYPE ## ValueByKey(LALDict *dict, LALDictKey *key) \
+	{ \
+		LALDictEntry *entry = XLALDictLookupByKey(dict, key); \
+		if (entry == NULL) \
+			XLAL_ERROR_VAL(FAILVAL, XLAL_ENAME, "Key `%s' not found", key->name); \
+		return XLALValueGet ## TYPE (XLALDictEntryGetValue(entry)); \
+	}
+
+DEFINE_LOOKUP_BY_KEY_FUNC(CHAR, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(INT2, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(INT4, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(INT8, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(UCHAR, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(UINT2, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(UINT4, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(UINT8, XLAL_FAILURE)
+DEFINE_LOOKUP_BY_KEY_FUNC(REAL4, XLAL_REAL4_FAIL_NAN)
+DEFINE_LOOKUP_BY_KEY_FUNC(REAL8, XLAL_REAL8_FAIL_NAN)
+DEFINE_LOOKUP_BY_KEY_FUNC(COMPLEX8, XLAL_REAL4_FAIL_NAN)
+DEFINE_LOOKUP_BY_KEY_FUNC(COMPLEX16, XLAL_REAL8_FAIL_NAN)
+
+#undef DEFINE_LOOKUP_BY_KEY_FUNC
+
 REAL8 XLALDictLookupValueAsREAL8(LALDict *dict, const char *key)
 {
 	LALDictEntry *entry;
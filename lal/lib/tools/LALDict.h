@@ -47,6 +47,31 @@ struct tagLALDictIter {
 };
 typedef struct tagLALDictIter LALDictIter;
 
+#ifndef SWIG    /* exclude from SWIG interface */
+/*
+ * Precomputed dictionary key: the key name is resolved to an interned
+ * name on first use, after which lookups need neither hashing nor string
+ * comparison.  Intended for keys looked up repeatedly, e.g.
+ *
+ *     static LALDictKey key = LAL_DICT_KEY_INIT("f_ref");
+ *     REAL8 f_ref = XLALDictLookupREAL8ValueByKey(dict, &key);
+ *
+ * A key may be shared between threads.
+ *
+ * Key names of all dictionaries are interned in a global table, and
+ * interned names are never freed: the memory used grows with the number
+ * of distinct key names used by a program, not with the number of
+ * dictionaries or entries.
+ */
+struct tagLALDictKey {
+	const char *name;
+	/* private data */
+	const char *interned;
+};
+typedef struct tagLALDictKey LALDictKey;
+#define LAL_DICT_KEY_INIT(name) { (name), NULL }
+#endif /* SWIG */
+
 void XLALDictEntryFree(LALDictEntry *list);
 LALDictEntry * XLALDictEntryAlloc(size_t size);
 LALDictEntry * XLALDictEntryRealloc(LALDictEntry *entry, size_t size);
@@ -107,6 +132,40 @@ COMPLEX16 XLALDictLookupCOMPLEX16Value(LALDict *dict, const char *key);
 
 REAL8 XLALDictLookupValueAsREAL8(LALDict *dict, const char *key);
 
+#ifndef SWIG    /* exclude from SWIG interface */
+int XLALDictContainsByKey(const LALDict *dict, LALDictKey *key);
+int XLALDictInsertByKey(LALDict *dict, LALDictKey *key, const void *data, size_t size, LALTYPECODE type);
+int XLALDictInsertStringValueByKey(LALDict *dict, LALDictKey *key, const char *value);
+int XLALDictInsertCHARValueByKey(LALDict *dict, LALDictKey *key, CHAR value);
+int XLALDictInsertINT2ValueByKey(LALDict *dict, LALDictKey *key, INT2 value);
+int XLALDictInsertINT4ValueByKey(LALDict *dict, LALDictKey *key, INT4 value);
+int XLALDictInsertINT8ValueByKey(LALDict *dict, LALDictKey *key, INT8 value);
+int XLALDictInsertUCHARValueByKey(LALDict *dict, LALDictKey *key, UCHAR value);
+int XLALDictInsertUINT2ValueByKey(LALDict *dict, LALDictKey *key, UINT2 value);
+int XLALDictInsertUINT4ValueByKey(LALDict *dict, LALDictKey *key, UINT4 value);
+int XLALDictInsertUINT8ValueByKey(LALDict *dict, LALDictKey *key, UINT8 value);
+int XLALDictInsertREAL4ValueByKey(LALDict *dict, LALDictKey *key, REAL4 value);
+int XLALDictInsertREAL8ValueByKey(LALDict *dict, LALDictKey *key, REAL8 value);
+int XLALDictInsertCOMPLEX8ValueByKey(LALDict *dict, LALDictKey *key, COMPLEX8 value);
+int XLALDictInsertCOMPLEX16ValueByKey(LALDict *dict, LALDictKey *key, COMPLEX16 value);
+
+LALDictEntry *XLALDictLookupByKey(LALDict *dict, LALDictKey *key);
+/* warning: shallow pointer */
+const char * XLALDictLookupStringValueByKey(LALDict *dict, LALDictKey *key);
+CHAR XLALDictLookupCHARValueByKey(LALDict *dict, LALDictKey *key);
+INT2 XLALDictLookupINT2ValueByKey(LALDict *dict, LALDictKey *key);
+INT4 XLALDictLookupINT4ValueByKey(LALDict *dict, LALDictKey *key);
+INT8 XLALDictLookupINT8ValueByKey(LALDict *dict, LALDictKey *key);
+UCHAR XLALDictLookupUCHARValueByKey(LALDict *dict, LALDictKey *key);
+UINT2 XLALDictLookupUINT2ValueByKey(LALDict *dict, LALDictKey *key);
+UINT4 XLALDictLookupUINT4ValueByKey(LALDict *dict, LALDictKey *key);
+UINT8 XLALDictLookupUINT8ValueByKey(LALDict *dict, LALDictKey *key);
+REAL4 XLALDictLookupREAL4ValueByKey(LALDict *dict, LALDictKey *key);
+REAL8 XLALDictLookupREAL8ValueByKey(LALDict *dict, LALDictKey *key);
+COMPLEX8 XLALDictLookupCOMPLEX8ValueByKey(LALDict *dict, LALDictKey *key);
+COMPLEX16 XLALDictLookupCOMPLEX16ValueByKey(LALDict *dict, LALDictKey *key);
+#endif /* SWIG */
+
 void XLALDictPrint(LALDict *dict, int fd);
 
 #if 0
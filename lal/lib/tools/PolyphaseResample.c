@@ -0,0 +1,506 @@
+/*
+*  Copyright (C) 2026 Jolien Creighton
+*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <math.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/Window.h>
+#include <lal/ResampleTimeSeries.h>
+
+/**
+ * \defgroup PolyphaseResample_c Module PolyphaseResample.c
+ * \ingroup ResampleTimeSeries_h
+ *
+ * \brief Streaming polyphase FIR resampling by an arbitrary rational factor.
+ *
+ * A ::PolyphaseResampler changes the sample rate of one or more channels by
+ * the rational factor \f$p/q\f$: the input is (notionally) upsampled by
+ * \f$p\f$, low pass filtered and decimated by \f$q\f$.  The low pass filter
+ * is a Kaiser-windowed sinc with its cutoff at the lower of the input and
+ * output Nyquist frequencies and \f$2 h \max(p, q) + 1\f$ taps at the
+ * upsampled rate, where \f$h\f$ is the number of zero crossings of the sinc
+ * kept on either side of its peak.  The filter is split into its \f$p\f$
+ * polyphase components of \f$\lceil (2 h \max(p, q) + 1) / p \rceil\f$ taps
+ * each, so that each output sample costs one short dot product with the
+ * input and neither the zero-stuffed nor the decimated-away samples are
+ * ever computed.
+ *
+ * The resampler carries the last few input samples of each channel from one
+ * call to the next, so a long (or unbounded) stream can be processed in
+ * chunks of any length with bounded memory, and the concatenated output is
+ * identical to what processing the whole stream at once would produce.  The
+ * number of output samples produced by a chunk depends on the phase left by
+ * the previous chunk; XLALPolyphaseResamplerOutputLength() reports it before
+ * the chunk is processed.  The output of the streaming interface is delayed
+ * with respect to the input by the group delay of the filter, which is
+ * returned by XLALPolyphaseResamplerDelay() in units of input samples.
+ *
+ * XLALResampleREAL4TimeSeriesPolyphase() and
+ * XLALResampleREAL8TimeSeriesPolyphase() resample a whole time series in
+ * place, compensating the group delay so that there is no time shift in the
+ * output time series.  As with XLALResampleREAL8TimeSeries(), data within
+ * about \f$h \max(p, q) / p\f$ input samples of either end of the time
+ * series are corrupted by the filter transient.
+ *
+ * When more than one channel is processed at once, the channels are
+ * distributed over threads if LAL was built with OpenMP.  The inner loops
+ * are written with independent partial sums so that the compiler can
+ * vectorise them.
+ */
+/** @{ */
+
+/** Default number of sinc zero crossings on either side of the peak */
+#define POLYPHASE_DEFAULT_HALF_LENGTH 10
+/** Default Kaiser window shape parameter */
+#define POLYPHASE_DEFAULT_BETA 5.0
+
+struct tagPolyphaseResampler {
+  UINT4 upFactor;      /* p */
+  UINT4 downFactor;    /* q */
+  UINT4 numChannels;
+  UINT4 numTaps;       /* taps per polyphase component */
+  UINT4 delay;         /* group delay in samples at the upsampled rate */
+  REAL8 *coef8;        /* upFactor x numTaps, each component time reversed */
+  REAL4 *coef4;        /* single-precision copy of coef8 */
+  REAL8 *history;      /* numChannels x (numTaps - 1) previous input samples */
+  REAL8 *edge8;        /* numChannels x 2 (numTaps - 1) scratch */
+  REAL4 *edge4;        /* numChannels x 2 (numTaps - 1) scratch */
+  UINT8 index;         /* input index of next output in the next chunk */
+  UINT4 phase;         /* polyphase component of next output */
+};
+
+static UINT4 gcd( UINT4 a, UINT4 b )
+{
+  while ( b )
+  {
+    UINT4 t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/* number of outputs produced by a chunk of length n given the current
+ * position, which is index * p + phase at the upsampled rate */
+static UINT8 polyphase_count( const PolyphaseResampler *r, UINT8 n )
+{
+  UINT8 start = r->index * r->upFactor + r->phase;
+  UINT8 end = n * r->upFactor;
+  return end > start ? ( end - start + r->downFactor - 1 ) / r->downFactor : 0;
+}
+
+/* advance the position past a chunk of length n that produced count outputs */
+static void polyphase_advance( PolyphaseResampler *r, UINT8 n, UINT8 count )
+{
+  UINT8 pos = r->index * r->upFactor + r->phase + count * r->downFactor;
+  r->index = pos / r->upFactor - n;
+  r->phase = pos % r->upFactor;
+}
+
+#define DEFINE_POLYPHASE(TYPE) \
+  static TYPE polyphase_dot_##TYPE( const TYPE *restrict h, const TYPE *restrict x, UINT4 n ) \
+  { \
+    TYPE s0 = 0, s1 = 0, s2 = 0, s3 = 0; \
+    UINT4 k; \
+    for ( k = 0; k + 4 <= n; k += 4 ) \
+    { \
+      s0 += h[k] * x[k]; \
+      s1 += h[k + 1] * x[k + 1]; \
+      s2 += h[k + 2] * x[k + 2]; \
+      s3 += h[k + 3] * x[k + 3]; \
+    } \
+    for ( ; k < n; ++k ) \
+      s0 += h[k] * x[k]; \
+    return ( s0 + s1 ) + ( s2 + s3 ); \
+  } \
+  \
+  static void polyphase_channel_##TYPE( TYPE *out, const TYPE *in, UINT4 n, UINT8 count, \
+      const TYPE *coef, UINT4 p, UINT4 q, UINT4 ntaps, UINT8 index, UINT4 phase, \
+      REAL8 *history, TYPE *edge ) \
+  { \
+    const UINT4 nh = ntaps - 1; \
+    const UINT4 ne = n < nh ? n : nh; \
+    UINT8 m; \
+    UINT4 j; \
+    /* the windows of the first few outputs straddle the previous chunk */ \
+    for ( j = 0; j < nh; ++j ) \
+      edge[j] = history[j]; \
+    for ( j = 0; j < ne; ++j ) \
+      edge[nh + j] = in[j]; \
+    for ( m = 0; m < count; ++m ) \
+    { \
+      const TYPE *x = index >= nh ? in + ( index - nh ) : edge + index; \
+      out[m] = polyphase_dot_##TYPE( coef + (size_t)phase * ntaps, x, ntaps ); \
+      phase += q; \
+      index += phase / p; \
+      phase %= p; \
+    } \
+    /* keep the last nh samples of the stream for the next chunk */ \
+    if ( n >= nh ) \
+      for ( j = 0; j < nh; ++j ) \
+        history[j] = in[n - nh + j]; \
+    else \
+    { \
+      memmove( history, history + n, ( nh - n ) * sizeof( *history ) ); \
+      for ( j = 0; j < n; ++j ) \
+        history[nh - n + j] = in[j]; \
+    } \
+  }
+
+DEFINE_POLYPHASE(REAL4)
+DEFINE_POLYPHASE(REAL8)
+
+#undef DEFINE_POLYPHASE
+
+/**
+ * Creates a resampler that changes the sample rate of \c numChannels
+ * channels by the factor \c upFactor / \c downFactor.  The factor is reduced
+ * to lowest terms.  \c halfLength is the number of sinc zero crossings kept
+ * on either side of the peak of the anti-aliasing filter and \c beta is the
+ * Kaiser window shape parameter; larger values of either give a sharper
+ * transition and greater stop band attenuation at greater cost.  If
+ * \c halfLength is 0 the defaults \f$h = 10\f$ and \f$\beta = 5\f$ are used,
+ * which attenuate the stop band by about 50 dB.
+ */
+PolyphaseResampler *XLALCreatePolyphaseResampler( UINT4 upFactor, UINT4 downFactor,
+    UINT4 numChannels, UINT4 halfLength, REAL8 beta )
+{
+  PolyphaseResampler *r;
+  REAL8Window *window;
+  UINT4 g, maxFactor, length, ntaps, nh, ph, k;
+
+  XLAL_CHECK_NULL( upFactor > 0 && downFactor > 0, XLAL_EINVAL, "resampling factors must be positive" );
+  XLAL_CHECK_NULL( numChannels > 0, XLAL_EINVAL, "number of channels must be positive" );
+  XLAL_CHECK_NULL( beta >= 0, XLAL_EINVAL, "Kaiser beta must be non-negative" );
+  if ( halfLength == 0 )
+  {
+    halfLength = POLYPHASE_DEFAULT_HALF_LENGTH;
+    beta = POLYPHASE_DEFAULT_BETA;
+  }
+
+  g = gcd( upFactor, downFactor );
+  upFactor /= g;
+  downFactor /= g;
+  maxFactor = upFactor > downFactor ? upFactor : downFactor;
+  XLAL_CHECK_NULL( (UINT8)halfLength * maxFactor < ( 1U << 30 ), XLAL_EINVAL, "filter too long" );
+  length = 2 * halfLength * maxFactor + 1;
+  ntaps = ( length + upFactor - 1 ) / upFactor;
+  nh = ntaps - 1;
+
+  r = LALCalloc( 1, sizeof( *r ) );
+  if ( ! r )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  r->upFactor = upFactor;
+  r->downFactor = downFactor;
+  r->numChannels = numChannels;
+  r->numTaps = ntaps;
+  r->delay = halfLength * maxFactor;
+  r->coef8 = LALCalloc( (size_t)upFactor * ntaps, sizeof( *r->coef8 ) );
+  r->coef4 = LALCalloc( (size_t)upFactor * ntaps, sizeof( *r->coef4 ) );
+  r->history = LALCalloc( (size_t)numChannels * nh + 1, sizeof( *r->history ) );
+  r->edge8 = LALCalloc( (size_t)numChannels * 2 * nh + 1, sizeof( *r->edge8 ) );
+  r->edge4 = LALCalloc( (size_t)numChannels * 2 * nh + 1, sizeof( *r->edge4 ) );
+  window = XLALCreateKaiserREAL8Window( length, beta );
+  if ( ! r->coef8 || ! r->coef4 || ! r->history || ! r->edge8 || ! r->edge4 || ! window )
+  {
+    XLALDestroyREAL8Window( window );
+    XLALDestroyPolyphaseResampler( r );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+
+  /* prototype filter h[n] = (p / R) sinc((n - c) / R) w[n] with R = max(p,
+   * q) and c = h R, scaled by p to make up for the zeros stuffed between
+   * input samples; component ph holds h[ph + k p] in reverse order so that
+   * it lines up with the input samples in time order */
+  for ( ph = 0; ph < upFactor; ++ph )
+    for ( k = 0; k < ntaps; ++k )
+    {
+      UINT4 n = ph + k * upFactor;
+      REAL8 h = 0;
+      if ( n < length )
+      {
+        REAL8 x = ( (REAL8)n - (REAL8)r->delay ) / maxFactor;
+        h = (REAL8)upFactor / maxFactor * window->data->data[n];
+        if ( x != 0 )
+          h *= sin( LAL_PI * x ) / ( LAL_PI * x );
+      }
+      r->coef8[(size_t)ph * ntaps + nh - k] = h;
+      r->coef4[(size_t)ph * ntaps + nh - k] = h;
+    }
+
+  XLALDestroyREAL8Window( window );
+  return r;
+}
+
+/** Destroys a resampler created by XLALCreatePolyphaseResampler(). */
+void XLALDestroyPolyphaseResampler( PolyphaseResampler *resampler )
+{
+  if ( resampler )
+  {
+    LALFree( resampler->coef8 );
+    LALFree( resampler->coef4 );
+    LALFree( resampler->history );
+    LALFree( resampler->edge8 );
+    LALFree( resampler->edge4 );
+    LALFree( resampler );
+  }
+  return;
+}
+
+/**
+ * Clears the input history of a resampler and returns it to the state it
+ * had when it was created, so that it can be used on a new stream.
+ */
+int XLALResetPolyphaseResampler( PolyphaseResampler *resampler )
+{
+  XLAL_CHECK( resampler, XLAL_EFAULT );
+  memset( resampler->history, 0, (size_t)resampler->numChannels * ( resampler->numTaps - 1 ) * sizeof( *resampler->history ) );
+  resampler->index = 0;
+  resampler->phase = 0;
+  return 0;
+}
+
+/**
+ * Returns the number of output samples per channel that the next call to
+ * one of the XLALPolyphaseResample functions will produce from an input
+ * chunk of \c inputLength samples per channel.
+ */
+UINT4 XLALPolyphaseResamplerOutputLength( const PolyphaseResampler *resampler, UINT4 inputLength )
+{
+  XLAL_CHECK_VAL( 0, resampler, XLAL_EFAULT );
+  return polyphase_count( resampler, inputLength );
+}
+
+/**
+ * Returns the delay of the output of a resampler with respect to its input,
+ * in units of input samples.
+ */
+REAL8 XLALPolyphaseResamplerDelay( const PolyphaseResampler *resampler )
+{
+  XLAL_CHECK_REAL8( resampler, XLAL_EFAULT );
+  return (REAL8)resampler->delay / resampler->upFactor;
+}
+
+/**
+ * Resamples a chunk of a single-channel stream.  The output vector must be
+ * at least XLALPolyphaseResamplerOutputLength() long.  Returns the number of
+ * output samples written, or #XLAL_FAILURE on error.
+ */
+int XLALPolyphaseResampleREAL4Vector( REAL4Vector *output, const REAL4Vector *input, PolyphaseResampler *resampler )
+{
+  UINT8 count;
+  XLAL_CHECK( output && input && resampler, XLAL_EFAULT );
+  XLAL_CHECK( output->data && input->data, XLAL_EINVAL );
+  XLAL_CHECK( resampler->numChannels == 1, XLAL_EINVAL, "resampler has %u channels", resampler->numChannels );
+  count = polyphase_count( resampler, input->length );
+  XLAL_CHECK( output->length >= count, XLAL_EBADLEN, "output length %u is less than %" LAL_UINT8_FORMAT, output->length, count );
+  polyphase_channel_REAL4( output->data, input->data, input->length, count, resampler->coef4,
+      resampler->upFactor, resampler->downFactor, resampler->numTaps, resampler->index, resampler->phase,
+      resampler->history, resampler->edge4 );
+  polyphase_advance( resampler, input->length, count );
+  return count;
+}
+
+/**
+ * Resamples a chunk of a multi-channel stream.  Each vector of the input
+ * sequence holds one channel; the output sequence must have the same number
+ * of vectors, each at least XLALPolyphaseResamplerOutputLength() long.
+ * Returns the number of output samples written to each channel, or
+ * #XLAL_FAILURE on error.
+ */
+int XLALPolyphaseResampleREAL4VectorSequence( REAL4VectorSequence *output, const REAL4VectorSequence *input, PolyphaseResampler *resampler )
+{
+  UINT8 count;
+  UINT4 nh;
+  INT4 i;
+  XLAL_CHECK( output && input && resampler, XLAL_EFAULT );
+  XLAL_CHECK( output->data && input->data, XLAL_EINVAL );
+  XLAL_CHECK( input->length == resampler->numChannels && output->length == resampler->numChannels, XLAL_EBADLEN, "resampler has %u channels", resampler->numChannels );
+  count = polyphase_count( resampler, input->vectorLength );
+  XLAL_CHECK( output->vectorLength >= count, XLAL_EBADLEN, "output vector length %u is less than %" LAL_UINT8_FORMAT, output->vectorLength, count );
+  nh = resampler->numTaps - 1;
+#pragma omp parallel for schedule(static) if(input->length > 1)
+  for ( i = 0; i < (INT4)input->length; ++i )
+    polyphase_channel_REAL4( output->data + (size_t)i * output->vectorLength,
+        input->data + (size_t)i * input->vectorLength, input->vectorLength, count, resampler->coef4,
+        resampler->upFactor, resampler->downFactor, resampler->numTaps, resampler->index, resampler->phase,
+        resampler->history + (size_t)i * nh, resampler->edge4 + (size_t)i * 2 * nh );
+  polyphase_advance( resampler, input->vectorLength, count );
+  return count;
+}
+
+/**
+ * Resamples a chunk of a single-channel stream.  The output vector must be
+ * at least XLALPolyphaseResamplerOutputLength() long.  Returns the number of
+ * output samples written, or #XLAL_FAILURE on error.
+ */
+int XLALPolyphaseResampleREAL8Vector( REAL8Vector *output, const REAL8Vector *input, PolyphaseResampler *resampler )
+{
+  UINT8 count;
+  XLAL_CHECK( output && input && resampler, XLAL_EFAULT );
+  XLAL_CHECK( output->data && input->data, XLAL_EINVAL );
+  XLAL_CHECK( resampler->numChannels == 1, XLAL_EINVAL, "resampler has %u channels", resampler->numChannels );
+  count = polyphase_count( resampler, input->length );
+  XLAL_CHECK( output->length >= count, XLAL_EBADLEN, "output length %u is less than %" LAL_UINT8_FORMAT, output->length, count );
+  polyphase_channel_REAL8( output->data, input->data, input->length, count, resampler->coef8,
+      resampler->upFactor, resampler->downFactor, resampler->numTaps, resampler->index, resampler->phase,
+      resampler->history, resampler->edge8 );
+  polyphase_advance( resampler, input->length, count );
+  return count;
+}
+
+/**
+ * Resamples a chunk of a multi-channel stream.  Each vector of the input
+ * sequence holds one channel; the output sequence must have the same number
+ * of vectors, each at least XLALPolyphaseResamplerOutputLength() long.
+ * Returns the number of output samples written to each channel, or
+ * #XLAL_FAILURE on error.
+ */
+int XLALPolyphaseResampleREAL8VectorSequence( REAL8VectorSequence *output, const REAL8VectorSequence *input, PolyphaseResampler *resampler )
+{
+  UINT8 count;
+  UINT4 nh;
+  INT4 i;
+  XLAL_CHECK( output && input && resampler, XLAL_EFAULT );
+  XLAL_CHECK( output->data && input->data, XLAL_EINVAL );
+  XLAL_CHECK( input->length == resampler->numChannels && output->length == resampler->numChannels, XLAL_EBADLEN, "resampler has %u channels", resampler->numChannels );
+  count = polyphase_count( resampler, input->vectorLength );
+  XLAL_CHECK( output->vectorLength >= count, XLAL_EBADLEN, "output vector length %u is less than %" LAL_UINT8_FORMAT, output->vectorLength, count );
+  nh = resampler->numTaps - 1;
+#pragma omp parallel for schedule(static) if(input->length > 1)
+  for ( i = 0; i < (INT4)input->length; ++i )
+    polyphase_channel_REAL8( output->data + (size_t)i * output->vectorLength,
+        input->data + (size_t)i * input->vectorLength, input->vectorLength, count, resampler->coef8,
+        resampler->upFactor, resampler->downFactor, resampler->numTaps, resampler->index, resampler->phase,
+        resampler->history + (size_t)i * nh, resampler->edge8 + (size_t)i * 2 * nh );
+  polyphase_advance( resampler, input->vectorLength, count );
+  return count;
+}
+
+/* find q / p = x with p, q <= maxden by continued fractions */
+static int polyphase_ratio( UINT4 *up, UINT4 *down, REAL8 x, UINT8 maxden )
+{
+  UINT8 h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+  REAL8 r = x;
+  while ( 1 )
+  {
+    UINT8 a = floor( r );
+    UINT8 h2 = a * h1 + h0;
+    UINT8 k2 = a * k1 + k0;
+    if ( h2 > maxden || k2 > maxden )
+      return -1;
+    h0 = h1;
+    h1 = h2;
+    k0 = k1;
+    k1 = k2;
+    if ( fabs( x - (REAL8)h1 / k1 ) <= 1e-9 * x )
+      break;
+    r -= a;
+    if ( r <= 0 )
+      return -1;
+    r = 1 / r;
+  }
+  *down = h1;
+  *up = k1;
+  return 0;
+}
+
+#define DEFINE_POLYPHASE_TIMESERIES(TYPE) \
+  int XLALResample##TYPE##TimeSeriesPolyphase( TYPE##TimeSeries *series, REAL8 dt ) \
+  { \
+    PolyphaseResampler *r; \
+    TYPE##Vector *out = NULL; \
+    TYPE##Vector *tail = NULL; \
+    UINT4 up, down, inlen, outlen, ntail, nfirst; \
+    int nfirst_out, ntail_out; \
+    \
+    XLAL_CHECK( series && series->data && series->data->data, XLAL_EFAULT ); \
+    XLAL_CHECK( series->data->length > 0, XLAL_EBADLEN ); \
+    XLAL_CHECK( series->deltaT > 0 && dt > 0, XLAL_EINVAL ); \
+    XLAL_CHECK( polyphase_ratio( &up, &down, dt / series->deltaT, 1 << 16 ) == 0, XLAL_EINVAL, \
+        "resampling factor %g is not a ratio of integers no greater than 65536", dt / series->deltaT ); \
+    \
+    if ( up == down ) \
+    { \
+      XLALPrintInfo( "XLAL Info - %s: No resampling required\n", __func__ ); \
+      return 0; \
+    } \
+    \
+    inlen = series->data->length; \
+    outlen = (UINT8)inlen * up / down; \
+    r = XLALCreatePolyphaseResampler( up, down, 1, 0, 0 ); \
+    XLAL_CHECK( r, XLAL_EFUNC ); \
+    \
+    /* start the output a group delay into the stream so that it is not \
+     * shifted in time, and flush the filter with zeros at the end */ \
+    r->index = r->delay / r->upFactor; \
+    r->phase = r->delay % r->upFactor; \
+    ntail = r->index + r->numTaps + 1; \
+    nfirst = polyphase_count( r, inlen ); \
+    out = XLALCreate##TYPE##Vector( polyphase_count( r, (UINT8)inlen + ntail ) ); \
+    tail = XLALCreate##TYPE##Vector( ntail ); \
+    if ( ! out || ! tail ) \
+    { \
+      XLALDestroy##TYPE##Vector( out ); \
+      XLALDestroy##TYPE##Vector( tail ); \
+      XLALDestroyPolyphaseResampler( r ); \
+      XLAL_ERROR( XLAL_EFUNC ); \
+    } \
+    memset( tail->data, 0, ntail * sizeof( *tail->data ) ); \
+    nfirst_out = XLALPolyphaseResample##TYPE##Vector( out, series->data, r ); \
+    ntail_out = -1; \
+    if ( nfirst_out >= 0 ) \
+    { \
+      out->data += nfirst; \
+      out->length -= nfirst; \
+      ntail_out = XLALPolyphaseResample##TYPE##Vector( out, tail, r ); \
+      out->data -= nfirst; \
+      out->length += nfirst; \
+    } \
+    XLALDestroy##TYPE##Vector( tail ); \
+    XLALDestroyPolyphaseResampler( r ); \
+    if ( nfirst_out < 0 || ntail_out < 0 ) \
+    { \
+      XLALDestroy##TYPE##Vector( out ); \
+      XLAL_ERROR( XLAL_EFUNC ); \
+    } \
+    \
+    if ( ! XLALResize##TYPE##Vector( series->data, outlen ) ) \
+    { \
+      XLALDestroy##TYPE##Vector( out ); \
+      XLAL_ERROR( XLAL_EFUNC ); \
+    } \
+    memcpy( series->data->data, out->data, outlen * sizeof( *out->data ) ); \
+    XLALDestroy##TYPE##Vector( out ); \
+    series->deltaT = dt; \
+    \
+    return 0; \
+  }
+
+/** \see See \ref PolyphaseResample_c for documentation */
+DEFINE_POLYPHASE_TIMESERIES(REAL4)
+/** \see See \ref PolyphaseResample_c for documentation */
+DEFINE_POLYPHASE_TIMESERIES(REAL8)
+
+#undef DEFINE_POLYPHASE_TIMESERIES
+
+/** @} */
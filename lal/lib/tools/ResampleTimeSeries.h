@@ -36,7 +36,10 @@ extern "C" {
  *
  * \brief Provides routines to resample a time series.
  *
- * At present only integer downsampling of ::REAL4TimeSeries by a power of two is supported.
+ * XLALResampleREAL4TimeSeries() and XLALResampleREAL8TimeSeries() support
+ * integer downsampling by a power of two.  Resampling by an arbitrary
+ * rational factor, either of a whole time series or of a stream processed in
+ * chunks, is provided by the polyphase resampler in \ref PolyphaseResample_c.
  *
  * ### Synopsis ###
  *
@@ -129,6 +132,12 @@ tagResampleTSParams
 }
 ResampleTSParams;
 
+/**
+ * Opaque state of a streaming polyphase rational resampler.
+ * See \ref PolyphaseResample_c for documentation.
+ */
+typedef struct tagPolyphaseResampler PolyphaseResampler;
+
 /** @} */
 
 /* ---------- Function prototypes ---------- */
@@ -136,6 +145,25 @@ ResampleTSParams;
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt );
 int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt );
 
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(VIEWIN_ARRAYS(REAL4Vector, output));
+SWIGLAL(VIEWIN_ARRAYS(REAL8Vector, output));
+SWIGLAL(VIEWIN_ARRAYS(REAL4VectorSequence, output));
+SWIGLAL(VIEWIN_ARRAYS(REAL8VectorSequence, output));
+#endif /* SWIG */
+
+PolyphaseResampler *XLALCreatePolyphaseResampler( UINT4 upFactor, UINT4 downFactor, UINT4 numChannels, UINT4 halfLength, REAL8 beta );
+void XLALDestroyPolyphaseResampler( PolyphaseResampler *resampler );
+int XLALResetPolyphaseResampler( PolyphaseResampler *resampler );
+UINT4 XLALPolyphaseResamplerOutputLength( const PolyphaseResampler *resampler, UINT4 inputLength );
+REAL8 XLALPolyphaseResamplerDelay( const PolyphaseResampler *resampler );
+int XLALPolyphaseResampleREAL4Vector( REAL4Vector *output, const REAL4Vector *input, PolyphaseResampler *resampler );
+int XLALPolyphaseResampleREAL8Vector( REAL8Vector *output, const REAL8Vector *input, PolyphaseResampler *resampler );
+int XLALPolyphaseResampleREAL4VectorSequence( REAL4VectorSequence *output, const REAL4VectorSequence *input, PolyphaseResampler *resampler );
+int XLALPolyphaseResampleREAL8VectorSequence( REAL8VectorSequence *output, const REAL8VectorSequence *input, PolyphaseResampler *resampler );
+int XLALResampleREAL4TimeSeriesPolyphase( REAL4TimeSeries *series, REAL8 dt );
+int XLALResampleREAL8TimeSeriesPolyphase( REAL8TimeSeries *series, REAL8 dt );
+
 void
 LALResampleREAL4TimeSeries(
     LALStatus          *status,
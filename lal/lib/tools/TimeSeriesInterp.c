@@ -19,6 +19,7 @@
 
 
 #include <math.h>
+#include <string.h>
 
 
 #include <lal/Date.h>
@@ -116,9 +117,25 @@ struct tagLALREAL8SequenceInterp {
 	/* calling-code supplied kernel generator */
 	void (*kernel)(double *, int, double, void *);
 	void *kernel_data;
+	/* table of kernels at equally-spaced residuals for the batch
+	 * evaluator, allocated on first use.  kernel_table_phases is 0
+	 * until the table has been built, and -1 if it is too large to
+	 * build */
+	double *kernel_table;
+	int kernel_table_phases;
 };
 
 
+/*
+ * largest kernel table, in doubles, the batch evaluator will build.  above
+ * this, it recomputes kernels as needed the way the single-sample
+ * evaluator does.
+ */
+
+
+#define KERNEL_TABLE_MAX_SIZE (1 << 22)
+
+
 /**
  * Create a new REAL8Sequence interpolator associated with the given
  * REAL8Sequence object.  The kernel_length parameter sets the length of
@@ -220,6 +237,8 @@ LALREAL8SequenceInterp *XLALREAL8SequenceInterpCreate(const REAL8Sequence *s, in
 	}
 	interp->kernel = kernel;
 	interp->kernel_data = kernel_data;
+	interp->kernel_table = NULL;
+	interp->kernel_table_phases = 0;
 
 	return interp;
 }
@@ -234,6 +253,7 @@ void XLALREAL8SequenceInterpDestroy(LALREAL8SequenceInterp *interp)
 {
 	if(interp) {
 		XLALFree(interp->cached_kernel);
+		XLALFree(interp->kernel_table);
 		/* unref the REAL8Sequence.  place-holder in case this code
 		 * is ported to a language where this matters */
 		interp->s = NULL;
@@ -316,6 +336,206 @@ REAL8 XLALREAL8SequenceInterpEval(LALREAL8SequenceInterp *interp, double x, int
 }
 
 
+/*
+ * build the table of kernels used by the batch evaluator.  the residual is
+ * sampled at the no-op threshold, so the kernel chosen for any residual
+ * is never further from the exact one than the single-sample evaluator
+ * allows its cached kernel to drift.  the middle entry is residual = 0.
+ */
+
+
+static int build_kernel_table(LALREAL8SequenceInterp *interp)
+{
+	int phases = 2 * (int) ceil(0.5 / interp->noop_threshold) + 1;
+	int i;
+
+	if((double) phases * interp->kernel_length > KERNEL_TABLE_MAX_SIZE) {
+		interp->kernel_table_phases = -1;
+		return 0;
+	}
+
+	interp->kernel_table = XLALMalloc(phases * interp->kernel_length * sizeof(*interp->kernel_table));
+	if(!interp->kernel_table)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	for(i = 0; i < phases; i++) {
+		double *kern = interp->kernel_table + i * interp->kernel_length;
+		if(i == phases / 2 && interp->kernel == default_kernel) {
+			/* the default kernel is 0/0 here.  it's a delta
+			 * function */
+			memset(kern, 0, interp->kernel_length * sizeof(*kern));
+			kern[(interp->kernel_length - 1) / 2] = 1.;
+		} else
+			interp->kernel(kern, interp->kernel_length, (double) i / (phases - 1) - 0.5, interp->kernel_data);
+	}
+	interp->kernel_table_phases = phases;
+
+	return 0;
+}
+
+
+/*
+ * inner product of kernel and samples.  four partial sums let the
+ * compiler vectorize the loop.
+ */
+
+
+static double inner_product(const double *kern, const REAL8 *data, int n)
+{
+	double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+	int i;
+
+	for(i = 0; i + 4 <= n; i += 4) {
+		s0 += kern[i] * data[i];
+		s1 += kern[i + 1] * data[i + 1];
+		s2 += kern[i + 2] * data[i + 2];
+		s3 += kern[i + 3] * data[i + 3];
+	}
+	for(; i < n; i++)
+		s0 += kern[i] * data[i];
+
+	return (s0 + s1) + (s2 + s3);
+}
+
+
+/*
+ * evaluate at x using the kernel table.  if interior is non-zero the
+ * caller guarantees the kernel lies entirely within the data.
+ */
+
+
+static REAL8 table_eval(const LALREAL8SequenceInterp *interp, double x, int interior)
+{
+	const int length = interp->s->length;
+	const int phases = interp->kernel_table_phases;
+	int start = lround(x);
+	int phase = lround((start - x + 0.5) * (phases - 1));
+	const double *kern = interp->kernel_table + phase * interp->kernel_length;
+	int n = interp->kernel_length;
+
+	/* special no-op case for default kernel */
+	if(phase == phases / 2 && interp->kernel == default_kernel)
+		return 0 <= start && start < length ? interp->s->data[start] : 0.0;
+
+	start -= (interp->kernel_length - 1) / 2;
+	if(!interior) {
+		if(start + n > length)
+			n -= start + n - length;
+		if(start < 0) {
+			kern -= start;
+			n += start;
+			start = 0;
+		}
+		if(n <= 0)
+			return 0.0;
+	}
+
+	return inner_product(kern, interp->s->data + start, n);
+}
+
+
+/* evaluate at offset + scale * x[i] for i in [0, n) */
+
+
+static int batch_eval(LALREAL8SequenceInterp *interp, REAL8 *result, const REAL8 *x, size_t n, double offset, double scale, int bounds_check)
+{
+	const int half = (interp->kernel_length - 1) / 2;
+	const double length = interp->s->length;
+	size_t head, tail, i;
+	int sorted = 1;
+
+	if(!n)
+		return 0;
+
+	/* the kernel table is built on first use */
+	if(!interp->kernel_table_phases)
+		if(build_kernel_table(interp) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+
+	/* no table:  evaluate one sample at a time.  the kernel cache
+	 * still helps if the residual changes slowly */
+	if(interp->kernel_table_phases < 0) {
+		for(i = 0; i < n; i++) {
+			result[i] = XLALREAL8SequenceInterpEval(interp, offset + scale * x[i], bounds_check);
+			if(XLAL_IS_REAL8_FAIL_NAN(result[i]))
+				XLAL_ERROR(XLAL_EFUNC);
+		}
+		return 0;
+	}
+
+	/* sorted input is the common case.  it needs only its end points
+	 * checked, and the samples whose kernels lie entirely within the
+	 * data are a single contiguous block that can skip the edge
+	 * handling.  NaNs fail the comparison, so they take the unsorted
+	 * path */
+	for(i = 1; i < n; i++)
+		if(!(x[i] >= x[i - 1])) {
+			sorted = 0;
+			break;
+		}
+	if(scale < 0.)
+		sorted = 0;
+
+	if(sorted) {
+		double first = offset + scale * x[0];
+		double last = offset + scale * x[n - 1];
+		if(!isfinite(first) || !isfinite(last) || (bounds_check && (first < 0 || last >= length)))
+			XLAL_ERROR(XLAL_EDOM);
+
+		for(head = 0; head < n && lround(offset + scale * x[head]) - half < 0; head++)
+			result[head] = table_eval(interp, offset + scale * x[head], 0);
+		for(tail = n; tail > head && lround(offset + scale * x[tail - 1]) + half >= length; tail--)
+			result[tail - 1] = table_eval(interp, offset + scale * x[tail - 1], 0);
+#pragma omp parallel for schedule(static)
+		for(i = head; i < tail; i++)
+			result[i] = table_eval(interp, offset + scale * x[i], 1);
+	} else {
+		for(i = 0; i < n; i++) {
+			double xi = offset + scale * x[i];
+			if(!isfinite(xi) || (bounds_check && (xi < 0 || xi >= length)))
+				XLAL_ERROR(XLAL_EDOM);
+		}
+#pragma omp parallel for schedule(static)
+		for(i = 0; i < n; i++)
+			result[i] = table_eval(interp, offset + scale * x[i], 0);
+	}
+
+	return 0;
+}
+
+
+/**
+ * Evaluate a LALREAL8SequenceInterp at each of the real-valued indexes in
+ * x, storing the results in result, which must have the same length as x.
+ * The treatment of the boundaries and the meaning of bounds_check are the
+ * same as for XLALREAL8SequenceInterpEval().
+ *
+ * Instead of caching the most recent kernel, the batch evaluator tabulates
+ * the kernel once, at residuals spaced by the no-op threshold, and uses
+ * the nearest entry for each sample.  The results therefore agree with
+ * XLALREAL8SequenceInterpEval() to within the same error that function's
+ * kernel cache allows, but do not depend on the order in which samples
+ * are evaluated.  The table costs about 4 kernel_length^2 doubles; for
+ * kernels too long to tabulate, the samples are evaluated one at a time.
+ * Sorted x, the common case when resampling or injecting, avoids the
+ * per-sample boundary checks.
+ */
+
+
+int XLALREAL8SequenceInterpEvalBatch(LALREAL8SequenceInterp *interp, REAL8Sequence *result, const REAL8Sequence *x, int bounds_check)
+{
+	if(!interp || !result || !x)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(result->length != x->length)
+		XLAL_ERROR(XLAL_EBADLEN);
+
+	if(batch_eval(interp, result->data, x->data, x->length, 0., 1., bounds_check) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
+
+
 struct tagLALREAL8TimeSeriesInterp {
 	const REAL8TimeSeries *series;
 	LALREAL8SequenceInterp *seqinterp;
@@ -397,3 +617,30 @@ REAL8 XLALREAL8TimeSeriesInterpEval(LALREAL8TimeSeriesInterp *interp, const LIGO
 {
 	return XLALREAL8SequenceInterpEval(interp->seqinterp, XLALGPSDiff(t, &interp->series->epoch) / interp->series->deltaT, bounds_check);
 }
+
+
+/**
+ * Evaluate a LALREAL8TimeSeriesInterp at the times t0 + dt[i], where the
+ * offsets dt are in seconds, storing the results in result, which must
+ * have the same length as dt.  Expressing the times as offsets from a
+ * single LIGOTimeGPS avoids a GPS time subtraction per sample without
+ * losing precision.  The meaning of bounds_check is the same as for
+ * XLALREAL8TimeSeriesInterpEval().
+ *
+ * See XLALREAL8SequenceInterpEvalBatch() for information about the
+ * kernel table used by the batch evaluator.
+ */
+
+
+int XLALREAL8TimeSeriesInterpEvalBatch(LALREAL8TimeSeriesInterp *interp, REAL8Sequence *result, const LIGOTimeGPS *t0, const REAL8Sequence *dt, int bounds_check)
+{
+	if(!interp || !result || !t0 || !dt)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(result->length != dt->length)
+		XLAL_ERROR(XLAL_EBADLEN);
+
+	if(batch_eval(interp->seqinterp, result->data, dt->data, dt->length, XLALGPSDiff(t0, &interp->series->epoch) / interp->series->deltaT, 1. / interp->series->deltaT, bounds_check) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	return 0;
+}
@@ -42,6 +42,7 @@ typedef struct tagLALREAL8SequenceInterp LALREAL8SequenceInterp;
 LALREAL8SequenceInterp *XLALREAL8SequenceInterpCreate(const REAL8Sequence *, int, void (*)(double *, int, double, void *), void *);
 void XLALREAL8SequenceInterpDestroy(LALREAL8SequenceInterp *);
 REAL8 XLALREAL8SequenceInterpEval(LALREAL8SequenceInterp *, double, int);
+int XLALREAL8SequenceInterpEvalBatch(LALREAL8SequenceInterp *, REAL8Sequence *, const REAL8Sequence *, int);
 
 
 /**
@@ -54,6 +55,7 @@ typedef struct tagLALREAL8TimeSeriesInterp LALREAL8TimeSeriesInterp;
 LALREAL8TimeSeriesInterp *XLALREAL8TimeSeriesInterpCreate(const REAL8TimeSeries *, int, void (*)(double *, int, double, void *), void *);
 void XLALREAL8TimeSeriesInterpDestroy(LALREAL8TimeSeriesInterp *);
 REAL8 XLALREAL8TimeSeriesInterpEval(LALREAL8TimeSeriesInterp *, const LIGOTimeGPS *, int);
+int XLALREAL8TimeSeriesInterpEvalBatch(LALREAL8TimeSeriesInterp *, REAL8Sequence *, const LIGOTimeGPS *, const REAL8Sequence *, int);
 
 
 #if 0
@@ -19,6 +19,10 @@
 
 #include <lal/LALHashTbl.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 /* Special hash table element value to indicate elements that have been deleted */
 static const void *hash_del = 0;
 #define DEL   ((void*) &hash_del)
@@ -32,6 +36,49 @@ static const void *hash_del = 0;
 /* Evaluates true if the elements x and y are equal, according to the hash table comparison function */
 #define EQUAL(ht, x, y)   ((ht)->cmp((ht)->cmp_param, (x), (y)) == 0)
 
+/* Number of locks used by a concurrent hash table; must be a power of 2 */
+#define CONC_NLOCKS 64
+
+/* Minimum size of a concurrent hash table; large enough that concurrent additions cannot fill it */
+#define CONC_MIN_LEN (8 * CONC_NLOCKS)
+
+/* Atomic access to the elements and counters of a concurrent hash table */
+#define LOAD(x)       __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE(x, v)   __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define CAS(x, o, v)  __atomic_compare_exchange_n(&(x), &(o), (v), 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)
+#define INCR(x)       __atomic_add_fetch(&(x), 1, __ATOMIC_RELAXED)
+#define DECR(x)       __atomic_sub_fetch(&(x), 1, __ATOMIC_RELAXED)
+
+/* Sequentially-consistent access to the table of elements and count of readers of a concurrent hash table */
+#define LOAD_SC(x)    __atomic_load_n(&(x), __ATOMIC_SEQ_CST)
+#define STORE_SC(x, v) __atomic_store_n(&(x), (v), __ATOMIC_SEQ_CST)
+#define INCR_SC(x)    __atomic_add_fetch(&(x), 1, __ATOMIC_SEQ_CST)
+#define DECR_SC(x)    __atomic_sub_fetch(&(x), 1, __ATOMIC_SEQ_CST)
+
+/* Index of the lock which must be held to access the lists of retired tables and elements of a concurrent hash table */
+#define CONC_RETIRED_LOCK CONC_NLOCKS
+
+#ifdef LAL_PTHREAD_LOCK
+#define LOCK(ht, k)   pthread_mutex_lock(&(ht)->conc_locks[k])
+#define UNLOCK(ht, k) pthread_mutex_unlock(&(ht)->conc_locks[k])
+#else
+#define LOCK(ht, k)
+#define UNLOCK(ht, k)
+#endif
+
+/* Table of elements of a concurrent hash table */
+typedef struct tagConcHashTblData {
+  struct tagConcHashTblData *retired;   /* Next table in the list of retired tables */
+  int len;                              /* Length of 'data'; a power of 2 */
+  void *data[];                         /* Hash table with open addressing and linear probing */
+} ConcHashTblData;
+
+/* Element removed from a concurrent hash table, which is freed once no reader can be comparing against it */
+typedef struct tagConcHashTblElem {
+  struct tagConcHashTblElem *retired;   /* Next element in the list of retired elements */
+  void *x;                              /* Removed element */
+} ConcHashTblElem;
+
 struct tagLALHashTbl {
   void **data;                  /* Hash table with open addressing and linear probing */
   int data_len;                 /* Size of the memory block 'data', in number of elements */
@@ -42,6 +89,13 @@ struct tagLALHashTbl {
   void *hash_param;             /* Parameter to pass to hash function */
   LALHashTblCmpParamFcn cmp;    /* Parameterised hash table element comparison function */
   void *cmp_param;              /* Parameter to pass to comparison function */
+  ConcHashTblData *conc;        /* Elements of a concurrent hash table, or NULL */
+  ConcHashTblData *conc_retired; /* Previous tables of a concurrent hash table, which may still be in use by readers */
+  ConcHashTblElem *conc_retired_elem; /* Elements removed from a concurrent hash table, which may still be in use by readers */
+  int conc_readers;             /* Number of calls to XLALHashTblFind() in progress on a concurrent hash table */
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_t *conc_locks;  /* Locks for adding/removing elements of a concurrent hash table, and for its lists of retired tables/elements */
+#endif
 };
 
 /* Call a non-parameterised hash function, which is passed in 'param' */
@@ -58,13 +112,13 @@ static int hashtbl_no_param_cmp( void *param, const void *x, const void *y )
   return cmp( x, y );
 }
 
-/* Resize and rebuild the hash table */
-static int hashtbl_resize( LALHashTbl *ht )
+/* Resize and rebuild the hash table, with room for 'n' elements */
+static int hashtbl_resize( LALHashTbl *ht, int n )
 {
   void **old_data = ht->data;
   int old_data_len = ht->data_len;
   ht->data_len = 2;
-  while ( ht->data_len < 3*ht->n ) {
+  while ( ht->data_len < 3*n ) {
     ht->data_len *= 2;
   }
   ht->data = XLALCalloc( ht->data_len, sizeof( ht->data[0] ) );
@@ -83,6 +137,153 @@ static int hashtbl_resize( LALHashTbl *ht )
   return XLAL_SUCCESS;
 }
 
+/* Allocate a table of elements for a concurrent hash table, with room for 'n' elements */
+static ConcHashTblData *conc_alloc( int n )
+{
+  int len = CONC_MIN_LEN;
+  while ( len < 4*n ) {
+    len *= 2;
+  }
+  ConcHashTblData *cd = XLALCalloc( 1, sizeof( *cd ) + len * sizeof( cd->data[0] ) );
+  XLAL_CHECK_NULL( cd != NULL, XLAL_ENOMEM );
+  cd->len = len;
+  return cd;
+}
+
+/* Free a table of elements of a concurrent hash table, and all tables following it in a list of retired tables */
+static void conc_free( ConcHashTblData *cd )
+{
+  while ( cd != NULL ) {
+    ConcHashTblData *retired = cd->retired;
+    XLALFree( cd );
+    cd = retired;
+  }
+}
+
+/* Free elements in a list of retired elements of a concurrent hash table */
+static void conc_free_elem( LALHashTblDtorFcn dtor, ConcHashTblElem *ce )
+{
+  while ( ce != NULL ) {
+    ConcHashTblElem *retired = ce->retired;
+    if ( dtor != NULL ) {
+      dtor( ce->x );
+    }
+    XLALFree( ce );
+    ce = retired;
+  }
+}
+
+/* Index of the lock which must be held to add or remove an element with hash value 'hval' */
+static int conc_lock_idx( UINT8 hval )
+{
+  return ( int )( hval & ( CONC_NLOCKS - 1 ) );
+}
+
+/* Acquire/release all locks of a concurrent hash table, giving exclusive write access */
+static void conc_lock_all( LALHashTbl *ht )
+{
+  for ( int k = 0; k < CONC_NLOCKS; ++k ) {
+    LOCK( ht, k );
+  }
+}
+static void conc_unlock_all( LALHashTbl *ht )
+{
+  for ( int k = CONC_NLOCKS - 1; k >= 0; --k ) {
+    UNLOCK( ht, k );
+  }
+}
+
+/*
+ * Free retired tables and elements of a concurrent hash table, if no reader is using them. Tables
+ * and elements are retired by conc_rebuild() and XLALHashTblRemove() before they are added to the
+ * lists; a reader which loaded a retired table or element incremented 'conc_readers' beforehand,
+ * and so no reader can be using anything in the lists if 'conc_readers' is zero after they are taken.
+ */
+static void conc_reclaim( LALHashTbl *ht )
+{
+  ConcHashTblData *retired = NULL;
+  ConcHashTblElem *retired_elem = NULL;
+  LOCK( ht, CONC_RETIRED_LOCK );
+  if ( ( ht->conc_retired != NULL || ht->conc_retired_elem != NULL ) && LOAD_SC( ht->conc_readers ) == 0 ) {
+    retired = ht->conc_retired;
+    STORE( ht->conc_retired, NULL );
+    retired_elem = ht->conc_retired_elem;
+    STORE( ht->conc_retired_elem, NULL );
+  }
+  UNLOCK( ht, CONC_RETIRED_LOCK );
+  conc_free( retired );
+  conc_free_elem( ht->dtor, retired_elem );
+}
+
+/* Find element matching 'x' in a table of elements of a concurrent hash table; does not lock */
+static const void *conc_find( const LALHashTbl *ht, const ConcHashTblData *cd, UINT8 hval, const void *x, int *idx )
+{
+  const int mask = cd->len - 1;
+  for ( int i = ( int )( hval & mask ); ; i = ( i + 1 ) & mask ) {
+    const void *y = LOAD( cd->data[i] );
+    if ( y == NULL ) {
+      return NULL;
+    }
+    if ( y != DEL && EQUAL( ht, x, y ) ) {
+      if ( idx != NULL ) {
+        *idx = i;
+      }
+      return y;
+    }
+  }
+}
+
+/* Put 'x' in a free slot of a table of elements of a concurrent hash table; caller must hold the lock for 'x' */
+static void conc_insert( LALHashTbl *ht, ConcHashTblData *cd, UINT8 hval, void *x )
+{
+  const int mask = cd->len - 1;
+  int i = ( int )( hval & mask );
+  while ( 1 ) {
+    void *y = LOAD( cd->data[i] );
+    if ( y == NULL || y == DEL ) {
+      /* Other threads may be filling free slots with elements of a different lock */
+      if ( CAS( cd->data[i], y, x ) ) {
+        if ( y == NULL ) {
+          INCR( ht->q );
+        }
+        INCR( ht->n );
+        return;
+      }
+    } else {
+      i = ( i + 1 ) & mask;
+    }
+  }
+}
+
+/* Rebuild a concurrent hash table with room for 'n' more elements; caller must hold all locks */
+static int conc_rebuild( LALHashTbl *ht, int n )
+{
+  ConcHashTblData *old = ht->conc;
+  ConcHashTblData *cd = conc_alloc( ht->n + n );
+  XLAL_CHECK( cd != NULL, XLAL_EFUNC );
+  const int mask = cd->len - 1;
+  for ( int k = 0; k < old->len; ++k ) {
+    if ( old->data[k] != NULL && old->data[k] != DEL ) {
+      int i = ( int )( ht->hash( ht->hash_param, old->data[k] ) & mask );
+      while ( cd->data[i] != NULL ) {
+        i = ( i + 1 ) & mask;
+      }
+      cd->data[i] = old->data[k];
+    }
+  }
+  ht->q = ht->n;
+
+  /* Readers may still be using the old table, so retire it until no reader is in progress */
+  STORE_SC( ht->conc, cd );
+  LOCK( ht, CONC_RETIRED_LOCK );
+  old->retired = ht->conc_retired;
+  STORE( ht->conc_retired, old );
+  UNLOCK( ht, CONC_RETIRED_LOCK );
+  conc_reclaim( ht );
+
+  return XLAL_SUCCESS;
+}
+
 LALHashTbl *XLALHashTblCreate(
   LALHashTblDtorFcn dtor,
   LALHashTblHashFcn hash,
@@ -126,6 +327,55 @@ LALHashTbl *XLALHashTblCreate2(
 
 }
 
+LALHashTbl *XLALHashTblCreateConcurrent(
+  LALHashTblDtorFcn dtor,
+  LALHashTblHashFcn hash,
+  LALHashTblCmpFcn cmp
+  )
+{
+
+  /* Create a hash table using hashtbl_no_param_hash/cmp as the hash/comparison functions */
+  LALHashTbl *ht = XLALHashTblCreateConcurrent2( dtor, hashtbl_no_param_hash, hash, hashtbl_no_param_cmp, cmp );
+  XLAL_CHECK_NULL( ht != NULL, XLAL_EFUNC );
+
+  return ht;
+
+}
+
+LALHashTbl *XLALHashTblCreateConcurrent2(
+  LALHashTblDtorFcn dtor,
+  LALHashTblHashParamFcn hash,
+  void *hash_param,
+  LALHashTblCmpParamFcn cmp,
+  void *cmp_param
+  )
+{
+
+  /* Create a hash table */
+  LALHashTbl *ht = XLALHashTblCreate2( dtor, hash, hash_param, cmp, cmp_param );
+  XLAL_CHECK_NULL( ht != NULL, XLAL_EFUNC );
+
+  /* Allocate concurrent table of elements and locks */
+  ht->conc = conc_alloc( 0 );
+  if ( ht->conc == NULL ) {
+    XLALHashTblDestroy( ht );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+#ifdef LAL_PTHREAD_LOCK
+  ht->conc_locks = XLALCalloc( CONC_NLOCKS + 1, sizeof( ht->conc_locks[0] ) );
+  if ( ht->conc_locks == NULL ) {
+    XLALHashTblDestroy( ht );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  for ( int k = 0; k < CONC_NLOCKS + 1; ++k ) {
+    pthread_mutex_init( &ht->conc_locks[k], NULL );
+  }
+#endif
+
+  return ht;
+
+}
+
 void XLALHashTblDestroy(
   LALHashTbl *ht
   )
@@ -141,6 +391,26 @@ void XLALHashTblDestroy(
       }
       XLALFree( ht->data );
     }
+    if ( ht->conc != NULL ) {
+      if ( ht->dtor != NULL ) {
+        for ( int i = 0; i < ht->conc->len; ++i ) {
+          if ( ht->conc->data[i] != NULL && ht->conc->data[i] != DEL ) {
+            ht->dtor( ht->conc->data[i] );
+          }
+        }
+      }
+      conc_free( ht->conc );
+      conc_free( ht->conc_retired );
+      conc_free_elem( ht->dtor, ht->conc_retired_elem );
+    }
+#ifdef LAL_PTHREAD_LOCK
+    if ( ht->conc_locks != NULL ) {
+      for ( int k = 0; k < CONC_NLOCKS + 1; ++k ) {
+        pthread_mutex_destroy( &ht->conc_locks[k] );
+      }
+      XLALFree( ht->conc_locks );
+    }
+#endif
     XLALFree( ht );
   }
 }
@@ -167,6 +437,21 @@ int XLALHashTblClear(
     }
   }
 
+  /* Free concurrent hash table elements, and retired tables since they are no longer in use */
+  if ( ht->conc != NULL ) {
+    for ( int i = 0; i < ht->conc->len; ++i ) {
+      if ( ht->conc->data[i] != NULL && ht->conc->data[i] != DEL && ht->dtor != NULL ) {
+        ht->dtor( ht->conc->data[i] );
+      }
+      ht->conc->data[i] = NULL;
+    }
+    conc_free( ht->conc_retired );
+    ht->conc_retired = NULL;
+    conc_free_elem( ht->dtor, ht->conc_retired_elem );
+    ht->conc_retired_elem = NULL;
+    ht->q = 0;
+  }
+
   /* Remove all elements from hash table */
   ht->n = 0;
 
@@ -179,7 +464,7 @@ int XLALHashTblSize(
   )
 {
   XLAL_CHECK( ht != NULL, XLAL_EFAULT );
-  return ht->n;
+  return LOAD( ht->n );
 }
 
 int XLALHashTblFind(
@@ -194,6 +479,18 @@ int XLALHashTblFind(
   XLAL_CHECK( x != NULL && x != DEL, XLAL_EINVAL );
   XLAL_CHECK( y != NULL, XLAL_EFAULT );
 
+  /* Concurrent hash table: find element without locking, counting this call as a reader of the table */
+  if ( LOAD( ht->conc ) != NULL ) {
+    LALHashTbl *ht_readers = ( LALHashTbl * ) ht;
+    INCR_SC( ht_readers->conc_readers );
+    const ConcHashTblData *cd = LOAD_SC( ht->conc );
+    *y = conc_find( ht, cd, ht->hash( ht->hash_param, x ), x, NULL );
+    if ( DECR_SC( ht_readers->conc_readers ) == 0 && ( LOAD_SC( ht->conc_retired ) != NULL || LOAD_SC( ht->conc_retired_elem ) != NULL ) ) {
+      conc_reclaim( ht_readers );
+    }
+    return XLAL_SUCCESS;
+  }
+
   /* Try to find element matching 'x' in hash table, if found return in 'y' */
   if ( ht->data_len > 0 ) {
     int i = HASHIDX( ht, x );
@@ -222,6 +519,37 @@ int XLALHashTblAdd(
   XLAL_CHECK( ht != NULL, XLAL_EFAULT );
   XLAL_CHECK( x != NULL && x != DEL, XLAL_EINVAL );
 
+  /* Concurrent hash table: add element while holding its lock */
+  if ( LOAD( ht->conc ) != NULL ) {
+    const UINT8 hval = ht->hash( ht->hash_param, x );
+    const int k = conc_lock_idx( hval );
+    while ( 1 ) {
+      LOCK( ht, k );
+      ConcHashTblData *cd = ht->conc;
+
+      /* Resize hash table to preserve maximum 50% occupancy */
+      if ( 2*( LOAD( ht->q ) + 1 ) > cd->len ) {
+        UNLOCK( ht, k );
+        conc_lock_all( ht );
+        int errnum = ( ht->conc == cd ) ? conc_rebuild( ht, 1 ) : XLAL_SUCCESS;
+        conc_unlock_all( ht );
+        XLAL_CHECK( errnum == XLAL_SUCCESS, XLAL_EFUNC );
+        continue;
+      }
+
+      /* Check that no element matching 'x' exists in the hash table */
+      if ( conc_find( ht, cd, hval, x, NULL ) != NULL ) {
+        UNLOCK( ht, k );
+        XLAL_ERROR( XLAL_EFAILED, "Hash table already contains given element" );
+      }
+
+      /* Add 'x' to the hash table */
+      conc_insert( ht, cd, hval, x );
+      UNLOCK( ht, k );
+      return XLAL_SUCCESS;
+    }
+  }
+
   /* Check that no element matching 'x' exists in the hash table */
   {
     const void *y;
@@ -231,7 +559,7 @@ int XLALHashTblAdd(
 
   /* Resize hash table to preserve maximum 50% occupancy */
   if ( 2*( ht->q + 1 ) > ht->data_len ) {
-    XLAL_CHECK( hashtbl_resize( ht ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( hashtbl_resize( ht, ht->n ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
   /* Add 'x' to the hash table */
@@ -249,6 +577,79 @@ int XLALHashTblAdd(
 
 }
 
+int XLALHashTblAddSorted(
+  LALHashTbl *ht,
+  void **x,
+  int n
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( ht != NULL, XLAL_EFAULT );
+  XLAL_CHECK( n >= 0, XLAL_EINVAL );
+  XLAL_CHECK( n == 0 || x != NULL, XLAL_EFAULT );
+  for ( int j = 0; j < n; ++j ) {
+    XLAL_CHECK( x[j] != NULL && x[j] != DEL, XLAL_EINVAL );
+  }
+
+  /* Since elements are sorted, any duplicate elements are adjacent */
+  for ( int j = 1; j < n; ++j ) {
+    XLAL_CHECK( ht->cmp( ht->cmp_param, x[j-1], x[j] ) < 0, XLAL_EINVAL, "Elements are not sorted, or contain duplicates" );
+  }
+
+  /* Concurrent hash table: add elements while holding all locks */
+  if ( ht->conc != NULL ) {
+    int errnum = XLAL_SUCCESS;
+    conc_lock_all( ht );
+    for ( int j = 0; j < n && ht->n > 0; ++j ) {
+      if ( conc_find( ht, ht->conc, ht->hash( ht->hash_param, x[j] ), x[j], NULL ) != NULL ) {
+        errnum = XLAL_EFAILED;
+        break;
+      }
+    }
+    if ( errnum == XLAL_SUCCESS && 2*( ht->q + n ) > ht->conc->len ) {
+      errnum = conc_rebuild( ht, n );
+    }
+    if ( errnum == XLAL_SUCCESS ) {
+      for ( int j = 0; j < n; ++j ) {
+        conc_insert( ht, ht->conc, ht->hash( ht->hash_param, x[j] ), x[j] );
+      }
+    }
+    conc_unlock_all( ht );
+    XLAL_CHECK( errnum != XLAL_EFAILED, XLAL_EFAILED, "Hash table already contains given element" );
+    XLAL_CHECK( errnum == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+  }
+
+  /* Check that no elements already exist in the hash table */
+  for ( int j = 0; j < n && ht->n > 0; ++j ) {
+    const void *y;
+    XLAL_CHECK( XLALHashTblFind( ht, x[j], &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( y == NULL, XLAL_EFAILED, "Hash table already contains given element" );
+  }
+
+  /* Resize hash table once to hold all elements */
+  if ( 2*( ht->q + n ) > ht->data_len ) {
+    XLAL_CHECK( hashtbl_resize( ht, ht->n + n ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  /* Add elements to the hash table */
+  for ( int j = 0; j < n; ++j ) {
+    int i = HASHIDX( ht, x[j] );
+    while ( ht->data[i] != NULL && ht->data[i] != DEL ) {
+      INCRIDX( ht, i );
+    }
+    if ( ht->data[i] == NULL ) {
+      ++ht->q;
+    }
+    ++ht->n;
+    ht->data[i] = x[j];
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 int XLALHashTblExtract(
   LALHashTbl *ht,
   const void *x,
@@ -261,6 +662,22 @@ int XLALHashTblExtract(
   XLAL_CHECK( x != NULL && x != DEL, XLAL_EINVAL );
   XLAL_CHECK( y != NULL, XLAL_EFAULT );
 
+  /* Concurrent hash table: remove element while holding its lock */
+  if ( LOAD( ht->conc ) != NULL ) {
+    const UINT8 hval = ht->hash( ht->hash_param, x );
+    const int k = conc_lock_idx( hval );
+    LOCK( ht, k );
+    ConcHashTblData *cd = ht->conc;
+    int i = 0;
+    *y = ( void * ) conc_find( ht, cd, hval, x, &i );
+    if ( *y != NULL ) {
+      STORE_SC( cd->data[i], DEL );
+      DECR( ht->n );
+    }
+    UNLOCK( ht, k );
+    return XLAL_SUCCESS;
+  }
+
   /* Try to find element matching 'x' in hash table, if found remove it from table and return in 'y' */
   if ( ht->data_len > 0 ) {
     int i = HASHIDX( ht, x );
@@ -270,7 +687,7 @@ int XLALHashTblExtract(
         ht->data[i] = DEL;
         --ht->n;
         if ( 8*ht->n < ht->data_len ) { /* Resize hash table to preserve minimum 50% occupancy */
-          XLAL_CHECK( hashtbl_resize( ht ) == XLAL_SUCCESS, XLAL_EFUNC );
+          XLAL_CHECK( hashtbl_resize( ht, ht->n ) == XLAL_SUCCESS, XLAL_EFUNC );
         }
         return XLAL_SUCCESS;
       }
@@ -294,6 +711,24 @@ int XLALHashTblRemove(
   XLAL_CHECK( ht != NULL, XLAL_EFAULT );
   XLAL_CHECK( x != NULL && x != DEL, XLAL_EINVAL );
 
+  /* Concurrent hash table: remove element, and retire it until no reader can be comparing against it */
+  if ( LOAD( ht->conc ) != NULL && ht->dtor != NULL ) {
+    ConcHashTblElem *ce = XLALMalloc( sizeof( *ce ) );
+    XLAL_CHECK( ce != NULL, XLAL_ENOMEM );
+    const int errnum = XLALHashTblExtract( ht, x, &ce->x );
+    if ( errnum != XLAL_SUCCESS || ce->x == NULL ) {
+      XLALFree( ce );
+      XLAL_CHECK( errnum == XLAL_SUCCESS, XLAL_EFUNC );
+      return XLAL_SUCCESS;
+    }
+    LOCK( ht, CONC_RETIRED_LOCK );
+    ce->retired = ht->conc_retired_elem;
+    STORE_SC( ht->conc_retired_elem, ce );
+    UNLOCK( ht, CONC_RETIRED_LOCK );
+    conc_reclaim( ht );
+    return XLAL_SUCCESS;
+  }
+
   /* Remove element matching 'x' from hash table, if it exists */
   void *y;
   XLAL_CHECK( XLALHashTblExtract( ht, x, &y ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -32,6 +32,24 @@ extern "C" {
  * \ingroup lal_utilities
  * \author Karl Wette
  * \brief Implementation of a generic hash table, following Chapter 5.2 of \cite open-data-structs .
+ *
+ * A hash table created with XLALHashTblCreateConcurrent() or XLALHashTblCreateConcurrent2() may be
+ * shared between threads without external locking. XLALHashTblFind() does not lock, and may be
+ * called concurrently with XLALHashTblAdd(), XLALHashTblAddSorted(), and XLALHashTblExtract(),
+ * which lock only a fraction of the hash table, except when it must grow. It is intended for
+ * tables which are read much more often than they are modified:
+ * - Elements removed by XLALHashTblExtract() may still be in use by concurrent readers.
+ *   XLALHashTblRemove() frees a removed element only once no call to XLALHashTblFind() which may
+ *   be comparing against it is in progress, but must not be used while another thread still holds
+ *   the element returned by XLALHashTblFind().
+ * - Memory of the hash table is not shrunk when elements are removed. Removed elements leave
+ *   markers which are purged when the hash table is rebuilt, which also happens without growing it
+ *   when elements are repeatedly added and removed. The previous table of elements is kept while
+ *   calls to XLALHashTblFind() are in progress, and released once no call is in progress during a
+ *   later rebuild or XLALHashTblFind() call; a table which is read continuously by overlapping calls
+ *   from several threads may therefore keep previous tables until XLALHashTblClear() or
+ *   XLALHashTblDestroy().
+ * - XLALHashTblClear() and XLALHashTblDestroy() must not be called concurrently with other functions.
  */
 /** @{ */
 
@@ -85,6 +103,26 @@ LALHashTbl *XLALHashTblCreate2(
   void *cmp_param               /**< [in] Parameter to pass to comparison function */
   );
 
+/**
+ * Create a hash table which may be shared between threads
+ */
+LALHashTbl *XLALHashTblCreateConcurrent(
+  LALHashTblDtorFcn dtor,       /**< [in] Function to free memory of elements of hash, if required */
+  LALHashTblHashFcn hash,       /**< [in] Hash function for hash table elements */
+  LALHashTblCmpFcn cmp          /**< [in] Hash table element comparison function */
+  );
+
+/**
+ * Create a hash table which may be shared between threads, with parameterised hash and comparison functions
+ */
+LALHashTbl *XLALHashTblCreateConcurrent2(
+  LALHashTblDtorFcn dtor,       /**< [in] Function to free memory of elements of hash, if required */
+  LALHashTblHashParamFcn hash,  /**< [in] Parameterised hash function for hash table elements */
+  void *hash_param,             /**< [in] Parameter to pass to hash function */
+  LALHashTblCmpParamFcn cmp,    /**< [in] Parameterised hash table element comparison function */
+  void *cmp_param               /**< [in] Parameter to pass to comparison function */
+  );
+
 /**
  * Destroy a hash table and its elements
  */
@@ -123,6 +161,16 @@ int XLALHashTblAdd(
   void *x                       /**< [in] Hash element to add */
   );
 
+/**
+ * Add an array of elements, sorted in strictly ascending order according to the hash table
+ * comparison function, to a hash table. The hash table is resized at most once.
+ */
+int XLALHashTblAddSorted(
+  LALHashTbl *ht,               /**< [in] Pointer to hash table */
+  void **x,                     /**< [in] Sorted array of hash elements to add */
+  int n                         /**< [in] Number of hash elements to add */
+  );
+
 /**
  * Find the element matching <tt>x</tt> in a hash table; if found, remove it and return in <tt>*y</tt>
  */
@@ -1499,3 +1499,333 @@ void LALSRunningMedian2( LALStatus *status,
   DETATCHSTATUSPTR( status );
   RETURN( status );
 }
+
+
+/*
+ * Running median using two indexable heaps: the lower half of the block
+ * is kept in a max-heap and the upper half in a min-heap, so that the
+ * median is found at the top(s) of the heaps.  Each step replaces the
+ * oldest element of the block with the newest in place, and restores the
+ * heap properties in O(log blocksize) operations.
+ */
+
+/* workspace of the heap-based running median */
+typedef struct tagRngMedHeaps {
+  UINT4 blocksize;      /* number of elements in the block */
+  UINT4 nlo;            /* number of elements in the lower (max-)heap */
+  UINT4 nhi;            /* number of elements in the upper (min-)heap */
+  UINT4 oldest;         /* slot of the oldest element in the block */
+  REAL8 *value;         /* values of the block, indexed by slot */
+  UINT4 *lo;            /* lower heap of slots */
+  UINT4 *hi;            /* upper heap of slots */
+  UINT4 *pos;           /* position of each slot in its heap */
+  BOOLEAN *inlo;        /* whether each slot is in the lower heap */
+  struct rngmed_val_index8 *sorted; /* scratch space for building the heaps */
+} RngMedHeaps;
+
+static void rngmed_heaps_destroy( RngMedHeaps *h )
+{
+  if ( h ) {
+    XLALFree( h->value );
+    XLALFree( h->lo );
+    XLALFree( h->hi );
+    XLALFree( h->pos );
+    XLALFree( h->inlo );
+    XLALFree( h->sorted );
+    XLALFree( h );
+  }
+}
+
+static RngMedHeaps *rngmed_heaps_create( UINT4 blocksize )
+{
+  RngMedHeaps *h = XLALCalloc( 1, sizeof( *h ) );
+  if ( ! h )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  h->blocksize = blocksize;
+  h->nlo = ( blocksize + 1 ) / 2;
+  h->nhi = blocksize / 2;
+  h->value = XLALMalloc( blocksize * sizeof( *h->value ) );
+  h->lo = XLALMalloc( h->nlo * sizeof( *h->lo ) );
+  h->hi = XLALMalloc( ( h->nhi > 0 ? h->nhi : 1 ) * sizeof( *h->hi ) );
+  h->pos = XLALMalloc( blocksize * sizeof( *h->pos ) );
+  h->inlo = XLALMalloc( blocksize * sizeof( *h->inlo ) );
+  h->sorted = XLALMalloc( blocksize * sizeof( *h->sorted ) );
+  if ( ! h->value || ! h->lo || ! h->hi || ! h->pos || ! h->inlo || ! h->sorted ) {
+    rngmed_heaps_destroy( h );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  return h;
+}
+
+/* compare two slots by value, breaking ties by slot for a strict order */
+static int rngmed_heaps_less( const RngMedHeaps *h, UINT4 a, UINT4 b )
+{
+  return h->value[a] < h->value[b] || ( h->value[a] == h->value[b] && a < b );
+}
+
+/* place a slot at a given position of a heap */
+#define RNGMED_HEAP_PUT( heap, i, slot ) do { heap[i] = slot; h->pos[slot] = i; } while (0)
+
+/* restore the lower max-heap after the value at position i has changed */
+static void rngmed_heaps_sift_lo( RngMedHeaps *h, UINT4 i )
+{
+  UINT4 slot = h->lo[i];
+  /* sift up */
+  while ( i > 0 ) {
+    UINT4 p = ( i - 1 ) / 2;
+    if ( ! rngmed_heaps_less( h, h->lo[p], slot ) )
+      break;
+    RNGMED_HEAP_PUT( h->lo, i, h->lo[p] );
+    i = p;
+  }
+  /* sift down */
+  for (;;) {
+    UINT4 c = 2 * i + 1;
+    if ( c >= h->nlo )
+      break;
+    if ( c + 1 < h->nlo && rngmed_heaps_less( h, h->lo[c], h->lo[c + 1] ) )
+      ++c;
+    if ( ! rngmed_heaps_less( h, slot, h->lo[c] ) )
+      break;
+    RNGMED_HEAP_PUT( h->lo, i, h->lo[c] );
+    i = c;
+  }
+  RNGMED_HEAP_PUT( h->lo, i, slot );
+}
+
+/* restore the upper min-heap after the value at position i has changed */
+static void rngmed_heaps_sift_hi( RngMedHeaps *h, UINT4 i )
+{
+  UINT4 slot = h->hi[i];
+  /* sift up */
+  while ( i > 0 ) {
+    UINT4 p = ( i - 1 ) / 2;
+    if ( ! rngmed_heaps_less( h, slot, h->hi[p] ) )
+      break;
+    RNGMED_HEAP_PUT( h->hi, i, h->hi[p] );
+    i = p;
+  }
+  /* sift down */
+  for (;;) {
+    UINT4 c = 2 * i + 1;
+    if ( c >= h->nhi )
+      break;
+    if ( c + 1 < h->nhi && rngmed_heaps_less( h, h->hi[c + 1], h->hi[c] ) )
+      ++c;
+    if ( ! rngmed_heaps_less( h, h->hi[c], slot ) )
+      break;
+    RNGMED_HEAP_PUT( h->hi, i, h->hi[c] );
+    i = c;
+  }
+  RNGMED_HEAP_PUT( h->hi, i, slot );
+}
+
+/* sort slots by value, breaking ties by slot, for building the heaps */
+static int rngmed_heaps_sortindex( const void *elem1, const void *elem2 )
+{
+  const struct rngmed_val_index8 *A = elem1;
+  const struct rngmed_val_index8 *B = elem2;
+  if ( A->data != B->data )
+    return ( A->data > B->data ) - ( A->data < B->data );
+  return ( A->index > B->index ) - ( A->index < B->index );
+}
+
+/* build the heaps from the values of the first block */
+static void rngmed_heaps_build( RngMedHeaps *h )
+{
+  UINT4 i;
+  for ( i = 0; i < h->blocksize; ++i ) {
+    h->sorted[i].data = h->value[i];
+    h->sorted[i].index = i;
+  }
+  qsort( h->sorted, h->blocksize, sizeof( *h->sorted ), rngmed_heaps_sortindex );
+  /* a descending array is a max-heap, and an ascending array a min-heap */
+  for ( i = 0; i < h->nlo; ++i ) {
+    const UINT4 slot = h->sorted[h->nlo - 1 - i].index;
+    h->lo[i] = slot;
+    h->pos[slot] = i;
+    h->inlo[slot] = 1;
+  }
+  for ( i = 0; i < h->nhi; ++i ) {
+    const UINT4 slot = h->sorted[h->nlo + i].index;
+    h->hi[i] = slot;
+    h->pos[slot] = i;
+    h->inlo[slot] = 0;
+  }
+  h->oldest = 0;
+}
+
+/* replace the oldest element of the block with a new value */
+static void rngmed_heaps_replace( RngMedHeaps *h, REAL8 x )
+{
+  const UINT4 slot = h->oldest;
+  h->value[slot] = x;
+  if ( ++h->oldest == h->blocksize )
+    h->oldest = 0;
+
+  /* restore the heap containing the replaced element */
+  if ( h->inlo[slot] )
+    rngmed_heaps_sift_lo( h, h->pos[slot] );
+  else
+    rngmed_heaps_sift_hi( h, h->pos[slot] );
+
+  /* at most one element is now on the wrong side: swap the heap tops */
+  if ( h->nhi > 0 && rngmed_heaps_less( h, h->hi[0], h->lo[0] ) ) {
+    const UINT4 a = h->lo[0];
+    const UINT4 b = h->hi[0];
+    h->lo[0] = b;
+    h->inlo[b] = 1;
+    h->hi[0] = a;
+    h->inlo[a] = 0;
+    rngmed_heaps_sift_lo( h, 0 );
+    rngmed_heaps_sift_hi( h, 0 );
+  }
+}
+
+/* median of the block */
+static REAL8 rngmed_heaps_median( const RngMedHeaps *h )
+{
+  if ( h->nlo > h->nhi )
+    return h->value[h->lo[0]];
+  return 0.5 * ( h->value[h->lo[0]] + h->value[h->hi[0]] );
+}
+
+#undef RNGMED_HEAP_PUT
+
+/* running median of an array using the heaps */
+#define DEFINE_RNGMED_HEAPS_RUN( TYPE ) \
+static void rngmed_heaps_run_ ## TYPE( RngMedHeaps *h, TYPE *medians, const TYPE *input, UINT4 length ) \
+{ \
+  UINT4 i; \
+  for ( i = 0; i < h->blocksize; ++i ) \
+    h->value[i] = input[i]; \
+  rngmed_heaps_build( h ); \
+  medians[0] = rngmed_heaps_median( h ); \
+  for ( i = h->blocksize; i < length; ++i ) { \
+    rngmed_heaps_replace( h, input[i] ); \
+    medians[i - h->blocksize + 1] = rngmed_heaps_median( h ); \
+  } \
+}
+DEFINE_RNGMED_HEAPS_RUN( REAL4 )
+DEFINE_RNGMED_HEAPS_RUN( REAL8 )
+#undef DEFINE_RNGMED_HEAPS_RUN
+
+/**
+ * Computes the running medians of a REAL4Sequence, using two indexable
+ * heaps which are updated in O(log blocksize) operations per median; see
+ * LALRunningMedian_h.  Any block size between 1 and the input length is
+ * allowed; for even block sizes the median is the mean of the two middle
+ * elements.
+ */
+int XLALSRunningMedian( REAL4Sequence *medians, const REAL4Sequence *input, UINT4 blocksize )
+{
+  RngMedHeaps *h;
+
+  XLAL_CHECK( medians != NULL && input != NULL, XLAL_EFAULT );
+  XLAL_CHECK( blocksize > 0, XLAL_EINVAL, "Block size must be positive" );
+  XLAL_CHECK( blocksize <= input->length, XLAL_EBADLEN, "Block size %u is larger than input length %u", blocksize, input->length );
+  XLAL_CHECK( medians->length == input->length - blocksize + 1, XLAL_EBADLEN, "Medians length %u must be %u", medians->length, input->length - blocksize + 1 );
+
+  h = rngmed_heaps_create( blocksize );
+  XLAL_CHECK( h != NULL, XLAL_EFUNC );
+  rngmed_heaps_run_REAL4( h, medians->data, input->data, input->length );
+  rngmed_heaps_destroy( h );
+
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Computes the running medians of each vector of a REAL4VectorSequence,
+ * e.g. the periodograms of all SFTs in a vector, as XLALSRunningMedian().
+ * The vectors are processed in parallel if OpenMP is enabled.
+ */
+int XLALSRunningMedianBatch( REAL4VectorSequence *medians, const REAL4VectorSequence *input, UINT4 blocksize )
+{
+  int failed = 0;
+
+  XLAL_CHECK( medians != NULL && input != NULL, XLAL_EFAULT );
+  XLAL_CHECK( blocksize > 0, XLAL_EINVAL, "Block size must be positive" );
+  XLAL_CHECK( blocksize <= input->vectorLength, XLAL_EBADLEN, "Block size %u is larger than input length %u", blocksize, input->vectorLength );
+  XLAL_CHECK( medians->length == input->length, XLAL_EBADLEN, "Number of median vectors %u must be %u", medians->length, input->length );
+  XLAL_CHECK( medians->vectorLength == input->vectorLength - blocksize + 1, XLAL_EBADLEN, "Medians length %u must be %u", medians->vectorLength, input->vectorLength - blocksize + 1 );
+
+  /* each thread uses its own workspace */
+#pragma omp parallel reduction(|:failed)
+  {
+    RngMedHeaps *h = rngmed_heaps_create( blocksize );
+    if ( h == NULL ) {
+      failed = 1;
+    }
+#pragma omp for schedule(dynamic)
+    for ( UINT4 n = 0; n < input->length; ++n ) {
+      if ( h != NULL ) {
+        rngmed_heaps_run_REAL4( h, medians->data + ( size_t ) n * medians->vectorLength,
+                                input->data + ( size_t ) n * input->vectorLength, input->vectorLength );
+      }
+    }
+    rngmed_heaps_destroy( h );
+  }
+  XLAL_CHECK( ! failed, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Computes the running medians of a REAL8Sequence, using two indexable
+ * heaps which are updated in O(log blocksize) operations per median; see
+ * LALRunningMedian_h.  Any block size between 1 and the input length is
+ * allowed; for even block sizes the median is the mean of the two middle
+ * elements.
+ */
+int XLALDRunningMedian( REAL8Sequence *medians, const REAL8Sequence *input, UINT4 blocksize )
+{
+  RngMedHeaps *h;
+
+  XLAL_CHECK( medians != NULL && input != NULL, XLAL_EFAULT );
+  XLAL_CHECK( blocksize > 0, XLAL_EINVAL, "Block size must be positive" );
+  XLAL_CHECK( blocksize <= input->length, XLAL_EBADLEN, "Block size %u is larger than input length %u", blocksize, input->length );
+  XLAL_CHECK( medians->length == input->length - blocksize + 1, XLAL_EBADLEN, "Medians length %u must be %u", medians->length, input->length - blocksize + 1 );
+
+  h = rngmed_heaps_create( blocksize );
+  XLAL_CHECK( h != NULL, XLAL_EFUNC );
+  rngmed_heaps_run_REAL8( h, medians->data, input->data, input->length );
+  rngmed_heaps_destroy( h );
+
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Computes the running medians of each vector of a REAL8VectorSequence,
+ * e.g. the periodograms of all SFTs in a vector, as XLALDRunningMedian().
+ * The vectors are processed in parallel if OpenMP is enabled.
+ */
+int XLALDRunningMedianBatch( REAL8VectorSequence *medians, const REAL8VectorSequence *input, UINT4 blocksize )
+{
+  int failed = 0;
+
+  XLAL_CHECK( medians != NULL && input != NULL, XLAL_EFAULT );
+  XLAL_CHECK( blocksize > 0, XLAL_EINVAL, "Block size must be positive" );
+  XLAL_CHECK( blocksize <= input->vectorLength, XLAL_EBADLEN, "Block size %u is larger than input length %u", blocksize, input->vectorLength );
+  XLAL_CHECK( medians->length == input->length, XLAL_EBADLEN, "Number of median vectors %u must be %u", medians->length, input->length );
+  XLAL_CHECK( medians->vectorLength == input->vectorLength - blocksize + 1, XLAL_EBADLEN, "Medians length %u must be %u", medians->vectorLength, input->vectorLength - blocksize + 1 );
+
+  /* each thread uses its own workspace */
+#pragma omp parallel reduction(|:failed)
+  {
+    RngMedHeaps *h = rngmed_heaps_create( blocksize );
+    if ( h == NULL ) {
+      failed = 1;
+    }
+#pragma omp for schedule(dynamic)
+    for ( UINT4 n = 0; n < input->length; ++n ) {
+      if ( h != NULL ) {
+        rngmed_heaps_run_REAL8( h, medians->data + ( size_t ) n * medians->vectorLength,
+                                input->data + ( size_t ) n * input->vectorLength, input->vectorLength );
+      }
+    }
+    rngmed_heaps_destroy( h );
+  }
+  XLAL_CHECK( ! failed, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+}
@@ -54,6 +54,15 @@ extern "C" {
  * <tt>LALDRunningMedian()</tt>, but has proven to be a
  * little faster and more stable. Check if it works for you.
  *
+ * The routines <tt>XLALDRunningMedian()</tt> and <tt>XLALSRunningMedian()</tt>
+ * compute the same medians with a different algorithm, which keeps the lower
+ * and upper halves of the block in two indexable heaps; each new median then
+ * costs O(log b) operations, compared to O(b) operations in the worst case for
+ * the algorithm below, which makes them considerably faster for large block
+ * sizes. <tt>XLALDRunningMedianBatch()</tt> and <tt>XLALSRunningMedianBatch()</tt>
+ * compute the running medians of every vector of a vector sequence, e.g. of
+ * the periodograms of many SFTs, in parallel if OpenMP is enabled.
+ *
  * ### Algorithm ###
  *
  * For a detailed description of the algorithm see the
@@ -137,6 +146,11 @@ LALSRunningMedian2( LALStatus *status,
 		    const REAL4Sequence *input,
 		    LALRunningMedianPar param);
 
+int XLALDRunningMedian( REAL8Sequence *medians, const REAL8Sequence *input, UINT4 blocksize );
+int XLALSRunningMedian( REAL4Sequence *medians, const REAL4Sequence *input, UINT4 blocksize );
+int XLALDRunningMedianBatch( REAL8VectorSequence *medians, const REAL8VectorSequence *input, UINT4 blocksize );
+int XLALSRunningMedianBatch( REAL4VectorSequence *medians, const REAL4VectorSequence *input, UINT4 blocksize );
+
 /** @} */
 
 #ifdef  __cplusplus
@@ -0,0 +1,543 @@
+/*
+ *  Copyright (C) 2026 Karl Wette
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <math.h>
+#include <string.h>
+#include <lal/LALToplist.h>
+#include <lal/LALHashFunc.h>
+#include <lal/VectorMath.h>
+
+#define ARITY       4                   /* Number of children of each heap node */
+#define CHILD(i)    (ARITY*(i) + 1)     /* First child of heap node 'i' */
+#define PARENT(i)   (((i) - 1)/ARITY)   /* Parent of heap node 'i' */
+
+/* Number of candidates filtered at once by XLALToplistAddMany() */
+#define FILTER_BLOCK 256
+
+/* Pointer to element in storage slot 's' of toplist 'tl' */
+#define ELEM(tl, s)   ((tl)->elems + (size_t)(s) * (tl)->elem_size)
+
+/* Evaluates true if heap node 'a' ranks below heap node 'b' */
+#define NODE_LESS(tl, a, b)   toplist_less((tl), (a).rank, ELEM((tl), (a).slot), (b).rank, ELEM((tl), (b).slot))
+
+/* Magic string and version of toplist checkpoint files */
+static const char toplist_magic[8] = "LALTOPL";
+#define TOPLIST_VERSION 1
+
+/* Heap node: rank of an element, and the storage slot holding it */
+typedef struct {
+  REAL4 rank;
+  INT4 slot;
+} toplist_node;
+
+/* Header of toplist checkpoint files */
+typedef struct {
+  char magic[8];
+  UINT4 version;
+  UINT4 elem_size;
+  INT4 max_size;
+  INT4 n;
+  UINT8 checksum;
+} toplist_header;
+
+struct tagLALToplist {
+  int max_size;                 /* Maximum number of elements in the toplist */
+  size_t elem_size;             /* Size of each element, in bytes */
+  int n;                        /* Number of elements in the toplist */
+  toplist_node *heap;           /* 4-ary min-heap of nodes, ordered by rank */
+  char *elems;                  /* Storage for 'max_size' elements */
+  LALToplistCmpFcn cmp;         /* Comparison function for elements of equal rank */
+  void *cmp_param;              /* Parameter to pass to comparison function */
+};
+
+struct tagLALToplistSet {
+  int num_threads;              /* Number of threads */
+  LALToplist **tls;             /* Toplist of each thread */
+};
+
+/* Return true if element 'xa' of rank 'ra' ranks below element 'xb' of rank 'rb' */
+static inline int toplist_less( const LALToplist *tl, REAL4 ra, const void *xa, REAL4 rb, const void *xb )
+{
+  if ( ra != rb ) {
+    return ra < rb;
+  }
+  int c = ( tl->cmp != NULL ) ? tl->cmp( tl->cmp_param, xa, xb ) : 0;
+  if ( c == 0 ) {
+    c = memcmp( xa, xb, tl->elem_size );
+  }
+  return c < 0;
+}
+
+/* Move node 'i' towards the root until the heap property is satisfied */
+static void toplist_sift_up( const LALToplist *tl, toplist_node *heap, int i )
+{
+  const toplist_node x = heap[i];
+  while ( i > 0 ) {
+    const int p = PARENT( i );
+    if ( !NODE_LESS( tl, x, heap[p] ) ) {
+      break;
+    }
+    heap[i] = heap[p];
+    i = p;
+  }
+  heap[i] = x;
+}
+
+/* Move node 'i' of a heap of 'n' nodes away from the root until the heap property is satisfied */
+static void toplist_sift_down( const LALToplist *tl, toplist_node *heap, int n, int i )
+{
+  const toplist_node x = heap[i];
+  while ( 1 ) {
+    const int c = CHILD( i );
+    if ( c >= n ) {
+      break;
+    }
+    const int cend = ( c + ARITY < n ) ? c + ARITY : n;
+    int m = c;
+    for ( int j = c + 1; j < cend; ++j ) {
+      if ( NODE_LESS( tl, heap[j], heap[m] ) ) {
+        m = j;
+      }
+    }
+    if ( !NODE_LESS( tl, heap[m], x ) ) {
+      break;
+    }
+    heap[i] = heap[m];
+    i = m;
+  }
+  heap[i] = x;
+}
+
+/* Add a copy of 'x' with rank 'rank' to the toplist; return 1 if added, 0 if not */
+static int toplist_add( LALToplist *tl, REAL4 rank, const void *x )
+{
+
+  /* Never add candidates with NaN ranks */
+  if ( isnan( rank ) ) {
+    return 0;
+  }
+
+  if ( tl->n < tl->max_size ) {
+
+    /* Copy element to next free storage slot, and add to end of heap */
+    const int i = tl->n++;
+    memcpy( ELEM( tl, i ), x, tl->elem_size );
+    tl->heap[i].rank = rank;
+    tl->heap[i].slot = i;
+    toplist_sift_up( tl, tl->heap, i );
+
+  } else {
+
+    /* Reject candidate unless it ranks above the root */
+    if ( !toplist_less( tl, tl->heap[0].rank, ELEM( tl, tl->heap[0].slot ), rank, x ) ) {
+      return 0;
+    }
+
+    /* Replace root with candidate, and sift down to restore heap property */
+    memcpy( ELEM( tl, tl->heap[0].slot ), x, tl->elem_size );
+    tl->heap[0].rank = rank;
+    toplist_sift_down( tl, tl->heap, tl->n, 0 );
+
+  }
+
+  return 1;
+
+}
+
+LALToplist *XLALToplistCreate(
+  int max_size,
+  size_t elem_size,
+  LALToplistCmpFcn cmp,
+  void *cmp_param
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK_NULL( max_size > 0, XLAL_EINVAL );
+  XLAL_CHECK_NULL( elem_size > 0, XLAL_EINVAL );
+
+  /* Allocate memory for toplist struct */
+  LALToplist *tl = XLALCalloc( 1, sizeof( *tl ) );
+  XLAL_CHECK_NULL( tl != NULL, XLAL_ENOMEM );
+
+  /* Set toplist struct parameters */
+  tl->max_size = max_size;
+  tl->elem_size = elem_size;
+  tl->cmp = cmp;
+  tl->cmp_param = cmp_param;
+
+  /* Allocate memory for heap and element storage */
+  tl->heap = XLALMalloc( max_size * sizeof( tl->heap[0] ) );
+  tl->elems = XLALMalloc( max_size * elem_size );
+  if ( tl->heap == NULL || tl->elems == NULL ) {
+    XLALToplistDestroy( tl );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+
+  return tl;
+
+}
+
+void XLALToplistDestroy(
+  LALToplist *tl
+  )
+{
+  if ( tl != NULL ) {
+    XLALFree( tl->heap );
+    XLALFree( tl->elems );
+    XLALFree( tl );
+  }
+}
+
+int XLALToplistClear(
+  LALToplist *tl
+  )
+{
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  tl->n = 0;
+  return XLAL_SUCCESS;
+}
+
+int XLALToplistSize(
+  const LALToplist *tl
+  )
+{
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  return tl->n;
+}
+
+int XLALToplistMaxSize(
+  const LALToplist *tl
+  )
+{
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  return tl->max_size;
+}
+
+REAL4 XLALToplistThreshold(
+  const LALToplist *tl
+  )
+{
+  XLAL_CHECK_REAL4( tl != NULL, XLAL_EFAULT );
+  return ( tl->n < tl->max_size ) ? -INFINITY : tl->heap[0].rank;
+}
+
+int XLALToplistAdd(
+  LALToplist *tl,
+  REAL4 rank,
+  const void *x
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  XLAL_CHECK( x != NULL, XLAL_EFAULT );
+
+  return toplist_add( tl, rank, x );
+
+}
+
+int XLALToplistAddMany(
+  LALToplist *tl,
+  const REAL4 *ranks,
+  const void *x,
+  int n
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  XLAL_CHECK( n >= 0, XLAL_EINVAL );
+  XLAL_CHECK( n == 0 || ranks != NULL, XLAL_EFAULT );
+  XLAL_CHECK( n == 0 || x != NULL, XLAL_EFAULT );
+  const char *xc = ( const char * ) x;
+
+  /* Add candidates one at a time until toplist is full */
+  int added = 0, i = 0;
+  for ( ; i < n && tl->n < tl->max_size; ++i ) {
+    added += toplist_add( tl, ranks[i], xc + ( size_t ) i * tl->elem_size );
+  }
+
+  /* Add remaining candidates in blocks, first finding those which rank at or above the current
+     threshold; since the threshold only increases, only candidates found can be added */
+  UINT4 idx[FILTER_BLOCK];
+  while ( i < n ) {
+    const UINT4 len = ( n - i < FILTER_BLOCK ) ? n - i : FILTER_BLOCK;
+    UINT4 count = 0;
+    XLAL_CHECK( XLALVectorFindScalarLessEqualREAL4( &count, idx, tl->heap[0].rank, ranks + i, len ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 k = 0; k < count; ++k ) {
+      const int j = i + idx[k];
+      added += toplist_add( tl, ranks[j], xc + ( size_t ) j * tl->elem_size );
+    }
+    i += len;
+  }
+
+  return added;
+
+}
+
+int XLALToplistFilter(
+  const LALToplist *tl,
+  UINT4 *count,
+  UINT4 *idx,
+  const REAL4 *ranks,
+  UINT4 n
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  XLAL_CHECK( count != NULL, XLAL_EFAULT );
+  XLAL_CHECK( n == 0 || idx != NULL, XLAL_EFAULT );
+  XLAL_CHECK( n == 0 || ranks != NULL, XLAL_EFAULT );
+
+  /* Find candidates which rank at or above the threshold */
+  *count = 0;
+  if ( n > 0 ) {
+    XLAL_CHECK( XLALVectorFindScalarLessEqualREAL4( count, idx, XLALToplistThreshold( tl ), ranks, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALToplistMerge(
+  LALToplist *tl,
+  const LALToplist *src
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  XLAL_CHECK( src != NULL, XLAL_EFAULT );
+  XLAL_CHECK( tl != src, XLAL_EINVAL );
+  XLAL_CHECK( tl->elem_size == src->elem_size, XLAL_EINVAL, "Toplists have different element sizes %zu and %zu", tl->elem_size, src->elem_size );
+
+  /* Add elements of 'src' */
+  for ( int i = 0; i < src->n; ++i ) {
+    toplist_add( tl, src->heap[i].rank, ELEM( src, src->heap[i].slot ) );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALToplistGetSorted(
+  const LALToplist *tl,
+  REAL4 *ranks,
+  void *x
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  if ( tl->n == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  /* Copy heap, then repeatedly remove its root, which is the element of smallest remaining rank */
+  toplist_node *heap = XLALMalloc( tl->n * sizeof( *heap ) );
+  XLAL_CHECK( heap != NULL, XLAL_ENOMEM );
+  memcpy( heap, tl->heap, tl->n * sizeof( *heap ) );
+  for ( int m = tl->n; m > 0; --m ) {
+    if ( ranks != NULL ) {
+      ranks[m - 1] = heap[0].rank;
+    }
+    if ( x != NULL ) {
+      memcpy( ( char * ) x + ( size_t )( m - 1 ) * tl->elem_size, ELEM( tl, heap[0].slot ), tl->elem_size );
+    }
+    heap[0] = heap[m - 1];
+    toplist_sift_down( tl, heap, m - 1, 0 );
+  }
+  XLALFree( heap );
+
+  return XLAL_SUCCESS;
+
+}
+
+/* Checksum of the ranks and elements written to a checkpoint file */
+static UINT8 toplist_checksum( const REAL4 *ranks, const char *elems, int n, size_t elem_size )
+{
+  return XLALCityHash64WithSeed( elems, n * elem_size, XLALCityHash64( ( const char * ) ranks, n * sizeof( ranks[0] ) ) );
+}
+
+int XLALToplistWrite(
+  LALFILE *fp,
+  const LALToplist *tl
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( fp != NULL, XLAL_EFAULT );
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+
+  /* Get ranks and elements in order of decreasing rank, so that equal toplists give identical checkpoints */
+  REAL4 *ranks = XLALMalloc( ( tl->n + 1 ) * sizeof( *ranks ) );
+  char *elems = XLALMalloc( ( tl->n + 1 ) * tl->elem_size );
+  XLAL_CHECK_FAIL( ranks != NULL && elems != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL( XLALToplistGetSorted( tl, ranks, elems ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Write header, ranks, and elements */
+  toplist_header hdr;
+  memset( &hdr, 0, sizeof( hdr ) );
+  memcpy( hdr.magic, toplist_magic, sizeof( hdr.magic ) );
+  hdr.version = TOPLIST_VERSION;
+  hdr.elem_size = tl->elem_size;
+  hdr.max_size = tl->max_size;
+  hdr.n = tl->n;
+  hdr.checksum = toplist_checksum( ranks, elems, tl->n, tl->elem_size );
+  XLAL_CHECK_FAIL( XLALFileWrite( &hdr, sizeof( hdr ), 1, fp ) == 1, XLAL_EIO, "Could not write toplist header" );
+  if ( tl->n > 0 ) {
+    XLAL_CHECK_FAIL( XLALFileWrite( ranks, sizeof( *ranks ), tl->n, fp ) == ( size_t ) tl->n, XLAL_EIO, "Could not write toplist ranks" );
+    XLAL_CHECK_FAIL( XLALFileWrite( elems, tl->elem_size, tl->n, fp ) == ( size_t ) tl->n, XLAL_EIO, "Could not write toplist elements" );
+  }
+
+  XLALFree( ranks );
+  XLALFree( elems );
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  XLALFree( ranks );
+  XLALFree( elems );
+  return XLAL_FAILURE;
+
+}
+
+int XLALToplistRead(
+  LALFILE *fp,
+  LALToplist *tl
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( fp != NULL, XLAL_EFAULT );
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+
+  /* Read and check header */
+  toplist_header hdr;
+  XLAL_CHECK( XLALFileRead( &hdr, sizeof( hdr ), 1, fp ) == 1, XLAL_EIO, "Could not read toplist header" );
+  XLAL_CHECK( memcmp( hdr.magic, toplist_magic, sizeof( hdr.magic ) ) == 0, XLAL_EIO, "File is not a toplist checkpoint" );
+  XLAL_CHECK( hdr.version == TOPLIST_VERSION, XLAL_EIO, "Toplist checkpoint has unknown version %u", hdr.version );
+  XLAL_CHECK( hdr.n >= 0 && hdr.n <= hdr.max_size, XLAL_EIO, "Toplist checkpoint is corrupt" );
+  XLAL_CHECK( hdr.elem_size == tl->elem_size, XLAL_EINVAL, "Toplist checkpoint has element size %u, expected %zu", hdr.elem_size, tl->elem_size );
+
+  /* Read and check ranks and elements */
+  REAL4 *ranks = XLALMalloc( ( hdr.n + 1 ) * sizeof( *ranks ) );
+  char *elems = XLALMalloc( ( hdr.n + 1 ) * tl->elem_size );
+  XLAL_CHECK_FAIL( ranks != NULL && elems != NULL, XLAL_ENOMEM );
+  if ( hdr.n > 0 ) {
+    XLAL_CHECK_FAIL( XLALFileRead( ranks, sizeof( *ranks ), hdr.n, fp ) == ( size_t ) hdr.n, XLAL_EIO, "Could not read toplist ranks" );
+    XLAL_CHECK_FAIL( XLALFileRead( elems, tl->elem_size, hdr.n, fp ) == ( size_t ) hdr.n, XLAL_EIO, "Could not read toplist elements" );
+  }
+  XLAL_CHECK_FAIL( toplist_checksum( ranks, elems, hdr.n, tl->elem_size ) == hdr.checksum, XLAL_EIO, "Toplist checkpoint has invalid checksum" );
+
+  /* Replace elements of toplist */
+  tl->n = 0;
+  XLAL_CHECK_FAIL( XLALToplistAddMany( tl, ranks, elems, hdr.n ) >= 0, XLAL_EFUNC );
+
+  XLALFree( ranks );
+  XLALFree( elems );
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  XLALFree( ranks );
+  XLALFree( elems );
+  return XLAL_FAILURE;
+
+}
+
+LALToplistSet *XLALToplistSetCreate(
+  int num_threads,
+  int max_size,
+  size_t elem_size,
+  LALToplistCmpFcn cmp,
+  void *cmp_param
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK_NULL( num_threads > 0, XLAL_EINVAL );
+
+  /* Allocate memory for set struct */
+  LALToplistSet *set = XLALCalloc( 1, sizeof( *set ) );
+  XLAL_CHECK_NULL( set != NULL, XLAL_ENOMEM );
+  set->tls = XLALCalloc( num_threads, sizeof( set->tls[0] ) );
+  if ( set->tls == NULL ) {
+    XLALFree( set );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  set->num_threads = num_threads;
+
+  /* Create a toplist for each thread */
+  for ( int t = 0; t < num_threads; ++t ) {
+    set->tls[t] = XLALToplistCreate( max_size, elem_size, cmp, cmp_param );
+    if ( set->tls[t] == NULL ) {
+      XLALToplistSetDestroy( set );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+  }
+
+  return set;
+
+}
+
+void XLALToplistSetDestroy(
+  LALToplistSet *set
+  )
+{
+  if ( set != NULL ) {
+    for ( int t = 0; t < set->num_threads; ++t ) {
+      XLALToplistDestroy( set->tls[t] );
+    }
+    XLALFree( set->tls );
+    XLALFree( set );
+  }
+}
+
+LALToplist *XLALToplistSetGet(
+  LALToplistSet *set,
+  int thread
+  )
+{
+  XLAL_CHECK_NULL( set != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( 0 <= thread && thread < set->num_threads, XLAL_EDOM, "Thread index %i is not in [0, %i)", thread, set->num_threads );
+  return set->tls[thread];
+}
+
+int XLALToplistSetMerge(
+  LALToplist *tl,
+  LALToplistSet *set
+  )
+{
+
+  /* Check input */
+  XLAL_CHECK( tl != NULL, XLAL_EFAULT );
+  XLAL_CHECK( set != NULL, XLAL_EFAULT );
+
+  /* Merge toplists in thread order, then clear them */
+  for ( int t = 0; t < set->num_threads; ++t ) {
+    XLAL_CHECK( XLALToplistMerge( tl, set->tls[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  for ( int t = 0; t < set->num_threads; ++t ) {
+    XLAL_CHECK( XLALToplistClear( set->tls[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (C) 2026 Karl Wette
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#ifndef _LALTOPLIST_H
+#define _LALTOPLIST_H
+
+#include <lal/LALStdlib.h>
+#include <lal/FileIO.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup LALToplist_h Header LALToplist.h
+ * \ingroup lal_utilities
+ * \brief Implementation of a generic toplist, which keeps the elements with the largest ranks out of many candidates.
+ *
+ * A ::LALToplist holds copies of at most a fixed number of elements of a fixed size, each
+ * with a \c REAL4 rank, such as a detection statistic.  The element with the smallest rank
+ * sits at the root of a 4-ary heap, so its rank is the threshold a new candidate must reach
+ * to enter a full toplist.  Candidates with equal ranks are ordered by an optional comparison
+ * function, and then by their bytes, so that the contents of a toplist depend only on the set
+ * of candidates added to it and not on the order in which they were added.  Candidates with
+ * NaN ranks are never added.
+ *
+ * Since the bytes compared include any padding of an element type, elements which are not
+ * totally ordered by the comparison function must either have no padding, or be
+ * zero-initialised (e.g. with \c memset()) before their members are set; otherwise the order
+ * of equal-ranked candidates, and hence which are kept, depends on uninitialised bytes.
+ *
+ * XLALToplistAddMany() adds an array of candidates, using XLALVectorFindScalarLessEqualREAL4()
+ * to skip over those below the threshold with SIMD instructions; XLALToplistFilter() does the
+ * same for candidates whose elements have not been computed yet.
+ *
+ * A toplist is not thread-safe.  A ::LALToplistSet holds one toplist per thread, which
+ * threads fill without locking, before XLALToplistSetMerge() merges them into one toplist.
+ * Since the order of candidates is total, the merged toplist is the same however candidates
+ * were distributed between threads.
+ *
+ * XLALToplistWrite() and XLALToplistRead() write and read a toplist to and from a checkpoint
+ * file.  Elements are written as raw bytes, so should not contain pointers, and checkpoints
+ * are only portable between machines of the same endianness.
+ */
+/** @{ */
+
+/**
+ * Generic toplist of fixed-size elements ranked by a \c REAL4
+ */
+typedef struct tagLALToplist LALToplist;
+
+/**
+ * Set of toplists, one per thread
+ */
+typedef struct tagLALToplistSet LALToplistSet;
+
+/**
+ * Function which compares toplist elements <tt>x</tt> and <tt>y</tt> of equal rank, with a parameter \c param
+ */
+typedef int ( *LALToplistCmpFcn )( void *param, const void *x, const void *y );
+
+/**
+ * Create a toplist
+ */
+LALToplist *XLALToplistCreate(
+  int max_size,                 /**< [in] Maximum number of elements in the toplist */
+  size_t elem_size,             /**< [in] Size of each element, in bytes */
+  LALToplistCmpFcn cmp,         /**< [in] Comparison function for elements of equal rank, if required; elements it does not order are compared by their bytes, including padding */
+  void *cmp_param               /**< [in] Parameter to pass to comparison function */
+  );
+
+/**
+ * Destroy a toplist
+ */
+void XLALToplistDestroy(
+  LALToplist *tl                /**< [in] Pointer to toplist */
+  );
+
+/**
+ * Remove all elements from a toplist
+ */
+int XLALToplistClear(
+  LALToplist *tl                /**< [in] Pointer to toplist */
+  );
+
+/**
+ * Return the number of elements in a toplist
+ */
+int XLALToplistSize(
+  const LALToplist *tl          /**< [in] Pointer to toplist */
+  );
+
+/**
+ * Return the maximum number of elements in a toplist
+ */
+int XLALToplistMaxSize(
+  const LALToplist *tl          /**< [in] Pointer to toplist */
+  );
+
+/**
+ * Return the smallest rank a candidate must have to be added to a toplist; \c -INFINITY if the toplist is not full
+ */
+REAL4 XLALToplistThreshold(
+  const LALToplist *tl          /**< [in] Pointer to toplist */
+  );
+
+/**
+ * Add a copy of a candidate element to a toplist, if it ranks above the smallest element of a
+ * full toplist, which is then removed.  Return 1 if the candidate was added, 0 if not, or
+ * XLAL_FAILURE on error
+ */
+int XLALToplistAdd(
+  LALToplist *tl,               /**< [in] Pointer to toplist */
+  REAL4 rank,                   /**< [in] Rank of candidate */
+  const void *x                 /**< [in] Candidate element */
+  );
+
+/**
+ * Add copies of an array of candidate elements to a toplist.  Return the number of candidates
+ * added, or XLAL_FAILURE on error
+ */
+int XLALToplistAddMany(
+  LALToplist *tl,               /**< [in] Pointer to toplist */
+  const REAL4 *ranks,           /**< [in] Ranks of candidates */
+  const void *x,                /**< [in] Array of <tt>n</tt> candidate elements */
+  int n                         /**< [in] Number of candidates */
+  );
+
+/**
+ * Find the candidates of an array which would currently be added to a toplist, without adding them
+ */
+int XLALToplistFilter(
+  const LALToplist *tl,         /**< [in] Pointer to toplist */
+  UINT4 *count,                 /**< [out] Number of candidates found */
+  UINT4 *idx,                   /**< [out] Indexes of candidates found; must have room for <tt>n</tt> indexes */
+  const REAL4 *ranks,           /**< [in] Ranks of candidates */
+  UINT4 n                       /**< [in] Number of candidates */
+  );
+
+/**
+ * Add all elements of one toplist to another
+ */
+int XLALToplistMerge(
+  LALToplist *tl,               /**< [in] Pointer to toplist to add elements to */
+  const LALToplist *src         /**< [in] Pointer to toplist to take elements from */
+  );
+
+/**
+ * Copy the ranks and elements of a toplist, in order of decreasing rank
+ */
+int XLALToplistGetSorted(
+  const LALToplist *tl,         /**< [in] Pointer to toplist */
+  REAL4 *ranks,                 /**< [out] Ranks of elements, if not \c NULL; must have room for XLALToplistSize() ranks */
+  void *x                       /**< [out] Elements, if not \c NULL; must have room for XLALToplistSize() elements */
+  );
+
+/**
+ * Write a toplist to a checkpoint file.  The header, ranks and elements are written in the
+ * byte order of the host, so the checkpoint can only be read on a machine of the same
+ * endianness
+ */
+int XLALToplistWrite(
+  LALFILE *fp,                  /**< [in] File to write to */
+  const LALToplist *tl          /**< [in] Pointer to toplist */
+  );
+
+/**
+ * Replace the elements of a toplist with those read from a checkpoint file.  The toplist must
+ * have the same element size as the toplist written; if its maximum size is smaller, only the
+ * elements of largest rank are kept.  The toplist is unchanged if the checkpoint is invalid
+ */
+int XLALToplistRead(
+  LALFILE *fp,                  /**< [in] File to read from */
+  LALToplist *tl                /**< [in] Pointer to toplist */
+  );
+
+/**
+ * Create a set of toplists with the same parameters, one per thread
+ */
+LALToplistSet *XLALToplistSetCreate(
+  int num_threads,              /**< [in] Number of threads */
+  int max_size,                 /**< [in] Maximum number of elements in each toplist */
+  size_t elem_size,             /**< [in] Size of each element, in bytes */
+  LALToplistCmpFcn cmp,         /**< [in] Comparison function for elements of equal rank, if required; elements it does not order are compared by their bytes, including padding */
+  void *cmp_param               /**< [in] Parameter to pass to comparison function */
+  );
+
+/**
+ * Destroy a set of toplists
+ */
+void XLALToplistSetDestroy(
+  LALToplistSet *set            /**< [in] Pointer to set of toplists */
+  );
+
+/**
+ * Return the toplist of a thread
+ */
+LALToplist *XLALToplistSetGet(
+  LALToplistSet *set,           /**< [in] Pointer to set of toplists */
+  int thread                    /**< [in] Index of thread, e.g. from <tt>omp_get_thread_num()</tt> */
+  );
+
+/**
+ * Add all elements of a set of toplists to a toplist, then clear the set
+ */
+int XLALToplistSetMerge(
+  LALToplist *tl,               /**< [in] Pointer to toplist to add elements to */
+  LALToplistSet *set            /**< [in] Pointer to set of toplists */
+  );
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _LALTOPLIST_H
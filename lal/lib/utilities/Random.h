@@ -92,6 +92,33 @@ RandomParams;
 
 typedef struct tagMTRandomParams MTRandomParams;
 
+/**
+ * \ingroup Random_h
+ * \brief This structure contains the state of a counter-based random number stream.
+ *
+ * The stream is generated by the Philox4x32-10 generator of \cite salmon2011 :
+ * the 32-bit random integer at position \c p of the stream is a fixed function of
+ * \c seed, \c index and \c p alone.  Streams with different seeds or indexes are
+ * statistically independent, so parallel threads may each draw from their own
+ * stream, e.g. with the thread number as the index, or from disjoint parts of the
+ * same stream after XLALSkipRandomStream().  Either way the numbers generated do
+ * not depend on the number of threads or on how work is divided between them.
+ *
+ * Each REAL4 uniform or normal deviate consumes one random integer, and each REAL8
+ * deviate two.  Normal deviates are generated in pairs by the Box-Muller method, so
+ * filling an odd number of normal deviates consumes the random integers of one more.
+ * \note The contents may be saved and restored, e.g. for checkpointing, but should
+ * otherwise only be changed through the functions below.
+ */
+typedef struct
+tagRandomStream
+{
+  UINT8 seed;		/**< Seed of the stream, used as the generator key */
+  UINT8 index;		/**< Index of the stream, used as the upper half of the generator counter */
+  UINT8 position;	/**< Number of random integers consumed from the stream */
+}
+RandomStream;
+
 
 INT4 XLALBasicRandom( INT4 i );
 RandomParams * XLALCreateRandomParams( INT4 seed );
@@ -101,6 +128,17 @@ REAL4 XLALUniformDeviate( RandomParams *params );
 int XLALNormalDeviates( REAL4Vector *deviates, RandomParams *params );
 REAL4 XLALNormalDeviate( RandomParams *params );
 
+int XLALInitRandomStream( RandomStream *stream, UINT8 seed, UINT8 index );
+int XLALDeriveRandomStream( RandomStream *child, const RandomStream *parent, UINT8 index );
+int XLALSkipRandomStream( RandomStream *stream, UINT8 n );
+int XLALRandomStreamUINT4( RandomStream *stream, UINT4 *out, UINT4 len );
+int XLALRandomStreamUniformREAL4( RandomStream *stream, REAL4 *out, UINT4 len );
+int XLALRandomStreamUniformREAL8( RandomStream *stream, REAL8 *out, UINT4 len );
+int XLALRandomStreamNormalREAL4( RandomStream *stream, REAL4 *out, UINT4 len );
+int XLALRandomStreamNormalREAL8( RandomStream *stream, REAL8 *out, UINT4 len );
+REAL8 XLALRandomStreamUniformDeviate( RandomStream *stream );
+REAL8 XLALRandomStreamNormalDeviate( RandomStream *stream );
+
 void
 LALCreateRandomParams (
     LALStatus        *status,
@@ -0,0 +1,360 @@
+/*
+ *  Copyright (C) 2026 Jolien Creighton
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <math.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/Random.h>
+#include <lal/VectorMath.h>
+
+/**
+ * \defgroup RandomStream_c Module RandomStream.c
+ * \ingroup Random_h
+ *
+ * \brief Functions for generating counter-based streams of random numbers.
+ *
+ * ### Description ###
+ *
+ * XLALInitRandomStream() starts a ::RandomStream with a given seed and index.
+ * XLALDeriveRandomStream() starts a new stream whose seed and index are derived
+ * from those of an existing stream and a further index, e.g. to give each thread
+ * of each job of a parallel search its own stream.  XLALSkipRandomStream() skips
+ * ahead in a stream in constant time.
+ *
+ * XLALRandomStreamUINT4() fills an array with random 32-bit integers, and
+ * XLALRandomStreamUniformREAL4() and XLALRandomStreamUniformREAL8() with deviates
+ * distributed uniformly in the open interval (0,1).
+ * XLALRandomStreamNormalREAL4() and XLALRandomStreamNormalREAL8() fill an array
+ * with normal deviates with zero mean and unit variance.
+ * XLALRandomStreamUniformDeviate() and XLALRandomStreamNormalDeviate() return
+ * a single REAL8 deviate.
+ *
+ * ### Operating Instructions ###
+ *
+ * \code
+ * REAL4 *noise = ...;
+ * RandomStream stream;
+ * XLALInitRandomStream( &stream, seed, 0 );
+ *
+ * // fill noise in parallel; each thread skips to its own part of the stream
+ * #pragma omp parallel for
+ * for ( UINT4 i = 0; i < nchunks; ++i ) {
+ *   RandomStream s = stream;
+ *   XLALSkipRandomStream( &s, ( UINT8 ) i * chunklen );
+ *   XLALRandomStreamNormalREAL4( &s, noise + i * chunklen, chunklen );
+ * }
+ * \endcode
+ *
+ * Large arrays are also filled in parallel internally, when LAL is built with OpenMP.
+ * The results are the same as if the arrays were filled serially.
+ *
+ * ### Algorithm ###
+ *
+ * Random integers are generated by the Philox4x32-10 counter-based generator of
+ * \cite salmon2011, which passes the BigCrush tests of TestU01.  Blocks of many
+ * counters are generated at once, in loops which compilers can vectorise.
+ * Normal deviates are generated in pairs by the Box-Muller method; REAL4 normal
+ * deviates use the SIMD functions XLALVectorLogREAL4() and XLALVectorSinCos2PiREAL4().
+ * Uniform deviates are formed from the upper 23 (REAL4) or 52 (REAL8) bits of
+ * random integers, and are never exactly 0 or 1.
+ *
+ */
+/** @{ */
+
+/* Philox4x32-10 multipliers and key increments */
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+#define PHILOX_ROUNDS 10
+
+/* Number of blocks of 4 random integers generated at once */
+#define BATCH_BLOCKS 64
+#define BATCH_WORDS (4*BATCH_BLOCKS)
+
+/* Minimum number of batches before filling arrays in parallel */
+#define PARALLEL_MIN_BATCHES 64
+
+/* Key increment used when deriving streams, to keep derived seeds apart from generated numbers */
+#define DERIVE_KEY 0x5A17C0DE5EED5A17ULL
+
+/* Function which fills 'n' deviates using the random integers from position 'pos' of a stream */
+typedef int ( *random_stream_batch_fcn )( void *out, const RandomStream *stream, UINT8 pos, UINT4 n );
+
+/* Generate 'nb' <= BATCH_BLOCKS + 1 consecutive blocks of 4 random integers, starting at block 'b0' of counter half 'index' with key 'seed' */
+static void philox_blocks( UINT4 *out, UINT8 seed, UINT8 index, UINT8 b0, UINT4 nb )
+{
+  UINT4 c0[BATCH_BLOCKS + 1], c1[BATCH_BLOCKS + 1], c2[BATCH_BLOCKS + 1], c3[BATCH_BLOCKS + 1];
+  for ( UINT4 j = 0; j < nb; ++j ) {
+    c0[j] = ( UINT4 )( b0 + j );
+    c1[j] = ( UINT4 )( ( b0 + j ) >> 32 );
+    c2[j] = ( UINT4 ) index;
+    c3[j] = ( UINT4 )( index >> 32 );
+  }
+  UINT4 k0 = ( UINT4 ) seed, k1 = ( UINT4 )( seed >> 32 );
+  for ( int r = 0; r < PHILOX_ROUNDS; ++r ) {
+#pragma omp simd
+    for ( UINT4 j = 0; j < nb; ++j ) {
+      const UINT8 p0 = ( UINT8 ) PHILOX_M0 * c0[j];
+      const UINT8 p1 = ( UINT8 ) PHILOX_M1 * c2[j];
+      c0[j] = ( UINT4 )( p1 >> 32 ) ^ c1[j] ^ k0;
+      c1[j] = ( UINT4 ) p1;
+      c2[j] = ( UINT4 )( p0 >> 32 ) ^ c3[j] ^ k1;
+      c3[j] = ( UINT4 ) p0;
+    }
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  for ( UINT4 j = 0; j < nb; ++j ) {
+    out[4*j + 0] = c0[j];
+    out[4*j + 1] = c1[j];
+    out[4*j + 2] = c2[j];
+    out[4*j + 3] = c3[j];
+  }
+}
+
+/* Put the 'n' <= BATCH_WORDS random integers from position 'pos' of a stream in 'out'; if 'pos' is not at the start of a block, one more block is needed */
+static void philox_words( UINT4 *out, const RandomStream *stream, UINT8 pos, UINT4 n )
+{
+  UINT4 blocks[BATCH_WORDS + 4];
+  const UINT4 skip = pos % 4;
+  const UINT4 nb = ( skip + n + 3 ) / 4;
+  philox_blocks( blocks, stream->seed, stream->index, pos / 4, nb );
+  for ( UINT4 i = 0; i < n; ++i ) {
+    out[i] = blocks[skip + i];
+  }
+}
+
+/* Convert random integers to REAL4 and REAL8 uniform deviates in (0,1) */
+static inline REAL4 uniform_REAL4( UINT4 w )
+{
+  return ( ( w >> 9 ) + 0.5f ) * 0x1p-23f;
+}
+static inline REAL8 uniform_REAL8( UINT4 w0, UINT4 w1 )
+{
+  return ( ( ( ( UINT8 )( w0 >> 6 ) ) << 26 | ( w1 >> 6 ) ) + 0.5 ) * 0x1p-52;
+}
+
+static int batch_UINT4( void *out, const RandomStream *stream, UINT8 pos, UINT4 n )
+{
+  philox_words( ( UINT4 * ) out, stream, pos, n );
+  return XLAL_SUCCESS;
+}
+
+static int batch_uniform_REAL4( void *out, const RandomStream *stream, UINT8 pos, UINT4 n )
+{
+  REAL4 *x = ( REAL4 * ) out;
+  UINT4 w[BATCH_WORDS];
+  philox_words( w, stream, pos, n );
+  for ( UINT4 i = 0; i < n; ++i ) {
+    x[i] = uniform_REAL4( w[i] );
+  }
+  return XLAL_SUCCESS;
+}
+
+static int batch_uniform_REAL8( void *out, const RandomStream *stream, UINT8 pos, UINT4 n )
+{
+  REAL8 *x = ( REAL8 * ) out;
+  UINT4 w[BATCH_WORDS];
+  philox_words( w, stream, pos, 2*n );
+  for ( UINT4 i = 0; i < n; ++i ) {
+    x[i] = uniform_REAL8( w[2*i], w[2*i + 1] );
+  }
+  return XLAL_SUCCESS;
+}
+
+static int batch_normal_REAL4( void *out, const RandomStream *stream, UINT8 pos, UINT4 n )
+{
+  REAL4 *x = ( REAL4 * ) out;
+  const UINT4 np = ( n + 1 ) / 2;
+  UINT4 w[BATCH_WORDS];
+  REAL4 u[BATCH_WORDS / 2], v[BATCH_WORDS / 2], logu[BATCH_WORDS / 2], s[BATCH_WORDS / 2], c[BATCH_WORDS / 2];
+  philox_words( w, stream, pos, 2*np );
+  for ( UINT4 k = 0; k < np; ++k ) {
+    u[k] = uniform_REAL4( w[2*k] );
+    v[k] = uniform_REAL4( w[2*k + 1] );
+  }
+  XLAL_CHECK( XLALVectorLogREAL4( logu, u, np ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALVectorSinCos2PiREAL4( s, c, v, np ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 k = 0; k < n / 2; ++k ) {
+    const REAL4 r = sqrtf( -2.0f * logu[k] );
+    x[2*k] = r * c[k];
+    x[2*k + 1] = r * s[k];
+  }
+  if ( n % 2 ) {
+    x[n - 1] = sqrtf( -2.0f * logu[np - 1] ) * c[np - 1];
+  }
+  return XLAL_SUCCESS;
+}
+
+static int batch_normal_REAL8( void *out, const RandomStream *stream, UINT8 pos, UINT4 n )
+{
+  REAL8 *x = ( REAL8 * ) out;
+  const UINT4 np = ( n + 1 ) / 2;
+  UINT4 w[BATCH_WORDS];
+  philox_words( w, stream, pos, 4*np );
+  for ( UINT4 k = 0; k < np; ++k ) {
+    const REAL8 r = sqrt( -2.0 * log( uniform_REAL8( w[4*k], w[4*k + 1] ) ) );
+    const REAL8 phi = LAL_TWOPI * uniform_REAL8( w[4*k + 2], w[4*k + 3] );
+    x[2*k] = r * cos( phi );
+    if ( 2*k + 1 < n ) {
+      x[2*k + 1] = r * sin( phi );
+    }
+  }
+  return XLAL_SUCCESS;
+}
+
+/*
+ * Fill 'len' deviates of size 'size' in 'out', each consuming 'words' random integers,
+ * by calling 'batch' on batches of BATCH_WORDS random integers.  If 'pairs' is true,
+ * deviates are generated in pairs, so an odd 'len' consumes the integers of one more.
+ * Since each batch depends only on its position in the stream, batches may be filled
+ * in any order, and in parallel.
+ */
+static int random_stream_fill( RandomStream *stream, void *out, size_t size, UINT4 len, UINT4 words, int pairs, random_stream_batch_fcn batch )
+{
+
+  /* Check input */
+  XLAL_CHECK( stream != NULL, XLAL_EFAULT );
+  XLAL_CHECK( len == 0 || out != NULL, XLAL_EFAULT );
+
+  /* Fill deviates in batches */
+  const UINT8 pos = stream->position;
+  const UINT4 per_batch = BATCH_WORDS / words;
+  const UINT4 nbatch = ( len + per_batch - 1 ) / per_batch;
+  int failed = 0;
+#pragma omp parallel for schedule(static) reduction(|:failed) if(nbatch >= PARALLEL_MIN_BATCHES)
+  for ( UINT4 b = 0; b < nbatch; ++b ) {
+    const UINT4 i0 = b * per_batch;
+    const UINT4 n = ( len - i0 < per_batch ) ? len - i0 : per_batch;
+    failed |= ( batch( ( char * ) out + i0 * size, stream, pos + ( UINT8 ) i0 * words, n ) != XLAL_SUCCESS );
+  }
+  XLAL_CHECK( !failed, XLAL_EFUNC );
+
+  /* Advance stream */
+  stream->position += ( UINT8 ) words * ( pairs ? len + ( len % 2 ) : len );
+
+  return XLAL_SUCCESS;
+
+}
+
+/**
+ * Start a random stream with the given seed and index, at position zero.
+ */
+int XLALInitRandomStream( RandomStream *stream, UINT8 seed, UINT8 index )
+{
+  XLAL_CHECK( stream != NULL, XLAL_EFAULT );
+  stream->seed = seed;
+  stream->index = index;
+  stream->position = 0;
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Start a random stream whose seed and index are derived from those of \c parent and from \c index.
+ * The position of \c parent is ignored, and \c parent is not changed.
+ */
+int XLALDeriveRandomStream( RandomStream *child, const RandomStream *parent, UINT8 index )
+{
+  XLAL_CHECK( child != NULL, XLAL_EFAULT );
+  XLAL_CHECK( parent != NULL, XLAL_EFAULT );
+  UINT4 w[4];
+  philox_blocks( w, parent->seed + DERIVE_KEY, parent->index, index, 1 );
+  child->seed = ( ( UINT8 ) w[1] ) << 32 | w[0];
+  child->index = ( ( UINT8 ) w[3] ) << 32 | w[2];
+  child->position = 0;
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Skip over the next \c n random integers of a random stream.
+ */
+int XLALSkipRandomStream( RandomStream *stream, UINT8 n )
+{
+  XLAL_CHECK( stream != NULL, XLAL_EFAULT );
+  stream->position += n;
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Fill \c out with \c len random 32-bit integers.
+ */
+int XLALRandomStreamUINT4( RandomStream *stream, UINT4 *out, UINT4 len )
+{
+  XLAL_CHECK( random_stream_fill( stream, out, sizeof( *out ), len, 1, 0, batch_UINT4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Fill \c out with \c len REAL4 deviates distributed uniformly in (0,1).
+ */
+int XLALRandomStreamUniformREAL4( RandomStream *stream, REAL4 *out, UINT4 len )
+{
+  XLAL_CHECK( random_stream_fill( stream, out, sizeof( *out ), len, 1, 0, batch_uniform_REAL4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Fill \c out with \c len REAL8 deviates distributed uniformly in (0,1).
+ */
+int XLALRandomStreamUniformREAL8( RandomStream *stream, REAL8 *out, UINT4 len )
+{
+  XLAL_CHECK( random_stream_fill( stream, out, sizeof( *out ), len, 2, 0, batch_uniform_REAL8 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Fill \c out with \c len REAL4 normal deviates with zero mean and unit variance.
+ */
+int XLALRandomStreamNormalREAL4( RandomStream *stream, REAL4 *out, UINT4 len )
+{
+  XLAL_CHECK( random_stream_fill( stream, out, sizeof( *out ), len, 1, 1, batch_normal_REAL4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Fill \c out with \c len REAL8 normal deviates with zero mean and unit variance.
+ */
+int XLALRandomStreamNormalREAL8( RandomStream *stream, REAL8 *out, UINT4 len )
+{
+  XLAL_CHECK( random_stream_fill( stream, out, sizeof( *out ), len, 2, 1, batch_normal_REAL8 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * Return a single REAL8 deviate distributed uniformly in (0,1).
+ */
+REAL8 XLALRandomStreamUniformDeviate( RandomStream *stream )
+{
+  REAL8 x;
+  XLAL_CHECK_REAL8( XLALRandomStreamUniformREAL8( stream, &x, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return x;
+}
+
+/**
+ * Return a single REAL8 normal deviate with zero mean and unit variance.
+ */
+REAL8 XLALRandomStreamNormalDeviate( RandomStream *stream )
+{
+  REAL8 x;
+  XLAL_CHECK_REAL8( XLALRandomStreamNormalREAL8( stream, &x, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return x;
+}
+
+/** @} */
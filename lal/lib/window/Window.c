@@ -29,9 +29,13 @@
 
 
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include <gsl/gsl_sf_bessel.h>
+#include <config.h>
 #include <lal/LALConstants.h>
+#include <lal/LALHashFunc.h>
+#include <lal/LALHashTbl.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALString.h>
 #include <lal/Sequence.h>
@@ -848,17 +852,11 @@ XLALParseWindowNameAndCheckBeta ( const char *windowName,	//< [in] window-name t
 } // XLALParseWindowNameAndCheckBeta()
 
 /**
- * Generic window-function wrapper, allowing to select a window by its name.
- * windowBeta must be set to '0' for windows without parameter.
+ * Create a window given its internal window-type index.
  */
-REAL8Window *
-XLALCreateNamedREAL8Window ( const char *windowName, REAL8 beta, UINT4 length )
+static REAL8Window *
+CreateTypedREAL8Window ( int wintype, REAL8 beta, UINT4 length )
 {
-  XLAL_CHECK_NULL ( length > 0, XLAL_EINVAL );
-
-  int wintype;
-  XLAL_CHECK_NULL ( (wintype = XLALParseWindowNameAndCheckBeta ( windowName, beta )) >= 0, XLAL_EFUNC );
-
   REAL8Window *win = NULL;
   switch ( wintype )
     {
@@ -907,6 +905,25 @@ XLALCreateNamedREAL8Window ( const char *windowName, REAL8 beta, UINT4 length )
 
   return win;
 
+} /* CreateTypedREAL8Window() */
+
+/**
+ * Generic window-function wrapper, allowing to select a window by its name.
+ * windowBeta must be set to '0' for windows without parameter.
+ */
+REAL8Window *
+XLALCreateNamedREAL8Window ( const char *windowName, REAL8 beta, UINT4 length )
+{
+  XLAL_CHECK_NULL ( length > 0, XLAL_EINVAL );
+
+  int wintype;
+  XLAL_CHECK_NULL ( (wintype = XLALParseWindowNameAndCheckBeta ( windowName, beta )) >= 0, XLAL_EFUNC );
+
+  REAL8Window *win = CreateTypedREAL8Window ( wintype, beta, length );
+  XLAL_CHECK_NULL (win != NULL, XLAL_EFUNC );
+
+  return win;
+
 } /* XLALCreateNamedREAL8Window() */
 
 
@@ -915,3 +932,292 @@ XLALCreateNamedREAL4Window ( const char *windowName, REAL8 beta, UINT4 length )
 {
   return XLALREAL4Window_from_REAL8Window ( XLALCreateNamedREAL8Window ( windowName, beta, length ) );
 }
+
+
+/*
+ * ============================================================================
+ *
+ *                               Cached Windows
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * Cached windows are kept in a concurrent hash table, created by
+ * XLALHashTblCreateConcurrent(), in which they are found without locking.
+ * Windows are computed outside of any lock.  Adding a window takes a lock,
+ * and if two threads miss the same window, the first one added wins and
+ * the other is discarded.  Each window is allocated in one block with its
+ * sequence and data.
+ */
+
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_mutex_t window_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK(l)		pthread_mutex_lock(&(l))
+#define UNLOCK(l)	pthread_mutex_unlock(&(l))
+#else
+#define LOCK(l)
+#define UNLOCK(l)
+#endif
+
+
+/* without atomic operations, the pointer to the hash table is only read under the lock */
+#if defined(HAVE_STDATOMIC_H) && !defined(__STDC_NO_ATOMICS__)
+#define LAL_WINDOW_ATOMICS 1
+#include <stdatomic.h>
+static _Atomic(LALHashTbl *) window_cache = NULL;
+#else
+static LALHashTbl *window_cache = NULL;
+#endif
+
+
+struct windowCacheKey {
+	INT4 type;	/* window type; -1 - type for single-precision windows */
+	UINT4 length;
+	REAL8 beta;
+};
+
+
+struct windowCacheEntry {
+	struct windowCacheKey key;
+	UINT8 hash;
+	union {
+		REAL8Window w8;
+		REAL4Window w4;
+	} window;
+	union {
+		REAL8Sequence s8;
+		REAL4Sequence s4;
+	} sequence;
+	/* followed by the window samples */
+};
+
+
+static UINT8 window_cache_key(struct windowCacheKey *key, int type, REAL8 beta, UINT4 length)
+{
+	memset(key, 0, sizeof(*key));
+	key->type = type;
+	key->length = length;
+	/* -0 and +0 are the same window */
+	key->beta = beta == 0 ? 0 : beta;
+	return XLALCityHash64((const char *) key, sizeof(*key));
+}
+
+
+static UINT8 window_cache_entry_hash(const void *x)
+{
+	return ((const struct windowCacheEntry *) x)->hash;
+}
+
+
+static int window_cache_entry_cmp(const void *x, const void *y)
+{
+	return memcmp(&((const struct windowCacheEntry *) x)->key, &((const struct windowCacheEntry *) y)->key, sizeof(struct windowCacheKey));
+}
+
+
+/* return the hash table of cached windows, creating it if required */
+static LALHashTbl *window_cache_table(void)
+{
+	LALHashTbl *table;
+#ifdef LAL_WINDOW_ATOMICS
+	table = atomic_load_explicit(&window_cache, memory_order_acquire);
+	if(table)
+		return table;
+#endif
+	LOCK(window_cache_mutex);
+	table = window_cache;
+	if(!table) {
+		table = XLALHashTblCreateConcurrent(XLALFree, window_cache_entry_hash, window_cache_entry_cmp);
+		window_cache = table;
+	}
+	UNLOCK(window_cache_mutex);
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return table;
+}
+
+
+/* find an entry in the cache; *found is NULL if there is no matching entry */
+static int window_cache_find(LALHashTbl *table, const struct windowCacheKey *key, UINT8 hash, const struct windowCacheEntry **found)
+{
+	struct windowCacheEntry find_entry;
+	const void *x = NULL;
+	find_entry.key = *key;
+	find_entry.hash = hash;
+	if(XLALHashTblFind(table, &find_entry, &x) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	*found = x;
+	return 0;
+}
+
+
+/* allocate an entry with room for the window samples */
+static struct windowCacheEntry *window_cache_entry_new(const struct windowCacheKey *key, UINT8 hash, size_t sample_size)
+{
+	struct windowCacheEntry *entry = XLALMalloc(sizeof(*entry) + key->length * sample_size);
+	if(!entry)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	entry->key = *key;
+	entry->hash = hash;
+	return entry;
+}
+
+
+/* add an entry to the cache and return it, or return the matching entry
+ * already added by another thread and free the new one */
+static const struct windowCacheEntry *window_cache_add(LALHashTbl *table, struct windowCacheEntry *entry)
+{
+	const struct windowCacheEntry *found = NULL;
+	int retn;
+
+	LOCK(window_cache_mutex);
+	retn = window_cache_find(table, &entry->key, entry->hash, &found);
+	if(retn == 0 && found == NULL) {
+		retn = XLALHashTblAdd(table, entry);
+		if(retn == 0)
+			found = entry;
+	}
+	UNLOCK(window_cache_mutex);
+	if(found != entry)
+		XLALFree(entry);
+	if(retn < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return found;
+}
+
+
+/* find or add the cache entry of a double-precision window */
+static const struct windowCacheEntry *window_cache_get_REAL8(const char *windowName, REAL8 beta, UINT4 length)
+{
+	struct windowCacheKey key;
+	const struct windowCacheEntry *found;
+	struct windowCacheEntry *entry;
+	LALHashTbl *table;
+	REAL8Window *window;
+	UINT8 hash;
+	int type;
+
+	XLAL_CHECK_NULL(length > 0, XLAL_EINVAL);
+	XLAL_CHECK_NULL((type = XLALParseWindowNameAndCheckBeta(windowName, beta)) >= 0, XLAL_EFUNC);
+
+	table = window_cache_table();
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	hash = window_cache_key(&key, type, beta, length);
+	if(window_cache_find(table, &key, hash, &found) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	if(found)
+		return found;
+
+	/* not found: compute the window, and copy it into a new entry */
+	window = CreateTypedREAL8Window(type, beta, length);
+	if(!window)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	entry = window_cache_entry_new(&key, hash, sizeof(REAL8));
+	if(!entry) {
+		XLALDestroyREAL8Window(window);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	entry->sequence.s8.length = length;
+	entry->sequence.s8.data = (REAL8 *) (entry + 1);
+	memcpy(entry->sequence.s8.data, window->data->data, length * sizeof(REAL8));
+	entry->window.w8.data = &entry->sequence.s8;
+	entry->window.w8.sumofsquares = window->sumofsquares;
+	entry->window.w8.sum = window->sum;
+	XLALDestroyREAL8Window(window);
+
+	found = window_cache_add(table, entry);
+	if(!found)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return found;
+}
+
+
+/**
+ * Return a window, selected by its name as for XLALCreateNamedREAL8Window(),
+ * from a cache of windows which is shared by all threads.  The window is
+ * computed the first time it is requested; later requests with the same
+ * name, parameter and length return the same window without computing it
+ * again.  The window is owned by the cache and must not be modified or
+ * destroyed; it remains valid until XLALClearWindowCache() is called,
+ * which LALCheckMemoryLeaks() also does.
+ *
+ * This function is thread-safe, and windows in the cache are found without
+ * locking.  It is intended for windows which are used many times with the
+ * same parameters, e.g. to window each segment of a long time series; every
+ * distinct window requested stays in memory.
+ */
+const REAL8Window *XLALGetCachedNamedREAL8Window(const char *windowName, REAL8 beta, UINT4 length)
+{
+	const struct windowCacheEntry *found = window_cache_get_REAL8(windowName, beta, length);
+	if(!found)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return &found->window.w8;
+}
+
+
+/**
+ * Single-precision version of XLALGetCachedNamedREAL8Window().  The window
+ * is converted from the cached double-precision window, which is also
+ * cached.
+ */
+const REAL4Window *XLALGetCachedNamedREAL4Window(const char *windowName, REAL8 beta, UINT4 length)
+{
+	struct windowCacheKey key;
+	const struct windowCacheEntry *found;
+	struct windowCacheEntry *entry;
+	const REAL8Window *window;
+	LALHashTbl *table;
+	UINT8 hash;
+	UINT4 i;
+
+	found = window_cache_get_REAL8(windowName, beta, length);
+	if(!found)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	window = &found->window.w8;
+
+	table = window_cache_table();
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	hash = window_cache_key(&key, -1 - found->key.type, beta, length);
+	if(window_cache_find(table, &key, hash, &found) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	if(found)
+		return &found->window.w4;
+
+	entry = window_cache_entry_new(&key, hash, sizeof(REAL4));
+	if(!entry)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	entry->sequence.s4.length = length;
+	entry->sequence.s4.data = (REAL4 *) (entry + 1);
+	for(i = 0; i < length; i++)
+		entry->sequence.s4.data[i] = window->data->data[i];
+	entry->window.w4.data = &entry->sequence.s4;
+	entry->window.w4.sumofsquares = window->sumofsquares;
+	entry->window.w4.sum = window->sum;
+
+	found = window_cache_add(table, entry);
+	if(!found)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return &found->window.w4;
+}
+
+
+/**
+ * Free all windows in the cache used by XLALGetCachedNamedREAL8Window() and
+ * XLALGetCachedNamedREAL4Window().  This function must not be called while
+ * any cached window is in use, or concurrently with any other function
+ * using the cache.  It is called by LALCheckMemoryLeaks(), so that cached
+ * windows are not reported as memory leaks.
+ */
+void XLALClearWindowCache(void)
+{
+	LOCK(window_cache_mutex);
+	XLALHashTblDestroy(window_cache);
+	window_cache = NULL;
+	UNLOCK(window_cache_mutex);
+}
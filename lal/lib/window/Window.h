@@ -232,6 +232,13 @@ extern "C" {
  * or to measure a broad spectrum with a large dynamical range (a Creighton or
  * a Papoulis window).
  *
+ * Code which applies the same window many times, e.g. to each segment of a
+ * long time series, can use XLALGetCachedNamedREAL8Window() or
+ * XLALGetCachedNamedREAL4Window() instead of creating and destroying the
+ * window each time.  These return windows from a thread-safe cache shared by
+ * the whole program, which are computed only once; they must not be modified
+ * or destroyed by the caller.
+ *
  */
 /** @{ */
 
@@ -306,6 +313,12 @@ COMPLEX16Sequence *XLALUnitaryWindowCOMPLEX16Sequence(COMPLEX16Sequence *sequenc
 REAL8Window *XLALCreateNamedREAL8Window ( const char *windowName, REAL8 beta, UINT4 length );
 REAL4Window *XLALCreateNamedREAL4Window ( const char *windowName, REAL8 beta, UINT4 length );
 
+const REAL8Window *XLALGetCachedNamedREAL8Window(const char *windowName, REAL8 beta, UINT4 length);
+const REAL4Window *XLALGetCachedNamedREAL4Window(const char *windowName, REAL8 beta, UINT4 length);
+#ifndef SWIG /* exclude from SWIG interface */
+void XLALClearWindowCache(void);
+#endif /* SWIG */
+
 /** @} */
 
 #ifdef  __cplusplus
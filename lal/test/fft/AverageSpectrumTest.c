@@ -26,6 +26,7 @@
 #include <lal/RealFFT.h>
 #include <lal/Window.h>
 #include <lal/Random.h>
+#include <lal/Units.h>
 
 #define TESTSTATUS( s ) \
   if ( (s)->statusCode ) { REPORTSTATUS( s ); exit( 1 ); } else \
@@ -84,6 +85,39 @@ int main( void )
   ave /= fseries.data->length - 2;
   fprintf( stdout, "median:\t%e\terror:\t%f%%\n", ave, fabs( ave - 2.0 ) / 0.02 );
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+  /* the batch median method must agree with the median method */
+  {
+    const UINT4 numseg = 2 * m - 1;
+    static REAL4FrequencySeries bseries;
+    REAL4FFTBatchPlan *bplan;
+    REAL8 maxerr = 0;
+    LALCreateVector( &status, &bseries.data, n / 2 + 1 );
+    TESTSTATUS( &status );
+    bplan = XLALCreateREAL4FFTBatchPlan( n, numseg, numseg, 1, 0 );
+    if ( ! bplan || XLALREAL4AverageSpectrumMedianBatch( &bseries, &tseries, n, n / 2, window, bplan ) )
+    {
+      fprintf( stderr, "batch median method failed\n" );
+      exit( 1 );
+    }
+    for ( i = 0; i < fseries.data->length; ++i )
+    {
+      REAL8 err = fabs( bseries.data->data[i] - fseries.data->data[i] ) / fseries.data->data[i];
+      if ( err > maxerr )
+        maxerr = err;
+    }
+    fprintf( stdout, "batch median:\tmax relative difference:\t%e\n", maxerr );
+    if ( maxerr > 1e-3 || bseries.deltaF != fseries.deltaF || XLALUnitCompare( &bseries.sampleUnits, &fseries.sampleUnits ) )
+    {
+      fprintf( stderr, "batch median method disagrees with median method\n" );
+      exit( 1 );
+    }
+    XLALDestroyREAL4FFTBatchPlan( bplan );
+    LALDestroyVector( &status, &bseries.data );
+    TESTSTATUS( &status );
+  }
+#endif
+
   /* now do the same for mean */
   XLALREAL4AverageSpectrumWelch( &fseries, &tseries, n, n / 2, window, plan );
   /* average values of power spectrum (omit DC & Nyquist ) */
@@ -60,6 +60,7 @@
 #include <lal/LALStdlib.h>
 #include <lal/LALgetopt.h>
 #include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
 #include <lal/ComplexFFT.h>
 #include <lal/LALString.h>
 #include <config.h>
@@ -78,6 +79,11 @@ ParseOptions( int argc, char *argv[] );
 static void
 TestStatus( LALStatus *status, const char *expectedCodes, int exitCode );
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+static int
+TestBatch( UINT4 n, UINT4 howmany, UINT4 stride, int inplace );
+#endif
+
 int
 main( int argc, char *argv[] )
 {
@@ -173,11 +179,94 @@ main( int argc, char *argv[] )
   LALCDestroyVector( &status, &avec );
   TestStatus( &status, CODES( 0 ), 1 );
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+  /* check batched transforms against single transforms */
+  if ( TestBatch( n, 5, 0, 0 ) || TestBatch( n, 5, 0, 1 )
+       || TestBatch( n, 5, 7, 0 ) || TestBatch( n, 3, 3, 1 ) )
+  {
+    return 1;
+  }
+#endif
+
   LALCheckMemoryLeaks();
   return 0;
 }
 
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+/*
+ * TestBatch()
+ *
+ * Checks that howmany batched forward transforms of size n agree with
+ * the same transforms performed one at a time.  If stride is zero the
+ * transforms are consecutive vectors of a sequence, otherwise they are
+ * interleaved with the given stride.
+ *
+ */
+static int
+TestBatch( UINT4 n, UINT4 howmany, UINT4 stride, int inplace )
+{
+  const REAL8 eps = 1e-5;
+  COMPLEX8FFTBatchPlan   *bfwd = XLALCreateCOMPLEX8FFTBatchPlan( n, howmany, stride, 1, inplace, 0 );
+  COMPLEX8FFTPlan        *fwd  = XLALCreateForwardCOMPLEX8FFTPlan( n, 0 );
+  COMPLEX8VectorSequence *aseq = XLALCreateCOMPLEX8VectorSequence( stride ? n : howmany, stride ? stride : n );
+  COMPLEX8VectorSequence *bseq = inplace ? aseq : XLALCreateCOMPLEX8VectorSequence( aseq->length, aseq->vectorLength );
+  COMPLEX8Vector         *avec = XLALCreateCOMPLEX8Vector( n );
+  COMPLEX8Vector         *bvec = XLALCreateCOMPLEX8Vector( n );
+  COMPLEX8Vector         *cvec = XLALCreateCOMPLEX8Vector( aseq->length * aseq->vectorLength );
+  UINT4 j, k;
+
+  if ( !bfwd || !fwd || !aseq || !bseq || !avec || !bvec || !cvec )
+  {
+    fprintf( stderr, "FAIL: Could not create batch test plans or sequences\n" );
+    return 1;
+  }
+
+  for ( k = 0; k < cvec->length; ++k )
+  {
+    aseq->data[k] = cvec->data[k] = ( rand() % 5 - 2 ) + I * ( rand() % 3 - 1 );
+  }
+
+  if ( XLALCOMPLEX8VectorSequenceFFT( bseq, aseq, bfwd ) != 0 )
+  {
+    fprintf( stderr, "FAIL: Error in batched transform\n" );
+    return 1;
+  }
+
+  for ( j = 0; j < howmany; ++j )
+  {
+    for ( k = 0; k < n; ++k )
+    {
+      avec->data[k] = stride ? cvec->data[k * stride + j] : cvec->data[j * n + k];
+    }
+    XLALCOMPLEX8VectorFFT( bvec, avec, fwd );
+    for ( k = 0; k < n; ++k )
+    {
+      const COMPLEX8 z = stride ? bseq->data[k * stride + j] : bseq->data[j * n + k];
+      if ( cabs( z - bvec->data[k] ) > eps * n * ( 1 + cabs( bvec->data[k] ) ) )
+      {
+        fprintf( stderr, "FAIL: Batched transform %u differs at %u\n", j, k );
+        return 1;
+      }
+    }
+  }
+
+  XLALDestroyCOMPLEX8FFTBatchPlan( bfwd );
+  XLALDestroyCOMPLEX8FFTPlan( fwd );
+  if ( !inplace )
+  {
+    XLALDestroyCOMPLEX8VectorSequence( bseq );
+  }
+  XLALDestroyCOMPLEX8VectorSequence( aseq );
+  XLALDestroyCOMPLEX8Vector( avec );
+  XLALDestroyCOMPLEX8Vector( bvec );
+  XLALDestroyCOMPLEX8Vector( cvec );
+
+  return 0;
+}
+#endif
+
+
 /*
  * TestStatus()
  *
@@ -0,0 +1,166 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests threaded FFTW plans created by LAL. Usage:
+ *
+ *   FFTWThreadsTest <threads> <min size>
+ *
+ * where <threads> and <min size> are the settings expected to have been
+ * read from the environment variables LAL_FFTW_THREADS and
+ * LAL_FFTW_THREADS_MIN_SIZE; see FFTWThreadsTests.sh.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/AVFactories.h>
+#include <lal/ComplexFFT.h>
+#include <lal/RealFFT.h>
+#include <lal/FFTWMutex.h>
+
+/* Size of transforms to compare; above the default minimum size for threaded plans */
+#define FFT_SIZE (1 << 17)
+
+/* Number of threads used by threaded plans */
+#define FFT_THREADS 4
+
+/* Tolerances on the RMS difference between the output of threaded and unthreaded plans, relative to the RMS output */
+#define FFT_COMPLEX8_TOL 1e-5
+#define FFT_REAL8_TOL 1e-13
+
+static int test_env( int expect_threads, UINT8 expect_min_size )
+{
+
+  /* Query settings read from the environment, before they are overridden below */
+  const int nthreads_below = XLALGetFFTWThreads( expect_min_size > 0 ? expect_min_size - 1 : 0 );
+  const int nthreads_above = XLALGetFFTWThreads( expect_min_size );
+
+  /* Threaded plans may not be available, in which case all settings must be ignored */
+  int errnum = 0;
+  XLAL_TRY_SILENT( XLALSetFFTWThreads( 2, 0 ), errnum );
+  if ( errnum != 0 ) {
+    XLAL_CHECK( errnum == XLAL_EINVAL, XLAL_EFAILED, "XLALSetFFTWThreads() failed with unexpected error %i", errnum );
+    printf( "threaded FFTW plans are not available\n" );
+    expect_threads = 1;
+  }
+
+  printf( "LAL_FFTW_THREADS='%s' LAL_FFTW_THREADS_MIN_SIZE='%s': %i threads below and %i threads at size %" LAL_UINT8_FORMAT "\n",
+          getenv( "LAL_FFTW_THREADS" ) ? getenv( "LAL_FFTW_THREADS" ) : "", getenv( "LAL_FFTW_THREADS_MIN_SIZE" ) ? getenv( "LAL_FFTW_THREADS_MIN_SIZE" ) : "",
+          nthreads_below, nthreads_above, expect_min_size );
+  XLAL_CHECK( expect_min_size == 0 || nthreads_below == 1, XLAL_EFAILED, "Expected 1 thread below size %" LAL_UINT8_FORMAT ", got %i", expect_min_size, nthreads_below );
+  XLAL_CHECK( nthreads_above == expect_threads, XLAL_EFAILED, "Expected %i threads at size %" LAL_UINT8_FORMAT ", got %i", expect_threads, expect_min_size, nthreads_above );
+
+  return errnum == 0 ? 1 : 0;
+
+}
+
+static int test_threaded_plans( void )
+{
+
+  /* Random input data */
+  COMPLEX8Vector *c_in = XLALCreateCOMPLEX8Vector( FFT_SIZE );
+  XLAL_CHECK( c_in != NULL, XLAL_EFUNC );
+  REAL8Vector *r_in = XLALCreateREAL8Vector( FFT_SIZE );
+  XLAL_CHECK( r_in != NULL, XLAL_EFUNC );
+  srand( 4711 );
+  for ( UINT4 k = 0; k < FFT_SIZE; ++k ) {
+    c_in->data[k] = crectf( rand() / ( RAND_MAX + 1.0 ) - 0.5, rand() / ( RAND_MAX + 1.0 ) - 0.5 );
+    r_in->data[k] = rand() / ( RAND_MAX + 1.0 ) - 0.5;
+  }
+
+  /* Transform the data with unthreaded and threaded plans */
+  COMPLEX8Vector *c_out[2];
+  COMPLEX16Vector *r_out[2];
+  for ( int i = 0; i < 2; ++i ) {
+    const int nthreads = ( i == 0 ) ? 1 : FFT_THREADS;
+    XLAL_CHECK( XLALSetFFTWThreads( nthreads, FFT_SIZE ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALGetFFTWThreads( FFT_SIZE ) == nthreads, XLAL_EFAILED );
+
+    COMPLEX8FFTPlan *c_plan = XLALCreateForwardCOMPLEX8FFTPlan( FFT_SIZE, 0 );
+    XLAL_CHECK( c_plan != NULL, XLAL_EFUNC );
+    c_out[i] = XLALCreateCOMPLEX8Vector( FFT_SIZE );
+    XLAL_CHECK( c_out[i] != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALCOMPLEX8VectorFFT( c_out[i], c_in, c_plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyCOMPLEX8FFTPlan( c_plan );
+
+    REAL8FFTPlan *r_plan = XLALCreateForwardREAL8FFTPlan( FFT_SIZE, 0 );
+    XLAL_CHECK( r_plan != NULL, XLAL_EFUNC );
+    r_out[i] = XLALCreateCOMPLEX16Vector( FFT_SIZE / 2 + 1 );
+    XLAL_CHECK( r_out[i] != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALREAL8ForwardFFT( r_out[i], r_in, r_plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyREAL8FFTPlan( r_plan );
+  }
+
+  /* Threaded plans may use different algorithms, so their output need not
+     be bitwise identical; it must agree to within the rounding error */
+  REAL8 c_err = 0, c_norm = 0, r_err = 0, r_norm = 0;
+  for ( UINT4 k = 0; k < c_out[0]->length; ++k ) {
+    c_err += cabs( c_out[1]->data[k] - c_out[0]->data[k] ) * cabs( c_out[1]->data[k] - c_out[0]->data[k] );
+    c_norm += cabs( c_out[0]->data[k] ) * cabs( c_out[0]->data[k] );
+  }
+  for ( UINT4 k = 0; k < r_out[0]->length; ++k ) {
+    r_err += cabs( r_out[1]->data[k] - r_out[0]->data[k] ) * cabs( r_out[1]->data[k] - r_out[0]->data[k] );
+    r_norm += cabs( r_out[0]->data[k] ) * cabs( r_out[0]->data[k] );
+  }
+  c_err = sqrt( c_err / c_norm );
+  r_err = sqrt( r_err / r_norm );
+  XLAL_CHECK( c_err <= FFT_COMPLEX8_TOL, XLAL_EFAILED,
+              "Output of threaded COMPLEX8 plan differs from unthreaded plan: relative error %g > %g", c_err, FFT_COMPLEX8_TOL );
+  XLAL_CHECK( r_err <= FFT_REAL8_TOL, XLAL_EFAILED,
+              "Output of threaded REAL8 plan differs from unthreaded plan: relative error %g > %g", r_err, FFT_REAL8_TOL );
+  printf( "output of %i-thread plans of size %i agrees with unthreaded plans: relative error %g (COMPLEX8), %g (REAL8)\n", FFT_THREADS, FFT_SIZE, c_err, r_err );
+
+  /* Restore default settings */
+  XLAL_CHECK( XLALSetFFTWThreads( 1, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  XLALDestroyCOMPLEX8Vector( c_in );
+  XLALDestroyREAL8Vector( r_in );
+  for ( int i = 0; i < 2; ++i ) {
+    XLALDestroyCOMPLEX8Vector( c_out[i] );
+    XLALDestroyCOMPLEX16Vector( r_out[i] );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int main( int argc, char *argv[] )
+{
+
+  /* Parse command line */
+  XLAL_CHECK_MAIN( argc == 3, XLAL_EINVAL, "Usage: %s <threads> <min size>", argv[0] );
+  const int expect_threads = atoi( argv[1] );
+  const UINT8 expect_min_size = strtoull( argv[2], NULL, 10 );
+
+  /* Test settings read from the environment */
+  const int have_threads = test_env( expect_threads, expect_min_size );
+  XLAL_CHECK_MAIN( have_threads >= 0, XLAL_EFUNC );
+
+  /* Test output of threaded plans */
+  if ( have_threads ) {
+    XLAL_CHECK_MAIN( test_threaded_plans() == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  /* Check for memory leaks */
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,35 @@
+#!/bin/sh
+
+# check for FFTWThreadsTest
+fftw_threads_test="${LAL_TEST_BUILDDIR}/FFTWThreadsTest"
+if test ! -x ${fftw_threads_test}; then
+    echo "$0: could not execute ${fftw_threads_test}" >&2
+    exit 1
+fi
+
+# run FFTWThreadsTest with the given environment, and the settings it should read from it
+run_test() {
+    echo
+    echo "========== testing LAL_FFTW_THREADS='$1' LAL_FFTW_THREADS_MIN_SIZE='$2' =========="
+    LAL_FFTW_THREADS="$1"
+    LAL_FFTW_THREADS_MIN_SIZE="$2"
+    export LAL_FFTW_THREADS LAL_FFTW_THREADS_MIN_SIZE
+    ${fftw_threads_test} "$3" "$4" || exit 1
+    echo "---------- testing LAL_FFTW_THREADS='$1' LAL_FFTW_THREADS_MIN_SIZE='$2' ----------"
+    echo
+}
+
+# default settings
+run_test "" "" 1 65536
+
+# valid settings
+run_test 3 "" 3 65536
+run_test 2 1024 2 1024
+
+# invalid settings must be ignored
+for threads in 0 -2 4097 two 2x " "; do
+    run_test "${threads}" "" 1 65536
+done
+for min_size in 1k -1024 "1024 " none; do
+    run_test 2 "${min_size}" 2 65536
+done
@@ -93,6 +93,11 @@ void LALForwardRealDFT(
     REAL4Vector    *input
     );
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+static int
+TestBatch( UINT4 n, UINT4 howmany, UINT4 stride );
+#endif
+
 int main( int argc, char *argv[] )
 {
   static LALStatus status;
@@ -304,10 +309,113 @@ int main( int argc, char *argv[] )
     TestStatus( &status, CODES( 0 ), 1 );
   }
 
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+  /*
+   *
+   * Check batched transforms against single transforms, for
+   * consecutive and interleaved data layouts.
+   *
+   */
+  if ( TestBatch( 17, 5, 0 ) || TestBatch( 64, 5, 0 )
+       || TestBatch( 17, 5, 7 ) || TestBatch( 64, 3, 3 ) )
+  {
+    return 1;
+  }
+#endif
+
   LALCheckMemoryLeaks();
   return 0;
 }
 
+
+#if defined(LAL_FFTW3_ENABLED) && !defined(LAL_CUDA_ENABLED)
+/*
+ * TestBatch()
+ *
+ * Checks that howmany batched forward and reverse transforms of size n
+ * agree with the same transforms performed one at a time.  If stride is
+ * zero the transforms are consecutive vectors of a sequence, otherwise
+ * they are interleaved with the given stride.
+ *
+ */
+static int
+TestBatch( UINT4 n, UINT4 howmany, UINT4 stride )
+{
+  const UINT4 nc = n / 2 + 1;
+  const REAL8 eps = 1e-5;
+  REAL4FFTBatchPlan      *bfwd = XLALCreateREAL4FFTBatchPlan( n, howmany, stride, 1, 0 );
+  REAL4FFTBatchPlan      *brev = XLALCreateREAL4FFTBatchPlan( n, howmany, stride, 0, 0 );
+  REAL4FFTPlan           *fwd  = XLALCreateForwardREAL4FFTPlan( n, 0 );
+  REAL4FFTPlan           *rev  = XLALCreateReverseREAL4FFTPlan( n, 0 );
+  REAL4VectorSequence    *dat  = XLALCreateREAL4VectorSequence( stride ? n : howmany, stride ? stride : n );
+  REAL4VectorSequence    *ans  = XLALCreateREAL4VectorSequence( stride ? n : howmany, stride ? stride : n );
+  COMPLEX8VectorSequence *fft  = XLALCreateCOMPLEX8VectorSequence( stride ? nc : howmany, stride ? stride : nc );
+  REAL4Vector            *dat1 = XLALCreateREAL4Vector( n );
+  REAL4Vector            *ans1 = XLALCreateREAL4Vector( n );
+  COMPLEX8Vector         *fft1 = XLALCreateCOMPLEX8Vector( nc );
+  UINT4 j, k;
+
+  if ( !bfwd || !brev || !fwd || !rev || !dat || !ans || !fft || !dat1 || !ans1 || !fft1 )
+  {
+    fputs( "FAIL: Could not create batch test plans or sequences\n", stderr );
+    return 1;
+  }
+
+  srand( n + howmany + stride );
+  for ( k = 0; k < dat->length * dat->vectorLength; ++k )
+  {
+    dat->data[k] = 20.0 * rand() / (REAL4)( RAND_MAX + 1.0 ) - 10.0;
+  }
+
+  if ( XLALREAL4ForwardFFTBatch( fft, dat, bfwd ) != 0 || XLALREAL4ReverseFFTBatch( ans, fft, brev ) != 0 )
+  {
+    fputs( "FAIL: Error in batched transforms\n", stderr );
+    return 1;
+  }
+
+  for ( j = 0; j < howmany; ++j )
+  {
+    for ( k = 0; k < n; ++k )
+    {
+      dat1->data[k] = stride ? dat->data[k * stride + j] : dat->data[j * n + k];
+    }
+    XLALREAL4ForwardFFT( fft1, dat1, fwd );
+    XLALREAL4ReverseFFT( ans1, fft1, rev );
+    for ( k = 0; k < nc; ++k )
+    {
+      const COMPLEX8 z = stride ? fft->data[k * stride + j] : fft->data[j * nc + k];
+      if ( cabs( z - fft1->data[k] ) > eps * n * ( 1 + cabs( fft1->data[k] ) ) )
+      {
+        fprintf( stderr, "FAIL: Batched forward transform %u differs at %u\n", j, k );
+        return 1;
+      }
+    }
+    for ( k = 0; k < n; ++k )
+    {
+      const REAL4 x = stride ? ans->data[k * stride + j] : ans->data[j * n + k];
+      if ( fabs( x - ans1->data[k] ) > eps * n * ( 1 + fabs( ans1->data[k] ) ) )
+      {
+        fprintf( stderr, "FAIL: Batched reverse transform %u differs at %u\n", j, k );
+        return 1;
+      }
+    }
+  }
+
+  XLALDestroyREAL4FFTBatchPlan( bfwd );
+  XLALDestroyREAL4FFTBatchPlan( brev );
+  XLALDestroyREAL4FFTPlan( fwd );
+  XLALDestroyREAL4FFTPlan( rev );
+  XLALDestroyREAL4VectorSequence( dat );
+  XLALDestroyREAL4VectorSequence( ans );
+  XLALDestroyCOMPLEX8VectorSequence( fft );
+  XLALDestroyREAL4Vector( dat1 );
+  XLALDestroyREAL4Vector( ans1 );
+  XLALDestroyCOMPLEX8Vector( fft1 );
+
+  return 0;
+}
+#endif
+
 /*
  * TestStatus()
  *
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (C) 2026 Karl Wette
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALArena.h>
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  /* Arena allocations are aligned, distinct and survive further allocations */
+  {
+    LALArena *arena = XLALCreateArena( 4096 );
+    XLAL_CHECK_MAIN( arena != NULL, XLAL_EFUNC );
+    unsigned char *p[100];
+    for ( size_t i = 0; i < 100; ++i ) {
+      p[i] = XLALArenaAlloc( arena, 1 + 37 * i );
+      XLAL_CHECK_MAIN( p[i] != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( ( (uintptr_t) p[i] ) % 64 == 0, XLAL_EFAILED, "Allocation %zu is not aligned", i );
+      memset( p[i], (int) i, 1 + 37 * i );
+    }
+    for ( size_t i = 0; i < 100; ++i ) {
+      for ( size_t j = 0; j < 1 + 37 * i; ++j ) {
+        XLAL_CHECK_MAIN( p[i][j] == (unsigned char) i, XLAL_EFAILED, "Allocation %zu was overwritten", i );
+      }
+    }
+
+    /* An allocation larger than the block size gets its own block */
+    double *big = XLALArenaCalloc( arena, 10000, sizeof( *big ) );
+    XLAL_CHECK_MAIN( big != NULL, XLAL_EFUNC );
+    for ( size_t i = 0; i < 10000; ++i ) {
+      XLAL_CHECK_MAIN( big[i] == 0, XLAL_EFAILED, "Calloc memory is not zeroed" );
+    }
+
+    LALArenaStats stats;
+    XLAL_CHECK_MAIN( XLALArenaGetStats( arena, &stats ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( stats.numAllocs == 101, XLAL_EFAILED, "Arena counted %zu allocations", stats.numAllocs );
+    XLAL_CHECK_MAIN( stats.numBlocks > 1, XLAL_EFAILED, "Arena has %zu blocks", stats.numBlocks );
+    XLAL_CHECK_MAIN( stats.used <= stats.capacity && stats.peak == stats.used, XLAL_EFAILED, "Inconsistent arena statistics" );
+
+    /* Releasing to a mark reuses the memory allocated after it */
+    const size_t mark = XLALArenaMark( arena );
+    void *q = XLALArenaAlloc( arena, 1000 );
+    XLAL_CHECK_MAIN( q != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALArenaRelease( arena, mark ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALArenaMark( arena ) == mark, XLAL_EFAILED, "Release did not restore the mark" );
+    XLAL_CHECK_MAIN( XLALArenaAlloc( arena, 1000 ) == q, XLAL_EFAILED, "Release did not reuse memory" );
+
+    /* Resetting merges the blocks, after which the same allocations need no new blocks */
+    XLAL_CHECK_MAIN( XLALArenaGetStats( arena, &stats ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const size_t capacity = stats.capacity;
+    XLAL_CHECK_MAIN( XLALArenaReset( arena ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALArenaGetStats( arena, &stats ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( stats.numBlocks == 1 && stats.capacity == capacity && stats.used == 0 && stats.numResets == 1, XLAL_EFAILED, "Unexpected statistics after reset" );
+    for ( size_t i = 0; i < 100; ++i ) {
+      XLAL_CHECK_MAIN( XLALArenaAlloc( arena, 1 + 37 * i ) != NULL, XLAL_EFUNC );
+    }
+    XLAL_CHECK_MAIN( XLALArenaCalloc( arena, 10000, sizeof( *big ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALArenaGetStats( arena, &stats ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( stats.numBlocks == 1, XLAL_EFAILED, "Arena grew after reset" );
+
+    /* A mark beyond the end of the arena is an error */
+    int errnum;
+    XLAL_TRY_SILENT( XLALArenaRelease( arena, stats.used + 1 ), errnum );
+    XLAL_CHECK_MAIN( errnum == XLAL_EINVAL, XLAL_EFAILED, "Releasing to an invalid mark did not fail" );
+
+    XLALDestroyArena( arena );
+  }
+
+  /* Freed pool objects are reused by allocations of the same size class */
+  {
+    LALPoolStats stats0, stats;
+    XLAL_CHECK_MAIN( XLALPoolGetStats( &stats0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    void *p = XLALPoolMalloc( 40 );
+    XLAL_CHECK_MAIN( p != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( ( (uintptr_t) p ) % 16 == 0, XLAL_EFAILED, "Pool object is not aligned" );
+    memset( p, 0xff, 40 );
+    XLALPoolFree( p );
+    XLAL_CHECK_MAIN( XLALPoolMalloc( 48 ) == p, XLAL_EFAILED, "Pool did not reuse freed object" );
+    XLALPoolFree( p );
+    int *z = XLALPoolCalloc( 10, sizeof( *z ) );
+    XLAL_CHECK_MAIN( z != NULL, XLAL_EFUNC );
+    for ( size_t i = 0; i < 10; ++i ) {
+      XLAL_CHECK_MAIN( z[i] == 0, XLAL_EFAILED, "Pool calloc memory is not zeroed" );
+    }
+    XLALPoolFree( z );
+
+    /* Large objects bypass the free lists */
+    char *big = XLALPoolMalloc( 2 * LAL_POOL_MAX_SIZE );
+    XLAL_CHECK_MAIN( big != NULL, XLAL_EFUNC );
+    memset( big, 0, 2 * LAL_POOL_MAX_SIZE );
+    XLALPoolFree( big );
+
+    XLAL_CHECK_MAIN( XLALPoolGetStats( &stats ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( stats.numAllocs - stats0.numAllocs == 4, XLAL_EFAILED, "Pool counted %zu allocations", stats.numAllocs - stats0.numAllocs );
+    XLAL_CHECK_MAIN( stats.numFrees - stats0.numFrees == 4, XLAL_EFAILED, "Pool counted %zu frees", stats.numFrees - stats0.numFrees );
+    XLAL_CHECK_MAIN( stats.numReused - stats0.numReused >= 1, XLAL_EFAILED, "Pool did not count reuse" );
+    XLAL_CHECK_MAIN( stats.numCached > 0 && stats.cachedBytes >= 48, XLAL_EFAILED, "Pool did not count cached objects" );
+
+    XLALPoolTrim();
+    XLAL_CHECK_MAIN( XLALPoolGetStats( &stats ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( stats.numCached == 0 && stats.cachedBytes == 0, XLAL_EFAILED, "Pool trim did not empty the free lists" );
+  }
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -294,6 +294,43 @@ static int testAllocList( void )
   return 0;
 }
 
+/* test the per-call-site memory statistics */
+static int testStatistics( void )
+{
+  int keep = lalDebugLevel;
+
+  XLALClobberDebugLevel(LALMEMSTAT);
+
+  /* statistics alone detect leaks */
+  trial( LALCheckMemoryLeaks(), 0, "" );
+  trial( p = LALMalloc( 2 * sizeof( *p ) ), 0, "" );
+  trial( q = LALCalloc( 4, sizeof( *q ) ), 0, "" );
+  for ( i = 0; i < 4; ++i ) if ( q[i] ) die( calloc memory not zeroed );
+  if ( lalMallocTotal != 6 * sizeof( *p ) ) die( wrong total );
+  trial( p = LALRealloc( p, 8 * sizeof( *p ) ), 0, "" );
+  if ( lalMallocTotal != 12 * sizeof( *p ) ) die( wrong total after realloc );
+  trial( LALFree( q ), 0, "" );
+  trial( LALCheckMemoryLeaks(), SIGSEGV, "memory leak" );
+  XLALPrintMemoryStatistics();
+  trial( LALFree( p ), 0, "" );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+
+  /* statistics combined with padding */
+  XLALClobberDebugLevel(LALMEMDBGBIT | LALMEMPADBIT | LALMEMSTATBIT);
+  trial( p = LALMalloc( 2 * sizeof( *p ) ), 0, "" );
+  trial( p = LALRealloc( p, 16 * sizeof( *p ) ), 0, "" );
+  if ( p[-1] != 0xABadCafe || p[-2] != 16 * sizeof( *p ) ) die( wrong padding prefix );
+  n = p[16];
+  p[16] = 0;
+  trial( LALFree( p ), SIGSEGV, "error: array bounds overwritten" );
+  p[16] = n;
+  trial( LALFree( p ), 0, "" );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+
+  XLALClobberDebugLevel(keep);
+  return 0;
+}
+
 /* stress test the realloc routine */
 static int stressTestRealloc( void )
 {
@@ -356,6 +393,7 @@ int main( void )
   if ( testOK() ) return 1;
   if ( testPadding() ) return 1;
   if ( testAllocList() ) return 1;
+  if ( testStatistics() ) return 1;
   if ( stressTestRealloc() ) return 1;
 
   trial( LALCheckMemoryLeaks(), 0, "" );
@@ -0,0 +1,281 @@
+/*
+ *  Copyright (C) 2026 Jolien Creighton
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
+#include <lal/ZPGFilter.h>
+#include <lal/IIRFilter.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/BandPassTimeSeries.h>
+
+/* create a Butterworth low-pass filter of the given order in the z-plane */
+static COMPLEX16ZPGFilter *create_butterworth( INT4 order, REAL8 wc )
+{
+  COMPLEX16ZPGFilter *zpg = XLALCreateCOMPLEX16ZPGFilter( 0, order );
+  XLAL_CHECK_NULL( zpg != NULL, XLAL_EFUNC );
+  zpg->gain = 1.0;
+  for ( INT4 k = 0; k < order; ++k ) {
+    const REAL8 theta = LAL_PI * ( k + 0.5 ) / order;
+    zpg->poles->data[k] = wc * cos( theta ) + I * wc * sin( theta );
+    zpg->gain *= -I * wc;
+  }
+  /* the pole on the imaginary axis must be exactly imaginary */
+  if ( order % 2 ) {
+    zpg->poles->data[order / 2] = I * wc;
+  }
+  XLAL_CHECK_NULL( XLALWToZCOMPLEX16ZPGFilter( zpg ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return zpg;
+}
+
+/*
+ * zero-phase Butterworth filtering of the given order, characteristic frequency
+ * and type (1 = low-pass, 2 = high-pass), as done by XLALButterworthREAL8TimeSeries()
+ * before it used SOS filters: each pair of poles, and any single pole, is applied as
+ * a direct-form IIR filter forwards and then in reverse
+ */
+static int butterworth_direct_form( REAL8Vector *data, INT4 n, REAL8 wc, INT4 type )
+{
+  for ( INT4 i = 0, j = n - 1; i <= j; ++i, --j ) {
+    const INT4 order = ( i < j ) ? 2 : 1;
+    COMPLEX16ZPGFilter *zpg = XLALCreateCOMPLEX16ZPGFilter( type == 2 ? order : 0, order );
+    XLAL_CHECK( zpg != NULL, XLAL_EFUNC );
+    if ( order == 2 ) {
+      const REAL8 theta = LAL_PI * ( i + 0.5 ) / n;
+      const REAL8 ar = wc * cos( theta );
+      const REAL8 ai = wc * sin( theta );
+      if ( type == 2 ) {
+        zpg->zeros->data[0] = zpg->zeros->data[1] = 0.0;
+        zpg->gain = 1.0;
+      } else {
+        zpg->gain = -wc * wc;
+      }
+      zpg->poles->data[0] = ar + I * ai;
+      zpg->poles->data[1] = -ar + I * ai;
+    } else {
+      if ( type == 2 ) {
+        zpg->zeros->data[0] = 0.0;
+        zpg->gain = 1.0;
+      } else {
+        zpg->gain = -I * wc;
+      }
+      zpg->poles->data[0] = I * wc;
+    }
+    XLAL_CHECK( XLALWToZCOMPLEX16ZPGFilter( zpg ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL8IIRFilter *iir = XLALCreateREAL8IIRFilter( zpg );
+    XLAL_CHECK( iir != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALIIRFilterREAL8Vector( data, iir ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALIIRFilterReverseREAL8Vector( data, iir ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyREAL8IIRFilter( iir );
+    XLALDestroyCOMPLEX16ZPGFilter( zpg );
+  }
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  const UINT4 length = 4096;
+  const UINT4 nchan = 11;
+  const UINT4 split = 1000;
+
+  /* Create a low-order filter, for which the direct-form IIR filter is accurate */
+  COMPLEX16ZPGFilter *zpg = create_butterworth( 5, tan( LAL_PI * 0.05 ) );
+  XLAL_CHECK_MAIN( zpg != NULL, XLAL_EFUNC );
+  REAL8IIRFilter *iir = XLALCreateREAL8IIRFilter( zpg );
+  XLAL_CHECK_MAIN( iir != NULL, XLAL_EFUNC );
+  REAL8SOSFilter *sos = XLALCreateREAL8SOSFilter( zpg, 1 );
+  XLAL_CHECK_MAIN( sos != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( sos->numSections == 3, XLAL_EFAILED, "Filter has %u sections, not 3", sos->numSections );
+  REAL8SOSFilter *sosmulti = XLALCreateREAL8SOSFilter( zpg, nchan );
+  XLAL_CHECK_MAIN( sosmulti != NULL, XLAL_EFUNC );
+
+  /* Create random input data */
+  REAL8VectorSequence *input = XLALCreateREAL8VectorSequence( nchan, length );
+  XLAL_CHECK_MAIN( input != NULL, XLAL_EFUNC );
+  srand( 1 );
+  for ( UINT4 i = 0; i < nchan * length; ++i ) {
+    input->data[i] = ( REAL8 ) rand() / RAND_MAX - 0.5;
+  }
+
+  /* Filter each channel with the IIR filter and the single-channel SOS filter */
+  REAL8VectorSequence *iirout = XLALCreateREAL8VectorSequence( nchan, length );
+  XLAL_CHECK_MAIN( iirout != NULL, XLAL_EFUNC );
+  REAL8VectorSequence *sosout = XLALCreateREAL8VectorSequence( nchan, length );
+  XLAL_CHECK_MAIN( sosout != NULL, XLAL_EFUNC );
+  memcpy( iirout->data, input->data, nchan * length * sizeof( *input->data ) );
+  memcpy( sosout->data, input->data, nchan * length * sizeof( *input->data ) );
+  for ( UINT4 c = 0; c < nchan; ++c ) {
+    REAL8Vector v = { .length = length, .data = iirout->data + c * length };
+    memset( iir->history->data, 0, iir->history->length * sizeof( *iir->history->data ) );
+    XLAL_CHECK_MAIN( XLALIIRFilterREAL8Vector( &v, iir ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL8Vector w = { .length = length, .data = sosout->data + c * length };
+    XLAL_CHECK_MAIN( XLALResetREAL8SOSFilter( sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALSOSFilterREAL8Vector( &w, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  REAL8 maxerr = 0;
+  for ( UINT4 i = 0; i < nchan * length; ++i ) {
+    maxerr = fmax( maxerr, fabs( iirout->data[i] - sosout->data[i] ) );
+  }
+  printf( "SOS vs. IIR filter: max error = %g\n", maxerr );
+  XLAL_CHECK_MAIN( maxerr < 1e-9, XLAL_ETOL, "SOS and IIR filters disagree" );
+
+  /* Filter all channels at once, in two parts to check the history */
+  REAL8VectorSequence *multiout = XLALCreateREAL8VectorSequence( nchan, length );
+  XLAL_CHECK_MAIN( multiout != NULL, XLAL_EFUNC );
+  memcpy( multiout->data, input->data, nchan * length * sizeof( *input->data ) );
+  {
+    REAL8VectorSequence part = { .length = nchan, .vectorLength = length, .data = multiout->data };
+    REAL8VectorSequence *tmp = XLALCreateREAL8VectorSequence( nchan, split );
+    XLAL_CHECK_MAIN( tmp != NULL, XLAL_EFUNC );
+    for ( UINT4 c = 0; c < nchan; ++c ) {
+      memcpy( tmp->data + c * split, part.data + c * length, split * sizeof( *tmp->data ) );
+    }
+    XLAL_CHECK_MAIN( XLALSOSFilterREAL8VectorSequence( tmp, sosmulti ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 c = 0; c < nchan; ++c ) {
+      memcpy( part.data + c * length, tmp->data + c * split, split * sizeof( *tmp->data ) );
+    }
+    XLALDestroyREAL8VectorSequence( tmp );
+    tmp = XLALCreateREAL8VectorSequence( nchan, length - split );
+    XLAL_CHECK_MAIN( tmp != NULL, XLAL_EFUNC );
+    for ( UINT4 c = 0; c < nchan; ++c ) {
+      memcpy( tmp->data + c * ( length - split ), part.data + c * length + split, ( length - split ) * sizeof( *tmp->data ) );
+    }
+    XLAL_CHECK_MAIN( XLALSOSFilterREAL8VectorSequence( tmp, sosmulti ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 c = 0; c < nchan; ++c ) {
+      memcpy( part.data + c * length + split, tmp->data + c * ( length - split ), ( length - split ) * sizeof( *tmp->data ) );
+    }
+    XLALDestroyREAL8VectorSequence( tmp );
+  }
+  for ( UINT4 i = 0; i < nchan * length; ++i ) {
+    XLAL_CHECK_MAIN( multiout->data[i] == sosout->data[i], XLAL_ETOL, "Multichannel SOS filter disagrees at %u", i );
+  }
+  printf( "Multichannel SOS filter agrees with single-channel SOS filter\n" );
+
+  /* Zero-phase filtering must agree with forward and reverse IIR filtering */
+  memcpy( iirout->data, input->data, nchan * length * sizeof( *input->data ) );
+  memcpy( sosout->data, input->data, nchan * length * sizeof( *input->data ) );
+  for ( UINT4 c = 0; c < nchan; ++c ) {
+    REAL8Vector v = { .length = length, .data = iirout->data + c * length };
+    memset( iir->history->data, 0, iir->history->length * sizeof( *iir->history->data ) );
+    XLAL_CHECK_MAIN( XLALIIRFilterREAL8Vector( &v, iir ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALIIRFilterReverseREAL8Vector( &v, iir ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLAL_CHECK_MAIN( XLALSOSFilterZeroPhaseREAL8VectorSequence( sosout, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  maxerr = 0;
+  for ( UINT4 i = 0; i < nchan * length; ++i ) {
+    maxerr = fmax( maxerr, fabs( iirout->data[i] - sosout->data[i] ) );
+  }
+  printf( "Zero-phase SOS vs. IIR filter: max error = %g\n", maxerr );
+  XLAL_CHECK_MAIN( maxerr < 1e-9, XLAL_ETOL, "Zero-phase SOS and IIR filters disagree" );
+
+  /* Complex zero-phase filtering must filter the real and imaginary parts */
+  {
+    COMPLEX16Vector *cdata = XLALCreateCOMPLEX16Vector( length );
+    XLAL_CHECK_MAIN( cdata != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < length; ++i ) {
+      cdata->data[i] = input->data[i] + I * input->data[length + i];
+    }
+    XLAL_CHECK_MAIN( XLALSOSFilterZeroPhaseCOMPLEX16Vector( cdata, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < length; ++i ) {
+      XLAL_CHECK_MAIN( creal( cdata->data[i] ) == sosout->data[i] && cimag( cdata->data[i] ) == sosout->data[length + i], XLAL_ETOL, "Complex zero-phase SOS filter disagrees at %u", i );
+    }
+    XLALDestroyCOMPLEX16Vector( cdata );
+  }
+  printf( "Complex zero-phase SOS filter agrees with real zero-phase SOS filter\n" );
+
+  /* A high-order filter must remain stable as a cascade of sections */
+  {
+    COMPLEX16ZPGFilter *zpghigh = create_butterworth( 20, tan( LAL_PI * 0.01 ) );
+    XLAL_CHECK_MAIN( zpghigh != NULL, XLAL_EFUNC );
+    REAL8SOSFilter *soshigh = XLALCreateREAL8SOSFilter( zpghigh, 1 );
+    XLAL_CHECK_MAIN( soshigh != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( soshigh->numSections == 10, XLAL_EFAILED, "Filter has %u sections, not 10", soshigh->numSections );
+    REAL8Vector *step = XLALCreateREAL8Vector( 20 * length );
+    XLAL_CHECK_MAIN( step != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < step->length; ++i ) {
+      step->data[i] = 1.0;
+    }
+    XLAL_CHECK_MAIN( XLALSOSFilterREAL8Vector( step, soshigh ) == XLAL_SUCCESS, XLAL_EFUNC );
+    printf( "Step response of order-20 SOS filter: final value = %.12f\n", step->data[step->length - 1] );
+    XLAL_CHECK_MAIN( fabs( step->data[step->length - 1] - 1.0 ) < 1e-6, XLAL_ETOL, "Order-20 SOS filter has wrong DC response" );
+    XLALDestroyREAL8Vector( step );
+    XLALDestroyREAL8SOSFilter( soshigh );
+    XLALDestroyCOMPLEX16ZPGFilter( zpghigh );
+  }
+
+  /* Butterworth filtering must agree with its previous direct-form IIR implementation */
+  {
+    const REAL8 deltaT = 1.0 / 1024;
+    const REAL8 freq = 100;
+    const REAL8 amp = 0.9;
+    const LIGOTimeGPS epoch = LIGOTIMEGPSZERO;
+    const INT4 orders[2] = { 8, 7 };
+    for ( INT4 type = 1; type <= 2; ++type ) {
+      const INT4 n = orders[type - 1];
+      REAL8TimeSeries *series = XLALCreateREAL8TimeSeries( "series", &epoch, 0, deltaT, &lalDimensionlessUnit, length );
+      XLAL_CHECK_MAIN( series != NULL, XLAL_EFUNC );
+      REAL8Vector *ref = XLALCreateREAL8Vector( length );
+      XLAL_CHECK_MAIN( ref != NULL, XLAL_EFUNC );
+      memcpy( series->data->data, input->data, length * sizeof( *input->data ) );
+      memcpy( ref->data, input->data, length * sizeof( *input->data ) );
+      REAL8 wc;
+      if ( type == 1 ) {
+        XLAL_CHECK_MAIN( XLALLowPassREAL8TimeSeries( series, freq, amp, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+        wc = tan( LAL_PI * freq * deltaT ) * pow( 1.0 / sqrt( amp ) - 1.0, -0.5 / n );
+      } else {
+        XLAL_CHECK_MAIN( XLALHighPassREAL8TimeSeries( series, freq, amp, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+        wc = tan( LAL_PI * freq * deltaT ) * pow( 1.0 / sqrt( amp ) - 1.0, 0.5 / n );
+      }
+      XLAL_CHECK_MAIN( butterworth_direct_form( ref, n, wc, type ) == XLAL_SUCCESS, XLAL_EFUNC );
+      maxerr = 0;
+      for ( UINT4 i = 0; i < length; ++i ) {
+        maxerr = fmax( maxerr, fabs( series->data->data[i] - ref->data[i] ) );
+      }
+      printf( "Order-%d %s-pass Butterworth vs. direct-form IIR filter: max error = %g\n", n, type == 1 ? "low" : "high", maxerr );
+      XLAL_CHECK_MAIN( maxerr < 1e-9, XLAL_ETOL, "Butterworth filter disagrees with direct-form IIR filter" );
+      XLALDestroyREAL8Vector( ref );
+      XLALDestroyREAL8TimeSeries( series );
+    }
+  }
+
+  /* Cleanup */
+  XLALDestroyREAL8VectorSequence( multiout );
+  XLALDestroyREAL8VectorSequence( sosout );
+  XLALDestroyREAL8VectorSequence( iirout );
+  XLALDestroyREAL8VectorSequence( input );
+  XLALDestroyREAL8SOSFilter( sosmulti );
+  XLALDestroyREAL8SOSFilter( sos );
+  XLALDestroyREAL8IIRFilter( iir );
+  XLALDestroyCOMPLEX16ZPGFilter( zpg );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
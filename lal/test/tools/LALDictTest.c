@@ -0,0 +1,139 @@
+/*
+ *  Copyright (C) 2026 Jolien Creighton
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/LALDict.h>
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  LALDict *dict = XLALCreateDict();
+  XLAL_CHECK_MAIN( dict != NULL, XLAL_EFUNC );
+
+  /* Values of every type round-trip */
+  XLAL_CHECK_MAIN( XLALDictInsertINT4Value( dict, "int4", -7 ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALDictInsertUINT8Value( dict, "uint8", 123456789012345ULL ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALDictInsertREAL8Value( dict, "real8", 2.5 ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALDictInsertCOMPLEX16Value( dict, "complex16", crect( 1.0, -2.0 ) ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALDictInsertStringValue( dict, "string", "a string too long to be stored inline" ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALDictLookupINT4Value( dict, "int4" ) == -7, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALDictLookupUINT8Value( dict, "uint8" ) == 123456789012345ULL, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALDictLookupREAL8Value( dict, "real8" ) == 2.5, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALDictLookupCOMPLEX16Value( dict, "complex16" ) == crect( 1.0, -2.0 ), XLAL_EFAILED );
+  XLAL_CHECK_MAIN( strcmp( XLALDictLookupStringValue( dict, "string" ), "a string too long to be stored inline" ) == 0, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALDictSize( dict ) == 5, XLAL_EFAILED );
+
+  /* Replacing a value may change its size and type */
+  XLAL_CHECK_MAIN( XLALDictInsertStringValue( dict, "real8", "now a long string value" ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( strcmp( XLALDictLookupStringValue( dict, "real8" ), "now a long string value" ) == 0, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALDictInsertREAL8Value( dict, "string", 4.0 ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALDictLookupREAL8Value( dict, "string" ) == 4.0, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALDictSize( dict ) == 5, XLAL_EFAILED );
+
+  /* Errors leave the dictionary unchanged */
+  {
+    int errnum;
+    const INT4 bad = 1;
+    XLAL_TRY_SILENT( XLALDictInsert( dict, "int4", &bad, sizeof( bad ), LAL_D_TYPE_CODE ), errnum );
+    XLAL_CHECK_MAIN( errnum != 0, XLAL_EFAILED, "Inserting a value of the wrong size did not fail" );
+    XLAL_CHECK_MAIN( XLALDictLookupINT4Value( dict, "int4" ) == -7, XLAL_EFAILED );
+    XLAL_TRY_SILENT( XLALDictInsertINT4Value( dict, "a key name that is far too long to be valid", 1 ), errnum );
+    XLAL_CHECK_MAIN( errnum != 0, XLAL_EFAILED, "Inserting a long key name did not fail" );
+    XLAL_CHECK_MAIN( XLALDictSize( dict ) == 5, XLAL_EFAILED );
+  }
+
+  /* Many entries, with removals, force the table to grow and reuse deleted slots */
+  for ( int i = 0; i < 1000; ++i ) {
+    char key[32];
+    snprintf( key, sizeof( key ), "key%d", i );
+    XLAL_CHECK_MAIN( XLALDictInsertINT4Value( dict, key, i ) == 0, XLAL_EFUNC );
+  }
+  for ( int i = 0; i < 1000; i += 2 ) {
+    char key[32];
+    snprintf( key, sizeof( key ), "key%d", i );
+    XLAL_CHECK_MAIN( XLALDictRemove( dict, key ) == 0, XLAL_EFAILED );
+  }
+  XLAL_CHECK_MAIN( XLALDictRemove( dict, "key0" ) == -1, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( XLALDictSize( dict ) == 505, XLAL_EFAILED );
+  for ( int i = 0; i < 1000; ++i ) {
+    char key[32];
+    snprintf( key, sizeof( key ), "key%d", i );
+    XLAL_CHECK_MAIN( XLALDictContains( dict, key ) == i % 2, XLAL_EFAILED, "Wrong membership of %s", key );
+    if ( i % 2 ) {
+      XLAL_CHECK_MAIN( XLALDictLookupINT4Value( dict, key ) == i, XLAL_EFAILED );
+    }
+  }
+
+  /* Iteration visits every entry once */
+  {
+    LALDictIter iter;
+    LALDictEntry *entry;
+    size_t n = 0;
+    INT8 sum = 0;
+    XLALDictIterInit( &iter, dict );
+    while ( ( entry = XLALDictIterNext( &iter ) ) != NULL ) {
+      if ( strncmp( XLALDictEntryGetKey( entry ), "key", 3 ) == 0 ) {
+        sum += XLALValueGetINT4( XLALDictEntryGetValue( entry ) );
+      }
+      ++n;
+    }
+    XLAL_CHECK_MAIN( n == 505 && sum == 250000, XLAL_EFAILED, "Iteration visited %zu entries with sum %" LAL_INT8_FORMAT, n, sum );
+  }
+
+  /* A duplicate is independent of the original */
+  {
+    LALDict *copy = XLALDictDuplicate( dict );
+    XLAL_CHECK_MAIN( copy != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALDictSize( copy ) == 505, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( strcmp( XLALDictLookupStringValue( copy, "real8" ), "now a long string value" ) == 0, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( XLALDictInsertINT4Value( copy, "key1", 0 ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALDictLookupINT4Value( dict, "key1" ) == 1, XLAL_EFAILED );
+    XLALDestroyDict( copy );
+  }
+
+  /* Precomputed keys agree with string keys */
+  {
+    static LALDictKey key = LAL_DICT_KEY_INIT( "int4" );
+    static LALDictKey newkey = LAL_DICT_KEY_INIT( "newkey" );
+    for ( int i = 0; i < 2; ++i ) {
+      XLAL_CHECK_MAIN( XLALDictContainsByKey( dict, &key ) == 1, XLAL_EFAILED );
+      XLAL_CHECK_MAIN( XLALDictLookupINT4ValueByKey( dict, &key ) == -7, XLAL_EFAILED );
+      XLAL_CHECK_MAIN( XLALDictContainsByKey( dict, &newkey ) == 0, XLAL_EFAILED );
+    }
+    XLAL_CHECK_MAIN( XLALDictInsertREAL8ValueByKey( dict, &newkey, 3.0 ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALDictLookupREAL8Value( dict, "newkey" ) == 3.0, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( XLALDictInsertREAL8Value( dict, "newkey", 6.0 ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALDictLookupREAL8ValueByKey( dict, &newkey ) == 6.0, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( XLALDictSize( dict ) == 506, XLAL_EFAILED );
+    XLAL_CHECK_MAIN( XLALDictLookupByKey( dict, &newkey ) == XLALDictLookup( dict, "newkey" ), XLAL_EFAILED );
+  }
+
+  XLALDestroyDict( dict );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
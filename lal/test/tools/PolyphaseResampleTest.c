@@ -0,0 +1,178 @@
+/*
+ *  Copyright (C) 2026 Jolien Creighton
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/Date.h>
+#include <lal/SeqFactories.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/ResampleTimeSeries.h>
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  const REAL8 srate = 16384;
+  const UINT4 length = 65536;
+  const UINT4 nchan = 5;
+  const UINT4 edge = 500;
+
+  /* Input: an in-band tone plus a tone above the output Nyquist frequency */
+  REAL8VectorSequence *input = XLALCreateREAL8VectorSequence( nchan, length );
+  XLAL_CHECK_MAIN( input != NULL, XLAL_EFUNC );
+  for ( UINT4 c = 0; c < nchan; ++c ) {
+    for ( UINT4 i = 0; i < length; ++i ) {
+      input->data[c * length + i] = sin( LAL_TWOPI * 100.0 * ( c + 1 ) * i / srate ) + 0.3 * sin( LAL_TWOPI * 5000.0 * i / srate );
+    }
+  }
+
+  /* Resampling a stream in chunks of random length must give the same output as all at once */
+  PolyphaseResampler *whole = XLALCreatePolyphaseResampler( 3, 8, nchan, 0, 0 );
+  XLAL_CHECK_MAIN( whole != NULL, XLAL_EFUNC );
+  PolyphaseResampler *chunked = XLALCreatePolyphaseResampler( 6, 16, nchan, 0, 0 );
+  XLAL_CHECK_MAIN( chunked != NULL, XLAL_EFUNC );
+  const UINT4 outlen = XLALPolyphaseResamplerOutputLength( whole, length );
+  XLAL_CHECK_MAIN( outlen == length * 3 / 8, XLAL_EFAILED, "Output length %u, expected %u", outlen, length * 3 / 8 );
+  REAL8VectorSequence *wholeout = XLALCreateREAL8VectorSequence( nchan, outlen );
+  XLAL_CHECK_MAIN( wholeout != NULL, XLAL_EFUNC );
+  REAL8VectorSequence *chunkout = XLALCreateREAL8VectorSequence( nchan, outlen );
+  XLAL_CHECK_MAIN( chunkout != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALPolyphaseResampleREAL8VectorSequence( wholeout, input, whole ) == (int)outlen, XLAL_EFUNC );
+  {
+    REAL8VectorSequence *in = XLALCreateREAL8VectorSequence( nchan, 1000 );
+    XLAL_CHECK_MAIN( in != NULL, XLAL_EFUNC );
+    REAL8VectorSequence *out = XLALCreateREAL8VectorSequence( nchan, 1000 );
+    XLAL_CHECK_MAIN( out != NULL, XLAL_EFUNC );
+    UINT4 inpos = 0, outpos = 0;
+    srand( 1 );
+    while ( inpos < length ) {
+      UINT4 n = 1 + rand() % 1000;
+      if ( n > length - inpos ) {
+        n = length - inpos;
+      }
+      in->vectorLength = n;
+      for ( UINT4 c = 0; c < nchan; ++c ) {
+        for ( UINT4 i = 0; i < n; ++i ) {
+          in->data[c * n + i] = input->data[c * length + inpos + i];
+        }
+      }
+      const UINT4 expected = XLALPolyphaseResamplerOutputLength( chunked, n );
+      XLAL_CHECK_MAIN( XLALPolyphaseResampleREAL8VectorSequence( out, in, chunked ) == (int)expected, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( outpos + expected <= outlen, XLAL_EFAILED, "Too many output samples" );
+      for ( UINT4 c = 0; c < nchan; ++c ) {
+        for ( UINT4 i = 0; i < expected; ++i ) {
+          chunkout->data[c * outlen + outpos + i] = out->data[c * out->vectorLength + i];
+        }
+      }
+      inpos += n;
+      outpos += expected;
+    }
+    XLAL_CHECK_MAIN( outpos == outlen, XLAL_EFAILED, "Chunked resampling gave %u samples, not %u", outpos, outlen );
+    XLALDestroyREAL8VectorSequence( out );
+    XLALDestroyREAL8VectorSequence( in );
+  }
+  for ( UINT4 i = 0; i < nchan * outlen; ++i ) {
+    XLAL_CHECK_MAIN( wholeout->data[i] == chunkout->data[i], XLAL_ETOL, "Chunked and whole resampling disagree at %u", i );
+  }
+
+  /* Single-channel and single-precision resampling must agree with the multi-channel output */
+  {
+    PolyphaseResampler *single = XLALCreatePolyphaseResampler( 3, 8, 1, 0, 0 );
+    XLAL_CHECK_MAIN( single != NULL, XLAL_EFUNC );
+    REAL8Vector in8 = { length, input->data + length };
+    REAL8Vector *out8 = XLALCreateREAL8Vector( outlen );
+    XLAL_CHECK_MAIN( out8 != NULL, XLAL_EFUNC );
+    REAL4Vector *in4 = XLALCreateREAL4Vector( length );
+    XLAL_CHECK_MAIN( in4 != NULL, XLAL_EFUNC );
+    REAL4Vector *out4 = XLALCreateREAL4Vector( outlen );
+    XLAL_CHECK_MAIN( out4 != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < length; ++i ) {
+      in4->data[i] = in8.data[i];
+    }
+    XLAL_CHECK_MAIN( XLALPolyphaseResampleREAL8Vector( out8, &in8, single ) == (int)outlen, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALResetPolyphaseResampler( single ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALPolyphaseResampleREAL4Vector( out4, in4, single ) == (int)outlen, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < outlen; ++i ) {
+      XLAL_CHECK_MAIN( out8->data[i] == wholeout->data[outlen + i], XLAL_ETOL, "Single-channel resampling disagrees at %u", i );
+      XLAL_CHECK_MAIN( fabs( out4->data[i] - out8->data[i] ) < 1e-5, XLAL_ETOL, "Single-precision resampling disagrees at %u", i );
+    }
+    XLALDestroyREAL4Vector( out4 );
+    XLALDestroyREAL4Vector( in4 );
+    XLALDestroyREAL8Vector( out8 );
+    XLALDestroyPolyphaseResampler( single );
+  }
+
+  /* The output is the delayed in-band tone with the out-of-band tone removed */
+  {
+    const REAL8 delay = XLALPolyphaseResamplerDelay( whole );
+    XLAL_CHECK_MAIN( fabs( delay - 80.0 / 3.0 ) < 1e-12, XLAL_EFAILED, "Group delay is %g samples", delay );
+    REAL8 maxerr = 0;
+    for ( UINT4 c = 0; c < nchan; ++c ) {
+      for ( UINT4 i = edge; i < outlen; ++i ) {
+        const REAL8 t = i * 8.0 / ( 3.0 * srate ) - delay / srate;
+        maxerr = fmax( maxerr, fabs( wholeout->data[c * outlen + i] - sin( LAL_TWOPI * 100.0 * ( c + 1 ) * t ) ) );
+      }
+    }
+    XLAL_CHECK_MAIN( maxerr < 1e-2, XLAL_ETOL, "Resampled tone has error %g", maxerr );
+  }
+
+  /* Whole time series are resampled in place with no time shift */
+  {
+    const LIGOTimeGPS epoch = { 1000000000, 0 };
+    REAL8TimeSeries *series = XLALCreateREAL8TimeSeries( "test", &epoch, 0.0, 1.0 / srate, &lalDimensionlessUnit, length );
+    XLAL_CHECK_MAIN( series != NULL, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < length; ++i ) {
+      series->data->data[i] = input->data[i];
+    }
+    XLAL_CHECK_MAIN( XLALResampleREAL8TimeSeriesPolyphase( series, 4.0 / ( 5.0 * srate ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( series->data->length == length * 5 / 4, XLAL_EFAILED, "Upsampled length %u", series->data->length );
+    REAL8 maxerr = 0;
+    for ( UINT4 i = edge; i + edge < series->data->length; ++i ) {
+      maxerr = fmax( maxerr, fabs( series->data->data[i] - sin( LAL_TWOPI * 100.0 * i * series->deltaT ) - 0.3 * sin( LAL_TWOPI * 5000.0 * i * series->deltaT ) ) );
+    }
+    XLAL_CHECK_MAIN( maxerr < 1e-2, XLAL_ETOL, "Upsampled series has error %g", maxerr );
+    XLAL_CHECK_MAIN( XLALResampleREAL8TimeSeriesPolyphase( series, 1.0 / 6144 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( series->data->length == length * 3 / 8, XLAL_EFAILED, "Downsampled length %u", series->data->length );
+    XLAL_CHECK_MAIN( XLALGPSCmp( &series->epoch, &epoch ) == 0, XLAL_EFAILED, "Epoch changed" );
+    maxerr = 0;
+    for ( UINT4 i = edge; i + edge < series->data->length; ++i ) {
+      maxerr = fmax( maxerr, fabs( series->data->data[i] - sin( LAL_TWOPI * 100.0 * i * series->deltaT ) ) );
+    }
+    XLAL_CHECK_MAIN( maxerr < 1e-2, XLAL_ETOL, "Downsampled series has error %g", maxerr );
+    XLALDestroyREAL8TimeSeries( series );
+  }
+
+  /* Cleanup */
+  XLALDestroyREAL8VectorSequence( chunkout );
+  XLALDestroyREAL8VectorSequence( wholeout );
+  XLALDestroyREAL8VectorSequence( input );
+  XLALDestroyPolyphaseResampler( chunked );
+  XLALDestroyPolyphaseResampler( whole );
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
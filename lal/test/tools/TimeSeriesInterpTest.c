@@ -24,6 +24,7 @@
 
 #include <lal/Date.h>
 #include <lal/LALDatatypes.h>
+#include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
 #include <lal/TimeSeriesInterp.h>
 #include <lal/Units.h>
@@ -79,6 +80,29 @@ static void evaluate(REAL8TimeSeries *dst, LALREAL8TimeSeriesInterp *interp, int
 }
 
 
+static void evaluate_batch(REAL8TimeSeries *dst, LALREAL8TimeSeriesInterp *interp, int bounds_check, int reverse)
+{
+	REAL8Sequence *dt = XLALCreateREAL8Sequence(dst->data->length);
+	REAL8Sequence *result = XLALCreateREAL8Sequence(dst->data->length);
+	unsigned i;
+
+	if(!dt || !result) {
+		fprintf(stderr, "error:  memory allocation failure\n");
+		exit(1);
+	}
+	for(i = 0; i < dst->data->length; i++)
+		dt->data[reverse ? dst->data->length - 1 - i : i] = i * dst->deltaT;
+	if(XLALREAL8TimeSeriesInterpEvalBatch(interp, result, &dst->epoch, dt, bounds_check) < 0) {
+		fprintf(stderr, "error:  batch evaluation failed\n");
+		exit(1);
+	}
+	for(i = 0; i < dst->data->length; i++)
+		dst->data->data[i] = result->data[reverse ? dst->data->length - 1 - i : i];
+	XLALDestroyREAL8Sequence(dt);
+	XLALDestroyREAL8Sequence(result);
+}
+
+
 static REAL8TimeSeries *error(const REAL8TimeSeries *s1, const REAL8TimeSeries *s0)
 {
 	REAL8TimeSeries *result = copy_series(s1);
@@ -236,6 +260,30 @@ int main(void)
 
 	check_result(mdl, dst, 0.03, -0.078, +0.083);
 
+	/*
+	 * the batch evaluator must meet the same bounds, and must give the
+	 * same answer for sorted and unsorted sample times
+	 */
+
+	{
+	REAL8TimeSeries *rev = copy_series(mdl);
+	unsigned i;
+
+	fprintf(stderr, "repeating with batch evaluator ...\n");
+	interp = XLALREAL8TimeSeriesInterpCreate(src, 9, NULL, NULL);
+	evaluate_batch(dst, interp, 1, 0);
+	evaluate_batch(rev, interp, 1, 1);
+	XLALREAL8TimeSeriesInterpDestroy(interp);
+
+	check_result(mdl, dst, 0.03, -0.078, +0.083);
+	for(i = 0; i < dst->data->length; i++)
+		if(rev->data->data[i] != dst->data->data[i]) {
+			fprintf(stderr, "error:  batch evaluator depends on sample order\n");
+			exit(1);
+		}
+	XLALDestroyREAL8TimeSeries(rev);
+	}
+
 	XLALDestroyREAL8TimeSeries(src);
 	XLALDestroyREAL8TimeSeries(dst);
 	XLALDestroyREAL8TimeSeries(mdl);
@@ -276,6 +324,27 @@ int main(void)
 		fprintf(stderr, "error:  interpolator failed in final sample (expected %.16g got %.16g)\n", 0., result);
 		exit(1);
 	}
+	/* the batch evaluator must behave the same way */
+	{
+	REAL8Sequence *dt = XLALCreateREAL8Sequence(2);
+	REAL8Sequence *results = XLALCreateREAL8Sequence(2);
+	LIGOTimeGPS t0 = src->epoch;
+	dt->data[0] = (src->data->length - 1) * src->deltaT;
+	dt->data[1] = src->data->length * src->deltaT;
+	fprintf(stderr, "checking for out-of-bounds failure in batch evaluator ...\n");
+	if(XLALREAL8TimeSeriesInterpEvalBatch(interp, results, &t0, dt, 1) == 0) {
+		fprintf(stderr, "error:  batch interpolator failed to report error beyond end of array\n");
+		exit(1);
+	} else
+		fprintf(stderr, "... passed\n");
+	XLALClearErrno();
+	if(XLALREAL8TimeSeriesInterpEvalBatch(interp, results, &t0, dt, 0) < 0 || results->data[1] != 0.) {
+		fprintf(stderr, "error:  batch interpolator failed in final sample (expected %.16g got %.16g)\n", 0., results->data[1]);
+		exit(1);
+	}
+	XLALDestroyREAL8Sequence(dt);
+	XLALDestroyREAL8Sequence(results);
+	}
 	}
 	XLALREAL8TimeSeriesInterpDestroy(interp);
 
@@ -22,7 +22,9 @@
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_permutation.h>
+#include <lal/LALStdlib.h>
 #include <lal/LALHashTbl.h>
+#include <lal/LogPrintf.h>
 
 typedef struct {
   int key;
@@ -50,13 +52,17 @@ static int cmp_elem( const void *x, const void *y )
   return ex->key - ey->key;
 }
 
-int main( void )
+static UINT8 city_hash_elem( const void *x )
+{
+  const elem *ex = ( const elem * ) x;
+  return XLALCityHash64( ( const char * ) &ex->key, sizeof( ex->key ) );
+}
+
+static int test_hashtbl( LALHashTbl *ht )
 {
 
-  /* Create hash table */
-  LALHashTbl *ht = XLALHashTblCreate( XLALFree, hash_elem, cmp_elem );
-  XLAL_CHECK_MAIN( ht != NULL, XLAL_EFUNC );
-  XLAL_CHECK_MAIN( XLALHashTblSize( ht ) == 0, XLAL_EFAILED );
+  XLAL_CHECK( ht != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALHashTblSize( ht ) == 0, XLAL_EFAILED );
 
   /* Repeat hash table test a few times */
   gsl_rng *r = gsl_rng_alloc( gsl_rng_mt19937 );
@@ -65,14 +71,14 @@ int main( void )
 
     /* Add 100 elements with keys in 100*n + [0,99] to table in a random order */
     {
-      XLAL_CHECK_MAIN( r != NULL, XLAL_ESYS );
+      XLAL_CHECK( r != NULL, XLAL_ESYS );
       gsl_permutation *p = gsl_permutation_calloc( 100 );
-      XLAL_CHECK_MAIN( p != NULL, XLAL_ESYS );
+      XLAL_CHECK( p != NULL, XLAL_ESYS );
       gsl_ran_shuffle( r, p->data, 100, sizeof( size_t ) );
       for ( int i = 0; i < 100; ++i ) {
         int key = 100*n + gsl_permutation_get( p, i );
-        XLAL_CHECK_MAIN( XLALHashTblAdd( ht, new_elem( key, 3*key - n ) ) == XLAL_SUCCESS, XLAL_EFUNC );
-        XLAL_CHECK_MAIN( XLALHashTblSize( ht ) == 100*n + i + 1, XLAL_EFAILED );
+        XLAL_CHECK( XLALHashTblAdd( ht, new_elem( key, 3*key - n ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK( XLALHashTblSize( ht ) == 100*n + i + 1, XLAL_EFAILED );
       }
       gsl_permutation_free( p );
     }
@@ -81,57 +87,251 @@ int main( void )
     for ( int i = 0; i < 100; ++i ) {
       elem x = { .key = 100*n + i };
       const elem *y;
-      XLAL_CHECK_MAIN( XLALHashTblFind( ht, &x, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( y != NULL, XLAL_EFAILED );
-      XLAL_CHECK_MAIN( y->value == 3*y->key - n, XLAL_EFAILED );
+      XLAL_CHECK( XLALHashTblFind( ht, &x, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( y != NULL, XLAL_EFAILED );
+      XLAL_CHECK( y->value == 3*y->key - n, XLAL_EFAILED );
     }
 
     /* Try extracting all 100 elements, then adding them back */
     for ( int i = 0; i < 100; ++i ) {
       elem x = { .key = 100*n + i };
       elem *y;
-      XLAL_CHECK_MAIN( XLALHashTblExtract( ht, &x, ( void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( y != NULL, XLAL_EFAILED );
-      XLAL_CHECK_MAIN( y->value == 3*y->key - n, XLAL_EFAILED );
+      XLAL_CHECK( XLALHashTblExtract( ht, &x, ( void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( y != NULL, XLAL_EFAILED );
+      XLAL_CHECK( y->value == 3*y->key - n, XLAL_EFAILED );
       const elem *z;
-      XLAL_CHECK_MAIN( XLALHashTblFind( ht, &x, ( const void ** ) &z ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( z == NULL, XLAL_EFAILED );
-      XLAL_CHECK_MAIN( XLALHashTblAdd( ht, y ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( XLALHashTblFind( ht, &x, ( const void ** ) &z ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( z != NULL, XLAL_EFAILED );
-      XLAL_CHECK_MAIN( z->value == 3*z->key - n, XLAL_EFAILED );
+      XLAL_CHECK( XLALHashTblFind( ht, &x, ( const void ** ) &z ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( z == NULL, XLAL_EFAILED );
+      XLAL_CHECK( XLALHashTblAdd( ht, y ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALHashTblFind( ht, &x, ( const void ** ) &z ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( z != NULL, XLAL_EFAILED );
+      XLAL_CHECK( z->value == 3*z->key - n, XLAL_EFAILED );
     }
 
     /* Try clearing hash table */
     if ( !clear_tested && n == 0 ) {
-      XLAL_CHECK_MAIN( XLALHashTblClear( ht ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALHashTblClear( ht ) == XLAL_SUCCESS, XLAL_EFUNC );
       clear_tested = 1;
       n = -1;
     }
 
   }
-  XLAL_CHECK_MAIN( XLALHashTblSize( ht ) == 400, XLAL_EFAILED );
+  XLAL_CHECK( XLALHashTblSize( ht ) == 400, XLAL_EFAILED );
 
   /* Try removing some elements */
   for ( int i = 0; i < 250; ++i ) {
     elem x = { .key = i };
-    XLAL_CHECK_MAIN( XLALHashTblRemove( ht, &x ) == XLAL_SUCCESS, XLAL_EFAILED );
-    XLAL_CHECK_MAIN( XLALHashTblSize( ht ) == 400 - i - 1, XLAL_EFAILED );
+    XLAL_CHECK( XLALHashTblRemove( ht, &x ) == XLAL_SUCCESS, XLAL_EFAILED );
+    XLAL_CHECK( XLALHashTblSize( ht ) == 400 - i - 1, XLAL_EFAILED );
   }
 
   /* Try finding the rest of the elements */
   for ( int i = 250; i < 400; ++i ) {
     elem x = { .key = i };
     const elem *y;
-    XLAL_CHECK_MAIN( XLALHashTblFind( ht, &x, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
-    XLAL_CHECK_MAIN( y != NULL, XLAL_EFAILED );
-    XLAL_CHECK_MAIN( y->value == 3*y->key - ( i / 100 ), XLAL_EFAILED );
+    XLAL_CHECK( XLALHashTblFind( ht, &x, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( y != NULL, XLAL_EFAILED );
+    XLAL_CHECK( y->value == 3*y->key - ( i / 100 ), XLAL_EFAILED );
   }
 
   /* Cleanup */
   gsl_rng_free( r );
   XLALHashTblDestroy( ht );
 
+  return XLAL_SUCCESS;
+
+}
+
+static int test_add_sorted( LALHashTbl *ht )
+{
+
+  XLAL_CHECK( ht != NULL, XLAL_EFUNC );
+
+  /* Add 1000 elements with keys in [0,2000) from a sorted array */
+  void *x[1000];
+  for ( int i = 0; i < 1000; ++i ) {
+    x[i] = new_elem( 2*i, 3*i );
+  }
+  XLAL_CHECK( XLALHashTblAddSorted( ht, x, 1000 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALHashTblSize( ht ) == 1000, XLAL_EFAILED );
+  for ( int key = 0; key < 2000; ++key ) {
+    elem e = { .key = key };
+    const elem *y;
+    XLAL_CHECK( XLALHashTblFind( ht, &e, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( key % 2 == 0 ) {
+      XLAL_CHECK( y != NULL && y->value == 3*key/2, XLAL_EFAILED );
+    } else {
+      XLAL_CHECK( y == NULL, XLAL_EFAILED );
+    }
+  }
+
+  /* Unsorted arrays, and elements already in the table, are rejected without changing the table */
+  {
+    int errnum;
+    elem a = { .key = 1 }, b = { .key = 3 }, c = { .key = 4 };
+    void *unsorted[2] = { &b, &a };
+    XLAL_TRY_SILENT( XLALHashTblAddSorted( ht, unsorted, 2 ), errnum );
+    XLAL_CHECK( errnum == XLAL_EINVAL, XLAL_EFAILED );
+    void *duplicate[2] = { &a, &a };
+    XLAL_TRY_SILENT( XLALHashTblAddSorted( ht, duplicate, 2 ), errnum );
+    XLAL_CHECK( errnum == XLAL_EINVAL, XLAL_EFAILED );
+    void *existing[3] = { &a, &b, &c };
+    XLAL_TRY_SILENT( XLALHashTblAddSorted( ht, existing, 3 ), errnum );
+    XLAL_CHECK( errnum == XLAL_EFAILED, XLAL_EFAILED );
+    XLAL_CHECK( XLALHashTblSize( ht ) == 1000, XLAL_EFAILED );
+  }
+
+  XLALHashTblDestroy( ht );
+
+  return XLAL_SUCCESS;
+
+}
+
+static int test_concurrent( void )
+{
+
+  const int n = 100000;
+
+  /* Add elements to a concurrent hash table from many threads, while finding them */
+  LALHashTbl *ht = XLALHashTblCreateConcurrent( XLALFree, city_hash_elem, cmp_elem );
+  XLAL_CHECK( ht != NULL, XLAL_EFUNC );
+  int errors = 0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:errors)
+  for ( int i = 0; i < n; ++i ) {
+    elem e = { .key = i };
+    const elem *y;
+    if ( XLALHashTblAdd( ht, new_elem( i, 3*i ) ) != XLAL_SUCCESS ) {
+      ++errors;
+    }
+    if ( XLALHashTblFind( ht, &e, ( const void ** ) &y ) != XLAL_SUCCESS || y == NULL || y->value != 3*i ) {
+      ++errors;
+    }
+  }
+  XLAL_CHECK( errors == 0, XLAL_EFAILED, "%i errors adding elements to concurrent hash table", errors );
+  XLAL_CHECK( XLALHashTblSize( ht ) == n, XLAL_EFAILED );
+
+  /* Remove every third element from many threads */
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:errors)
+  for ( int i = 0; i < n; i += 3 ) {
+    elem e = { .key = i };
+    if ( XLALHashTblRemove( ht, &e ) != XLAL_SUCCESS ) {
+      ++errors;
+    }
+  }
+  XLAL_CHECK( errors == 0, XLAL_EFAILED, "%i errors removing elements from concurrent hash table", errors );
+  XLAL_CHECK( XLALHashTblSize( ht ) == n - ( n + 2 ) / 3, XLAL_EFAILED );
+
+  /* Compare lookups in a hash table built serially, to lookups in the concurrent hash table */
+  LALHashTbl *ht_serial = XLALHashTblCreate( XLALFree, city_hash_elem, cmp_elem );
+  XLAL_CHECK( ht_serial != NULL, XLAL_EFUNC );
+  for ( int i = 0; i < n; ++i ) {
+    if ( i % 3 != 0 ) {
+      XLAL_CHECK( XLALHashTblAdd( ht_serial, new_elem( i, 3*i ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+  const int nfind = 10 * n;
+  int found_serial = 0, found_conc = 0, found = 0;
+  REAL8 t0 = XLALGetTimeOfDay();
+  for ( int i = 0; i < nfind; ++i ) {
+    elem e = { .key = ( int )( ( ( INT8 ) i * 7919 ) % n ) };
+    const elem *y;
+    XLAL_CHECK( XLALHashTblFind( ht_serial, &e, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    found_serial += ( y != NULL );
+  }
+  REAL8 t1 = XLALGetTimeOfDay();
+  for ( int i = 0; i < nfind; ++i ) {
+    elem e = { .key = ( int )( ( ( INT8 ) i * 7919 ) % n ) };
+    const elem *y;
+    XLAL_CHECK( XLALHashTblFind( ht, &e, ( const void ** ) &y ) == XLAL_SUCCESS, XLAL_EFUNC );
+    found_conc += ( y != NULL );
+  }
+  REAL8 t2 = XLALGetTimeOfDay();
+#pragma omp parallel for reduction(+:found)
+  for ( int i = 0; i < nfind; ++i ) {
+    elem e = { .key = ( int )( ( ( INT8 ) i * 7919 ) % n ) };
+    const elem *y = NULL;
+    XLALHashTblFind( ht, &e, ( const void ** ) &y );
+    found += ( y != NULL );
+  }
+  REAL8 t3 = XLALGetTimeOfDay();
+  XLAL_CHECK( found_conc == found_serial, XLAL_EFAILED, "Concurrent hash table found %i elements, serial hash table %i", found_conc, found_serial );
+  XLAL_CHECK( found == found_serial, XLAL_EFAILED, "Concurrent hash table found %i elements from many threads, serial hash table %i", found, found_serial );
+  printf( "XLALHashTblFind() with CityHash, one thread: %0.1f ns per lookup in serial hash table, %0.1f ns per lookup in concurrent hash table\n",
+          ( t1 - t0 ) / nfind * 1e9, ( t2 - t1 ) / nfind * 1e9 );
+  printf( "XLALHashTblFind() with CityHash, many threads: %0.1f ns per lookup in concurrent hash table, %0.2fx speedup over one thread\n",
+          ( t3 - t2 ) / nfind * 1e9, ( t2 - t1 ) / ( t3 - t2 ) );
+
+  XLALHashTblDestroy( ht_serial );
+  XLALHashTblDestroy( ht );
+
+  return XLAL_SUCCESS;
+
+}
+
+static int test_concurrent_churn( void )
+{
+
+  const int m = 1000, rounds = 200;
+
+  /* Repeatedly replace all elements of a concurrent hash table from many threads, while finding them */
+  LALHashTbl *ht = XLALHashTblCreateConcurrent( XLALFree, city_hash_elem, cmp_elem );
+  XLAL_CHECK( ht != NULL, XLAL_EFUNC );
+  for ( int i = 0; i < m; ++i ) {
+    XLAL_CHECK( XLALHashTblAdd( ht, new_elem( i, 3*i ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  size_t mem_start = 0;
+  int errors = 0;
+  for ( int r = 0; r < rounds; ++r ) {
+    if ( r == 1 ) {   /* Memory used once the hash table has grown to hold all elements */
+      mem_start = lalMallocTotal;
+    }
+#pragma omp parallel for schedule(dynamic, 16) reduction(+:errors)
+    for ( int i = 0; i < m; ++i ) {
+      const int key_old = r*m + i, key_new = ( r + 1 )*m + i;
+      elem e_old = { .key = key_old }, e_new = { .key = key_new };
+      const elem *y;
+      if ( XLALHashTblRemove( ht, &e_old ) != XLAL_SUCCESS ) {
+        ++errors;
+      }
+      if ( XLALHashTblAdd( ht, new_elem( key_new, 3*key_new ) ) != XLAL_SUCCESS ) {
+        ++errors;
+      }
+      if ( XLALHashTblFind( ht, &e_new, ( const void ** ) &y ) != XLAL_SUCCESS || y == NULL || y->value != 3*key_new ) {
+        ++errors;
+      }
+    }
+  }
+  XLAL_CHECK( errors == 0, XLAL_EFAILED, "%i errors replacing elements of concurrent hash table", errors );
+  XLAL_CHECK( XLALHashTblSize( ht ) == m, XLAL_EFAILED );
+
+  /* Tables retired by rebuilding the hash table must have been released, since no reader is in progress */
+  if ( lalDebugLevel & LALMEMTRKBIT ) {
+    XLAL_CHECK( lalMallocTotal <= mem_start, XLAL_EFAILED, "Concurrent hash table memory grew from %zu to %zu bytes", mem_start, lalMallocTotal );
+  }
+
+  XLALHashTblDestroy( ht );
+
+  return XLAL_SUCCESS;
+
+}
+
+int main( void )
+{
+
+  /* Test serial and concurrent hash tables */
+  XLAL_CHECK_MAIN( test_hashtbl( XLALHashTblCreate( XLALFree, hash_elem, cmp_elem ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_hashtbl( XLALHashTblCreateConcurrent( XLALFree, hash_elem, cmp_elem ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Test adding sorted elements */
+  XLAL_CHECK_MAIN( test_add_sorted( XLALHashTblCreate( XLALFree, hash_elem, cmp_elem ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_add_sorted( XLALHashTblCreateConcurrent( XLALFree, hash_elem, cmp_elem ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Test and benchmark concurrent hash table */
+  XLAL_CHECK_MAIN( test_concurrent() == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Test memory use of a concurrent hash table whose elements are repeatedly replaced */
+  XLAL_CHECK_MAIN( test_concurrent_churn() == XLAL_SUCCESS, XLAL_EFUNC );
+
   /* Check for memory leaks */
   LALCheckMemoryLeaks();
 
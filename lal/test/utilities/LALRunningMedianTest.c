@@ -23,8 +23,10 @@
 #include <lal/LALConstants.h>
 #include <lal/LALMalloc.h>
 #include <lal/SeqFactories.h>
+#include <lal/Sequence.h>
 #include <lal/PrintVector.h>
 #include <lal/LALRunningMedian.h>
+#include <lal/LogPrintf.h>
 
 
 /**
@@ -50,6 +52,9 @@
  * LALRunningMedian functions and compares the results against
  * inividually calculated medians. The test is repeated with
  * blocksize - 1 (to check for even/odd errors).
+ * The XLAL heap-based running median functions, including the batch
+ * functions, are tested in the same way, and are then timed against
+ * LALDRunningMedian2() for block sizes between 11 and 1001.
  * The default values for array length and window
  * width are 1024 and 512.
  * If a value for lalDebugLevel is given, the program
@@ -113,6 +118,8 @@ int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
 		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
 int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
 		       LALRunningMedianPar param, BOOLEAN verbose, BOOLEAN bmimpl);
+int testDRunningMedianBatch(REAL8Sequence *input, UINT4 blocksize);
+int benchmarkRunningMedian(LALStatus *stat);
 
 
 struct rngmed_val_index {
@@ -204,7 +211,13 @@ int testDRunningMedian(LALStatus *stat, REAL8Sequence *input, UINT4 length,
   }
 
   /* call running median */
-  if (bmimpl)
+  if (bmimpl == 2) {
+    if (XLALDRunningMedian( medians, input, param.blocksize ) != XLAL_SUCCESS) {
+      printf("ERROR: XLALDRunningMedian failed with xlalErrno %d\n",xlalErrno);
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+  }
+  else if (bmimpl)
     LALDRunningMedian2( stat, medians, input, param );
   else
     LALDRunningMedian( stat, medians, input, param );
@@ -284,7 +297,13 @@ int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
   }
 
   /* call running median */
-  if (bmimpl)
+  if (bmimpl == 2) {
+    if (XLALSRunningMedian( medians, input, param.blocksize ) != XLAL_SUCCESS) {
+      printf("ERROR: XLALSRunningMedian failed with xlalErrno %d\n",xlalErrno);
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+  }
+  else if (bmimpl)
     LALSRunningMedian2( stat, medians, input, param );
   else
     LALSRunningMedian( stat, medians, input, param );
@@ -343,6 +362,117 @@ int testSRunningMedian(LALStatus *stat, REAL4Sequence *input, UINT4 length,
 }
 
 
+int testDRunningMedianBatch(REAL8Sequence *input, UINT4 blocksize) {
+/* Test the XLALDRunningMedianBatch (REAL8VectorSequence) function by
+   comparing the results to XLALDRunningMedian of each vector */
+
+  const UINT4 nvec = 5;
+  const UINT4 veclen = input->length - nvec + 1;
+  REAL8VectorSequence *batchin, *batchout;
+  REAL8Sequence vecin, *medians;
+  UINT4 n,i;
+
+  if (blocksize > veclen)
+    return(0);
+
+  /* each vector is the input shifted by one more element */
+  batchin = XLALCreateREAL8VectorSequence( nvec, veclen );
+  batchout = XLALCreateREAL8VectorSequence( nvec, veclen - blocksize + 1 );
+  medians = XLALCreateREAL8Sequence( veclen - blocksize + 1 );
+  if (!batchin || !batchout || !medians) {
+    EXIT( LALRUNNINGMEDIANTESTC_EALOC, argv0, LALRUNNINGMEDIANTESTC_MSGEALOC );
+  }
+  for(n=0;n<nvec;n++)
+    for(i=0;i<veclen;i++)
+      batchin->data[n*veclen+i] = input->data[n+i];
+
+  if (XLALDRunningMedianBatch( batchout, batchin, blocksize ) != XLAL_SUCCESS) {
+    printf("ERROR: XLALDRunningMedianBatch failed with xlalErrno %d\n",xlalErrno);
+    EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+  }
+
+  /* compare to the medians of each vector */
+  for(n=0;n<nvec;n++) {
+    vecin.length = veclen;
+    vecin.data = batchin->data + n*veclen;
+    if (XLALDRunningMedian( medians, &vecin, blocksize ) != XLAL_SUCCESS) {
+      printf("ERROR: XLALDRunningMedian failed with xlalErrno %d\n",xlalErrno);
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+    for(i=0;i<medians->length;i++) {
+      if (medians->data[i] != batchout->data[n*batchout->vectorLength+i]) {
+        printf("ERROR: vector:%d index:%d median:% 22.15e batch median:% 22.15e mismatch\n",
+               n, i, medians->data[i], batchout->data[n*batchout->vectorLength+i]);
+        EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+      }
+    }
+  }
+
+  XLALDestroyREAL8Sequence(medians);
+  XLALDestroyREAL8VectorSequence(batchout);
+  XLALDestroyREAL8VectorSequence(batchin);
+  return(0);
+}
+
+
+int benchmarkRunningMedian(LALStatus *stat) {
+/* Time the XLALDRunningMedian function against LALDRunningMedian2
+   for a range of block sizes */
+
+  const UINT4 length = 100000;
+  const UINT4 blocksizes[] = { 11, 31, 101, 301, 1001 };
+  REAL8Sequence *input, *medians1, *medians2;
+  LALRunningMedianPar param;
+  UINT4 b,i;
+
+  input = XLALCreateREAL8Sequence( length );
+  if (!input) {
+    EXIT( LALRUNNINGMEDIANTESTC_EALOC, argv0, LALRUNNINGMEDIANTESTC_MSGEALOC );
+  }
+  for(i=0;i<length;i++)
+    input->data[i] = (double)rand()/(double)RAND_MAX;
+
+  for(b=0;b<sizeof(blocksizes)/sizeof(blocksizes[0]);b++) {
+    REAL8 t0, t1, t2;
+    param.blocksize = blocksizes[b];
+    medians1 = XLALCreateREAL8Sequence( length - param.blocksize + 1 );
+    medians2 = XLALCreateREAL8Sequence( length - param.blocksize + 1 );
+    if (!medians1 || !medians2) {
+      EXIT( LALRUNNINGMEDIANTESTC_EALOC, argv0, LALRUNNINGMEDIANTESTC_MSGEALOC );
+    }
+
+    t0 = XLALGetCPUTime();
+    LALDRunningMedian2( stat, medians1, input, param );
+    if ( stat->statusCode ) {
+      printf("ERROR: LALDRunningMedian2 returned status %d\n",stat->statusCode);
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+    t1 = XLALGetCPUTime();
+    if (XLALDRunningMedian( medians2, input, param.blocksize ) != XLAL_SUCCESS) {
+      printf("ERROR: XLALDRunningMedian failed with xlalErrno %d\n",xlalErrno);
+      EXIT( LALRUNNINGMEDIANTESTC_ESUB, argv0, LALRUNNINGMEDIANTESTC_MSGESUB );
+    }
+    t2 = XLALGetCPUTime();
+
+    for(i=0;i<medians1->length;i++) {
+      if(compare_double(medians1->data[i],medians2->data[i])) {
+        printf("ERROR: index:%d LALDRunningMedian2:% 22.15e XLALDRunningMedian:% 22.15e mismatch\n",
+               i, medians1->data[i], medians2->data[i]);
+        EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+      }
+    }
+    printf("  TIME: blocksize %4d: LALDRunningMedian2 %8.4f s, XLALDRunningMedian %8.4f s\n",
+           param.blocksize, t1 - t0, t2 - t1);
+
+    XLALDestroyREAL8Sequence(medians2);
+    XLALDestroyREAL8Sequence(medians1);
+  }
+
+  XLALDestroyREAL8Sequence(input);
+  return(0);
+}
+
+
 
 
 
@@ -681,6 +811,34 @@ int main( int argc, char **argv )
   }
 
 
+  /* test the heap-based XLAL running medians for both block sizes */
+  for(i=0;i<2;i++,param.blocksize++) {
+
+    if(testDRunningMedian(&stat,input8,length,param,verbose,2)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: XLALDRunningMedian(%d,%d)\n",length,param.blocksize);
+    }
+
+    if(testSRunningMedian(&stat,input4,length,param,verbose,2)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: XLALSRunningMedian(%d,%d)\n",length,param.blocksize);
+    }
+
+    if(testDRunningMedianBatch(input8,param.blocksize)) {
+      EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+    } else {
+      printf("  PASS: XLALDRunningMedianBatch(%d,%d)\n",length,param.blocksize);
+    }
+
+  }
+
+  /* compare timings of the running median implementations */
+  if(benchmarkRunningMedian(&stat)) {
+    EXIT( LALRUNNINGMEDIANTESTC_EFALSE, argv0, LALRUNNINGMEDIANTESTC_MSGEFALSE );
+  }
+
   /* free dummy input memory */
   LALDDestroyVector(&stat,&input8);
   LALSDestroyVector(&stat,&input4);
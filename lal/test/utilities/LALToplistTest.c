@@ -0,0 +1,236 @@
+/*
+ *  Copyright (C) 2026 Karl Wette
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <lal/LALToplist.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define NUM_CAND   100000
+#define MAX_SIZE   1000
+#define NUM_THREADS 7
+
+typedef struct {
+  INT4 id;
+  REAL4 freq;
+} cand;
+
+static int cmp_cand( void *param, const void *x, const void *y )
+{
+  ( void ) param;
+  const cand *cx = ( const cand * ) x;
+  const cand *cy = ( const cand * ) y;
+  return ( cx->id > cy->id ) - ( cx->id < cy->id );
+}
+
+/* Sort candidates in order of decreasing rank, then decreasing id */
+static const REAL4 *sort_ranks;
+static int sort_cand( const void *x, const void *y )
+{
+  const cand *cx = ( const cand * ) x;
+  const cand *cy = ( const cand * ) y;
+  const REAL4 rx = sort_ranks[cx->id], ry = sort_ranks[cy->id];
+  if ( rx != ry ) {
+    return ( rx < ry ) ? 1 : -1;
+  }
+  return cmp_cand( NULL, y, x );
+}
+
+static int check_equal( const LALToplist *tl, const LALToplist *tl_ref )
+{
+  const int n = XLALToplistSize( tl );
+  XLAL_CHECK( n == XLALToplistSize( tl_ref ), XLAL_EFAILED, "Toplists have different sizes" );
+  REAL4 ranks[MAX_SIZE], ranks_ref[MAX_SIZE];
+  cand elems[MAX_SIZE], elems_ref[MAX_SIZE];
+  XLAL_CHECK( XLALToplistGetSorted( tl, ranks, elems ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALToplistGetSorted( tl_ref, ranks_ref, elems_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( memcmp( ranks, ranks_ref, n * sizeof( ranks[0] ) ) == 0, XLAL_EFAILED, "Toplists have different ranks" );
+  XLAL_CHECK( memcmp( elems, elems_ref, n * sizeof( elems[0] ) ) == 0, XLAL_EFAILED, "Toplists have different elements" );
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  /* Create candidates, with many ties in rank and a few NaN ranks */
+  static REAL4 ranks[NUM_CAND];
+  static cand cands[NUM_CAND];
+  srand( 1 );
+  for ( int i = 0; i < NUM_CAND; ++i ) {
+    ranks[i] = ( i % 997 == 0 ) ? NAN : ( rand() % 5000 ) / 10.0;
+    cands[i].id = i;
+    cands[i].freq = 100.0 + 1e-3 * i;
+  }
+
+  /* Adding candidates one at a time must keep those of largest rank */
+  LALToplist *tl_ref = XLALToplistCreate( MAX_SIZE, sizeof( cand ), cmp_cand, NULL );
+  XLAL_CHECK_MAIN( tl_ref != NULL, XLAL_EFUNC );
+  for ( int i = 0; i < NUM_CAND; ++i ) {
+    const int added = XLALToplistAdd( tl_ref, ranks[i], &cands[i] );
+    XLAL_CHECK_MAIN( added == 0 || added == 1, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( !isnan( ranks[i] ) || added == 0, XLAL_EFAILED, "Candidate with NaN rank was added" );
+  }
+  XLAL_CHECK_MAIN( XLALToplistSize( tl_ref ) == MAX_SIZE, XLAL_EFAILED );
+  {
+    static cand sorted[NUM_CAND];
+    int nsorted = 0;
+    for ( int i = 0; i < NUM_CAND; ++i ) {
+      if ( !isnan( ranks[i] ) ) {
+        sorted[nsorted++] = cands[i];
+      }
+    }
+    sort_ranks = ranks;
+    qsort( sorted, nsorted, sizeof( sorted[0] ), sort_cand );
+    REAL4 tl_ranks[MAX_SIZE];
+    cand tl_elems[MAX_SIZE];
+    XLAL_CHECK_MAIN( XLALToplistGetSorted( tl_ref, tl_ranks, tl_elems ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( int i = 0; i < MAX_SIZE; ++i ) {
+      XLAL_CHECK_MAIN( tl_elems[i].id == sorted[i].id && tl_ranks[i] == ranks[sorted[i].id], XLAL_EFAILED, "Toplist element %i is candidate %i, expected %i", i, tl_elems[i].id, sorted[i].id );
+    }
+    XLAL_CHECK_MAIN( XLALToplistThreshold( tl_ref ) == tl_ranks[MAX_SIZE - 1], XLAL_EFAILED );
+  }
+
+  /* Adding candidates in bulk must give the same toplist */
+  {
+    LALToplist *tl = XLALToplistCreate( MAX_SIZE, sizeof( cand ), cmp_cand, NULL );
+    XLAL_CHECK_MAIN( tl != NULL, XLAL_EFUNC );
+    for ( int i = 0; i < NUM_CAND; i += 1234 ) {
+      const int n = ( NUM_CAND - i < 1234 ) ? NUM_CAND - i : 1234;
+      XLAL_CHECK_MAIN( XLALToplistAddMany( tl, ranks + i, cands + i, n ) >= 0, XLAL_EFUNC );
+    }
+    XLAL_CHECK_MAIN( check_equal( tl, tl_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* Filtering finds exactly those candidates at or above the threshold */
+    static UINT4 idx[NUM_CAND];
+    UINT4 count = 0, expected = 0;
+    XLAL_CHECK_MAIN( XLALToplistFilter( tl, &count, idx, ranks, NUM_CAND ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( int i = 0; i < NUM_CAND; ++i ) {
+      expected += ( ranks[i] >= XLALToplistThreshold( tl ) );
+    }
+    XLAL_CHECK_MAIN( count == expected, XLAL_EFAILED, "Filter found %u candidates, expected %u", count, expected );
+    for ( UINT4 k = 0; k < count; ++k ) {
+      XLAL_CHECK_MAIN( ranks[idx[k]] >= XLALToplistThreshold( tl ), XLAL_EFAILED );
+    }
+
+    XLALToplistDestroy( tl );
+  }
+
+  /* Merging per-thread toplists, filled concurrently, must give the same toplist, however candidates are distributed */
+  {
+    LALToplistSet *set = XLALToplistSetCreate( NUM_THREADS, MAX_SIZE, sizeof( cand ), cmp_cand, NULL );
+    XLAL_CHECK_MAIN( set != NULL, XLAL_EFUNC );
+    for ( int pass = 0; pass < 2; ++pass ) {
+      const int chunk = ( pass == 0 ) ? 1 : NUM_CAND / NUM_THREADS + 1;
+      int fail = 0;
+#pragma omp parallel for num_threads(NUM_THREADS) schedule(dynamic, chunk) reduction(+:fail)
+      for ( int i = 0; i < NUM_CAND; ++i ) {
+#ifdef _OPENMP
+        const int t = omp_get_thread_num();
+#else
+        const int t = ( i / chunk ) % NUM_THREADS;
+#endif
+        LALToplist *tl_t = XLALToplistSetGet( set, t );
+        if ( tl_t == NULL || XLALToplistAdd( tl_t, ranks[i], &cands[i] ) < 0 ) {
+          ++fail;
+        }
+      }
+      XLAL_CHECK_MAIN( fail == 0, XLAL_EFUNC, "Adding %i candidates to per-thread toplists failed", fail );
+      LALToplist *tl = XLALToplistCreate( MAX_SIZE, sizeof( cand ), cmp_cand, NULL );
+      XLAL_CHECK_MAIN( tl != NULL, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALToplistSetMerge( tl, set ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( check_equal( tl, tl_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALToplistSize( XLALToplistSetGet( set, 0 ) ) == 0, XLAL_EFAILED, "Merge did not clear per-thread toplists" );
+      XLALToplistDestroy( tl );
+    }
+    XLALToplistSetDestroy( set );
+  }
+
+  /* Toplists must be restored from checkpoints */
+  {
+    const char *fname = "LALToplistTest.out";
+    LALFILE *fp = XLALFileOpenWrite( fname, 0 );
+    XLAL_CHECK_MAIN( fp != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALToplistWrite( fp, tl_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFileClose( fp ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    LALToplist *tl = XLALToplistCreate( MAX_SIZE, sizeof( cand ), cmp_cand, NULL );
+    XLAL_CHECK_MAIN( tl != NULL, XLAL_EFUNC );
+    fp = XLALFileOpenRead( fname );
+    XLAL_CHECK_MAIN( fp != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALToplistRead( fp, tl ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFileClose( fp ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( check_equal( tl, tl_ref ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* A smaller toplist keeps the elements of largest rank */
+    LALToplist *tl_small = XLALToplistCreate( MAX_SIZE / 10, sizeof( cand ), cmp_cand, NULL );
+    XLAL_CHECK_MAIN( tl_small != NULL, XLAL_EFUNC );
+    fp = XLALFileOpenRead( fname );
+    XLAL_CHECK_MAIN( fp != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALToplistRead( fp, tl_small ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALFileClose( fp ) == XLAL_SUCCESS, XLAL_EFUNC );
+    {
+      REAL4 r[MAX_SIZE], r_small[MAX_SIZE / 10];
+      XLAL_CHECK_MAIN( XLALToplistGetSorted( tl_ref, r, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALToplistGetSorted( tl_small, r_small, NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK_MAIN( XLALToplistSize( tl_small ) == MAX_SIZE / 10, XLAL_EFAILED );
+      XLAL_CHECK_MAIN( memcmp( r, r_small, sizeof( r_small ) ) == 0, XLAL_EFAILED, "Smaller toplist has different ranks" );
+    }
+    XLALToplistDestroy( tl_small );
+
+    /* A corrupt checkpoint is rejected, and leaves the toplist unchanged */
+    {
+      FILE *f = fopen( fname, "r+b" );
+      XLAL_CHECK_MAIN( f != NULL, XLAL_ESYS );
+      XLAL_CHECK_MAIN( fseek( f, -1, SEEK_END ) == 0, XLAL_ESYS );
+      const int c = fgetc( f );
+      XLAL_CHECK_MAIN( fseek( f, -1, SEEK_END ) == 0, XLAL_ESYS );
+      XLAL_CHECK_MAIN( fputc( c ^ 0x01, f ) != EOF, XLAL_ESYS );
+      XLAL_CHECK_MAIN( fclose( f ) == 0, XLAL_ESYS );
+    }
+    XLAL_CHECK_MAIN( XLALToplistClear( tl ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALToplistAdd( tl, 1.0, &cands[1] ) == 1, XLAL_EFUNC );
+    fp = XLALFileOpenRead( fname );
+    XLAL_CHECK_MAIN( fp != NULL, XLAL_EFUNC );
+    int errnum;
+    XLAL_TRY_SILENT( XLALToplistRead( fp, tl ), errnum );
+    XLAL_CHECK_MAIN( errnum == XLAL_EIO, XLAL_EFAILED, "Corrupt checkpoint was not rejected" );
+    XLAL_CHECK_MAIN( XLALFileClose( fp ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALToplistSize( tl ) == 1, XLAL_EFAILED, "Toplist was changed by corrupt checkpoint" );
+
+    XLALToplistDestroy( tl );
+  }
+
+  /* Cleanup */
+  XLALToplistDestroy( tl_ref );
+
+  /* Check for memory leaks */
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
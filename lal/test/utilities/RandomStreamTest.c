@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2026 Jolien Creighton
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <lal/LALStdlib.h>
+#include <lal/Random.h>
+
+#define LEN 100000
+
+int main( void )
+{
+
+  /* Turn off buffering to sync standard output and error printing */
+  setvbuf( stdout, NULL, _IONBF, 0 );
+  setvbuf( stderr, NULL, _IONBF, 0 );
+
+  static REAL4 x4[LEN], y4[LEN];
+  static REAL8 x8[LEN], y8[LEN];
+  RandomStream stream, s;
+
+  /* First block of stream 0 with seed 0 is the Philox4x32-10 known-answer test vector */
+  {
+    const UINT4 kat[4] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+    UINT4 w[4];
+    XLAL_CHECK_MAIN( XLALInitRandomStream( &stream, 0, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRandomStreamUINT4( &stream, w, 4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( memcmp( w, kat, sizeof( w ) ) == 0, XLAL_EFAILED, "Known-answer test failed: got %08x %08x %08x %08x", w[0], w[1], w[2], w[3] );
+    XLAL_CHECK_MAIN( stream.position == 4, XLAL_EFAILED );
+  }
+
+  /* Filling in chunks, and skipping ahead, gives the same deviates as filling all at once */
+  XLAL_CHECK_MAIN( XLALInitRandomStream( &stream, 20260101, 3 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  {
+    s = stream;
+    XLAL_CHECK_MAIN( XLALRandomStreamUniformREAL4( &s, x4, LEN ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( s.position == LEN, XLAL_EFAILED );
+    s = stream;
+    srand( 1 );
+    for ( UINT4 i = 0; i < LEN; ) {
+      UINT4 n = 1 + rand() % 1000;
+      n = ( n < LEN - i ) ? n : LEN - i;
+      XLAL_CHECK_MAIN( XLALRandomStreamUniformREAL4( &s, y4 + i, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+      i += n;
+    }
+    XLAL_CHECK_MAIN( memcmp( x4, y4, sizeof( x4 ) ) == 0, XLAL_EFAILED, "Chunked REAL4 uniform deviates differ" );
+    s = stream;
+    XLAL_CHECK_MAIN( XLALSkipRandomStream( &s, 12345 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRandomStreamUniformREAL4( &s, y4, 1000 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( memcmp( x4 + 12345, y4, 1000 * sizeof( y4[0] ) ) == 0, XLAL_EFAILED, "REAL4 uniform deviates differ after skipping" );
+  }
+  {
+    s = stream;
+    XLAL_CHECK_MAIN( XLALRandomStreamNormalREAL8( &s, x8, LEN ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( s.position == 2 * LEN, XLAL_EFAILED );
+    s = stream;
+    for ( UINT4 i = 0; i < LEN; ) {
+      UINT4 n = 2 * ( 1 + rand() % 500 );
+      n = ( n < LEN - i ) ? n : LEN - i;
+      XLAL_CHECK_MAIN( XLALRandomStreamNormalREAL8( &s, y8 + i, n ) == XLAL_SUCCESS, XLAL_EFUNC );
+      i += n;
+    }
+    XLAL_CHECK_MAIN( memcmp( x8, y8, sizeof( x8 ) ) == 0, XLAL_EFAILED, "Chunked REAL8 normal deviates differ" );
+    s = stream;
+    XLAL_CHECK_MAIN( XLALSkipRandomStream( &s, 2 * 5000 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRandomStreamNormalREAL8( &s, y8, 999 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( s.position == 2 * ( 5000 + 1000 ), XLAL_EFAILED );
+    XLAL_CHECK_MAIN( memcmp( x8 + 5000, y8, 999 * sizeof( y8[0] ) ) == 0, XLAL_EFAILED, "REAL8 normal deviates differ after skipping" );
+    s = stream;
+    XLAL_CHECK_MAIN( XLALSkipRandomStream( &s, 2 * 10 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRandomStreamNormalDeviate( &s ) == x8[10], XLAL_EFAILED, "Single REAL8 normal deviate differs" );
+  }
+
+  /* Deviates have the expected ranges and moments */
+  {
+    s = stream;
+    XLAL_CHECK_MAIN( XLALRandomStreamUniformREAL4( &s, x4, LEN ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRandomStreamUniformREAL8( &s, x8, LEN ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL8 mean4 = 0, mean8 = 0;
+    for ( UINT4 i = 0; i < LEN; ++i ) {
+      XLAL_CHECK_MAIN( 0 < x4[i] && x4[i] < 1, XLAL_EFAILED, "REAL4 uniform deviate %g out of range", x4[i] );
+      XLAL_CHECK_MAIN( 0 < x8[i] && x8[i] < 1, XLAL_EFAILED, "REAL8 uniform deviate %g out of range", x8[i] );
+      mean4 += x4[i] / LEN;
+      mean8 += x8[i] / LEN;
+    }
+    XLAL_CHECK_MAIN( fabs( mean4 - 0.5 ) < 5e-3 && fabs( mean8 - 0.5 ) < 5e-3, XLAL_EFAILED, "Uniform deviates have means %g, %g", mean4, mean8 );
+  }
+  {
+    s = stream;
+    XLAL_CHECK_MAIN( XLALRandomStreamNormalREAL4( &s, x4, LEN ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRandomStreamNormalREAL8( &s, x8, LEN ) == XLAL_SUCCESS, XLAL_EFUNC );
+    REAL8 mean4 = 0, var4 = 0, mean8 = 0, var8 = 0;
+    for ( UINT4 i = 0; i < LEN; ++i ) {
+      XLAL_CHECK_MAIN( isfinite( x4[i] ) && isfinite( x8[i] ), XLAL_EFAILED, "Normal deviate is not finite" );
+      mean4 += x4[i] / LEN;
+      var4 += x4[i] * x4[i] / LEN;
+      mean8 += x8[i] / LEN;
+      var8 += x8[i] * x8[i] / LEN;
+    }
+    XLAL_CHECK_MAIN( fabs( mean4 ) < 2e-2 && fabs( var4 - 1 ) < 2e-2, XLAL_EFAILED, "REAL4 normal deviates have mean %g, variance %g", mean4, var4 );
+    XLAL_CHECK_MAIN( fabs( mean8 ) < 2e-2 && fabs( var8 - 1 ) < 2e-2, XLAL_EFAILED, "REAL8 normal deviates have mean %g, variance %g", mean8, var8 );
+  }
+
+  /* Streams with different indexes, and derived streams, are different and reproducible */
+  {
+    RandomStream t, d1, d2;
+    XLAL_CHECK_MAIN( XLALInitRandomStream( &t, stream.seed, stream.index + 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALDeriveRandomStream( &d1, &stream, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALDeriveRandomStream( &d2, &stream, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( d1.seed != d2.seed || d1.index != d2.index, XLAL_EFAILED, "Derived streams are equal" );
+    RandomStream *streams[4] = { &stream, &t, &d1, &d2 };
+    UINT4 w[4][16];
+    for ( int k = 0; k < 4; ++k ) {
+      s = *streams[k];
+      XLAL_CHECK_MAIN( XLALRandomStreamUINT4( &s, w[k], 16 ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( int l = 0; l < k; ++l ) {
+        XLAL_CHECK_MAIN( memcmp( w[k], w[l], sizeof( w[k] ) ) != 0, XLAL_EFAILED, "Streams %i and %i are equal", k, l );
+      }
+    }
+    RandomStream d3;
+    XLAL_CHECK_MAIN( XLALDeriveRandomStream( &d3, &stream, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( memcmp( &d2, &d3, sizeof( d2 ) ) == 0, XLAL_EFAILED, "Derived streams are not reproducible" );
+  }
+
+  /* Check for memory leaks */
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -24,6 +24,7 @@
 #include <string.h>
 #include <math.h>
 #include <lal/LALDatatypes.h>
+#include <lal/LALStdlib.h>
 #include <lal/Window.h>
 #include <lal/XLALError.h>
 #include <lal/LALMalloc.h>
@@ -412,6 +413,90 @@ static int test_parameter_safety(void)
 }
 
 
+/*
+ * Cached windows.
+ */
+
+
+static int _test_cached_windows(int length, double kaiser_beta, double creighton_beta, double tukey_beta, double gauss_beta)
+{
+	REAL4Window *windows1[NWINDOWS];
+	REAL8Window *windows2[NWINDOWS];
+	int i;
+
+	XLAL_CHECK ( create_single_windows(windows1, length, kaiser_beta, creighton_beta, tukey_beta, gauss_beta) == XLAL_SUCCESS, XLAL_EFUNC );
+
+	XLAL_CHECK ( create_double_windows(windows2, length, kaiser_beta, creighton_beta, tukey_beta, gauss_beta) == XLAL_SUCCESS, XLAL_EFUNC );
+
+	for(i = 0; i < NWINDOWS; i++) {
+		const double beta = !strcmp(names[i], "Kaiser") ? kaiser_beta : !strcmp(names[i], "Creighton") ? creighton_beta : !strcmp(names[i], "Tukey") ? tukey_beta : !strcmp(names[i], "Gauss") ? gauss_beta : 0;
+		const REAL4Window *cached1;
+		const REAL8Window *cached2;
+
+		/* cached windows are identical to newly-created windows */
+		XLAL_CHECK ( (cached1 = XLALGetCachedNamedREAL4Window(names[i], beta, length)) != NULL, XLAL_EFUNC );
+		XLAL_CHECK ( (cached2 = XLALGetCachedNamedREAL8Window(names[i], beta, length)) != NULL, XLAL_EFUNC );
+		XLAL_CHECK ( cached1->data->length == windows1[i]->data->length && memcmp(cached1->data->data, windows1[i]->data->data, length * sizeof(REAL4)) == 0, XLAL_EFAILED, "error: cached single-precision %d-sample %s window differs\n", length, names[i] );
+		XLAL_CHECK ( cached2->data->length == windows2[i]->data->length && memcmp(cached2->data->data, windows2[i]->data->data, length * sizeof(REAL8)) == 0, XLAL_EFAILED, "error: cached double-precision %d-sample %s window differs\n", length, names[i] );
+		XLAL_CHECK ( cached1->sumofsquares == windows1[i]->sumofsquares && cached1->sum == windows1[i]->sum, XLAL_EFAILED, "error: cached single-precision %d-sample %s window has wrong metadata\n", length, names[i] );
+		XLAL_CHECK ( cached2->sumofsquares == windows2[i]->sumofsquares && cached2->sum == windows2[i]->sum, XLAL_EFAILED, "error: cached double-precision %d-sample %s window has wrong metadata\n", length, names[i] );
+
+		/* windows are found again */
+		XLAL_CHECK ( XLALGetCachedNamedREAL4Window(names[i], beta, length) == cached1, XLAL_EFAILED, "error: cached single-precision %d-sample %s window not found\n", length, names[i] );
+		XLAL_CHECK ( XLALGetCachedNamedREAL8Window(names[i], beta, length) == cached2, XLAL_EFAILED, "error: cached double-precision %d-sample %s window not found\n", length, names[i] );
+	}
+
+	free_single_windows(windows1);
+	free_double_windows(windows2);
+
+	return XLAL_SUCCESS;
+
+} // _test_cached_windows()
+
+
+static int test_cached_windows(void)
+{
+	const REAL8Window *window;
+	int i;
+
+	XLAL_CHECK ( _test_cached_windows(1025, 6, 2, 0.5, 2) == XLAL_SUCCESS, XLAL_EFUNC );
+	XLAL_CHECK ( _test_cached_windows(1024, 6, 2, 0.5, 2) == XLAL_SUCCESS, XLAL_EFUNC );
+	XLAL_CHECK ( _test_cached_windows(1024, 0, 0, 0, 0) == XLAL_SUCCESS, XLAL_EFUNC );
+	XLAL_CHECK ( _test_cached_windows(3, HUGE_VAL, HUGE_VAL, 1, HUGE_VAL) == XLAL_SUCCESS, XLAL_EFUNC );
+	XLAL_CHECK ( _test_cached_windows(1, 6, 2, 0.5, 2) == XLAL_SUCCESS, XLAL_EFUNC );
+
+	/* windows with different parameters or lengths are different */
+	XLAL_CHECK ( (window = XLALGetCachedNamedREAL8Window("tukey", 0.5, 1024)) != NULL, XLAL_EFUNC );
+	XLAL_CHECK ( XLALGetCachedNamedREAL8Window("tukey", 0.25, 1024) != window, XLAL_EFAILED );
+	XLAL_CHECK ( XLALGetCachedNamedREAL8Window("tukey", 0.5, 1025) != window, XLAL_EFAILED );
+	XLAL_CHECK ( XLALGetCachedNamedREAL8Window("hann", 0, 1024) != window, XLAL_EFAILED );
+	XLAL_CHECK ( XLALGetCachedNamedREAL8Window("TUKEY", 0.5, 1024) == window, XLAL_EFAILED, "error: window names are not case-insensitive\n" );
+
+	/* invalid names and parameters are rejected */
+	XLAL_TRY_SILENT ( window = XLALGetCachedNamedREAL8Window("nonesuch", 0, 1024), i );
+	XLAL_CHECK ( window == NULL && i == (XLAL_EFUNC | XLAL_EINVAL), XLAL_EFAILED, "error: cached window accepted invalid name\n" );
+	XLAL_TRY_SILENT ( window = XLALGetCachedNamedREAL8Window("hann", 1, 1024), i );
+	XLAL_CHECK ( window == NULL && i == (XLAL_EFUNC | XLAL_EINVAL), XLAL_EFAILED, "error: cached window accepted invalid parameter\n" );
+	XLAL_TRY_SILENT ( window = XLALGetCachedNamedREAL8Window("tukey", 2, 1024), i );
+	XLAL_CHECK ( window == NULL && i == (XLAL_EFUNC | XLAL_ERANGE), XLAL_EFAILED, "error: cached window accepted out-of-range parameter\n" );
+
+	/* many windows, requested concurrently, make the cache grow */
+	int fail = 0;
+#pragma omp parallel for reduction(+:fail)
+	for(i = 0; i < 1000; i++) {
+		const REAL8Window *w = XLALGetCachedNamedREAL8Window("tukey", (i % 10) / 10.0, 16 + i / 10);
+		if(w == NULL || w != XLALGetCachedNamedREAL8Window("tukey", (i % 10) / 10.0, 16 + i / 10) || w->data->length != (UINT4) (16 + i / 10))
+			fail++;
+	}
+	XLAL_CHECK ( fail == 0, XLAL_EFAILED, "error: %d concurrently cached windows are wrong\n", fail );
+
+	XLALClearWindowCache();
+
+	return XLAL_SUCCESS;
+
+} // test_cached_windows()
+
+
 /*
  * Display sample windows.
  */
@@ -525,6 +610,11 @@ int main(void)
 	if(test_parameter_safety())
 		fail = 1;
 
+	/* Cached windows */
+
+	if(test_cached_windows())
+		fail = 1;
+
 	/* Verbosity */
 
 	display();
@@ -150,6 +150,8 @@ typedef struct {
   FstatInputVector* Fstat_in_vec_recalc; /**< Recalculate the toplist: Vector of Fstat input data structures for XLALComputeFstat(), one per stack */
   PulsarParamsVector *injectionSources; ///< Source parameters to inject: comma-separated list of file-patterns and/or direct config-strings ('{...}')
   BOOLEAN collectFstatTiming;		///< flag whether to collect and output F-stat timing info
+  UINT4 SFTloadThreads;			///< number of threads used to read SFT files concurrently
+  BOOLEAN SFTprefetch;			///< load the SFTs of the next segment in the background
 } UsefulStageVariables;
 
 
@@ -418,6 +420,8 @@ int main( int argc, char *argv[]) {
   INT4 uvar_metricType1 = LAL_PMETRIC_COH_PTOLE_ANALYTIC;
   INT4 uvar_gridType1 = GRID_METRIC;
   INT4 uvar_skyPointIndex = -1;
+  INT4 uvar_SFTloadThreads = 1;
+  BOOLEAN uvar_SFTprefetch = FALSE;
 
   CHAR *uvar_ephemEarth;	/**< Earth ephemeris file to use */
   CHAR *uvar_ephemSun;		/**< Sun ephemeris file to use */
@@ -532,6 +536,8 @@ int main( int argc, char *argv[]) {
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_Dterms,              "Dterms",              INT4,         0,   DEVELOPER,  "Number of kernel terms (single-sided) to use in\na) Dirichlet kernel if FstatMethod=Demod*\nb) sinc-interpolation kernel if FstatMethod=Resamp*" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_DtermsRecalc,        "DtermsRecalc",        INT4,         0,   DEVELOPER,  "Same as 'Dterms', applies to 'Recalc' step" ) == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_skyPointIndex,       "skyPointIndex",       INT4,         0,   DEVELOPER,  "Only analyze this skypoint in grid" ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_SFTloadThreads,      "SFTloadThreads",      INT4,         0,   DEVELOPER,  "Number of threads used to read SFT files concurrently" ) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_SFTprefetch,         "SFTprefetch",         BOOLEAN,      0,   DEVELOPER,  "Load the SFTs of the next segment in the background while setting up the current segment" ) == XLAL_SUCCESS, XLAL_EFUNC);
 
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTiming,        "outputTiming",        STRING,       0,   DEVELOPER,  "Append timing information into this file") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTimingDetails, "outputTimingDetails", STRING,       0,   DEVELOPER,  "Append detailed averaged F-stat timing information to this file") == XLAL_SUCCESS, XLAL_EFUNC);
@@ -786,6 +792,9 @@ int main( int argc, char *argv[]) {
   usefulParams.Fmethod = uvar_FstatMethod;
   usefulParams.FmethodRecalc = uvar_FstatMethodRecalc;
   usefulParams.recalcToplistStats = uvar_recalcToplistStats;
+  XLAL_CHECK_MAIN( uvar_SFTloadThreads > 0, XLAL_EDOM, "Invalid value of SFTloadThreads = %d, must be > 0\n", uvar_SFTloadThreads );
+  usefulParams.SFTloadThreads = uvar_SFTloadThreads;
+  usefulParams.SFTprefetch = uvar_SFTprefetch;
 
   usefulParams.mismatch1 = uvar_mismatch1;
 
@@ -2267,12 +2276,34 @@ void SetUpSFTs( LALStatus *status,			/**< pointer to LALStatus structure */
   optionalArgs.FstatMethod = in->Fmethod;
   optionalArgs.collectTiming = in->collectFstatTiming;
   optionalArgs.injectSources = in->injectionSources;
+  optionalArgs.loadSFTsNumThreads = in->SFTloadThreads;
+
+  /* if requested, load the SFTs of the next segment in the background while setting up the current one */
+  SFTPrefetcher *prefetcher = NULL;
+  if ( in->SFTprefetch ) {
+    if ( ( prefetcher = XLALCreateSFTPrefetcher( in->SFTloadThreads ) ) == NULL ) {
+      XLALPrintError("%s: XLALCreateSFTPrefetcher() failed with errno=%d", __func__, xlalErrno);
+      ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
+    }
+    optionalArgs.prefetchSFTs = prefetcher;
+    if ( XLALFstatPrefetchSFTs( prefetcher, &catalogSeq.data[0], freqmin, freqmax, &optionalArgs ) != XLAL_SUCCESS ) {
+      XLALPrintError("%s: XLALFstatPrefetchSFTs() failed with errno=%d", __func__, xlalErrno);
+      ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
+    }
+  }
 
   FstatOptionalArgs XLAL_INIT_DECL(optionalArgsRecalc);
 
   /* loop over segments and read sfts */
   for (k = 0; k < in->nStacks; k++) {
 
+    if ( prefetcher != NULL && k + 1 < in->nStacks ) {
+      if ( XLALFstatPrefetchSFTs( prefetcher, &catalogSeq.data[k + 1], freqmin, freqmax, &optionalArgs ) != XLAL_SUCCESS ) {
+        XLALPrintError("%s: XLALFstatPrefetchSFTs() failed with errno=%d", __func__, xlalErrno);
+        ABORT ( status, HIERARCHICALSEARCH_EXLAL, HIERARCHICALSEARCH_MSGEXLAL );
+      }
+    }
+
     /* if flag is given, assume a PSD with sqrt(S) = 1.0 */
     MultiNoiseFloor s_assumeSqrtSX;
     if ( in->assumeSqrtSX != NULL ) {
@@ -2375,6 +2406,7 @@ void SetUpSFTs( LALStatus *status,			/**< pointer to LALStatus structure */
     } /* if have segmentList */
 
   } /* loop over k */
+  XLALDestroySFTPrefetcher( prefetcher );
   for (UINT4 X = 0; X < numDetectors; X++) {
     in->NSegmentsInvX[X] = 1.0 / in->NSegmentsInvX[X]; /* now it is the inverse number */
   }
@@ -146,6 +146,8 @@ struct CommandLineArgsTag {
   REAL8 overlapFraction;   /* 12/28/05 gam; overlap fraction (for use with windows; e.g., use -P 0.5 with -w 3 Hann windows; default is 1.0). */
   BOOLEAN useSingle;       /* 11/19/05 gam; use single rather than double precision */
   char *frameStructType;   /* 01/10/07 gam */
+  char *h5File;            /* write SFTs to this band-chunked HDF5 SFT container instead of SFT files */
+  REAL8 h5ChunkBand;       /* frequency band of each chunk of the HDF5 SFT container */
 } CommandLineArgs;
 
 struct headertag {
@@ -186,6 +188,8 @@ COMPLEX16Vector *fftDataDouble = NULL;
 REAL4FFTPlan *fftPlanSingle;           /* 11/19/05 gam; fft plan and data container, single precision case */
 COMPLEX8Vector *fftDataSingle = NULL;
 
+SFTVector *h5SFTs = NULL;              /* SFTs to write to the HDF5 SFT container; all are held in memory until it is written at the end */
+
 #ifdef PSS_ENABLED
 XLALPSSParamSet XLALPSSParams;
 #endif
@@ -559,6 +563,18 @@ int main(int argc,char *argv[])
       gpsepoch.gpsNanoSeconds = 0;
     }
 
+  /* write all SFTs to the HDF5 SFT container */
+  if (h5SFTs != NULL) {
+    UINT4 chunkBins = (UINT4)(CommandLineArgs.h5ChunkBand*CommandLineArgs.T+0.5);
+    if (chunkBins < 1) chunkBins = 1;
+    if (XLALWriteSFTVector2H5File(h5SFTs, CommandLineArgs.h5File, chunkBins, CommandLineArgs.commentField) != XLAL_SUCCESS) {
+      fprintf(stderr, "Failed to write SFT container '%s'\n", CommandLineArgs.h5File);
+      return 7;
+    }
+    XLALDestroySFTVector(h5SFTs);
+    h5SFTs = NULL;
+  }
+
   if(FreeMem(CommandLineArgs)) return 8;
 
   #if TRACKMEMUSE
@@ -607,6 +623,8 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
     {"pss-edge",             required_argument, NULL,          516},
     {"pss-ext",              required_argument, NULL,          517},
 #endif
+    {"hdf5-output",          required_argument, NULL,          518},
+    {"hdf5-chunk-band",      required_argument, NULL,          519},
     {"ht-data",              no_argument,       NULL,          'H'},
     {"use-single",           no_argument,       NULL,          'S'},
     {"help",                 no_argument,       NULL,          'h'},
@@ -639,6 +657,8 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
   CLA->PSSCleaning = 0;	     /* 1=YES and 0=NO*/
   CLA->PSSCleanHPf = 100.0;  /* Cut frequency for the bilateral highpass filter. It has to be used only if PSSCleaning is YES. defaults to 100Hz */
   CLA->PSSCleanExt = 1;      /* by default, extend the timeseries */
+  CLA->h5File = NULL;        /* by default, write SFT files */
+  CLA->h5ChunkBand = 0.05;   /* by default, store the HDF5 SFT container in 0.05 Hz chunks */
 
   strcat(allargs, "\nMakeSFTs ");
   strcat(allargs, lalVCSIdentInfo.vcsId);
@@ -800,6 +820,12 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       CLA->PSSCleanExt = atoi(LALoptarg);
       break;
 #endif
+    case 518:
+      CLA->h5File = LALoptarg;
+      break;
+    case 519:
+      CLA->h5ChunkBand = atof(LALoptarg);
+      break;
     case 'h':
       /* print usage/help message */
       fprintf(stdout,"Arguments are:\n");
@@ -825,6 +851,8 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       fprintf(stdout,"\tuse-single (-S)\t\tFLAG\t (optional) Use single precision for window, plan, and fft; double precision filtering is always done.\n");
       fprintf(stdout,"\tframe-struct-type (-u)\tSTRING\t (optional) String specifying the input frame structure and data type. Must begin with ADC_ or PROC_ followed by REAL4, REAL8, INT2, INT4, or INT8; default: ADC_REAL4; -H is the same as PROC_REAL8.\n");
       fprintf(stdout,"\ttd-cleaning (-a)\tFLAG\t Use time-domain cleaning with PSS routines\n");
+      fprintf(stdout,"\thdf5-output        \tSTRING\t (optional) Write all SFTs to this band-chunked HDF5 SFT container instead of SFT files in sft-write-path (requires version 2 SFTs). All SFTs are held in memory until the container is written at the end, which needs 8 bytes per frequency bin per SFT, i.e. about 8 x time-baseline x frequency-band bytes per SFT; if this exceeds the available memory, split the analysis time into several runs with separate containers.\n");
+      fprintf(stdout,"\thdf5-chunk-band    \tFLOAT\t (optional) Frequency band in Hz of each chunk of the HDF5 SFT container (default is 0.05 Hz).\n");
 #ifdef PSS_ENABLED
       fprintf(stdout,"\tpss-freq (-b)      \tFLOAT\t Cut frequency for the bilateral highpass filter for time-domain cleaning\n");
       fprintf(stdout,"\tpss-abs            \tFLOAT\t (optional) Set PSS parameter 'abs' for time-domain cleaning\n");
@@ -927,12 +955,24 @@ int ReadCommandLine(int argc,char *argv[],struct CommandLineArgsTag *CLA)
       fprintf(stderr,"Try %s -h \n", argv[0]);
       return 1;
     }      
-  if(CLA->SFTpath == NULL)
+  if(CLA->SFTpath == NULL && CLA->h5File == NULL)
     {
       fprintf(stderr,"No output path specified for SFTs.\n");
       fprintf(stderr,"Try %s -h \n", argv[0]);
       return 1;
     }      
+  if(CLA->h5File != NULL && CLA->sftVersion != 2)
+    {
+      fprintf(stderr,"An HDF5 SFT container can only be written for version 2 SFTs.\n");
+      fprintf(stderr,"Try %s -h \n", argv[0]);
+      return 1;
+    }
+  if(CLA->h5File != NULL && CLA->h5ChunkBand <= 0.0)
+    {
+      fprintf(stderr,"Illegal hdf5-chunk-band option given.\n");
+      fprintf(stderr,"Try %s -h \n", argv[0]);
+      return 1;
+    }
   if(CLA->PSSCleaning)
 #ifdef PSS_ENABLED
     {
@@ -2062,9 +2102,9 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
   ifo[2] = '\0'; /* null terminate */
   sprintf(gpstime,"%09d",gpsepoch.gpsSeconds);
 
-  strcpy( sftname, CLA.SFTpath );
+  strcpy( sftname, CLA.h5File != NULL ? "." : CLA.SFTpath );
   /* 12/27/05 gam; add option to make directories based on gps time */
-  if (CLA.makeGPSDirs > 0) {
+  if (CLA.makeGPSDirs > 0 && CLA.h5File == NULL) {
      /* 12/27/05 gam; concat to the sftname the directory name based on GPS time; make this directory if it does not already exist */
      mkSFTDir(sftname, site, numSFTs, ifo, CLA.stringT, CLA.miscDesc, gpstime, CLA.makeGPSDirs);
   }
@@ -2144,12 +2184,20 @@ int WriteVersion2SFT(struct CommandLineArgsTag CLA)
     #endif
   }  
 
-  /* write the SFT */
-  XLAL_CHECK( XLALWriteSFT2file(oneSFT, sftname, CLA.commentField) == XLAL_SUCCESS, XLAL_EFUNC );
+  if (CLA.h5File != NULL) {
+    /* keep the SFT to write to the HDF5 SFT container at the end */
+    if (h5SFTs == NULL) {
+      XLAL_CHECK( ( h5SFTs = XLALCalloc(1, sizeof(*h5SFTs)) ) != NULL, XLAL_ENOMEM );
+    }
+    XLAL_CHECK( XLALAppendSFT2Vector(h5SFTs, oneSFT) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    /* write the SFT */
+    XLAL_CHECK( XLALWriteSFT2file(oneSFT, sftname, CLA.commentField) == XLAL_SUCCESS, XLAL_EFUNC );
 
-  /* 01/09/06 gam; sftname is temporary; move to sftnameFinal. */
-  if(CLA.makeTmpFile) {  
-    mvFilenames(sftname,sftnameFinal);
+    /* 01/09/06 gam; sftname is temporary; move to sftnameFinal. */
+    if(CLA.makeTmpFile) {
+      mvFilenames(sftname,sftnameFinal);
+    }
   }
 
   XLALDestroySFT (oneSFT);
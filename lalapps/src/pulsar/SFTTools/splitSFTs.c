@@ -57,6 +57,7 @@
 #include <lal/LALHashTbl.h>
 #include <lal/Date.h>
 #include <lal/SFTfileIO.h>
+#include <lal/SFTutils.h>
 #include <LALAppsVCSInfo.h>
 #include "SFTReferenceLibrary.h"
 
@@ -229,6 +230,9 @@ int main( int argc, char **argv )
   int assumeSorted = 0;                /* Are SFT input files chronologically sorted? */
   int sfterrno = 0;                    /* SFT error number return from reference library */
   LALHashTbl *nbsfts = NULL;           /* hash table of existing narrow-band SFTs */
+  char *h5file = NULL;                 /* name of band-chunked HDF5 SFT container to write */
+  SFTVector *h5sfts = NULL;            /* SFTs to write to the HDF5 SFT container */
+  char *h5comment = NULL;              /* comment of the HDF5 SFT container */
 
   /* initialize throtteling */
   time( &read_bandwidth.last_checked );
@@ -263,6 +267,7 @@ int main( int argc, char **argv )
              "  [-m|--factor <factor>]\n"
              "  [-d|--detector <detector>]\n"
              "  [-n|--output-directory <outputdirectory>]\n"
+             "  [-H5|--hdf5-output <containerfile>]\n"
              "  [--] <inputfile> ...\n"
              "\n"
              "  This program reads in binary SFTs (v1 and v2) and writes out narrow-banded\n"
@@ -325,6 +330,13 @@ int main( int argc, char **argv )
              "  sorted, which means the program will stop as soon as an SFT located after the\n" 
              "  specified range is encountered.\n"
              "\n"
+             "  If '-H5' is given, instead of narrow-band SFT files, a single band-chunked HDF5 SFT\n"
+             "  container is written to <containerfile>, containing the band from start bin to end bin\n"
+             "  of all input SFTs (which must be from the same detector and chronologically sorted),\n"
+             "  stored in chunks of <sftbins> bins (the overlap is ignored). The container can be read\n"
+             "  with XLALSFTdataFind() and XLALLoadSFTs() like an ordinary SFT file, but reading a band\n"
+             "  only reads the chunks which overlap it.\n"
+             "\n"
              "  After all options (and an optional '--' separator), the input files are given, as many\n"
              "  as you wish (or the OS supports - using xargs should be simple with this command-line\n"
              "  syntax).\n"
@@ -412,6 +424,9 @@ int main( int argc, char **argv )
     } else if ( ( strcmp( argv[arg], "-n" ) == 0 ) ||
                 ( strcmp( argv[arg], "--output-directory" ) == 0 ) ) {
       outdir = argv[++arg];
+    } else if ( ( strcmp( argv[arg], "-H5" ) == 0 ) ||
+                ( strcmp( argv[arg], "--hdf5-output" ) == 0 ) ) {
+      h5file = argv[++arg];
     } else if ( ( strcmp( argv[arg], "-rb" ) == 0 ) ||
                 ( strcmp( argv[arg], "--read-bandwidth" ) == 0 ) ) {
       read_bandwidth.resource_rate = atoi( argv[++arg] );
@@ -459,6 +474,11 @@ int main( int argc, char **argv )
   /* check output directory exists */
   XLAL_CHECK_MAIN( is_directory( outdir ), XLAL_ESYS, "output directory does not exist" );
 
+  /* create vector of SFTs for the HDF5 SFT container */
+  if ( h5file != NULL ) {
+    XLAL_CHECK_MAIN( ( h5sfts = XLALCalloc( 1, sizeof( *h5sfts ) ) ) != NULL, XLAL_ENOMEM, "out of memory allocating SFT vector" );
+  }
+
   /* allocate space for output filename */
   const size_t outnamelen = strlen( outdir ) + 256;
   XLAL_CHECK_MAIN( ( outname = ( char * )XLALMalloc( outnamelen ) ) != NULL, XLAL_ENOMEM, "out of memory allocating outname" );
@@ -655,8 +675,29 @@ int main( int argc, char **argv )
         data[bin] *= factor * conversion_factor;
       }
 
+      /* append the band to the SFTs for the HDF5 SFT container, instead of writing narrow-band SFTs */
+      if ( h5sfts != NULL ) {
+        unsigned int h5bins = endBin - startBin + 1 < nactivesamples ? endBin - startBin + 1 : nactivesamples;
+        SFTtype *sft = XLALCreateSFT( h5bins );
+        XLAL_CHECK_MAIN( sft != NULL, XLAL_EFUNC, "XLALCreateSFT() failed" );
+        XLAL_CHECK_MAIN( snprintf( sft->name, sizeof( sft->name ), "%c%c", detector[0], detector[1] ) < ( int )sizeof( sft->name ),
+                         XLAL_ESYS, "output of snprintf() was truncated" );
+        sft->epoch.gpsSeconds = hd.gps_sec;
+        sft->epoch.gpsNanoSeconds = hd.gps_nsec;
+        sft->deltaF = 1.0 / hd.tbase;
+        sft->f0 = startBin * sft->deltaF;
+        for ( bin = 0; bin < h5bins; bin++ ) {
+          sft->data->data[bin] = crectf( data[2 * bin], data[2 * bin + 1] );
+        }
+        XLAL_CHECK_MAIN( XLALAppendSFT2Vector( h5sfts, sft ) == XLAL_SUCCESS, XLAL_EFUNC, "XLALAppendSFT2Vector() failed" );
+        XLALDestroySFT( sft );
+        if ( h5comment == NULL && comment != NULL ) {
+          XLAL_CHECK_MAIN( ( h5comment = XLALStringDuplicate( comment ) ) != NULL, XLAL_EFUNC, "XLALStringDuplicate() failed" );
+        }
+      }
+
       /* loop over start bins for output SFTs */
-      for ( bin = startBin; bin < endBin; bin += width - overlap ) {
+      for ( bin = startBin; h5sfts == NULL && bin < endBin; bin += width - overlap ) {
         /* determine the number of bins actually to write from the desired 'width',
            given that the remaining number of bin may be odd (especially from overlapping)
            and the bins to write need to be present in the input sft
@@ -759,6 +800,15 @@ int main( int argc, char **argv )
 
   } /* loop over input SFT files */
 
+  /* write the HDF5 SFT container */
+  if ( h5sfts != NULL ) {
+    request_resource( &write_open_rate, 1 );
+    XLAL_CHECK_MAIN( XLALWriteSFTVector2H5File( h5sfts, h5file, width, h5comment ) == XLAL_SUCCESS, XLAL_EFUNC,
+                     "could not write SFT container '%s'", h5file );
+    XLALDestroySFTVector( h5sfts );
+    XLALFree( h5comment );
+  }
+
   /* cleanup */
   XLALFree( outname );
   XLALFree( constraint_str );
@@ -24,10 +24,33 @@
 
 #include "CacheResults.h"
 
+#include <unistd.h>
+#include <errno.h>
+#include <zlib.h>
+
 #include <lal/LALHeap.h>
 #include <lal/LALHashTbl.h>
 #include <lal/LALBitset.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Lock used to serialise access to a cache, or to a cache item, which is shared between threads
+#ifdef _OPENMP
+#define CACHE_LOCK_T                    omp_lock_t
+#define CACHE_LOCK_INIT( lock )         omp_init_lock( &(lock) )
+#define CACHE_LOCK_DESTROY( lock )      omp_destroy_lock( &(lock) )
+#define CACHE_LOCK( lock )              omp_set_lock( &(lock) )
+#define CACHE_UNLOCK( lock )            omp_unset_lock( &(lock) )
+#else
+#define CACHE_LOCK_T                    int
+#define CACHE_LOCK_INIT( lock )         do { (void)(lock); } while(0)
+#define CACHE_LOCK_DESTROY( lock )      do { (void)(lock); } while(0)
+#define CACHE_LOCK( lock )              do { (void)(lock); } while(0)
+#define CACHE_UNLOCK( lock )            do { (void)(lock); } while(0)
+#endif
+
 // Compare two quantities, and return a sort order value if they are unequal
 #define COMPARE_BY( x, y ) do { if ( (x) < (y) ) return -1; if ( (x) > (y) ) return +1; } while(0)
 
@@ -43,8 +66,40 @@ typedef struct {
   UINT8 coh_index;
   /// Results of a coherent computation on a single segment
   WeaveCohResults *coh_res;
+  /// Number of cache queries currently using the coherent results of the item
+  UINT4 nusers;
+  /// Whether the item was removed from the cache while still in use
+  BOOLEAN retired;
+  /// Whether coherent results of the item are still being computed
+  BOOLEAN computing;
+  /// Whether computation of coherent results of the item failed
+  BOOLEAN failed;
+  /// Lock held by the thread computing coherent results of the item
+  CACHE_LOCK_T compute_lock;
 } cache_item;
 
+///
+/// Item evicted from the cache which is kept, compressed, in memory or in a scratch file
+///
+typedef struct {
+  /// Generation, used both to find items in cache and to decide how long to keep items
+  UINT4 generation;
+  /// Relevance, used to decide how long to keep items
+  REAL4 relevance;
+  /// Coherent locator index, used to find items in cache
+  UINT8 coh_index;
+  /// Whether item can still be found in the cache; retrieved items are discarded lazily
+  BOOLEAN live;
+  /// Compressed packed coherent results, if kept in memory
+  void *zdata;
+  /// Size of compressed packed coherent results
+  size_t zlen;
+  /// Size of packed coherent results
+  size_t len;
+  /// Offset of compressed packed coherent results in scratch file, if not kept in memory
+  long offset;
+} spill_item;
+
 ///
 /// Container for a series of cache queries
 ///
@@ -97,6 +152,8 @@ struct tagWeaveCacheQueries {
   double semi_relevance_offset;
   /// Number of semicoherent templates (over all queries)
   UINT8 semi_ntmpl;
+  /// Cache items in use by each query, until released
+  cache_item **coh_item;
 };
 
 ///
@@ -135,6 +192,56 @@ struct tagWeaveCache {
   BOOLEAN all_gc;
   /// Save an no-longer-used cache item for re-use
   cache_item *saved_item;
+  /// Number of threads which may share the cache
+  UINT4 nthreads;
+  /// Input data required for computing coherent results, for each thread other than the first
+  WeaveCohInput **thread_coh_input;
+  /// Lock which serialises access to the cache by multiple threads
+  CACHE_LOCK_T lock;
+  /// Whether items evicted from the cache are kept in further tiers (compressed in memory, scratch file)
+  BOOLEAN tiered;
+  /// Maximum memory used by compressed items, in bytes
+  size_t compress_max_bytes;
+  /// Current memory used by compressed items, in bytes
+  size_t compress_bytes;
+  /// Maximum memory used by compressed items obtained by cache, in bytes
+  size_t compress_peak_bytes;
+  /// Heap which ranks compressed items in memory by relevance
+  LALHeap *compress_heap;
+  /// Directory in which to create scratch file; if NULL, items are discarded instead of being written to a scratch file
+  char *scratch_dir;
+  /// Scratch file to which compressed items are written
+  FILE *scratch_file;
+  /// Offset of end of data in scratch file
+  long scratch_end;
+  /// Number of items in scratch file which can still be found in the cache
+  UINT4 scratch_live;
+  /// Heap which ranks compressed items in scratch file by relevance
+  LALHeap *scratch_heap;
+  /// Hash table which looks up compressed items, in memory or in scratch file, by index
+  LALHashTbl *spill_index_hash;
+  /// Buffer for packed coherent results
+  void *pack_buf;
+  /// Buffer for byte-shuffled packed coherent results
+  void *shuffle_buf;
+  /// Size of buffers for packed/shuffled coherent results
+  size_t pack_buf_len;
+  /// Buffer for compressed coherent results
+  void *zbuf;
+  /// Size of buffer for compressed coherent results
+  size_t zbuf_len;
+  /// Number of cache queries satisfied by items in memory
+  UINT8 nhit;
+  /// Number of cache queries which required computation of coherent results
+  UINT8 nmiss;
+  /// Number of items evicted from memory by a fixed-size cache
+  UINT8 nevict;
+  /// Number of cache queries satisfied by compressed items in memory
+  UINT8 ncompress_hit;
+  /// Number of cache queries satisfied by compressed items in scratch file
+  UINT8 nscratch_hit;
+  /// Number of compressed items written to scratch file
+  UINT8 nscratch_put;
 };
 
 ///
@@ -148,6 +255,18 @@ static UINT8 cache_item_hash( const void *x );
 static int cache_item_compare_by_coh_index( const void *x, const void *y );
 static int cache_item_compare_by_relevance( const void *x, const void *y );
 static void cache_item_destroy( void *x );
+static void cache_item_dispose( WeaveCache *cache, cache_item *item );
+static int cache_find_or_add( WeaveCache *cache, const WeaveCacheQueries *queries, const UINT4 query_index, cache_item **item, BOOLEAN *compute );
+static int cache_insert( WeaveCache *cache, const WeaveCacheQueries *queries, const UINT4 query_index, cache_item *new_item, const BOOLEAN computed );
+static UINT8 spill_item_hash( const void *x );
+static int spill_item_compare_by_coh_index( const void *x, const void *y );
+static int spill_item_compare_by_relevance( const void *x, const void *y );
+static void spill_item_destroy( void *x );
+static int cache_spill_buffers( WeaveCache *cache, const size_t len );
+static int cache_spill_clear( WeaveCache *cache );
+static int cache_spill_gc( WeaveCache *cache, const REAL4 semi_relevance );
+static int cache_spill_add( WeaveCache *cache, const cache_item *item, const REAL4 semi_relevance );
+static int cache_spill_retrieve( WeaveCache *cache, const cache_item *key, WeaveCohResults **coh_res, BOOLEAN *retrieved );
 
 /// @}
 
@@ -161,10 +280,30 @@ void cache_item_destroy(
   if ( x != NULL ) {
     cache_item *ix = ( cache_item * ) x;
     XLALWeaveCohResultsDestroy( ix->coh_res );
+    CACHE_LOCK_DESTROY( ix->compute_lock );
     XLALFree( ix );
   }
 }
 
+///
+/// Dispose of a cache item which has been removed from the cache; items still in use are retired,
+/// and disposed of once released by XLALWeaveCacheRelease()
+///
+void cache_item_dispose(
+  WeaveCache *cache,
+  cache_item *item
+  )
+{
+  if ( item->nusers > 0 ) {
+    item->retired = 1;
+  } else if ( cache->saved_item == NULL ) {
+    item->retired = 0;
+    cache->saved_item = item;
+  } else {
+    cache_item_destroy( item );
+  }
+}
+
 ///
 /// Compare cache items by generation, then relevance
 ///
@@ -209,6 +348,338 @@ UINT8 cache_item_hash(
   return hval;
 }
 
+///
+/// Destroy a compressed item
+///
+void spill_item_destroy(
+  void *x
+  )
+{
+  if ( x != NULL ) {
+    spill_item *ix = ( spill_item * ) x;
+    XLALFree( ix->zdata );
+    XLALFree( ix );
+  }
+}
+
+///
+/// Compare compressed items by generation, then relevance
+///
+int spill_item_compare_by_relevance(
+  const void *x,
+  const void *y
+  )
+{
+  const spill_item *ix = ( const spill_item * ) x;
+  const spill_item *iy = ( const spill_item * ) y;
+  COMPARE_BY( ix->generation, iy->generation );   // Compare in ascending order
+  COMPARE_BY( ix->relevance, iy->relevance );   // Compare in ascending order
+  return 0;
+}
+
+///
+/// Compare compressed items by generation, then locator index
+///
+int spill_item_compare_by_coh_index(
+  const void *x,
+  const void *y
+  )
+{
+  const spill_item *ix = ( const spill_item * ) x;
+  const spill_item *iy = ( const spill_item * ) y;
+  COMPARE_BY( ix->generation, iy->generation );   // Compare in ascending order
+  COMPARE_BY( ix->coh_index, iy->coh_index );   // Compare in ascending order
+  return 0;
+}
+
+///
+/// Hash compressed items by generation and locator index
+///
+UINT8 spill_item_hash(
+  const void *x
+  )
+{
+  const spill_item *ix = ( const spill_item * ) x;
+  UINT4 hval = 0;
+  XLALPearsonHash( &hval, sizeof( hval ), &ix->generation, sizeof( ix->generation ) );
+  XLALPearsonHash( &hval, sizeof( hval ), &ix->coh_index, sizeof( ix->coh_index ) );
+  return hval;
+}
+
+///
+/// Ensure that buffers used to compress/decompress items can hold packed coherent results of a given size
+///
+int cache_spill_buffers(
+  WeaveCache *cache,
+  const size_t len
+  )
+{
+  if ( cache->pack_buf_len < len ) {
+    cache->pack_buf = XLALRealloc( cache->pack_buf, len );
+    XLAL_CHECK( cache->pack_buf != NULL, XLAL_ENOMEM );
+    cache->shuffle_buf = XLALRealloc( cache->shuffle_buf, len );
+    XLAL_CHECK( cache->shuffle_buf != NULL, XLAL_ENOMEM );
+    cache->pack_buf_len = len;
+  }
+  const size_t zlen = compressBound( len );
+  if ( cache->zbuf_len < zlen ) {
+    cache->zbuf = XLALRealloc( cache->zbuf, zlen );
+    XLAL_CHECK( cache->zbuf != NULL, XLAL_ENOMEM );
+    cache->zbuf_len = zlen;
+  }
+  return XLAL_SUCCESS;
+}
+
+///
+/// Remove all compressed items, in memory and in scratch file
+///
+int cache_spill_clear(
+  WeaveCache *cache
+  )
+{
+  if ( cache->tiered ) {
+    XLAL_CHECK( XLALHashTblClear( cache->spill_index_hash ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALHeapClear( cache->compress_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALHeapClear( cache->scratch_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
+    cache->compress_bytes = 0;
+    cache->scratch_live = 0;
+    cache->scratch_end = 0;
+  }
+  return XLAL_SUCCESS;
+}
+
+///
+/// Remove compressed items which have already been retrieved, or whose relevance has fallen below
+/// that of the current semicoherent frequency block, and so will never be needed again
+///
+int cache_spill_gc(
+  WeaveCache *cache,
+  const REAL4 semi_relevance
+  )
+{
+
+  // Create a 'fake' item specifying thresholds for item relevance
+  const spill_item relevance_threshold = { .generation = cache->generation, .relevance = semi_relevance };
+
+  // Remove compressed items in memory
+  while ( 1 ) {
+    const spill_item *root = ( const spill_item * ) XLALHeapRoot( cache->compress_heap );
+    XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
+    if ( root == NULL || ( root->live && spill_item_compare_by_relevance( root, &relevance_threshold ) >= 0 ) ) {
+      break;
+    }
+    if ( root->live ) {
+      XLAL_CHECK( XLALHashTblRemove( cache->spill_index_hash, root ) == XLAL_SUCCESS, XLAL_EFUNC );
+      cache->compress_bytes -= root->zlen;
+    }
+    XLAL_CHECK( XLALHeapRemoveRoot( cache->compress_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Remove compressed items in scratch file
+  while ( 1 ) {
+    const spill_item *root = ( const spill_item * ) XLALHeapRoot( cache->scratch_heap );
+    XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
+    if ( root == NULL || ( root->live && spill_item_compare_by_relevance( root, &relevance_threshold ) >= 0 ) ) {
+      break;
+    }
+    if ( root->live ) {
+      XLAL_CHECK( XLALHashTblRemove( cache->spill_index_hash, root ) == XLAL_SUCCESS, XLAL_EFUNC );
+      --cache->scratch_live;
+    }
+    XLAL_CHECK( XLALHeapRemoveRoot( cache->scratch_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Reuse the scratch file from the beginning once it holds no items which can still be found
+  if ( cache->scratch_live == 0 ) {
+    XLAL_CHECK( XLALHeapClear( cache->scratch_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
+    cache->scratch_end = 0;
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Compress an item evicted from the cache and keep it in memory, moving the least relevant
+/// compressed items to the scratch file (or discarding them) if memory use exceeds its maximum
+///
+int cache_spill_add(
+  WeaveCache *cache,
+  const cache_item *item,
+  const REAL4 semi_relevance
+  )
+{
+
+  // Remove compressed items which will never be needed again
+  XLAL_CHECK( cache_spill_gc( cache, semi_relevance ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Pack coherent results
+  const size_t len = XLALWeaveCohResultsPackedSize( item->coh_res );
+  XLAL_CHECK( len > 0, XLAL_EFUNC );
+  XLAL_CHECK( cache_spill_buffers( cache, len ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALWeaveCohResultsPack( cache->pack_buf, len, item->coh_res ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Shuffle bytes so that the corresponding bytes of each 4-byte word are contiguous;
+  // this groups together the slowly-varying sign/exponent bytes of the F-statistics,
+  // which greatly improves their compressibility
+  {
+    const size_t nwords = len / 4;
+    const char *src = ( const char * ) cache->pack_buf;
+    char *dst = ( char * ) cache->shuffle_buf;
+    for ( size_t b = 0; b < 4; ++b ) {
+      for ( size_t w = 0; w < nwords; ++w ) {
+        dst[b * nwords + w] = src[w * 4 + b];
+      }
+    }
+    memcpy( dst + 4 * nwords, src + 4 * nwords, len - 4 * nwords );
+  }
+
+  // Compress packed coherent results
+  uLongf zlen = cache->zbuf_len;
+  XLAL_CHECK( compress2( cache->zbuf, &zlen, cache->shuffle_buf, len, 1 ) == Z_OK, XLAL_EFAILED, "zlib compression of cache item failed" );
+
+  // Create compressed item
+  spill_item *new_item = XLALCalloc( 1, sizeof( *new_item ) );
+  XLAL_CHECK( new_item != NULL, XLAL_ENOMEM );
+  new_item->generation = item->generation;
+  new_item->relevance = item->relevance;
+  new_item->coh_index = item->coh_index;
+  new_item->live = 1;
+  new_item->len = len;
+  new_item->zlen = zlen;
+  new_item->zdata = XLALMalloc( zlen );
+  XLAL_CHECK( new_item->zdata != NULL, XLAL_ENOMEM );
+  memcpy( new_item->zdata, cache->zbuf, zlen );
+
+  // Add compressed item to the index hash table and the relevance heap of compressed items in memory
+  XLAL_CHECK( XLALHashTblAdd( cache->spill_index_hash, new_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALHeapAdd( cache->compress_heap, ( void ** ) &new_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( new_item == NULL, XLAL_EFAILED );
+  cache->compress_bytes += zlen;
+  if ( cache->compress_peak_bytes < cache->compress_bytes ) {
+    cache->compress_peak_bytes = cache->compress_bytes;
+  }
+
+  // Move least relevant compressed items out of memory until memory use is below its maximum
+  while ( cache->compress_bytes > cache->compress_max_bytes ) {
+
+    // Remove least relevant compressed item from memory
+    spill_item *cold_item = ( spill_item * ) XLALHeapExtractRoot( cache->compress_heap );
+    XLAL_CHECK( cold_item != NULL, XLAL_EFUNC );
+    if ( !cold_item->live ) {
+      spill_item_destroy( cold_item );
+      continue;
+    }
+    cache->compress_bytes -= cold_item->zlen;
+
+    // Discard compressed item if there is no scratch file
+    if ( cache->scratch_dir == NULL ) {
+      XLAL_CHECK( XLALHashTblRemove( cache->spill_index_hash, cold_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+      spill_item_destroy( cold_item );
+      continue;
+    }
+
+    // Create scratch file if needed; it is removed as soon as it is created, and so is deleted once closed
+    if ( cache->scratch_file == NULL ) {
+      char *scratch_path = XLALStringAppendFmt( NULL, "%s/WeaveCache.XXXXXX", cache->scratch_dir );
+      XLAL_CHECK( scratch_path != NULL, XLAL_EFUNC );
+      const int fd = mkstemp( scratch_path );
+      XLAL_CHECK( fd >= 0, XLAL_EIO, "Could not create cache scratch file '%s': %s", scratch_path, strerror( errno ) );
+      unlink( scratch_path );
+      XLALFree( scratch_path );
+      cache->scratch_file = fdopen( fd, "w+b" );
+      XLAL_CHECK( cache->scratch_file != NULL, XLAL_EIO, "Could not open cache scratch file: %s", strerror( errno ) );
+      cache->scratch_end = 0;
+    }
+
+    // Write compressed item to scratch file
+    XLAL_CHECK( fseek( cache->scratch_file, cache->scratch_end, SEEK_SET ) == 0, XLAL_EIO, "Could not seek in cache scratch file: %s", strerror( errno ) );
+    XLAL_CHECK( fwrite( cold_item->zdata, 1, cold_item->zlen, cache->scratch_file ) == cold_item->zlen, XLAL_EIO, "Could not write to cache scratch file: %s", strerror( errno ) );
+    cold_item->offset = cache->scratch_end;
+    cache->scratch_end += cold_item->zlen;
+    XLALFree( cold_item->zdata );
+    cold_item->zdata = NULL;
+    ++cache->nscratch_put;
+
+    // Add compressed item to the relevance heap of compressed items in scratch file
+    XLAL_CHECK( XLALHeapAdd( cache->scratch_heap, ( void ** ) &cold_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( cold_item == NULL, XLAL_EFAILED );
+    ++cache->scratch_live;
+
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Retrieve coherent results from a compressed item, in memory or in scratch file, if found
+///
+int cache_spill_retrieve(
+  WeaveCache *cache,
+  const cache_item *key,
+  WeaveCohResults **coh_res,
+  BOOLEAN *retrieved
+  )
+{
+
+  *retrieved = 0;
+
+  // Look for compressed item
+  const spill_item find_key = { .generation = key->generation, .coh_index = key->coh_index };
+  spill_item *find_item = NULL;
+  XLAL_CHECK( XLALHashTblFind( cache->spill_index_hash, &find_key, ( const void ** ) &find_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( find_item == NULL ) {
+    return XLAL_SUCCESS;
+  }
+  XLAL_CHECK( cache_spill_buffers( cache, find_item->len ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Get compressed packed coherent results, from memory or from scratch file
+  const void *zdata = find_item->zdata;
+  if ( zdata == NULL ) {
+    XLAL_CHECK( fseek( cache->scratch_file, find_item->offset, SEEK_SET ) == 0, XLAL_EIO, "Could not seek in cache scratch file: %s", strerror( errno ) );
+    XLAL_CHECK( fread( cache->zbuf, 1, find_item->zlen, cache->scratch_file ) == find_item->zlen, XLAL_EIO, "Could not read from cache scratch file" );
+    zdata = cache->zbuf;
+  }
+
+  // Decompress packed coherent results
+  uLongf len = find_item->len;
+  XLAL_CHECK( uncompress( cache->shuffle_buf, &len, zdata, find_item->zlen ) == Z_OK && len == find_item->len, XLAL_EFAILED, "zlib decompression of cache item failed" );
+
+  // Unshuffle bytes
+  {
+    const size_t nwords = len / 4;
+    const char *src = ( const char * ) cache->shuffle_buf;
+    char *dst = ( char * ) cache->pack_buf;
+    for ( size_t b = 0; b < 4; ++b ) {
+      for ( size_t w = 0; w < nwords; ++w ) {
+        dst[w * 4 + b] = src[b * nwords + w];
+      }
+    }
+    memcpy( dst + 4 * nwords, src + 4 * nwords, len - 4 * nwords );
+  }
+
+  // Unpack coherent results
+  XLAL_CHECK( XLALWeaveCohResultsUnpack( coh_res, cache->pack_buf, len ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Remove compressed item from the index hash table; it is removed from its relevance heap lazily
+  XLAL_CHECK( XLALHashTblRemove( cache->spill_index_hash, find_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  find_item->live = 0;
+  if ( find_item->zdata != NULL ) {
+    cache->compress_bytes -= find_item->zlen;
+    XLALFree( find_item->zdata );
+    find_item->zdata = NULL;
+    ++cache->ncompress_hit;
+  } else {
+    --cache->scratch_live;
+    ++cache->nscratch_hit;
+  }
+
+  *retrieved = 1;
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Sample points on surface of coherent bounding box, convert to semicoherent supersky
 /// coordinates, and record maximum value of semicoherent coordinate in dimension 'dim0'
@@ -338,6 +809,8 @@ WeaveCacheQueries *XLALWeaveCacheQueriesCreate(
   XLAL_CHECK_NULL( queries->coh_nres != NULL, XLAL_ENOMEM );
   queries->coh_ntmpl = XLALCalloc( nqueries, sizeof( *queries->coh_ntmpl ) );
   XLAL_CHECK_NULL( queries->coh_ntmpl != NULL, XLAL_ENOMEM );
+  queries->coh_item = XLALCalloc( nqueries, sizeof( *queries->coh_item ) );
+  XLAL_CHECK_NULL( queries->coh_item != NULL, XLAL_ENOMEM );
 
   // Set fields
   queries->semi_rssky_transf = semi_rssky_transf;
@@ -394,6 +867,7 @@ void XLALWeaveCacheQueriesDestroy(
     XLALFree( queries->coh_relevance );
     XLALFree( queries->coh_nres );
     XLALFree( queries->coh_ntmpl );
+    XLALFree( queries->coh_item );
     XLALFree( queries );
   }
 }
@@ -610,6 +1084,32 @@ int XLALWeaveCacheQueriesGetCounts(
 
 }
 
+///
+/// Add the counts of computed coherent results, and of coherent and semicoherent templates, from one
+/// set of queries (e.g. used by another thread) to the counts of another
+///
+int XLALWeaveCacheQueriesAddCounts(
+  WeaveCacheQueries *queries,
+  const WeaveCacheQueries *other
+  )
+{
+
+  // Check input
+  XLAL_CHECK( queries != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( queries->nqueries == other->nqueries, XLAL_EINVAL );
+
+  // Add counts
+  for ( size_t i = 0; i < queries->nqueries; ++i ) {
+    queries->coh_nres[i] += other->coh_nres[i];
+    queries->coh_ntmpl[i] += other->coh_ntmpl[i];
+  }
+  queries->semi_ntmpl += other->semi_ntmpl;
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Create a cache
 ///
@@ -633,6 +1133,7 @@ WeaveCache *XLALWeaveCacheCreate(
   XLAL_CHECK_NULL( cache != NULL, XLAL_ENOMEM );
 
   // Set fields
+  cache->nthreads = 1;
   cache->coh_rssky_transf = coh_rssky_transf;
   cache->semi_rssky_transf = semi_rssky_transf;
   cache->coh_input = coh_input;
@@ -756,6 +1257,9 @@ WeaveCache *XLALWeaveCacheCreate(
   cache->coh_computed_bitset = XLALBitsetCreate();
   XLAL_CHECK_NULL( cache->coh_computed_bitset != NULL, XLAL_EFUNC );
 
+  // Initialise lock which serialises access to the cache
+  CACHE_LOCK_INIT( cache->lock );
+
   return cache;
 
 }
@@ -772,11 +1276,108 @@ void XLALWeaveCacheDestroy(
     XLALHeapDestroy( cache->relevance_heap );
     XLALHashTblDestroy( cache->coh_index_hash );
     cache_item_destroy( cache->saved_item );
+    XLALHeapDestroy( cache->compress_heap );
+    XLALHeapDestroy( cache->scratch_heap );
+    XLALHashTblDestroy( cache->spill_index_hash );
+    if ( cache->scratch_file != NULL ) {
+      fclose( cache->scratch_file );
+    }
+    XLALFree( cache->scratch_dir );
+    XLALFree( cache->pack_buf );
+    XLALFree( cache->shuffle_buf );
+    XLALFree( cache->zbuf );
     XLALBitsetDestroy( cache->coh_computed_bitset );
+    if ( cache->thread_coh_input != NULL ) {
+      for ( size_t t = 0; t + 1 < cache->nthreads; ++t ) {
+        XLALWeaveCohInputDestroy( cache->thread_coh_input[t] );
+      }
+      XLALFree( cache->thread_coh_input );
+    }
+    CACHE_LOCK_DESTROY( cache->lock );
     XLALFree( cache );
   }
 }
 
+///
+/// Allow a cache to be shared by the \p nthreads threads of an OpenMP parallel region. Cache items,
+/// and the record of which coherent results have ever been computed, are shared between threads,
+/// while each thread computes coherent results using its own copy of the coherent input data (see
+/// XLALWeaveCohInputThreadCopy()). Coherent results are computed without holding the cache lock;
+/// a thread which queries an item being computed by another thread waits for the computation to
+/// finish. Coherent results returned by XLALWeaveCacheRetrieve() remain valid, even if evicted from
+/// the cache by another thread, until released by XLALWeaveCacheRelease().
+///
+int XLALWeaveCacheSetThreads(
+  WeaveCache *cache,
+  const UINT4 nthreads
+  )
+{
+
+  // Check input
+  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nthreads > 0, XLAL_EINVAL );
+  XLAL_CHECK( cache->nthreads == 1, XLAL_EINVAL, "Cache threads have already been set" );
+
+  // Create copies of the coherent input data for each thread other than the first
+  if ( nthreads > 1 ) {
+    cache->thread_coh_input = XLALCalloc( nthreads - 1, sizeof( *cache->thread_coh_input ) );
+    XLAL_CHECK( cache->thread_coh_input != NULL, XLAL_ENOMEM );
+    cache->nthreads = nthreads;
+    for ( size_t t = 0; t + 1 < nthreads; ++t ) {
+      cache->thread_coh_input[t] = XLALWeaveCohInputThreadCopy( cache->coh_input );
+      XLAL_CHECK( cache->thread_coh_input[t] != NULL, XLAL_EFUNC );
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Keep items evicted from a fixed-size cache in further tiers, instead of discarding them: evicted
+/// items are compressed and kept in memory, up to a maximum of \p compress_max_bytes; once this is
+/// exceeded, the least relevant compressed items are written to a scratch file created in \p
+/// scratch_dir, or discarded if \p scratch_dir is NULL. Compressed items are retrieved in preference
+/// to recomputing coherent results. The scratch file is removed as soon as it is created, and is
+/// therefore deleted when the cache is destroyed, or if the program terminates.
+///
+int XLALWeaveCacheSetTiers(
+  WeaveCache *cache,
+  const UINT8 compress_max_bytes,
+  const char *scratch_dir
+  )
+{
+
+  // Check input
+  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
+  XLAL_CHECK( !cache->any_gc, XLAL_EINVAL, "Cache tiers require a fixed-size cache" );
+  XLAL_CHECK( !cache->tiered, XLAL_EINVAL, "Cache tiers have already been set" );
+
+  // Set cache tier parameters
+  cache->tiered = 1;
+  cache->compress_max_bytes = compress_max_bytes;
+  if ( scratch_dir != NULL ) {
+    cache->scratch_dir = XLALStringDuplicate( scratch_dir );
+    XLAL_CHECK( cache->scratch_dir != NULL, XLAL_EFUNC );
+  }
+
+  // Create heaps which rank compressed items, in memory and in scratch file, by relevance. Items
+  // which are retrieved are marked as no longer live, and are removed from the heaps lazily.
+  // Items removed from the heaps are destroyed by calling spill_item_destroy().
+  cache->compress_heap = XLALHeapCreate( spill_item_destroy, 0, -1, spill_item_compare_by_relevance );
+  XLAL_CHECK( cache->compress_heap != NULL, XLAL_EFUNC );
+  cache->scratch_heap = XLALHeapCreate( spill_item_destroy, 0, -1, spill_item_compare_by_relevance );
+  XLAL_CHECK( cache->scratch_heap != NULL, XLAL_EFUNC );
+
+  // Create a hash table which looks up compressed items by partition and locator index. Items
+  // removed from the hash table are NOT destroyed, since items are shared with the heaps.
+  cache->spill_index_hash = XLALHashTblCreate( NULL, spill_item_hash, spill_item_compare_by_coh_index );
+  XLAL_CHECK( cache->spill_index_hash != NULL, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Write various information from caches to a FITS file
 ///
@@ -801,6 +1402,38 @@ int XLALWeaveCacheWriteInfo(
     XLAL_CHECK_MAIN( XLALFITSHeaderWriteUINT4( file, "cachemax", heap_max_size, "maximum size obtained by cache" ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
 
+  // Write total number of cache hits, misses, and evictions
+  {
+    UINT8 nhit = 0, nmiss = 0, nevict = 0;
+    for ( size_t i = 0; i < ncache; ++i ) {
+      nhit += cache[i]->nhit;
+      nmiss += cache[i]->nmiss;
+      nevict += cache[i]->nevict;
+    }
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cachehit", nhit, "number of cache hits" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cachemiss", nmiss, "number of cache misses" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cacheevict", nevict, "number of cache evictions" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write total number of hits on, and maximum memory used by, compressed cache items
+  {
+    BOOLEAN tiered = 0;
+    UINT8 ncompress_hit = 0, nscratch_hit = 0, nscratch_put = 0, compress_peak_bytes = 0;
+    for ( size_t i = 0; i < ncache; ++i ) {
+      tiered = tiered || cache[i]->tiered;
+      ncompress_hit += cache[i]->ncompress_hit;
+      nscratch_hit += cache[i]->nscratch_hit;
+      nscratch_put += cache[i]->nscratch_put;
+      compress_peak_bytes += cache[i]->compress_peak_bytes;
+    }
+    if ( tiered ) {
+      XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cachezhit", ncompress_hit, "number of cache hits on compressed items" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cachezmax", compress_peak_bytes, "maximum bytes used by compressed items" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cachefhit", nscratch_hit, "number of cache hits on scratch file items" ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "cachefput", nscratch_put, "number of items written to scratch file" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
   return XLAL_SUCCESS;
 
 }
@@ -820,6 +1453,9 @@ int XLALWeaveCacheExpire(
   // - Existing items will no longer be accessible, but are still kept for reuse
   ++cache->generation;
 
+  // Remove all compressed items, which can no longer be accessed
+  XLAL_CHECK( cache_spill_clear( cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   return XLAL_SUCCESS;
 
 }
@@ -839,6 +1475,9 @@ int XLALWeaveCacheClear(
   XLAL_CHECK( XLALHeapClear( cache->relevance_heap ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK( XLALHashTblClear( cache->coh_index_hash ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+  // Remove all compressed items
+  XLAL_CHECK( cache_spill_clear( cache ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   // Reset current generation of cache items
   cache->generation = 0;
 
@@ -847,140 +1486,272 @@ int XLALWeaveCacheClear(
 }
 
 ///
-/// Retrieve coherent results for a given query, or compute new coherent results if not found
+/// Find the cache item for a given query, or add a new cache item if not found; must be called with
+/// the cache lock held. The item is marked as in use by the query. If coherent results of the new
+/// item must be computed, \p compute is set, and the item is locked until they have been computed.
 ///
-int XLALWeaveCacheRetrieve(
+int cache_find_or_add(
   WeaveCache *cache,
   const WeaveCacheQueries *queries,
   const UINT4 query_index,
-  const WeaveCohResults **coh_res,
-  UINT8 *coh_index,
-  UINT4 *coh_offset,
-  WeaveSearchTiming *tim
+  cache_item **item,
+  BOOLEAN *compute
   )
 {
 
-  // Check input
-  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
-  XLAL_CHECK( queries != NULL, XLAL_EFAULT );
-  XLAL_CHECK( query_index < queries->nqueries, XLAL_EINVAL );
-  XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
-  XLAL_CHECK( coh_offset != NULL, XLAL_EFAULT );
-  XLAL_CHECK( tim != NULL, XLAL_EFAULT );
+  *compute = 0;
 
   // See if coherent results are already cached
   const cache_item find_key = { .generation = cache->generation, .coh_index = queries->coh_index[query_index] };
   const cache_item *find_item = NULL;
   XLAL_CHECK( XLALHashTblFind( cache->coh_index_hash, &find_key, ( const void ** ) &find_item ) == XLAL_SUCCESS, XLAL_EFUNC );
-  if ( find_item == NULL ) {
+  if ( find_item != NULL ) {
 
-    // Reuse 'saved_item' if possible, otherwise allocate memory for a new cache item
-    if ( cache->saved_item == NULL ) {
-      cache->saved_item = XLALCalloc( 1, sizeof( *cache->saved_item ) );
-      XLAL_CHECK( cache->saved_item != NULL, XLAL_EINVAL );
-    }
-    cache_item *new_item = cache->saved_item;
-    find_item = new_item;
+    // Coherent results are already cached, or are being computed by another thread
+    *item = ( cache_item * ) find_item;
+    XLAL_CHECK( !( *item )->failed, XLAL_EFAILED, "Computation of coherent results by another thread failed" );
+    ++( *item )->nusers;
+    ++cache->nhit;
 
-    // Set the key of the new cache item for future lookups
-    new_item->generation = find_key.generation;
-    new_item->coh_index = find_key.coh_index;
+    return XLAL_SUCCESS;
 
-    // Set the relevance of the coherent frequency block associated with the new cache item
-    new_item->relevance = queries->coh_relevance[query_index];
+  }
 
-    // Determine the number of points in the coherent frequency block
-    const UINT4 coh_nfreqs = queries->coh_right[query_index] - queries->coh_left[query_index] + 1;
+  // Reuse 'saved_item' if possible, otherwise allocate memory for a new cache item
+  cache_item *new_item = cache->saved_item;
+  if ( new_item == NULL ) {
+    new_item = XLALCalloc( 1, sizeof( *new_item ) );
+    XLAL_CHECK( new_item != NULL, XLAL_ENOMEM );
+    CACHE_LOCK_INIT( new_item->compute_lock );
+  }
+  cache->saved_item = NULL;
+  *item = new_item;
 
-    // Compute coherent results for the new cache item
-    XLAL_CHECK( XLALWeaveCohResultsCompute( &new_item->coh_res, cache->coh_input, &queries->coh_phys[query_index], coh_nfreqs, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Set the key of the new cache item for future lookups
+  new_item->generation = find_key.generation;
+  new_item->coh_index = find_key.coh_index;
 
-    // Add new cache item to the index hash table
-    XLAL_CHECK( XLALHashTblAdd( cache->coh_index_hash, new_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Set the relevance of the coherent frequency block associated with the new cache item
+  new_item->relevance = queries->coh_relevance[query_index];
 
-    // Get the item in the cache with the smallest relevance
-    const cache_item *least_relevant_item = ( const cache_item * ) XLALHeapRoot( cache->relevance_heap );
-    XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
+  // Mark the new cache item as in use
+  new_item->nusers = 1;
 
-    // Create a 'fake' item specifying thresholds for cache item relevance, for comparison with 'least_relevant_item'
-    const cache_item relevance_threshold = { .generation = cache->generation, .relevance = queries->semi_relevance };
+  // Add new cache item to the index hash table
+  XLAL_CHECK( XLALHashTblAdd( cache->coh_index_hash, new_item ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-    // If garbage collection is enabled, and item's relevance has fallen below the threshold relevance, it can be removed from the cache
-    if ( cache->any_gc && least_relevant_item != NULL && least_relevant_item != new_item && cache_item_compare_by_relevance( least_relevant_item, &relevance_threshold ) < 0 ) {
+  // Retrieve coherent results for the new cache item from the compressed items, if possible
+  BOOLEAN retrieved = 0;
+  if ( cache->tiered ) {
+    XLAL_CHECK( cache_spill_retrieve( cache, new_item, &new_item->coh_res, &retrieved ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  if ( retrieved ) {
+    XLAL_CHECK( cache_insert( cache, queries, query_index, new_item, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+  }
 
-      // Remove least relevant item from index hash table
-      XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Otherwise coherent results must be computed; lock the new cache item so that other threads
+  // which query it wait until coherent results have been computed
+  new_item->computing = 1;
+  CACHE_LOCK( new_item->compute_lock );
+  *compute = 1;
 
-      // Exchange 'saved_item' with the least relevant item in the relevance heap
-      XLAL_CHECK( XLALHeapExchangeRoot( cache->relevance_heap, ( void ** ) &cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
 
-      // If maximal garbage collection is enabled, remove as many results as possible
-      while ( cache->all_gc ) {
+}
 
-        // Get the item in the cache with the smallest relevance
-        least_relevant_item = ( const cache_item * ) XLALHeapRoot( cache->relevance_heap );
-        XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
+///
+/// Insert a cache item with coherent results into the relevance heap, removing items which are no
+/// longer relevant or which are evicted from a fixed-size cache; must be called with the cache lock held
+///
+int cache_insert(
+  WeaveCache *cache,
+  const WeaveCacheQueries *queries,
+  const UINT4 query_index,
+  cache_item *new_item,
+  const BOOLEAN computed
+  )
+{
 
-        // If item's relevance has fallen below the threshold relevance, it can be removed from the cache
-        if ( least_relevant_item != NULL && least_relevant_item != new_item && cache_item_compare_by_relevance( least_relevant_item, &relevance_threshold ) < 0 ) {
+  // Get the item in the cache with the smallest relevance
+  const cache_item *least_relevant_item = ( const cache_item * ) XLALHeapRoot( cache->relevance_heap );
+  XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
 
-          // Remove least relevant item from index hash table
-          XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Create a 'fake' item specifying thresholds for cache item relevance, for comparison with 'least_relevant_item'
+  const cache_item relevance_threshold = { .generation = cache->generation, .relevance = queries->semi_relevance };
 
-          // Remove and destroy least relevant item from the relevance heap
-          XLAL_CHECK( XLALHeapRemoveRoot( cache->relevance_heap ) == XLAL_SUCCESS, XLAL_EINVAL );
+  // If garbage collection is enabled, and item's relevance has fallen below the threshold relevance, it can be removed from the cache
+  if ( cache->any_gc && least_relevant_item != NULL && least_relevant_item != new_item && cache_item_compare_by_relevance( least_relevant_item, &relevance_threshold ) < 0 ) {
 
-        } else {
+    // Remove least relevant item from index hash table
+    XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
 
-          // All cache items are still relevant
-          break;
+    // Exchange new cache item with the least relevant item in the relevance heap, and dispose of the latter
+    void *removed_item = new_item;
+    XLAL_CHECK( XLALHeapExchangeRoot( cache->relevance_heap, &removed_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+    cache_item_dispose( cache, removed_item );
 
-        }
+    // If maximal garbage collection is enabled, remove as many results as possible
+    while ( cache->all_gc ) {
 
-      }
+      // Get the item in the cache with the smallest relevance
+      least_relevant_item = ( const cache_item * ) XLALHeapRoot( cache->relevance_heap );
+      XLAL_CHECK( xlalErrno == 0, XLAL_EFUNC );
 
-    } else {
+      // If item's relevance has fallen below the threshold relevance, it can be removed from the cache
+      if ( least_relevant_item != NULL && least_relevant_item != new_item && cache_item_compare_by_relevance( least_relevant_item, &relevance_threshold ) < 0 ) {
+
+        // Remove least relevant item from index hash table
+        XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, least_relevant_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+        // Remove least relevant item from the relevance heap, and dispose of it
+        removed_item = XLALHeapExtractRoot( cache->relevance_heap );
+        XLAL_CHECK( removed_item != NULL, XLAL_EFUNC );
+        cache_item_dispose( cache, removed_item );
 
-      // Add new cache item to the relevance heap; 'saved_item' many now contains an item removed from the heap
-      XLAL_CHECK( XLALHeapAdd( cache->relevance_heap, ( void ** ) &cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+      } else {
+
+        // All cache items are still relevant
+        break;
 
-      // If 'saved_item' contains an item removed from the heap, also remove it from the index hash table
-      if ( cache->saved_item != NULL ) {
-        XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, cache->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
       }
 
     }
 
-    // Update maximum size obtained by relevance heap
-    const UINT4 heap_size = XLALHeapSize( cache->relevance_heap );
-    if ( cache->heap_max_size < heap_size ) {
-      cache->heap_max_size = heap_size;
+  } else {
+
+    // Add new cache item to the relevance heap; 'removed_item' many now contains an item removed from the heap
+    void *removed_item = new_item;
+    XLAL_CHECK( XLALHeapAdd( cache->relevance_heap, &removed_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // If 'removed_item' contains an item removed from the heap, also remove it from the index hash table
+    if ( removed_item != NULL ) {
+      XLAL_CHECK( XLALHashTblRemove( cache->coh_index_hash, removed_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+      ++cache->nevict;
+
+      // If the item removed from the heap is still relevant, keep it in the compressed tiers
+      if ( cache->tiered && cache_item_compare_by_relevance( removed_item, &relevance_threshold ) >= 0 ) {
+        XLAL_CHECK( cache_spill_add( cache, removed_item, queries->semi_relevance ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+
+      // Dispose of the item removed from the heap
+      cache_item_dispose( cache, removed_item );
+
     }
 
+  }
+
+  // Update maximum size obtained by relevance heap
+  const UINT4 heap_size = XLALHeapSize( cache->relevance_heap );
+  if ( cache->heap_max_size < heap_size ) {
+    cache->heap_max_size = heap_size;
+  }
+
+  // Count coherent results if they were computed; coherent results retrieved from the compressed items have already been counted
+  if ( computed ) {
+    ++cache->nmiss;
+
     // Increment number of computed coherent results
+    const UINT4 coh_nfreqs = queries->coh_right[query_index] - queries->coh_left[query_index] + 1;
     queries->coh_nres[query_index] += coh_nfreqs;
 
-    // Check if coherent results have been computed previously
-    const UINT8 coh_bitset_index = queries->freq_partition_index * cache->coh_max_index + find_key.coh_index;
-    BOOLEAN computed = 0;
-    XLAL_CHECK( XLALBitsetGet( cache->coh_computed_bitset, coh_bitset_index, &computed ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( !computed ) {
+    // Check if coherent results have been computed previously, and record that this coherent result has now been computed
+    const UINT8 coh_bitset_index = queries->freq_partition_index * cache->coh_max_index + new_item->coh_index;
+    BOOLEAN computed_before = 0;
+    XLAL_CHECK( XLALBitsetGet( cache->coh_computed_bitset, coh_bitset_index, &computed_before ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( !computed_before ) {
 
       // Coherent results have not been computed before: increment the number of coherent templates
       queries->coh_ntmpl[query_index] += coh_nfreqs;
-
-      // This coherent result has now been computed
       XLAL_CHECK( XLALBitsetSet( cache->coh_computed_bitset, coh_bitset_index, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     }
 
   }
 
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Retrieve coherent results for a given query, or compute new coherent results if not found. The
+/// coherent results must be released with XLALWeaveCacheRelease() once no longer needed.
+///
+int XLALWeaveCacheRetrieve(
+  WeaveCache *cache,
+  const WeaveCacheQueries *queries,
+  const UINT4 query_index,
+  const WeaveCohResults **coh_res,
+  UINT8 *coh_index,
+  UINT4 *coh_offset,
+  WeaveSearchTiming *tim
+  )
+{
+
+  // Check input
+  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
+  XLAL_CHECK( queries != NULL, XLAL_EFAULT );
+  XLAL_CHECK( query_index < queries->nqueries, XLAL_EINVAL );
+  XLAL_CHECK( queries->coh_item[query_index] == NULL, XLAL_EINVAL, "Coherent results of query %u have not been released", query_index );
+  XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
+  XLAL_CHECK( coh_offset != NULL, XLAL_EFAULT );
+
+  // Select coherent input data of the calling thread
+  WeaveCohInput *coh_input = cache->coh_input;
+#ifdef _OPENMP
+  if ( cache->nthreads > 1 && omp_get_thread_num() > 0 ) {
+    const UINT4 t = omp_get_thread_num();
+    XLAL_CHECK( t < cache->nthreads, XLAL_EINVAL, "Cache is shared by %u threads, but was queried by thread %u", cache->nthreads, t );
+    coh_input = cache->thread_coh_input[t - 1];
+  }
+#endif
+
+  // Find the cache item for this query, or add a new cache item
+  // - The cache lock must be released before checking for errors
+  cache_item *item = NULL;
+  BOOLEAN compute = 0;
+  CACHE_LOCK( cache->lock );
+  int retn = cache_find_or_add( cache, queries, query_index, &item, &compute );
+  const BOOLEAN wait = ( retn == XLAL_SUCCESS && !compute && item->computing );
+  CACHE_UNLOCK( cache->lock );
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  if ( compute ) {
+
+    // Compute coherent results for the new cache item, without holding the cache lock
+    const UINT4 coh_nfreqs = queries->coh_right[query_index] - queries->coh_left[query_index] + 1;
+    retn = XLALWeaveCohResultsCompute( &item->coh_res, coh_input, &queries->coh_phys[query_index], coh_nfreqs, tim );
+
+    // Insert new cache item into the cache, then release threads waiting for its coherent results
+    CACHE_LOCK( cache->lock );
+    item->computing = 0;
+    if ( retn == XLAL_SUCCESS ) {
+      retn = cache_insert( cache, queries, query_index, item, 1 );
+    } else {
+      item->failed = 1;
+    }
+    CACHE_UNLOCK( cache->lock );
+    CACHE_UNLOCK( item->compute_lock );
+    XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  } else if ( wait ) {
+
+    // Wait for another thread to finish computing coherent results for the cache item
+    CACHE_LOCK( item->compute_lock );
+    const BOOLEAN failed = item->failed;
+    CACHE_UNLOCK( item->compute_lock );
+    XLAL_CHECK( !failed, XLAL_EFAILED, "Computation of coherent results by another thread failed" );
+
+  }
+
+  // Record cache item in use by this query
+  queries->coh_item[query_index] = item;
+
   // Return coherent results from cache
-  *coh_res = find_item->coh_res;
+  *coh_res = item->coh_res;
 
   // Return index of coherent result
-  *coh_index = find_item->coh_index;
+  *coh_index = item->coh_index;
 
   // Return offset at which coherent results should be combined with semicoherent results
   *coh_offset = queries->semi_left - queries->coh_left[query_index];
@@ -989,6 +1760,37 @@ int XLALWeaveCacheRetrieve(
 
 }
 
+///
+/// Release coherent results retrieved for a given query by XLALWeaveCacheRetrieve()
+///
+int XLALWeaveCacheRelease(
+  WeaveCache *cache,
+  const WeaveCacheQueries *queries,
+  const UINT4 query_index
+  )
+{
+
+  // Check input
+  XLAL_CHECK( cache != NULL, XLAL_EFAULT );
+  XLAL_CHECK( queries != NULL, XLAL_EFAULT );
+  XLAL_CHECK( query_index < queries->nqueries, XLAL_EINVAL );
+  cache_item *item = queries->coh_item[query_index];
+  XLAL_CHECK( item != NULL, XLAL_EINVAL, "Coherent results of query %u have not been retrieved", query_index );
+  queries->coh_item[query_index] = NULL;
+
+  // Mark cache item as no longer in use by this query; once no longer in use, dispose of an item
+  // which has already been removed from the cache
+  CACHE_LOCK( cache->lock );
+  --item->nusers;
+  if ( item->nusers == 0 && item->retired ) {
+    cache_item_dispose( cache, item );
+  }
+  CACHE_UNLOCK( cache->lock );
+
+  return XLAL_SUCCESS;
+
+}
+
 // Local Variables:
 // c-file-style: "linux"
 // c-basic-offset: 2
@@ -71,6 +71,10 @@ int XLALWeaveCacheQueriesGetCounts(
   UINT8 *coh_ntmpl,
   UINT8 *semi_ntmpl
   );
+int XLALWeaveCacheQueriesAddCounts(
+  WeaveCacheQueries *queries,
+  const WeaveCacheQueries *other
+  );
 WeaveCache *XLALWeaveCacheCreate(
   const LatticeTiling *coh_tiling,
   const BOOLEAN interpolation,
@@ -83,6 +87,15 @@ WeaveCache *XLALWeaveCacheCreate(
 void XLALWeaveCacheDestroy(
   WeaveCache *cache
   );
+int XLALWeaveCacheSetThreads(
+  WeaveCache *cache,
+  const UINT4 nthreads
+  );
+int XLALWeaveCacheSetTiers(
+  WeaveCache *cache,
+  const UINT8 compress_max_bytes,
+  const char *scratch_dir
+  );
 int XLALWeaveCacheWriteInfo(
   FITSFile *file,
   const size_t ncache,
@@ -103,6 +116,11 @@ int XLALWeaveCacheRetrieve(
   UINT4 *coh_offset,
   WeaveSearchTiming *tim
   );
+int XLALWeaveCacheRelease(
+  WeaveCache *cache,
+  const WeaveCacheQueries *queries,
+  const UINT4 query_index
+  );
 
 #ifdef __cplusplus
 }
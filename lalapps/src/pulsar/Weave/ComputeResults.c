@@ -97,6 +97,7 @@ struct tagWeaveCohResults {
 
 static int semi_res_sum_2F( UINT4 *nsum, REAL4 *sum2F, const REAL4 *coh2F, const UINT4 nfreqs );
 static int semi_res_max_2F( UINT4 *nmax, REAL4 *max2F, const REAL4 *coh2F, const UINT4 nfreqs );
+static int sft_covering_band( double *sft_min_cover_freq, double *sft_max_cover_freq, const SFTCatalog *sft_catalog_seg, const PulsarDopplerParams *min_phys, const PulsarDopplerParams *max_phys );
 
 /// @}
 
@@ -174,14 +175,8 @@ WeaveCohInput *XLALWeaveCohInputCreate(
   XLAL_CHECK_NULL( sft_catalog_seg_detectors != NULL, XLAL_EFUNC );
 
   // Compute frequency range covered by spindown range over in the given segment
-  LIGOTimeGPS sft_start = sft_catalog_seg.data[0].header.epoch;
-  LIGOTimeGPS sft_end = sft_catalog_seg.data[sft_catalog_seg.length - 1].header.epoch;
-  const double sft_end_timebase = 1.0 / sft_catalog_seg.data[sft_catalog_seg.length - 1].header.deltaF;
-  XLALGPSAdd( &sft_end, sft_end_timebase );
-  PulsarSpinRange XLAL_INIT_DECL( spin_range );
-  XLAL_CHECK_NULL( XLALInitPulsarSpinRangeFromSpins( &spin_range, &min_phys->refTime, min_phys->fkdot, max_phys->fkdot ) == XLAL_SUCCESS, XLAL_EFUNC );
   double sft_min_cover_freq = 0, sft_max_cover_freq = 0;
-  XLAL_CHECK_NULL( XLALCWSignalCoveringBand( &sft_min_cover_freq, &sft_max_cover_freq, &sft_start, &sft_end, &spin_range, 0, 0, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_NULL( sft_covering_band( &sft_min_cover_freq, &sft_max_cover_freq, &sft_catalog_seg, min_phys, max_phys ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // Parse SFT noise sqrt(Sh) string vector for detectors in this segment
   // - This is important when segments contain data from a subset of detectors
@@ -249,6 +244,77 @@ WeaveCohInput *XLALWeaveCohInputCreate(
 
 }
 
+///
+/// Queue the SFTs required to create coherent input data for the given segment with an SFT prefetcher,
+/// so that they are loaded in the background while previous segments are being set up
+///
+int XLALWeaveCohInputPrefetch(
+  SFTPrefetcher *prefetcher,
+  const SFTCatalog *sft_catalog,
+  const LALSeg *segment,
+  const PulsarDopplerParams *min_phys,
+  const PulsarDopplerParams *max_phys,
+  const FstatOptionalArgs *Fstat_opt_args
+  )
+{
+
+  // Check input
+  XLAL_CHECK( prefetcher != NULL, XLAL_EFAULT );
+  XLAL_CHECK( sft_catalog != NULL, XLAL_EFAULT );
+  XLAL_CHECK( segment != NULL, XLAL_EFAULT );
+  XLAL_CHECK( min_phys != NULL, XLAL_EFAULT );
+  XLAL_CHECK( max_phys != NULL, XLAL_EFAULT );
+  XLAL_CHECK( Fstat_opt_args != NULL, XLAL_EFAULT );
+
+  // Get a timeslice of SFT catalog restricted to the given segment
+  // - Nothing to prefetch if there are no SFTs; error is reported by XLALWeaveCohInputCreate()
+  SFTCatalog XLAL_INIT_DECL( sft_catalog_seg );
+  XLAL_CHECK( XLALSFTCatalogTimeslice( &sft_catalog_seg, sft_catalog, &segment->start, &segment->end ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( sft_catalog_seg.length == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  // Compute frequency range covered by spindown range over in the given segment
+  double sft_min_cover_freq = 0, sft_max_cover_freq = 0;
+  XLAL_CHECK( sft_covering_band( &sft_min_cover_freq, &sft_max_cover_freq, &sft_catalog_seg, min_phys, max_phys ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Queue the SFTs which XLALCreateFstatInput() will load
+  XLAL_CHECK( XLALFstatPrefetchSFTs( prefetcher, &sft_catalog_seg, sft_min_cover_freq, sft_max_cover_freq, Fstat_opt_args ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Create a copy of coherent input data for use by another thread. F-statistic input data is copied
+/// using XLALFstatInputThreadCopy(), which shares the loaded SFT data with \p coh_input but gives the
+/// copy its own buffers. Copies must be created and destroyed outside of any parallel region.
+///
+WeaveCohInput *XLALWeaveCohInputThreadCopy(
+  const WeaveCohInput *coh_input
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( coh_input != NULL, XLAL_EFAULT );
+
+  // Allocate memory
+  WeaveCohInput *copy = XLALCalloc( 1, sizeof( *copy ) );
+  XLAL_CHECK_NULL( copy != NULL, XLAL_ENOMEM );
+
+  // Copy fields
+  *copy = *coh_input;
+
+  // Create a thread copy of F-statistic input data, if any and if it will be used
+  copy->Fstat_input = NULL;
+  if ( coh_input->Fstat_input != NULL && !( coh_input->simulation_level & WEAVE_SIMULATE ) ) {
+    XLAL_CHECK_NULL( XLALFstatInputThreadCopy( &copy->Fstat_input, coh_input->Fstat_input ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return copy;
+
+}
+
 ///
 /// Destroy coherent input data
 ///
@@ -518,6 +584,144 @@ void XLALWeaveCohResultsDestroy(
   }
 }
 
+///
+/// Return the size in bytes of coherent results packed into a contiguous buffer by XLALWeaveCohResultsPack()
+///
+size_t XLALWeaveCohResultsPackedSize(
+  const WeaveCohResults *coh_res
+  )
+{
+
+  // Check input
+  XLAL_CHECK_VAL( 0, coh_res != NULL, XLAL_EFAULT );
+
+  // Size of header, plus one vector of F-statistics per frequency for each vector present
+  size_t n = sizeof( coh_res->coh_phys ) + sizeof( coh_res->nfreqs ) + sizeof( UINT4 );
+  if ( coh_res->coh2F != NULL ) {
+    n += coh_res->nfreqs * sizeof( coh_res->coh2F->data[0] );
+  }
+  for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+    if ( coh_res->coh2F_det[i] != NULL ) {
+      n += coh_res->nfreqs * sizeof( coh_res->coh2F_det[i]->data[0] );
+    }
+  }
+
+  return n;
+
+}
+
+///
+/// Pack coherent results into a contiguous buffer, e.g. to be compressed or written to disk.
+/// The buffer must be of the size returned by XLALWeaveCohResultsPackedSize().
+///
+int XLALWeaveCohResultsPack(
+  void *buf,
+  const size_t buf_len,
+  const WeaveCohResults *coh_res
+  )
+{
+
+  // Check input
+  XLAL_CHECK( buf != NULL, XLAL_EFAULT );
+  XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
+  XLAL_CHECK( buf_len == XLALWeaveCohResultsPackedSize( coh_res ), XLAL_ESIZE );
+
+  // Bitmask of which vectors of F-statistics per frequency are present
+  UINT4 have_mask = 0;
+  if ( coh_res->coh2F != NULL ) {
+    have_mask |= 1;
+  }
+  for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+    if ( coh_res->coh2F_det[i] != NULL ) {
+      have_mask |= 1 << ( 1 + i );
+    }
+  }
+
+  // Pack header
+  char *p = ( char * ) buf;
+  memcpy( p, &coh_res->coh_phys, sizeof( coh_res->coh_phys ) );
+  p += sizeof( coh_res->coh_phys );
+  memcpy( p, &coh_res->nfreqs, sizeof( coh_res->nfreqs ) );
+  p += sizeof( coh_res->nfreqs );
+  memcpy( p, &have_mask, sizeof( have_mask ) );
+  p += sizeof( have_mask );
+
+  // Pack F-statistics per frequency
+  if ( coh_res->coh2F != NULL ) {
+    memcpy( p, coh_res->coh2F->data, coh_res->nfreqs * sizeof( coh_res->coh2F->data[0] ) );
+    p += coh_res->nfreqs * sizeof( coh_res->coh2F->data[0] );
+  }
+  for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+    if ( coh_res->coh2F_det[i] != NULL ) {
+      memcpy( p, coh_res->coh2F_det[i]->data, coh_res->nfreqs * sizeof( coh_res->coh2F_det[i]->data[0] ) );
+      p += coh_res->nfreqs * sizeof( coh_res->coh2F_det[i]->data[0] );
+    }
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Unpack coherent results from a contiguous buffer filled by XLALWeaveCohResultsPack().
+/// Memory in any existing coherent results is reused.
+///
+int XLALWeaveCohResultsUnpack(
+  WeaveCohResults **coh_res,
+  const void *buf,
+  const size_t buf_len
+  )
+{
+
+  // Check input
+  XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
+  XLAL_CHECK( buf != NULL, XLAL_EFAULT );
+  XLAL_CHECK( buf_len >= sizeof( ( *coh_res )->coh_phys ) + sizeof( ( *coh_res )->nfreqs ) + sizeof( UINT4 ), XLAL_ESIZE );
+
+  // Allocate results struct if required
+  if ( *coh_res == NULL ) {
+    *coh_res = XLALCalloc( 1, sizeof( **coh_res ) );
+    XLAL_CHECK( *coh_res != NULL, XLAL_ENOMEM );
+  }
+
+  // Unpack header
+  const char *p = ( const char * ) buf;
+  memcpy( &( *coh_res )->coh_phys, p, sizeof( ( *coh_res )->coh_phys ) );
+  p += sizeof( ( *coh_res )->coh_phys );
+  memcpy( &( *coh_res )->nfreqs, p, sizeof( ( *coh_res )->nfreqs ) );
+  p += sizeof( ( *coh_res )->nfreqs );
+  UINT4 have_mask = 0;
+  memcpy( &have_mask, p, sizeof( have_mask ) );
+  p += sizeof( have_mask );
+  const UINT4 nfreqs = ( *coh_res )->nfreqs;
+
+  // Unpack F-statistics per frequency, reallocating vectors if required
+  REAL4Vector **vec[1 + PULSAR_MAX_DETECTORS];
+  vec[0] = &( *coh_res )->coh2F;
+  for ( size_t i = 0; i < PULSAR_MAX_DETECTORS; ++i ) {
+    vec[1 + i] = &( *coh_res )->coh2F_det[i];
+  }
+  for ( size_t j = 0; j < XLAL_NUM_ELEM( vec ); ++j ) {
+    if ( have_mask & ( 1 << j ) ) {
+      if ( *vec[j] == NULL || ( *vec[j] )->length < nfreqs ) {
+        *vec[j] = XLALResizeREAL4Vector( *vec[j], nfreqs );
+        XLAL_CHECK( *vec[j] != NULL, XLAL_ENOMEM );
+      }
+      XLAL_CHECK( ( size_t )( p - ( const char * ) buf ) + nfreqs * sizeof( ( *vec[j] )->data[0] ) <= buf_len, XLAL_ESIZE );
+      memcpy( ( *vec[j] )->data, p, nfreqs * sizeof( ( *vec[j] )->data[0] ) );
+      p += nfreqs * sizeof( ( *vec[j] )->data[0] );
+    } else {
+      // Vectors absent from the packed results must not keep stale contents from reused results
+      XLALDestroyREAL4Vector( *vec[j] );
+      *vec[j] = NULL;
+    }
+  }
+  XLAL_CHECK( ( size_t )( p - ( const char * ) buf ) == buf_len, XLAL_ESIZE );
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Create and initialise semicoherent results
 ///
@@ -683,6 +887,27 @@ int XLALWeaveSemiResultsInit(
 
 }
 
+///
+/// Compute frequency range covered by the spindown range over the time span of the SFTs in a segment
+///
+static int sft_covering_band(
+  double *sft_min_cover_freq,
+  double *sft_max_cover_freq,
+  const SFTCatalog *sft_catalog_seg,
+  const PulsarDopplerParams *min_phys,
+  const PulsarDopplerParams *max_phys
+  )
+{
+  LIGOTimeGPS sft_start = sft_catalog_seg->data[0].header.epoch;
+  LIGOTimeGPS sft_end = sft_catalog_seg->data[sft_catalog_seg->length - 1].header.epoch;
+  const double sft_end_timebase = 1.0 / sft_catalog_seg->data[sft_catalog_seg->length - 1].header.deltaF;
+  XLALGPSAdd( &sft_end, sft_end_timebase );
+  PulsarSpinRange XLAL_INIT_DECL( spin_range );
+  XLAL_CHECK( XLALInitPulsarSpinRangeFromSpins( &spin_range, &min_phys->refTime, min_phys->fkdot, max_phys->fkdot ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALCWSignalCoveringBand( sft_min_cover_freq, sft_max_cover_freq, &sft_start, &sft_end, &spin_range, 0, 0, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
 ///
 /// Add F-statistic array 'coh2F' to summed array 'sum2F', and keep track of the number of summations 'nsum'
 ///
@@ -736,7 +961,6 @@ int XLALWeaveSemiResultsAdd(
   XLAL_CHECK( semi_res->ncoh_res < semi_res->nsegments, XLAL_EINVAL );
   XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
   XLAL_CHECK( semi_res->statistics_params != NULL, XLAL_EFAULT );
-  XLAL_CHECK( tim != NULL, XLAL_EFAULT );
 
   // Check that offset does not overrun coherent results arrays
   XLAL_CHECK( coh_offset + semi_res->nfreqs <= coh_res->nfreqs, XLAL_EFAILED, "Coherent offset (%u) + number of semicoherent frequency bins (%u) > number of coherent frequency bins (%u)", coh_offset, semi_res->nfreqs, coh_res->nfreqs );
@@ -836,7 +1060,6 @@ int XLALWeaveSemiResultsComputeMain(
   XLAL_CHECK( semi_res != NULL, XLAL_EFAULT );
   XLAL_CHECK( semi_res->ncoh_res == semi_res->nsegments, XLAL_EINVAL );
   XLAL_CHECK( semi_res->statistics_params != NULL, XLAL_EFAULT );
-  XLAL_CHECK( tim != NULL, XLAL_EFAULT );
 
   WeaveStatisticType mainloop_stats = semi_res->statistics_params->mainloop_statistics;
 
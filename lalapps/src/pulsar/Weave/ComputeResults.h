@@ -109,6 +109,17 @@ WeaveCohInput *XLALWeaveCohInputCreate(
   const WeaveStatisticsParams *statistics_params,
   BOOLEAN recalc_stage
   );
+int XLALWeaveCohInputPrefetch(
+  SFTPrefetcher *prefetcher,
+  const SFTCatalog *sft_catalog,
+  const LALSeg *segment,
+  const PulsarDopplerParams *min_phys,
+  const PulsarDopplerParams *max_phys,
+  const FstatOptionalArgs *Fstat_opt_args
+  );
+WeaveCohInput *XLALWeaveCohInputThreadCopy(
+  const WeaveCohInput *coh_input
+  );
 void XLALWeaveCohInputDestroy(
   WeaveCohInput *coh_input
   );
@@ -129,6 +140,19 @@ int XLALWeaveCohResultsCompute(
   const UINT4 coh_nfreqs,
   WeaveSearchTiming *tim
   );
+size_t XLALWeaveCohResultsPackedSize(
+  const WeaveCohResults *coh_res
+  );
+int XLALWeaveCohResultsPack(
+  void *buf,
+  const size_t buf_len,
+  const WeaveCohResults *coh_res
+  );
+int XLALWeaveCohResultsUnpack(
+  WeaveCohResults **coh_res,
+  const void *buf,
+  const size_t buf_len
+  );
 void XLALWeaveCohResultsDestroy(
   WeaveCohResults *coh_res
   );
@@ -48,6 +48,8 @@ struct tagWeaveOutputResults {
   BOOLEAN toplist_tmpl_idx;
   /// Output result toplists
   WeaveResultsToplist *toplists[8];
+  /// Output results from which these output results were copied, for use by another thread
+  const WeaveOutputResults *thread_parent;
 };
 
 ///
@@ -239,7 +241,9 @@ void XLALWeaveOutputResultsDestroy(
   )
 {
   if ( out != NULL ) {
-    XLALWeaveStatisticsParamsDestroy( out->statistics_params );
+    if ( out->thread_parent == NULL ) {
+      XLALWeaveStatisticsParamsDestroy( out->statistics_params );
+    }
     for ( size_t i = 0; i < out->ntoplists; ++i ) {
       XLALWeaveResultsToplistDestroy( out->toplists[i] );
     }
@@ -247,6 +251,52 @@ void XLALWeaveOutputResultsDestroy(
   }
 }
 
+///
+/// Create a copy of output results for use by another thread. The copy has its own (empty) toplists,
+/// but shares 'statistics_params' with \p out, which must therefore be destroyed after all its copies.
+///
+WeaveOutputResults *XLALWeaveOutputResultsThreadCopy(
+  const WeaveOutputResults *out
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( out != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( out->thread_parent == NULL, XLAL_EINVAL );
+
+  // Create output results with the same parameters
+  WeaveOutputResults *copy = XLALWeaveOutputResultsCreate( &out->ref_time, out->nspins, out->statistics_params, out->toplist_limit, out->toplist_tmpl_idx );
+  XLAL_CHECK_NULL( copy != NULL, XLAL_EFUNC );
+  copy->thread_parent = out;
+
+  return copy;
+
+}
+
+///
+/// Merge the toplists of output results copied for use by another thread into the output results
+/// from which they were copied. The toplists of \p other are left empty.
+///
+int XLALWeaveOutputResultsMerge(
+  WeaveOutputResults *out,
+  WeaveOutputResults *other
+  )
+{
+
+  // Check input
+  XLAL_CHECK( out != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other->thread_parent == out, XLAL_EINVAL );
+
+  // Merge toplists
+  for ( size_t i = 0; i < out->ntoplists; ++i ) {
+    XLAL_CHECK( XLALWeaveResultsToplistMerge( out->toplists[i], other->toplists[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Add semicoherent results to output
 ///
@@ -262,11 +312,22 @@ int XLALWeaveOutputResultsAdd(
   XLAL_CHECK( semi_res != NULL, XLAL_EFAULT );
 
   // Store main-loop parameters relevant for completion-loop statistics calculation
+  // - 'statistics_params' may be shared with thread copies of the output results, so only
+  //   take the lock until the parameters have been stored
   static BOOLEAN firstTime = 1;
-  if ( firstTime ) {
-    out->statistics_params->nsum2F = semi_res->nsum2F;
-    memcpy( out->statistics_params->nsum2F_det, semi_res->nsum2F_det, sizeof( semi_res->nsum2F_det ) );
-    firstTime = 0;
+  BOOLEAN first = 0;
+#pragma omp atomic read
+  first = firstTime;
+  if ( first ) {
+#pragma omp critical( WeaveOutputResultsFirstTime )
+    {
+      if ( firstTime ) {
+        out->statistics_params->nsum2F = semi_res->nsum2F;
+        memcpy( out->statistics_params->nsum2F_det, semi_res->nsum2F_det, sizeof( semi_res->nsum2F_det ) );
+#pragma omp atomic write
+        firstTime = 0;
+      }
+    }
   }
 
   // Add results to toplists
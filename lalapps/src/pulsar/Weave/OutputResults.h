@@ -47,6 +47,13 @@ WeaveOutputResults *XLALWeaveOutputResultsCreate(
 void XLALWeaveOutputResultsDestroy(
   WeaveOutputResults *out
   );
+WeaveOutputResults *XLALWeaveOutputResultsThreadCopy(
+  const WeaveOutputResults *out
+  );
+int XLALWeaveOutputResultsMerge(
+  WeaveOutputResults *out,
+  WeaveOutputResults *other
+  );
 int XLALWeaveOutputResultsAdd(
   WeaveOutputResults *out,
   const WeaveSemiResults *semi_res,
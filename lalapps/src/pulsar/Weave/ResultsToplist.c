@@ -170,7 +170,9 @@ int toplist_item_compare(
   const WeaveResultsToplistItem *ix = ( const WeaveResultsToplistItem * ) x;
   const WeaveResultsToplistItem *iy = ( const WeaveResultsToplistItem * ) y;
   COMPARE_BY( item_get_rank_stat_fcn( iy ), item_get_rank_stat_fcn( ix ) );   // Compare in descending order
-  return 0;
+  // Break ties by semicoherent template parameters, so that toplist contents do not depend on
+  // the order in which items are added, e.g. when merging toplists filled by separate threads
+  return toplist_item_sort_by_semi_phys( &ix, &iy );
 }
 
 ///
@@ -699,6 +701,13 @@ int XLALWeaveResultsToplistAdd(
   for ( UINT4 idx = 0; idx < n_maybe_add; ++idx ) {
     const UINT4 freq_idx = toplist->maybe_add_freq_idxs->data[idx];
 
+    // Skip results whose ranking statistic is now less than that of the heap root, which may have
+    // risen since the results were selected; these would not be added to the heap, and so the
+    // template parameters needed to break ties need not be set
+    if ( XLALHeapIsFull( toplist->heap ) > 0 && toplist_rank_stats[freq_idx] < toplist->item_get_rank_stat_fcn( XLALHeapRoot( toplist->heap ) ) ) {
+      continue;
+    }
+
     // Create a new toplist item if needed
     if ( toplist->saved_item == NULL ) {
       toplist->saved_item = toplist_item_create( toplist );
@@ -709,15 +718,8 @@ int XLALWeaveResultsToplistAdd(
     // Set ranking statistic of toplist item
     toplist->item_set_rank_stat_fcn( item, toplist_rank_stats[freq_idx] );
 
-    // Possibly add toplist item to heap
-    XLAL_CHECK( XLALHeapAdd( toplist->heap, ( void ** ) &toplist->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Skip remainder of loop if toplist item was not added to heap
-    if ( item == toplist->saved_item ) {
-      continue;
-    }
-
     // Set all semicoherent template parameters
+    // - These are needed by toplist_item_compare() to break ties in ranking statistic
     item->semi_index = semi_res->semi_index;
     item->semi_alpha = semi_res->semi_phys.Alpha;
     item->semi_delta = semi_res->semi_phys.Delta;
@@ -726,6 +728,14 @@ int XLALWeaveResultsToplistAdd(
       item->semi_fkdot[k] = semi_res->semi_phys.fkdot[k];
     }
 
+    // Possibly add toplist item to heap
+    XLAL_CHECK( XLALHeapAdd( toplist->heap, ( void ** ) &toplist->saved_item ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Skip remainder of loop if toplist item was not added to heap
+    if ( item == toplist->saved_item ) {
+      continue;
+    }
+
     // Set all coherent template parameters if outputting per-segment statistics
     if ( per_seg_coords ) {
       for ( size_t j = 0; j < semi_res->nsegments; ++j ) {
@@ -808,6 +818,45 @@ int XLALWeaveResultsToplistAdd(
 
 }
 
+///
+/// Merge the items in one toplist into another toplist, e.g. to combine toplists filled by
+/// separate threads. Items are moved from \p other, which is left empty.
+///
+int XLALWeaveResultsToplistMerge(
+  WeaveResultsToplist *toplist,
+  WeaveResultsToplist *other
+  )
+{
+
+  // Check input
+  XLAL_CHECK( toplist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( other != NULL, XLAL_EFAULT );
+  XLAL_CHECK( toplist->nspins == other->nspins, XLAL_EINVAL );
+  XLAL_CHECK( strcmp( toplist->stat_name, other->stat_name ) == 0, XLAL_EINVAL );
+
+  // Move items from 'other' into 'toplist'
+  while ( XLALHeapSize( other->heap ) > 0 ) {
+
+    // Remove item from 'other'
+    WeaveResultsToplistItem *item = XLALHeapExtractRoot( other->heap );
+    XLAL_CHECK( item != NULL, XLAL_EFUNC );
+
+    // Possibly add item to 'toplist'; 'item' may now contain an item removed from the heap
+    XLAL_CHECK( XLALHeapAdd( toplist->heap, ( void ** ) &item ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    // Save or destroy any item not in 'toplist'
+    if ( toplist->saved_item == NULL ) {
+      toplist->saved_item = item;
+    } else {
+      toplist_item_destroy( item );
+    }
+
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 ///
 /// Compute all missing 'extra' (non-toplist-ranking) statistics for all toplist entries
 ///
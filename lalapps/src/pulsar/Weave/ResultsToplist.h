@@ -96,6 +96,10 @@ int XLALWeaveResultsToplistAdd(
   const WeaveSemiResults *semi_res,
   const UINT4 semi_nfreqs
   );
+int XLALWeaveResultsToplistMerge(
+  WeaveResultsToplist *toplist,
+  WeaveResultsToplist *other
+  );
 int XLALWeaveResultsToplistCompletionLoop(
   WeaveResultsToplist *toplist
   );
@@ -281,7 +281,7 @@ int XLALWeaveSearchTimingStop(
 }
 
 ///
-/// Change the search section currently being timed
+/// Change the search section currently being timed; does nothing if \p tim is NULL
 ///
 int XLALWeaveSearchTimingSection(
   WeaveSearchTiming *tim,
@@ -290,8 +290,12 @@ int XLALWeaveSearchTimingSection(
   )
 {
 
+  // Return if not timing
+  if ( tim == NULL ) {
+    return XLAL_SUCCESS;
+  }
+
   // Check input
-  XLAL_CHECK( tim != NULL, XLAL_EFAULT );
   XLAL_CHECK( prev_section < WEAVE_SEARCH_TIMING_MAX, XLAL_EINVAL );
   XLAL_CHECK( next_section < WEAVE_SEARCH_TIMING_MAX, XLAL_EINVAL );
   XLAL_CHECK( tim->curr_section == prev_section, XLAL_EINVAL );
@@ -317,7 +321,7 @@ int XLALWeaveSearchTimingSection(
 }
 
 ///
-/// Change the search statistic currently being timed
+/// Change the search statistic currently being timed; does nothing if \p tim is NULL
 ///
 int XLALWeaveSearchTimingStatistic(
   WeaveSearchTiming *tim,
@@ -326,8 +330,12 @@ int XLALWeaveSearchTimingStatistic(
   )
 {
 
+  // Return if not timing
+  if ( tim == NULL ) {
+    return XLAL_SUCCESS;
+  }
+
   // Check input
-  XLAL_CHECK( tim != NULL, XLAL_EFAULT );
   XLAL_CHECK( prev_statistic < WEAVE_STATISTIC_MAX, XLAL_EINVAL );
   XLAL_CHECK( next_statistic < WEAVE_STATISTIC_MAX, XLAL_EINVAL );
   XLAL_CHECK( tim->curr_statistic == prev_statistic, XLAL_EINVAL );
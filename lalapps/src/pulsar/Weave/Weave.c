@@ -34,6 +34,32 @@
 #include <lal/UserInput.h>
 #include <lal/Random.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Number of semicoherent frequency blocks searched by each thread, on average, in each lattice block
+#define WEAVE_FREQ_BLOCKS_PER_THREAD 16
+
+///
+/// Semicoherent frequency block handed out by the main loop iterator, to be searched by a thread
+///
+typedef struct {
+  /// Sequential index of the semicoherent frequency block
+  UINT8 semi_index;
+  /// Reduced supersky coordinates of the semicoherent frequency block
+  gsl_vector *semi_rssky;
+  /// Index of left-most point in the semicoherent frequency block
+  INT4 semi_left;
+  /// Index of right-most point in the semicoherent frequency block
+  INT4 semi_right;
+  /// Index of the frequency partition
+  UINT4 freq_partition_index;
+} freq_block;
+
+static int search_next_freq_block( WeaveSearchIterator *itr, BOOLEAN *iteration_complete, const size_t nsegments, WeaveCache *const *coh_cache, WeaveCacheQueries *queries, const WeaveSimulationLevel simulation_level, const UINT4 ndetectors, const double dfreq, const WeaveStatisticsParams *statistics_params, WeaveSemiResults **semi_res, WeaveOutputResults *out, WeaveSearchTiming *tim );
+static int search_freq_block( const UINT8 semi_index, const gsl_vector *semi_rssky, const INT4 semi_left, const INT4 semi_right, const UINT4 freq_partition_index, const size_t nsegments, WeaveCache *const *coh_cache, WeaveCacheQueries *queries, const WeaveSimulationLevel simulation_level, const UINT4 ndetectors, const double dfreq, const WeaveStatisticsParams *statistics_params, WeaveSemiResults **semi_res, WeaveOutputResults *out, WeaveSearchTiming *tim );
+
 int main( int argc, char *argv[] )
 {
 
@@ -47,12 +73,12 @@ int main( int argc, char *argv[] )
 
   // Initialise user input variables
   struct uvar_type {
-    BOOLEAN validate_sft_files, interpolation, lattice_rand_offset, toplist_tmpl_idx, segment_info, simulate_search, time_search, cache_all_gc;
-    CHAR *setup_file, *sft_files, *output_file, *ckpt_output_file;
+    BOOLEAN validate_sft_files, sft_prefetch, interpolation, lattice_rand_offset, toplist_tmpl_idx, segment_info, simulate_search, time_search, cache_all_gc;
+    CHAR *setup_file, *sft_files, *output_file, *ckpt_output_file, *cache_scratch_dir;
     LALStringVector *sft_timestamps_files, *sft_noise_sqrtSX, *injections, *Fstat_assume_sqrtSX, *lrs_oLGX;
-    REAL8 sft_timebase, semi_max_mismatch, coh_max_mismatch, ckpt_output_period, ckpt_output_exit, lrs_Fstar0sc, nc_2Fth;
+    REAL8 sft_timebase, semi_max_mismatch, coh_max_mismatch, ckpt_output_period, ckpt_output_exit, lrs_Fstar0sc, nc_2Fth, cache_compress_mem;
     REAL8Range alpha, delta, freq, f1dot, f2dot, f3dot, f4dot;
-    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size;
+    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size, sft_load_threads, search_threads;
     int lattice, Fstat_method, Fstat_SSB_precision, toplists, extra_statistics, recalc_statistics;
   } uvar_struct = {
     .Fstat_Dterms = Fstat_opt_args.Dterms,
@@ -70,6 +96,8 @@ int main( int argc, char *argv[] )
     .extra_statistics = WEAVE_STATISTIC_NONE,
     .recalc_statistics = WEAVE_STATISTIC_NONE,
     .nc_2Fth = 5.2,
+    .sft_load_threads = 1,
+    .search_threads = 1,
   };
   struct uvar_type *const uvar = &uvar_struct;
 
@@ -98,6 +126,14 @@ int main( int argc, char *argv[] )
     validate_sft_files, BOOLEAN, 'V', DEVELOPER,
     "Validate the checksums of the SFTs matched by " UVAR_STR( sft_files ) " before loading them into memory. "
     );
+  XLALRegisterUvarMember(
+    sft_load_threads, UINT4, 0, DEVELOPER,
+    "Number of threads used to read the SFTs matched by " UVAR_STR( sft_files ) " concurrently. "
+    );
+  XLALRegisterUvarMember(
+    sft_prefetch, BOOLEAN, 0, DEVELOPER,
+    "Load the SFTs of the next segment in the background while the F-statistic input data of the current segment is being set up. "
+    );
   XLALRegisterUvarMember(
     sft_timebase, REAL8, 't', NODEFAULT,
     "Generate SFTs with this timebase instead of loading from files. "
@@ -329,6 +365,23 @@ int main( int argc, char *argv[] )
     "If FALSE, whenever an item is added to the internal caches, at most one item that may no longer be required is removed. "
     "Has no effect when performing a fully-coherent single-segment search, or a non-interpolating search. "
     );
+  XLALRegisterUvarMember(
+    cache_compress_mem, REAL8, 0, DEVELOPER,
+    "Instead of discarding items evicted from the internal caches when they reach the size given by " UVAR_STR( cache_max_size ) ", "
+    "compress them and keep them in memory, up to this amount of memory (in MB) per segment. "
+    "Compressed items are retrieved instead of recomputing intermediate results. "
+    );
+  XLALRegisterUvarMember(
+    cache_scratch_dir, STRING, 0, DEVELOPER,
+    "Write compressed items which exceed the memory given by " UVAR_STR( cache_compress_mem ) " to scratch files in this directory, instead of discarding them. "
+    "Scratch files are deleted when the search finishes. "
+    );
+  XLALRegisterUvarMember(
+    search_threads, UINT4, 0, DEVELOPER,
+    "Number of threads used to search the semicoherent parameter space. Threads search blocks of consecutive semicoherent frequency blocks "
+    "in parallel, sharing the caches of coherent results, and each adds results to its own toplists, which are merged into the output results; "
+    "results are identical to those of a single-threaded search. Requires a resampling F-statistic method, unless simulating the search. "
+    );
 
   // Parse user input
   XLAL_CHECK_MAIN( xlalErrno == 0, XLAL_EFUNC, "A call to XLALRegisterUvarMember() failed" );
@@ -352,6 +405,15 @@ int main( int argc, char *argv[] )
   XLALUserVarCheck( &should_exit,
                     !UVAR_SET( validate_sft_files ) || UVAR_SET( sft_files ),
                     UVAR_STR( validate_sft_files ) " requires " UVAR_STR( sft_files ) );
+  XLALUserVarCheck( &should_exit,
+                    !UVAR_SET( sft_load_threads ) || UVAR_SET( sft_files ),
+                    UVAR_STR( sft_load_threads ) " requires " UVAR_STR( sft_files ) );
+  XLALUserVarCheck( &should_exit,
+                    uvar->sft_load_threads > 0,
+                    UVAR_STR( sft_load_threads ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    !UVAR_SET( sft_prefetch ) || UVAR_SET( sft_files ),
+                    UVAR_STR( sft_prefetch ) " requires " UVAR_STR( sft_files ) );
   XLALUserVarCheck( &should_exit,
                     !UVAR_SET( sft_timebase ) || uvar->sft_timebase > 0,
                     UVAR_STR( sft_timebase ) " must be strictly positive" );
@@ -428,6 +490,21 @@ int main( int argc, char *argv[] )
   XLALUserVarCheck( &should_exit,
                     !UVAR_ALLSET2( time_search, ckpt_output_file ),
                     UVAR_STR2AND( time_search, ckpt_output_file ) " are mutually exclusive" );
+  XLALUserVarCheck( &should_exit,
+                    !UVAR_SET2( cache_compress_mem, cache_scratch_dir ) || uvar->cache_max_size > 0,
+                    UVAR_STR2OR( cache_compress_mem, cache_scratch_dir ) " requires " UVAR_STR( cache_max_size ) " to be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->cache_compress_mem >= 0,
+                    UVAR_STR( cache_compress_mem ) " must be positive" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->search_threads > 0,
+                    UVAR_STR( search_threads ) " must be strictly positive" );
+  XLALUserVarCheck( &should_exit,
+                    uvar->search_threads == 1 || !uvar->time_search,
+                    UVAR_STR( search_threads ) " greater than 1 is mutually exclusive with " UVAR_STR( time_search ) );
+  XLALUserVarCheck( &should_exit,
+                    uvar->search_threads == 1 || uvar->simulate_search || uvar->Fstat_method == FMETHOD_RESAMP_GENERIC || uvar->Fstat_method == FMETHOD_RESAMP_BEST,
+                    UVAR_STR( search_threads ) " greater than 1 requires a resampling " UVAR_STR( Fstat_method ) );
 
   // Exit if required
   if ( should_exit ) {
@@ -802,12 +879,27 @@ int main( int argc, char *argv[] )
   Fstat_opt_args.injectSources = injections;
   Fstat_opt_args.prevInput = NULL;
   Fstat_opt_args.collectTiming = uvar->time_search;
+  Fstat_opt_args.loadSFTsNumThreads = uvar->sft_load_threads;
+
+  // Create SFT prefetcher, to load SFTs of the next segment while setting up the current segment
+  SFTPrefetcher *sft_prefetcher = NULL;
+  if ( uvar->sft_prefetch && !( simulation_level & WEAVE_SIMULATE_MIN_MEM ) ) {
+    sft_prefetcher = XLALCreateSFTPrefetcher( uvar->sft_load_threads );
+    XLAL_CHECK_MAIN( sft_prefetcher != NULL, XLAL_EFUNC );
+    Fstat_opt_args.prefetchSFTs = sft_prefetcher;
+  }
 
   // Load input data required for computing coherent results
   const LALStringVector *sft_noise_sqrtSX = UVAR_SET( sft_noise_sqrtSX ) ? uvar->sft_noise_sqrtSX : NULL;
   const LALStringVector *Fstat_assume_sqrtSX = UVAR_SET( Fstat_assume_sqrtSX ) ? uvar->Fstat_assume_sqrtSX : NULL;
   LogPrintf( LOG_NORMAL, "Loading input data for coherent results ...\n" );
+  if ( sft_prefetcher != NULL ) {
+    XLAL_CHECK_MAIN( XLALWeaveCohInputPrefetch( sft_prefetcher, sft_catalog, &setup.segments->segs[0], min_phys[0], max_phys[0], &Fstat_opt_args ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
   for ( size_t i = 0; i < nsegments; ++i ) {
+    if ( sft_prefetcher != NULL && i + 1 < nsegments ) {
+      XLAL_CHECK_MAIN( XLALWeaveCohInputPrefetch( sft_prefetcher, sft_catalog, &setup.segments->segs[i + 1], min_phys[i + 1], max_phys[i + 1], &Fstat_opt_args ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
     statistics_params->coh_input[i] = XLALWeaveCohInputCreate( setup.detectors, simulation_level, sft_catalog, i, &setup.segments->segs[i], min_phys[i], max_phys[i], dfreq, setup.ephemerides, sft_noise_sqrtSX, Fstat_assume_sqrtSX, &Fstat_opt_args, statistics_params, 0 );
     XLAL_CHECK_MAIN( statistics_params->coh_input[i] != NULL, XLAL_EFUNC );
   }
@@ -823,6 +915,10 @@ int main( int argc, char *argv[] )
     const BOOLEAN cache_all_gc = interpolation ? uvar->cache_all_gc : 0;
     coh_cache[i] = XLALWeaveCacheCreate( tiling[i], interpolation, rssky_transf[i], rssky_transf[isemi], statistics_params->coh_input[i], cache_max_size, cache_all_gc );
     XLAL_CHECK_MAIN( coh_cache[i] != NULL, XLAL_EFUNC );
+    if ( interpolation && UVAR_SET2( cache_compress_mem, cache_scratch_dir ) ) {
+      const UINT8 cache_compress_bytes = ( UINT8 ) round( uvar->cache_compress_mem * 1024 * 1024 );
+      XLAL_CHECK_MAIN( XLALWeaveCacheSetTiers( coh_cache[i], cache_compress_bytes, uvar->cache_scratch_dir ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
   }
 
   ////////// Perform search //////////
@@ -881,6 +977,45 @@ int main( int argc, char *argv[] )
 
   }
 
+  // Number of threads used to search the semicoherent parameter space
+  const UINT4 nthreads = uvar->search_threads;
+
+  // Share caches between threads, and create per-thread cache queries, semicoherent results, and
+  // output results, and storage for lattice blocks of semicoherent frequency blocks
+  // - Per-thread output results share 'statistics_params' with 'out'
+  // - Storage for one extra frequency block is allocated, see main loop below
+  WeaveCacheQueries **thread_queries = NULL;
+  WeaveSemiResults **thread_semi_res = NULL;
+  WeaveOutputResults **thread_out = NULL;
+  const UINT4 nblocks_max = WEAVE_FREQ_BLOCKS_PER_THREAD * nthreads;
+  freq_block *blocks = NULL;
+  if ( nthreads > 1 ) {
+#ifndef _OPENMP
+    LogPrintf( LOG_NORMAL, "WARNING: compiled without OpenMP support; search will be performed by a single thread\n" );
+#endif
+    LogPrintf( LOG_NORMAL, "Searching the semicoherent parameter space using %u threads, in lattice blocks of %u frequency blocks\n", nthreads, nblocks_max );
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      XLAL_CHECK_MAIN( XLALWeaveCacheSetThreads( coh_cache[i], nthreads ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    thread_queries = XLALCalloc( nthreads, sizeof( *thread_queries ) );
+    XLAL_CHECK_MAIN( thread_queries != NULL, XLAL_ENOMEM );
+    thread_semi_res = XLALCalloc( nthreads, sizeof( *thread_semi_res ) );
+    XLAL_CHECK_MAIN( thread_semi_res != NULL, XLAL_ENOMEM );
+    thread_out = XLALCalloc( nthreads, sizeof( *thread_out ) );
+    XLAL_CHECK_MAIN( thread_out != NULL, XLAL_ENOMEM );
+    for ( size_t t = 0; t < nthreads; ++t ) {
+      thread_queries[t] = XLALWeaveCacheQueriesCreate( tiling[isemi], rssky_transf[isemi], dfreq, nsegments, uvar->freq_partitions );
+      XLAL_CHECK_MAIN( thread_queries[t] != NULL, XLAL_EFUNC );
+      thread_out[t] = XLALWeaveOutputResultsThreadCopy( out );
+      XLAL_CHECK_MAIN( thread_out[t] != NULL, XLAL_EFUNC );
+    }
+    blocks = XLALCalloc( nblocks_max + 1, sizeof( *blocks ) );
+    XLAL_CHECK_MAIN( blocks != NULL, XLAL_ENOMEM );
+    for ( size_t n = 0; n <= nblocks_max; ++n ) {
+      GAVEC_MAIN( blocks[n].semi_rssky, ndim );
+    }
+  }
+
   // Start timing main search loop
   XLAL_CHECK_MAIN( XLALWeaveSearchTimingStart( tim ) == XLAL_SUCCESS, XLAL_EFUNC );
 
@@ -900,88 +1035,100 @@ int main( int argc, char *argv[] )
 
   // Begin main loop
   BOOLEAN search_complete = 0;
+  BOOLEAN held_block = 0;
   while ( !search_complete ) {
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Get next semicoherent frequency block
-    // - Exit main loop if iteration is complete
-    // - Expire cache items if requested by iterator
-    BOOLEAN expire_cache = 0;
-    UINT8 semi_index = 0;
-    const gsl_vector *semi_rssky = NULL;
-    INT4 semi_left = 0;
-    INT4 semi_right = 0;
-    UINT4 freq_partition_index = 0;
-    XLAL_CHECK( XLALWeaveSearchIteratorNext( main_loop_itr, &search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( search_complete ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      break;
-    } else if ( expire_cache ) {
-      for ( size_t i = 0; i < nsegments; ++i ) {
-        XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
-      }
-    }
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( nthreads == 1 ) {
 
-    // Initialise cache queries
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Query for coherent results for each segment
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
-    }
+      // Search the next semicoherent frequency block
+      // - Exit main loop if iteration is complete
+      XLAL_CHECK_MAIN( search_next_freq_block( main_loop_itr, &search_complete, nsegments, coh_cache, queries, simulation_level, ndetectors, dfreq, statistics_params, &semi_res, out, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( search_complete ) {
+        break;
+      }
 
-    // Finalise cache queries
-    PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
-    UINT4 semi_nfreqs = 0;
-    XLAL_CHECK_MAIN( XLALWeaveCacheQueriesFinal( queries, &semi_phys, &semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
-    if ( semi_nfreqs == 0 ) {
-      XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-      continue;
-    }
+    } else {
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Hand out the next lattice block: up to 'nblocks_max' consecutive semicoherent frequency blocks
+      // - A frequency block which requires cache items to be expired (i.e. which starts a new partition)
+      //   is held back in 'blocks[nblocks_max]' until the current lattice block has been searched, and
+      //   then begins the next lattice block, so that cache items are only expired between lattice blocks
+      // - Exit main loop once all frequency blocks have been searched
+      UINT4 nblocks = 0;
+      if ( held_block ) {
+        for ( size_t i = 0; i < nsegments; ++i ) {
+          XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+        const freq_block tmp = blocks[0];
+        blocks[0] = blocks[nblocks_max];
+        blocks[nblocks_max] = tmp;
+        nblocks = 1;
+        held_block = 0;
+      }
+      while ( nblocks < nblocks_max ) {
+        BOOLEAN expire_cache = 0;
+        UINT8 semi_index = 0;
+        const gsl_vector *semi_rssky = NULL;
+        INT4 semi_left = 0;
+        INT4 semi_right = 0;
+        UINT4 freq_partition_index = 0;
+        XLAL_CHECK_MAIN( XLALWeaveSearchIteratorNext( main_loop_itr, &search_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+        if ( search_complete ) {
+          break;
+        }
+        if ( expire_cache ) {
+          if ( nblocks > 0 ) {
+            held_block = 1;
+          } else {
+            for ( size_t i = 0; i < nsegments; ++i ) {
+              XLAL_CHECK_MAIN( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+            }
+          }
+        }
+        freq_block *block = &blocks[held_block ? nblocks_max : nblocks];
+        block->semi_index = semi_index;
+        gsl_vector_memcpy( block->semi_rssky, semi_rssky );
+        block->semi_left = semi_left;
+        block->semi_right = semi_right;
+        block->freq_partition_index = freq_partition_index;
+        if ( held_block ) {
+          break;
+        }
+        ++nblocks;
+      }
 
-    // Retrieve coherent results from each segment
-    const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
-    UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
-    UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( coh_res[i] != NULL, XLAL_EFUNC );
-    }
+      // Search frequency blocks of the lattice block in parallel
+      // - Threads share the caches, which compute each coherent result once, and which keep coherent
+      //   results in use by one thread until released, even if evicted from the caches by another thread
+      // - Each thread uses its own cache queries, semicoherent results, and output results
+      // - Search timing is not supported, see check on 'search_threads' above
+      int failed = 0;
+#pragma omp parallel for schedule(dynamic,1) num_threads(nthreads) reduction(|:failed)
+      for ( UINT4 n = 0; n < nblocks; ++n ) {
+#ifdef _OPENMP
+        const size_t t = omp_get_thread_num();
+#else
+        const size_t t = 0;
+#endif
+        if ( !failed ) {
+          const freq_block *block = &blocks[n];
+          failed |= ( search_freq_block( block->semi_index, block->semi_rssky, block->semi_left, block->semi_right, block->freq_partition_index, nsegments, coh_cache, thread_queries[t], simulation_level, ndetectors, dfreq, statistics_params, &thread_semi_res[t], thread_out[t], NULL ) != XLAL_SUCCESS );
+        }
+      }
+      XLAL_CHECK_MAIN( !failed, XLAL_EFUNC, "Parallel search of semicoherent frequency blocks failed" );
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Merge toplists from each thread into output results
+      for ( size_t t = 0; t < nthreads; ++t ) {
+        XLAL_CHECK_MAIN( XLALWeaveOutputResultsMerge( out, thread_out[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
 
-    // Initialise semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsInit( &semi_res, simulation_level, ndetectors, nsegments, semi_index, &semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+      // Exit main loop if all frequency blocks have been searched
+      if ( search_complete ) {
+        break;
+      }
 
-    // Add coherent results to semicoherent results
-    for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveSemiResultsAdd( semi_res, coh_res[i], coh_index[i], coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
 
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Compute all toplist-ranking semicoherent results
-    XLAL_CHECK_MAIN( XLALWeaveSemiResultsComputeMain( semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Add semicoherent results to output
-    XLAL_CHECK_MAIN( XLALWeaveOutputResultsAdd( out, semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-    // Switch timing section
-    XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
-
     // Main iterator percentage complete
     const REAL4 prog_per_cent = XLALWeaveSearchIteratorProgress( main_loop_itr );
 
@@ -1024,7 +1171,8 @@ int main( int argc, char *argv[] )
     }
 
     // Checkpoint output results, if required
-    if ( UVAR_SET( ckpt_output_file ) ) {
+    // - Not while a frequency block is held back, since the main loop iterator has already moved past it
+    if ( UVAR_SET( ckpt_output_file ) && !held_block ) {
 
       // Switch timing section
       XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_CKPT ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1075,6 +1223,23 @@ int main( int argc, char *argv[] )
 
   }   // End of main loop
 
+  // Add counts from per-thread cache queries, and cleanup per-thread memory
+  if ( nthreads > 1 ) {
+    for ( size_t t = 0; t < nthreads; ++t ) {
+      XLAL_CHECK_MAIN( XLALWeaveCacheQueriesAddCounts( queries, thread_queries[t] ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALWeaveCacheQueriesDestroy( thread_queries[t] );
+      XLALWeaveSemiResultsDestroy( thread_semi_res[t] );
+      XLALWeaveOutputResultsDestroy( thread_out[t] );
+    }
+    XLALFree( thread_queries );
+    XLALFree( thread_semi_res );
+    XLALFree( thread_out );
+    for ( size_t n = 0; n <= nblocks_max; ++n ) {
+      GFVEC( blocks[n].semi_rssky );
+    }
+    XLALFree( blocks );
+  }
+
   // Clear all cache items from memory
   for ( size_t i = 0; i < nsegments; ++i ) {
     XLAL_CHECK_MAIN( XLALWeaveCacheClear( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1219,6 +1384,7 @@ int main( int argc, char *argv[] )
   }
 
   // Cleanup memory from loading input data
+  XLALDestroySFTPrefetcher( sft_prefetcher );
   XLALDestroySFTCatalog( sft_catalog );
 
   // Cleanup memory from lattice tilings
@@ -1250,6 +1416,147 @@ int main( int argc, char *argv[] )
 
 }
 
+///
+/// Search the next semicoherent frequency block given by a search iterator
+///
+int search_next_freq_block(
+  WeaveSearchIterator *itr,
+  BOOLEAN *iteration_complete,
+  const size_t nsegments,
+  WeaveCache *const *coh_cache,
+  WeaveCacheQueries *queries,
+  const WeaveSimulationLevel simulation_level,
+  const UINT4 ndetectors,
+  const double dfreq,
+  const WeaveStatisticsParams *statistics_params,
+  WeaveSemiResults **semi_res,
+  WeaveOutputResults *out,
+  WeaveSearchTiming *tim
+  )
+{
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_ITER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Get next semicoherent frequency block
+  // - Return if iteration is complete
+  // - Expire cache items if requested by iterator
+  BOOLEAN expire_cache = 0;
+  UINT8 semi_index = 0;
+  const gsl_vector *semi_rssky = NULL;
+  INT4 semi_left = 0;
+  INT4 semi_right = 0;
+  UINT4 freq_partition_index = 0;
+  XLAL_CHECK( XLALWeaveSearchIteratorNext( itr, iteration_complete, &expire_cache, &semi_index, &semi_rssky, &semi_left, &semi_right, &freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( *iteration_complete ) {
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+  } else if ( expire_cache ) {
+    for ( size_t i = 0; i < nsegments; ++i ) {
+      XLAL_CHECK( XLALWeaveCacheExpire( coh_cache[i] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_ITER, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Search the semicoherent frequency block
+  XLAL_CHECK( search_freq_block( semi_index, semi_rssky, semi_left, semi_right, freq_partition_index, nsegments, coh_cache, queries, simulation_level, ndetectors, dfreq, statistics_params, semi_res, out, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+///
+/// Search a semicoherent frequency block; may be called concurrently by multiple threads sharing
+/// \p coh_cache, provided each thread has its own \p queries, \p semi_res, and \p out
+///
+int search_freq_block(
+  const UINT8 semi_index,
+  const gsl_vector *semi_rssky,
+  const INT4 semi_left,
+  const INT4 semi_right,
+  const UINT4 freq_partition_index,
+  const size_t nsegments,
+  WeaveCache *const *coh_cache,
+  WeaveCacheQueries *queries,
+  const WeaveSimulationLevel simulation_level,
+  const UINT4 ndetectors,
+  const double dfreq,
+  const WeaveStatisticsParams *statistics_params,
+  WeaveSemiResults **semi_res,
+  WeaveOutputResults *out,
+  WeaveSearchTiming *tim
+  )
+{
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OTHER, WEAVE_SEARCH_TIMING_QUERY ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Initialise cache queries
+  XLAL_CHECK( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Query for coherent results for each segment
+  for ( size_t i = 0; i < nsegments; ++i ) {
+    XLAL_CHECK( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Finalise cache queries
+  PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
+  UINT4 semi_nfreqs = 0;
+  XLAL_CHECK( XLALWeaveCacheQueriesFinal( queries, &semi_phys, &semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( semi_nfreqs == 0 ) {
+    XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+  }
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Retrieve coherent results from each segment
+  const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
+  UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
+  UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
+  for ( size_t i = 0; i < nsegments; ++i ) {
+    XLAL_CHECK( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( coh_res[i] != NULL, XLAL_EFUNC );
+  }
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_COH, WEAVE_SEARCH_TIMING_SEMISEG ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Initialise semicoherent results
+  XLAL_CHECK( XLALWeaveSemiResultsInit( semi_res, simulation_level, ndetectors, nsegments, semi_index, &semi_phys, dfreq, semi_nfreqs, statistics_params ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Add coherent results to semicoherent results
+  for ( size_t i = 0; i < nsegments; ++i ) {
+    XLAL_CHECK( XLALWeaveSemiResultsAdd( *semi_res, coh_res[i], coh_index[i], coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Release coherent results from each segment
+  for ( size_t i = 0; i < nsegments; ++i ) {
+    XLAL_CHECK( XLALWeaveCacheRelease( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMISEG, WEAVE_SEARCH_TIMING_SEMI ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Compute all toplist-ranking semicoherent results
+  XLAL_CHECK( XLALWeaveSemiResultsComputeMain( *semi_res, tim ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Add semicoherent results to output
+  XLAL_CHECK( XLALWeaveOutputResultsAdd( out, *semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Switch timing section
+  XLAL_CHECK( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
 // Local Variables:
 // c-file-style: "linux"
 // c-basic-offset: 2
@@ -105,6 +105,40 @@ for setup in short long; do
             env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutNoMax.fits --result-file-2=WeaveOutMax.fits
             set +x
             echo
+
+            echo "=== Setup '${setup}': ${verb} interpolating search with a maximum cache size, keeping evicted items compressed in memory and in a scratch file ==="
+            set -x
+            lalapps_Weave ${weave_cache_options} --cache-compress-mem=0.002 --cache-scratch-dir=. --output-file=WeaveOutTiers.fits \
+                --toplists=all --toplist-limit=2321 --segment-info --setup-file=WeaveSetup.fits \
+                ${weave_sft_options} ${weave_search_options}
+            lalapps_fits_overview WeaveOutTiers.fits
+            set +x
+            echo
+
+            echo "=== Setup '${setup}': Check that with cache tiers number of coherent templates are equal, and no results are recomputed ==="
+            set -x
+            coh_ntmpl_tiers=`lalapps_fits_header_getval "WeaveOutTiers.fits[0]" 'NCOHTPL' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+            coh_nres_tiers=`lalapps_fits_header_getval "WeaveOutTiers.fits[0]" 'NCOHRES' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+            expr ${coh_ntmpl_no_max} '=' ${coh_ntmpl_tiers}
+            expr ${coh_nres_tiers} '=' ${coh_ntmpl_tiers}
+            set +x
+            echo
+
+            echo "=== Setup '${setup}': Check that with cache tiers items are evicted and retrieved from compressed memory and scratch file ==="
+            set -x
+            cache_evict=`lalapps_fits_header_getval "WeaveOutTiers.fits[0]" 'CACHEEVICT' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+            cache_zhit=`lalapps_fits_header_getval "WeaveOutTiers.fits[0]" 'CACHEZHIT' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+            cache_fhit=`lalapps_fits_header_getval "WeaveOutTiers.fits[0]" 'CACHEFHIT' | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+            expr ${cache_evict} '>' 0
+            expr ${cache_zhit} '+' ${cache_fhit} '>' 0
+            set +x
+            echo
+
+            echo "=== Setup '${setup}': Compare F-statistics from lalapps_Weave without a maximum cache size/with cache tiers ==="
+            set -x
+            env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOutNoMax.fits --result-file-2=WeaveOutTiers.fits
+            set +x
+            echo
             ;;
 
         *)
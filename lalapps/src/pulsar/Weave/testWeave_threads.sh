@@ -0,0 +1,89 @@
+# Perform an interpolating search with frequency/spindown partitions using one/several threads, and check for identical results
+
+export LAL_FSTAT_FFT_PLAN_MODE=ESTIMATE
+
+echo "=== Create search setup with 3 segments ==="
+set -x
+lalapps_WeaveSetup --first-segment=1122332211/90000 --segment-count=3 --detectors=H1,L1 --output-file=WeaveSetup.fits
+lalapps_fits_overview WeaveSetup.fits
+set +x
+echo
+
+echo "=== Restrict timestamps to segment list in WeaveSetup.fits ==="
+set -x
+lalapps_fits_table_list 'WeaveSetup.fits[segments][col c1=start_s; col2=end_s]' \
+    | awk 'BEGIN { print "/^#/ { print }" } /^#/ { next } { printf "%i <= $1 && $1 <= %i { print }\n", $1, $2 + 1 }' > timestamp-filter.awk
+awk -f timestamp-filter.awk all-timestamps-1.txt > timestamps-1.txt
+awk -f timestamp-filter.awk all-timestamps-2.txt > timestamps-2.txt
+set +x
+echo
+
+echo "=== Generate SFTs ==="
+set -x
+lalapps_Makefakedata_v5 --randSeed=3456 --fmin=49.5 --Band=2.0 --Tsft=1800 \
+    --outSingleSFT --outSFTdir=. --IFOs=H1,L1 --sqrtSX=1,1 \
+    --timestampsFiles=timestamps-1.txt,timestamps-2.txt
+set +x
+echo
+
+weave_search_options="--toplists=all --toplist-limit=232 --extra-statistics=mean2F_det,sum2F_det,coh2F,coh2F_det --setup-file=WeaveSetup.fits --sft-files=*.sft"
+weave_search_options="${weave_search_options} --freq-partitions=3 --f1dot-partitions=2"
+weave_search_options="${weave_search_options} --sky-patch-count=4 --sky-patch-index=0 --freq=50/0.01 --f1dot=-1e-9,0 --semi-max-mismatch=5 --coh-max-mismatch=0.4"
+
+echo "=== Perform interpolating search using 1 thread ==="
+set -x
+lalapps_Weave --search-threads=1 --output-file=WeaveOut1Thread.fits ${weave_search_options}
+lalapps_fits_overview WeaveOut1Thread.fits
+set +x
+echo
+
+for threads in 2 4; do
+
+    echo "=== Perform interpolating search using ${threads} threads ==="
+    set -x
+    lalapps_Weave --search-threads=${threads} --output-file=WeaveOutThreads.fits ${weave_search_options}
+    lalapps_fits_overview WeaveOutThreads.fits
+    set +x
+    echo
+
+    echo "=== Perform interpolating search using ${threads} threads with checkpointing ==="
+    set -x
+    rm -f WeaveCkpt.fits
+    lalapps_Weave --search-threads=${threads} --output-file=WeaveOutThreadsCkpt.fits --ckpt-output-file=WeaveCkpt.fits --ckpt-output-exit=0.4 ${weave_search_options}
+    lalapps_fits_overview WeaveCkpt.fits
+    lalapps_Weave --search-threads=${threads} --output-file=WeaveOutThreadsCkpt.fits --ckpt-output-file=WeaveCkpt.fits ${weave_search_options}
+    lalapps_fits_overview WeaveOutThreadsCkpt.fits
+    set +x
+    echo
+
+    echo "=== Check that number of coherent and semicoherent templates using 1/${threads} threads are equal ==="
+    set -x
+    for key in NCOHTPL NSEMITPL; do
+        for file in WeaveOutThreads.fits WeaveOutThreadsCkpt.fits; do
+            ntmpl_1=`lalapps_fits_header_getval "WeaveOut1Thread.fits[0]" ${key} | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+            ntmpl_n=`lalapps_fits_header_getval "${file}[0]" ${key} | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+            expr ${ntmpl_1} '=' ${ntmpl_n}
+        done
+    done
+    set +x
+    echo
+
+    echo "=== Check that toplists using 1/${threads} threads are identical ==="
+    set -x
+    for toplist in mean2F sum2F log10BSGL; do
+        lalapps_fits_table_list "WeaveOut1Thread.fits[${toplist}_toplist]" > tmp_1
+        for file in WeaveOutThreads.fits WeaveOutThreadsCkpt.fits; do
+            lalapps_fits_table_list "${file}[${toplist}_toplist]" > tmp_n
+            diff tmp_1 tmp_n
+        done
+    done
+    set +x
+    echo
+
+    echo "=== Compare F-statistics from lalapps_Weave using 1/${threads} threads ==="
+    set -x
+    env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOut1Thread.fits --result-file-2=WeaveOutThreads.fits
+    set +x
+    echo
+
+done
@@ -514,10 +514,10 @@ XLALMakeSFTsFromREAL8TimeSeries ( const REAL8TimeSeries *timeseries,	//!< input
                     "Inconsistent sampling-step (dt=%g) and Tsft=%g: must be integer multiple Tsft/dt = %g >= %g\n",
                     dt, Tsft, timestepsSFT0, eps );
 
-  // prepare window function if requested
-  REAL8Window *window = NULL;
+  // prepare window function if requested; the same window is used for every call with the same SFT parameters, so is taken from the window cache
+  const REAL8Window *window = NULL;
   if ( windowType != NULL ) {
-    XLAL_CHECK_NULL ( (window = XLALCreateNamedREAL8Window ( windowType, windowBeta, timestepsSFT )) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_NULL ( (window = XLALGetCachedNamedREAL8Window ( windowType, windowBeta, timestepsSFT )) != NULL, XLAL_EFUNC );
   }
 
   // ---------- Prepare FFT ----------
@@ -609,7 +609,6 @@ XLALMakeSFTsFromREAL8TimeSeries ( const REAL8TimeSeries *timeseries,	//!< input
   fftw_destroy_plan ( fftplan );
   LAL_FFTW_WISDOM_UNLOCK;
   XLALDestroyREAL8Vector ( timeStretchCopy );
-  XLALDestroyREAL8Window ( window );
 
   return sftvect;
 
@@ -44,13 +44,19 @@ struct tagFstatInput {
   FstatMethodType method;				// Method to use for computing the F-statistic
   FstatCommon common;					// Common input data
   int *workspace_refcount;				// Reference counter for the shared workspace 'common.workspace'
+  int *common_refcount;					// Reference counter for 'common' input data shared with per-thread copies
   FstatMethodFuncs method_funcs;			// Function pointers for F-statistic method
   void *method_data;					// F-statistic method data
 };
 
 // ---------- Internal prototypes ---------- //
 
+typedef int ( *FstatMethodSetupFunc ) ( void **, FstatCommon *, FstatMethodFuncs*, MultiSFTVector *, const FstatOptionalArgs * );
+
 static int XLALSelectBestFstatMethod ( FstatMethodType *method );
+static int XLALParseFstatMethod ( const FstatOptionalArgs *optArgs, int *extraBinsMethod, FstatMethodSetupFunc *setupFuncMethod );
+static int FstatMethodIsDemod ( FstatMethodType method );
+static int FstatMethodIsResamp ( FstatMethodType method );
 
 int XLALSetupFstatDemod  ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
 int XLALSetupFstatResamp ( void **method_data, FstatCommon *common, FstatMethodFuncs* funcs, MultiSFTVector *multiSFTs, const FstatOptionalArgs *optArgs );
@@ -66,6 +72,9 @@ static const char *const FstatMethodNames[FMETHOD_END] = {
 
   [FMETHOD_RESAMP_GENERIC]	= "ResampGeneric",
   [FMETHOD_RESAMP_BEST]		= "ResampBest",
+
+  [FMETHOD_DEMOD_AVX2]		= "DemodAVX2",
+  [FMETHOD_DEMOD_AVX512]	= "DemodAVX512",
 };
 
 const FstatOptionalArgs FstatOptionalArgsDefaults = {
@@ -79,7 +88,10 @@ const FstatOptionalArgs FstatOptionalArgsDefaults = {
   .assumeSqrtSX = NULL,
   .prevInput = NULL,
   .collectTiming = 0,
-  .resampFFTPowerOf2 = 1
+  .resampFFTPowerOf2 = 1,
+  .resampNumThreads = 1,
+  .loadSFTsNumThreads = 1,
+  .prefetchSFTs = NULL
 };
 
 static const char FstatTimingGenericHelp[] =
@@ -378,49 +390,10 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   XLAL_CHECK_NULL ( FstatMethodNames[optArgs.FstatMethod] != NULL, XLAL_EFAULT );
   XLAL_CHECK_NULL ( XLALSelectBestFstatMethod( &optArgs.FstatMethod ) == XLAL_SUCCESS, XLAL_EFAULT );
 
-  //
-  // Parse which F-statistic method to use, and set these variables:
-  // - extraBinsMethod:   any extra SFT frequency bins required by the method
-  // - setupFuncMethod:   method setup function, called at end of XLALCreateFstatInput()
-  //
+  // Parse which F-statistic method to use
   int extraBinsMethod = 0;
-  int (*setupFuncMethod) ( void **, FstatCommon *, FstatMethodFuncs*, MultiSFTVector *, const FstatOptionalArgs * );
-  switch (optArgs.FstatMethod) {
-
-  case FMETHOD_DEMOD_GENERIC:		// Demod: generic C hotloop
-    XLAL_CHECK_NULL ( optArgs.Dterms > 0, XLAL_EINVAL );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_DEMOD_OPTC:		// Demod: gptimized C hotloop using Akos' algorithm
-    XLAL_CHECK_NULL ( optArgs.Dterms <= 20, XLAL_EINVAL, "Selected Hotloop variant 'OptC' only works for Dterms <= 20, got %d\n", optArgs.Dterms );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_DEMOD_ALTIVEC:		// Demod: Altivec hotloop variant
-    XLAL_CHECK_NULL ( optArgs.Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'Altivec' only works for Dterms == 8, got %d\n", optArgs.Dterms );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_DEMOD_SSE:		// Demod: SSE hotloop with precalc divisors
-    XLAL_CHECK_NULL ( optArgs.Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'SSE' only works for Dterms == 8, got %d\n", optArgs.Dterms );
-    extraBinsMethod = optArgs.Dterms;
-    setupFuncMethod = XLALSetupFstatDemod;
-    break;
-
-  case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
-    extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
-    setupFuncMethod = XLALSetupFstatResamp;
-    break;
-
-  default:
-    XLAL_ERROR_NULL ( XLAL_EFAILED, "Missing switch case for optArgs.FstatMethod='%d'\n", optArgs.FstatMethod );
-  }
-  XLAL_CHECK_NULL ( extraBinsMethod >= 0, XLAL_EFAILED );
-  XLAL_CHECK_NULL ( setupFuncMethod != NULL, XLAL_EFAILED );
+  FstatMethodSetupFunc setupFuncMethod = NULL;
+  XLAL_CHECK_NULL ( XLALParseFstatMethod ( &optArgs, &extraBinsMethod, &setupFuncMethod ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // Determine whether to load and/or generate SFTs
   const BOOLEAN loadSFTs = (SFTcatalog->data[0].locator != NULL);
@@ -461,6 +434,10 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
 
   }
 
+  // Allocate reference counter for 'common' input data, which may be shared with per-thread copies
+  XLAL_CHECK_NULL ( ( input->common_refcount = XLALCalloc ( 1, sizeof(*input->common_refcount) ) ) != NULL, XLAL_ENOMEM );
+  (*input->common_refcount) = 1;
+
   // Determine the length of an SFT
   input->Tsft = 1.0 / SFTcatalog->data[0].header.deltaF;
 
@@ -504,8 +481,19 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
   MultiSFTVector *multiSFTs = NULL;
   if (loadSFTs)
     {
-      // Load all SFTs at once
-      XLAL_CHECK_NULL ( ( multiSFTs = XLALLoadMultiSFTs(SFTcatalog, input->minFreqFull, input->maxFreqFull) ) != NULL, XLAL_EFUNC );
+      // Load all SFTs at once, either from a prefetcher or by reading SFT files concurrently
+      if ( optArgs.prefetchSFTs != NULL )
+        {
+          XLAL_CHECK_NULL ( ( multiSFTs = XLALSFTPrefetcherLoad(optArgs.prefetchSFTs, SFTcatalog, input->minFreqFull, input->maxFreqFull) ) != NULL, XLAL_EFUNC );
+        }
+      else
+        {
+          MultiSFTCatalogView *multiSFTcatalog;
+          XLAL_CHECK_NULL ( (multiSFTcatalog = XLALGetMultiSFTCatalogView(SFTcatalog)) != NULL, XLAL_EFUNC );
+          multiSFTs = XLALLoadMultiSFTsFromViewParallel(multiSFTcatalog, input->minFreqFull, input->maxFreqFull, optArgs.loadSFTsNumThreads);
+          XLALDestroyMultiSFTCatalogView(multiSFTcatalog);
+          XLAL_CHECK_NULL ( multiSFTs != NULL, XLAL_EFUNC );
+        }
 
       // Extract detectors and timestamps from SFTs
       XLAL_CHECK_NULL ( XLALMultiLALDetectorFromMultiSFTs ( &common->detectors, multiSFTs ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -633,6 +621,46 @@ int XLALGetFstatInputSFTBand ( const FstatInput *input,  ///< [in] \c FstatInput
 
 }
 
+///
+/// Queue the SFTs that XLALCreateFstatInput() would load for the given arguments with an \c SFTPrefetcher,
+/// so that they are loaded in the background. When XLALCreateFstatInput() is later called with the same
+/// arguments, and with <tt>optionalArgs->prefetchSFTs</tt> set to \p prefetcher, it uses the prefetched SFTs.
+///
+int XLALFstatPrefetchSFTs ( SFTPrefetcher *prefetcher,              ///< [in] SFT prefetcher.
+                            const SFTCatalog *SFTcatalog,           ///< [in] Catalog of SFTs to either load from files, or generate in memory.
+                            const REAL8 minCoverFreq,               ///< [in] Minimum instantaneous frequency which will be covered over the SFT time span.
+                            const REAL8 maxCoverFreq,               ///< [in] Maximum instantaneous frequency which will be covered over the SFT time span.
+                            const FstatOptionalArgs *optionalArgs   ///< [in] Optional 'advanced-level' and method-specific extra arguments; NULL: use defaults from FstatOptionalArgsDefaults.
+  )
+{
+
+  // Check input
+  XLAL_CHECK ( prefetcher != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( SFTcatalog != NULL && SFTcatalog->length > 0, XLAL_EINVAL );
+  XLAL_CHECK ( maxCoverFreq > minCoverFreq, XLAL_EINVAL );
+
+  // Nothing to do if SFTs will be generated rather than loaded
+  if ( SFTcatalog->data[0].locator == NULL ) {
+    return XLAL_SUCCESS;
+  }
+
+  FstatOptionalArgs optArgs = ( optionalArgs != NULL ) ? *optionalArgs : FstatOptionalArgsDefaults;
+  XLAL_CHECK ( XLALSelectBestFstatMethod( &optArgs.FstatMethod ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Extra frequency bins must agree with those used by XLALCreateFstatInput()
+  int extraBinsMethod = 0;
+  FstatMethodSetupFunc setupFuncMethod = NULL;
+  XLAL_CHECK ( XLALParseFstatMethod ( &optArgs, &extraBinsMethod, &setupFuncMethod ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const int extraBinsFull = extraBinsMethod + optArgs.runningMedianWindow/2 + 1;
+  const REAL8 Tsft = 1.0 / SFTcatalog->data[0].header.deltaF;
+  const REAL8 extraFreqFull = extraBinsFull / Tsft;
+
+  XLAL_CHECK ( XLALSFTPrefetcherStart ( prefetcher, SFTcatalog, minCoverFreq - extraFreqFull, maxCoverFreq + extraFreqFull ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} // XLALFstatPrefetchSFTs()
+
 ///
 /// Returns the human-readable name of the \f$\mathcal{F}\f$-statistic method being used by a \c FstatInput structure.
 ///
@@ -723,15 +751,17 @@ XLALGetFstatInputDetectorStates ( const FstatInput* input       ///< [in] \c Fst
 } // XLALGetFstatInputDetectorStates()
 
 ///
-/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
+/// Check the input to XLALComputeFstat(), (re)allocate the results structure, and initialise it for the
+/// given Doppler parameters, which are also returned extrapolated to the SFT mid-time in 'midDoppler'
 ///
-int
-XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a #FstatResults results structure; if \c NULL, allocate here.
-                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
-                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
-                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
-                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
-                   )
+static int
+XLALPrepareFstatResults ( FstatResults **Fstats,
+                          const FstatInput *input,
+                          const PulsarDopplerParams *doppler,
+                          const UINT4 numFreqBins,
+                          const FstatQuantities whatToCompute,
+                          PulsarDopplerParams *midDoppler
+                          )
 {
   // Check input
   XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
@@ -823,15 +853,15 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
     } // if (moreFreqBins || moreDetectors)
 
   // Extrapolate parameters in 'doppler' to SFT mid-time
-  PulsarDopplerParams midDoppler = (*doppler);
+  (*midDoppler) = (*doppler);
   {
     const REAL8 dtau = XLALGPSDiff ( &common->midTime, &doppler->refTime );
-    XLAL_CHECK ( XLALExtrapolatePulsarSpins ( midDoppler.fkdot, midDoppler.fkdot, dtau ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK ( XLALExtrapolatePulsarSpins ( midDoppler->fkdot, midDoppler->fkdot, dtau ) == XLAL_SUCCESS, XLAL_EFUNC );
   }
-  midDoppler.refTime = common->midTime;
+  midDoppler->refTime = common->midTime;
 
   // Initialise result struct parameters
-  (*Fstats)->doppler      = midDoppler;
+  (*Fstats)->doppler      = (*midDoppler);
   (*Fstats)->dFreq        = input->singleFreqBin ? 0 : common->dFreq;
   (*Fstats)->numFreqBins  = numFreqBins;
   (*Fstats)->numDetectors = numDetectors;
@@ -841,8 +871,29 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
   }
   (*Fstats)->whatWasComputed = whatToCompute;
 
+  return XLAL_SUCCESS;
+
+} // XLALPrepareFstatResults()
+
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
+///
+int
+XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a #FstatResults results structure; if \c NULL, allocate here.
+                   FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
+                   const PulsarDopplerParams *doppler,  ///< [in] Doppler parameters, including starting frequency, at which to compute \f$2\mathcal{F}\f$
+                   const UINT4 numFreqBins,             ///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed. Must be 1 if XLALCreateFstatInput() was passed zero \c dFreq.
+                   const FstatQuantities whatToCompute  ///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                   )
+{
+  // Check input, and allocate and initialise results struct
+  XLAL_CHECK ( Fstats != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
+  PulsarDopplerParams midDoppler;
+  XLAL_CHECK ( XLALPrepareFstatResults ( Fstats, input, doppler, numFreqBins, whatToCompute, &midDoppler ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   // Call the appropriate method function to compute the F-statistic
-  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( (input->method_funcs.compute_func) ( *Fstats, &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   (*Fstats)->doppler = (*doppler);
   // Record the internal reference time used, which is required to compute a correct global signal phase
@@ -852,6 +903,73 @@ XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of
 
 } // XLALComputeFstat()
 
+///
+/// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies, for a block of Doppler points which
+/// differ only in their frequency and spindown parameters \c fkdot[].
+///
+/// This is equivalent to calling XLALComputeFstat() for each element of \p dopplers in turn, but allows
+/// F-statistic methods to share work between Doppler points: the \a Resamp methods barycenter the data only
+/// once for the whole block, and compute the FFTs of several spindowns with a single batched FFTW plan.
+/// All other methods simply loop over the Doppler points.
+///
+int
+XLALComputeFstatSpindownBlock ( FstatResults **FstatsBlock,		///< [in/out] Array of \p numDopplers pointers to #FstatResults results structures; any \c NULL elements are allocated here.
+                                FstatInput *input,			///< [in] Input data structure created by one of the setup functions.
+                                const PulsarDopplerParams *dopplers,	///< [in] Array of \p numDopplers Doppler parameters, differing only in \c fkdot[]
+                                const UINT4 numDopplers,		///< [in] Number of Doppler points in the block
+                                const UINT4 numFreqBins,		///< [in] Number of frequencies at which the \f$2\mathcal{F}\f$ are to be computed, for each Doppler point.
+                                const FstatQuantities whatToCompute	///< [in] Bit-field of which \f$\mathcal{F}\f$-statistic quantities to compute.
+                                )
+{
+  // Check input
+  XLAL_CHECK ( FstatsBlock != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( dopplers != NULL, XLAL_EINVAL);
+  XLAL_CHECK ( numDopplers > 0, XLAL_EINVAL);
+
+  // Check that all Doppler points share the same sky position, reference time, and binary parameters
+  const PulsarDopplerParams *doppler0 = &dopplers[0];
+  for ( UINT4 i = 1; i < numDopplers; ++i )
+    {
+      const PulsarDopplerParams *doppler = &dopplers[i];
+      XLAL_CHECK ( doppler->Alpha == doppler0->Alpha && doppler->Delta == doppler0->Delta, XLAL_EINVAL, "Doppler point %u has a different sky position from Doppler point 0", i );
+      XLAL_CHECK ( XLALGPSCmp ( &doppler->refTime, &doppler0->refTime ) == 0, XLAL_EINVAL, "Doppler point %u has a different reference time from Doppler point 0", i );
+      XLAL_CHECK ( doppler->asini == doppler0->asini && doppler->period == doppler0->period && doppler->ecc == doppler0->ecc
+                   && doppler->argp == doppler0->argp && XLALGPSCmp ( &doppler->tp, &doppler0->tp ) == 0,
+                   XLAL_EINVAL, "Doppler point %u has different binary parameters from Doppler point 0", i );
+    }
+
+  // Allocate and initialise results structs
+  PulsarDopplerParams midDoppler;
+  for ( UINT4 i = 0; i < numDopplers; ++i )
+    {
+      XLAL_CHECK ( XLALPrepareFstatResults ( &FstatsBlock[i], input, &dopplers[i], numFreqBins, whatToCompute, &midDoppler ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+  // Call the appropriate method function to compute the F-statistic, if it supports blocks of Doppler points; otherwise loop
+  if ( input->method_funcs.compute_block_func != NULL )
+    {
+      XLAL_CHECK ( (input->method_funcs.compute_block_func) ( FstatsBlock, numDopplers, &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  else
+    {
+      for ( UINT4 i = 0; i < numDopplers; ++i )
+        {
+          XLAL_CHECK ( (input->method_funcs.compute_func) ( FstatsBlock[i], &input->common, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+    }
+
+  for ( UINT4 i = 0; i < numDopplers; ++i )
+    {
+      FstatsBlock[i]->doppler = dopplers[i];
+      // Record the internal reference time used, which is required to compute a correct global signal phase
+      FstatsBlock[i]->refTimePhase = midDoppler.refTime;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatSpindownBlock()
+
 ///
 /// Free all memory associated with a \c FstatInput structure.
 ///
@@ -864,7 +982,7 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
   }
   if ( input->common.isTimeslice )
     {
-      XLAL_CHECK_VOID ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL,
+      XLAL_CHECK_VOID ( FstatMethodIsDemod ( input->method ), XLAL_EINVAL,
                         "Something is wrong: 'isTimeslice==TRUE' for non-LALDemod F-stat method '%s' is not supported!\n", XLALGetFstatInputMethodName(input));
       XLALDestroyFstatInputTimeslice_common ( &input->common );
       XLALDestroyFstatInputTimeslice_Demod ( input->method_data);
@@ -872,9 +990,13 @@ XLALDestroyFstatInput ( FstatInput* input       ///< [in] \c FstatInput structur
       return;
     }
 
-  XLALDestroyMultiTimestamps ( input->common.multiTimestamps );
-  XLALDestroyMultiNoiseWeights ( input->common.multiNoiseWeights );
-  XLALDestroyMultiDetectorStateSeries ( input->common.multiDetectorStates );
+  // Release a reference to 'common' input data, free it if there are no more outstanding references (from per-thread copies)
+  if ( --(*input->common_refcount) == 0 ) {
+    XLALDestroyMultiTimestamps ( input->common.multiTimestamps );
+    XLALDestroyMultiNoiseWeights ( input->common.multiNoiseWeights );
+    XLALDestroyMultiDetectorStateSeries ( input->common.multiDetectorStates );
+    XLALFree ( input->common_refcount );
+  }
 
   // Release a reference to 'common.workspace'; if there are no more outstanding references ...
   if ( --(*input->workspace_refcount) == 0 ) {
@@ -1055,6 +1177,60 @@ XLALComputeFstatFromAtoms ( const MultiFstatAtomVector *multiFstatAtoms,   ///<
 
 } // XLALComputeFstatFromAtoms()
 
+///
+/// Parse which F-statistic method to use, and return:
+/// - extraBinsMethod:   any extra SFT frequency bins required by the method
+/// - setupFuncMethod:   method setup function, called at end of XLALCreateFstatInput()
+///
+static int
+XLALParseFstatMethod ( const FstatOptionalArgs *optArgs, int *extraBinsMethod, FstatMethodSetupFunc *setupFuncMethod )
+{
+  switch (optArgs->FstatMethod) {
+
+  case FMETHOD_DEMOD_GENERIC:		// Demod: generic C hotloop
+    XLAL_CHECK ( optArgs->Dterms > 0, XLAL_EINVAL );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_OPTC:		// Demod: gptimized C hotloop using Akos' algorithm
+    XLAL_CHECK ( optArgs->Dterms <= 20, XLAL_EINVAL, "Selected Hotloop variant 'OptC' only works for Dterms <= 20, got %d\n", optArgs->Dterms );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_ALTIVEC:		// Demod: Altivec hotloop variant
+    XLAL_CHECK ( optArgs->Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'Altivec' only works for Dterms == 8, got %d\n", optArgs->Dterms );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_SSE:		// Demod: SSE hotloop with precalc divisors
+    XLAL_CHECK ( optArgs->Dterms == 8, XLAL_EINVAL, "Selected Hotloop variant 'SSE' only works for Dterms == 8, got %d\n", optArgs->Dterms );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_DEMOD_AVX2:		// Demod: AVX2 hotloop
+  case FMETHOD_DEMOD_AVX512:		// Demod: AVX-512 hotloop
+    XLAL_CHECK ( optArgs->Dterms > 0, XLAL_EINVAL );
+    *extraBinsMethod = optArgs->Dterms;
+    *setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
+  case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
+    *extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
+    *setupFuncMethod = XLALSetupFstatResamp;
+    break;
+
+  default:
+    XLAL_ERROR ( XLAL_EFAILED, "Missing switch case for optArgs->FstatMethod='%d'\n", optArgs->FstatMethod );
+  }
+  XLAL_CHECK ( *extraBinsMethod >= 0, XLAL_EFAILED );
+  XLAL_CHECK ( *setupFuncMethod != NULL, XLAL_EFAILED );
+  return XLAL_SUCCESS;
+}
+
 ///
 /// If user asks for a 'best' #FstatMethodType, find and select it
 ///
@@ -1064,6 +1240,19 @@ XLALSelectBestFstatMethod ( FstatMethodType *method )
   switch ( *method ) {
 
   case FMETHOD_DEMOD_BEST:
+    // The AVX2 and AVX-512 hotloops are appended to the FstatMethodType enum, after the 'best'
+    // methods, so they are not found by decrementing FMETHOD_DEMOD_BEST below; try them first
+    if ( XLALFstatMethodIsAvailable( FMETHOD_DEMOD_AVX512 ) ) {
+      *method = FMETHOD_DEMOD_AVX512;
+    } else if ( XLALFstatMethodIsAvailable( FMETHOD_DEMOD_AVX2 ) ) {
+      *method = FMETHOD_DEMOD_AVX2;
+    }
+    if ( *method != FMETHOD_DEMOD_BEST ) {
+      XLALPrintInfo( "%s: Fstat method '%s' is available; selected as best method\n", __func__, FstatMethodNames[*method] );
+      break;
+    }
+    // fall through
+
   case FMETHOD_RESAMP_BEST:
     // If user asks for a 'best' method:
     //   Decrement the current method, then check for the first available Fstat method. This assumes the FstatMethodType enum is ordered as follows:
@@ -1088,6 +1277,24 @@ XLALSelectBestFstatMethod ( FstatMethodType *method )
   return XLAL_SUCCESS;
 }
 
+///
+/// Return true if given #FstatMethodType is a \a Demod method
+///
+static int
+FstatMethodIsDemod ( FstatMethodType method )
+{
+  return ( FMETHOD_DEMOD_GENERIC <= method && method <= FMETHOD_DEMOD_BEST ) || method == FMETHOD_DEMOD_AVX2 || method == FMETHOD_DEMOD_AVX512;
+}
+
+///
+/// Return true if given #FstatMethodType is a \a Resamp method
+///
+static int
+FstatMethodIsResamp ( FstatMethodType method )
+{
+  return FMETHOD_RESAMP_GENERIC <= method && method <= FMETHOD_RESAMP_BEST;
+}
+
 ///
 /// Return true if given #FstatMethodType corresponds to a valid and *available* Fstat method, false otherwise
 ///
@@ -1124,6 +1331,24 @@ XLALFstatMethodIsAvailable ( FstatMethodType method )
     return 0;
 #endif
 
+  case FMETHOD_DEMOD_AVX2:
+    // This method is available only if compiled with AVX2 support,
+    // and AVX2 is available on the current execution machine
+#ifdef HAVE_AVX2_COMPILER
+    return LAL_HAVE_AVX2_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_DEMOD_AVX512:
+    // This method is available only if compiled with AVX-512 support,
+    // and AVX-512 is available on the current execution machine
+#ifdef HAVE_AVX512F_COMPILER
+    return LAL_HAVE_AVX512F_RUNTIME();
+#else
+    return 0;
+#endif
+
   default:
     return 0;
 
@@ -1197,11 +1422,11 @@ XLALGetFstatTiming ( const FstatInput* input, FstatTimingGeneric *timingGeneric,
   XLAL_CHECK ( timingGeneric != NULL, XLAL_EINVAL );
   XLAL_CHECK ( timingModel != NULL, XLAL_EINVAL );
 
-  if ( input->method >= FMETHOD_DEMOD_GENERIC && input->method <= FMETHOD_DEMOD_BEST)
+  if ( FstatMethodIsDemod ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Demod ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
-  else if ( input->method >= FMETHOD_RESAMP_GENERIC && input->method <= FMETHOD_RESAMP_BEST)
+  else if ( FstatMethodIsResamp ( input->method ) )
     {
       XLAL_CHECK ( XLALGetFstatTiming_Resamp ( input->method_data, timingGeneric, timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
@@ -1270,7 +1495,7 @@ XLALExtractResampledTimeseries ( MultiCOMPLEX8TimeSeries **multiTimeSeries_SRC_a
 {
   XLAL_CHECK ( input != NULL, XLAL_EINVAL );
   XLAL_CHECK ( ( multiTimeSeries_SRC_a != NULL ) && ( multiTimeSeries_SRC_b != NULL ) , XLAL_EINVAL );
-  XLAL_CHECK ( (input->method >= FMETHOD_RESAMP_GENERIC) && (input->method <= FMETHOD_RESAMP_BEST), XLAL_EINVAL,
+  XLAL_CHECK ( FstatMethodIsResamp ( input->method ), XLAL_EINVAL,
                "%s() only works for resampling-Fstat methods, not with '%s'\n", __func__, XLALGetFstatInputMethodName ( input ) );
 
   XLAL_CHECK ( XLALExtractResampledTimeseries_intern ( multiTimeSeries_SRC_a, multiTimeSeries_SRC_b, input->method_data ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -1304,7 +1529,7 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
               LAL_GPS_PRINT(*minStartGPS), LAL_GPS_PRINT(*maxStartGPS) );
 
   // only supported for 'LALDemod' Fstat methods
-  XLAL_CHECK ( input->method < FMETHOD_RESAMP_GENERIC, XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
+  XLAL_CHECK ( FstatMethodIsDemod ( input->method ), XLAL_EINVAL, "This function is not avavible for the chosen FstatMethod '%s'!", XLALGetFstatInputMethodName ( input ) );
 
   const FstatCommon *common = &(input->common);
   UINT4 numIFOs = common->detectors.length;
@@ -1420,6 +1645,58 @@ XLALFstatInputTimeslice ( FstatInput ** slice,                ///< [out] Address
 
 } // XLALFstatInputTimeslice()
 
+///
+/// Create and return a copy of the given FstatInput object [must be using a Resamp Fstat method!],
+/// which can be used by a different thread to call XLALComputeFstat() concurrently with 'input'.
+///
+/// The copy shares all immutable data with 'input', namely the SFT timestamps, noise weights, detector states,
+/// the detector-frame timeseries and the FFT plan, but has its own workspace and buffers. Each copy computes serially,
+/// so several copies can be used to parallelise a search e.g.\ over templates with one copy per thread.
+/// The copy must be freed with XLALDestroyFstatInput(); the shared data is freed once 'input' and all its copies are destroyed.
+///
+/// Note: copies must be created and destroyed by a single thread, i.e.\ outside of any parallel region.
+///
+int
+XLALFstatInputThreadCopy ( FstatInput ** copy,                ///< [out] Address of a pointer to a \c FstatInput structure
+                           const FstatInput* input            ///< [in] Input data structure
+                           )
+{
+  XLAL_CHECK ( input != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( copy != NULL && (*copy) == NULL, XLAL_EINVAL );
+
+  // only supported for 'Resamp' Fstat methods
+  XLAL_CHECK ( FstatMethodIsResamp ( input->method ), XLAL_EINVAL,
+               "%s() only works for resampling-Fstat methods, not with '%s'\n", __func__, XLALGetFstatInputMethodName ( input ) );
+  XLAL_CHECK ( !input->common.isTimeslice, XLAL_EINVAL );
+
+  // allocate memory and copy the orginal FstatInput struct
+  FstatInput *ret;
+  XLAL_CHECK ( ( ret = XLALCalloc ( 1 , sizeof(*input) ) ) != NULL, XLAL_ENOMEM );
+  memcpy ( ret, input, sizeof ( *input ) );
+
+  // the copy uses its own workspace, allocated by the method copy function
+  ret->common.workspace = NULL;
+  if ( ( ret->workspace_refcount = XLALCalloc ( 1, sizeof(*ret->workspace_refcount) ) ) == NULL ) {
+    XLALFree ( ret );
+    XLAL_ERROR ( XLAL_ENOMEM );
+  }
+  (*ret->workspace_refcount) = 1;
+
+  if ( ( ret->method_data = XLALFstatInputThreadCopy_Resamp ( &ret->common, input->method_data ) ) == NULL ) {
+    XLALFree ( ret->workspace_refcount );
+    XLALFree ( ret );
+    XLAL_ERROR ( XLAL_EFUNC );
+  }
+
+  // share 'common' input data, now that the copy can no longer fail
+  ++(*ret->common_refcount);
+
+  (*copy) = ret;
+
+  return XLAL_SUCCESS;
+
+} // XLALFstatInputThreadCopy()
+
 
 void
 XLALDestroyFstatInputTimeslice_common ( FstatCommon *common )
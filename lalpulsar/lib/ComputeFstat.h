@@ -121,6 +121,10 @@ typedef enum tagFstatMethodType {
   FMETHOD_RESAMP_GENERIC,	///< \a Resamp: generic implementation
   FMETHOD_RESAMP_BEST,		///< \a Resamp: best guess of the fastest available implementation
 
+  // Methods added later are appended here, so that the values of existing methods do not change
+  FMETHOD_DEMOD_AVX2,		///< \a Demod: AVX2 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
+  FMETHOD_DEMOD_AVX512,		///< \a Demod: AVX-512 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
+
   /// \cond DONT_DOXYGEN
   FMETHOD_END
   /// \endcond
@@ -143,7 +147,10 @@ typedef struct tagFstatOptionalArgs {
   FstatInput *prevInput;		///< An \c FstatInput structure from a previous call to XLALCreateFstatInput(); may contain common workspace data than can be re-used to save memory.
   BOOLEAN collectTiming;		///< a flag to turn on/off the collection of F-stat-method-specific timing-data
   BOOLEAN resampFFTPowerOf2;		///< \a Resamp: round up FFT lengths to next power of 2; see #FstatMethodType.
+  UINT4 resampNumThreads;		///< \a Resamp: number of threads used by XLALComputeFstat() over detectors and frequency bins; serial if <= 1.
   REAL8 allowedMismatchFromSFTLength;      ///<  Optional override for XLALFstatCheckSFTLengthMismatch().
+  UINT4 loadSFTsNumThreads;		///< Number of threads used to read SFT files concurrently; serial if <= 1.
+  SFTPrefetcher *prefetchSFTs;		///< If non-NULL, retrieve SFTs through this prefetcher, which may already have loaded them in the background; see XLALSFTPrefetcherStart().
 } FstatOptionalArgs;
 
 ///
@@ -343,6 +350,8 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog, const REAL8 minCoverFreq, c
                        const EphemerisData *ephemerides, const FstatOptionalArgs *optionalArgs );
 
 int XLALGetFstatInputSFTBand ( const FstatInput *input, REAL8 *minFreqFull, REAL8 *maxFreqFull );
+int XLALFstatPrefetchSFTs ( SFTPrefetcher *prefetcher, const SFTCatalog *SFTcatalog, const REAL8 minCoverFreq, const REAL8 maxCoverFreq,
+                            const FstatOptionalArgs *optionalArgs );
 const CHAR *XLALGetFstatInputMethodName ( const FstatInput* input );
 const MultiLALDetector* XLALGetFstatInputDetectors ( const FstatInput* input );
 const MultiLIGOTimeGPSVector* XLALGetFstatInputTimestamps ( const FstatInput* input );
@@ -352,12 +361,15 @@ int  XLALExtractResampledTimeseries ( MultiCOMPLEX8TimeSeries **multiTimeSeries_
 int XLALGetFstatTiming ( const FstatInput* input, FstatTimingGeneric *timingGeneric, FstatTimingModel *timingModel );
 int XLALAppendFstatTiming2File ( const FstatInput* input, FILE *fp, BOOLEAN printHeader );
 int XLALFstatInputTimeslice ( FstatInput** slice, const FstatInput* input, const LIGOTimeGPS *minStartGPS, const LIGOTimeGPS *maxStartGPS);
+int XLALFstatInputThreadCopy ( FstatInput** copy, const FstatInput* input );
 
 #ifdef SWIG // SWIG interface directives
 SWIGLAL(INOUT_STRUCTS(FstatResults**, Fstats));
 #endif
 int XLALComputeFstat ( FstatResults **Fstats, FstatInput *input, const PulsarDopplerParams *doppler,
                        const UINT4 numFreqBins, const FstatQuantities whatToCompute );
+int XLALComputeFstatSpindownBlock ( FstatResults **FstatsBlock, FstatInput *input, const PulsarDopplerParams *dopplers,
+                                    const UINT4 numDopplers, const UINT4 numFreqBins, const FstatQuantities whatToCompute );
 
 void XLALDestroyFstatInput ( FstatInput* input );
 void XLALDestroyFstatResults ( FstatResults* Fstats );
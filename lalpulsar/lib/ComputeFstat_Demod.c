@@ -104,6 +104,16 @@ int XLALComputeFaFb_SSE     ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **Fsta
                               const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
 #endif
 
+#ifdef HAVE_AVX2_COMPILER
+int XLALComputeFaFb_AVX2    ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
+#ifdef HAVE_AVX512F_COMPILER
+int XLALComputeFaFb_AVX512  ( COMPLEX8 *Fa, COMPLEX8 *Fb, FstatAtomVector **FstatAtoms, const SFTVector *sfts,
+                              const PulsarSpins fkdot, const SSBtimes *tSSB, const AMCoeffs *amcoe, const UINT4 Dterms );
+#endif
+
 // ----- local function definitions ----------
 static int
 XLALComputeFstatDemod ( FstatResults* Fstats,
@@ -431,6 +441,16 @@ XLALSetupFstatDemod ( void **method_data,
   case FMETHOD_DEMOD_SSE:
     demod->computefafb_func = XLALComputeFaFb_SSE;
     break;
+#endif
+#ifdef HAVE_AVX2_COMPILER
+  case FMETHOD_DEMOD_AVX2:
+    demod->computefafb_func = XLALComputeFaFb_AVX2;
+    break;
+#endif
+#ifdef HAVE_AVX512F_COMPILER
+  case FMETHOD_DEMOD_AVX512:
+    demod->computefafb_func = XLALComputeFaFb_AVX512;
+    break;
 #endif
   default:
     XLAL_ERROR ( XLAL_EINVAL, "Invalid Demod hotloop optArgs->FstatMethod='%d'", optArgs->FstatMethod );
@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+/// [hotloop]
+/* NOTE: sin[ 2pi (Dphi_alpha - k) ] = sin [ 2pi Dphi_alpha ], therefore
+ * the trig-functions need to be calculated only once!
+ * We choose the value sin[ 2pi(Dphi_alpha - kstar) ] because it is the
+ * closest to zero and will pose no numerical difficulties !
+ */
+{
+  {
+    /* AVX2 version of the 'vanilla' hotloop: the 2*Dterms kernel denominators
+     * are independent, so 4 complex bins (8 floats) are divided and summed per
+     * vector; the common factors s_alpha, c_alpha are applied once at the end.
+     * Works for any Dterms; the < 4 left-over bins are summed in scalar code.
+     */
+    const REAL4 kappa_max = kappa_star + 1.0f * Dterms - 1.0f;
+    const UINT4 numBins = 2 * Dterms;
+    const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+
+    /* lane offsets of the (re,im) pairs of 4 consecutive bins, low to high */
+    const __m256 lane_l = _mm256_set_ps( 3.0f, 3.0f, 2.0f, 2.0f, 1.0f, 1.0f, 0.0f, 0.0f );
+    const __m256 kmax = _mm256_set1_ps( kappa_max );
+    __m256 UV = _mm256_setzero_ps();
+
+    UINT4 l = 0;
+    for ( ; l + 4 <= numBins; l += 4 )
+      {
+        const __m256 x = _mm256_sub_ps( kmax, _mm256_add_ps( _mm256_set1_ps( (REAL4) l ), lane_l ) );
+        UV = _mm256_add_ps( UV, _mm256_div_ps( _mm256_loadu_ps( Xa + 2*l ), x ) );
+      } /* for l < numBins */
+
+    /* horizontal sum of even (U) and odd (V) lanes */
+    __m128 UV2 = _mm_add_ps( _mm256_castps256_ps128( UV ), _mm256_extractf128_ps( UV, 1 ) );
+    UV2 = _mm_add_ps( UV2, _mm_movehl_ps( UV2, UV2 ) );
+    REAL4 U_alpha = _mm_cvtss_f32( UV2 );
+    REAL4 V_alpha = _mm_cvtss_f32( _mm_shuffle_ps( UV2, UV2, 1 ) );
+
+    for ( ; l < numBins; l ++ )
+      {
+        const REAL4 xinv = 1.0f / ( kappa_max - l );
+        U_alpha += Xa[2*l] * xinv;
+        V_alpha += Xa[2*l + 1] * xinv;
+      } /* for l < numBins */
+
+    REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+    XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star );
+    c_alpha -= 1.0f;
+
+    realXP = s_alpha * U_alpha - c_alpha * V_alpha;
+    imagXP = c_alpha * U_alpha + s_alpha * V_alpha;
+  }
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
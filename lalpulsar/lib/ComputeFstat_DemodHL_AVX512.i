@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+/// [hotloop]
+/* NOTE: sin[ 2pi (Dphi_alpha - k) ] = sin [ 2pi Dphi_alpha ], therefore
+ * the trig-functions need to be calculated only once!
+ * We choose the value sin[ 2pi(Dphi_alpha - kstar) ] because it is the
+ * closest to zero and will pose no numerical difficulties !
+ */
+{
+  {
+    /* AVX-512 version of the 'vanilla' hotloop: 8 complex bins (16 floats) are
+     * divided and summed per vector; works for any Dterms, the last partial
+     * vector is handled with a lane mask, so no scalar remainder is needed.
+     */
+    const REAL4 kappa_max = kappa_star + 1.0f * Dterms - 1.0f;
+    const UINT4 numBins = 2 * Dterms;
+    const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+
+    /* lane offsets of the (re,im) pairs of 8 consecutive bins, low to high */
+    const __m512 lane_l = _mm512_set_ps( 7.0f, 7.0f, 6.0f, 6.0f, 5.0f, 5.0f, 4.0f, 4.0f,
+                                         3.0f, 3.0f, 2.0f, 2.0f, 1.0f, 1.0f, 0.0f, 0.0f );
+    const __m512 kmax = _mm512_set1_ps( kappa_max );
+    __m512 UV = _mm512_setzero_ps();
+
+    for ( UINT4 l = 0; l < numBins; l += 8 )
+      {
+        const UINT4 n = ( numBins - l < 8 ) ? ( numBins - l ) : 8;
+        const __mmask16 mask = (__mmask16) ( ( 1U << ( 2*n ) ) - 1 );
+        const __m512 x = _mm512_sub_ps( kmax, _mm512_add_ps( _mm512_set1_ps( (REAL4) l ), lane_l ) );
+        const __m512 X = _mm512_maskz_loadu_ps( mask, Xa + 2*l );
+        UV = _mm512_add_ps( UV, _mm512_maskz_div_ps( mask, X, x ) );
+      } /* for l < numBins */
+
+    /* horizontal sum of even (U) and odd (V) lanes */
+    const REAL4 U_alpha = _mm512_mask_reduce_add_ps( 0x5555, UV );
+    const REAL4 V_alpha = _mm512_mask_reduce_add_ps( 0xAAAA, UV );
+
+    REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+    XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star );
+    c_alpha -= 1.0f;
+
+    realXP = s_alpha * U_alpha - c_alpha * V_alpha;
+    imagXP = c_alpha * U_alpha + s_alpha * V_alpha;
+  }
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
@@ -65,6 +65,11 @@
 
 // ----- local constants
 
+// maximal number of spindowns whose FFTs are batched together by XLALComputeFstatResampBlock(),
+// and maximal memory (in bytes) to use for the buffers of a batch
+#define RESAMP_FFT_BATCH_MAX		8
+#define RESAMP_FFT_BATCH_MAXBYTES	(64 * 1024 * 1024)
+
 // ----- local types ----------
 
 // ---------- BEGIN: Resamp-specific timing model data ----------
@@ -137,12 +142,37 @@ typedef struct tagResampWorkspace
   COMPLEX8 *Fb_k;		// properly normalized F_b(f_k) over output bins
   UINT4 numFreqBinsAlloc;	// internal: keep track of allocated length of frequency-arrays
 
+  // buffers for batched FFTs over a block of spindowns, see XLALComputeFstatResampBlock()
+  UINT4 lenFFTBlockAlloc;	// allocated length of each of the following two arrays
+  COMPLEX8 *TS_FFT_block;	// zero-padded, spindown-corr SRC-frame TS for a batch of spindowns, times a(t) and b(t)
+  COMPLEX8 *FabX_Raw_block;	// raw full-band FFT results for a batch of spindowns
+  UINT4 lenFabBlockAlloc;	// allocated length of the following array
+  COMPLEX8 *Fab_k_block;	// Fa_k, Fb_k, FaX_k, FbX_k for a batch of spindowns, if not returned in FstatResults
+
 } ResampWorkspace;
 
-typedef struct
+// ----- immutable input data, shared between an FstatInput and all its per-thread copies ----------
+typedef struct tagResampSharedInput
 {
+  int refcount;						// Reference counter: number of ResampMethodData structs using this input
   UINT4 Dterms;						// Number of terms to use (on either side) in Windowed-Sinc interpolation kernel
   MultiCOMPLEX8TimeSeries  *multiTimeSeries_DET;	// input SFTs converted into a heterodyned timeseries
+  UINT4 numSamplesMax_SRC;				// maximal length of a single-detector SRC-frame timeseries (for allocating workspace)
+  UINT4 numSamplesFFT;					// length of zero-padded SRC-frame timeseries (related to dFreq)
+  UINT4 decimateFFT;					// output every n-th frequency bin, with n>1 iff (dFreq > 1/Tspan), and was internally decreased by n
+  fftwf_plan fftplan;					// FFT plan: only ever executed via the thread-safe new-array interface fftwf_execute_dft()
+} ResampSharedInput;
+
+typedef struct
+{
+  ResampSharedInput *shared;				// immutable input data, shared with per-thread copies of this FstatInput
+  UINT4 numThreads;					// number of threads used internally by XLALComputeFstatResamp(); serial if <= 1
+  UINT4 numSubBands;					// number of time ranges and frequency sub-bands each detector is split into, if numThreads > 1
+  ResampWorkspace *wsPerDet[PULSAR_MAX_DETECTORS];	// per-detector workspaces, only allocated if numThreads > 1
+  UINT4 numFFTBatch;					// number of spindowns whose FFTs are batched together by XLALComputeFstatResampBlock()
+  UINT4 strideFFT;					// distance between zero-padded timeseries in a batch, rounded up from numSamplesFFT to preserve alignment
+  fftwf_plan fftplan_block;				// batched FFT plan for 2*numFFTBatch timeseries, created on first use
+
   // ----- buffering -----
   PulsarDopplerParams prev_doppler;			// buffering: previous phase-evolution ("doppler") parameters
   MultiAMCoeffs *multiAMcoef;				// buffered antenna-pattern functions
@@ -155,10 +185,6 @@ typedef struct
   MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a;	// multi-detector SRC-frame timeseries, multiplied by AM function a(t)
   MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b;	// multi-detector SRC-frame timeseries, multiplied by AM function b(t)
 
-  UINT4 numSamplesFFT;					// length of zero-padded SRC-frame timeseries (related to dFreq)
-  UINT4 decimateFFT;					// output every n-th frequency bin, with n>1 iff (dFreq > 1/Tspan), and was internally decreased by n
-  fftwf_plan fftplan;					// FFT plan
-
   // ----- timing -----
   BOOLEAN collectTiming;				// flag whether or not to collect timing information
   FstatTimingGeneric timingGeneric;			// measured (generic) F-statistic timing values
@@ -177,6 +203,13 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
                          void *method_data
                        );
 
+static int
+XLALComputeFstatResampBlock ( FstatResults **Fstats,
+                              const UINT4 numFstats,
+                              const FstatCommon *common,
+                              void *method_data
+                              );
+
 static int
 XLALApplySpindownAndFreqShift ( COMPLEX8 *xOut,
                                 const COMPLEX8TimeSeries *xIn,
@@ -184,12 +217,74 @@ XLALApplySpindownAndFreqShift ( COMPLEX8 *xOut,
                                 REAL8 freqShift
                                 );
 
+static int
+XLALApplySpindownAndFreqShiftRange ( COMPLEX8 *xOut,
+                                     const COMPLEX8TimeSeries *xIn,
+                                     const PulsarDopplerParams *doppler,
+                                     REAL8 freqShift,
+                                     UINT4 jStart,
+                                     UINT4 jEnd
+                                     );
+
+static int
+XLALBarycentricResampleCOMPLEX8TimeSeriesX ( ResampMethodData *resamp,
+                                             ResampWorkspace *ws,
+                                             const MultiSSBtimes *multiSRCtimes,
+                                             const FstatCommon *common,
+                                             UINT4 X
+                                             );
+
+static int
+XLALBarycentricResamplePrepareX ( ResampMethodData *resamp,
+                                  ResampWorkspace *ws,
+                                  const MultiSSBtimes *multiSRCtimes,
+                                  const FstatCommon *common,
+                                  UINT4 X
+                                  );
+
+static int
+XLALBarycentricResampleInterpolateX ( ResampMethodData *resamp,
+                                      ResampWorkspace *ws,
+                                      UINT4 X,
+                                      UINT4 jStart,
+                                      UINT4 jEnd
+                                      );
+
 static int
 XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,
                                                  const PulsarDopplerParams *thisPoint,
                                                  const FstatCommon *common
                                                  );
 
+static int
+XLALResampFFTOffsets ( REAL8 *freqShift,
+                       UINT4 *offset_bins,
+                       const ResampMethodData *resamp,
+                       const PulsarDopplerParams *thisPoint,
+                       REAL8 dFreq,
+                       UINT4 numFreqBins,
+                       REAL8 fHet
+                       );
+
+static void
+XLALResampNormaliseFaFbX ( COMPLEX8 *FaX_k,
+                           COMPLEX8 *FbX_k,
+                           const PulsarDopplerParams *thisPoint,
+                           REAL8 dFreq,
+                           UINT4 numFreqBins,
+                           const COMPLEX8TimeSeries *TimeSeries_SRC
+                           );
+
+static void
+XLALResampNormaliseFaFbXRange ( COMPLEX8 *FaX_k,
+                                COMPLEX8 *FbX_k,
+                                const PulsarDopplerParams *thisPoint,
+                                REAL8 dFreq,
+                                UINT4 kStart,
+                                UINT4 kEnd,
+                                const COMPLEX8TimeSeries *TimeSeries_SRC
+                                );
+
 static int
 XLALComputeFaFb_Resamp ( ResampMethodData *resamp,
                          ResampWorkspace *ws,
@@ -211,6 +306,9 @@ static void
 XLALDestroyResampWorkspace ( void *workspace )
 {
   ResampWorkspace *ws = (ResampWorkspace*) workspace;
+  if ( ws == NULL ) {
+    return;
+  }
 
   XLALDestroyCOMPLEX8Vector ( ws->TStmp1_SRC );
   XLALDestroyCOMPLEX8Vector ( ws->TStmp2_SRC );
@@ -224,11 +322,160 @@ XLALDestroyResampWorkspace ( void *workspace )
   XLALFree ( ws->Fa_k );
   XLALFree ( ws->Fb_k );
 
+  fftw_free ( ws->TS_FFT_block );
+  fftw_free ( ws->FabX_Raw_block );
+  XLALFree ( ws->Fab_k_block );
+
   XLALFree ( ws );
   return;
 
 } // XLALDestroyResampWorkspace()
 
+///
+/// Create a new workspace, or enlarge an existing one, to hold single-detector
+/// SRC-frame timeseries of up to 'numSamplesMax_SRC' and FFTs of length 'numSamplesFFT'
+///
+static int
+XLALResampWorkspaceEnsure ( ResampWorkspace **ws_io,
+                            UINT4 numSamplesMax_SRC,
+                            UINT4 numSamplesFFT
+                            )
+{
+  XLAL_CHECK ( ws_io != NULL, XLAL_EINVAL );
+
+  ResampWorkspace *ws = (*ws_io);
+  if ( ws != NULL )
+    {
+      if ( numSamplesFFT > ws->numSamplesFFTAlloc )
+        {
+          fftw_free ( ws->FabX_Raw );
+          XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+          fftw_free ( ws->TS_FFT );
+          XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+
+          ws->numSamplesFFTAlloc = numSamplesFFT;
+        }
+
+      // adjust maximal SRC-frame timeseries length, if necessary
+      if ( numSamplesMax_SRC > ws->TStmp1_SRC->length ) {
+        XLAL_CHECK ( (ws->TStmp1_SRC->data = XLALRealloc ( ws->TStmp1_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+        ws->TStmp1_SRC->length = numSamplesMax_SRC;
+        XLAL_CHECK ( (ws->TStmp2_SRC->data = XLALRealloc ( ws->TStmp2_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+        ws->TStmp2_SRC->length = numSamplesMax_SRC;
+        XLAL_CHECK ( (ws->SRCtimes_DET->data = XLALRealloc ( ws->SRCtimes_DET->data, numSamplesMax_SRC * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+        ws->SRCtimes_DET->length = numSamplesMax_SRC;
+      }
+
+    } // end: if existing workspace given
+  else
+    {
+      XLAL_CHECK ( (ws = XLALCalloc ( 1, sizeof(*ws))) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+
+      XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      ws->numSamplesFFTAlloc = numSamplesFFT;
+
+      (*ws_io) = ws;
+    } // end: if we create a new workspace
+
+  return XLAL_SUCCESS;
+
+} // XLALResampWorkspaceEnsure()
+
+///
+/// Make sure a workspace can hold per-detector results F_a^X, F_b^X for 'numFreqBins' frequency bins,
+/// unless these are going to be written directly into the FstatResults struct
+///
+static int
+XLALResampWorkspaceEnsureFreqBinsX ( ResampWorkspace *ws,
+                                     UINT4 numFreqBins
+                                     )
+{
+  XLAL_CHECK ( ws != NULL, XLAL_EINVAL );
+  if ( ( numFreqBins > ws->numFreqBinsAlloc ) || ( ws->FaX_k == NULL ) || ( ws->FbX_k == NULL ) )
+    {
+      XLAL_CHECK ( (ws->FaX_k = XLALRealloc ( ws->FaX_k, numFreqBins * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK ( (ws->FbX_k = XLALRealloc ( ws->FbX_k, numFreqBins * sizeof(COMPLEX8))) != NULL, XLAL_ENOMEM );
+      ws->numFreqBinsAlloc = numFreqBins;
+    }
+  return XLAL_SUCCESS;
+} // XLALResampWorkspaceEnsureFreqBinsX()
+
+///
+/// Make sure a workspace can hold the buffers needed for batched FFTs over a block of spindowns
+///
+static int
+XLALResampWorkspaceEnsureBlock ( ResampWorkspace *ws,
+                                 UINT4 lenFFTBlock,
+                                 UINT4 lenFabBlock
+                                 )
+{
+  XLAL_CHECK ( ws != NULL, XLAL_EINVAL );
+  if ( lenFFTBlock > ws->lenFFTBlockAlloc )
+    {
+      fftw_free ( ws->TS_FFT_block );
+      XLAL_CHECK ( (ws->TS_FFT_block = fftw_malloc ( lenFFTBlock * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      fftw_free ( ws->FabX_Raw_block );
+      XLAL_CHECK ( (ws->FabX_Raw_block = fftw_malloc ( lenFFTBlock * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      ws->lenFFTBlockAlloc = lenFFTBlock;
+    }
+  if ( lenFabBlock > ws->lenFabBlockAlloc )
+    {
+      XLAL_CHECK ( (ws->Fab_k_block = XLALRealloc ( ws->Fab_k_block, lenFabBlock * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      ws->lenFabBlockAlloc = lenFabBlock;
+    }
+  return XLAL_SUCCESS;
+} // XLALResampWorkspaceEnsureBlock()
+
+///
+/// Allocate empty multi-detector SRC-frame timeseries buffers with the same layout as 'tmpl'
+///
+static MultiCOMPLEX8TimeSeries *
+XLALCreateMultiSRCTimeSeriesLike ( const MultiCOMPLEX8TimeSeries *tmpl )
+{
+  XLAL_CHECK_NULL ( tmpl != NULL, XLAL_EINVAL );
+
+  MultiCOMPLEX8TimeSeries *out;
+  XLAL_CHECK_NULL ( (out = XLALCalloc ( 1, sizeof(*out) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_NULL ( (out->data = XLALCalloc ( tmpl->length, sizeof(out->data[0]) )) != NULL, XLAL_ENOMEM );
+  out->length = tmpl->length;
+
+  for ( UINT4 X = 0; X < tmpl->length; X ++ )
+    {
+      const COMPLEX8TimeSeries *tX = tmpl->data[X];
+      XLAL_CHECK_NULL ( (out->data[X] = XLALCreateCOMPLEX8TimeSeries ( tX->name, &tX->epoch, tX->f0, tX->deltaT, &tX->sampleUnits, tX->data->length )) != NULL, XLAL_EFUNC );
+    }
+
+  return out;
+
+} // XLALCreateMultiSRCTimeSeriesLike()
+
+///
+/// Allocate the per-detector workspaces needed to compute detectors in parallel. Each detector's work is further
+/// split into 'numSubBands' ranges of time samples and of output frequency bins, so that more threads than detectors
+/// can be used; each workspace holds the timeseries and FFTs of both a(t) and b(t), so that these can also be
+/// transformed in parallel.
+///
+static int
+XLALCreateResampPerDetWorkspaces ( ResampMethodData *resamp )
+{
+  XLAL_CHECK ( resamp != NULL, XLAL_EINVAL );
+  if ( resamp->numThreads <= 1 ) {
+    return XLAL_SUCCESS;
+  }
+  const UINT4 numDetectors = resamp->shared->multiTimeSeries_DET->length;
+  resamp->numSubBands = ( resamp->numThreads + numDetectors - 1 ) / numDetectors;
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      XLAL_CHECK ( XLALResampWorkspaceEnsure ( &resamp->wsPerDet[X], resamp->shared->numSamplesMax_SRC, resamp->shared->numSamplesFFT ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK ( XLALResampWorkspaceEnsureBlock ( resamp->wsPerDet[X], 2 * resamp->strideFFT, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  return XLAL_SUCCESS;
+} // XLALCreateResampPerDetWorkspaces()
+
 // ---------- internal functions ----------
 static void
 XLALDestroyResampMethodData ( void* method_data )
@@ -236,7 +483,31 @@ XLALDestroyResampMethodData ( void* method_data )
 
   ResampMethodData *resamp = (ResampMethodData*) method_data;
 
-  XLALDestroyMultiCOMPLEX8TimeSeries (resamp->multiTimeSeries_DET );
+  // ----- release reference to shared input data, free it if this was the last one
+  if ( --(resamp->shared->refcount) == 0 )
+    {
+      XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->shared->multiTimeSeries_DET );
+
+      LAL_FFTW_WISDOM_LOCK;
+      fftwf_destroy_plan ( resamp->shared->fftplan );
+      LAL_FFTW_WISDOM_UNLOCK;
+
+      XLALFree ( resamp->shared );
+    }
+
+  // ----- free batched FFT plan
+  if ( resamp->fftplan_block != NULL )
+    {
+      LAL_FFTW_WISDOM_LOCK;
+      fftwf_destroy_plan ( resamp->fftplan_block );
+      LAL_FFTW_WISDOM_UNLOCK;
+    }
+
+  // ----- free per-detector workspaces
+  for ( UINT4 X = 0; X < PULSAR_MAX_DETECTORS; X ++ )
+    {
+      XLALDestroyResampWorkspace ( resamp->wsPerDet[X] );
+    }
 
   // ----- free buffer
   XLALDestroyMultiCOMPLEX8TimeSeries ( resamp->multiTimeSeries_SRC_a );
@@ -245,10 +516,6 @@ XLALDestroyResampMethodData ( void* method_data )
   XLALDestroyMultiSSBtimes ( resamp->multiSSBtimes );
   XLALDestroyMultiSSBtimes ( resamp->multiBinaryTimes );
 
-  LAL_FFTW_WISDOM_LOCK;
-  fftwf_destroy_plan ( resamp->fftplan );
-  LAL_FFTW_WISDOM_UNLOCK;
-
   XLALFree ( resamp );
 
 } // XLALDestroyResampMethodData()
@@ -267,15 +534,23 @@ XLALSetupFstatResamp ( void **method_data,
   XLAL_CHECK ( funcs != NULL, XLAL_EFAULT );
   XLAL_CHECK ( multiSFTs != NULL, XLAL_EFAULT );
   XLAL_CHECK ( optArgs != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( !( optArgs->collectTiming && optArgs->resampNumThreads > 1 ), XLAL_EINVAL, "Cannot collect timing information with resampNumThreads=%d > 1\n", optArgs->resampNumThreads );
 
   // Allocate method data
   ResampMethodData *resamp = *method_data = XLALCalloc( 1, sizeof(*resamp) );
   XLAL_CHECK( resamp != NULL, XLAL_ENOMEM );
+  XLAL_CHECK( (resamp->shared = XLALCalloc( 1, sizeof(*resamp->shared) )) != NULL, XLAL_ENOMEM );
+  resamp->shared->refcount = 1;
 
-  resamp->Dterms = optArgs->Dterms;
+  resamp->shared->Dterms = optArgs->Dterms;
+  resamp->numThreads = optArgs->resampNumThreads;
+
+  // make sure the sin/cos lookup table is initialised here, as it may be used by several threads at once later
+  XLALSinCosLUTInit();
 
   // Set method function pointers
   funcs->compute_func = XLALComputeFstatResamp;
+  funcs->compute_block_func = XLALComputeFstatResampBlock;
   funcs->method_data_destroy_func = XLALDestroyResampMethodData;
   funcs->workspace_destroy_func = XLALDestroyResampWorkspace;
 
@@ -291,13 +566,13 @@ XLALSetupFstatResamp ( void **method_data,
   REAL8 extraBand = 2.0  / ( 2 * optArgs->Dterms + 1 ) * Band;
   XLAL_CHECK ( XLALMultiSFTVectorResizeBand ( multiSFTs, f0 - extraBand, Band + 2 * extraBand ) == XLAL_SUCCESS, XLAL_EFUNC );
   // Convert SFTs into heterodyned complex timeseries [in detector frame]
-  XLAL_CHECK ( (resamp->multiTimeSeries_DET = XLALMultiSFTVectorToCOMPLEX8TimeSeries ( multiSFTs )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (resamp->shared->multiTimeSeries_DET = XLALMultiSFTVectorToCOMPLEX8TimeSeries ( multiSFTs )) != NULL, XLAL_EFUNC );
 
   XLALDestroyMultiSFTVector ( multiSFTs );	// don't need them SFTs any more ...
 
-  UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
-  REAL8 dt_DET       = resamp->multiTimeSeries_DET->data[0]->deltaT;
-  REAL8 fHet         = resamp->multiTimeSeries_DET->data[0]->f0;
+  UINT4 numDetectors = resamp->shared->multiTimeSeries_DET->length;
+  REAL8 dt_DET       = resamp->shared->multiTimeSeries_DET->data[0]->deltaT;
+  REAL8 fHet         = resamp->shared->multiTimeSeries_DET->data[0]->f0;
   REAL8 Tsft         = common->multiTimestamps->data[0]->deltaT;
 
   // determine resampled timeseries parameters
@@ -307,7 +582,7 @@ XLALSetupFstatResamp ( void **method_data,
   REAL8 TspanXMax = 0;
   for ( UINT4 X = 0; X < numDetectors; X ++ )
     {
-      UINT4 numSamples_DETX = resamp->multiTimeSeries_DET->data[X]->data->length;
+      UINT4 numSamples_DETX = resamp->shared->multiTimeSeries_DET->data[X]->data->length;
       REAL8 TspanX = numSamples_DETX * dt_DET;
       TspanXMax = fmax ( TspanXMax, TspanX );
     }
@@ -316,7 +591,7 @@ XLALSetupFstatResamp ( void **method_data,
     XLALPrintWarning ("WARNING: Frequency spacing larger than 1/Tspan, we'll internally decimate FFT frequency bins by a factor of %" LAL_UINT4_FORMAT "\n", decimateFFT );
   }
   TspanFFT *= decimateFFT;
-  resamp->decimateFFT = decimateFFT;
+  resamp->shared->decimateFFT = decimateFFT;
 
   UINT4 numSamplesFFT0 = (UINT4) ceil ( TspanFFT / dt_DET );      // we use ceil() so that we artificially widen the band rather than reduce it
   UINT4 numSamplesFFT = 0;
@@ -328,7 +603,12 @@ XLALSetupFstatResamp ( void **method_data,
 
   REAL8 dt_SRC = TspanFFT / numSamplesFFT;			// adjust sampling rate to allow achieving exact requested dFreq=1/TspanFFT !
 
-  resamp->numSamplesFFT = numSamplesFFT;
+  resamp->shared->numSamplesFFT = numSamplesFFT;
+
+  // number of spindowns to batch together in XLALComputeFstatResampBlock(), limited by the memory needed
+  // for the buffers of {a(t),b(t)}-weighted timeseries and their FFTs
+  resamp->strideFFT = 16 * ( ( numSamplesFFT + 15 ) / 16 );
+  resamp->numFFTBatch = MYMAX ( 1, MYMIN ( RESAMP_FFT_BATCH_MAX, RESAMP_FFT_BATCH_MAXBYTES / ( 4 * resamp->strideFFT * sizeof(COMPLEX8) ) ) );
   // ----- allocate buffer Memory ----------
 
   // header for SRC-frame resampled timeseries buffer
@@ -345,18 +625,18 @@ XLALSetupFstatResamp ( void **method_data,
   for ( UINT4 X = 0; X < numDetectors; X ++ )
     {
       // ----- check input consistency ----------
-      REAL8 dt_DETX = resamp->multiTimeSeries_DET->data[X]->deltaT;
+      REAL8 dt_DETX = resamp->shared->multiTimeSeries_DET->data[X]->deltaT;
       XLAL_CHECK ( dt_DET == dt_DETX, XLAL_EINVAL, "Input timeseries must have identical 'deltaT(X=%d)' (%.16g != %.16g)\n", X, dt_DET, dt_DETX);
 
-      REAL8 fHetX = resamp->multiTimeSeries_DET->data[X]->f0;
+      REAL8 fHetX = resamp->shared->multiTimeSeries_DET->data[X]->f0;
       XLAL_CHECK ( fabs( fHet - fHetX ) < LAL_REAL8_EPS * fHet, XLAL_EINVAL, "Input timeseries must have identical heterodyning frequency 'f0(X=%d)' (%.16g != %.16g)\n", X, fHet, fHetX );
 
       REAL8 TsftX = common->multiTimestamps->data[X]->deltaT;
       XLAL_CHECK ( Tsft == TsftX, XLAL_EINVAL, "Input timestamps must have identical stepsize 'Tsft(X=%d)' (%.16g != %.16g)\n", X, Tsft, TsftX );
 
       // ----- prepare Memory fo SRC-frame timeseries and AM coefficients
-      const char *nameX = resamp->multiTimeSeries_DET->data[X]->name;
-      UINT4 numSamples_DETX = resamp->multiTimeSeries_DET->data[X]->data->length;
+      const char *nameX = resamp->shared->multiTimeSeries_DET->data[X]->name;
+      UINT4 numSamples_DETX = resamp->shared->multiTimeSeries_DET->data[X]->data->length;
       UINT4 numSamples_SRCX = (UINT4)ceil ( numSamples_DETX * dt_DET / dt_SRC );
 
       XLAL_CHECK ( (resamp->multiTimeSeries_SRC_a->data[X] = XLALCreateCOMPLEX8TimeSeries ( nameX, &epoch0, fHet, dt_SRC, &lalDimensionlessUnit, numSamples_SRCX )) != NULL, XLAL_EFUNC );
@@ -367,44 +647,15 @@ XLALSetupFstatResamp ( void **method_data,
 
   XLAL_CHECK ( numSamplesFFT >= numSamplesMax_SRC, XLAL_EFAILED, "[numSamplesFFT = %d] < [numSamplesMax_SRC = %d]\n", numSamplesFFT, numSamplesMax_SRC );
 
+  resamp->shared->numSamplesMax_SRC = numSamplesMax_SRC;
+
   // ---- re-use shared workspace, or allocate here ----------
   ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
-  if ( ws != NULL )
-    {
-      if ( numSamplesFFT > ws->numSamplesFFTAlloc )
-        {
-          fftw_free ( ws->FabX_Raw );
-          XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-          fftw_free ( ws->TS_FFT );
-          XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK ( XLALResampWorkspaceEnsure ( &ws, numSamplesMax_SRC, numSamplesFFT ) == XLAL_SUCCESS, XLAL_EFUNC );
+  common->workspace = ws;
 
-          ws->numSamplesFFTAlloc = numSamplesFFT;
-        }
-
-      // adjust maximal SRC-frame timeseries length, if necessary
-      if ( numSamplesMax_SRC > ws->TStmp1_SRC->length ) {
-        XLAL_CHECK ( (ws->TStmp1_SRC->data = XLALRealloc ( ws->TStmp1_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-        ws->TStmp1_SRC->length = numSamplesMax_SRC;
-        XLAL_CHECK ( (ws->TStmp2_SRC->data = XLALRealloc ( ws->TStmp2_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-        ws->TStmp2_SRC->length = numSamplesMax_SRC;
-        XLAL_CHECK ( (ws->SRCtimes_DET->data = XLALRealloc ( ws->SRCtimes_DET->data, numSamplesMax_SRC * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
-        ws->SRCtimes_DET->length = numSamplesMax_SRC;
-      }
-
-    } // end: if shared workspace given
-  else
-    {
-      XLAL_CHECK ( (ws = XLALCalloc ( 1, sizeof(*ws))) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-
-      XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      ws->numSamplesFFTAlloc = numSamplesFFT;
-
-      common->workspace = ws;
-    } // end: if we create our own workspace
+  // ---- allocate extra per-detector workspaces for internal parallelisation ----------
+  XLAL_CHECK ( XLALCreateResampPerDetWorkspaces ( resamp ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   // ----- compute and buffer FFT plan ----------
   int fft_plan_flags=FFTW_MEASURE;
@@ -430,8 +681,12 @@ XLALSetupFstatResamp ( void **method_data,
   }
   XLALGetFFTPlanHints (& fft_plan_flags , & fft_plan_timeout);
   fftw_set_timelimit( fft_plan_timeout );
-  XLAL_CHECK ( (resamp->fftplan = fftwf_plan_dft_1d ( resamp->numSamplesFFT, ws->TS_FFT, ws->FabX_Raw, FFTW_FORWARD, fft_plan_flags )) != NULL, XLAL_EFAILED, "fftwf_plan_dft_1d() failed\n");
+  // use threaded FFTW for long FFTs, if enabled with XLALSetFFTWThreads() or LAL_FFTW_THREADS
+  XLALFFTWPlanWithNumThreads ( XLALGetFFTWThreads ( resamp->shared->numSamplesFFT ) );
+  resamp->shared->fftplan = fftwf_plan_dft_1d ( resamp->shared->numSamplesFFT, ws->TS_FFT, ws->FabX_Raw, FFTW_FORWARD, fft_plan_flags );
+  XLALFFTWPlanWithNumThreads ( 1 );
   LAL_FFTW_WISDOM_UNLOCK;
+  XLAL_CHECK ( resamp->shared->fftplan != NULL, XLAL_EFAILED, "fftwf_plan_dft_1d() failed\n");
 
   // turn on timing collection if requested
   resamp->collectTiming = optArgs->collectTiming;
@@ -452,6 +707,57 @@ XLALSetupFstatResamp ( void **method_data,
 
 } // XLALSetupFstatResamp()
 
+///
+/// Create a copy of the Resamp method data for use by another thread: the detector-frame input timeseries and
+/// the FFT plan are shared with 'method_data', while all buffers and the workspace are private to the copy.
+/// Copies always compute serially, and must be created and destroyed by a single thread.
+///
+void *
+XLALFstatInputThreadCopy_Resamp ( FstatCommon *common, const void *method_data )
+{
+  XLAL_CHECK_NULL ( common != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( method_data != NULL, XLAL_EINVAL );
+  const ResampMethodData *resamp = (const ResampMethodData *) method_data;
+
+  ResampMethodData *copy;
+  XLAL_CHECK_NULL ( (copy = XLALCalloc ( 1, sizeof(*copy) )) != NULL, XLAL_ENOMEM );
+
+  // share immutable input data
+  copy->shared = resamp->shared;
+  ++(copy->shared->refcount);
+  copy->numThreads = 1;
+  copy->numFFTBatch = resamp->numFFTBatch;
+  copy->strideFFT = resamp->strideFFT;
+
+  // force re-computing the buffer on the first call
+  copy->prev_doppler.Alpha = NAN;
+
+  // allocate private SRC-frame timeseries buffers and workspace; on failure, release the reference to the shared data
+  ResampWorkspace *ws = NULL;
+  if ( (copy->multiTimeSeries_SRC_a = XLALCreateMultiSRCTimeSeriesLike ( resamp->multiTimeSeries_SRC_a )) == NULL
+       || (copy->multiTimeSeries_SRC_b = XLALCreateMultiSRCTimeSeriesLike ( resamp->multiTimeSeries_SRC_b )) == NULL
+       || XLALResampWorkspaceEnsure ( &ws, copy->shared->numSamplesMax_SRC, copy->shared->numSamplesFFT ) != XLAL_SUCCESS )
+    {
+      XLALDestroyResampWorkspace ( ws );
+      XLALDestroyResampMethodData ( copy );
+      XLAL_ERROR_NULL ( XLAL_EFUNC );
+    }
+  common->workspace = ws;
+
+  // copies collect their own timing information, using the same invariant 'meta' quantities
+  copy->collectTiming = resamp->collectTiming;
+  if ( copy->collectTiming )
+    {
+      copy->timingGeneric.Ndet = resamp->timingGeneric.Ndet;
+      copy->timingResamp.Resolution = resamp->timingResamp.Resolution;
+      copy->timingResamp.NsampFFT0  = resamp->timingResamp.NsampFFT0;
+      copy->timingResamp.NsampFFT   = resamp->timingResamp.NsampFFT;
+    }
+
+  return copy;
+
+} // XLALFstatInputThreadCopy_Resamp()
+
 
 static int
 XLALComputeFstatResamp ( FstatResults* Fstats,
@@ -473,7 +779,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
 
   // ----- handy shortcuts ----------
   PulsarDopplerParams thisPoint = Fstats->doppler;
-  const MultiCOMPLEX8TimeSeries *multiTimeSeries_DET = resamp->multiTimeSeries_DET;
+  const MultiCOMPLEX8TimeSeries *multiTimeSeries_DET = resamp->shared->multiTimeSeries_DET;
   UINT4 numDetectors = multiTimeSeries_DET->length;
 
   // collect internal timing info
@@ -550,67 +856,206 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
   }
   // ====================================================================================================
 
-  // loop over detectors
-  for ( UINT4 X=0; X < numDetectors; X++ )
+  const int numThreads = (int) MYMAX ( resamp->numThreads, 1 );
+  if ( numThreads > 1 )
     {
-      // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
-      if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+      // each detector uses its own workspace, so that detectors can be processed in parallel
+      const COMPLEX8 *FaX_k[PULSAR_MAX_DETECTORS], *FbX_k[PULSAR_MAX_DETECTORS];
+      for ( UINT4 X = 0; X < numDetectors; X++ )
         {
-          ws->FaX_k = Fstats->FaPerDet[X];
-          ws->FbX_k = Fstats->FbPerDet[X];
-        }
-      const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
-      const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
-
-      // compute {Fa^X(f_k), Fb^X(f_k)}: results returned via workspace ws
-      XLAL_CHECK ( XLALComputeFaFb_Resamp ( resamp, ws, thisPoint, common->dFreq, numFreqBins, TimeSeriesX_SRC_a, TimeSeriesX_SRC_b ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-      if ( collectTiming ) {
-        tic = XLALGetCPUTime();
-      }
-      if ( X == 0 )
-        { // avoid having to memset this array: for the first detector we *copy* results
-          for ( UINT4 k = 0; k < numFreqBins; k++ )
+          ResampWorkspace *wsX = resamp->wsPerDet[X];
+          // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
+          if ( whatToCompute & FSTATQ_FAFB_PER_DET )
             {
-              ws->Fa_k[k] = ws->FaX_k[k];
-              ws->Fb_k[k] = ws->FbX_k[k];
+              XLALFree ( wsX->FaX_k );
+              wsX->FaX_k = Fstats->FaPerDet[X];
+              XLALFree ( wsX->FbX_k );
+              wsX->FbX_k = Fstats->FbPerDet[X];
+              wsX->numFreqBinsAlloc = MYMAX ( wsX->numFreqBinsAlloc, numFreqBins );
             }
-        } // end: if X==0
-      else
-        { // for subsequent detectors we *add to* them
-          for ( UINT4 k = 0; k < numFreqBins; k++ )
+          else
             {
-              ws->Fa_k[k] += ws->FaX_k[k];
-              ws->Fb_k[k] += ws->FbX_k[k];
+              XLAL_CHECK ( XLALResampWorkspaceEnsureFreqBinsX ( wsX, numFreqBins ) == XLAL_SUCCESS, XLAL_EFUNC );
             }
-        } // end:if X>0
-
-      if ( collectTiming ) {
-        toc = XLALGetCPUTime();
-        Tau->SumFabX += (toc-tic);
-        tic = toc;
-      }
+          FaX_k[X] = wsX->FaX_k;
+          FbX_k[X] = wsX->FbX_k;
+        } // for X < numDetectors
+
+      // each detector's work is split into 'numSubBands' ranges of time samples (spindown correction) and
+      // of output frequency bins (extraction and normalisation of {Fa^X, Fb^X}, and 2F^X); the a(t) and b(t)
+      // timeseries of every detector are Fourier transformed in parallel, each in its own slice of the workspace
+      const UINT4 numSubBands = resamp->numSubBands;
+      const UINT4 numSamplesFFT = resamp->shared->numSamplesFFT;
+      const UINT4 decimateFFT = resamp->shared->decimateFFT;
+      const UINT4 strideFFT = resamp->strideFFT;
+      REAL8 freqShift[PULSAR_MAX_DETECTORS];
+      UINT4 offset_bins[PULSAR_MAX_DETECTORS];
+      for ( UINT4 X = 0; X < numDetectors; X++ )
+        {
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
+          XLAL_CHECK ( numSamplesFFT >= TimeSeriesX_SRC_a->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_a) = %d]\n", numSamplesFFT, TimeSeriesX_SRC_a->data->length );
+          XLAL_CHECK ( numSamplesFFT >= TimeSeriesX_SRC_b->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_b) = %d]\n", numSamplesFFT, TimeSeriesX_SRC_b->data->length );
+          XLAL_CHECK ( XLALResampFFTOffsets ( &freqShift[X], &offset_bins[X], resamp, &thisPoint, common->dFreq, numFreqBins, TimeSeriesX_SRC_a->f0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+        } // for X < numDetectors
+
+      int failed = 0;
+#pragma omp parallel num_threads(numThreads)
+      {
+
+        // apply spindown phase-factors to a(t) and b(t), over ranges of time samples, and zero-pad for 'FFT'ing
+#pragma omp for schedule(static) reduction(|:failed)
+        for ( UINT4 t = 0; t < numDetectors * 2 * numSubBands; t++ )
+          {
+            const UINT4 X = t / ( 2 * numSubBands ), ab = ( t / numSubBands ) % 2, i = t % numSubBands;
+            const COMPLEX8TimeSeries *TimeSeriesX_SRC = ( ab == 0 ) ? multiTimeSeries_SRC_a->data[X] : multiTimeSeries_SRC_b->data[X];
+            COMPLEX8 *TS_FFT = resamp->wsPerDet[X]->TS_FFT_block + ab * strideFFT;
+            const UINT4 numSamplesIn = TimeSeriesX_SRC->data->length;
+            const UINT4 jStart = ( (UINT8) numSamplesFFT * i ) / numSubBands;
+            const UINT4 jEnd = ( (UINT8) numSamplesFFT * ( i + 1 ) ) / numSubBands;
+            if ( jStart < numSamplesIn )
+              {
+                failed |= ( XLALApplySpindownAndFreqShiftRange ( TS_FFT, TimeSeriesX_SRC, &thisPoint, freqShift[X], jStart, MYMIN ( jEnd, numSamplesIn ) ) != XLAL_SUCCESS );
+              }
+            if ( jEnd > numSamplesIn )
+              {
+                const UINT4 jZero = MYMAX ( jStart, numSamplesIn );
+                memset ( TS_FFT + jZero, 0, ( jEnd - jZero ) * sizeof(TS_FFT[0]) );
+              }
+          } // for t < numDetectors * 2 * numSubBands
+
+        // Fourier transform the resampled Fa(t), Fb(t) of each detector
+#pragma omp for schedule(static,1)
+        for ( UINT4 t = 0; t < numDetectors * 2; t++ )
+          {
+            ResampWorkspace *wsX = resamp->wsPerDet[t / 2];
+            fftwf_execute_dft ( resamp->shared->fftplan, wsX->TS_FFT_block + ( t % 2 ) * strideFFT, wsX->FabX_Raw_block + ( t % 2 ) * strideFFT );
+          } // for t < numDetectors * 2
+
+        // extract and normalise {Fa^X(f_k), Fb^X(f_k)}, and compute 2F^X(f_k), over frequency sub-bands
+#pragma omp for schedule(static)
+        for ( UINT4 t = 0; t < numDetectors * numSubBands; t++ )
+          {
+            const UINT4 X = t / numSubBands, i = t % numSubBands;
+            ResampWorkspace *wsX = resamp->wsPerDet[X];
+            const UINT4 kStart = ( (UINT8) numFreqBins * i ) / numSubBands;
+            const UINT4 kEnd = ( (UINT8) numFreqBins * ( i + 1 ) ) / numSubBands;
+            const COMPLEX8 *FaX_Raw = wsX->FabX_Raw_block;
+            const COMPLEX8 *FbX_Raw = wsX->FabX_Raw_block + strideFFT;
+            for ( UINT4 k = kStart; k < kEnd; k++ )
+              {
+                wsX->FaX_k[k] = FaX_Raw [ offset_bins[X] + k * decimateFFT ];
+                wsX->FbX_k[k] = FbX_Raw [ offset_bins[X] + k * decimateFFT ];
+              }
+            XLALResampNormaliseFaFbXRange ( wsX->FaX_k, wsX->FbX_k, &thisPoint, common->dFreq, kStart, kEnd, multiTimeSeries_SRC_a->data[X] );
+
+            // ----- if requested: compute per-detector Fstat_X_k
+            if ( whatToCompute & FSTATQ_2F_PER_DET )
+              {
+                const REAL4 AdX = resamp->MmunuX[X].Ad;
+                const REAL4 BdX = resamp->MmunuX[X].Bd;
+                const REAL4 CdX = resamp->MmunuX[X].Cd;
+                const REAL4 EdX = resamp->MmunuX[X].Ed;
+                const REAL4 DdX_inv = 1.0f / resamp->MmunuX[X].Dd;
+                for ( UINT4 k = kStart; k < kEnd; k ++ )
+                  {
+                    Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( wsX->FaX_k[k], wsX->FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
+                  }  // for k < kEnd
+              } // end: if compute F_X
+          } // for t < numDetectors * numSubBands
+
+      } // omp parallel
 
-      // ----- if requested: compute per-detector Fstat_X_k
-      if ( whatToCompute & FSTATQ_2F_PER_DET )
+      if ( whatToCompute & FSTATQ_FAFB_PER_DET )
         {
-          const REAL4 AdX = resamp->MmunuX[X].Ad;
-          const REAL4 BdX = resamp->MmunuX[X].Bd;
-          const REAL4 CdX = resamp->MmunuX[X].Cd;
-          const REAL4 EdX = resamp->MmunuX[X].Ed;
-          const REAL4 DdX_inv = 1.0f / resamp->MmunuX[X].Dd;
-          for ( UINT4 k = 0; k < numFreqBins; k ++ )
+          for ( UINT4 X = 0; X < numDetectors; X++ )
             {
-              Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( ws->FaX_k[k], ws->FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
-            }  // for k < numFreqBins
-        } // end: if compute F_X
+              resamp->wsPerDet[X]->FaX_k = NULL;
+              resamp->wsPerDet[X]->FbX_k = NULL;
+            }
+        }
+      XLAL_CHECK ( !failed, XLAL_EFUNC, "Computing {Fa^X, Fb^X} failed for at least one detector\n" );
 
-      if ( collectTiming ) {
-        toc = XLALGetCPUTime();
-        Tau->Fab2F += ( toc - tic );
-      }
+      // sum over detectors in the same order as the serial loop below, parallelised over frequency bins
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+      for ( UINT4 k = 0; k < numFreqBins; k++ )
+        {
+          COMPLEX8 Fa_k = FaX_k[0][k];
+          COMPLEX8 Fb_k = FbX_k[0][k];
+          for ( UINT4 X = 1; X < numDetectors; X++ )
+            {
+              Fa_k += FaX_k[X][k];
+              Fb_k += FbX_k[X][k];
+            }
+          ws->Fa_k[k] = Fa_k;
+          ws->Fb_k[k] = Fb_k;
+        } // for k < numFreqBins
 
-    } // for X < numDetectors
+    } // if numThreads > 1
+  else
+    {
+      // loop over detectors
+      for ( UINT4 X=0; X < numDetectors; X++ )
+        {
+          // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
+          if ( whatToCompute & FSTATQ_FAFB_PER_DET )
+            {
+              ws->FaX_k = Fstats->FaPerDet[X];
+              ws->FbX_k = Fstats->FbPerDet[X];
+            }
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
+
+          // compute {Fa^X(f_k), Fb^X(f_k)}: results returned via workspace ws
+          XLAL_CHECK ( XLALComputeFaFb_Resamp ( resamp, ws, thisPoint, common->dFreq, numFreqBins, TimeSeriesX_SRC_a, TimeSeriesX_SRC_b ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+          if ( collectTiming ) {
+            tic = XLALGetCPUTime();
+          }
+          if ( X == 0 )
+            { // avoid having to memset this array: for the first detector we *copy* results
+              for ( UINT4 k = 0; k < numFreqBins; k++ )
+                {
+                  ws->Fa_k[k] = ws->FaX_k[k];
+                  ws->Fb_k[k] = ws->FbX_k[k];
+                }
+            } // end: if X==0
+          else
+            { // for subsequent detectors we *add to* them
+              for ( UINT4 k = 0; k < numFreqBins; k++ )
+                {
+                  ws->Fa_k[k] += ws->FaX_k[k];
+                  ws->Fb_k[k] += ws->FbX_k[k];
+                }
+            } // end:if X>0
+
+          if ( collectTiming ) {
+            toc = XLALGetCPUTime();
+            Tau->SumFabX += (toc-tic);
+            tic = toc;
+          }
+
+          // ----- if requested: compute per-detector Fstat_X_k
+          if ( whatToCompute & FSTATQ_2F_PER_DET )
+            {
+              const REAL4 AdX = resamp->MmunuX[X].Ad;
+              const REAL4 BdX = resamp->MmunuX[X].Bd;
+              const REAL4 CdX = resamp->MmunuX[X].Cd;
+              const REAL4 EdX = resamp->MmunuX[X].Ed;
+              const REAL4 DdX_inv = 1.0f / resamp->MmunuX[X].Dd;
+              for ( UINT4 k = 0; k < numFreqBins; k ++ )
+                {
+                  Fstats->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( ws->FaX_k[k], ws->FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
+                }  // for k < numFreqBins
+            } // end: if compute F_X
+
+          if ( collectTiming ) {
+            toc = XLALGetCPUTime();
+            Tau->Fab2F += ( toc - tic );
+          }
+
+        } // for X < numDetectors
+    } // if numThreads <= 1
 
   if ( collectTiming ) {
     Tau->SumFabX /= numDetectors;
@@ -625,6 +1070,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
       const REAL4 Cd = resamp->Mmunu.Cd;
       const REAL4 Ed = resamp->Mmunu.Ed;
       const REAL4 Dd_inv = 1.0f / resamp->Mmunu.Dd;
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(numThreads > 1)
       for ( UINT4 k=0; k < numFreqBins; k++ )
         {
           Fstats->twoF[k] = compute_fstat_from_fa_fb ( ws->Fa_k[k], ws->Fb_k[k], Ad, Bd, Cd, Ed, Dd_inv );
@@ -721,6 +1167,294 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
 
 } // XLALComputeFstatResamp()
 
+///
+/// Create the batched FFT plan used by XLALComputeFstatResampBlock(), if it does not already exist
+///
+static int
+XLALResampCreateBlockFFTPlan ( ResampMethodData *resamp,
+                               ResampWorkspace *ws
+                               )
+{
+  if ( resamp->fftplan_block != NULL ) {
+    return XLAL_SUCCESS;
+  }
+
+  const int n = resamp->shared->numSamplesFFT;
+  const int howmany = 2 * resamp->numFFTBatch;
+  const int dist = resamp->strideFFT;
+
+  int fft_plan_flags=FFTW_MEASURE;
+  double fft_plan_timeout= FFTW_NO_TIMELIMIT ;
+  XLALGetFFTPlanHints (& fft_plan_flags , & fft_plan_timeout);
+
+  LAL_FFTW_WISDOM_LOCK;
+  fftw_set_timelimit( fft_plan_timeout );
+  XLALFFTWPlanWithNumThreads ( XLALGetFFTWThreads ( ( UINT8 ) n * howmany ) );
+  resamp->fftplan_block = fftwf_plan_many_dft ( 1, &n, howmany, ws->TS_FFT_block, NULL, 1, dist, ws->FabX_Raw_block, NULL, 1, dist, FFTW_FORWARD, fft_plan_flags );
+  XLALFFTWPlanWithNumThreads ( 1 );
+  LAL_FFTW_WISDOM_UNLOCK;
+  XLAL_CHECK ( resamp->fftplan_block != NULL, XLAL_EFAILED, "fftwf_plan_many_dft() failed\n");
+
+  return XLAL_SUCCESS;
+
+} // XLALResampCreateBlockFFTPlan()
+
+///
+/// Compute the F-statistic for a block of Doppler points which differ only in their frequency and spindowns.
+/// The SRC-frame timeseries are computed only once for the whole block, and the FFTs of up to 'numFFTBatch'
+/// spindowns (times a(t) and b(t)) are computed together with a single batched FFTW plan.
+///
+/// Note: timing information is not collected for blocks, and the detectors are always processed serially.
+///
+static int
+XLALComputeFstatResampBlock ( FstatResults **Fstats,
+                              const UINT4 numFstats,
+                              const FstatCommon *common,
+                              void *method_data
+                              )
+{
+  // Check input
+  XLAL_CHECK ( Fstats != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( numFstats > 0, XLAL_EINVAL );
+  XLAL_CHECK ( common != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( method_data != NULL, XLAL_EFAULT );
+
+  ResampMethodData *resamp = (ResampMethodData*) method_data;
+  ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
+
+  const FstatQuantities whatToCompute = Fstats[0]->whatWasComputed;
+  if (whatToCompute & FSTATQ_ATOMS_PER_DET) {
+    XLAL_ERROR(XLAL_EFAILED, "NOT implemented!");
+  }
+
+  // barycentric resampling is only done once for the whole block, as all Doppler points share the same sky position and binary parameters
+  PulsarDopplerParams thisPoint0 = Fstats[0]->doppler;
+  XLAL_CHECK ( XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( resamp, &thisPoint0, common ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  if ( whatToCompute == FSTATQ_NONE ) {
+    return XLAL_SUCCESS;
+  }
+
+  // ----- handy shortcuts ----------
+  const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_a = resamp->multiTimeSeries_SRC_a;
+  const MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b = resamp->multiTimeSeries_SRC_b;
+  const UINT4 numDetectors = multiTimeSeries_SRC_a->length;
+  const UINT4 numFreqBins = Fstats[0]->numFreqBins;
+  const UINT4 numSamplesFFT = resamp->shared->numSamplesFFT;
+  const UINT4 decimateFFT = resamp->shared->decimateFFT;
+  const UINT4 numFFTBatch = resamp->numFFTBatch;
+  const UINT4 strideFFT = resamp->strideFFT;
+  const REAL8 fHet = multiTimeSeries_SRC_a->data[0]->f0;
+
+  // ----- allocate batch buffers and create batched FFT plan ----------
+  XLAL_CHECK ( XLALResampWorkspaceEnsureBlock ( ws, 2 * numFFTBatch * strideFFT, 4 * numFFTBatch * numFreqBins ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALResampCreateBlockFFTPlan ( resamp, ws ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // loop over batches of spindowns
+  for ( UINT4 i0 = 0; i0 < numFstats; i0 += numFFTBatch )
+    {
+      const UINT4 numBatch = MYMIN ( numFFTBatch, numFstats - i0 );
+
+      REAL8 freqShift[RESAMP_FFT_BATCH_MAX];
+      UINT4 offset_bins[RESAMP_FFT_BATCH_MAX];
+      COMPLEX8 *Fa_k[RESAMP_FFT_BATCH_MAX], *Fb_k[RESAMP_FFT_BATCH_MAX];
+      for ( UINT4 b = 0; b < numBatch; b ++ )
+        {
+          FstatResults *Fstats_b = Fstats[i0 + b];
+          XLAL_CHECK ( XLALResampFFTOffsets ( &freqShift[b], &offset_bins[b], resamp, &Fstats_b->doppler, common->dFreq, numFreqBins, fHet ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+          // if returning FaFb we can use that return-struct as 'workspace'
+          COMPLEX8 *Fab_k_b = ws->Fab_k_block + 4 * b * numFreqBins;
+          Fa_k[b] = ( whatToCompute & FSTATQ_FAFB ) ? Fstats_b->Fa : Fab_k_b;
+          Fb_k[b] = ( whatToCompute & FSTATQ_FAFB ) ? Fstats_b->Fb : Fab_k_b + numFreqBins;
+        }
+
+      // loop over detectors
+      for ( UINT4 X = 0; X < numDetectors; X++ )
+        {
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_a = multiTimeSeries_SRC_a->data[X];
+          const COMPLEX8TimeSeries *TimeSeriesX_SRC_b = multiTimeSeries_SRC_b->data[X];
+          XLAL_CHECK ( numSamplesFFT >= TimeSeriesX_SRC_a->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_a) = %d]\n", numSamplesFFT, TimeSeriesX_SRC_a->data->length );
+          XLAL_CHECK ( numSamplesFFT >= TimeSeriesX_SRC_b->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_b) = %d]\n", numSamplesFFT, TimeSeriesX_SRC_b->data->length );
+
+          // apply spindown phase-factors, store results in zero-padded timeseries for 'FFT'ing
+          memset ( ws->TS_FFT_block, 0, 2 * numBatch * strideFFT * sizeof(ws->TS_FFT_block[0]) );
+          for ( UINT4 b = 0; b < numBatch; b ++ )
+            {
+              const PulsarDopplerParams *thisPoint = &Fstats[i0 + b]->doppler;
+              XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT_block + (2*b) * strideFFT, TimeSeriesX_SRC_a, thisPoint, freqShift[b] ) == XLAL_SUCCESS, XLAL_EFUNC );
+              XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT_block + (2*b+1) * strideFFT, TimeSeriesX_SRC_b, thisPoint, freqShift[b] ) == XLAL_SUCCESS, XLAL_EFUNC );
+            }
+
+          // Fourier transform the resampled Fa(t), Fb(t) of the whole batch; for an incomplete batch, transform one at a time
+          if ( numBatch == numFFTBatch )
+            {
+              fftwf_execute_dft ( resamp->fftplan_block, ws->TS_FFT_block, ws->FabX_Raw_block );
+            }
+          else
+            {
+              for ( UINT4 j = 0; j < 2 * numBatch; j ++ )
+                {
+                  fftwf_execute_dft ( resamp->shared->fftplan, ws->TS_FFT_block + j * strideFFT, ws->FabX_Raw_block + j * strideFFT );
+                }
+            }
+
+          for ( UINT4 b = 0; b < numBatch; b ++ )
+            {
+              FstatResults *Fstats_b = Fstats[i0 + b];
+
+              // if return-struct contains memory for holding FaFbPerDet: use that directly instead of local memory
+              COMPLEX8 *Fab_k_b = ws->Fab_k_block + 4 * b * numFreqBins;
+              COMPLEX8 *FaX_k = ( whatToCompute & FSTATQ_FAFB_PER_DET ) ? Fstats_b->FaPerDet[X] : Fab_k_b + 2 * numFreqBins;
+              COMPLEX8 *FbX_k = ( whatToCompute & FSTATQ_FAFB_PER_DET ) ? Fstats_b->FbPerDet[X] : Fab_k_b + 3 * numFreqBins;
+
+              // compute {Fa^X(f_k), Fb^X(f_k)}
+              const COMPLEX8 *FaX_Raw = ws->FabX_Raw_block + (2*b) * strideFFT;
+              const COMPLEX8 *FbX_Raw = ws->FabX_Raw_block + (2*b+1) * strideFFT;
+              for ( UINT4 k = 0; k < numFreqBins; k++ )
+                {
+                  FaX_k[k] = FaX_Raw [ offset_bins[b] + k * decimateFFT ];
+                  FbX_k[k] = FbX_Raw [ offset_bins[b] + k * decimateFFT ];
+                }
+              XLALResampNormaliseFaFbX ( FaX_k, FbX_k, &Fstats_b->doppler, common->dFreq, numFreqBins, TimeSeriesX_SRC_a );
+
+              if ( X == 0 )
+                { // avoid having to memset this array: for the first detector we *copy* results
+                  for ( UINT4 k = 0; k < numFreqBins; k++ )
+                    {
+                      Fa_k[b][k] = FaX_k[k];
+                      Fb_k[b][k] = FbX_k[k];
+                    }
+                } // end: if X==0
+              else
+                { // for subsequent detectors we *add to* them
+                  for ( UINT4 k = 0; k < numFreqBins; k++ )
+                    {
+                      Fa_k[b][k] += FaX_k[k];
+                      Fb_k[b][k] += FbX_k[k];
+                    }
+                } // end:if X>0
+
+              // ----- if requested: compute per-detector Fstat_X_k
+              if ( whatToCompute & FSTATQ_2F_PER_DET )
+                {
+                  const REAL4 AdX = resamp->MmunuX[X].Ad;
+                  const REAL4 BdX = resamp->MmunuX[X].Bd;
+                  const REAL4 CdX = resamp->MmunuX[X].Cd;
+                  const REAL4 EdX = resamp->MmunuX[X].Ed;
+                  const REAL4 DdX_inv = 1.0f / resamp->MmunuX[X].Dd;
+                  for ( UINT4 k = 0; k < numFreqBins; k ++ )
+                    {
+                      Fstats_b->twoFPerDet[X][k] = compute_fstat_from_fa_fb ( FaX_k[k], FbX_k[k], AdX, BdX, CdX, EdX, DdX_inv );
+                    }  // for k < numFreqBins
+                } // end: if compute F_X
+
+            } // for b < numBatch
+
+        } // for X < numDetectors
+
+      for ( UINT4 b = 0; b < numBatch; b ++ )
+        {
+          FstatResults *Fstats_b = Fstats[i0 + b];
+
+          if ( whatToCompute & FSTATQ_2F )
+            {
+              const REAL4 Ad = resamp->Mmunu.Ad;
+              const REAL4 Bd = resamp->Mmunu.Bd;
+              const REAL4 Cd = resamp->Mmunu.Cd;
+              const REAL4 Ed = resamp->Mmunu.Ed;
+              const REAL4 Dd_inv = 1.0f / resamp->Mmunu.Dd;
+              for ( UINT4 k=0; k < numFreqBins; k++ )
+                {
+                  Fstats_b->twoF[k] = compute_fstat_from_fa_fb ( Fa_k[b][k], Fb_k[b][k], Ad, Bd, Cd, Ed, Dd_inv );
+                }
+            } // if FSTATQ_2F
+
+          // Return antenna-pattern matrices
+          Fstats_b->Mmunu = resamp->Mmunu;
+          for ( UINT4 X = 0; X < numDetectors; X ++ )
+            {
+              Fstats_b->MmunuX[X] = resamp->MmunuX[X];
+            }
+        } // for b < numBatch
+
+    } // for i0 < numFstats
+
+  return XLAL_SUCCESS;
+
+} // XLALComputeFstatResampBlock()
+
+
+///
+/// Compute the frequency shift needed to align the heterodyne frequency 'fHet' with the output frequency bins,
+/// and the index of the first output frequency bin in the (DC-centred) raw FFT output
+///
+static int
+XLALResampFFTOffsets ( REAL8 *freqShift,				//!< [out] frequency shift to closest output bin
+                       UINT4 *offset_bins,				//!< [out] index of first output frequency bin in raw FFT output
+                       const ResampMethodData *resamp,			//!< [in] buffered resampling data
+                       const PulsarDopplerParams *thisPoint,		//!< [in] Doppler point
+                       REAL8 dFreq,					//!< [in] output frequency resolution
+                       UINT4 numFreqBins,				//!< [in] number of output frequency bins
+                       REAL8 fHet					//!< [in] heterodyne frequency of the SRC-frame timeseries
+                       )
+{
+  REAL8 FreqOut0 = thisPoint->fkdot[0];
+
+  REAL8 dFreqFFT = dFreq / resamp->shared->decimateFFT;	// internally may be using higher frequency resolution dFreqFFT than requested
+  (*freqShift) = remainder ( FreqOut0 - fHet, dFreq ); // frequency shift to closest bin
+  REAL8 fMinFFT = fHet + (*freqShift) - dFreqFFT * (resamp->shared->numSamplesFFT/2);	// we'll shift DC into the *middle bin* N/2  [N always even!]
+  XLAL_CHECK ( FreqOut0 >= fMinFFT, XLAL_EDOM, "Lowest output frequency outside the available frequency band: [FreqOut0 = %.16g] < [fMinFFT = %.16g]\n", FreqOut0, fMinFFT );
+  (*offset_bins) = (UINT4) lround ( ( FreqOut0 - fMinFFT ) / dFreqFFT );
+  UINT4 maxOutputBin = (*offset_bins) + (numFreqBins - 1) * resamp->shared->decimateFFT;
+  XLAL_CHECK ( maxOutputBin < resamp->shared->numSamplesFFT, XLAL_EDOM, "Highest output frequency bin outside available band: [maxOutputBin = %d] >= [numSamplesFFT = %d]\n", maxOutputBin, resamp->shared->numSamplesFFT );
+
+  return XLAL_SUCCESS;
+
+} // XLALResampFFTOffsets()
+
+///
+/// Apply the normalization factors to {Fa^X(f_k), Fb^X(f_k)} over output frequency bins
+///
+static void
+XLALResampNormaliseFaFbX ( COMPLEX8 *FaX_k,					//!< [in,out] F_a^X(f_k) over output bins
+                           COMPLEX8 *FbX_k,					//!< [in,out] F_b^X(f_k) over output bins
+                           const PulsarDopplerParams *thisPoint,		//!< [in] Doppler point
+                           REAL8 dFreq,						//!< [in] output frequency resolution
+                           UINT4 numFreqBins,					//!< [in] number of output frequency bins
+                           const COMPLEX8TimeSeries *TimeSeries_SRC		//!< [in] SRC-frame single-IFO timeseries
+                           )
+{
+  XLALResampNormaliseFaFbXRange ( FaX_k, FbX_k, thisPoint, dFreq, 0, numFreqBins, TimeSeries_SRC );
+} // XLALResampNormaliseFaFbX()
+
+///
+/// Apply the normalization factors to {Fa^X(f_k), Fb^X(f_k)} over the output frequency bins kStart <= k < kEnd
+///
+static void
+XLALResampNormaliseFaFbXRange ( COMPLEX8 *FaX_k,				//!< [in,out] F_a^X(f_k) over output bins
+                                COMPLEX8 *FbX_k,				//!< [in,out] F_b^X(f_k) over output bins
+                                const PulsarDopplerParams *thisPoint,		//!< [in] Doppler point
+                                REAL8 dFreq,					//!< [in] output frequency resolution
+                                UINT4 kStart,					//!< [in] first output frequency bin to normalise
+                                UINT4 kEnd,					//!< [in] one past the last output frequency bin to normalise
+                                const COMPLEX8TimeSeries *TimeSeries_SRC	//!< [in] SRC-frame single-IFO timeseries
+                                )
+{
+  const REAL8 FreqOut0 = thisPoint->fkdot[0];
+  const REAL8 dt_SRC = TimeSeries_SRC->deltaT;
+  const REAL8 dtauX = GPSDIFF ( TimeSeries_SRC->epoch, thisPoint->refTime );
+  for ( UINT4 k = kStart; k < kEnd; k++ )
+    {
+      REAL8 f_k = FreqOut0 + k * dFreq;
+      REAL8 cycles = - f_k * dtauX;
+      REAL4 sinphase, cosphase;
+      XLALSinCos2PiLUT ( &sinphase, &cosphase, cycles );
+      COMPLEX8 normX_k = dt_SRC * crectf ( cosphase, sinphase );
+      FaX_k[k] *= normX_k;
+      FbX_k[k] *= normX_k;
+    } // for k < kEnd
+} // XLALResampNormaliseFaFbXRange()
 
 static int
 XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered resampling data and workspace
@@ -736,31 +1470,22 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   XLAL_CHECK ( dFreq > 0, XLAL_EINVAL );
   XLAL_CHECK ( numFreqBins <= ws->numFreqBinsAlloc, XLAL_EINVAL );
 
-  REAL8 FreqOut0 = thisPoint.fkdot[0];
-
   // compute frequency shift to align heterodyne frequency with output frequency bins
-  REAL8 fHet   = TimeSeries_SRC_a->f0;
-  REAL8 dt_SRC = TimeSeries_SRC_a->deltaT;
-
-  REAL8 dFreqFFT = dFreq / resamp->decimateFFT;	// internally may be using higher frequency resolution dFreqFFT than requested
-  REAL8 freqShift = remainder ( FreqOut0 - fHet, dFreq ); // frequency shift to closest bin
-  REAL8 fMinFFT = fHet + freqShift - dFreqFFT * (resamp->numSamplesFFT/2);	// we'll shift DC into the *middle bin* N/2  [N always even!]
-  XLAL_CHECK ( FreqOut0 >= fMinFFT, XLAL_EDOM, "Lowest output frequency outside the available frequency band: [FreqOut0 = %.16g] < [fMinFFT = %.16g]\n", FreqOut0, fMinFFT );
-  UINT4 offset_bins = (UINT4) lround ( ( FreqOut0 - fMinFFT ) / dFreqFFT );
-  UINT4 maxOutputBin = offset_bins + (numFreqBins - 1) * resamp->decimateFFT;
-  XLAL_CHECK ( maxOutputBin < resamp->numSamplesFFT, XLAL_EDOM, "Highest output frequency bin outside available band: [maxOutputBin = %d] >= [numSamplesFFT = %d]\n", maxOutputBin, resamp->numSamplesFFT );
+  REAL8 freqShift;
+  UINT4 offset_bins;
+  XLAL_CHECK ( XLALResampFFTOffsets ( &freqShift, &offset_bins, resamp, &thisPoint, dFreq, numFreqBins, TimeSeries_SRC_a->f0 ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   FstatTimingResamp *tiRS = &(resamp->timingResamp);
   BOOLEAN collectTiming = resamp->collectTiming;
   REAL8 tic = 0, toc = 0;
 
-  XLAL_CHECK ( resamp->numSamplesFFT >= TimeSeries_SRC_a->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_a) = %d]\n", resamp->numSamplesFFT, TimeSeries_SRC_a->data->length );
-  XLAL_CHECK ( resamp->numSamplesFFT >= TimeSeries_SRC_b->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_b) = %d]\n", resamp->numSamplesFFT, TimeSeries_SRC_b->data->length );
+  XLAL_CHECK ( resamp->shared->numSamplesFFT >= TimeSeries_SRC_a->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_a) = %d]\n", resamp->shared->numSamplesFFT, TimeSeries_SRC_a->data->length );
+  XLAL_CHECK ( resamp->shared->numSamplesFFT >= TimeSeries_SRC_b->data->length, XLAL_EFAILED, "[numSamplesFFT = %d] < [len(TimeSeries_SRC_b) = %d]\n", resamp->shared->numSamplesFFT, TimeSeries_SRC_b->data->length );
 
   if ( collectTiming ) {
     tic = XLALGetCPUTime();
   }
-  memset ( ws->TS_FFT, 0, resamp->numSamplesFFT * sizeof(ws->TS_FFT[0]) );
+  memset ( ws->TS_FFT, 0, resamp->shared->numSamplesFFT * sizeof(ws->TS_FFT[0]) );
   // ----- compute FaX_k
   // apply spindown phase-factors, store result in zero-padded timeseries for 'FFT'ing
   XLAL_CHECK ( XLALApplySpindownAndFreqShift ( ws->TS_FFT, TimeSeries_SRC_a, &thisPoint, freqShift ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -772,7 +1497,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   // Fourier transform the resampled Fa(t)
-  fftwf_execute_dft ( resamp->fftplan, ws->TS_FFT, ws->FabX_Raw );
+  fftwf_execute_dft ( resamp->shared->fftplan, ws->TS_FFT, ws->FabX_Raw );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -781,7 +1506,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   for ( UINT4 k = 0; k < numFreqBins; k++ ) {
-    ws->FaX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
+    ws->FaX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->shared->decimateFFT ];
   }
 
   if ( collectTiming ) {
@@ -801,7 +1526,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   // Fourier transform the resampled Fa(t)
-  fftwf_execute_dft ( resamp->fftplan, ws->TS_FFT, ws->FabX_Raw );
+  fftwf_execute_dft ( resamp->shared->fftplan, ws->TS_FFT, ws->FabX_Raw );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -810,7 +1535,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   for ( UINT4 k = 0; k < numFreqBins; k++ ) {
-    ws->FbX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->decimateFFT ];
+    ws->FbX_k[k] = ws->FabX_Raw [ offset_bins + k * resamp->shared->decimateFFT ];
   }
 
   if ( collectTiming ) {
@@ -820,17 +1545,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   }
 
   // ----- normalization factors to be applied to Fa and Fb:
-  const REAL8 dtauX = GPSDIFF ( TimeSeries_SRC_a->epoch, thisPoint.refTime );
-  for ( UINT4 k = 0; k < numFreqBins; k++ )
-    {
-      REAL8 f_k = FreqOut0 + k * dFreq;
-      REAL8 cycles = - f_k * dtauX;
-      REAL4 sinphase, cosphase;
-      XLALSinCos2PiLUT ( &sinphase, &cosphase, cycles );
-      COMPLEX8 normX_k = dt_SRC * crectf ( cosphase, sinphase );
-      ws->FaX_k[k] *= normX_k;
-      ws->FbX_k[k] *= normX_k;
-    } // for k < numFreqBinsOut
+  XLALResampNormaliseFaFbX ( ws->FaX_k, ws->FbX_k, &thisPoint, dFreq, numFreqBins, TimeSeries_SRC_a );
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -848,6 +1563,24 @@ XLALApplySpindownAndFreqShift ( COMPLEX8 *restrict xOut,      			///< [out] the
                                 const PulsarDopplerParams *restrict doppler,	///< [in] containing spindown parameters
                                 REAL8 freqShift					///< [in] frequency-shift to apply, sign is "new - old"
                                 )
+{
+  XLAL_CHECK ( xIn != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( XLALApplySpindownAndFreqShiftRange ( xOut, xIn, doppler, freqShift, 0, xIn->data->length ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+} // XLALApplySpindownAndFreqShift()
+
+///
+/// Apply the spindown phase-factors and frequency-shift to the time samples jStart <= j < jEnd of 'xIn'.
+/// Different ranges of the same timeseries may be processed concurrently.
+///
+static int
+XLALApplySpindownAndFreqShiftRange ( COMPLEX8 *restrict xOut,      			///< [out] the spindown-corrected SRC-frame timeseries
+                                     const COMPLEX8TimeSeries *restrict xIn,		///< [in] the input SRC-frame timeseries
+                                     const PulsarDopplerParams *restrict doppler,	///< [in] containing spindown parameters
+                                     REAL8 freqShift,					///< [in] frequency-shift to apply, sign is "new - old"
+                                     UINT4 jStart,					///< [in] first time sample to process
+                                     UINT4 jEnd						///< [in] one past the last time sample to process
+                                     )
 {
   // input sanity checks
   XLAL_CHECK ( xOut != NULL, XLAL_EINVAL );
@@ -861,13 +1594,13 @@ XLALApplySpindownAndFreqShift ( COMPLEX8 *restrict xOut,      			///< [out] the
   }
 
   REAL8 dt = xIn->deltaT;
-  UINT4 numSamplesIn  = xIn->data->length;
+  XLAL_CHECK ( jStart <= jEnd && jEnd <= xIn->data->length, XLAL_EINVAL );
 
   LIGOTimeGPS epoch = xIn->epoch;
   REAL8 Dtau0 = GPSDIFF ( epoch, doppler->refTime );
 
   // loop over time samples
-  for ( UINT4 j = 0; j < numSamplesIn; j ++ )
+  for ( UINT4 j = jStart; j < jEnd; j ++ )
     {
       REAL8 taup_j = j * dt;
       REAL8 Dtau_alpha_j = Dtau0 + taup_j;
@@ -888,11 +1621,186 @@ XLALApplySpindownAndFreqShift ( COMPLEX8 *restrict xOut,      			///< [out] the
       // weight the complex timeseries by the antenna patterns
       xOut[j] = em2piphase * xIn->data->data[j];
 
-    } // for j < numSamplesIn
+    } // for j < jEnd
 
   return XLAL_SUCCESS;
 
-} // XLALApplySpindownAndFreqShift()
+} // XLALApplySpindownAndFreqShiftRange()
+
+///
+/// Performs barycentric resampling of the timeseries of a single detector 'X', using the workspace 'ws'.
+/// Different detectors may be processed concurrently, provided each uses its own workspace.
+///
+static int
+XLALBarycentricResampleCOMPLEX8TimeSeriesX ( ResampMethodData *resamp,		// [in/out] resampling input and buffer (to store resampling TS)
+                                             ResampWorkspace *ws,		// [in/out] workspace used for this detector
+                                             const MultiSSBtimes *multiSRCtimes,	// [in] SRC-frame timings for all detectors
+                                             const FstatCommon *common,		// [in] various input quantities and parameters used here
+                                             UINT4 X				// [in] detector index
+                                             )
+{
+  XLAL_CHECK ( XLALBarycentricResamplePrepareX ( resamp, ws, multiSRCtimes, common, X ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALBarycentricResampleInterpolateX ( resamp, ws, X, 0, resamp->multiTimeSeries_SRC_a->data[X]->data->length ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+} // XLALBarycentricResampleCOMPLEX8TimeSeriesX()
+
+///
+/// First step of the barycentric resampling of detector 'X': compute the detector-frame times corresponding to the
+/// SRC-frame samples, and the heterodyne and antenna-pattern correction factors, and store them in the workspace 'ws'.
+///
+static int
+XLALBarycentricResamplePrepareX ( ResampMethodData *resamp,		// [in/out] resampling input and buffer (to store resampling TS)
+                                  ResampWorkspace *ws,			// [in/out] workspace used for this detector
+                                  const MultiSSBtimes *multiSRCtimes,	// [in] SRC-frame timings for all detectors
+                                  const FstatCommon *common,		// [in] various input quantities and parameters used here
+                                  UINT4 X				// [in] detector index
+                                  )
+{
+  // shorthands
+  REAL8 fHet = resamp->shared->multiTimeSeries_DET->data[0]->f0;
+  REAL8 Tsft = common->multiTimestamps->data[0]->deltaT;
+  REAL8 dt_SRC = resamp->multiTimeSeries_SRC_a->data[0]->deltaT;
+
+  const REAL4 signumLUT[2] = {1, -1};
+
+  // shorthand pointers: input
+  const COMPLEX8TimeSeries *TimeSeries_DETX = resamp->shared->multiTimeSeries_DET->data[X];
+  const LIGOTimeGPSVector  *Timestamps_DETX = common->multiTimestamps->data[X];
+  const SSBtimes *SRCtimesX                 = multiSRCtimes->data[X];
+  const AMCoeffs *AMcoefX			= resamp->multiAMcoef->data[X];
+
+  // shorthand pointers: output
+  COMPLEX8TimeSeries *TimeSeries_SRCX_a     = resamp->multiTimeSeries_SRC_a->data[X];
+  COMPLEX8TimeSeries *TimeSeries_SRCX_b     = resamp->multiTimeSeries_SRC_b->data[X];
+  REAL8Vector *ti_DET = ws->SRCtimes_DET;
+
+  // useful shorthands
+  REAL8 refTime8        = GPSGETREAL8 ( &SRCtimesX->refTime );
+  UINT4 numSFTsX        = Timestamps_DETX->length;
+  UINT4 numSamples_DETX = TimeSeries_DETX->data->length;
+  UINT4 numSamples_SRCX = TimeSeries_SRCX_a->data->length;
+
+  // sanity checks on input data
+  XLAL_CHECK ( numSamples_SRCX == TimeSeries_SRCX_b->data->length, XLAL_EINVAL );
+  XLAL_CHECK ( dt_SRC == TimeSeries_SRCX_a->deltaT, XLAL_EINVAL );
+  XLAL_CHECK ( dt_SRC == TimeSeries_SRCX_b->deltaT, XLAL_EINVAL );
+  XLAL_CHECK ( numSamples_DETX > 0, XLAL_EINVAL, "Input timeseries for detector X=%d has zero samples. Can't handle that!\n", X );
+  XLAL_CHECK ( (SRCtimesX->DeltaT->length == numSFTsX) && (SRCtimesX->Tdot->length == numSFTsX), XLAL_EINVAL );
+  REAL8 fHetX = resamp->shared->multiTimeSeries_DET->data[X]->f0;
+  XLAL_CHECK ( fabs( fHet - fHetX ) < LAL_REAL8_EPS * fHet, XLAL_EINVAL, "Input timeseries must have identical heterodyning frequency 'f0(X=%d)' (%.16g != %.16g)\n", X, fHet, fHetX );
+  REAL8 TsftX = common->multiTimestamps->data[X]->deltaT;
+  XLAL_CHECK ( Tsft == TsftX, XLAL_EINVAL, "Input timestamps must have identical stepsize 'Tsft(X=%d)' (%.16g != %.16g)\n", X, Tsft, TsftX );
+
+  TimeSeries_SRCX_a->f0 = fHet;
+  TimeSeries_SRCX_b->f0 = fHet;
+  // set SRC-frame time-series start-time
+  REAL8 tStart_SRC_0 = refTime8 + SRCtimesX->DeltaT->data[0] - (0.5*Tsft) * SRCtimesX->Tdot->data[0];
+  LIGOTimeGPS epoch;
+  GPSSETREAL8 ( epoch, tStart_SRC_0 );
+  TimeSeries_SRCX_a->epoch = epoch;
+  TimeSeries_SRCX_b->epoch = epoch;
+
+  // make sure all output samples are initialized to zero first, in case of gaps
+  memset ( TimeSeries_SRCX_a->data->data, 0, TimeSeries_SRCX_a->data->length * sizeof(TimeSeries_SRCX_a->data->data[0]) );
+  memset ( TimeSeries_SRCX_b->data->data, 0, TimeSeries_SRCX_b->data->length * sizeof(TimeSeries_SRCX_b->data->data[0]) );
+  // make sure detector-frame timesteps to interpolate to are initialized to 0, in case of gaps
+  memset ( ws->SRCtimes_DET->data, 0, ws->SRCtimes_DET->length * sizeof(ws->SRCtimes_DET->data[0]) );
+
+  memset ( ws->TStmp1_SRC->data, 0, ws->TStmp1_SRC->length * sizeof(ws->TStmp1_SRC->data[0]) );
+  memset ( ws->TStmp2_SRC->data, 0, ws->TStmp2_SRC->length * sizeof(ws->TStmp2_SRC->data[0]) );
+
+  REAL8 tStart_DET_0 = GPSGETREAL8 ( &(Timestamps_DETX->data[0]) );// START time of the SFT at the detector
+
+  // loop over SFT timestamps and compute the detector frame time samples corresponding to uniformly sampled SRC time samples
+  for ( UINT4 alpha = 0; alpha < numSFTsX; alpha ++ )
+    {
+      // define some useful shorthands
+      REAL8 Tdot_al       = SRCtimesX->Tdot->data [ alpha ];		// the instantaneous time derivitive dt_SRC/dt_DET at the MID-POINT of the SFT
+      REAL8 tMid_SRC_al   = refTime8 + SRCtimesX->DeltaT->data[alpha];	// MID-POINT time of the SFT at the SRC
+      REAL8 tStart_SRC_al = tMid_SRC_al - 0.5 * Tsft * Tdot_al;		// approximate START time of the SFT at the SRC
+      REAL8 tEnd_SRC_al   = tMid_SRC_al + 0.5 * Tsft * Tdot_al;		// approximate END time of the SFT at the SRC
+
+      REAL8 tStart_DET_al = GPSGETREAL8 ( &(Timestamps_DETX->data[alpha]) );// START time of the SFT at the detector
+      REAL8 tMid_DET_al   = tStart_DET_al + 0.5 * Tsft;			// MID-POINT time of the SFT at the detector
+
+      // indices of first and last SRC-frame sample corresponding to this SFT
+      UINT4 iStart_SRC_al = lround ( (tStart_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the start of the SFT
+      UINT4 iEnd_SRC_al   = lround ( (tEnd_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the end of the SFT
+
+      // truncate to actual SRC-frame timeseries
+      iStart_SRC_al = MYMIN ( iStart_SRC_al, numSamples_SRCX - 1);
+      iEnd_SRC_al   = MYMIN ( iEnd_SRC_al, numSamples_SRCX - 1);
+      UINT4 numSamplesSFT_SRC_al = iEnd_SRC_al - iStart_SRC_al + 1;		// the number of samples in the SRC-frame for this SFT
+
+      REAL4 a_al = AMcoefX->a->data[alpha];
+      REAL4 b_al = AMcoefX->b->data[alpha];
+      for ( UINT4 j = 0; j < numSamplesSFT_SRC_al; j++ )
+        {
+          UINT4 iSRC_al_j  = iStart_SRC_al + j;
+
+          // for each time sample in the SRC frame, we estimate the corresponding detector time,
+          // using a linear approximation expanding around the midpoint of each SFT
+          REAL8 t_SRC = tStart_SRC_0 + iSRC_al_j * dt_SRC;
+          ti_DET->data [ iSRC_al_j ] = tMid_DET_al + ( t_SRC - tMid_SRC_al ) / Tdot_al;
+
+          // pre-compute correction factors due to non-zero heterodyne frequency of input
+          REAL8 tDiff = iSRC_al_j * dt_SRC + (tStart_DET_0 - ti_DET->data [ iSRC_al_j ]); 	// tSRC_al_j - tDET(tSRC_al_j)
+          REAL8 cycles = fmod ( fHet * tDiff, 1.0 );				// the accumulated heterodyne cycles
+
+          // use a look-up-table for speed to compute real and imaginary phase
+          REAL4 cosphase, sinphase;                                   // the real and imaginary parts of the phase correction
+          XLAL_CHECK( XLALSinCos2PiLUT ( &sinphase, &cosphase, -cycles ) == XLAL_SUCCESS, XLAL_EFUNC );
+          COMPLEX8 ei2piphase = crectf ( cosphase, sinphase );
+
+          // apply AM coefficients a(t), b(t) to SRC frame timeseries [alternate sign to get final FFT return DC in the middle]
+          REAL4 signum = signumLUT [ (iSRC_al_j % 2) ];	// alternating sign, avoid branching
+          ei2piphase *= signum;
+          ws->TStmp1_SRC->data [ iSRC_al_j ] = ei2piphase * a_al;
+          ws->TStmp2_SRC->data [ iSRC_al_j ] = ei2piphase * b_al;
+        } // for j < numSamples_SRC_al
+
+    } // for  alpha < numSFTsX
+
+  XLAL_CHECK ( ti_DET->length >= numSamples_SRCX, XLAL_EINVAL );
+
+  return XLAL_SUCCESS;
+
+} // XLALBarycentricResamplePrepareX()
+
+///
+/// Second step of the barycentric resampling of detector 'X': interpolate the detector-frame timeseries to the SRC-frame
+/// samples jStart <= j < jEnd, and apply the correction factors computed by XLALBarycentricResamplePrepareX().
+/// Different ranges of samples may be processed concurrently.
+///
+static int
+XLALBarycentricResampleInterpolateX ( ResampMethodData *resamp,		// [in/out] resampling input and buffer (to store resampling TS)
+                                      ResampWorkspace *ws,		// [in] workspace filled by XLALBarycentricResamplePrepareX()
+                                      UINT4 X,				// [in] detector index
+                                      UINT4 jStart,			// [in] first SRC-frame sample to compute
+                                      UINT4 jEnd			// [in] one past the last SRC-frame sample to compute
+                                      )
+{
+  const COMPLEX8TimeSeries *TimeSeries_DETX = resamp->shared->multiTimeSeries_DET->data[X];
+  COMPLEX8TimeSeries *TimeSeries_SRCX_a     = resamp->multiTimeSeries_SRC_a->data[X];
+  COMPLEX8TimeSeries *TimeSeries_SRCX_b     = resamp->multiTimeSeries_SRC_b->data[X];
+  XLAL_CHECK ( jStart <= jEnd && jEnd <= TimeSeries_SRCX_a->data->length, XLAL_EINVAL );
+  XLAL_CHECK ( jEnd <= ws->SRCtimes_DET->length, XLAL_EINVAL );
+
+  // interpolate into views of the requested range of samples
+  COMPLEX8Vector y_out = { .length = jEnd - jStart, .data = TimeSeries_SRCX_a->data->data + jStart };
+  REAL8Vector t_out = { .length = jEnd - jStart, .data = ws->SRCtimes_DET->data + jStart };
+  XLAL_CHECK ( XLALSincInterpolateCOMPLEX8TimeSeries ( &y_out, &t_out, TimeSeries_DETX, resamp->shared->Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // apply heterodyne correction and AM-functions a(t) and b(t) to interpolated timeseries
+  for ( UINT4 j = jStart; j < jEnd; j ++ )
+    {
+      TimeSeries_SRCX_b->data->data[j] = TimeSeries_SRCX_a->data->data[j] * ws->TStmp2_SRC->data[j];
+      TimeSeries_SRCX_a->data->data[j] *= ws->TStmp1_SRC->data[j];
+    } // for j < jEnd
+
+  return XLAL_SUCCESS;
+
+} // XLALBarycentricResampleInterpolateX()
 
 ///
 /// Performs barycentric resampling on a multi-detector timeseries, updates resampling buffer with results
@@ -911,13 +1819,13 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
   XLAL_CHECK ( thisPoint != NULL, XLAL_EINVAL );
   XLAL_CHECK ( common != NULL, XLAL_EINVAL );
   XLAL_CHECK ( resamp != NULL, XLAL_EINVAL );
-  XLAL_CHECK ( resamp->multiTimeSeries_DET != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( resamp->shared->multiTimeSeries_DET != NULL, XLAL_EINVAL );
   XLAL_CHECK ( resamp->multiTimeSeries_SRC_a != NULL, XLAL_EINVAL );
   XLAL_CHECK ( resamp->multiTimeSeries_SRC_b != NULL, XLAL_EINVAL );
 
   ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
 
-  UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
+  UINT4 numDetectors = resamp->shared->multiTimeSeries_DET->length;
   XLAL_CHECK ( resamp->multiTimeSeries_SRC_a->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors tsDET(%d) != tsSRC(%d)\n", numDetectors, resamp->multiTimeSeries_SRC_a->length );
   XLAL_CHECK ( resamp->multiTimeSeries_SRC_b->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors tsDET(%d) != tsSRC(%d)\n", numDetectors, resamp->multiTimeSeries_SRC_b->length );
 
@@ -984,128 +1892,38 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
   // record barycenter parameters in order to allow re-usal of this result ('buffering')
   resamp->prev_doppler = (*thisPoint);
 
-  // shorthands
-  REAL8 fHet = resamp->multiTimeSeries_DET->data[0]->f0;
-  REAL8 Tsft = common->multiTimestamps->data[0]->deltaT;
-  REAL8 dt_SRC = resamp->multiTimeSeries_SRC_a->data[0]->deltaT;
-
-  const REAL4 signumLUT[2] = {1, -1};
-
-  // loop over detectors X
-  for ( UINT4 X = 0; X < numDetectors; X++)
+  const int numThreads = (int) MYMAX ( resamp->numThreads, 1 );
+  if ( numThreads > 1 )
     {
-      // shorthand pointers: input
-      const COMPLEX8TimeSeries *TimeSeries_DETX = resamp->multiTimeSeries_DET->data[X];
-      const LIGOTimeGPSVector  *Timestamps_DETX = common->multiTimestamps->data[X];
-      const SSBtimes *SRCtimesX                 = multiSRCtimes->data[X];
-      const AMCoeffs *AMcoefX			= resamp->multiAMcoef->data[X];
-
-      // shorthand pointers: output
-      COMPLEX8TimeSeries *TimeSeries_SRCX_a     = resamp->multiTimeSeries_SRC_a->data[X];
-      COMPLEX8TimeSeries *TimeSeries_SRCX_b     = resamp->multiTimeSeries_SRC_b->data[X];
-      REAL8Vector *ti_DET = ws->SRCtimes_DET;
-
-      // useful shorthands
-      REAL8 refTime8        = GPSGETREAL8 ( &SRCtimesX->refTime );
-      UINT4 numSFTsX        = Timestamps_DETX->length;
-      UINT4 numSamples_DETX = TimeSeries_DETX->data->length;
-      UINT4 numSamples_SRCX = TimeSeries_SRCX_a->data->length;
-
-      // sanity checks on input data
-      XLAL_CHECK ( numSamples_SRCX == TimeSeries_SRCX_b->data->length, XLAL_EINVAL );
-      XLAL_CHECK ( dt_SRC == TimeSeries_SRCX_a->deltaT, XLAL_EINVAL );
-      XLAL_CHECK ( dt_SRC == TimeSeries_SRCX_b->deltaT, XLAL_EINVAL );
-      XLAL_CHECK ( numSamples_DETX > 0, XLAL_EINVAL, "Input timeseries for detector X=%d has zero samples. Can't handle that!\n", X );
-      XLAL_CHECK ( (SRCtimesX->DeltaT->length == numSFTsX) && (SRCtimesX->Tdot->length == numSFTsX), XLAL_EINVAL );
-      REAL8 fHetX = resamp->multiTimeSeries_DET->data[X]->f0;
-      XLAL_CHECK ( fabs( fHet - fHetX ) < LAL_REAL8_EPS * fHet, XLAL_EINVAL, "Input timeseries must have identical heterodyning frequency 'f0(X=%d)' (%.16g != %.16g)\n", X, fHet, fHetX );
-      REAL8 TsftX = common->multiTimestamps->data[X]->deltaT;
-      XLAL_CHECK ( Tsft == TsftX, XLAL_EINVAL, "Input timestamps must have identical stepsize 'Tsft(X=%d)' (%.16g != %.16g)\n", X, Tsft, TsftX );
-
-      TimeSeries_SRCX_a->f0 = fHet;
-      TimeSeries_SRCX_b->f0 = fHet;
-      // set SRC-frame time-series start-time
-      REAL8 tStart_SRC_0 = refTime8 + SRCtimesX->DeltaT->data[0] - (0.5*Tsft) * SRCtimesX->Tdot->data[0];
-      LIGOTimeGPS epoch;
-      GPSSETREAL8 ( epoch, tStart_SRC_0 );
-      TimeSeries_SRCX_a->epoch = epoch;
-      TimeSeries_SRCX_b->epoch = epoch;
-
-      // make sure all output samples are initialized to zero first, in case of gaps
-      memset ( TimeSeries_SRCX_a->data->data, 0, TimeSeries_SRCX_a->data->length * sizeof(TimeSeries_SRCX_a->data->data[0]) );
-      memset ( TimeSeries_SRCX_b->data->data, 0, TimeSeries_SRCX_b->data->length * sizeof(TimeSeries_SRCX_b->data->data[0]) );
-      // make sure detector-frame timesteps to interpolate to are initialized to 0, in case of gaps
-      memset ( ws->SRCtimes_DET->data, 0, ws->SRCtimes_DET->length * sizeof(ws->SRCtimes_DET->data[0]) );
-
-      memset ( ws->TStmp1_SRC->data, 0, ws->TStmp1_SRC->length * sizeof(ws->TStmp1_SRC->data[0]) );
-      memset ( ws->TStmp2_SRC->data, 0, ws->TStmp2_SRC->length * sizeof(ws->TStmp2_SRC->data[0]) );
-
-      REAL8 tStart_DET_0 = GPSGETREAL8 ( &(Timestamps_DETX->data[0]) );// START time of the SFT at the detector
-
-      // loop over SFT timestamps and compute the detector frame time samples corresponding to uniformly sampled SRC time samples
-      for ( UINT4 alpha = 0; alpha < numSFTsX; alpha ++ )
-        {
-          // define some useful shorthands
-          REAL8 Tdot_al       = SRCtimesX->Tdot->data [ alpha ];		// the instantaneous time derivitive dt_SRC/dt_DET at the MID-POINT of the SFT
-          REAL8 tMid_SRC_al   = refTime8 + SRCtimesX->DeltaT->data[alpha];	// MID-POINT time of the SFT at the SRC
-          REAL8 tStart_SRC_al = tMid_SRC_al - 0.5 * Tsft * Tdot_al;		// approximate START time of the SFT at the SRC
-          REAL8 tEnd_SRC_al   = tMid_SRC_al + 0.5 * Tsft * Tdot_al;		// approximate END time of the SFT at the SRC
-
-          REAL8 tStart_DET_al = GPSGETREAL8 ( &(Timestamps_DETX->data[alpha]) );// START time of the SFT at the detector
-          REAL8 tMid_DET_al   = tStart_DET_al + 0.5 * Tsft;			// MID-POINT time of the SFT at the detector
-
-          // indices of first and last SRC-frame sample corresponding to this SFT
-          UINT4 iStart_SRC_al = lround ( (tStart_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the start of the SFT
-          UINT4 iEnd_SRC_al   = lround ( (tEnd_SRC_al - tStart_SRC_0) / dt_SRC );	// the index of the resampled timeseries corresponding to the end of the SFT
-
-          // truncate to actual SRC-frame timeseries
-          iStart_SRC_al = MYMIN ( iStart_SRC_al, numSamples_SRCX - 1);
-          iEnd_SRC_al   = MYMIN ( iEnd_SRC_al, numSamples_SRCX - 1);
-          UINT4 numSamplesSFT_SRC_al = iEnd_SRC_al - iStart_SRC_al + 1;		// the number of samples in the SRC-frame for this SFT
-
-          REAL4 a_al = AMcoefX->a->data[alpha];
-          REAL4 b_al = AMcoefX->b->data[alpha];
-          for ( UINT4 j = 0; j < numSamplesSFT_SRC_al; j++ )
-            {
-              UINT4 iSRC_al_j  = iStart_SRC_al + j;
-
-              // for each time sample in the SRC frame, we estimate the corresponding detector time,
-              // using a linear approximation expanding around the midpoint of each SFT
-              REAL8 t_SRC = tStart_SRC_0 + iSRC_al_j * dt_SRC;
-              ti_DET->data [ iSRC_al_j ] = tMid_DET_al + ( t_SRC - tMid_SRC_al ) / Tdot_al;
-
-              // pre-compute correction factors due to non-zero heterodyne frequency of input
-              REAL8 tDiff = iSRC_al_j * dt_SRC + (tStart_DET_0 - ti_DET->data [ iSRC_al_j ]); 	// tSRC_al_j - tDET(tSRC_al_j)
-              REAL8 cycles = fmod ( fHet * tDiff, 1.0 );				// the accumulated heterodyne cycles
-
-              // use a look-up-table for speed to compute real and imaginary phase
-              REAL4 cosphase, sinphase;                                   // the real and imaginary parts of the phase correction
-              XLAL_CHECK( XLALSinCos2PiLUT ( &sinphase, &cosphase, -cycles ) == XLAL_SUCCESS, XLAL_EFUNC );
-              COMPLEX8 ei2piphase = crectf ( cosphase, sinphase );
-
-              // apply AM coefficients a(t), b(t) to SRC frame timeseries [alternate sign to get final FFT return DC in the middle]
-              REAL4 signum = signumLUT [ (iSRC_al_j % 2) ];	// alternating sign, avoid branching
-              ei2piphase *= signum;
-              ws->TStmp1_SRC->data [ iSRC_al_j ] = ei2piphase * a_al;
-              ws->TStmp2_SRC->data [ iSRC_al_j ] = ei2piphase * b_al;
-            } // for j < numSamples_SRC_al
-
-        } // for  alpha < numSFTsX
-
-      XLAL_CHECK ( ti_DET->length >= TimeSeries_SRCX_a->data->length, XLAL_EINVAL );
-      UINT4 bak_length = ti_DET->length;
-      ti_DET->length = TimeSeries_SRCX_a->data->length;
-      XLAL_CHECK ( XLALSincInterpolateCOMPLEX8TimeSeries ( TimeSeries_SRCX_a->data, ti_DET, TimeSeries_DETX, resamp->Dterms ) == XLAL_SUCCESS, XLAL_EFUNC );
-      ti_DET->length = bak_length;
-
-      // apply heterodyne correction and AM-functions a(t) and b(t) to interpolated timeseries
-      for ( UINT4 j = 0; j < numSamples_SRCX; j ++ )
+      // prepare each detector in parallel, then interpolate 'numSubBands' ranges of SRC-frame samples per detector in parallel
+      const UINT4 numSubBands = resamp->numSubBands;
+      int failed = 0;
+#pragma omp parallel num_threads(numThreads)
+      {
+#pragma omp for schedule(static,1) reduction(|:failed)
+        for ( UINT4 X = 0; X < numDetectors; X++)
+          {
+            failed |= ( XLALBarycentricResamplePrepareX ( resamp, resamp->wsPerDet[X], multiSRCtimes, common, X ) != XLAL_SUCCESS );
+          } // for X < numDetectors
+#pragma omp for schedule(static) reduction(|:failed)
+        for ( UINT4 t = 0; t < numDetectors * numSubBands; t++ )
+          {
+            const UINT4 X = t / numSubBands, i = t % numSubBands;
+            const UINT4 numSamples_SRCX = resamp->multiTimeSeries_SRC_a->data[X]->data->length;
+            const UINT4 jStart = ( (UINT8) numSamples_SRCX * i ) / numSubBands;
+            const UINT4 jEnd = ( (UINT8) numSamples_SRCX * ( i + 1 ) ) / numSubBands;
+            failed |= ( XLALBarycentricResampleInterpolateX ( resamp, resamp->wsPerDet[X], X, jStart, jEnd ) != XLAL_SUCCESS );
+          } // for t < numDetectors * numSubBands
+      }
+      XLAL_CHECK ( !failed, XLAL_EFUNC, "Barycentric resampling failed for at least one detector\n" );
+    }
+  else
+    {
+      for ( UINT4 X = 0; X < numDetectors; X++)
         {
-          TimeSeries_SRCX_b->data->data[j] = TimeSeries_SRCX_a->data->data[j] * ws->TStmp2_SRC->data[j];
-          TimeSeries_SRCX_a->data->data[j] *= ws->TStmp1_SRC->data[j];
-        } // for j < numSamples_SRCX
-
-    } // for X < numDetectors
+          XLAL_CHECK ( XLALBarycentricResampleCOMPLEX8TimeSeriesX ( resamp, ws, multiSRCtimes, common, X ) == XLAL_SUCCESS, XLAL_EFUNC );
+        } // for X < numDetectors
+    }
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
@@ -66,6 +66,9 @@ typedef struct {
   int (*compute_func) (					// F-statistic method computation function
     FstatResults *, const FstatCommon *, void *
     );
+  int (*compute_block_func) (				// Optional: F-statistic method computation function for a block of spindowns
+    FstatResults **, const UINT4, const FstatCommon *, void *
+    );
   void (*method_data_destroy_func) ( void * );		// F-statistic method data destructor function
   void (*workspace_destroy_func) ( void * );		// Workspace destructor function
 } FstatMethodFuncs;
@@ -77,6 +80,7 @@ int XLALGetFstatTiming_Resamp ( const void *method_data, FstatTimingGeneric *tim
 void *XLALFstatInputTimeslice_Demod ( const void *method_data, const UINT4 iStart[PULSAR_MAX_DETECTORS], const UINT4 iEnd[PULSAR_MAX_DETECTORS] );
 void XLALDestroyFstatInputTimeslice_common ( FstatCommon *common );
 void XLALDestroyFstatInputTimeslice_Demod ( void *method_data );
+void *XLALFstatInputThreadCopy_Resamp ( FstatCommon *common, const void *method_data );
 
 static inline REAL4
 compute_fstat_from_fa_fb ( COMPLEX8 Fa, COMPLEX8 Fb, REAL4 A, REAL4 B, REAL4 C, REAL4 E, REAL4 Dinv )
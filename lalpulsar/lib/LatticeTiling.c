@@ -20,6 +20,10 @@
 #include <config.h>
 #include <fenv.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
@@ -42,6 +46,12 @@
 // Number of cached values which can be stored per dimension
 #define LT_CACHE_MAX_SIZE 6
 
+// Maximum number of points for which LT_FindNearestPoints() uses stack memory
+#define LT_STACK_MAX_POINTS 16
+
+// Minimum number of points for which LT_FindNearestPoints() sorts points
+#define LT_SORT_MIN_POINTS 32
+
 ///
 /// Lattice tiling parameter-space bound for one dimension.
 ///
@@ -125,6 +135,42 @@ struct tagLatticeTilingIterator {
   UINT8 index;                          ///< Index of current lattice tiling point
 };
 
+///
+/// Block of lattice tiling points dispensed by a lattice tiling dispenser.
+///
+typedef struct tagLT_DispensedBlock {
+  UINT8 first;                          ///< Index of first point in block
+  UINT8 count;                          ///< Number of points in block
+  bool finished;                        ///< Whether block has been finished
+  LatticeTilingIterator *start;         ///< Iterator state before the first point in block
+} LT_DispensedBlock;
+
+///
+/// FITS record for saving and restoring finished blocks of a lattice tiling dispenser.
+///
+typedef struct tagLT_FITSBlockRecord {
+  UINT8 first;                          ///< Index of first point in finished block
+  UINT8 count;                          ///< Number of points in finished block
+} LT_FITSBlockRecord;
+
+struct tagLatticeTilingDispenser {
+  LatticeTilingIterator *itr;           ///< Iterator which generates dispensed points
+  UINT8 total;                          ///< Total number of points to dispense
+  UINT8 nfinished;                      ///< Number of points in finished blocks
+  UINT4 nworkers;                       ///< Number of workers expected to pull blocks
+  UINT4 min_block_size;                 ///< Minimum number of points in a dispensed block
+  size_t nblocks;                       ///< Number of dispensed blocks not yet retired
+  size_t max_nblocks;                   ///< Allocated length of dispensed block array
+  LT_DispensedBlock *blocks;            ///< Dispensed blocks not yet retired, in order of index
+  size_t nskip;                         ///< Number of blocks finished before a restore still to be skipped
+  LT_FITSBlockRecord *skip;             ///< Blocks finished before a restore still to be skipped, in order of index
+  size_t nspare;                        ///< Number of spare iterators
+  LatticeTilingIterator **spare;        ///< Spare iterators for storing iterator states
+#ifdef HAVE_PTHREAD
+  pthread_mutex_t lock;                 ///< Lock protecting dispenser state
+#endif
+};
+
 struct tagLatticeTilingLocator {
   const LatticeTiling *tiling;          ///< Lattice tiling
   size_t ndim;                          ///< Number of parameter-space dimensions
@@ -349,6 +395,39 @@ static int LT_StatsCallback(
 
 }
 
+///
+/// Point sorted by LT_FindNearestPoints() by its rounded generating integers
+///
+typedef struct tagLT_SortPoint {
+  const double *rounded;                ///< Rounded generating integers of point in tiled dimensions
+  size_t stride;                        ///< Stride between tiled dimensions in 'rounded'
+  size_t tn;                            ///< Number of tiled dimensions
+  size_t j;                             ///< Index of point
+} LT_SortPoint;
+
+///
+/// Compare points lexicographically by their rounded generating integers
+///
+static int LT_SortPointCompare(
+  const void *x,
+  const void *y
+  )
+{
+  const LT_SortPoint *px = ( const LT_SortPoint * ) x;
+  const LT_SortPoint *py = ( const LT_SortPoint * ) y;
+  for ( size_t ti = 0; ti < px->tn; ++ti ) {
+    const double rx = px->rounded[ti * px->stride];
+    const double ry = py->rounded[ti * py->stride];
+    if ( rx < ry ) {
+      return -1;
+    }
+    if ( rx > ry ) {
+      return +1;
+    }
+  }
+  return ( px->j > py->j ) - ( px->j < py->j );
+}
+
 ///
 /// Initialise FITS table for saving and restoring a lattice tiling iterator
 ///
@@ -364,6 +443,17 @@ static int LT_InitFITSRecordTable( FITSFile *file )
   return XLAL_SUCCESS;
 }
 
+///
+/// Initialise FITS table for saving and restoring finished blocks of a lattice tiling dispenser
+///
+static int LT_InitFITSBlockRecordTable( FITSFile *file )
+{
+  XLAL_FITS_TABLE_COLUMN_BEGIN( LT_FITSBlockRecord );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, first ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLAL_FITS_TABLE_COLUMN_ADD( file, UINT8, count ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
 ///
 /// Free memory pointed to by an index trie. The trie itself should be freed by the caller.
 ///
@@ -528,6 +618,18 @@ static int LT_FindNearestPoints(
   const size_t tn = loc->tiled_ndim;
   const size_t num_points = points->size2;
 
+  // Workspace: rounded generating integers of tiled dimensions, order in which to find nearest
+  // points, and path through the index trie and nearest point of the previous point. Stack memory
+  // is used for few enough points. All are declared here, before any jump to XLAL_FAIL below.
+  const size_t num_rounded = ( tn > 0 ) ? tn * num_points : 1;
+  double rounded_stack[( num_points <= LT_STACK_MAX_POINTS ) ? num_rounded : 1];
+  LT_SortPoint order_stack[( num_points <= LT_STACK_MAX_POINTS ) ? num_points : 1];
+  double *rounded = rounded_stack;
+  LT_SortPoint *order = order_stack;
+  const LT_IndexTrie *trie_path[( tn > 0 ) ? tn : 1];
+  INT4 prev_nearest[n];
+  bool have_prev = false;
+
   // Copy 'points' to 'nearest_points'
   gsl_matrix_memcpy( nearest_points, points );
 
@@ -539,8 +641,57 @@ static int LT_FindNearestPoints(
   }
   gsl_blas_dtrmm( CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, 1.0, loc->tiling->int_from_phys, nearest_points );
 
-  // Find the nearest points in the lattice tiling to the points in 'nearest_points'
+  // Round the tiled dimensions of all points in 'nearest_points' to the nearest integers. Each
+  // dimension is stored contiguously in a row of 'nearest_points', so rounding is performed in
+  // simple loops over rows which the compiler can vectorise. Note that round(), like lround(),
+  // rounds half-way cases away from zero. Rounded values must be representable as INT4.
+  if ( num_points > LT_STACK_MAX_POINTS ) {
+    rounded = XLALMalloc( num_rounded * sizeof( *rounded ) );
+    XLAL_CHECK_FAIL( rounded != NULL, XLAL_ENOMEM );
+  }
+  for ( size_t ti = 0; ti < tn; ++ti ) {
+    const size_t i = loc->tiling->tiled_idx[ti];
+    const double *nearest_points_row = gsl_matrix_const_ptr( nearest_points, i, 0 );
+    double *rounded_row = &rounded[ti * num_points];
+    int round_failed = 0;
+    for ( size_t j = 0; j < num_points; ++j ) {
+      rounded_row[j] = round( nearest_points_row[j] );
+      round_failed |= !( fabs( rounded_row[j] ) <= INT32_MAX );
+    }
+    if ( round_failed ) {
+      size_t j = 0;
+      while ( fabs( rounded_row[j] ) <= INT32_MAX ) {
+        ++j;
+      }
+      XLALPrintError( "Rounding failed while finding nearest point #%zu:", j );
+      for ( size_t tj = 0; tj < tn; ++tj ) {
+        XLALPrintError( " %0.2e", gsl_matrix_get( nearest_points, loc->tiling->tiled_idx[tj], j ) );
+      }
+      XLALPrintError( "\n" );
+      XLAL_ERROR_FAIL( XLAL_EFAILED );
+    }
+  }
+
+  // Determine the order in which to find nearest points: if there are enough points, sort points
+  // by their rounded generating integers, so that consecutive points share as much of their
+  // paths through the index trie as possible
+  if ( num_points > LT_STACK_MAX_POINTS ) {
+    order = XLALMalloc( num_points * sizeof( *order ) );
+    XLAL_CHECK_FAIL( order != NULL, XLAL_ENOMEM );
+  }
   for ( size_t j = 0; j < num_points; ++j ) {
+    order[j].rounded = &rounded[j];
+    order[j].stride = num_points;
+    order[j].tn = tn;
+    order[j].j = j;
+  }
+  if ( tn > 0 && num_points >= LT_SORT_MIN_POINTS ) {
+    qsort( order, num_points, sizeof( *order ), LT_SortPointCompare );
+  }
+
+  // Find the nearest points in the lattice tiling to the points in 'nearest_points'
+  for ( size_t jj = 0; jj < num_points; ++jj ) {
+    const size_t j = order[jj].j;
 
     // If there are tiled dimensions:
     INT4 nearest[n];
@@ -553,20 +704,10 @@ static int LT_FindNearestPoints(
 
       {
 
-        // Round each dimension of 'nearest_points[:,j]' to nearest integer to find the nearest point in Zn
-        feclearexcept( FE_ALL_EXCEPT );
+        // The nearest point in Zn is given by rounding each dimension of 'nearest_points[:,j]' to nearest integer
         for ( size_t ti = 0; ti < tn; ++ti ) {
           const size_t i = loc->tiling->tiled_idx[ti];
-          nearest[i] = lround( gsl_matrix_get( nearest_points, i, j ) );
-        }
-        if ( fetestexcept( FE_INVALID ) != 0 ) {
-          XLALPrintError( "Rounding failed while finding nearest point #%zu:", j );
-          for ( size_t ti = 0; ti < tn; ++ti ) {
-            const size_t i = loc->tiling->tiled_idx[ti];
-            XLALPrintError( " %0.2e", gsl_matrix_get( nearest_points, i, j ) );
-          }
-          XLALPrintError( "\n" );
-          XLAL_ERROR( XLAL_EFAILED );
+          nearest[i] = ( INT4 ) rounded[ti * num_points + j];
         }
 
       }
@@ -603,24 +744,19 @@ static int LT_FindNearestPoints(
         {
 
           // Lines 1--4, 20
+          // - Line 20 is moved here to avoid duplicate round; the tiled dimensions of 'y' have already been rounded
           double z[tn+1], alpha = 0, beta = 0;
           size_t bucket[tn+1], link[tn+1];
-          feclearexcept( FE_ALL_EXCEPT );
+          k[0] = 0;
+          for ( size_t ti = 2; ti <= tn + 1; ++ti ) {
+            k[ti-1] = ( INT4 ) rounded[( ti - 2 ) * num_points + j];
+          }
           for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
-            k[ti-1] = lround( y[ti-1] ); // Line 20, moved here to avoid duplicate round
             z[ti-1] = y[ti-1] - k[ti-1];
             alpha += z[ti-1];
             beta += z[ti-1]*z[ti-1];
             bucket[ti-1] = 0;
           }
-          if ( fetestexcept( FE_INVALID ) != 0 ) {
-            XLALPrintError( "Rounding failed while finding nearest point #%zu:", j );
-            for ( size_t ti = 1; ti <= tn + 1; ++ti ) {
-              XLALPrintError( " %0.2e", y[ti-1] );
-            }
-            XLALPrintError( "\n" );
-            XLAL_ERROR( XLAL_EFAILED );
-          }
 
           // Lines 5--8
           // Notes:
@@ -681,15 +817,23 @@ static int LT_FindNearestPoints(
       break;
 
       default:
-        XLAL_ERROR( XLAL_EFAILED, "Invalid lattice" );
+        XLAL_ERROR_FAIL( XLAL_EFAILED, "Invalid lattice" );
       }
 
       // Bound generating integers
+      // - Dimensions in which 'nearest' agrees with the nearest point to the previous point share
+      //   the same path through the index trie, and are already known to be within bounds
       {
-        const LT_IndexTrie *trie = loc->index_trie;
         size_t ti = 0;
+        if ( have_prev ) {
+          while ( ti < tn && nearest[loc->tiling->tiled_idx[ti]] == prev_nearest[loc->tiling->tiled_idx[ti]] ) {
+            ++ti;
+          }
+        }
+        const LT_IndexTrie *trie = ( ti < tn ) ? ( ( ti > 0 ) ? trie_path[ti] : loc->index_trie ) : NULL;
         while ( ti < tn ) {
           const size_t i = loc->tiling->tiled_idx[ti];
+          trie_path[ti] = trie;
 
           // If 'nearest[i]' is outside parameter-space bounds:
           if ( nearest[i] < trie->int_lower || nearest[i] > trie->int_upper ) {
@@ -702,7 +846,7 @@ static int LT_FindNearestPoints(
             double poll_min_distance = GSL_POSINF;
             feclearexcept( FE_ALL_EXCEPT );
             LT_PollIndexTrie( loc->tiling, loc->index_trie, 0, &point_int_view.vector, poll_nearest, &poll_min_distance, nearest );
-            XLAL_CHECK( fetestexcept( FE_INVALID ) == 0, XLAL_EFAILED, "Rounding failed while calling LT_PollIndexTrie() for nearest point #%zu", j );
+            XLAL_CHECK_FAIL( fetestexcept( FE_INVALID ) == 0, XLAL_EFAILED, "Rounding failed while calling LT_PollIndexTrie() for nearest point #%zu", j );
 
             // Reset 'trie', given that 'nearest' may have changed in any dimension
             trie = loc->index_trie;
@@ -721,14 +865,18 @@ static int LT_FindNearestPoints(
         }
       }
 
+      // Save nearest point for comparison with the next point
+      memcpy( prev_nearest, nearest, sizeof( prev_nearest ) );
+      have_prev = true;
+
     }
 
     // Return various outputs
     {
-      const LT_IndexTrie *trie = loc->index_trie;
       UINT8 nearest_index = 0;
       for ( size_t ti = 0, i = 0; i < n; ++i ) {
         const bool is_tiled = loc->tiling->bounds[i].is_tiled;
+        const LT_IndexTrie *trie = is_tiled ? trie_path[ti] : NULL;
 
         // Return nearest point
         if ( is_tiled ) {
@@ -752,11 +900,8 @@ static int LT_FindNearestPoints(
           nearest_rights->data[n * j + i] = is_tiled ? trie->int_upper - nearest[i] : 0;
         }
 
-        // If we are below the highest dimension, jump to the next dimension based on 'nearest[i]'
+        // Increment tiled dimension index
         if ( is_tiled ) {
-          if ( ti + 1 < tn ) {
-            trie = &trie->next[nearest[i] - trie->int_lower];
-          }
           ++ti;
         }
 
@@ -765,6 +910,14 @@ static int LT_FindNearestPoints(
 
   }
 
+  // Cleanup
+  if ( rounded != rounded_stack ) {
+    XLALFree( rounded );
+  }
+  if ( order != order_stack ) {
+    XLALFree( order );
+  }
+
   // Transform 'nearest_points' from generating integers to physical coordinates
   gsl_blas_dtrmm( CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, 1.0, loc->tiling->phys_from_int, nearest_points );
   for ( size_t i = 0; i < n; ++i ) {
@@ -773,26 +926,39 @@ static int LT_FindNearestPoints(
     gsl_vector_add_constant( &nearest_points_row.vector, phys_origin );
   }
 
-  // Create local cache for computing physical bounds
-  double local_cache_array[n * LT_CACHE_MAX_SIZE];
-  gsl_matrix_view local_cache_view = gsl_matrix_view_array( local_cache_array, n, LT_CACHE_MAX_SIZE );
-  gsl_matrix *local_cache = &local_cache_view.matrix;
-  gsl_matrix_set_all( local_cache, GSL_NAN );
-
   // Set any non-tiled dimensions in 'nearest_points'
-  for ( size_t j = 0; j < num_points; ++j ) {
-    gsl_vector_view nearest_points_col = gsl_matrix_column( nearest_points, j );
-    for ( size_t i = 0; i < n; ++i ) {
-      double phys_point = gsl_vector_get( &nearest_points_col.vector, i );
-      if ( !loc->tiling->bounds[i].is_tiled ) {
-        LT_CallBoundFunc( loc->tiling, i, local_cache, &nearest_points_col.vector, &phys_point, NULL );
+  {
+
+    // Create local cache for computing physical bounds
+    double local_cache_array[n * LT_CACHE_MAX_SIZE];
+    gsl_matrix_view local_cache_view = gsl_matrix_view_array( local_cache_array, n, LT_CACHE_MAX_SIZE );
+    gsl_matrix *local_cache = &local_cache_view.matrix;
+    gsl_matrix_set_all( local_cache, GSL_NAN );
+
+    for ( size_t j = 0; j < num_points; ++j ) {
+      gsl_vector_view nearest_points_col = gsl_matrix_column( nearest_points, j );
+      for ( size_t i = 0; i < n; ++i ) {
+        double phys_point = gsl_vector_get( &nearest_points_col.vector, i );
+        if ( !loc->tiling->bounds[i].is_tiled ) {
+          LT_CallBoundFunc( loc->tiling, i, local_cache, &nearest_points_col.vector, &phys_point, NULL );
+        }
+        LT_SetPhysPoint( loc->tiling, local_cache, &nearest_points_col.vector, i, phys_point );
       }
-      LT_SetPhysPoint( loc->tiling, local_cache, &nearest_points_col.vector, i, phys_point );
     }
+
   }
 
   return XLAL_SUCCESS;
 
+XLAL_FAIL:
+  if ( rounded != rounded_stack ) {
+    XLALFree( rounded );
+  }
+  if ( order != order_stack ) {
+    XLALFree( order );
+  }
+  return XLAL_FAILURE;
+
 }
 
 LatticeTiling *XLALCreateLatticeTiling(
@@ -2232,6 +2398,467 @@ int XLALRestoreLatticeTilingIterator(
 
 }
 
+///
+/// Copy the state of a lattice tiling iterator to another iterator over the same lattice tiling.
+///
+static void LT_CopyIterator(
+  LatticeTilingIterator *dst,           ///< [in] Lattice tiling iterator to copy to
+  const LatticeTilingIterator *src      ///< [in] Lattice tiling iterator to copy from
+  )
+{
+  const size_t tn = src->tiling->tiled_ndim;
+  dst->alternating = src->alternating;
+  dst->state = src->state;
+  dst->index = src->index;
+  gsl_vector_memcpy( dst->phys_point, src->phys_point );
+  gsl_matrix_memcpy( dst->phys_point_cache, src->phys_point_cache );
+  if ( tn > 0 ) {
+    memcpy( dst->int_point, src->int_point, tn * sizeof( *dst->int_point ) );
+    memcpy( dst->int_lower, src->int_lower, tn * sizeof( *dst->int_lower ) );
+    memcpy( dst->int_upper, src->int_upper, tn * sizeof( *dst->int_upper ) );
+    memcpy( dst->direction, src->direction, tn * sizeof( *dst->direction ) );
+  }
+}
+
+///
+/// Return the index of the point which will next be returned by a lattice tiling iterator.
+///
+static inline UINT8 LT_NextIteratorIndex(
+  const LatticeTilingIterator *itr      ///< [in] Lattice tiling iterator
+  )
+{
+  return ( itr->state == 0 ) ? 0 : itr->index + 1;
+}
+
+///
+/// Dispense the next block of points from a lattice tiling dispenser. Must be called with the
+/// dispenser locked. Returns the number of points in the block, or XLAL_FAILURE on error.
+///
+static int LT_DispenseBlock(
+  LatticeTilingDispenser *disp,         ///< [in] Lattice tiling dispenser
+  gsl_matrix *points,                   ///< [out] Columns are points in block
+  UINT8 *block_index                    ///< [out] Index of first point in block
+  )
+{
+
+  // If iterator is finished, there are no more blocks
+  if ( disp->itr->state > 1 ) {
+    return 0;
+  }
+
+  // Choose size of block: start with large blocks, which decrease in size as the remaining number of
+  // points decreases, so that workers finish at about the same time (cf. OpenMP guided scheduling)
+  const UINT8 remaining = disp->total - GSL_MIN( disp->total, LT_NextIteratorIndex( disp->itr ) );
+  UINT8 block_size = ( remaining + 2 * disp->nworkers - 1 ) / ( 2 * disp->nworkers );
+  block_size = GSL_MAX( block_size, disp->min_block_size );
+  block_size = GSL_MIN( block_size, points->size2 );
+
+  // Enlarge dispensed block and spare iterator arrays, if required; both arrays have the same
+  // length, which is always at least the total number of dispensed blocks and spare iterators
+  if ( disp->nspare == 0 && disp->nblocks == disp->max_nblocks ) {
+    const size_t max_nblocks = GSL_MAX( 2 * disp->max_nblocks, 2 * disp->nworkers );
+    disp->blocks = XLALRealloc( disp->blocks, max_nblocks * sizeof( disp->blocks[0] ) );
+    XLAL_CHECK( disp->blocks != NULL, XLAL_ENOMEM );
+    disp->spare = XLALRealloc( disp->spare, max_nblocks * sizeof( disp->spare[0] ) );
+    XLAL_CHECK( disp->spare != NULL, XLAL_ENOMEM );
+    disp->max_nblocks = max_nblocks;
+  }
+
+  // Get an iterator to store the iterator state before the first point in block
+  LatticeTilingIterator *start = NULL;
+  if ( disp->nspare > 0 ) {
+    start = disp->spare[--disp->nspare];
+  } else {
+    start = XLALCreateLatticeTilingIterator( disp->itr->tiling, disp->itr->itr_ndim );
+    XLAL_CHECK( start != NULL, XLAL_EFUNC );
+  }
+  LT_CopyIterator( start, disp->itr );
+
+  // Fill block with points
+  UINT8 first = 0;
+  size_t j = 0;
+  while ( j < block_size ) {
+
+    // Skip over any blocks which were finished before the dispenser was restored
+    if ( disp->nskip > 0 && LT_NextIteratorIndex( disp->itr ) == disp->skip[0].first ) {
+
+      // Stop if block already contains points, so that blocks contain contiguous points
+      if ( j > 0 ) {
+        break;
+      }
+
+      // Advance iterator past finished block
+      for ( UINT8 k = 0; k < disp->skip[0].count; ++k ) {
+        const int retn = XLALNextLatticeTilingPoint( disp->itr, NULL );
+        XLAL_CHECK( retn > 0, XLAL_EFUNC, "Could not skip finished block of lattice tiling points" );
+      }
+      --disp->nskip;
+      memmove( &disp->skip[0], &disp->skip[1], disp->nskip * sizeof( disp->skip[0] ) );
+
+      // Update stored iterator state
+      LT_CopyIterator( start, disp->itr );
+
+      continue;
+
+    }
+
+    // Get next point
+    gsl_vector_view point_j = gsl_matrix_column( points, j );
+    const int retn = XLALNextLatticeTilingPoint( disp->itr, &point_j.vector );
+    XLAL_CHECK( retn >= 0, XLAL_EFUNC );
+    if ( retn == 0 ) {
+      break;
+    }
+    if ( j == 0 ) {
+      first = disp->itr->index;
+    }
+    ++j;
+
+  }
+
+  // If block is empty, there are no more blocks
+  if ( j == 0 ) {
+    disp->spare[disp->nspare++] = start;
+    return 0;
+  }
+
+  // Record dispensed block
+  LT_DispensedBlock *block = &disp->blocks[disp->nblocks++];
+  block->first = first;
+  block->count = j;
+  block->finished = false;
+  block->start = start;
+
+  *block_index = first;
+  return j;
+
+}
+
+///
+/// Mark a block of points dispensed by a lattice tiling dispenser as finished. Must be called with
+/// the dispenser locked.
+///
+static int LT_FinishBlock(
+  LatticeTilingDispenser *disp,         ///< [in] Lattice tiling dispenser
+  const UINT8 block_index               ///< [in] Index of first point in block
+  )
+{
+
+  // Find block
+  size_t b = 0;
+  while ( b < disp->nblocks && disp->blocks[b].first != block_index ) {
+    ++b;
+  }
+  XLAL_CHECK( b < disp->nblocks, XLAL_EINVAL, "Block at index %" LAL_UINT8_FORMAT " has not been dispensed", block_index );
+  XLAL_CHECK( !disp->blocks[b].finished, XLAL_EINVAL, "Block at index %" LAL_UINT8_FORMAT " has already been finished", block_index );
+
+  // Mark block as finished
+  disp->blocks[b].finished = true;
+  disp->nfinished += disp->blocks[b].count;
+
+  // Retire finished blocks from the front of the dispensed block array; the iterator
+  // state before the first remaining block is then the earliest unfinished state
+  size_t nretire = 0;
+  while ( nretire < disp->nblocks && disp->blocks[nretire].finished ) {
+    disp->spare[disp->nspare++] = disp->blocks[nretire].start;
+    ++nretire;
+  }
+  if ( nretire > 0 ) {
+    disp->nblocks -= nretire;
+    memmove( &disp->blocks[0], &disp->blocks[nretire], disp->nblocks * sizeof( disp->blocks[0] ) );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+LatticeTilingDispenser *XLALCreateLatticeTilingDispenser(
+  const LatticeTiling *tiling,
+  const size_t itr_ndim,
+  const bool alternating,
+  const UINT4 nworkers,
+  const UINT4 min_block_size
+  )
+{
+
+  // Check input
+  XLAL_CHECK_NULL( tiling != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( nworkers > 0, XLAL_EINVAL );
+  XLAL_CHECK_NULL( min_block_size > 0, XLAL_EINVAL );
+
+  // Allocate memory
+  LatticeTilingDispenser *disp = XLALCalloc( 1, sizeof( *disp ) );
+  XLAL_CHECK_NULL( disp != NULL, XLAL_ENOMEM );
+
+  // Set fields
+  disp->nworkers = nworkers;
+  disp->min_block_size = min_block_size;
+
+  // Create iterator which generates dispensed points
+  disp->itr = XLALCreateLatticeTilingIterator( tiling, itr_ndim );
+  XLAL_CHECK_NULL( disp->itr != NULL, XLAL_EFUNC );
+  XLAL_CHECK_NULL( XLALSetLatticeTilingAlternatingIterator( disp->itr, alternating ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Count total number of points; this also performs any lattice tiling callbacks,
+  // which are not thread-safe, before the dispenser is used by multiple threads
+  disp->total = XLALTotalLatticeTilingPoints( disp->itr );
+  XLAL_CHECK_NULL( disp->total > 0, XLAL_EFUNC );
+
+#ifdef HAVE_PTHREAD
+  // Initialise lock
+  XLAL_CHECK_NULL( pthread_mutex_init( &disp->lock, NULL ) == 0, XLAL_ESYS );
+#endif
+
+  return disp;
+
+}
+
+void XLALDestroyLatticeTilingDispenser(
+  LatticeTilingDispenser *disp
+  )
+{
+  if ( disp ) {
+    XLALDestroyLatticeTilingIterator( disp->itr );
+    for ( size_t b = 0; b < disp->nblocks; ++b ) {
+      XLALDestroyLatticeTilingIterator( disp->blocks[b].start );
+    }
+    XLALFree( disp->blocks );
+    for ( size_t k = 0; k < disp->nspare; ++k ) {
+      XLALDestroyLatticeTilingIterator( disp->spare[k] );
+    }
+    XLALFree( disp->spare );
+    XLALFree( disp->skip );
+#ifdef HAVE_PTHREAD
+    pthread_mutex_destroy( &disp->lock );
+#endif
+    XLALFree( disp );
+  }
+}
+
+int XLALNextLatticeTilingDispenserBlock(
+  LatticeTilingDispenser *disp,
+  gsl_matrix *points,
+  UINT8 *block_index
+  )
+{
+
+  // Check input
+  XLAL_CHECK( disp != NULL, XLAL_EFAULT );
+  XLAL_CHECK( points != NULL, XLAL_EFAULT );
+  XLAL_CHECK( points->size1 == disp->itr->tiling->ndim, XLAL_EINVAL );
+  XLAL_CHECK( block_index != NULL, XLAL_EFAULT );
+
+  // Dispense next block of points
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock( &disp->lock );
+#endif
+  const int retn = LT_DispenseBlock( disp, points, block_index );
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock( &disp->lock );
+#endif
+  XLAL_CHECK( retn >= 0, XLAL_EFUNC );
+
+  return retn;
+
+}
+
+int XLALFinishLatticeTilingDispenserBlock(
+  LatticeTilingDispenser *disp,
+  const UINT8 block_index
+  )
+{
+
+  // Check input
+  XLAL_CHECK( disp != NULL, XLAL_EFAULT );
+
+  // Mark block as finished
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock( &disp->lock );
+#endif
+  const int retn = LT_FinishBlock( disp, block_index );
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock( &disp->lock );
+#endif
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+UINT8 XLALTotalLatticeTilingDispenserPoints(
+  const LatticeTilingDispenser *disp
+  )
+{
+
+  // Check input
+  XLAL_CHECK_VAL( 0, disp != NULL, XLAL_EFAULT );
+
+  return disp->total;
+
+}
+
+UINT8 XLALFinishedLatticeTilingDispenserPoints(
+  LatticeTilingDispenser *disp
+  )
+{
+
+  // Check input
+  XLAL_CHECK_VAL( 0, disp != NULL, XLAL_EFAULT );
+
+  // Get number of points in finished blocks
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock( &disp->lock );
+#endif
+  const UINT8 nfinished = disp->nfinished;
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock( &disp->lock );
+#endif
+
+  return nfinished;
+
+}
+
+///
+/// Save the state of a lattice tiling dispenser to a FITS file. Must be called with the dispenser locked.
+///
+static int LT_SaveDispenser(
+  const LatticeTilingDispenser *disp,   ///< [in] Lattice tiling dispenser
+  FITSFile *file,                       ///< [in] FITS file to save dispenser to
+  const char *name                      ///< [in] FITS HDU to save dispenser to
+  )
+{
+
+  // The saved iterator state is that before the first unfinished dispensed block, if any;
+  // otherwise it is the current iterator state
+  const LatticeTilingIterator *itr = ( disp->nblocks > 0 ) ? disp->blocks[0].start : disp->itr;
+
+  // Open FITS table for writing
+  XLAL_CHECK( XLALFITSTableOpenWrite( file, name, "serialised lattice tiling dispenser" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( LT_InitFITSBlockRecordTable( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Write FITS records to table for finished blocks after the saved iterator state
+  // - Dispensed blocks all precede blocks still to be skipped, so records are written in order of index
+  for ( size_t b = 0; b < disp->nblocks; ++b ) {
+    if ( disp->blocks[b].finished ) {
+      LT_FITSBlockRecord XLAL_INIT_DECL( record );
+      record.first = disp->blocks[b].first;
+      record.count = disp->blocks[b].count;
+      XLAL_CHECK( XLALFITSTableWriteRow( file, &record ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+  for ( size_t k = 0; k < disp->nskip; ++k ) {
+    XLAL_CHECK( XLALFITSTableWriteRow( file, &disp->skip[k] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Write dispenser properties
+  {
+    UINT8 count = disp->total;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "count", count, "total number of lattice tiling points" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT8 nfinished = disp->nfinished;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT8( file, "finished", nfinished, "number of points in finished blocks" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } {
+    UINT4 state = itr->state;
+    XLAL_CHECK( XLALFITSHeaderWriteUINT4( file, "state", state, "iterator state" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  // Save iterator, unless it is at its initialised or finished state
+  if ( itr->state == 1 ) {
+    char itr_name[256];
+    XLAL_CHECK( snprintf( itr_name, sizeof( itr_name ), "%s_itr", name ) < ( int ) sizeof( itr_name ), XLAL_EINVAL );
+    XLAL_CHECK( XLALSaveLatticeTilingIterator( itr, file, itr_name ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALSaveLatticeTilingDispenser(
+  LatticeTilingDispenser *disp,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK( disp != NULL, XLAL_EFAULT );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( name != NULL, XLAL_EFAULT );
+
+  // Save dispenser
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock( &disp->lock );
+#endif
+  const int retn = LT_SaveDispenser( disp, file, name );
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock( &disp->lock );
+#endif
+  XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+}
+
+int XLALRestoreLatticeTilingDispenser(
+  LatticeTilingDispenser *disp,
+  FITSFile *file,
+  const char *name
+  )
+{
+
+  // Check input
+  XLAL_CHECK( disp != NULL, XLAL_EFAULT );
+  XLAL_CHECK( file != NULL, XLAL_EFAULT );
+  XLAL_CHECK( name != NULL, XLAL_EFAULT );
+  XLAL_CHECK( disp->itr->state == 0 && disp->nblocks == 0 && disp->nskip == 0, XLAL_EINVAL, "Dispenser must not have dispensed any blocks" );
+
+  // Open FITS table for reading
+  UINT8 nrows = 0;
+  XLAL_CHECK( XLALFITSTableOpenRead( file, name, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( LT_InitFITSBlockRecordTable( file ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Read and check dispenser properties
+  UINT4 state = 0;
+  {
+    UINT8 count;
+    XLAL_CHECK( XLALFITSHeaderReadUINT8( file, "count", &count ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( count == disp->total, XLAL_EIO, "Could not restore dispenser; invalid HDU '%s'", name );
+  } {
+    UINT8 nfinished;
+    XLAL_CHECK( XLALFITSHeaderReadUINT8( file, "finished", &nfinished ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( nfinished <= disp->total, XLAL_EIO, "Could not restore dispenser; invalid HDU '%s'", name );
+    disp->nfinished = nfinished;
+  } {
+    XLAL_CHECK( XLALFITSHeaderReadUINT4( file, "state", &state ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( state <= 2, XLAL_EIO, "Could not restore dispenser; invalid HDU '%s'", name );
+  }
+
+  // Read FITS records from table for finished blocks to skip
+  if ( nrows > 0 ) {
+    disp->skip = XLALRealloc( disp->skip, nrows * sizeof( disp->skip[0] ) );
+    XLAL_CHECK( disp->skip != NULL, XLAL_ENOMEM );
+    while ( nrows > 0 ) {
+      LT_FITSBlockRecord *record = &disp->skip[disp->nskip];
+      XLAL_CHECK( XLALFITSTableReadRow( file, record, &nrows ) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( record->count > 0 && record->first + record->count <= disp->total, XLAL_EIO, "Could not restore dispenser; invalid HDU '%s'", name );
+      XLAL_CHECK( disp->nskip == 0 || disp->skip[disp->nskip - 1].first + disp->skip[disp->nskip - 1].count <= record->first, XLAL_EIO, "Could not restore dispenser; invalid HDU '%s'", name );
+      ++disp->nskip;
+    }
+  }
+
+  // Restore iterator
+  if ( state == 1 ) {
+    char itr_name[256];
+    XLAL_CHECK( snprintf( itr_name, sizeof( itr_name ), "%s_itr", name ) < ( int ) sizeof( itr_name ), XLAL_EINVAL );
+    XLAL_CHECK( XLALRestoreLatticeTilingIterator( disp->itr, file, itr_name ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    disp->itr->state = state;
+  }
+
+  return XLAL_SUCCESS;
+
+}
+
 LatticeTilingLocator *XLALCreateLatticeTilingLocator(
   const LatticeTiling *tiling
   )
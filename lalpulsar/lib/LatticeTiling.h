@@ -52,6 +52,11 @@ typedef struct tagLatticeTiling LatticeTiling;
 ///
 typedef struct tagLatticeTilingIterator LatticeTilingIterator;
 
+///
+/// Dispenses blocks of points in a lattice tiling to multiple workers.
+///
+typedef struct tagLatticeTilingDispenser LatticeTilingDispenser;
+
 ///
 /// Locates the nearest point in a lattice tiling.
 ///
@@ -445,6 +450,94 @@ int XLALRestoreLatticeTilingIterator(
   const char *name                      ///< [in] FITS HDU to restore iterator from
   );
 
+///
+/// Create a new lattice tiling dispenser. A dispenser hands out disjoint blocks of contiguous points,
+/// in the order generated by a lattice tiling iterator over \c itr_ndim dimensions, to any number
+/// of workers, which may call XLALNextLatticeTilingDispenserBlock() and
+/// XLALFinishLatticeTilingDispenserBlock() concurrently from multiple threads. The size of blocks
+/// decreases as the number of remaining points decreases, to balance the load between \c nworkers
+/// workers, down to a minimum of \c min_block_size points.
+///
+#ifdef SWIG // SWIG interface directives
+SWIGLAL( RETURN_OWNED_BY_1ST_ARG( int, XLALCreateLatticeTilingDispenser ) );
+#endif
+LatticeTilingDispenser *XLALCreateLatticeTilingDispenser(
+  const LatticeTiling *tiling,          ///< [in] Lattice tiling
+  const size_t itr_ndim,                ///< [in] Number of parameter-space dimensions to iterate over
+  const bool alternating,               ///< [in] If true, alternate iterator direction after every crossing
+  const UINT4 nworkers,                 ///< [in] Number of workers expected to pull blocks
+  const UINT4 min_block_size            ///< [in] Minimum number of points in a dispensed block
+  );
+
+///
+/// Destroy a lattice tiling dispenser.
+///
+void XLALDestroyLatticeTilingDispenser(
+  LatticeTilingDispenser *disp          ///< [in] Lattice tiling dispenser
+  );
+
+///
+/// Dispense the next block of points from a lattice tiling dispenser. The number of points in the
+/// block is at most the number of columns of \c points; the first columns of \c points are filled
+/// with the points in the block. The index of the first point in the block, which identifies the
+/// block, is returned in \c block_index. Returns the number of points in the block if there are
+/// points remaining, 0 if there are no more points, and XLAL_FAILURE on error.
+///
+#ifdef SWIG // SWIG interface directives
+SWIGLAL( RETURN_VALUE( int, XLALNextLatticeTilingDispenserBlock ) );
+#endif
+int XLALNextLatticeTilingDispenserBlock(
+  LatticeTilingDispenser *disp,         ///< [in] Lattice tiling dispenser
+  gsl_matrix *points,                   ///< [out] Columns are points in block
+  UINT8 *block_index                    ///< [out] Index of first point in block
+  );
+
+///
+/// Mark a block of points dispensed by a lattice tiling dispenser as finished. Only finished
+/// blocks are recorded as such when saving the state of the dispenser; other dispensed blocks will
+/// be dispensed again after the dispenser is restored.
+///
+int XLALFinishLatticeTilingDispenserBlock(
+  LatticeTilingDispenser *disp,         ///< [in] Lattice tiling dispenser
+  const UINT8 block_index               ///< [in] Index of first point in block
+  );
+
+///
+/// Return the total number of points dispensed by a lattice tiling dispenser.
+///
+UINT8 XLALTotalLatticeTilingDispenserPoints(
+  const LatticeTilingDispenser *disp    ///< [in] Lattice tiling dispenser
+  );
+
+///
+/// Return the number of points in blocks which have been finished.
+///
+UINT8 XLALFinishedLatticeTilingDispenserPoints(
+  LatticeTilingDispenser *disp          ///< [in] Lattice tiling dispenser
+  );
+
+///
+/// Save the state of a lattice tiling dispenser to a FITS file. The state of the dispenser's
+/// iterator before the first unfinished block is saved to HDU <tt>name_itr</tt>, if required,
+/// together with any finished blocks which follow it.
+///
+int XLALSaveLatticeTilingDispenser(
+  LatticeTilingDispenser *disp,         ///< [in] Lattice tiling dispenser
+  FITSFile *file,                       ///< [in] FITS file to save dispenser to
+  const char *name                      ///< [in] FITS HDU to save dispenser to
+  );
+
+///
+/// Restore the state of a lattice tiling dispenser from a FITS file. The dispenser must not have
+/// dispensed any blocks. Blocks which were finished when the dispenser was saved will not be
+/// dispensed again.
+///
+int XLALRestoreLatticeTilingDispenser(
+  LatticeTilingDispenser *disp,         ///< [in] Lattice tiling dispenser
+  FITSFile *file,                       ///< [in] FITS file to restore dispenser from
+  const char *name                      ///< [in] FITS HDU to restore dispenser from
+  );
+
 ///
 /// Create a new lattice tiling locator. If there are tiled dimensions, an index trie is internally built.
 ///
@@ -35,6 +35,7 @@
  */
 
 /*---------- INCLUDES ----------*/
+#include <config.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
@@ -48,9 +49,20 @@
 #include <io.h>
 #endif
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
 #include <lal/LALStdio.h>
 #include <lal/LALString.h>
 #include <lal/FileIO.h>
+#include <lal/H5FileIO.h>
 #include <lal/SFTfileIO.h>
 #include <lal/StringVector.h>
 #include <lal/Sequence.h>
@@ -75,6 +87,14 @@
 #define SFTFILEIO_REALLOC_BLOCKSIZE 100
 #endif
 
+/** identifiers of SFT catalog index files written by XLALWriteSFTCatalogIndex() */
+#define SFT_INDEX_MAGIC "LALSFTIX"
+#define SFT_INDEX_VERSION 2
+#define SFT_INDEX_ENDIAN 0x01020304
+
+/** version of band-chunked HDF5 SFT containers written by XLALWriteSFTVector2H5File() */
+#define SFT_H5_CONTAINER_VERSION 1
+
 /*----- Macros ----- */
 
 #define GPS2REAL8(gps) (1.0 * (gps).gpsSeconds + 1.e-9 * (gps).gpsNanoSeconds )
@@ -93,6 +113,22 @@ struct tagSFTLocator
   CHAR *fname;		/* name of file containing this SFT */
   long offset;		/* SFT-offset with respect to a merged-SFT */
   UINT4 isft;           /* index of SFT this locator belongs to, used only in XLALLoadSFTs() */
+  BOOLEAN h5;		/* SFT is in a band-chunked HDF5 SFT container; 'offset' is its index in the container */
+};
+
+/* a single memory-mapped SFT file */
+typedef struct
+{
+  CHAR *fname;		/* name of mapped file */
+  char *addr;		/* start address of mapping */
+  size_t len;		/* length of mapping */
+} SFTMappedFile;
+
+/* memory mapping of the SFT files referenced by a catalog, sorted by file name */
+struct tagSFTFileMap
+{
+  UINT4 length;		/* number of mapped files */
+  SFTMappedFile *data;	/* array of mapped files */
 };
 
 typedef struct
@@ -127,6 +163,15 @@ typedef struct {
   struct tagSFTLocator *lastfrom;  /**< last bin read from this locator */
 } SFTReadSegment;
 
+/** band of SFT data read from a band-chunked HDF5 SFT container */
+typedef struct {
+  CHAR *fname;                     /**< name of container file */
+  UINT4 numSFTs;                   /**< number of SFTs in container */
+  UINT4 firstBin;                  /**< first bin read */
+  UINT4 numBins;                   /**< number of bins read (0 if none) */
+  COMPLEX8 *data;                  /**< SFT data, numSFTs x numBins */
+} SFTH5Band;
+
 /*---------- Global variables ----------*/
 static REAL8 fudge_up   = 1 + 10 * LAL_REAL8_EPS;	// about ~1 + 2e-15
 static REAL8 fudge_down = 1 - 10 * LAL_REAL8_EPS;	// about ~1 - 2e-15
@@ -139,6 +184,16 @@ static BOOLEAN is_pattern(const char*c); /* filename string is a glob-style patt
 
 static BOOLEAN consistent_mSFT_header ( SFTtype header1, UINT4 version1, UINT4 nsamples1, SFTtype header2, UINT4 version2, UINT4 nsamples2 );
 static BOOLEAN timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list );
+static BOOLEAN want_SFT_block ( SFTtype *header, const SFTConstraints *constraints );
+static int read_SFT_catalog_index ( SFTCatalog *catalog, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints );
+static int read_SFT_catalog_index_fp ( SFTCatalog *catalog, UINT4 *numSFTs, FILE *fp, const SFTConstraints *constraints );
+static int write_SFT_catalog_index_fp ( const SFTCatalog *catalog, FILE *fp );
+
+static BOOLEAN is_H5_file ( FILE *fp );
+static int read_H5_SFT_container_info ( LALH5File *file, CHAR name[3], REAL8 *deltaF, UINT4 *firstBin, UINT4 *numBins, UINT4 *chunkBins, UINT4 *numSFTs,
+                                        CHAR **comment, INT4Vector **gps_seconds, INT4Vector **gps_nanoseconds );
+static int read_H5_SFT_descriptors ( SFTCatalog *catalog, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints );
+static int read_H5_SFT_band ( SFTH5Band *band, const CHAR *fname, UINT4 firstBin2read, UINT4 lastBin2read );
 static long get_file_len ( FILE *fp );
 
 static FILE * fopen_SFTLocator ( const struct tagSFTLocator *locator );
@@ -151,6 +206,7 @@ static int read_v1_header_from_fp ( FILE *fp, SFTtype *header, UINT4 *nsamples,
 int compareSFTdesc(const void *ptr1, const void *ptr2);
 static int compareSFTloc(const void *ptr1, const void *ptr2);
 static int compareDetNameCatalogs ( const void *ptr1, const void *ptr2 );
+static int compareSFTMappedFiles ( const void *ptr1, const void *ptr2 );
 
 static UINT8 calc_crc64(const CHAR *data, UINT4 length, UINT8 crc);
 static BOOLEAN has_valid_v2_crc64 (FILE *fp );
@@ -230,6 +286,9 @@ UINT4 XLALRoundFrequencyUpToSFTBin( const REAL8 freq, const REAL8 df )
  *
  * The returned SFTs in the catalogue are sorted by increasing GPS-epochs !
  *
+ * If \a file_pattern is of the form <tt>"index:<index-file>"</tt>, the SFT descriptors are read from
+ * an index file written by XLALWriteSFTCatalogIndex(), instead of from the SFT files themselves.
+ *
  */
 SFTCatalog *
 XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
@@ -251,12 +310,27 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
   SFTCatalog *ret;
   XLAL_CHECK_NULL ( (ret = LALCalloc ( 1, sizeof (*ret) )) != NULL, XLAL_ENOMEM );
 
-  /* find matching filenames */
-  LALStringVector *fnames;
-  XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
-  UINT4 numFiles = fnames->length;
-
+  /* find matching filenames, or read SFT descriptors from an index file */
+  LALStringVector *fnames = NULL;
+  UINT4 numFiles = 0;
   UINT4 numSFTs = 0;
+#define INDEX_PREFIX "index:"
+  if ( strncmp ( file_pattern, INDEX_PREFIX, strlen(INDEX_PREFIX) ) == 0 )
+    {
+      const CHAR *index_fname = file_pattern + strlen(INDEX_PREFIX);
+      if ( read_SFT_catalog_index ( ret, &numSFTs, index_fname, constraints ) != XLAL_SUCCESS )
+        {
+          XLALDestroySFTCatalog ( ret );
+          XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to read SFT catalog index '%s'.\n\n", index_fname );
+        }
+    }
+  else
+    {
+      XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
+      numFiles = fnames->length;
+    }
+#undef INDEX_PREFIX
+
   /* ----- main loop: parse all matching files */
   for ( UINT4 i = 0; i < numFiles; i ++ )
     {
@@ -277,6 +351,19 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
 	  XLAL_ERROR_NULL ( XLAL_EIO );
 	}
 
+      /* band-chunked HDF5 SFT containers are described by their attributes */
+      if ( is_H5_file ( fp ) )
+        {
+          fclose(fp);
+          if ( read_H5_SFT_descriptors ( ret, &numSFTs, fname, constraints ) != XLAL_SUCCESS )
+            {
+              XLALDestroyStringVector ( fnames );
+              XLALDestroySFTCatalog ( ret );
+              XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to read SFT container '%s'\n\n", fname );
+            }
+          continue;
+        }
+
       long file_len;
       if ( (file_len = get_file_len(fp)) == 0 )
 	{
@@ -336,30 +423,8 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
 	  mprev_version = this_version;
 	  mprev_nsamples = this_nsamples;
 
-	  want_this_block = TRUE;	/* default */
-	  /* but does this SFT-block satisfy the user-constraints ? */
-	  if ( constraints )
-	    {
-	      if ( constraints->detector && strncmp(constraints->detector, "??", 2) )
-		{
-		  /* v1-SFTs have '??' as detector-name */
-		  if ( ! strncmp (this_header.name, "??", 2 ) ) {
-		    strncpy ( this_header.name, constraints->detector, 2 );	/* SET to constraint! */
-                  }
-		  else if ( strncmp( constraints->detector, this_header.name, 2) ) {
-		    want_this_block = FALSE;
-                  }
-		}
-
-	      if ( XLALCWGPSinRange(this_header.epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
-		want_this_block = FALSE;
-              }
-
-	      if ( constraints->timestamps && !timestamp_in_list(this_header.epoch, constraints->timestamps) ) {
-		want_this_block = FALSE;
-              }
-
-	    } /* if constraints */
+	  /* does this SFT-block satisfy the user-constraints ? */
+	  want_this_block = want_SFT_block ( &this_header, constraints );
 
 	  if ( want_this_block )
 	    {
@@ -521,6 +586,37 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
 } /* XLALSFTdataFind() */
 
 
+/**
+ * Write an index of the SFTs described by an ::SFTCatalog to a file.
+ *
+ * The index stores the locators, headers, comments and checksums of all SFTs in the catalog,
+ * and can be read back with <tt>XLALSFTdataFind("index:<fname>", constraints)</tt>, which
+ * avoids opening and reading the headers of every SFT file. The index is written in
+ * native byte order, and can only be read back on machines with the same endianness.
+ *
+ * Note: the index must be regenerated if any of the indexed SFT files change.
+ */
+int
+XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog,	/**< [in] catalog of SFTs to index */
+                           const CHAR *fname		/**< [in] name of index file to write */
+                           )
+{
+  XLAL_CHECK ( catalog != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( catalog->length == 0 || catalog->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( fname != NULL, XLAL_EINVAL );
+
+  FILE *fp;
+  XLAL_CHECK ( (fp = fopen ( fname, "wb" )) != NULL, XLAL_EIO, "Failed to open '%s' for writing: %s\n\n", fname, strerror(errno) );
+
+  int retn = write_SFT_catalog_index_fp ( catalog, fp );
+  fclose ( fp );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC, "Failed to write SFT catalog index '%s'\n\n", fname );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteSFTCatalogIndex() */
+
+
 /*
    This function reads an SFT (segment) from an open file pointer into a buffer.
    firstBin2read specifies the first bin to read from the SFT, lastBin2read is the last bin.
@@ -704,21 +800,27 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
   UINT4 nSFTs = 1;                 /**< number of SFTs, i.e. different GPS timestamps */
   REAL8 deltaF;                    /**< frequency spacing of SFT */
   SFTCatalog locatalog;            /**< local copy of the catalog to be sorted by 'locator' */
+  struct tagSFTLocator*locators = NULL; /**< local copy of the locators of the catalog */
   SFTVector* sftVector = NULL;     /**< the vector of SFTs to be returned */
   SFTReadSegment*segments = NULL;  /**< array of segments already read of an SFT */
   char empty = '\0';               /**< empty string */
   char* fname = &empty;            /**< name of currently open file, initially "" */
   FILE* fp = NULL;                 /**< open file */
   SFTtype* thisSFT = NULL;         /**< SFT to read from file */
+  SFTH5Band h5band;                /**< band read from current HDF5 SFT container */
 
   /* error handler: free memory and return with error */
 #define XLALLOADSFTSERROR(eno)	{		\
     if(fp)					\
       fclose(fp);				\
+    XLALFree(h5band.fname);			\
+    XLALFree(h5band.data);			\
     if(segments) 				\
       XLALFree(segments);			\
     if(locatalog.data)				\
       XLALFree(locatalog.data);			\
+    if(locators)				\
+      XLALFree(locators);			\
     if(thisSFT)					\
       XLALDestroySFT(thisSFT);			\
     if(sftVector)				\
@@ -726,13 +828,23 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
     XLAL_ERROR_NULL(eno);	                \
   }
 
-  /* initialize locatalog.data so it doesn't get free()d on early error */
+  /* initialize locatalog.data and h5band so they don't get free()d on early error */
   locatalog.data = NULL;
+  memset(&h5band, 0, sizeof(h5band));
 
   /* check function parameters */
   if(!catalog)
     XLALLOADSFTSERROR(XLAL_EINVAL);
 
+  /* make a local copy of the locators, so that the catalog itself is not modified
+     below, and different catalogs sharing locators can be loaded concurrently */
+  if(!(locators = XLALMalloc(catalog->length * sizeof(locators[0])))) {
+    XLALPrintError("ERROR: Couldn't allocate locators\n");
+    XLALLOADSFTSERROR(XLAL_ENOMEM);
+  }
+  for(catPos = 0; catPos < catalog->length; catPos++)
+    locators[catPos] = *catalog->data[catPos].locator;
+
   /* determine number of SFTs, i.e. number of different GPS timestamps.
      The catalog should be sorted by GPS time, so just count changes.
      Record the 'index' of GPS time in the 'isft' field of the locator,
@@ -741,7 +853,7 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
      while at it, record max and min bin of all SFTs in the catalog */
 
   LIGOTimeGPS epoch = catalog->data[0].header.epoch;
-  catalog->data[0].locator->isft = nSFTs - 1;
+  locators[0].isft = nSFTs - 1;
   deltaF = catalog->data[0].header.deltaF; /* Hz/bin */
   minbin = firstbin = lround ( catalog->data[0].header.f0 / deltaF );
   maxbin = lastbin = firstbin + catalog->data[0].numBins - 1;
@@ -756,7 +868,7 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
       epoch = catalog->data[catPos].header.epoch;
       nSFTs++;
     }
-    catalog->data[catPos].locator->isft = nSFTs - 1;
+    locators[catPos].isft = nSFTs - 1;
   }
   XLALPrintInfo("%s: fMin: %f, fMax: %f, deltaF: %f, minbin: %u, maxbin: %u\n", __func__, fMin, fMax, deltaF, minbin, maxbin);
 
@@ -799,6 +911,8 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
       XLALLOADSFTSERROR(XLAL_ENOMEM);
     }
     memcpy(locatalog.data, catalog->data, size);
+    for(catPos = 0; catPos < catalog->length; catPos++)
+      locatalog.data[catPos].locator = &locators[catPos];
   }
 
   /* sort catalog by f0, locator */
@@ -864,6 +978,43 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
 	lastBinRead = 0;
       }
 
+    } else if (locator->h5) {
+      /* SFT data is in a band-chunked HDF5 SFT container:
+	 read the band for all SFTs in the container only when reading a different container */
+
+      if(!h5band.fname || strcmp(h5band.fname, locator->fname)) {
+	XLALPrintInfo("%s: Reading bins %u - %u from SFT container '%s'\n", __func__, firstbin, lastbin, locator->fname);
+	if(read_H5_SFT_band(&h5band, locator->fname, firstbin, lastbin) != XLAL_SUCCESS) {
+	  XLALPrintError("ERROR: Couldn't read SFT container '%s'\n", locator->fname);
+	  XLALLOADSFTSERROR(XLAL_EIO);
+	}
+      }
+      if(locator->offset < 0 || (UINT4)locator->offset >= h5band.numSFTs) {
+	XLALPrintError("ERROR: Invalid SFT index %ld in SFT container '%s'\n", locator->offset, locator->fname);
+	XLALLOADSFTSERROR(XLAL_EIO);
+      }
+
+      /* keep a copy of the data pointer */
+      COMPLEX8Sequence*data = thisSFT->data;
+
+      /* copy the header */
+      *thisSFT = locatalog.data[catPos].header;
+      /* restore data pointer */
+      thisSFT->data = data;
+
+      if (h5band.numBins > 0) {
+	firstBinRead = h5band.firstBin;
+	lastBinRead = h5band.firstBin + h5band.numBins - 1;
+	memcpy(thisSFT->data->data,
+	       h5band.data + (size_t)locator->offset * h5band.numBins,
+	       h5band.numBins * sizeof(COMPLEX8));
+	thisSFT->f0 = 1.0 * firstBinRead * thisSFT->deltaF;
+      } else {
+	/* no data was needed from this SFT (segment) */
+	firstBinRead = 0;
+	lastBinRead = 0;
+      }
+
     } else {
       /* SFT data had not yet been read - read it */
 
@@ -969,6 +1120,8 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
     fclose(fp);
     fp = NULL;
   }
+  XLALFree(h5band.fname);
+  XLALFree(h5band.data);
 
   /* check that all SFTs are complete */
   for(UINT4 isft = 0; isft < nSFTs; isft++) {
@@ -993,6 +1146,7 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
   /* cleanup  */
   XLALFree(segments);
   XLALFree(locatalog.data);
+  XLALFree(locators);
   XLALDestroySFT(thisSFT);
 
   return(sftVector);
@@ -1082,6 +1236,721 @@ XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView,/**< The
 } // XLALLoadMultiSFTsFromView()
 
 
+/**
+ * This function loads a MultiSFTVector from a given input MultiSFTCatalogView, reading SFT files
+ * concurrently using up to \a numThreads threads; otherwise the documentation of XLALLoadMultiSFTsFromView()
+ * applies, and the returned SFTs are identical.
+ *
+ * The SFTs of each detector are divided into groups of consecutive timestamps which are read from the same
+ * file(s), and each group is loaded by one thread with XLALLoadSFTs(). Groups are limited in size so that
+ * SFTs from a single merged SFT file are also read concurrently. If \a numThreads <= 1, or if compiled
+ * without OpenMP, the SFTs are loaded serially.
+ */
+MultiSFTVector *
+XLALLoadMultiSFTsFromViewParallel ( const MultiSFTCatalogView *multiCatalogView,/**< The multi-SFT catalogue view of SFTs to load */
+                                    REAL8 fMin,		             		/**< minumum requested frequency (-1 = read from lowest) */
+                                    REAL8 fMax,		             		/**< maximum requested frequency (-1 = read up to highest) */
+                                    UINT4 numThreads				/**< maximum number of threads used to read SFT files */
+                                    )
+{
+  XLAL_CHECK_NULL ( multiCatalogView != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( multiCatalogView->length != 0, XLAL_EINVAL );
+
+#ifndef _OPENMP
+  numThreads = 1;
+#endif
+  if ( numThreads <= 1 ) {
+    return XLALLoadMultiSFTsFromView ( multiCatalogView, fMin, fMax );
+  }
+
+  const UINT4 numIFOs = multiCatalogView->length;
+
+  /* a group of consecutive SFT timestamps of one detector, loaded by one thread */
+  typedef struct {
+    UINT4 X;			/* detector index */
+    SFTCatalog catalog;		/* view of the catalog entries of this group */
+    REAL8 fMin, fMax;		/* frequency band to load */
+    SFTVector *sfts;		/* loaded SFTs */
+  } SFTLoadGroup;
+
+  UINT4 numGroups = 0, maxGroups = 0;
+  for ( UINT4 X = 0; X < numIFOs; X++ ) {
+    XLAL_CHECK_NULL ( multiCatalogView->data[X].length != 0, XLAL_EINVAL );
+    maxGroups += multiCatalogView->data[X].length;
+  }
+
+  MultiSFTVector *multiSFTs = NULL;
+  SFTLoadGroup *groups = NULL;
+  XLAL_CHECK_NULL ( (groups = XLALCalloc ( maxGroups, sizeof(*groups) )) != NULL, XLAL_ENOMEM );
+
+  for ( UINT4 X = 0; X < numIFOs; X++ )
+    {
+      const SFTCatalog *catalog = &multiCatalogView->data[X];
+
+      /* resolve open frequency bounds over all SFTs of this detector, so that all groups load the same band */
+      const REAL8 deltaF = catalog->data[0].header.deltaF;
+      UINT4 minbin = lround ( catalog->data[0].header.f0 / deltaF );
+      UINT4 maxbin = minbin + catalog->data[0].numBins - 1;
+      UINT4 numSFTs = 1;
+      for ( UINT4 i = 1; i < catalog->length; i ++ )
+        {
+          const UINT4 firstbin = lround ( catalog->data[i].header.f0 / deltaF );
+          const UINT4 lastbin = firstbin + catalog->data[i].numBins - 1;
+          minbin = ( firstbin < minbin ) ? firstbin : minbin;
+          maxbin = ( lastbin > maxbin ) ? lastbin : maxbin;
+          if ( !GPSEQUAL ( catalog->data[i].header.epoch, catalog->data[i-1].header.epoch ) ) {
+            ++numSFTs;
+          }
+        }
+      const REAL8 fMinX = ( fMin < 0 ) ? minbin * deltaF : fMin;
+      const REAL8 fMaxX = ( fMax < 0 ) ? maxbin * deltaF : fMax;
+
+      /* limit the number of timestamps per group, to balance the load over the threads */
+      const UINT4 maxGroupSFTs = ( numSFTs + 4*numThreads - 1 ) / ( 4*numThreads );
+
+      /* start a new group at a change of timestamp, if either the file changes or the group is full */
+      UINT4 groupSFTs = 0;
+      for ( UINT4 i = 0; i < catalog->length; i ++ )
+        {
+          const BOOLEAN new_epoch = ( i == 0 ) || !GPSEQUAL ( catalog->data[i].header.epoch, catalog->data[i-1].header.epoch );
+          if ( new_epoch )
+            {
+              if ( i == 0 || groupSFTs == maxGroupSFTs || strcmp ( catalog->data[i].locator->fname, catalog->data[i-1].locator->fname ) != 0 )
+                {
+                  SFTLoadGroup *group = &groups[numGroups++];
+                  group->X = X;
+                  group->catalog.data = &catalog->data[i];
+                  group->fMin = fMinX;
+                  group->fMax = fMaxX;
+                  groupSFTs = 0;
+                }
+              ++groupSFTs;
+            }
+          ++groups[numGroups - 1].catalog.length;
+        }
+
+    } // for X < numIFOs
+
+  /* load the groups of SFTs concurrently */
+  int failed = 0;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic,1) reduction(|:failed)
+  for ( UINT4 g = 0; g < numGroups; g ++ )
+    {
+      groups[g].sfts = XLALLoadSFTs ( &groups[g].catalog, groups[g].fMin, groups[g].fMax );
+      failed |= ( groups[g].sfts == NULL );
+    }
+  XLAL_CHECK_FAIL ( !failed, XLAL_EFUNC, "Failed to XLALLoadSFTs() for some group of SFTs\n" );
+
+  /* create multi sft vector, and move the SFTs of each group into it */
+  XLAL_CHECK_FAIL ( (multiSFTs = XLALCalloc ( 1, sizeof(*multiSFTs) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (multiSFTs->data = XLALCalloc ( numIFOs, sizeof(*multiSFTs->data) )) != NULL, XLAL_ENOMEM );
+  multiSFTs->length = numIFOs;
+  for ( UINT4 g = 0; g < numGroups; g ++ )
+    {
+      SFTVector *sfts = multiSFTs->data[groups[g].X];
+      if ( sfts == NULL ) {
+        XLAL_CHECK_FAIL ( (sfts = multiSFTs->data[groups[g].X] = XLALCalloc ( 1, sizeof(*sfts) )) != NULL, XLAL_ENOMEM );
+      }
+      SFTtype *data = XLALRealloc ( sfts->data, ( sfts->length + groups[g].sfts->length ) * sizeof(sfts->data[0]) );
+      XLAL_CHECK_FAIL ( data != NULL, XLAL_ENOMEM );
+      memcpy ( &data[sfts->length], groups[g].sfts->data, groups[g].sfts->length * sizeof(data[0]) );
+      sfts->data = data;
+      sfts->length += groups[g].sfts->length;
+      groups[g].sfts->length = 0;	/* SFT data now owned by multiSFTs */
+      XLALDestroySFTVector ( groups[g].sfts );
+      groups[g].sfts = NULL;
+    }
+
+  XLALFree ( groups );
+
+  // return final multi-SFT vector
+  return multiSFTs;
+
+XLAL_FAIL:
+  for ( UINT4 g = 0; g < numGroups; g ++ ) {
+    XLALDestroySFTVector ( groups[g].sfts );
+  }
+  XLALFree ( groups );
+  XLALDestroyMultiSFTVector ( multiSFTs );
+  return NULL;
+
+} // XLALLoadMultiSFTsFromViewParallel()
+
+
+/** A request queued in an ::SFTPrefetcher */
+typedef struct tagSFTPrefetchRequest {
+  SFTCatalog catalog;				/**< catalog of SFTs to load; descriptors are not owned */
+  REAL8 fMin, fMax;				/**< frequency band to load */
+  MultiSFTVector *sfts;				/**< loaded SFTs, or NULL on error */
+  BOOLEAN done;					/**< have the SFTs been loaded? */
+  struct tagSFTPrefetchRequest *next;		/**< next request in the queue */
+} SFTPrefetchRequest;
+
+/** Background loader of SFTs */
+struct tagSFTPrefetcher {
+  UINT4 numThreads;				/**< number of threads used to load SFTs */
+  SFTPrefetchRequest *head;			/**< first request in the queue */
+  SFTPrefetchRequest *tail;			/**< last request in the queue */
+  SFTPrefetchRequest *pending;			/**< first request in the queue still to be loaded */
+#ifdef HAVE_PTHREAD
+  BOOLEAN running;				/**< has the background thread been started? */
+  BOOLEAN quit;					/**< should the background thread exit? */
+  pthread_t thread;				/**< background thread */
+  pthread_mutex_t lock;				/**< lock protecting the queue */
+  pthread_cond_t cond;				/**< signalled when the queue changes */
+#endif
+};
+
+/* load the SFTs of a prefetch request */
+static void
+load_SFT_prefetch_request ( SFTPrefetchRequest *req, UINT4 numThreads )
+{
+  MultiSFTCatalogView *view = XLALGetMultiSFTCatalogView ( &req->catalog );
+  if ( view != NULL ) {
+    req->sfts = XLALLoadMultiSFTsFromViewParallel ( view, req->fMin, req->fMax, numThreads );
+    XLALDestroyMultiSFTCatalogView ( view );
+  }
+  if ( req->sfts == NULL ) {
+    XLALPrintInfo ( "%s: failed to prefetch SFTs, will load them again when requested\n", __func__ );
+    XLALClearErrno();
+  }
+} /* load_SFT_prefetch_request() */
+
+#ifdef HAVE_PTHREAD
+/* background thread of an SFTPrefetcher: load queued requests in order */
+static void *
+SFT_prefetcher_thread ( void *arg )
+{
+  SFTPrefetcher *prefetcher = (SFTPrefetcher *) arg;
+  pthread_mutex_lock ( &prefetcher->lock );
+  while ( 1 )
+    {
+      while ( !prefetcher->quit && prefetcher->pending == NULL ) {
+        pthread_cond_wait ( &prefetcher->cond, &prefetcher->lock );
+      }
+      if ( prefetcher->quit ) {
+        break;
+      }
+      SFTPrefetchRequest *req = prefetcher->pending;
+      pthread_mutex_unlock ( &prefetcher->lock );
+      load_SFT_prefetch_request ( req, prefetcher->numThreads );
+      pthread_mutex_lock ( &prefetcher->lock );
+      req->done = TRUE;
+      prefetcher->pending = req->next;
+      pthread_cond_broadcast ( &prefetcher->cond );
+    }
+  pthread_mutex_unlock ( &prefetcher->lock );
+  return NULL;
+} /* SFT_prefetcher_thread() */
+#endif
+
+/*
+ * Restrict prefetched SFTs to the frequency bins XLALLoadSFTs() would read for [fMin, fMax];
+ * returns FALSE if the SFTs do not contain all of these bins.
+ */
+static BOOLEAN
+restrict_prefetched_SFTs ( MultiSFTVector *multiSFTs, REAL8 fMin, REAL8 fMax )
+{
+  if ( fMin < 0 || fMax < 0 ) {
+    return FALSE;
+  }
+  for ( UINT4 X = 0; X < multiSFTs->length; X ++ )
+    {
+      const SFTVector *sfts = multiSFTs->data[X];
+      for ( UINT4 i = 0; i < sfts->length; i ++ )
+        {
+          const REAL8 deltaF = sfts->data[i].deltaF;
+          const UINT4 firstbin = XLALRoundFrequencyDownToSFTBin ( fMin, deltaF );
+          const UINT4 lastbin = XLALRoundFrequencyUpToSFTBin ( fMax, deltaF );
+          const UINT4 firstSFTbin = lround ( sfts->data[i].f0 / deltaF );
+          if ( firstbin < firstSFTbin || lastbin >= firstSFTbin + sfts->data[i].data->length ) {
+            return FALSE;
+          }
+        }
+    }
+  for ( UINT4 X = 0; X < multiSFTs->length; X ++ )
+    {
+      SFTVector *sfts = multiSFTs->data[X];
+      for ( UINT4 i = 0; i < sfts->length; i ++ )
+        {
+          const REAL8 deltaF = sfts->data[i].deltaF;
+          const UINT4 firstbin = XLALRoundFrequencyDownToSFTBin ( fMin, deltaF );
+          const UINT4 lastbin = XLALRoundFrequencyUpToSFTBin ( fMax, deltaF );
+          const UINT4 firstSFTbin = lround ( sfts->data[i].f0 / deltaF );
+          memmove ( sfts->data[i].data->data, sfts->data[i].data->data + ( firstbin - firstSFTbin ), ( lastbin - firstbin + 1 ) * sizeof(COMPLEX8) );
+          sfts->data[i].data->length = lastbin - firstbin + 1;
+          sfts->data[i].f0 = 1.0 * firstbin * deltaF;
+        }
+    }
+  return TRUE;
+} /* restrict_prefetched_SFTs() */
+
+
+/**
+ * Create an ::SFTPrefetcher, which loads SFTs using up to \a numThreads threads.
+ */
+SFTPrefetcher *
+XLALCreateSFTPrefetcher ( UINT4 numThreads		/**< maximum number of threads used to read SFT files */
+                          )
+{
+  SFTPrefetcher *prefetcher = NULL;
+  XLAL_CHECK_NULL ( (prefetcher = XLALCalloc ( 1, sizeof(*prefetcher) )) != NULL, XLAL_ENOMEM );
+  prefetcher->numThreads = numThreads;
+#ifdef HAVE_PTHREAD
+  if ( pthread_mutex_init ( &prefetcher->lock, NULL ) != 0 ) {
+    XLALFree ( prefetcher );
+    XLAL_ERROR_NULL ( XLAL_ESYS, "Failed to initialise SFT prefetcher mutex\n" );
+  }
+  if ( pthread_cond_init ( &prefetcher->cond, NULL ) != 0 ) {
+    pthread_mutex_destroy ( &prefetcher->lock );
+    XLALFree ( prefetcher );
+    XLAL_ERROR_NULL ( XLAL_ESYS, "Failed to initialise SFT prefetcher condition variable\n" );
+  }
+  if ( pthread_create ( &prefetcher->thread, NULL, SFT_prefetcher_thread, prefetcher ) != 0 ) {
+    pthread_cond_destroy ( &prefetcher->cond );
+    pthread_mutex_destroy ( &prefetcher->lock );
+    XLALFree ( prefetcher );
+    XLAL_ERROR_NULL ( XLAL_ESYS, "Failed to create SFT prefetcher thread\n" );
+  }
+  prefetcher->running = TRUE;
+#endif
+  return prefetcher;
+} /* XLALCreateSFTPrefetcher() */
+
+
+/**
+ * Destroy an ::SFTPrefetcher, waiting for any SFTs currently being loaded, and freeing
+ * any prefetched SFTs which were never retrieved.
+ */
+void
+XLALDestroySFTPrefetcher ( SFTPrefetcher *prefetcher	/**< SFT prefetcher */
+                           )
+{
+  if ( prefetcher == NULL ) {
+    return;
+  }
+#ifdef HAVE_PTHREAD
+  if ( prefetcher->running ) {
+    pthread_mutex_lock ( &prefetcher->lock );
+    prefetcher->quit = TRUE;
+    pthread_cond_broadcast ( &prefetcher->cond );
+    pthread_mutex_unlock ( &prefetcher->lock );
+    pthread_join ( prefetcher->thread, NULL );
+  }
+  pthread_cond_destroy ( &prefetcher->cond );
+  pthread_mutex_destroy ( &prefetcher->lock );
+#endif
+  while ( prefetcher->head != NULL ) {
+    SFTPrefetchRequest *req = prefetcher->head;
+    prefetcher->head = req->next;
+    XLALDestroyMultiSFTVector ( req->sfts );
+    XLALFree ( req );
+  }
+  XLALFree ( prefetcher );
+} /* XLALDestroySFTPrefetcher() */
+
+
+/**
+ * Queue the SFTs described by \a catalog in the frequency band <tt>[fMin, fMax]</tt> to be loaded in
+ * the background by an ::SFTPrefetcher. Only the catalog header is copied, so \a catalog may be e.g.
+ * a local timeslice from XLALSFTCatalogTimeslice(); but its array of SFT descriptors must not be freed
+ * or modified until the SFTs have been retrieved with XLALSFTPrefetcherLoad().
+ */
+int
+XLALSFTPrefetcherStart ( SFTPrefetcher *prefetcher,	/**< SFT prefetcher */
+                         const SFTCatalog *catalog,	/**< The 'catalogue' of SFTs to load */
+                         REAL8 fMin,			/**< minumum requested frequency (-1 = read from lowest) */
+                         REAL8 fMax			/**< maximum requested frequency (-1 = read up to highest) */
+                         )
+{
+  XLAL_CHECK ( prefetcher != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( catalog != NULL && catalog->length > 0, XLAL_EINVAL );
+
+  SFTPrefetchRequest *req = NULL;
+  XLAL_CHECK ( (req = XLALCalloc ( 1, sizeof(*req) )) != NULL, XLAL_ENOMEM );
+  req->catalog = *catalog;
+  req->fMin = fMin;
+  req->fMax = fMax;
+
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock ( &prefetcher->lock );
+#else
+  /* no background thread: load the SFTs now */
+  load_SFT_prefetch_request ( req, prefetcher->numThreads );
+  req->done = TRUE;
+#endif
+  if ( prefetcher->tail != NULL ) {
+    prefetcher->tail->next = req;
+  } else {
+    prefetcher->head = req;
+  }
+  prefetcher->tail = req;
+#ifdef HAVE_PTHREAD
+  if ( prefetcher->pending == NULL ) {
+    prefetcher->pending = req;
+  }
+  pthread_cond_broadcast ( &prefetcher->cond );
+  pthread_mutex_unlock ( &prefetcher->lock );
+#endif
+
+  return XLAL_SUCCESS;
+
+} /* XLALSFTPrefetcherStart() */
+
+
+/**
+ * Return the SFTs described by \a catalog in the frequency band <tt>[fMin, fMax]</tt>, identical to
+ * XLALLoadMultiSFTs(). If the SFT descriptors of \a catalog are at the head of the queue of an ::SFTPrefetcher, and the
+ * prefetched band covers the requested band, the prefetched SFTs are returned, waiting for them
+ * to be loaded if necessary. Otherwise the SFTs are loaded directly.
+ */
+MultiSFTVector *
+XLALSFTPrefetcherLoad ( SFTPrefetcher *prefetcher,	/**< SFT prefetcher */
+                        const SFTCatalog *catalog,	/**< The 'catalogue' of SFTs to load */
+                        REAL8 fMin,			/**< minumum requested frequency (-1 = read from lowest) */
+                        REAL8 fMax			/**< maximum requested frequency (-1 = read up to highest) */
+                        )
+{
+  XLAL_CHECK_NULL ( prefetcher != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL ( catalog != NULL && catalog->length > 0, XLAL_EINVAL );
+
+  /* take the request at the head of the queue, if it is for this catalog */
+  SFTPrefetchRequest *req = NULL;
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock ( &prefetcher->lock );
+#endif
+  if ( prefetcher->head != NULL && prefetcher->head->catalog.data == catalog->data && prefetcher->head->catalog.length == catalog->length )
+    {
+      req = prefetcher->head;
+#ifdef HAVE_PTHREAD
+      while ( !req->done ) {
+        pthread_cond_wait ( &prefetcher->cond, &prefetcher->lock );
+      }
+#endif
+      prefetcher->head = req->next;
+      if ( prefetcher->head == NULL ) {
+        prefetcher->tail = NULL;
+      }
+    }
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock ( &prefetcher->lock );
+#endif
+
+  MultiSFTVector *multiSFTs = NULL;
+  if ( req != NULL )
+    {
+      multiSFTs = req->sfts;
+      if ( multiSFTs != NULL && !( req->fMin == fMin && req->fMax == fMax ) && !restrict_prefetched_SFTs ( multiSFTs, fMin, fMax ) ) {
+        XLALPrintInfo ( "%s: prefetched SFTs do not cover the requested band, loading them again\n", __func__ );
+        XLALDestroyMultiSFTVector ( multiSFTs );
+        multiSFTs = NULL;
+      }
+      XLALFree ( req );
+    }
+
+  if ( multiSFTs == NULL )
+    {
+      MultiSFTCatalogView *view = NULL;
+      XLAL_CHECK_NULL ( (view = XLALGetMultiSFTCatalogView ( catalog )) != NULL, XLAL_EFUNC );
+      multiSFTs = XLALLoadMultiSFTsFromViewParallel ( view, fMin, fMax, prefetcher->numThreads );
+      XLALDestroyMultiSFTCatalogView ( view );
+      XLAL_CHECK_NULL ( multiSFTs != NULL, XLAL_EFUNC );
+    }
+
+  return multiSFTs;
+
+} /* XLALSFTPrefetcherLoad() */
+
+
+/**
+ * Memory-map all SFT files referenced by an ::SFTCatalog, for use with XLALLoadSFTViews()
+ * and XLALLoadMultiSFTViews(). Each file is mapped once, irrespective of how many SFTs it contains.
+ *
+ * Note: the catalog may be freed after this function returns.
+ */
+SFTFileMap *
+XLALCreateSFTFileMap ( const SFTCatalog *catalog	/**< [in] catalog of SFTs whose files to map */
+                       )
+{
+  XLAL_CHECK_NULL ( catalog != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( catalog->length > 0 && catalog->data != NULL, XLAL_EINVAL );
+
+#ifdef HAVE_SYS_MMAN_H
+
+  SFTFileMap *map;
+  XLAL_CHECK_NULL ( (map = XLALCalloc ( 1, sizeof(*map) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (map->data = XLALCalloc ( catalog->length, sizeof(map->data[0]) )) != NULL, XLAL_ENOMEM );
+
+  /* collect the unique file names in the catalog */
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
+    {
+      map->data[i].fname = catalog->data[i].locator->fname;
+    }
+  qsort ( map->data, catalog->length, sizeof(map->data[0]), compareSFTMappedFiles );
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
+    {
+      if ( map->length == 0 || strcmp ( map->data[map->length - 1].fname, map->data[i].fname ) != 0 )
+        {
+          map->data[map->length ++].fname = map->data[i].fname;
+        }
+    }
+  for ( UINT4 i = map->length; i < catalog->length; i ++ )
+    {
+      map->data[i].fname = NULL;
+    }
+
+  /* map each file; pages are copy-on-write, so the files themselves are never modified */
+  for ( UINT4 i = 0; i < map->length; i ++ )
+    {
+      SFTMappedFile *mf = &map->data[i];
+      const CHAR *fname = mf->fname;
+      mf->fname = NULL;
+      XLAL_CHECK_FAIL ( (mf->fname = XLALStringDuplicate ( fname )) != NULL, XLAL_EFUNC );
+      int fd = open ( fname, O_RDONLY );
+      XLAL_CHECK_FAIL ( fd >= 0, XLAL_EIO, "Failed to open SFT '%s' for mapping: %s\n\n", fname, strerror(errno) );
+      struct stat st;
+      if ( fstat ( fd, &st ) != 0 || st.st_size == 0 )
+        {
+          close ( fd );
+          XLAL_ERROR_FAIL ( XLAL_EIO, "Failed to get length of SFT '%s'\n\n", fname );
+        }
+      void *addr = mmap ( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+      close ( fd );
+      XLAL_CHECK_FAIL ( addr != MAP_FAILED, XLAL_EIO, "Failed to map SFT '%s': %s\n\n", fname, strerror(errno) );
+      mf->addr = addr;
+      mf->len = st.st_size;
+    }
+
+  return map;
+
+XLAL_FAIL:
+  XLALDestroySFTFileMap ( map );
+  return NULL;
+
+#else /* !HAVE_SYS_MMAN_H */
+
+  XLAL_ERROR_NULL ( XLAL_EFAILED, "Memory-mapping of SFT files is not supported on this platform; use XLALLoadSFTs()\n" );
+
+#endif /* HAVE_SYS_MMAN_H */
+
+} /* XLALCreateSFTFileMap() */
+
+
+/**
+ * Unmap the SFT files mapped by XLALCreateSFTFileMap(). All SFT views created from
+ * the map must have been freed before calling this function.
+ */
+void
+XLALDestroySFTFileMap ( SFTFileMap *map )
+{
+  if ( map == NULL ) {
+    return;
+  }
+  if ( map->data != NULL )
+    {
+      for ( UINT4 i = 0; i < map->length; i ++ )
+        {
+#ifdef HAVE_SYS_MMAN_H
+          if ( map->data[i].addr != NULL ) {
+            munmap ( map->data[i].addr, map->data[i].len );
+          }
+#endif
+          XLALFree ( map->data[i].fname );
+        }
+      XLALFree ( map->data );
+    }
+  XLALFree ( map );
+
+} /* XLALDestroySFTFileMap() */
+
+
+/**
+ * Return the given frequency-band <tt>[fMin, fMax]</tt> (inclusively) of the SFTs in the
+ * SFT-'catalogue', as views directly into the SFT files mapped by XLALCreateSFTFileMap(),
+ * without copying any SFT data. The frequency band is determined exactly as in XLALLoadSFTs().
+ *
+ * The SFT data may be modified; modified pages are copied privately, and the SFT files
+ * themselves are never changed. The returned vector must be freed with XLALDestroySFTViews().
+ *
+ * Note: only native-endian SFT-v2 files are supported, and every SFT timestamp must be
+ * described by a single SFT block containing the whole requested frequency band.
+ * Use XLALLoadSFTs() for all other SFTs.
+ */
+SFTVector *
+XLALLoadSFTViews ( const SFTFileMap *map,	/**< [in] memory mapping of the SFT files in the catalog */
+                   const SFTCatalog *catalog,	/**< [in] the 'catalogue' of SFTs to return */
+                   REAL8 fMin,			/**< [in] minumum requested frequency (-1 = read from lowest) */
+                   REAL8 fMax			/**< [in] maximum requested frequency (-1 = read up to highest) */
+                   )
+{
+  XLAL_CHECK_NULL ( map != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( catalog != NULL && catalog->length > 0 && catalog->data != NULL, XLAL_EINVAL );
+
+  /* record max and min bin of all SFTs in the catalog, and check that there is one SFT block per timestamp */
+  const REAL8 deltaF = catalog->data[0].header.deltaF;
+  UINT4 minbin = lround ( catalog->data[0].header.f0 / deltaF );
+  UINT4 maxbin = minbin + catalog->data[0].numBins - 1;
+  for ( UINT4 i = 1; i < catalog->length; i ++ )
+    {
+      const SFTDescriptor *desc = &catalog->data[i];
+      XLAL_CHECK_NULL ( strncmp ( desc->header.name, catalog->data[0].header.name, 2 ) == 0, XLAL_EINVAL,
+                        "SFT catalog contains more than one detector; use XLALLoadMultiSFTViews()\n" );
+      XLAL_CHECK_NULL ( !GPSEQUAL ( desc->header.epoch, catalog->data[i-1].header.epoch ), XLAL_EINVAL,
+                        "SFT at GPS %d is split over several SFT blocks; use XLALLoadSFTs()\n", desc->header.epoch.gpsSeconds );
+      const UINT4 firstSFTbin = lround ( desc->header.f0 / deltaF );
+      const UINT4 lastSFTbin = firstSFTbin + desc->numBins - 1;
+      if ( firstSFTbin < minbin ) {
+        minbin = firstSFTbin;
+      }
+      if ( lastSFTbin > maxbin ) {
+        maxbin = lastSFTbin;
+      }
+    }
+
+  /* calculate first and last frequency bin to return */
+  const UINT4 firstbin = ( fMin < 0 ) ? minbin : XLALRoundFrequencyDownToSFTBin ( fMin, deltaF );
+  const UINT4 lastbin = ( fMax < 0 ) ? maxbin : XLALRoundFrequencyUpToSFTBin ( fMax, deltaF );
+  XLAL_CHECK_NULL ( firstbin <= lastbin, XLAL_EINVAL, "Empty frequency-interval requested [%u, %u] bins\n", firstbin, lastbin );
+  const UINT4 numBins = lastbin - firstbin + 1;
+
+  /* create vector of SFT views */
+  SFTVector *views;
+  XLAL_CHECK_NULL ( (views = XLALCalloc ( 1, sizeof(*views) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (views->data = XLALCalloc ( catalog->length, sizeof(views->data[0]) )) != NULL, XLAL_ENOMEM );
+  views->length = catalog->length;
+
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
+    {
+      const SFTDescriptor *desc = &catalog->data[i];
+      const struct tagSFTLocator *locator = desc->locator;
+      XLAL_CHECK_FAIL ( desc->version == 2 && !locator->h5, XLAL_EDATA, "SFT '%s' is not an SFT-v2 file; use XLALLoadSFTs()\n", locator->fname );
+
+      /* find mapping of SFT file */
+      const SFTMappedFile key = { .fname = locator->fname };
+      const SFTMappedFile *mf = bsearch ( &key, map->data, map->length, sizeof(map->data[0]), compareSFTMappedFiles );
+      XLAL_CHECK_FAIL ( mf != NULL, XLAL_EINVAL, "SFT '%s' was not mapped by XLALCreateSFTFileMap()\n", locator->fname );
+
+      /* a byte-swapped SFT-v2 header will not have a native version number */
+      _SFT_header_v2_t rawheader;
+      XLAL_CHECK_FAIL ( locator->offset >= 0 && (size_t)locator->offset + sizeof(rawheader) <= mf->len, XLAL_EIO,
+                        "SFT '%s' is shorter than expected\n", locator->fname );
+      memcpy ( &rawheader, mf->addr + locator->offset, sizeof(rawheader) );
+      XLAL_CHECK_FAIL ( rawheader.version == 2 && rawheader.comment_length >= 0, XLAL_EDATA,
+                        "SFT '%s' is not in native byte order; use XLALLoadSFTs()\n", locator->fname );
+
+      /* check that requested interval is found in SFT */
+      const UINT4 firstSFTbin = lround ( desc->header.f0 / deltaF );
+      const UINT4 lastSFTbin = firstSFTbin + desc->numBins - 1;
+      XLAL_CHECK_FAIL ( firstSFTbin <= firstbin && lastbin <= lastSFTbin, XLAL_EDOM,
+                        "SFT at GPS %d contains frequency bins [%u, %u], not requested bins [%u, %u]\n",
+                        desc->header.epoch.gpsSeconds, firstSFTbin, lastSFTbin, firstbin, lastbin );
+
+      const size_t offset = locator->offset + sizeof(rawheader) + rawheader.comment_length + ( firstbin - firstSFTbin ) * sizeof(COMPLEX8);
+      XLAL_CHECK_FAIL ( offset + numBins * sizeof(COMPLEX8) <= mf->len, XLAL_EIO, "SFT '%s' is shorter than expected\n", locator->fname );
+      XLAL_CHECK_FAIL ( ( (size_t)( mf->addr + offset ) ) % sizeof(REAL4) == 0, XLAL_EDATA, "SFT data in '%s' is not aligned\n", locator->fname );
+
+      /* point SFT data into mapped file */
+      SFTtype *view = &views->data[i];
+      *view = desc->header;
+      view->f0 = 1.0 * firstbin * deltaF;
+      XLAL_CHECK_FAIL ( (view->data = XLALCalloc ( 1, sizeof(*view->data) )) != NULL, XLAL_ENOMEM );
+      view->data->length = numBins;
+      view->data->data = (COMPLEX8 *)( mf->addr + offset );
+    }
+
+  return views;
+
+XLAL_FAIL:
+  XLALDestroySFTViews ( views );
+  return NULL;
+
+} /* XLALLoadSFTViews() */
+
+
+/**
+ * Multi-IFO version of XLALLoadSFTViews(), with the same semantics as XLALLoadMultiSFTs().
+ * The returned vector must be freed with XLALDestroyMultiSFTViews().
+ */
+MultiSFTVector *
+XLALLoadMultiSFTViews ( const SFTFileMap *map,		/**< [in] memory mapping of the SFT files in the catalog */
+                        const SFTCatalog *catalog,	/**< [in] the 'catalogue' of SFTs to return */
+                        REAL8 fMin,			/**< [in] minumum requested frequency (-1 = read from lowest) */
+                        REAL8 fMax			/**< [in] maximum requested frequency (-1 = read up to highest) */
+                        )
+{
+  XLAL_CHECK_NULL ( map != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL ( catalog != NULL && catalog->length > 0, XLAL_EINVAL );
+
+  MultiSFTCatalogView *multiCatalogView;
+  XLAL_CHECK_NULL ( (multiCatalogView = XLALGetMultiSFTCatalogView ( catalog )) != NULL, XLAL_EFUNC );
+
+  MultiSFTVector *multiViews = NULL;
+  XLAL_CHECK_FAIL ( (multiViews = XLALCalloc ( 1, sizeof(*multiViews) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (multiViews->data = XLALCalloc ( multiCatalogView->length, sizeof(multiViews->data[0]) )) != NULL, XLAL_ENOMEM );
+  multiViews->length = multiCatalogView->length;
+
+  for ( UINT4 X = 0; X < multiViews->length; X ++ )
+    {
+      XLAL_CHECK_FAIL ( (multiViews->data[X] = XLALLoadSFTViews ( map, &multiCatalogView->data[X], fMin, fMax )) != NULL, XLAL_EFUNC,
+                        "Failed to XLALLoadSFTViews() for IFO X = %d\n", X );
+    }
+
+  XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+
+  return multiViews;
+
+XLAL_FAIL:
+  XLALDestroyMultiSFTViews ( multiViews );
+  XLALDestroyMultiSFTCatalogView ( multiCatalogView );
+  return NULL;
+
+} /* XLALLoadMultiSFTViews() */
+
+
+/**
+ * Free a vector of SFT views returned by XLALLoadSFTViews(); the SFT data themselves belong to the SFTFileMap.
+ */
+void
+XLALDestroySFTViews ( SFTVector *views )
+{
+  if ( views == NULL ) {
+    return;
+  }
+  if ( views->data != NULL )
+    {
+      for ( UINT4 i = 0; i < views->length; i ++ )
+        {
+          XLALFree ( views->data[i].data );
+        }
+      XLALFree ( views->data );
+    }
+  XLALFree ( views );
+
+} /* XLALDestroySFTViews() */
+
+
+/**
+ * Free a multi-IFO vector of SFT views returned by XLALLoadMultiSFTViews().
+ */
+void
+XLALDestroyMultiSFTViews ( MultiSFTVector *multiViews )
+{
+  if ( multiViews == NULL ) {
+    return;
+  }
+  if ( multiViews->data != NULL )
+    {
+      for ( UINT4 X = 0; X < multiViews->length; X ++ )
+        {
+          XLALDestroySFTViews ( multiViews->data[X] );
+        }
+      XLALFree ( multiViews->data );
+    }
+  XLALFree ( multiViews );
+
+} /* XLALDestroyMultiSFTViews() */
+
+
 /// backwards compatible wrapper to XLALReadTimestampsFileConstrained() without GPS-time constraints
 LIGOTimeGPSVector *
 XLALReadTimestampsFile ( const CHAR *fname )
@@ -1189,6 +2058,11 @@ XLALCheckCRCSFTCatalog(
     {
       FILE *fp;
 
+      /* band-chunked HDF5 SFT containers store no CRC */
+      if ( catalog->data[i].locator->h5 ) {
+        continue;
+      }
+
       switch ( catalog->data[i].version  )
 	{
 	case 1:	/* version 1 had no CRC  */
@@ -1565,6 +2439,112 @@ XLALWriteSFTVector2NamedFile ( const SFTVector *sftVect,	/**< SFT vector to writ
 } /* XLALWriteSFTVector2NamedFile() */
 
 
+/**
+ * Write the given *v2-normalized* (i.e. dt x DFT) SFTVector into a band-chunked HDF5 SFT container,
+ * in which the SFT data of all timestamps are stored in chunks of \a chunkBins frequency bins.
+ * All SFTs must be from the same detector, and have identical frequency bands.
+ * Add the comment to the container if SFTcomment != NULL.
+ *
+ * The container is read transparently by XLALSFTdataFind() and XLALLoadSFTs().
+ */
+int
+XLALWriteSFTVector2H5File ( const SFTVector *sftVect,	//!< [in] SFT vector to write to disk
+                            const CHAR *fname,		//!< [in] name of HDF5 file to write
+                            UINT4 chunkBins,		//!< [in] number of frequency bins in each chunk
+                            const CHAR *SFTcomment	//!< [in] optional comment
+                            )
+{
+  XLAL_CHECK ( sftVect != NULL && sftVect->length > 0 && sftVect->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( fname != NULL, XLAL_EINVAL );
+  XLAL_CHECK ( chunkBins > 0, XLAL_EINVAL );
+
+  /* check SFTs are consistent */
+  const SFTtype *sft0 = &sftVect->data[0];
+  XLAL_CHECK ( sft0->data != NULL && sft0->data->length > 0, XLAL_EINVAL );
+  XLAL_CHECK ( XLALIsValidCWDetector ( sft0->name ), XLAL_EINVAL, "Invalid detector prefix '%c%c'\n", sft0->name[0], sft0->name[1] );
+  const UINT4 numSFTs = sftVect->length;
+  const UINT4 numBins = sft0->data->length;
+  const UINT4 firstBin = lround ( sft0->f0 / sft0->deltaF );
+  for ( UINT4 i = 1; i < numSFTs; i ++ )
+    {
+      const SFTtype *sft = &sftVect->data[i];
+      XLAL_CHECK ( sft->data != NULL && sft->data->length == numBins, XLAL_EINVAL, "SFT %u has a different number of bins\n", i );
+      XLAL_CHECK ( strncmp ( sft->name, sft0->name, 2 ) == 0, XLAL_EINVAL, "SFT %u is from a different detector\n", i );
+      XLAL_CHECK ( sft->deltaF == sft0->deltaF && sft->f0 == sft0->f0, XLAL_EINVAL, "SFT %u has a different frequency band\n", i );
+      XLAL_CHECK ( XLALGPSCmp ( &sftVect->data[i-1].epoch, &sft->epoch ) < 0, XLAL_EINVAL, "SFTs are not sorted by increasing GPS epochs\n" );
+    }
+
+  LALH5File *file = NULL;
+  INT4Vector *gps_seconds = NULL, *gps_nanoseconds = NULL;
+  COMPLEX8Array *chunk = NULL;
+  LALH5Dataset *dset = NULL;
+
+  XLAL_CHECK ( (file = XLALH5FileOpen ( fname, "w" )) != NULL, XLAL_EFUNC, "Failed to open '%s' for writing\n", fname );
+  LALH5Generic gfile = { .file = file };
+
+  /* write container attributes */
+  {
+    const INT4 version = SFT_H5_CONTAINER_VERSION;
+    CHAR detector[3] = { sft0->name[0], sft0->name[1], 0 };
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddScalar ( gfile, "SFT_container_version", &version, LAL_I4_TYPE_CODE ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddString ( gfile, "detector", detector ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddScalar ( gfile, "deltaF", &sft0->deltaF, LAL_D_TYPE_CODE ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddScalar ( gfile, "first_bin", &firstBin, LAL_U4_TYPE_CODE ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddScalar ( gfile, "num_bins", &numBins, LAL_U4_TYPE_CODE ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddScalar ( gfile, "chunk_bins", &chunkBins, LAL_U4_TYPE_CODE ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddScalar ( gfile, "num_SFTs", &numSFTs, LAL_U4_TYPE_CODE ) == 0, XLAL_EFUNC );
+    XLAL_CHECK_FAIL ( XLALH5AttributeAddString ( gfile, "comment", ( SFTcomment != NULL ) ? SFTcomment : "" ) == 0, XLAL_EFUNC );
+  }
+
+  /* write SFT timestamps */
+  XLAL_CHECK_FAIL ( (gps_seconds = XLALCreateINT4Vector ( numSFTs )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK_FAIL ( (gps_nanoseconds = XLALCreateINT4Vector ( numSFTs )) != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < numSFTs; i ++ )
+    {
+      gps_seconds->data[i] = sftVect->data[i].epoch.gpsSeconds;
+      gps_nanoseconds->data[i] = sftVect->data[i].epoch.gpsNanoSeconds;
+    }
+  XLAL_CHECK_FAIL ( (dset = XLALH5DatasetAllocINT4Vector ( file, "gps_seconds", gps_seconds )) != NULL, XLAL_EFUNC );
+  XLALH5DatasetFree ( dset );
+  XLAL_CHECK_FAIL ( (dset = XLALH5DatasetAllocINT4Vector ( file, "gps_nanoseconds", gps_nanoseconds )) != NULL, XLAL_EFUNC );
+  XLALH5DatasetFree ( dset );
+
+  /* write SFT data, one chunk of frequency bins for all SFTs at a time */
+  for ( UINT4 k = 0; k * chunkBins < numBins; k ++ )
+    {
+      const UINT4 chunkFirst = k * chunkBins;
+      const UINT4 chunkLen = ( numBins - chunkFirst < chunkBins ) ? numBins - chunkFirst : chunkBins;
+      XLAL_CHECK_FAIL ( (chunk = XLALCreateCOMPLEX8ArrayL ( 2, numSFTs, chunkLen )) != NULL, XLAL_EFUNC );
+      for ( UINT4 i = 0; i < numSFTs; i ++ )
+        {
+          memcpy ( chunk->data + (size_t)i * chunkLen, sftVect->data[i].data->data + chunkFirst, chunkLen * sizeof(COMPLEX8) );
+        }
+      char dset_name[32];
+      snprintf ( dset_name, sizeof(dset_name), "band_%u", k );
+      XLAL_CHECK_FAIL ( (dset = XLALH5DatasetAllocCOMPLEX8Array ( file, dset_name, chunk )) != NULL, XLAL_EFUNC );
+      XLALH5DatasetFree ( dset );
+      XLALDestroyCOMPLEX8Array ( chunk );
+      chunk = NULL;
+    }
+
+  XLALDestroyINT4Vector ( gps_seconds );
+  XLALDestroyINT4Vector ( gps_nanoseconds );
+  XLALH5FileClose ( file );
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  if ( chunk != NULL ) {
+    XLALDestroyCOMPLEX8Array ( chunk );
+  }
+  XLALDestroyINT4Vector ( gps_seconds );
+  XLALDestroyINT4Vector ( gps_nanoseconds );
+  XLALH5FileClose ( file );
+  return XLAL_FAILURE;
+
+} /* XLALWriteSFTVector2H5File() */
+
+
 /** Free an 'SFT-catalogue' */
 void
 XLALDestroySFTCatalog ( SFTCatalog *catalog  /**< the 'catalogue' to free */ )
@@ -2057,6 +3037,440 @@ timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list )
 } /* timestamp_in_list() */
 
 
+/* does this SFT-block satisfy the user-constraints?
+ * NOTE: v1-SFTs have '??' as detector-name, which is SET to the detector-constraint */
+static BOOLEAN
+want_SFT_block ( SFTtype *header, const SFTConstraints *constraints )
+{
+  BOOLEAN want_this_block = TRUE;	/* default */
+
+  if ( constraints )
+    {
+      if ( constraints->detector && strncmp(constraints->detector, "??", 2) )
+	{
+	  /* v1-SFTs have '??' as detector-name */
+	  if ( ! strncmp (header->name, "??", 2 ) ) {
+	    strncpy ( header->name, constraints->detector, 2 );	/* SET to constraint! */
+	  }
+	  else if ( strncmp( constraints->detector, header->name, 2) ) {
+	    want_this_block = FALSE;
+	  }
+	}
+
+      if ( XLALCWGPSinRange(header->epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
+	want_this_block = FALSE;
+      }
+
+      if ( constraints->timestamps && !timestamp_in_list(header->epoch, constraints->timestamps) ) {
+	want_this_block = FALSE;
+      }
+
+    } /* if constraints */
+
+  return want_this_block;
+
+} /* want_SFT_block() */
+
+
+/* Read the SFT descriptors satisfying the given constraints from an index file
+ * written by XLALWriteSFTCatalogIndex(). The descriptors are stored in
+ * catalog->data, and their number in *numSFTs.
+ */
+static int
+read_SFT_catalog_index ( SFTCatalog *catalog, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints )
+{
+  FILE *fp;
+  XLAL_CHECK ( (fp = fopen ( fname, "rb" )) != NULL, XLAL_EIO, "Failed to open SFT catalog index '%s' for reading: %s\n\n", fname, strerror(errno) );
+
+  int retn = read_SFT_catalog_index_fp ( catalog, numSFTs, fp, constraints );
+  fclose ( fp );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} /* read_SFT_catalog_index() */
+
+
+/* Write the fields of an SFT catalog index file; see read_SFT_catalog_index_fp() for the format */
+static int
+write_SFT_catalog_index_fp ( const SFTCatalog *catalog, FILE *fp )
+{
+#define WRITE_FIELD(ptr, size) XLAL_CHECK ( fwrite ( (ptr), (size), 1, fp ) == 1, XLAL_EIO, "Failed to write SFT catalog index: %s\n", strerror(errno) )
+
+  const UINT4 index_version = SFT_INDEX_VERSION;
+  const UINT4 index_endian = SFT_INDEX_ENDIAN;
+  WRITE_FIELD ( SFT_INDEX_MAGIC, strlen(SFT_INDEX_MAGIC) );
+  WRITE_FIELD ( &index_version, sizeof(index_version) );
+  WRITE_FIELD ( &index_endian, sizeof(index_endian) );
+  WRITE_FIELD ( &catalog->length, sizeof(catalog->length) );
+
+  for ( UINT4 i = 0; i < catalog->length; i ++ )
+    {
+      const SFTDescriptor *desc = &catalog->data[i];
+      XLAL_CHECK ( desc->locator != NULL && desc->locator->fname != NULL, XLAL_EINVAL, "SFT catalog entry %u has no locator\n", i );
+
+      /* file names of consecutive SFTs from the same (merged) SFT file are written only once */
+      const CHAR *fname = desc->locator->fname;
+      const UINT4 fname_len = ( i > 0 && strcmp ( fname, catalog->data[i-1].locator->fname ) == 0 ) ? 0 : strlen ( fname );
+      WRITE_FIELD ( &fname_len, sizeof(fname_len) );
+      if ( fname_len > 0 ) {
+        WRITE_FIELD ( fname, fname_len );
+      }
+
+      const INT8 offset = desc->locator->offset;
+      const UINT4 h5 = desc->locator->h5;
+      WRITE_FIELD ( &offset, sizeof(offset) );
+      WRITE_FIELD ( &h5, sizeof(h5) );
+      WRITE_FIELD ( &desc->header.epoch.gpsSeconds, sizeof(desc->header.epoch.gpsSeconds) );
+      WRITE_FIELD ( &desc->header.epoch.gpsNanoSeconds, sizeof(desc->header.epoch.gpsNanoSeconds) );
+      WRITE_FIELD ( &desc->header.f0, sizeof(desc->header.f0) );
+      WRITE_FIELD ( &desc->header.deltaF, sizeof(desc->header.deltaF) );
+      WRITE_FIELD ( desc->header.name, 2 );
+      WRITE_FIELD ( &desc->numBins, sizeof(desc->numBins) );
+      WRITE_FIELD ( &desc->version, sizeof(desc->version) );
+      WRITE_FIELD ( &desc->crc64, sizeof(desc->crc64) );
+
+      const UINT4 comment_len = ( desc->comment != NULL ) ? strlen ( desc->comment ) + 1 : 0;
+      WRITE_FIELD ( &comment_len, sizeof(comment_len) );
+      if ( comment_len > 0 ) {
+        WRITE_FIELD ( desc->comment, comment_len );
+      }
+
+    } /* for i < catalog->length */
+
+#undef WRITE_FIELD
+
+  return XLAL_SUCCESS;
+
+} /* write_SFT_catalog_index_fp() */
+
+
+/* Read the fields of an SFT catalog index file, which are (in native byte order):
+ * - header: magic string SFT_INDEX_MAGIC, UINT4 SFT_INDEX_VERSION, UINT4 SFT_INDEX_ENDIAN, UINT4 number of SFTs
+ * - for each SFT: UINT4 file-name length (0 = same file as previous SFT), file name [no terminating '\0'],
+ *   INT8 locator offset, UINT4 locator in HDF5 SFT container (0 = no, 1 = yes), INT4 GPS seconds, INT4 GPS nanoseconds, REAL8 f0, REAL8 deltaF, CHAR[2] detector,
+ *   UINT4 numBins, UINT4 SFT version, UINT8 crc64, UINT4 comment length (0 = no comment), comment [with terminating '\0']
+ */
+static int
+read_SFT_catalog_index_fp ( SFTCatalog *catalog, UINT4 *numSFTs, FILE *fp, const SFTConstraints *constraints )
+{
+#define READ_FIELD(ptr, size) XLAL_CHECK_FAIL ( fread ( (ptr), (size), 1, fp ) == 1, XLAL_EIO, "Failed to read SFT catalog index\n" )
+
+  CHAR *fname = NULL;
+
+  CHAR index_magic[sizeof(SFT_INDEX_MAGIC)] = { 0 };
+  UINT4 index_version = 0, index_endian = 0, numEntries = 0;
+  READ_FIELD ( index_magic, strlen(SFT_INDEX_MAGIC) );
+  XLAL_CHECK_FAIL ( strcmp ( index_magic, SFT_INDEX_MAGIC ) == 0, XLAL_EDATA, "File is not an SFT catalog index\n" );
+  READ_FIELD ( &index_version, sizeof(index_version) );
+  XLAL_CHECK_FAIL ( index_version == SFT_INDEX_VERSION, XLAL_EDATA, "Unsupported SFT catalog index version %u\n", index_version );
+  READ_FIELD ( &index_endian, sizeof(index_endian) );
+  XLAL_CHECK_FAIL ( index_endian == SFT_INDEX_ENDIAN, XLAL_EDATA, "SFT catalog index was written with a different byte order\n" );
+  READ_FIELD ( &numEntries, sizeof(numEntries) );
+
+  *numSFTs = 0;
+  if ( numEntries == 0 ) {
+    return XLAL_SUCCESS;
+  }
+
+  XLAL_CHECK_FAIL ( (catalog->data = XLALCalloc ( numEntries, sizeof(catalog->data[0]) )) != NULL, XLAL_ENOMEM );
+  catalog->length = numEntries;
+
+  for ( UINT4 i = 0; i < numEntries; i ++ )
+    {
+      SFTDescriptor *desc = &catalog->data[*numSFTs];
+
+      /* read file name, or keep file name of previous SFT */
+      UINT4 fname_len = 0;
+      READ_FIELD ( &fname_len, sizeof(fname_len) );
+      XLAL_CHECK_FAIL ( fname_len > 0 || fname != NULL, XLAL_EDATA, "SFT catalog index entry %u has no file name\n", i );
+      if ( fname_len > 0 )
+        {
+          XLALFree ( fname );
+          XLAL_CHECK_FAIL ( (fname = XLALCalloc ( 1, fname_len + 1 )) != NULL, XLAL_ENOMEM );
+          READ_FIELD ( fname, fname_len );
+        }
+      XLAL_CHECK_FAIL ( (desc->locator = XLALCalloc ( 1, sizeof(*desc->locator) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( (desc->locator->fname = XLALStringDuplicate ( fname )) != NULL, XLAL_EFUNC );
+
+      INT8 offset = 0;
+      UINT4 h5 = 0;
+      READ_FIELD ( &offset, sizeof(offset) );
+      READ_FIELD ( &h5, sizeof(h5) );
+      desc->locator->offset = offset;
+      desc->locator->h5 = ( h5 != 0 );
+      READ_FIELD ( &desc->header.epoch.gpsSeconds, sizeof(desc->header.epoch.gpsSeconds) );
+      READ_FIELD ( &desc->header.epoch.gpsNanoSeconds, sizeof(desc->header.epoch.gpsNanoSeconds) );
+      READ_FIELD ( &desc->header.f0, sizeof(desc->header.f0) );
+      READ_FIELD ( &desc->header.deltaF, sizeof(desc->header.deltaF) );
+      READ_FIELD ( desc->header.name, 2 );
+      desc->header.name[2] = 0;
+      READ_FIELD ( &desc->numBins, sizeof(desc->numBins) );
+      READ_FIELD ( &desc->version, sizeof(desc->version) );
+      READ_FIELD ( &desc->crc64, sizeof(desc->crc64) );
+
+      UINT4 comment_len = 0;
+      READ_FIELD ( &comment_len, sizeof(comment_len) );
+      if ( comment_len > 0 )
+        {
+          XLAL_CHECK_FAIL ( (desc->comment = XLALCalloc ( 1, comment_len )) != NULL, XLAL_ENOMEM );
+          READ_FIELD ( desc->comment, comment_len );
+          desc->comment[comment_len - 1] = 0;
+        }
+
+      /* keep this descriptor only if it satisfies the user-constraints, otherwise re-use it for the next SFT */
+      if ( want_SFT_block ( &desc->header, constraints ) )
+        {
+          ++(*numSFTs);
+        }
+      else
+        {
+          XLALFree ( desc->locator->fname );
+          XLALFree ( desc->locator );
+          XLALFree ( desc->comment );
+          memset ( desc, 0, sizeof(*desc) );
+        }
+
+    } /* for i < numEntries */
+
+#undef READ_FIELD
+
+  XLALFree ( fname );
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  XLALFree ( fname );
+  return XLAL_FAILURE;
+
+} /* read_SFT_catalog_index_fp() */
+
+
+/* does the file at fp start with the HDF5 file signature? leaves fp at the start of the file */
+static BOOLEAN
+is_H5_file ( FILE *fp )
+{
+  static const char H5_signature[8] = { '\211', 'H', 'D', 'F', '\r', '\n', '\032', '\n' };
+  char buf[sizeof(H5_signature)];
+
+  BOOLEAN is_H5 = ( fread ( buf, sizeof(buf), 1, fp ) == 1 ) && ( memcmp ( buf, H5_signature, sizeof(buf) ) == 0 );
+  rewind ( fp );
+
+  return is_H5;
+
+} /* is_H5_file() */
+
+
+/* read the attributes of a band-chunked HDF5 SFT container, and optionally its comment and timestamps */
+static int
+read_H5_SFT_container_info ( LALH5File *file, CHAR name[3], REAL8 *deltaF, UINT4 *firstBin, UINT4 *numBins, UINT4 *chunkBins, UINT4 *numSFTs,
+                             CHAR **comment, INT4Vector **gps_seconds, INT4Vector **gps_nanoseconds )
+{
+  LALH5Generic gfile = { .file = file };
+
+  INT4 version = 0;
+  XLAL_CHECK ( XLALH5AttributeQueryScalarValue ( &version, gfile, "SFT_container_version" ) == 0, XLAL_EFUNC, "HDF5 file is not an SFT container\n" );
+  XLAL_CHECK ( version == SFT_H5_CONTAINER_VERSION, XLAL_EDATA, "Unsupported SFT container version %d\n", version );
+  XLAL_CHECK ( XLALH5AttributeQueryStringValue ( name, 3, gfile, "detector" ) == 2, XLAL_EDATA, "Invalid detector in SFT container\n" );
+  XLAL_CHECK ( XLALH5AttributeQueryScalarValue ( deltaF, gfile, "deltaF" ) == 0, XLAL_EFUNC );
+  XLAL_CHECK ( XLALH5AttributeQueryScalarValue ( firstBin, gfile, "first_bin" ) == 0, XLAL_EFUNC );
+  XLAL_CHECK ( XLALH5AttributeQueryScalarValue ( numBins, gfile, "num_bins" ) == 0, XLAL_EFUNC );
+  XLAL_CHECK ( XLALH5AttributeQueryScalarValue ( chunkBins, gfile, "chunk_bins" ) == 0, XLAL_EFUNC );
+  XLAL_CHECK ( XLALH5AttributeQueryScalarValue ( numSFTs, gfile, "num_SFTs" ) == 0, XLAL_EFUNC );
+  XLAL_CHECK ( *deltaF > 0 && *numBins > 0 && *chunkBins > 0 && *numSFTs > 0, XLAL_EDATA, "Invalid SFT container attributes\n" );
+
+  if ( comment != NULL )
+    {
+      int comment_len = XLALH5AttributeQueryStringValue ( NULL, 0, gfile, "comment" );
+      XLAL_CHECK ( comment_len >= 0, XLAL_EFUNC );
+      *comment = NULL;
+      if ( comment_len > 0 )
+        {
+          XLAL_CHECK ( (*comment = XLALMalloc ( comment_len + 1 )) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK ( XLALH5AttributeQueryStringValue ( *comment, comment_len + 1, gfile, "comment" ) == comment_len, XLAL_EFUNC );
+        }
+    }
+
+  if ( gps_seconds != NULL && gps_nanoseconds != NULL )
+    {
+      LALH5Dataset *dset = NULL;
+      XLAL_CHECK ( (dset = XLALH5DatasetRead ( file, "gps_seconds" )) != NULL, XLAL_EFUNC );
+      *gps_seconds = XLALH5DatasetReadINT4Vector ( dset );
+      XLALH5DatasetFree ( dset );
+      XLAL_CHECK ( *gps_seconds != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (dset = XLALH5DatasetRead ( file, "gps_nanoseconds" )) != NULL, XLAL_EFUNC );
+      *gps_nanoseconds = XLALH5DatasetReadINT4Vector ( dset );
+      XLALH5DatasetFree ( dset );
+      XLAL_CHECK ( *gps_nanoseconds != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (*gps_seconds)->length == *numSFTs && (*gps_nanoseconds)->length == *numSFTs, XLAL_EDATA, "Invalid number of timestamps in SFT container\n" );
+    }
+
+  return XLAL_SUCCESS;
+
+} /* read_H5_SFT_container_info() */
+
+
+/* Add descriptors of the SFTs in a band-chunked HDF5 SFT container satisfying the given constraints
+ * to catalog->data; *numSFTs is the number of descriptors already in the catalog, and is updated.
+ * The locator of each SFT stores its index in the container as 'offset'.
+ */
+static int
+read_H5_SFT_descriptors ( SFTCatalog *catalog, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints )
+{
+  LALH5File *file = NULL;
+  INT4Vector *gps_seconds = NULL, *gps_nanoseconds = NULL;
+  CHAR *comment = NULL;
+
+  CHAR name[3] = { 0 };
+  REAL8 deltaF = 0;
+  UINT4 firstBin = 0, numBins = 0, chunkBins = 0, numContainerSFTs = 0;
+  XLAL_CHECK ( (file = XLALH5FileOpen ( fname, "r" )) != NULL, XLAL_EFUNC, "Failed to open SFT container '%s'\n", fname );
+  XLAL_CHECK_FAIL ( read_H5_SFT_container_info ( file, name, &deltaF, &firstBin, &numBins, &chunkBins, &numContainerSFTs,
+                                                 &comment, &gps_seconds, &gps_nanoseconds ) == XLAL_SUCCESS, XLAL_EFUNC,
+                    "Failed to read SFT container '%s'\n", fname );
+
+  /* make room for all SFTs in the container */
+  if ( *numSFTs + numContainerSFTs > catalog->length )
+    {
+      const UINT4 length = *numSFTs + numContainerSFTs + SFTFILEIO_REALLOC_BLOCKSIZE;
+      SFTDescriptor *data = XLALRealloc ( catalog->data, length * sizeof(catalog->data[0]) );
+      XLAL_CHECK_FAIL ( data != NULL, XLAL_ENOMEM );
+      memset ( &data[catalog->length], 0, ( length - catalog->length ) * sizeof(data[0]) );
+      catalog->data = data;
+      catalog->length = length;
+    }
+
+  for ( UINT4 i = 0; i < numContainerSFTs; i ++ )
+    {
+      SFTtype XLAL_INIT_DECL(header);
+      memcpy ( header.name, name, sizeof(name) );
+      header.epoch.gpsSeconds = gps_seconds->data[i];
+      header.epoch.gpsNanoSeconds = gps_nanoseconds->data[i];
+      header.f0 = firstBin * deltaF;
+      header.deltaF = deltaF;
+
+      if ( !want_SFT_block ( &header, constraints ) ) {
+        continue;
+      }
+
+      SFTDescriptor *desc = &catalog->data[*numSFTs];
+      XLAL_CHECK_FAIL ( (desc->locator = XLALCalloc ( 1, sizeof(*desc->locator) )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( (desc->locator->fname = XLALStringDuplicate ( fname )) != NULL, XLAL_EFUNC );
+      desc->locator->offset = i;
+      desc->locator->h5 = TRUE;
+      if ( comment != NULL ) {
+        XLAL_CHECK_FAIL ( (desc->comment = XLALStringDuplicate ( comment )) != NULL, XLAL_EFUNC );
+      }
+      desc->header  = header;
+      desc->numBins = numBins;
+      desc->version = 2;
+      desc->crc64   = 0;
+      ++(*numSFTs);
+    }
+
+  XLALFree ( comment );
+  XLALDestroyINT4Vector ( gps_seconds );
+  XLALDestroyINT4Vector ( gps_nanoseconds );
+  XLALH5FileClose ( file );
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  XLALFree ( comment );
+  XLALDestroyINT4Vector ( gps_seconds );
+  XLALDestroyINT4Vector ( gps_nanoseconds );
+  XLALH5FileClose ( file );
+  return XLAL_FAILURE;
+
+} /* read_H5_SFT_descriptors() */
+
+
+/* Read the frequency bins [firstBin2read, lastBin2read] of all SFTs in a band-chunked HDF5 SFT container
+ * into 'band', reading only the chunks which overlap the requested bins. If the container contains none
+ * of the requested bins, band->numBins is set to zero.
+ */
+static int
+read_H5_SFT_band ( SFTH5Band *band, const CHAR *fname, UINT4 firstBin2read, UINT4 lastBin2read )
+{
+  LALH5File *file = NULL;
+  LALH5Dataset *dset = NULL;
+  COMPLEX8Array *chunk = NULL;
+
+  /* free any previously-read band */
+  XLALFree ( band->fname );
+  XLALFree ( band->data );
+  memset ( band, 0, sizeof(*band) );
+  XLAL_CHECK ( (band->fname = XLALStringDuplicate ( fname )) != NULL, XLAL_EFUNC );
+
+  CHAR name[3] = { 0 };
+  REAL8 deltaF = 0;
+  UINT4 firstSFTbin = 0, numSFTbins = 0, chunkBins = 0, numSFTs = 0;
+  XLAL_CHECK ( (file = XLALH5FileOpen ( fname, "r" )) != NULL, XLAL_EFUNC, "Failed to open SFT container '%s'\n", fname );
+  XLAL_CHECK_FAIL ( read_H5_SFT_container_info ( file, name, &deltaF, &firstSFTbin, &numSFTbins, &chunkBins, &numSFTs, NULL, NULL, NULL ) == XLAL_SUCCESS, XLAL_EFUNC,
+                    "Failed to read SFT container '%s'\n", fname );
+  const UINT4 lastSFTbin = firstSFTbin + numSFTbins - 1;
+  band->numSFTs = numSFTs;
+
+  /* limit the interval to be read to what's actually in the container */
+  if ( firstBin2read < firstSFTbin ) {
+    firstBin2read = firstSFTbin;
+  }
+  if ( lastBin2read > lastSFTbin ) {
+    lastBin2read = lastSFTbin;
+  }
+  if ( firstBin2read > lastBin2read )
+    {
+      XLALH5FileClose ( file );
+      return XLAL_SUCCESS;
+    }
+  band->firstBin = firstBin2read;
+  band->numBins = lastBin2read - firstBin2read + 1;
+  XLAL_CHECK_FAIL ( (band->data = XLALMalloc ( (size_t)numSFTs * band->numBins * sizeof(band->data[0]) )) != NULL, XLAL_ENOMEM );
+
+  /* read overlapping chunks, each of which contains a contiguous band for all SFTs */
+  for ( UINT4 k = ( firstBin2read - firstSFTbin ) / chunkBins; k <= ( lastBin2read - firstSFTbin ) / chunkBins; k ++ )
+    {
+      const UINT4 chunkFirst = firstSFTbin + k * chunkBins;
+      const UINT4 chunkLen = ( numSFTbins - k * chunkBins < chunkBins ) ? numSFTbins - k * chunkBins : chunkBins;
+      char dset_name[32];
+      snprintf ( dset_name, sizeof(dset_name), "band_%u", k );
+      XLAL_CHECK_FAIL ( (dset = XLALH5DatasetRead ( file, dset_name )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK_FAIL ( (chunk = XLALH5DatasetReadCOMPLEX8Array ( dset )) != NULL, XLAL_EFUNC );
+      XLALH5DatasetFree ( dset );
+      dset = NULL;
+      XLAL_CHECK_FAIL ( chunk->dimLength->length == 2 && chunk->dimLength->data[0] == numSFTs && chunk->dimLength->data[1] == chunkLen, XLAL_EDATA,
+                        "Invalid dimensions of dataset '%s' in SFT container '%s'\n", dset_name, fname );
+
+      /* copy the requested bins of this chunk */
+      const UINT4 copyFirst = ( chunkFirst > firstBin2read ) ? chunkFirst : firstBin2read;
+      const UINT4 copyLast = ( chunkFirst + chunkLen - 1 < lastBin2read ) ? chunkFirst + chunkLen - 1 : lastBin2read;
+      for ( UINT4 i = 0; i < numSFTs; i ++ )
+        {
+          memcpy ( band->data + (size_t)i * band->numBins + ( copyFirst - firstBin2read ),
+                   chunk->data + (size_t)i * chunkLen + ( copyFirst - chunkFirst ),
+                   ( copyLast - copyFirst + 1 ) * sizeof(band->data[0]) );
+        }
+      XLALDestroyCOMPLEX8Array ( chunk );
+      chunk = NULL;
+    }
+
+  XLALH5FileClose ( file );
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  if ( dset != NULL ) {
+    XLALH5DatasetFree ( dset );
+  }
+  if ( chunk != NULL ) {
+    XLALDestroyCOMPLEX8Array ( chunk );
+  }
+  XLALH5FileClose ( file );
+  return XLAL_FAILURE;
+
+} /* read_H5_SFT_band() */
+
+
 /* check consistency constraints for SFT-blocks within a merged SFT-file,
  * see SFT-v2 spec */
 static BOOLEAN
@@ -3107,6 +4521,16 @@ compareDetNameCatalogs ( const void *ptr1, const void *ptr2 )
 } /* compareDetNameCatalogs() */
 
 
+/* comparison function for the 'SFTMappedFile's in an SFTFileMap, sorted by file name */
+static int
+compareSFTMappedFiles ( const void *ptr1, const void *ptr2 )
+{
+  const SFTMappedFile *mf1 = (const SFTMappedFile *) ptr1;
+  const SFTMappedFile *mf2 = (const SFTMappedFile *) ptr2;
+  return strcmp ( mf1->fname, mf2->fname );
+} /* compareSFTMappedFiles() */
+
+
 /**
  * Read valid SFT version-number at position fp, and determine if we need to
  * endian-swap the data.
@@ -46,7 +46,7 @@ extern "C" {
  * gravity.phys.uwm.edu:2402/usr/local/cvs/lscsoft sftlib, Copyright (C) 2004 Bruce Allen
  *
  * <p> <h3> Overview:</h3>
- * - SFT-reading: XLALSFTdataFind(), XLALLoadSFTs(), XLALLoadMultiSFTs()
+ * - SFT-reading: XLALSFTdataFind(), XLALLoadSFTs(), XLALLoadMultiSFTs(), XLALLoadMultiSFTsFromViewParallel()
  * - SFT-writing: XLALWriteSFT2file(), XLALWriteSFTVector2File(), XLALWriteSFTVector2Dir()
  * - SFT-checking: XLALCheckCRCSFTCatalog(): complete check of SFT-validity including CRC64 checksum
  * - free SFT-catalog: XLALDestroySFTCatalog()
@@ -134,6 +134,72 @@ extern "C" {
  * The function XLALLoadMultiSFTs() is similar to the above, except that it accepts an ::SFTCatalog with different detectors,
  * and returns corresponding multi-IFO vector of SFTVectors.
  *
+ * <h4>Concurrent loading and prefetching of SFTs</h4>
+ *
+ * XLALLoadMultiSFTsFromViewParallel() returns the same SFTs as XLALLoadMultiSFTsFromView(), but reads the
+ * SFT files concurrently using a bounded number of threads (requires OpenMP), which helps to hide the
+ * latency of network filesystems. The SFTs of each detector are divided into groups of consecutive
+ * timestamps read from the same file(s), and each group is loaded by one thread.
+ *
+ * An ::SFTPrefetcher loads SFTs in a background thread (requires POSIX threads), so that e.g. the SFTs
+ * of the next segment of a semicoherent search are read while the current segment is being processed:
+ * -# XLALCreateSFTPrefetcher(): create a prefetcher, which uses the given number of threads to load SFTs
+ * -# XLALSFTPrefetcherStart(): queue an ::SFTCatalog (e.g. returned by XLALSFTCatalogTimeslice()) and a
+ *    frequency band to be loaded in the background; the catalog must not be freed or loaded elsewhere until
+ *    its SFTs have been retrieved
+ * -# XLALSFTPrefetcherLoad(): return the SFTs of the given catalog and frequency band, identical to
+ *    XLALLoadMultiSFTs(). If the catalog is at the head of the queue and the prefetched band covers the
+ *    requested band, the prefetched SFTs are returned (waiting for them if necessary); otherwise the SFTs
+ *    are loaded directly.
+ * -# XLALDestroySFTPrefetcher(): free the prefetcher, and any prefetched SFTs which were never retrieved
+ *
+ * Without POSIX threads, XLALSFTPrefetcherStart() loads the SFTs immediately.
+ *
+ * <h4>Catalog index files</h4>
+ *
+ * Building an ::SFTCatalog requires opening every matching file and reading every SFT header,
+ * which can be slow for large numbers of SFT files on a shared filesystem. XLALWriteSFTCatalogIndex()
+ * saves the locators, timestamps and frequency bands of a catalog to an index file, which
+ * XLALSFTdataFind() reads instead of scanning the SFT files when passed a file pattern of the form
+ * <tt>"index:<index-file>"</tt>. All constraints are applied to the indexed SFTs as usual.
+ *
+ * <b>Note:</b> the SFT files themselves are not checked when an index is read, so the index file
+ * must be regenerated whenever any of the indexed SFT files change. The SFT file names are stored
+ * exactly as they appear in the catalog, so relative paths are relative to the working directory.
+ *
+ * <h4>Band-chunked SFT containers</h4>
+ *
+ * In SFT-v2 files the full frequency band of each SFT is stored contiguously, so reading a narrow
+ * frequency band from many SFTs requires one small read per SFT. XLALWriteSFTVector2H5File() instead
+ * writes an SFTVector of a single detector into an HDF5 file, where the SFT data of all timestamps are
+ * stored together in chunks of a fixed number of frequency bins. Reading a frequency band for the whole
+ * observing run then requires only one contiguous read per overlapping chunk.
+ *
+ * XLALSFTdataFind() recognises such containers by their HDF5 file signature, and returns one catalog
+ * entry per SFT in the container; these are read transparently by XLALLoadSFTs() and XLALLoadMultiSFTs().
+ * A container has the following structure:
+ * - file attributes \c SFT_container_version (INT4), \c detector (string), \c deltaF (REAL8),
+ *   \c first_bin, \c num_bins, \c chunk_bins, \c num_SFTs (UINT4), and \c comment (string);
+ * - datasets \c gps_seconds and \c gps_nanoseconds (INT4 vectors) containing the SFT timestamps;
+ * - datasets \c band_<k> (COMPLEX8 arrays of dimension <tt>num_SFTs x chunk_bins</tt>, except for
+ *   the last chunk) containing the SFT data of frequency bins <tt>[first_bin + k * chunk_bins, ...)</tt>.
+ *
+ * <b>Note:</b> band-chunked SFT containers require LAL to be built with HDF5 support.
+ *
+ * <h4>Memory-mapped SFTs</h4>
+ *
+ * XLALCreateSFTFileMap() memory-maps all the SFT files referenced by an ::SFTCatalog.
+ * XLALLoadSFTViews() and XLALLoadMultiSFTViews() then return SFTs, with the same semantics as
+ * XLALLoadSFTs() and XLALLoadMultiSFTs(), whose data point directly into the mapped files without
+ * copying. The files are mapped copy-on-write, so modifying the returned SFT data never changes the
+ * SFT files. The returned vectors must be freed with XLALDestroySFTViews() or
+ * XLALDestroyMultiSFTViews() <em>before</em> the map is freed with XLALDestroySFTFileMap().
+ *
+ * Views are only supported for SFT-v2 files with native endianness, and for catalogs where every
+ * SFT timestamp is described by a single SFT block containing the requested frequency band;
+ * other SFTs must be loaded with XLALLoadSFTs(). Note that one memory mapping is used per SFT file,
+ * so merged SFT files should be used when very large numbers of SFTs are to be mapped.
+ *
  * <p><h2>Usage: Writing of SFT-files</h2>
  *
  * For <b>writing SFTs</b>:
@@ -259,6 +325,12 @@ typedef struct tagSFTCatalog
   SFTDescriptor *data;		/**< array of data-entries describing matched SFTs */
 } SFTCatalog;
 
+/** Memory mapping of the SFT files referenced by an ::SFTCatalog [opaque] */
+typedef struct tagSFTFileMap SFTFileMap;
+
+/** Background loader of SFTs [opaque] */
+typedef struct tagSFTPrefetcher SFTPrefetcher;
+
 /**
  * A multi-SFT-catalogue "view": a multi-IFO vector of SFT-catalogs
  *
@@ -296,6 +368,7 @@ SFTCatalog *XLALSFTdataFind ( const CHAR *file_pattern, const SFTConstraints *co
 int XLALWriteSFTVector2Dir  ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
 int XLALWriteSFTVector2File ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
 int XLALWriteSFTVector2NamedFile ( const SFTVector *sftVect, const CHAR *filename, const CHAR *SFTcomment );
+int XLALWriteSFTVector2H5File ( const SFTVector *sftVect, const CHAR *fname, UINT4 chunkBins, const CHAR *SFTcomment );
 int XLALWriteSFT2fp   ( const SFTtype *sft, FILE *fp, const CHAR *SFTcomment );
 int XLALWriteSFT2file ( const SFTtype *sft, const CHAR *fname, const CHAR *SFTcomment );
 
@@ -310,6 +383,23 @@ SFTVector* XLALLoadSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 
 MultiSFTVector* XLALLoadMultiSFTs (const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax);
 MultiSFTVector *XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView, REAL8 fMin, REAL8 fMax );
+MultiSFTVector *XLALLoadMultiSFTsFromViewParallel ( const MultiSFTCatalogView *multiCatalogView, REAL8 fMin, REAL8 fMax, UINT4 numThreads );
+
+SFTPrefetcher *XLALCreateSFTPrefetcher ( UINT4 numThreads );
+void XLALDestroySFTPrefetcher ( SFTPrefetcher *prefetcher );
+int XLALSFTPrefetcherStart ( SFTPrefetcher *prefetcher, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+MultiSFTVector *XLALSFTPrefetcherLoad ( SFTPrefetcher *prefetcher, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+
+int XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog, const CHAR *fname );
+
+SFTFileMap *XLALCreateSFTFileMap ( const SFTCatalog *catalog );
+void XLALDestroySFTFileMap ( SFTFileMap *map );
+#ifndef SWIG /* exclude from SWIG interface; SFT data are not owned by the returned vectors */
+SFTVector *XLALLoadSFTViews ( const SFTFileMap *map, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+MultiSFTVector *XLALLoadMultiSFTViews ( const SFTFileMap *map, const SFTCatalog *catalog, REAL8 fMin, REAL8 fMax );
+void XLALDestroySFTViews ( SFTVector *views );
+void XLALDestroyMultiSFTViews ( MultiSFTVector *multiViews );
+#endif /* SWIG */
 
 int XLALCheckCRCSFTCatalog( BOOLEAN *crc_check, SFTCatalog *catalog );
 
@@ -279,6 +279,119 @@ main ( int argc, char *argv[] )
       XLAL_ERROR ( XLAL_EFUNC );
     }
 
+  // ----- test internal parallelisation of Resamp, and XLALFstatInputThreadCopy()
+  optionalArgs.FstatMethod = FMETHOD_RESAMP_GENERIC;
+  optionalArgs.prevInput = NULL;
+  optionalArgs.resampFFTPowerOf2 = (1 == 1);
+  FstatInput *input_threads = NULL, *input_copy = NULL;
+  FstatResults *results_threads = NULL, *results_copy = NULL, *results_orig = NULL;
+  XLAL_CHECK ( XLALFstatInputThreadCopy ( &input_copy, input_seg1[FMETHOD_RESAMP_GENERIC] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALComputeFstat ( &results_orig, input_seg1[FMETHOD_RESAMP_GENERIC], &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK ( XLALComputeFstat ( &results_copy, input_copy, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // use fewer and more threads than detectors; in the latter case each detector is split into sub-bands
+  const UINT4 resampNumThreads[] = { 2, 7 };
+  for ( UINT4 i = 0; i < XLAL_NUM_ELEM ( resampNumThreads ); i ++ )
+    {
+      optionalArgs.resampNumThreads = resampNumThreads[i];
+      XLAL_CHECK ( (input_threads = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( XLALComputeFstat ( &results_threads, input_threads, &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      XLALPrintInfo ( "Comparing results between serial and threaded (%d threads) Resamp FstatInput\n", resampNumThreads[i] );
+      if ( compareFstatResults ( results_orig, results_threads ) != XLAL_SUCCESS )
+        {
+          XLALPrintError ( "Comparison between serial and threaded (%d threads) Resamp FstatInput failed\n", resampNumThreads[i] );
+          XLAL_ERROR ( XLAL_EFUNC );
+        }
+
+      XLALDestroyFstatInput ( input_threads );
+      input_threads = NULL;
+    }
+
+  // a copy shares the FFT plan with the original, and must therefore reproduce its results exactly
+  XLALPrintInfo ( "Comparing results between original and copied Resamp FstatInput\n" );
+  for ( UINT4 k = 0; k < numFreqBins; k ++ )
+    {
+      XLAL_CHECK ( results_copy->twoF[k] == results_orig->twoF[k], XLAL_EFAILED, "Copied Resamp result differs from original result at bin k=%d\n", k );
+    }
+
+  XLALDestroyFstatInput ( input_copy );
+  XLALDestroyFstatResults ( results_orig );
+  XLALDestroyFstatResults ( results_threads );
+  XLALDestroyFstatResults ( results_copy );
+
+  // ----- test XLALComputeFstatSpindownBlock() against XLALComputeFstat() for all available methods
+  {
+    const UINT4 numBlock = 11;
+    PulsarDopplerParams dopplerBlock[numBlock];
+    FstatResults *results_block[numBlock], *results_single = NULL;
+    for ( UINT4 i = 0; i < numBlock; i ++ )
+      {
+        dopplerBlock[i] = Doppler;
+        dopplerBlock[i].fkdot[1] = spinRange.fkdot[1] + i * spinRange.fkdotBand[1] / (numBlock - 1);
+        results_block[i] = NULL;
+      }
+    for ( UINT4 iMethod = FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
+      {
+        if ( !XLALFstatMethodIsAvailable(iMethod) ) {
+          continue;
+        }
+        XLAL_CHECK ( XLALComputeFstatSpindownBlock ( results_block, input_seg1[iMethod], dopplerBlock, numBlock, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+        for ( UINT4 i = 0; i < numBlock; i ++ )
+          {
+            XLAL_CHECK ( XLALComputeFstat ( &results_single, input_seg1[iMethod], &dopplerBlock[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+            XLALPrintInfo ( "Comparing results between XLALComputeFstatSpindownBlock() and XLALComputeFstat() for method %s, spindown %d\n", XLALGetFstatInputMethodName ( input_seg1[iMethod] ), i );
+            if ( compareFstatResults ( results_single, results_block[i] ) != XLAL_SUCCESS )
+              {
+                XLALPrintError ( "Comparison between XLALComputeFstatSpindownBlock() and XLALComputeFstat() failed for method %s\n", XLALGetFstatInputMethodName ( input_seg1[iMethod] ) );
+                XLAL_ERROR ( XLAL_EFUNC );
+              }
+          }
+      }
+    for ( UINT4 i = 0; i < numBlock; i ++ )
+      {
+        XLALDestroyFstatResults ( results_block[i] );
+      }
+    XLALDestroyFstatResults ( results_single );
+  }
+
+  // ----- test Demod hotloops which work for any number of Dirichlet kernel terms against DemodGeneric, with a non-default Dterms
+  {
+    const FstatMethodType methods_Dterms[] = { FMETHOD_DEMOD_GENERIC, FMETHOD_DEMOD_OPTC, FMETHOD_DEMOD_AVX2, FMETHOD_DEMOD_AVX512 };
+    FstatInput *input_Dterms[XLAL_NUM_ELEM ( methods_Dterms )];
+    FstatResults *results_Dterms[XLAL_NUM_ELEM ( methods_Dterms )];
+    optionalArgs = FstatOptionalArgsDefaults;
+    optionalArgs.injectSources = injectSources;
+    optionalArgs.injectSqrtSX = &injectSqrtSX;
+    optionalArgs.assumeSqrtSX = &assumeSqrtSX;
+    optionalArgs.Dterms = 13;
+    for ( UINT4 i = 0; i < XLAL_NUM_ELEM ( methods_Dterms ); i ++ )
+      {
+        input_Dterms[i] = NULL;
+        results_Dterms[i] = NULL;
+        if ( !XLALFstatMethodIsAvailable ( methods_Dterms[i] ) ) {
+          continue;
+        }
+        optionalArgs.FstatMethod = methods_Dterms[i];
+        XLAL_CHECK ( (input_Dterms[i] = XLALCreateFstatInput ( catalog, minCoverFreq, maxCoverFreq, dFreq, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+        XLAL_CHECK ( XLALComputeFstat ( &results_Dterms[i], input_Dterms[i], &Doppler, numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+        if ( i > 0 )
+          {
+            XLALPrintInfo ( "Comparing results between method '%s' and '%s' with Dterms=%u\n", XLALGetFstatInputMethodName ( input_Dterms[0] ), XLALGetFstatInputMethodName ( input_Dterms[i] ), optionalArgs.Dterms );
+            if ( compareFstatResults ( results_Dterms[0], results_Dterms[i] ) != XLAL_SUCCESS )
+              {
+                XLALPrintError ( "Comparison between method '%s' and '%s' failed with Dterms=%u\n", XLALGetFstatInputMethodName ( input_Dterms[0] ), XLALGetFstatInputMethodName ( input_Dterms[i] ), optionalArgs.Dterms );
+                XLAL_ERROR ( XLAL_EFUNC );
+              }
+          }
+      }
+    for ( UINT4 i = 0; i < XLAL_NUM_ELEM ( methods_Dterms ); i ++ )
+      {
+        XLALDestroyFstatInput ( input_Dterms[i] );
+        XLALDestroyFstatResults ( results_Dterms[i] );
+      }
+  }
+
   // free remaining memory
   for ( UINT4 iMethod=FMETHOD_START; iMethod < FMETHOD_END; iMethod ++ )
     {
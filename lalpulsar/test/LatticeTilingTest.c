@@ -28,6 +28,7 @@
 #include <lal/DopplerFullScan.h>
 #include <lal/SuperskyMetrics.h>
 #include <lal/LALInitBarycenter.h>
+#include <lal/LogPrintf.h>
 
 #include <lal/GSLHelpers.h>
 
@@ -171,6 +172,159 @@ static int SerialisationTest(
 
 }
 
+static int DispenserTest(
+  const LatticeTiling *tiling
+  )
+{
+
+  printf( "Performing dispenser test ..." );
+
+  const size_t n = XLALTotalLatticeTilingDimensions( tiling );
+  const UINT4 nworkers = 3;
+
+  // Get all points from an alternating iterator
+  LatticeTilingIterator *itr = XLALCreateLatticeTilingIterator( tiling, n );
+  XLAL_CHECK( itr != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALSetLatticeTilingAlternatingIterator( itr, true ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const UINT8 total = XLALTotalLatticeTilingPoints( itr );
+  XLAL_CHECK( total > 0, XLAL_EFUNC );
+  gsl_matrix *GAMAT( points, n, total );
+  XLAL_CHECK( XLALNextLatticeTilingPoints( itr, &points ) == ( int ) total, XLAL_EFUNC );
+  XLALDestroyLatticeTilingIterator( itr );
+
+  // Create lattice tiling dispenser
+  LatticeTilingDispenser *disp = XLALCreateLatticeTilingDispenser( tiling, n, true, nworkers, 2 );
+  XLAL_CHECK( disp != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALTotalLatticeTilingDispenserPoints( disp ) == total, XLAL_EFAILED );
+
+  // Record number of times each point is in a finished block
+  UINT4 *nfinished = XLALCalloc( total, sizeof( *nfinished ) );
+  XLAL_CHECK( nfinished != NULL, XLAL_ENOMEM );
+
+  // Allocate memory for blocks of points dispensed to each worker
+  gsl_matrix *block_points[nworkers];
+  for ( size_t w = 0; w < nworkers; ++w ) {
+    GAMAT( block_points[w], n, 7 );
+  }
+  UINT8 block_index[nworkers];
+  int block_count[nworkers];
+
+  // Dispense blocks to workers, finishing blocks in a different order to which they were dispensed
+  size_t nrounds = 0, k_ckpt = 0;
+  while ( true ) {
+
+    // Dispense blocks to all workers
+    for ( size_t w = 0; w < nworkers; ++w ) {
+      block_count[w] = XLALNextLatticeTilingDispenserBlock( disp, block_points[w], &block_index[w] );
+      XLAL_CHECK( block_count[w] >= 0, XLAL_EFUNC );
+    }
+    if ( block_count[0] == 0 ) {
+      break;
+    }
+
+    // Checkpoint dispenser every few rounds, leaving the first block unfinished;
+    // it should then be dispensed again after the dispenser is restored
+#if defined(HAVE_LIBCFITSIO)
+    const bool checkpoint = ( nrounds % 3 == 1 );
+#else
+    const bool checkpoint = false;
+#endif
+
+    // Finish blocks in reverse order
+    for ( size_t w = nworkers; w > 0; --w ) {
+      if ( block_count[w-1] == 0 || ( w == 1 && checkpoint ) ) {
+        continue;
+      }
+      for ( int j = 0; j < block_count[w-1]; ++j ) {
+        const UINT8 k = block_index[w-1] + j;
+        XLAL_CHECK( k < total, XLAL_EFAILED, "k = %" LAL_UINT8_FORMAT " >= %" LAL_UINT8_FORMAT " = total", k, total );
+        gsl_vector_view point_view = gsl_matrix_column( block_points[w-1], j );
+        gsl_vector_const_view points_k_view = gsl_matrix_const_column( points, k );
+        gsl_vector_sub( &point_view.vector, &points_k_view.vector );
+        double err = gsl_blas_dasum( &point_view.vector ) / n;
+        XLAL_CHECK( err < 1e-6, XLAL_EFAILED, "err = %e < 1e-6", err );
+        ++nfinished[k];
+      }
+      XLAL_CHECK( XLALFinishLatticeTilingDispenserBlock( disp, block_index[w-1] ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    ++nrounds;
+
+#if defined(HAVE_LIBCFITSIO)
+    if ( checkpoint ) {
+
+      // Save dispenser to a FITS file
+      {
+        FITSFile *file = XLALFITSFileOpenWrite( "LatticeTilingTest.fits" );
+        XLAL_CHECK( file != NULL, XLAL_EFUNC );
+        XLAL_CHECK( XLALSaveLatticeTilingDispenser( disp, file, "disp" ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLALFITSFileClose( file );
+      }
+
+      // Destroy and recreate lattice tiling dispenser
+      XLALDestroyLatticeTilingDispenser( disp );
+      disp = XLALCreateLatticeTilingDispenser( tiling, n, true, nworkers, 2 );
+      XLAL_CHECK( disp != NULL, XLAL_EFUNC );
+
+      // Restore dispenser from a FITS file
+      {
+        FITSFile *file = XLALFITSFileOpenRead( "LatticeTilingTest.fits" );
+        XLAL_CHECK( file != NULL, XLAL_EFUNC );
+        XLAL_CHECK( XLALRestoreLatticeTilingDispenser( disp, file, "disp" ) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLALFITSFileClose( file );
+      }
+
+      ++k_ckpt;
+
+    }
+#endif // defined(HAVE_LIBCFITSIO)
+
+  }
+
+  // Check that every point has been in exactly one finished block
+  for ( UINT8 k = 0; k < total; ++k ) {
+    XLAL_CHECK( nfinished[k] == 1, XLAL_EFAILED, "nfinished[%" LAL_UINT8_FORMAT "] = %u != 1", k, nfinished[k] );
+  }
+  XLAL_CHECK( XLALFinishedLatticeTilingDispenserPoints( disp ) == total, XLAL_EFAILED );
+  XLALDestroyLatticeTilingDispenser( disp );
+
+  // Dispense blocks to workers in multiple threads, if available
+  disp = XLALCreateLatticeTilingDispenser( tiling, n, true, nworkers, 1 );
+  XLAL_CHECK( disp != NULL, XLAL_EFUNC );
+  memset( nfinished, 0, total * sizeof( *nfinished ) );
+  int failed = 0;
+#pragma omp parallel for num_threads(nworkers) reduction(|:failed)
+  for ( size_t w = 0; w < nworkers; ++w ) {
+    int count = 0;
+    UINT8 index = 0;
+    while ( !failed && ( count = XLALNextLatticeTilingDispenserBlock( disp, block_points[w], &index ) ) > 0 ) {
+      for ( int j = 0; j < count; ++j ) {
+#pragma omp atomic
+        ++nfinished[index + j];
+      }
+      failed |= ( XLALFinishLatticeTilingDispenserBlock( disp, index ) != XLAL_SUCCESS );
+    }
+    failed |= ( count < 0 );
+  }
+  XLAL_CHECK( !failed, XLAL_EFUNC );
+  for ( UINT8 k = 0; k < total; ++k ) {
+    XLAL_CHECK( nfinished[k] == 1, XLAL_EFAILED, "nfinished[%" LAL_UINT8_FORMAT "] = %u != 1", k, nfinished[k] );
+  }
+  XLAL_CHECK( XLALFinishedLatticeTilingDispenserPoints( disp ) == total, XLAL_EFAILED );
+
+  printf( " %zu rounds, %zu checkpoints ... done\n", nrounds, k_ckpt );
+
+  // Cleanup
+  XLALDestroyLatticeTilingDispenser( disp );
+  for ( size_t w = 0; w < nworkers; ++w ) {
+    GFMAT( block_points[w] );
+  }
+  GFMAT( points );
+  XLALFree( nfinished );
+
+  return XLAL_SUCCESS;
+
+}
+
 static int BasicTest(
   const size_t n,
   const int bound_on_0,
@@ -354,6 +508,9 @@ static int BasicTest(
   // Perform serialisation test
   XLAL_CHECK( SerialisationTest( tiling, total_ref[n-1], total_tol, total_ref_0, total_ref_1, total_ref_2, total_ref_3 ) == XLAL_SUCCESS, XLAL_EFUNC );
 
+  // Perform dispenser test
+  XLAL_CHECK( DispenserTest( tiling ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   // Cleanup
   XLALDestroyLatticeTiling( tiling );
   XLALDestroyLatticeTilingLocator( loc );
@@ -518,6 +675,72 @@ static int MismatchTest(
 
 }
 
+static int NearestPointsBenchmark(
+  const LatticeTiling *tiling,
+  const size_t num_points
+  )
+{
+
+  const size_t n = XLALTotalLatticeTilingDimensions( tiling );
+
+  printf( "Benchmarking XLALNearestLatticeTilingPoints() with %zu points ...", num_points );
+
+  // Create lattice tiling locator
+  LatticeTilingLocator *loc = XLALCreateLatticeTilingLocator( tiling );
+  XLAL_CHECK( loc != NULL, XLAL_EFUNC );
+
+  // Generate random points
+  gsl_matrix *GAMAT( points, n, num_points );
+  RandomParams *rng = XLALCreateRandomParams( num_points );
+  XLAL_CHECK( rng != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALRandomLatticeTilingPoints( tiling, 0.0, rng, points ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Find nearest points one at a time
+  gsl_matrix *GAMAT( nearest_single, n, num_points );
+  UINT8VectorSequence *nearest_indexes_single = XLALCreateUINT8VectorSequence( num_points, n );
+  XLAL_CHECK( nearest_indexes_single != NULL, XLAL_EFUNC );
+  const double t_single_0 = XLALGetCPUTime();
+  for ( size_t j = 0; j < num_points; ++j ) {
+    gsl_vector_const_view point_view = gsl_matrix_const_column( points, j );
+    gsl_vector_view nearest_view = gsl_matrix_column( nearest_single, j );
+    UINT8Vector nearest_index_view = { .length = n, .data = &nearest_indexes_single->data[n * j] };
+    XLAL_CHECK( XLALNearestLatticeTilingPoint( loc, &point_view.vector, &nearest_view.vector, &nearest_index_view ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  const double t_single = XLALGetCPUTime() - t_single_0;
+
+  // Find nearest points in a single batch
+  gsl_matrix *nearest_batch = NULL;
+  UINT8VectorSequence *nearest_indexes_batch = NULL;
+  const double t_batch_0 = XLALGetCPUTime();
+  XLAL_CHECK( XLALNearestLatticeTilingPoints( loc, points, &nearest_batch, &nearest_indexes_batch ) == XLAL_SUCCESS, XLAL_EFUNC );
+  const double t_batch = XLALGetCPUTime() - t_batch_0;
+
+  // Check for consistency
+  for ( size_t j = 0; j < num_points; ++j ) {
+    for ( size_t i = 0; i < n; ++i ) {
+      const UINT8 index_single = nearest_indexes_single->data[n * j + i];
+      const UINT8 index_batch = nearest_indexes_batch->data[n * j + i];
+      XLAL_CHECK( index_single == index_batch, XLAL_EFAILED, "nearest_indexes[%zu][%zu]: single = %" LAL_UINT8_FORMAT " != %" LAL_UINT8_FORMAT " = batch", j, i, index_single, index_batch );
+      const double nearest_single_i_j = gsl_matrix_get( nearest_single, i, j );
+      const double nearest_batch_i_j = gsl_matrix_get( nearest_batch, i, j );
+      XLAL_CHECK( nearest_single_i_j == nearest_batch_i_j, XLAL_EFAILED, "nearest[%zu][%zu]: single = %.16g != %.16g = batch", j, i, nearest_single_i_j, nearest_batch_i_j );
+    }
+  }
+
+  // Report speedup
+  printf( " single %.3g us/point, batch %.3g us/point, speedup %.2f ... done\n", 1e6 * t_single / num_points, 1e6 * t_batch / num_points, t_single / GSL_MAX( t_batch, 1e-9 ) );
+
+  // Cleanup
+  XLALDestroyLatticeTilingLocator( loc );
+  XLALDestroyRandomParams( rng );
+  XLALDestroyUINT8VectorSequence( nearest_indexes_single );
+  XLALDestroyUINT8VectorSequence( nearest_indexes_batch );
+  GFMAT( points, nearest_single, nearest_batch );
+
+  return XLAL_SUCCESS;
+
+}
+
 static int MismatchSquareTest(
   const TilingLattice lattice,
   const double freqband,
@@ -751,6 +974,12 @@ static int SuperskyTests(
   XLAL_CHECK( MismatchTest( semi_tiling, metrics->semi_rssky_metric, semi_max_mismatch, 0.0001, 5e-2, 5e-2, semi_total_ref, lround(1e-6 * semi_total_ref), A4s_mism_hist ) == XLAL_SUCCESS, XLAL_EFUNC );
   printf( "\n" );
 
+  // Perform nearest point benchmark of coherent tilings, as used to interpolate semicoherent points
+  // - Use enough points to exercise the sorted, heap-allocated batch code path while keeping 'make check' fast
+  printf( "Coherent #0 nearest point benchmark:\n" );
+  XLAL_CHECK( NearestPointsBenchmark( coh_tiling[0], 5000 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  printf( "\n" );
+
   // Cleanup
   for ( size_t n = 0; n < metrics->num_segments; ++n ) {
     XLALDestroyLatticeTiling( coh_tiling[n] );
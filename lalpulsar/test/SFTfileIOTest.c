@@ -199,6 +199,28 @@ int main( void )
     XLALPrintError ("%s: XLALLoadMultiSFTs (cat, -1, -1) failed with xlalErrno = %d\n", fn, xlalErrno );
     return EXIT_FAILURE;
   }
+
+  /* load again concurrently, and through an SFT prefetcher, and compare */
+  {
+    MultiSFTCatalogView *multiCatView;
+    MultiSFTVector *multsft_par, *multsft_pre;
+    SFTPrefetcher *prefetcher;
+    XLAL_CHECK_MAIN ( ( multiCatView = XLALGetMultiSFTCatalogView ( catalog ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( multsft_par = XLALLoadMultiSFTsFromViewParallel ( multiCatView, -1, -1, 4 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( prefetcher = XLALCreateSFTPrefetcher ( 2 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( XLALSFTPrefetcherStart ( prefetcher, catalog, -1, -1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( multsft_pre = XLALSFTPrefetcherLoad ( prefetcher, catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( multsft_par->length == multsft_vect->length && multsft_pre->length == multsft_vect->length, XLAL_EFAILED );
+    for ( UINT4 X = 0; X < multsft_vect->length; X ++ )
+      {
+        XLAL_CHECK_MAIN ( CompareSFTVectors ( multsft_vect->data[X], multsft_par->data[X] ) == 0, XLAL_EFAILED, "parallel-loaded SFTs differ for X=%d\n", X );
+        XLAL_CHECK_MAIN ( CompareSFTVectors ( multsft_vect->data[X], multsft_pre->data[X] ) == 0, XLAL_EFAILED, "prefetched SFTs differ for X=%d\n", X );
+      }
+    XLALDestroyMultiSFTVector ( multsft_pre );
+    XLALDestroySFTPrefetcher ( prefetcher );
+    XLALDestroyMultiSFTVector ( multsft_par );
+    XLALDestroyMultiSFTCatalogView ( multiCatView );
+  }
   XLALDestroySFTCatalog(catalog);
 
   /* 6 SFTs from 2 IFOs should have been read */
@@ -338,6 +360,59 @@ int main( void )
   if(CompareSFTVectors(sft_vect, sft_vect2))
     return EXIT_FAILURE;
 
+  /* write a catalog index, read it back, and compare to the original catalog */
+  {
+    SFTCatalog *catalog2 = NULL;
+    XLAL_CHECK_MAIN ( XLALWriteSFTCatalogIndex ( catalog, "outputsftv2.idx" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( catalog2 = XLALSFTdataFind ( "index:outputsftv2.idx", &constraints ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( catalog2->length == catalog->length, XLAL_EFAILED, "Catalog read from index has %u SFTs, expected %u\n", catalog2->length, catalog->length );
+    for ( UINT4 i = 0; i < catalog->length; i ++ )
+      {
+        const SFTDescriptor *desc = &catalog->data[i], *desc2 = &catalog2->data[i];
+        XLAL_CHECK_MAIN ( strcmp ( XLALshowSFTLocator ( desc->locator ), XLALshowSFTLocator ( desc2->locator ) ) == 0, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( XLALGPSCmp ( &desc->header.epoch, &desc2->header.epoch ) == 0, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( desc->header.f0 == desc2->header.f0 && desc->header.deltaF == desc2->header.deltaF, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( strcmp ( desc->header.name, desc2->header.name ) == 0, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( desc->numBins == desc2->numBins && desc->version == desc2->version && desc->crc64 == desc2->crc64, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( strcmp ( desc->comment, desc2->comment ) == 0, XLAL_EFAILED );
+      }
+
+    /* load memory-mapped SFT views and compare to the loaded SFTs */
+    SFTFileMap *map = NULL;
+    SFTVector *views = NULL;
+    XLAL_CHECK_MAIN ( ( map = XLALCreateSFTFileMap ( catalog2 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( views = XLALLoadSFTViews ( map, catalog2, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    if(CompareSFTVectors(sft_vect, views))
+      return EXIT_FAILURE;
+    XLALDestroySFTViews ( views );
+    XLALDestroySFTFileMap ( map );
+    XLALDestroySFTCatalog(catalog2);
+  }
+
+#ifdef LAL_HDF5_ENABLED
+  /* write a band-chunked HDF5 SFT container, read it back (fully and a sub-band), and compare to the loaded SFTs */
+  {
+    SFTCatalog *catalog2 = NULL;
+    SFTVector *sft_vect3 = NULL, *sft_vect4 = NULL;
+    const REAL8 f0 = sft_vect->data[0].f0, dFreq = sft_vect->data[0].deltaF;
+    const REAL8 fMin2 = f0 + 4 * dFreq, fMax2 = f0 + 10 * dFreq;
+    XLAL_CHECK_MAIN ( XLALWriteSFTVector2H5File ( sft_vect, "outputsftv2.h5", 3, "A band-chunked SFT container for testing!" ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( catalog2 = XLALSFTdataFind ( "outputsftv2.h5", &constraints ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( catalog2->length == catalog->length, XLAL_EFAILED, "Catalog of SFT container has %u SFTs, expected %u\n", catalog2->length, catalog->length );
+    XLAL_CHECK_MAIN ( ( sft_vect3 = XLALLoadSFTs ( catalog2, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    if(CompareSFTVectors(sft_vect, sft_vect3))
+      return EXIT_FAILURE;
+    XLALDestroySFTVector ( sft_vect3 );
+    XLAL_CHECK_MAIN ( ( sft_vect3 = XLALLoadSFTs ( catalog2, fMin2, fMax2 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( ( sft_vect4 = XLALLoadSFTs ( catalog, fMin2, fMax2 ) ) != NULL, XLAL_EFUNC );
+    if(CompareSFTVectors(sft_vect4, sft_vect3))
+      return EXIT_FAILURE;
+    XLALDestroySFTVector ( sft_vect4 );
+    XLALDestroySFTVector ( sft_vect3 );
+    XLALDestroySFTCatalog(catalog2);
+  }
+#endif
+
   XLALDestroySFTVector ( sft_vect2 );
   sft_vect2 = NULL;
   XLALDestroySFTVector ( sft_vect );
@@ -8,15 +8,18 @@
 #define DEFINE_INSERT_FUNC(NAME, TYPE, KEY, DEFAULT) \
 	int XLALSimInspiralWaveformParamsInsert ## NAME(LALDict *params, TYPE value) \
 	{ \
-		return XLALDictInsert ## TYPE ## Value(params, KEY, value); \
+		static LALDictKey key = LAL_DICT_KEY_INIT(KEY); \
+		return XLALDictInsert ## TYPE ## ValueByKey(params, &key, value); \
 	}
 
 #define DEFINE_LOOKUP_FUNC(NAME, TYPE, KEY, DEFAULT) \
 	TYPE XLALSimInspiralWaveformParamsLookup ## NAME(LALDict *params) \
 	{ \
+		static LALDictKey key = LAL_DICT_KEY_INIT(KEY); \
 		TYPE value = DEFAULT; \
-		if (params && XLALDictContains(params, KEY)) \
-			value = XLALDictLookup ## TYPE ## Value(params, KEY); \
+		LALDictEntry *entry; \
+		if (params && (entry = XLALDictLookupByKey(params, &key)) != NULL) \
+			value = XLALValueGet ## TYPE(XLALDictEntryGetValue(entry)); \
 		return value; \
 	}
 
@@ -197,11 +200,9 @@ LALValue* XLALSimInspiralWaveformParamsLookupModeArray(LALDict *params)
 {
 	/* Initialise and set Default to NULL */
 	LALValue * value = NULL;
-	if (params && XLALDictContains(params, "ModeArray"))
-	{
-		LALDictEntry * entry = XLALDictLookup(params, "ModeArray");
+	LALDictEntry * entry;
+	if (params && (entry = XLALDictLookup(params, "ModeArray")) != NULL)
 		value = XLALValueDuplicate(XLALDictEntryGetValue(entry));
-	}
 	return value;
 }
 